@@ -984,6 +984,50 @@ int sr_delete_item(sr_session_ctx_t *session, const char *xpath, const sr_edit_o
  */
 int sr_move_item(sr_session_ctx_t *session, const char *xpath, const sr_move_position_t position, const char *relative_item);
 
+/**
+ * @brief Type of an edit operation within a batch (see ::sr_edit_batch).
+ */
+typedef enum sr_edit_batch_op_type_e {
+    SR_EDIT_BATCH_SET,      /**< Equivalent of ::sr_set_item. */
+    SR_EDIT_BATCH_SET_STR,  /**< Equivalent of ::sr_set_item_str. */
+    SR_EDIT_BATCH_DELETE,   /**< Equivalent of ::sr_delete_item. */
+    SR_EDIT_BATCH_MOVE,     /**< Equivalent of ::sr_move_item. */
+} sr_edit_batch_op_type_t;
+
+/**
+ * @brief One edit operation within a batch (see ::sr_edit_batch).
+ */
+typedef struct sr_edit_batch_op_s {
+    sr_edit_batch_op_type_t type;   /**< Type of the operation. */
+    const char *xpath;              /**< @ref xp_page "Data Path" identifier of the data element to be edited. */
+    const sr_val_t *value;          /**< Value to be set (::SR_EDIT_BATCH_SET, can be NULL as in ::sr_set_item). */
+    const char *str_value;          /**< Value to be set in string format (::SR_EDIT_BATCH_SET_STR). */
+    sr_edit_options_t opts;         /**< Edit options (::SR_EDIT_BATCH_SET, ::SR_EDIT_BATCH_SET_STR, ::SR_EDIT_BATCH_DELETE). */
+    sr_move_position_t position;    /**< Requested move direction (::SR_EDIT_BATCH_MOVE). */
+    const char *relative_item;      /**< Relative item for the move operation (::SR_EDIT_BATCH_MOVE). */
+    int result;                     /**< [out] Result of the operation, SR_ERR_OPERATION_FAILED
+                                         for operations not processed because of a previous error. */
+} sr_edit_batch_op_t;
+
+/**
+ * @brief Performs multiple edit operations in one request.
+ *
+ * The operations are applied in the order of the array, with the same semantics
+ * as the corresponding single-edit calls. The edits are sent to the datastore
+ * as one message, which is much faster than a separate call for each of them.
+ *
+ * @see Use ::sr_get_last_errors to retrieve error information of the failed operations.
+ *
+ * @param[in] session Session context acquired with ::sr_session_start call.
+ * @param[in,out] operations Array of the operations, the result of each operation is set on return.
+ * @param[in] op_cnt Number of the operations in the array.
+ * @param[in] continue_on_error If false, processing stops on the first failed operation,
+ * otherwise all operations are attempted.
+ *
+ * @return Error code (SR_ERR_OK if all operations have succeeded, otherwise the error of the first failed one).
+ */
+int sr_edit_batch(sr_session_ctx_t *session, sr_edit_batch_op_t *operations, size_t op_cnt, bool continue_on_error);
+
 /**
  * @brief Perform the validation of changes made in current session, but do not
  * commit nor discard them.
@@ -1058,6 +1102,102 @@ int sr_copy_config(sr_session_ctx_t *session, const char *module_name,
         sr_datastore_t src_datastore, sr_datastore_t dst_datastore);
 
 
+////////////////////////////////////////////////////////////////////////////////
+// Asynchronous Data Retrieval / Manipulation API
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Callback to be called when an asynchronous request is completed.
+ *
+ * @param[in] session Session context the request has been issued on.
+ * @param[in] result Result of the request (SR_ERR_OK on success).
+ * @param[in] errors Detailed error information of a failed request (NULL if there is none).
+ * The array is valid only within the callback. ::sr_get_last_errors does not reflect
+ * asynchronous requests.
+ * @param[in] error_cnt Number of items in the errors array.
+ * @param[in] private_ctx Private context opaque to sysrepo, as passed in the request call.
+ */
+typedef void (*sr_async_cb)(sr_session_ctx_t *session, int result, const sr_error_info_t *errors, size_t error_cnt,
+        void *private_ctx);
+
+/**
+ * @brief Callback to be called when an asynchronous ::sr_get_items_async request is completed.
+ *
+ * @param[in] session Session context the request has been issued on.
+ * @param[in] result Result of the request (SR_ERR_OK on success, SR_ERR_NOT_FOUND if no data matched).
+ * @param[in] values Array of retrieved values (if any). Ownership is passed to the callback,
+ * the values need to be freed by ::sr_free_values.
+ * @param[in] value_cnt Number of retrieved values.
+ * @param[in] errors Detailed error information of a failed request (see ::sr_async_cb).
+ * @param[in] error_cnt Number of items in the errors array.
+ * @param[in] private_ctx Private context opaque to sysrepo, as passed in the request call.
+ */
+typedef void (*sr_get_items_async_cb)(sr_session_ctx_t *session, int result, sr_val_t *values, size_t value_cnt,
+        const sr_error_info_t *errors, size_t error_cnt, void *private_ctx);
+
+/**
+ * @brief Asynchronous variant of ::sr_get_items. Sends the request and returns immediately,
+ * the result is delivered to the provided callback.
+ *
+ * @note Callbacks of asynchronous requests are called from a dispatcher thread
+ * of the connection, one at a time. Requests issued on the same session are
+ * processed and completed in the order in which they have been issued.
+ * The session must not be stopped until all its asynchronous requests are completed.
+ *
+ * @param[in] session Session context acquired with ::sr_session_start call.
+ * @param[in] xpath @ref xp_page "Data Path" identifier of the data element to be retrieved.
+ * @param[in] callback Callback to be called when the request is completed.
+ * @param[in] private_ctx Private context passed to the callback function, opaque to sysrepo.
+ *
+ * @return Error code (SR_ERR_OK if the request has been sent).
+ */
+int sr_get_items_async(sr_session_ctx_t *session, const char *xpath, sr_get_items_async_cb callback,
+        void *private_ctx);
+
+/**
+ * @brief Asynchronous variant of ::sr_set_item. Sends the request and returns immediately,
+ * the result is delivered to the provided callback (see ::sr_get_items_async for details).
+ *
+ * @param[in] session Session context acquired with ::sr_session_start call.
+ * @param[in] xpath @ref xp_page "Data Path" identifier of the data element to be set.
+ * @param[in] value Value to be set on specified xpath (see ::sr_set_item).
+ * @param[in] opts Options overriding default behavior of this call.
+ * @param[in] callback Callback to be called when the request is completed (can be NULL).
+ * @param[in] private_ctx Private context passed to the callback function, opaque to sysrepo.
+ *
+ * @return Error code (SR_ERR_OK if the request has been sent).
+ */
+int sr_set_item_async(sr_session_ctx_t *session, const char *xpath, const sr_val_t *value,
+        const sr_edit_options_t opts, sr_async_cb callback, void *private_ctx);
+
+/**
+ * @brief Asynchronous variant of ::sr_delete_item. Sends the request and returns immediately,
+ * the result is delivered to the provided callback (see ::sr_get_items_async for details).
+ *
+ * @param[in] session Session context acquired with ::sr_session_start call.
+ * @param[in] xpath @ref xp_page "Data Path" identifier of the data element to be deleted.
+ * @param[in] opts Options overriding default behavior of this call.
+ * @param[in] callback Callback to be called when the request is completed (can be NULL).
+ * @param[in] private_ctx Private context passed to the callback function, opaque to sysrepo.
+ *
+ * @return Error code (SR_ERR_OK if the request has been sent).
+ */
+int sr_delete_item_async(sr_session_ctx_t *session, const char *xpath, const sr_edit_options_t opts,
+        sr_async_cb callback, void *private_ctx);
+
+/**
+ * @brief Asynchronous variant of ::sr_commit. Sends the request and returns immediately,
+ * the result is delivered to the provided callback (see ::sr_get_items_async for details).
+ *
+ * @param[in] session Session context acquired with ::sr_session_start call.
+ * @param[in] callback Callback to be called when the request is completed (can be NULL).
+ * @param[in] private_ctx Private context passed to the callback function, opaque to sysrepo.
+ *
+ * @return Error code (SR_ERR_OK if the request has been sent).
+ */
+int sr_commit_async(sr_session_ctx_t *session, sr_async_cb callback, void *private_ctx);
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // Locking API
 ////////////////////////////////////////////////////////////////////////////////
@@ -1182,6 +1322,22 @@ typedef enum sr_subscr_flag_e {
      * and replay has finished (::SR_EV_NOTIF_T_REPLAY_COMPLETE is delivered).
      */
     SR_SUBSCR_NOTIF_REPLAY_FIRST = 32,
+
+    /**
+     * @brief The data provider is able to provide operational data nested in a configuration list for all
+     * instances of the list in one callback call. Instead of calling the ::sr_dp_get_items_cb callback once
+     * per list instance, sysrepo will pass in an xpath without the list keys (e.g. `/ietf-interfaces:interfaces-state/interface/statistics`)
+     * and the provider is supposed to return the values for all instances at once.
+     */
+    SR_SUBSCR_DP_BULK = 64,
+
+    /**
+     * @brief The changes matching the subscription are delivered to the subscriber together with
+     * the ::sr_module_change_cb / ::sr_subtree_change_cb notification. Iterating over them using ::sr_get_changes_iter
+     * with the xpath of the subscription (or `/<module>:*` in case of ::sr_module_change_subscribe) does not need
+     * to request them from sysrepo, which is useful for commits changing a large amount of data.
+     */
+    SR_SUBSCR_CHANGES_INLINE = 128,
 } sr_subscr_flag_t;
 
 /**
@@ -1307,7 +1463,9 @@ typedef void (*sr_feature_enable_cb)(const char *module_name, const char *featur
  * @param[in] callback Callback to be called when the change in the datastore occurs.
  * @param[in] private_ctx Private context passed to the callback function, opaque to sysrepo.
  * @param[in] priority Specifies the order in which the callbacks will be called (callbacks with higher
- * priority will be called sooner, callbacks with the priority of 0 will be called at the end).
+ * priority will be called sooner, callbacks with the priority of 0 will be called at the end). If the
+ * SR_SUBSCR_THREADS environment variable is set to a positive number, callbacks of different subscriptions
+ * with the same priority can be called concurrently from multiple threads.
  * @param[in] opts Options overriding default behavior of the subscription, it is supposed to be
  * a bitwise OR-ed value of any ::sr_subscr_flag_t flags.
  * @param[in,out] subscription Subscription context that is supposed to be released by ::sr_unsubscribe.
@@ -1327,7 +1485,9 @@ int sr_module_change_subscribe(sr_session_ctx_t *session, const char *module_nam
  * @param[in] callback Callback to be called when the change in the datastore occurs.
  * @param[in] private_ctx Private context passed to the callback function, opaque to sysrepo.
  * @param[in] priority Specifies the order in which the callbacks will be called (callbacks with higher
- * priority will be called sooner, callbacks with the priority of 0 will be called at the end).
+ * priority will be called sooner, callbacks with the priority of 0 will be called at the end). If the
+ * SR_SUBSCR_THREADS environment variable is set to a positive number, callbacks of different subscriptions
+ * with the same priority can be called concurrently from multiple threads.
  * @param[in] opts Options overriding default behavior of the subscription, it is supposed to be
  * a bitwise OR-ed value of any ::sr_subscr_flag_t flags.
  * @param[in,out] subscription Subscription context that is supposed to be released by ::sr_unsubscribe.
@@ -1833,6 +1993,9 @@ int sr_event_notif_replay(sr_session_ctx_t *session, sr_subscription_ctx_t *subs
  * The xpath argument passed to callback can be only the xpath that was used for the subscription, or xpath of
  * any nested lists or containers.
  *
+ * If the subscription was made with ::SR_SUBSCR_DP_BULK flag, the xpath may select the node in all instances
+ * of a parent list (list keys are omitted), in which case the values for all instances are supposed to be returned.
+ *
  * @param[in] xpath @ref xp_page "Data Path" identifying the level under which the nodes are requested.
  * @param[out] values Array of values at the selected level (allocated by the provider).
  * @param[out] values_cnt Number of values returned.
@@ -1863,6 +2026,30 @@ typedef int (*sr_dp_get_items_cb)(const char *xpath, sr_val_t **values, size_t *
 int sr_dp_get_items_subscribe(sr_session_ctx_t *session, const char *xpath, sr_dp_get_items_cb callback, void *private_ctx,
         sr_subscr_options_t opts, sr_subscription_ctx_t **subscription);
 
+/**
+ * @brief Registers for providing of operational data under given xpath, allowing sysrepo to cache
+ * the provided data. Same as ::sr_dp_get_items_subscribe, but the values returned by the callback
+ * for a particular xpath are kept by sysrepo for cache_ttl milliseconds and served to all sessions
+ * requesting the same data in that period without calling the callback again.
+ *
+ * @note Use this only for data that can be a little stale, e.g. counters polled by management agents.
+ *
+ * @param[in] session Session context acquired with ::sr_session_start call.
+ * @param[in] xpath @ref xp_page "Data Path" identifying the subtree under which the provider is able to provide
+ * operational data.
+ * @param[in] callback Callback to be called when the operational data nder given xpat is needed.
+ * @param[in] private_ctx Private context passed to the callback function, opaque to sysrepo.
+ * @param[in] cache_ttl Time in milliseconds for which the provided data can be served from the cache.
+ * 0 disables the caching.
+ * @param[in] opts Options overriding default behavior of the subscription, it is supposed to be
+ * a bitwise OR-ed value of any ::sr_subscr_flag_t flags.
+ * @param[in,out] subscription Subscription context that is supposed to be released by ::sr_unsubscribe.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int sr_dp_get_items_subscribe_cached(sr_session_ctx_t *session, const char *xpath, sr_dp_get_items_cb callback,
+        void *private_ctx, uint32_t cache_ttl, sr_subscr_options_t opts, sr_subscription_ctx_t **subscription);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // Application-local File Descriptor Watcher API
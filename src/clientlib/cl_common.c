@@ -29,6 +29,9 @@
 
 #include "cl_common.h"
 
+#define CL_MSG_REQUEST_ID_FIELD 8  /**< Number of the request_id field of Msg in sysrepo.proto. */
+#define CL_SHM_WAKEUP_BUFF_SIZE 64 /**< Maximum number of wake-up bytes consumed at once (shared-memory transport). */
+
 /**
  * @brief Adds a new session to the session list of the connection.
  */
@@ -104,23 +107,106 @@ cl_conn_remove_session(sr_conn_ctx_t *connection, sr_session_ctx_t *session)
 }
 
 /**
- * @brief Expands message buffer of a connection to fit given size, if needed.
+ * @brief Expands a message buffer of a connection to fit given size, if needed.
  */
 static int
-cl_conn_msg_buf_expand(sr_conn_ctx_t *conn_ctx, size_t required_size)
+cl_conn_msg_buf_expand(sr_conn_ctx_t *conn_ctx, uint8_t **buf, size_t *buf_size, size_t required_size)
 {
     uint8_t *tmp = NULL;
 
-    CHECK_NULL_ARG(conn_ctx);
+    CHECK_NULL_ARG3(conn_ctx, buf, buf_size);
 
-    if (conn_ctx->msg_buf_size < required_size) {
-        tmp = realloc(conn_ctx->msg_buf, required_size * sizeof(*tmp));
+    if (*buf_size < required_size) {
+        tmp = realloc(*buf, required_size * sizeof(*tmp));
         if (NULL == tmp) {
             SR_LOG_ERR("Unable to expand message buffer of connection=%p.", (void*)conn_ctx);
             return SR_ERR_NOMEM;
         }
-        conn_ctx->msg_buf = tmp;
-        conn_ctx->msg_buf_size = required_size;
+        *buf = tmp;
+        *buf_size = required_size;
+    }
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Sends a one-byte wake-up to the Engine when the shared-memory transport is used.
+ */
+static int
+cl_shm_wakeup(sr_conn_ctx_t *conn_ctx)
+{
+    uint8_t wakeup = 0;
+
+    while (1 != send(conn_ctx->fd, &wakeup, sizeof(wakeup), 0)) {
+        if (errno == EINTR) {
+            continue;
+        }
+        SR_LOG_ERR("Error by sending of the wake-up: %s.", sr_strerror_safe(errno));
+        return SR_ERR_DISCONNECT;
+    }
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Sends data over the socket of the connection, attaching the file descriptor
+ * of the shared memory segment (SCM_RIGHTS).
+ */
+static ssize_t
+cl_socket_send_fd(sr_conn_ctx_t *conn_ctx, const uint8_t *data, size_t len, int fd)
+{
+    struct msghdr msgh = { 0, };
+    struct iovec iov = { 0, };
+    struct cmsghdr *cmsg = NULL;
+    union {
+        struct cmsghdr align;
+        char buf[CMSG_SPACE(sizeof(int))];
+    } ctrl;
+
+    memset(&ctrl, 0, sizeof(ctrl));
+    iov.iov_base = (void *)data;
+    iov.iov_len = len;
+    msgh.msg_iov = &iov;
+    msgh.msg_iovlen = 1;
+    msgh.msg_control = ctrl.buf;
+    msgh.msg_controllen = sizeof(ctrl.buf);
+
+    cmsg = CMSG_FIRSTHDR(&msgh);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+
+    return sendmsg(conn_ctx->fd, &msgh, 0);
+}
+
+/**
+ * @brief Writes the packed message into the shared-memory ring, waiting for the Engine
+ * to free some space if needed.
+ */
+static int
+cl_message_shm_send(sr_conn_ctx_t *conn_ctx, size_t len)
+{
+    size_t pos = 0;
+    bool wakeup = false;
+    int rc = SR_ERR_OK;
+
+    while (pos < len) {
+        pos += sr_shm_ring_write(&conn_ctx->shm->tx, (conn_ctx->msg_buf + pos), (len - pos), &wakeup);
+        if (wakeup) {
+            rc = cl_shm_wakeup(conn_ctx);
+            if (SR_ERR_OK != rc) {
+                return rc;
+            }
+        }
+        if (pos < len) {
+            /* the ring is full, the Engine wakes us up once it reads some data */
+            rc = sr_shm_ring_wait_space(&conn_ctx->shm->tx, SR_REQUEST_TIMEOUT);
+            if (SR_ERR_OK != rc) {
+                SR_LOG_ERR_MSG("Error by sending of the message via shared memory.");
+                return rc;
+            }
+        }
     }
 
     return SR_ERR_OK;
@@ -133,7 +219,7 @@ static int
 cl_message_send(sr_conn_ctx_t *conn_ctx, Sr__Msg *msg)
 {
     size_t msg_size = 0;
-    int pos = 0, sent = 0;
+    int pos = 0, sent = 0, shm_fd = -1;
     int rc = SR_ERR_OK;
 
     CHECK_NULL_ARG2(conn_ctx, msg);
@@ -146,7 +232,7 @@ cl_message_send(sr_conn_ctx_t *conn_ctx, Sr__Msg *msg)
     }
 
     /* expand the buffer if needed */
-    rc = cl_conn_msg_buf_expand(conn_ctx, msg_size + SR_MSG_PREAM_SIZE);
+    rc = cl_conn_msg_buf_expand(conn_ctx, &conn_ctx->msg_buf, &conn_ctx->msg_buf_size, msg_size + SR_MSG_PREAM_SIZE);
     if (SR_ERR_OK != rc) {
         SR_LOG_ERR_MSG("Cannot expand buffer for the message.");
         return rc;
@@ -158,9 +244,23 @@ cl_message_send(sr_conn_ctx_t *conn_ctx, Sr__Msg *msg)
     /* pack the message */
     sr__msg__pack(msg, (conn_ctx->msg_buf + SR_MSG_PREAM_SIZE));
 
+    if (conn_ctx->shm_active) {
+        return cl_message_shm_send(conn_ctx, msg_size + SR_MSG_PREAM_SIZE);
+    }
+
+    /* the shared memory segment offered to the Engine goes along with the version verification request */
+    if (NULL != conn_ctx->shm && NULL != msg->request && NULL != msg->request->version_verify_req &&
+            msg->request->version_verify_req->shm_offered) {
+        shm_fd = conn_ctx->shm->fd;
+    }
+
     /* send the message */
     do {
-        sent = send(conn_ctx->fd, (conn_ctx->msg_buf + pos), (msg_size + SR_MSG_PREAM_SIZE - pos), 0);
+        if (0 == pos && -1 != shm_fd) {
+            sent = cl_socket_send_fd(conn_ctx, conn_ctx->msg_buf, (msg_size + SR_MSG_PREAM_SIZE), shm_fd);
+        } else {
+            sent = send(conn_ctx->fd, (conn_ctx->msg_buf + pos), (msg_size + SR_MSG_PREAM_SIZE - pos), 0);
+        }
         if (sent > 0) {
             pos += sent;
         } else {
@@ -175,32 +275,47 @@ cl_message_send(sr_conn_ctx_t *conn_ctx, Sr__Msg *msg)
     return SR_ERR_OK;
 }
 
-/*
- * @brief Receives a message on provided connection (blocks until a message is received).
+/**
+ * @brief Receives exactly the requested amount of data on provided connection into its receive buffer.
  */
 static int
-cl_message_recv(sr_conn_ctx_t *conn_ctx, Sr__Msg **msg, sr_mem_ctx_t *sr_mem_resp)
+cl_message_recv_data(sr_conn_ctx_t *conn_ctx, size_t pos, size_t end)
 {
-    size_t len = 0, pos = 0;
-    size_t msg_size = 0;
-    sr_mem_ctx_t *sr_mem = sr_mem_resp;
-    int rc = 0;
-
-    /* expand the buffer if needed */
-    rc = cl_conn_msg_buf_expand(conn_ctx, SR_MSG_PREAM_SIZE);
-    if (SR_ERR_OK != rc) {
-        SR_LOG_ERR_MSG("Cannot expand buffer for the message.");
-        return rc;
-    }
+    uint8_t wakeups[CL_SHM_WAKEUP_BUFF_SIZE];
+    size_t read_len = 0;
+    ssize_t len = 0;
+    bool wakeup = false;
+    int rc = SR_ERR_OK;
 
-    /* read at least first 4 bytes with length of the message */
-    while (pos < SR_MSG_PREAM_SIZE) {
-        len = recv(conn_ctx->fd, conn_ctx->msg_buf, conn_ctx->msg_buf_size, 0);
+    while (pos < end) {
+        if (conn_ctx->shm_active) {
+            rc = sr_shm_ring_read(&conn_ctx->shm->rx, (conn_ctx->recv_buf + pos), (end - pos), &read_len, &wakeup);
+            if (SR_ERR_OK == rc && wakeup) {
+                /* the Engine waits for space in the ring */
+                rc = cl_shm_wakeup(conn_ctx);
+            }
+            if (SR_ERR_OK != rc) {
+                return rc;
+            }
+            if (read_len > 0) {
+                pos += read_len;
+                continue;
+            }
+            /* the ring is empty, wait for a wake-up from the Engine */
+            len = recv(conn_ctx->fd, wakeups, sizeof(wakeups), 0);
+        } else {
+            len = recv(conn_ctx->fd, (conn_ctx->recv_buf + pos), (end - pos), 0);
+        }
         if (-1 == len) {
             if (errno == EINTR) {
                 continue;
             }
             if (EAGAIN == errno || EWOULDBLOCK == errno) {
+                if (pos > 0) {
+                    /* the rest of the message would be taken for the beginning of the next one */
+                    SR_LOG_ERR_MSG("Timeout has expired in the middle of a message, the connection is unusable.");
+                    return SR_ERR_DISCONNECT;
+                }
                 SR_LOG_ERR_MSG("While waiting for a response, timeout has expired.");
                 return SR_ERR_TIME_OUT;
             }
@@ -211,9 +326,39 @@ cl_message_recv(sr_conn_ctx_t *conn_ctx, Sr__Msg **msg, sr_mem_ctx_t *sr_mem_res
             SR_LOG_ERR_MSG("Sysrepo server disconnected.");
             return SR_ERR_DISCONNECT;
         }
-        pos += len;
+        if (!conn_ctx->shm_active) {
+            pos += len;
+        }
+    }
+
+    return SR_ERR_OK;
+}
+
+/*
+ * @brief Receives one packed message on provided connection into its receive buffer
+ * (blocks until a message is received).
+ *
+ * Reads exactly one message, so that the data of the following messages stay in the socket.
+ */
+static int
+cl_message_recv(sr_conn_ctx_t *conn_ctx, size_t *msg_size_p)
+{
+    size_t msg_size = 0;
+    int rc = 0;
+
+    /* expand the buffer if needed */
+    rc = cl_conn_msg_buf_expand(conn_ctx, &conn_ctx->recv_buf, &conn_ctx->recv_buf_size, SR_MSG_PREAM_SIZE);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_ERR_MSG("Cannot expand buffer for the message.");
+        return rc;
     }
-    msg_size = sr_buff_to_uint32(conn_ctx->msg_buf);
+
+    /* read first 4 bytes with length of the message */
+    rc = cl_message_recv_data(conn_ctx, 0, SR_MSG_PREAM_SIZE);
+    if (SR_ERR_OK != rc) {
+        return rc;
+    }
+    msg_size = sr_buff_to_uint32(conn_ctx->recv_buf);
 
     /* check message size bounds */
     if ((msg_size <= 0) || (msg_size > SR_MAX_MSG_SIZE)) {
@@ -222,40 +367,37 @@ cl_message_recv(sr_conn_ctx_t *conn_ctx, Sr__Msg **msg, sr_mem_ctx_t *sr_mem_res
     }
 
     /* expand the buffer if needed */
-    rc = cl_conn_msg_buf_expand(conn_ctx, (msg_size + SR_MSG_PREAM_SIZE));
+    rc = cl_conn_msg_buf_expand(conn_ctx, &conn_ctx->recv_buf, &conn_ctx->recv_buf_size, (msg_size + SR_MSG_PREAM_SIZE));
     if (SR_ERR_OK != rc) {
         SR_LOG_ERR_MSG("Cannot expand buffer for the message.");
         return rc;
     }
 
     /* read the rest of the message */
-    while (pos < (msg_size + SR_MSG_PREAM_SIZE)) {
-        len = recv(conn_ctx->fd, (conn_ctx->msg_buf + pos), (conn_ctx->msg_buf_size - pos), 0);
-        if (-1 == len) {
-            if (errno == EINTR) {
-                continue;
-            }
-            if (EAGAIN == errno || EWOULDBLOCK == errno) {
-                SR_LOG_ERR_MSG("While waiting for a response, timeout has expired.");
-                return SR_ERR_TIME_OUT;
-            }
-            SR_LOG_ERR("Error by receiving of the message: %s.", sr_strerror_safe(errno));
-            return SR_ERR_DISCONNECT;
-        }
-        if (0 == len) {
-            SR_LOG_ERR_MSG("Sysrepo server disconnected.");
-            return SR_ERR_DISCONNECT;
-        }
-        pos += len;
+    rc = cl_message_recv_data(conn_ctx, SR_MSG_PREAM_SIZE, (msg_size + SR_MSG_PREAM_SIZE));
+    if (SR_ERR_OK != rc) {
+        return rc;
     }
 
-    /* unpack the message */
+    *msg_size_p = msg_size;
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Unpacks a received message.
+ */
+static int
+cl_message_unpack(const uint8_t *msg_data, size_t msg_size, sr_mem_ctx_t *sr_mem_resp, Sr__Msg **msg)
+{
+    sr_mem_ctx_t *sr_mem = sr_mem_resp;
+    int rc = SR_ERR_OK;
+
     if (NULL == sr_mem) {
         rc = sr_mem_new(msg_size, &sr_mem);
         CHECK_RC_MSG_RETURN(rc, "Failed to create a new Sysrepo memory context.");
     }
     ProtobufCAllocator allocator = sr_get_protobuf_allocator(sr_mem);
-    *msg = sr__msg__unpack(&allocator, msg_size, (const uint8_t*)(conn_ctx->msg_buf + SR_MSG_PREAM_SIZE));
+    *msg = sr__msg__unpack(&allocator, msg_size, msg_data);
     if (NULL == *msg) {
         if (NULL == sr_mem_resp) {
             sr_mem_free(sr_mem);
@@ -273,6 +415,423 @@ cl_message_recv(sr_conn_ctx_t *conn_ctx, Sr__Msg **msg, sr_mem_ctx_t *sr_mem_res
     return SR_ERR_OK;
 }
 
+/**
+ * @brief Reads a varint from the packed GPB message.
+ */
+static bool
+cl_gpb_varint_read(const uint8_t *data, size_t size, size_t *pos, uint64_t *value)
+{
+    unsigned shift = 0;
+
+    *value = 0;
+    while (*pos < size && shift < 64) {
+        *value |= ((uint64_t)(data[*pos] & 0x7f)) << shift;
+        if (0 == (data[(*pos)++] & 0x80)) {
+            return true;
+        }
+        shift += 7;
+    }
+    return false;
+}
+
+/**
+ * @brief Finds out the request identifier of the packed GPB message without unpacking it.
+ *
+ * Only top-level fields of the message are walked through, nested messages are skipped.
+ *
+ * @return Request identifier, 0 if the message does not contain it.
+ */
+static uint64_t
+cl_gpb_msg_request_id_peek(const uint8_t *data, size_t size)
+{
+    size_t pos = 0;
+    uint64_t key = 0, value = 0;
+
+    while (pos < size) {
+        if (!cl_gpb_varint_read(data, size, &pos, &key)) {
+            return 0;
+        }
+        switch (key & 0x7) {
+            case 0: /* varint */
+                if (!cl_gpb_varint_read(data, size, &pos, &value)) {
+                    return 0;
+                }
+                if (CL_MSG_REQUEST_ID_FIELD == (key >> 3)) {
+                    return value;
+                }
+                break;
+            case 1: /* 64-bit */
+                pos += 8;
+                break;
+            case 2: /* length-delimited */
+                if (!cl_gpb_varint_read(data, size, &pos, &value) || value > (size - pos)) {
+                    return 0;
+                }
+                pos += value;
+                break;
+            case 5: /* 32-bit */
+                pos += 4;
+                break;
+            default:
+                return 0;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Hands over the message just received by the reader to the matching pending request.
+ * Called with resp_lock held.
+ */
+static void
+cl_conn_resp_dispatch(sr_conn_ctx_t *conn_ctx, cl_pending_req_t *reader_req, int recv_rc, size_t msg_size)
+{
+    cl_pending_req_t *req = NULL, *iter = NULL;
+    uint64_t request_id = 0;
+    size_t pending_cnt = 0;
+
+    if (SR_ERR_OK != recv_rc) {
+        if (SR_ERR_TIME_OUT == recv_rc) {
+            /* nothing came within the timeout, fail the request of the reader and all requests
+             * (synchronous or asynchronous) waiting longer than the timeout */
+            if (NULL != reader_req) {
+                reader_req->rc = recv_rc;
+                reader_req->done = true;
+            }
+            for (req = conn_ctx->pending_reqs; NULL != req; req = req->next) {
+                if (!req->done && (time(NULL) - req->sent_time) >= SR_REQUEST_TIMEOUT) {
+                    req->rc = recv_rc;
+                    req->done = true;
+                }
+            }
+        } else {
+            /* the connection is unusable, fail all pending requests */
+            conn_ctx->broken = true;
+            for (req = conn_ctx->pending_reqs; NULL != req; req = req->next) {
+                if (!req->done) {
+                    req->rc = recv_rc;
+                    req->done = true;
+                }
+            }
+        }
+        return;
+    }
+
+    request_id = cl_gpb_msg_request_id_peek(conn_ctx->recv_buf + SR_MSG_PREAM_SIZE, msg_size);
+
+    /* find matching request */
+    if (0 != request_id) {
+        for (req = conn_ctx->pending_reqs; NULL != req; req = req->next) {
+            if (!req->done && req->request_id == request_id) {
+                break;
+            }
+        }
+    } else {
+        /* a response without an id can be matched only if a single request is pending */
+        for (iter = conn_ctx->pending_reqs; NULL != iter; iter = iter->next) {
+            if (!iter->done) {
+                pending_cnt++;
+                req = iter;
+            }
+        }
+        if (pending_cnt > 1) {
+            req = NULL;
+        }
+    }
+    if (NULL == req) {
+        SR_LOG_WRN("Response to an unknown request (id=%"PRIu64") received, ignoring.", request_id);
+        return;
+    }
+
+    /* pass the buffer to the request, the reader will allocate a new one */
+    req->resp_buf = conn_ctx->recv_buf;
+    req->resp_size = msg_size;
+    req->rc = SR_ERR_OK;
+    req->done = true;
+    conn_ctx->recv_buf = NULL;
+    conn_ctx->recv_buf_size = 0;
+}
+
+/**
+ * @brief Tags the request with a new request id and appends it to the list of pending requests
+ * of the connection. Called with the connection lock held.
+ *
+ * @return Error code (SR_ERR_OK on success), SR_ERR_DISCONNECT if the connection is unusable.
+ */
+static int
+cl_conn_pending_req_add(sr_conn_ctx_t *conn_ctx, Sr__Msg *msg_req, cl_pending_req_t *req)
+{
+    cl_pending_req_t **iter = NULL;
+
+    req->request_id = ++conn_ctx->last_request_id;
+    msg_req->has_request_id = true;
+    msg_req->request_id = req->request_id;
+
+    pthread_mutex_lock(&conn_ctx->resp_lock);
+    if (conn_ctx->broken) {
+        pthread_mutex_unlock(&conn_ctx->resp_lock);
+        SR_LOG_ERR_MSG("The connection to the Sysrepo Engine is unusable, the request can not be sent.");
+        return SR_ERR_DISCONNECT;
+    }
+    iter = &conn_ctx->pending_reqs;
+    while (NULL != *iter) {
+        iter = &(*iter)->next;
+    }
+    *iter = req;
+    pthread_mutex_unlock(&conn_ctx->resp_lock);
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Removes a request from the list of pending requests of the connection.
+ * Called with resp_lock held.
+ */
+static void
+cl_conn_pending_req_remove(sr_conn_ctx_t *conn_ctx, cl_pending_req_t *req)
+{
+    cl_pending_req_t **iter = &conn_ctx->pending_reqs;
+
+    while (NULL != *iter) {
+        if (req == *iter) {
+            *iter = req->next;
+            break;
+        }
+        iter = &(*iter)->next;
+    }
+}
+
+/**
+ * @brief Sends the request over the connection and waits for the response with matching request id.
+ *
+ * No dedicated thread reads from the socket - the first waiting thread takes the reader role,
+ * reads one message, hands it over to its recipient and releases the role again.
+ */
+static int
+cl_conn_request_process(sr_conn_ctx_t *conn_ctx, Sr__Msg *msg_req, Sr__Msg **msg_resp, sr_mem_ctx_t *sr_mem_resp)
+{
+    cl_pending_req_t req = { 0, };
+    size_t msg_size = 0;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(conn_ctx, msg_req, msg_resp);
+
+    req.sent_time = time(NULL);
+
+    pthread_mutex_lock(&conn_ctx->lock);
+
+    /* tag the request and register it before sending, the response may come at any time then */
+    rc = cl_conn_pending_req_add(conn_ctx, msg_req, &req);
+
+    /* send the request */
+    if (SR_ERR_OK == rc) {
+        rc = cl_message_send(conn_ctx, msg_req);
+    }
+    pthread_mutex_unlock(&conn_ctx->lock);
+
+    pthread_mutex_lock(&conn_ctx->resp_lock);
+    if (SR_ERR_OK != rc) {
+        cl_conn_pending_req_remove(conn_ctx, &req);
+        pthread_mutex_unlock(&conn_ctx->resp_lock);
+        return rc;
+    }
+
+    /* wait for the response, read from the socket if nobody else does */
+    while (!req.done) {
+        if (conn_ctx->reader_active) {
+            pthread_cond_wait(&conn_ctx->resp_cv, &conn_ctx->resp_lock);
+        } else {
+            conn_ctx->reader_active = true;
+            pthread_mutex_unlock(&conn_ctx->resp_lock);
+
+            rc = cl_message_recv(conn_ctx, &msg_size);
+
+            pthread_mutex_lock(&conn_ctx->resp_lock);
+            cl_conn_resp_dispatch(conn_ctx, &req, rc, msg_size);
+            conn_ctx->reader_active = false;
+            pthread_cond_broadcast(&conn_ctx->resp_cv);
+        }
+    }
+    cl_conn_pending_req_remove(conn_ctx, &req);
+    pthread_mutex_unlock(&conn_ctx->resp_lock);
+
+    if (SR_ERR_OK != req.rc) {
+        return req.rc;
+    }
+
+    /* unpack the response */
+    rc = cl_message_unpack(req.resp_buf + SR_MSG_PREAM_SIZE, req.resp_size, sr_mem_resp, msg_resp);
+    free(req.resp_buf);
+
+    return rc;
+}
+
+/**
+ * @brief Validates the response and logs the error it carries (except the expected ones).
+ *
+ * @return Error code (SR_ERR_OK on success), the result of the request if it failed.
+ */
+static int
+cl_response_validate(uint32_t session_id, Sr__Msg *msg_resp, const Sr__Operation expected_response_op)
+{
+    int rc = SR_ERR_OK;
+
+    /* validate the response */
+    rc = sr_gpb_msg_validate(msg_resp, SR__MSG__MSG_TYPE__RESPONSE, expected_response_op);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_ERR("Malformed message with response received (session id=%"PRIu32", operation=%s).",
+                session_id, sr_gpb_operation_name(expected_response_op));
+        return rc;
+    }
+
+    /* log the error (except expected ones) */
+    if (SR_ERR_OK != msg_resp->response->result &&
+            SR_ERR_NOT_FOUND != msg_resp->response->result &&
+            SR_ERR_VALIDATION_FAILED != msg_resp->response->result &&
+            SR_ERR_UNAUTHORIZED != msg_resp->response->result &&
+            SR_ERR_OPERATION_FAILED != msg_resp->response->result) {
+        SR_LOG_ERR("Error by processing of the %s request (session id=%"PRIu32"): %s.",
+                sr_gpb_operation_name(expected_response_op), session_id,
+            (NULL != msg_resp->response->error && NULL != msg_resp->response->error->message) ?
+                    msg_resp->response->error->message : sr_strerror(msg_resp->response->result));
+    }
+
+    return msg_resp->response->result;
+}
+
+/**
+ * @brief Validates the response and stores the error information from it into the session.
+ * Used only for synchronous requests, the session error information belongs to the calling thread.
+ */
+static int
+cl_response_check(sr_session_ctx_t *session, Sr__Msg *msg_resp, const Sr__Operation expected_response_op)
+{
+    int rc = SR_ERR_OK;
+
+    rc = cl_response_validate(session->id, msg_resp, expected_response_op);
+    if (SR_ERR_OK != rc && NULL != msg_resp->response && SR_ERR_OK != msg_resp->response->result &&
+            NULL != msg_resp->response->error) {
+        /* set detailed error information into session */
+        cl_session_set_error(session, msg_resp->response->error->message, msg_resp->response->error->xpath);
+    }
+
+    return rc;
+}
+
+/**
+ * @brief Completes an asynchronous request - unpacks and checks the response and calls the callback.
+ * Called without any connection lock held.
+ */
+static void
+cl_async_req_complete(cl_pending_req_t *req)
+{
+    Sr__Msg *msg_resp = NULL;
+    int rc = req->rc;
+
+    if (SR_ERR_OK == rc) {
+        rc = cl_message_unpack(req->resp_buf + SR_MSG_PREAM_SIZE, req->resp_size, NULL, &msg_resp);
+    }
+    if (SR_ERR_OK == rc) {
+        /* the error information is passed to the callback in the response, not stored in the session,
+         * which may be used by a synchronous call at the same time */
+        rc = cl_response_validate(req->session->id, msg_resp, req->operation);
+    } else {
+        SR_LOG_ERR("Unable to process the asynchronous request (session id=%"PRIu32", operation=%s).",
+                req->session->id, sr_gpb_operation_name(req->operation));
+    }
+
+    req->callback(req->session, rc, msg_resp, req->callback_data);
+
+    free(req->resp_buf);
+    free(req);
+}
+
+/**
+ * @brief Dispatcher thread of asynchronous requests. Reads the responses from the socket
+ * while there are some asynchronous requests pending and nobody else is reading,
+ * completes the asynchronous requests whose responses have been received.
+ */
+static void *
+cl_async_thread_execute(void *conn_ctx_p)
+{
+    sr_conn_ctx_t *conn_ctx = (sr_conn_ctx_t*)conn_ctx_p;
+    cl_pending_req_t *req = NULL;
+    size_t msg_size = 0;
+    int rc = SR_ERR_OK;
+
+    pthread_mutex_lock(&conn_ctx->resp_lock);
+    while (!conn_ctx->async_thread_stop) {
+        /* look for a completed asynchronous request */
+        for (req = conn_ctx->pending_reqs; NULL != req; req = req->next) {
+            if (req->done && NULL != req->callback) {
+                break;
+            }
+        }
+        if (NULL != req) {
+            cl_conn_pending_req_remove(conn_ctx, req);
+            conn_ctx->async_req_cnt -= 1;
+            pthread_mutex_unlock(&conn_ctx->resp_lock);
+            cl_async_req_complete(req);
+            pthread_mutex_lock(&conn_ctx->resp_lock);
+        } else if (conn_ctx->async_req_cnt > 0 && !conn_ctx->reader_active) {
+            /* take the reader role */
+            conn_ctx->reader_active = true;
+            pthread_mutex_unlock(&conn_ctx->resp_lock);
+
+            rc = cl_message_recv(conn_ctx, &msg_size);
+
+            pthread_mutex_lock(&conn_ctx->resp_lock);
+            cl_conn_resp_dispatch(conn_ctx, NULL, rc, msg_size);
+            conn_ctx->reader_active = false;
+            pthread_cond_broadcast(&conn_ctx->resp_cv);
+        } else {
+            pthread_cond_wait(&conn_ctx->resp_cv, &conn_ctx->resp_lock);
+        }
+    }
+    pthread_mutex_unlock(&conn_ctx->resp_lock);
+
+    return NULL;
+}
+
+/**
+ * @brief Stops the dispatcher thread of asynchronous requests and fails
+ * all asynchronous requests that have not been completed yet.
+ */
+static void
+cl_async_thread_stop(sr_conn_ctx_t *conn_ctx)
+{
+    cl_pending_req_t *req = NULL, *next = NULL;
+
+    pthread_mutex_lock(&conn_ctx->resp_lock);
+    if (!conn_ctx->async_thread_running) {
+        pthread_mutex_unlock(&conn_ctx->resp_lock);
+        return;
+    }
+    conn_ctx->async_thread_stop = true;
+    pthread_cond_broadcast(&conn_ctx->resp_cv);
+    pthread_mutex_unlock(&conn_ctx->resp_lock);
+
+    /* unblock the thread if it is waiting on the socket */
+    if (-1 != conn_ctx->fd) {
+        shutdown(conn_ctx->fd, SHUT_RDWR);
+    }
+    pthread_join(conn_ctx->async_thread, NULL);
+    conn_ctx->async_thread_running = false;
+
+    for (req = conn_ctx->pending_reqs; NULL != req; req = next) {
+        next = req->next;
+        if (NULL != req->callback) {
+            cl_conn_pending_req_remove(conn_ctx, req);
+            if (!req->done) {
+                req->rc = SR_ERR_DISCONNECT;
+            }
+            cl_async_req_complete(req);
+        }
+    }
+    conn_ctx->async_req_cnt = 0;
+}
+
 int
 cl_connection_create(sr_conn_ctx_t **conn_ctx_p)
 {
@@ -291,6 +850,23 @@ cl_connection_create(sr_conn_ctx_t **conn_ctx_p)
         return SR_ERR_INIT_FAILED;
     }
 
+    /* init response demultiplexing */
+    rc = pthread_mutex_init(&connection->resp_lock, NULL);
+    if (0 != rc) {
+        SR_LOG_ERR_MSG("Cannot initialize connection response mutex.");
+        pthread_mutex_destroy(&connection->lock);
+        free(connection);
+        return SR_ERR_INIT_FAILED;
+    }
+    rc = pthread_cond_init(&connection->resp_cv, NULL);
+    if (0 != rc) {
+        SR_LOG_ERR_MSG("Cannot initialize connection response condition variable.");
+        pthread_mutex_destroy(&connection->resp_lock);
+        pthread_mutex_destroy(&connection->lock);
+        free(connection);
+        return SR_ERR_INIT_FAILED;
+    }
+
     connection->fd = -1;
 
     *conn_ctx_p = connection;
@@ -303,6 +879,9 @@ cl_connection_cleanup(sr_conn_ctx_t *conn_ctx)
     sr_session_list_t *session = NULL, *tmp = NULL;
 
     if (NULL != conn_ctx) {
+        /* complete pending asynchronous requests while the sessions still exist */
+        cl_async_thread_stop(conn_ctx);
+
         /* destroy all sessions */
         session = conn_ctx->session_list;
         while (NULL != session) {
@@ -312,8 +891,12 @@ cl_connection_cleanup(sr_conn_ctx_t *conn_ctx)
         }
 
         pthread_mutex_destroy(&conn_ctx->lock);
+        pthread_mutex_destroy(&conn_ctx->resp_lock);
+        pthread_cond_destroy(&conn_ctx->resp_cv);
         free(conn_ctx->msg_buf);
+        free(conn_ctx->recv_buf);
         free((void*)conn_ctx->dst_address);
+        sr_shm_transport_cleanup(conn_ctx->shm);
         if (-1 != conn_ctx->fd) {
             close(conn_ctx->fd);
         }
@@ -427,29 +1010,25 @@ cl_version_verify(sr_conn_ctx_t *connection)
     sr_mem_edit_string(sr_mem, &msg_req->request->version_verify_req->soname, SR_COMPAT_VERSION);
     CHECK_NULL_NOMEM_GOTO(msg_req->request->version_verify_req->soname, rc, cleanup);
 
-    /* send the request */
-    SR_LOG_DBG("Sending %s request.", sr_gpb_operation_name(SR__OPERATION__VERSION_VERIFY));
-
-    pthread_mutex_lock(&connection->lock);
-    rc = cl_message_send(connection, msg_req);
-    if (SR_ERR_OK != rc) {
-        SR_LOG_ERR("Unable to send the message with request (operation=%s).",
-                   sr_gpb_operation_name(msg_req->request->operation));
-        pthread_mutex_unlock(&connection->lock);
-        goto cleanup;
+    /* offer the shared-memory transport to the daemon */
+    if (!connection->library_mode && NULL == connection->shm && sr_shm_transport_enabled()) {
+        if (SR_ERR_OK == sr_shm_transport_create(SR_SHM_RING_SIZE * 1024, &connection->shm)) {
+            msg_req->request->version_verify_req->has_shm_offered = true;
+            msg_req->request->version_verify_req->shm_offered = true;
+        } else {
+            SR_LOG_WRN_MSG("Unable to create the shared-memory transport, using the socket only.");
+        }
     }
 
-    SR_LOG_DBG("%s request sent, waiting for response.", sr_gpb_operation_name(SR__OPERATION__VERSION_VERIFY));
+    /* send the request */
+    SR_LOG_DBG("Sending %s request.", sr_gpb_operation_name(SR__OPERATION__VERSION_VERIFY));
 
-    /* receive the response */
-    rc = cl_message_recv(connection, &msg_resp, NULL);
+    rc = cl_conn_request_process(connection, msg_req, &msg_resp, NULL);
     if (SR_ERR_OK != rc) {
-        SR_LOG_ERR("Unable to receive the message with response (operation=%s).",
+        SR_LOG_ERR("Unable to process the request (operation=%s).",
                    sr_gpb_operation_name(msg_req->request->operation));
-        pthread_mutex_unlock(&connection->lock);
         goto cleanup;
     }
-    pthread_mutex_unlock(&connection->lock);
 
     SR_LOG_DBG("%s response received, processing.", sr_gpb_operation_name(SR__OPERATION__VERSION_VERIFY));
 
@@ -469,7 +1048,20 @@ cl_version_verify(sr_conn_ctx_t *connection)
         goto cleanup;
     }
 
+    if (NULL != connection->shm && msg_resp->response->version_verify_resp->shm_accepted) {
+        SR_LOG_DBG("Connection to the daemon switched to the shared-memory transport (fd=%d).", connection->fd);
+        connection->shm_active = true;
+        /* the segment stays mapped, its descriptor is not needed anymore */
+        close(connection->shm->fd);
+        connection->shm->fd = -1;
+    }
+
 cleanup:
+    if (NULL != connection->shm && !connection->shm_active) {
+        /* not accepted by the Engine */
+        sr_shm_transport_cleanup(connection->shm);
+        connection->shm = NULL;
+    }
     if (NULL != msg_req) {
         sr_msg_free(msg_req);
     } else {
@@ -492,58 +1084,75 @@ cl_request_process(sr_session_ctx_t *session, Sr__Msg *msg_req, Sr__Msg **msg_re
 
     SR_LOG_DBG("Sending %s request.", sr_gpb_operation_name(expected_response_op));
 
-    pthread_mutex_lock(&session->conn_ctx->lock);
-
-    /* send the request */
-    rc = cl_message_send(session->conn_ctx, msg_req);
+    /* send the request and receive the response */
+    rc = cl_conn_request_process(session->conn_ctx, msg_req, msg_resp, sr_mem_resp);
     if (SR_ERR_OK != rc) {
-        SR_LOG_ERR("Unable to send the message with request (session id=%"PRIu32", operation=%s).",
+        SR_LOG_ERR("Unable to process the request (session id=%"PRIu32", operation=%s).",
                 session->id, sr_gpb_operation_name(msg_req->request->operation));
-        pthread_mutex_unlock(&session->conn_ctx->lock);
         return rc;
     }
 
-    SR_LOG_DBG("%s request sent, waiting for response.", sr_gpb_operation_name(expected_response_op));
+    SR_LOG_DBG("%s response received, processing.", sr_gpb_operation_name(expected_response_op));
 
-    /* receive the response */
-    rc = cl_message_recv(session->conn_ctx, msg_resp, sr_mem_resp);
-    if (SR_ERR_OK != rc) {
-        SR_LOG_ERR("Unable to receive the message with response (session id=%"PRIu32", operation=%s).",
-                session->id, sr_gpb_operation_name(msg_req->request->operation));
-        pthread_mutex_unlock(&session->conn_ctx->lock);
-        return rc;
-    }
+    /* validate the response and check for errors */
+    return cl_response_check(session, *msg_resp, expected_response_op);
+}
 
-    pthread_mutex_unlock(&session->conn_ctx->lock);
+int
+cl_request_process_async(sr_session_ctx_t *session, Sr__Msg *msg_req, const Sr__Operation expected_response_op,
+        cl_resp_cb callback, void *data)
+{
+    sr_conn_ctx_t *conn_ctx = NULL;
+    cl_pending_req_t *req = NULL;
+    int rc = SR_ERR_OK;
 
-    SR_LOG_DBG("%s response received, processing.", sr_gpb_operation_name(expected_response_op));
+    CHECK_NULL_ARG4(session, session->conn_ctx, msg_req, callback);
+    conn_ctx = session->conn_ctx;
+
+    SR_LOG_DBG("Sending asynchronous %s request.", sr_gpb_operation_name(expected_response_op));
+
+    req = calloc(1, sizeof(*req));
+    CHECK_NULL_NOMEM_RETURN(req);
+    req->session = session;
+    req->operation = expected_response_op;
+    req->callback = callback;
+    req->callback_data = data;
+    req->sent_time = time(NULL);
+
+    /* start the dispatcher thread if not running yet */
+    pthread_mutex_lock(&conn_ctx->resp_lock);
+    if (!conn_ctx->async_thread_running) {
+        rc = pthread_create(&conn_ctx->async_thread, NULL, cl_async_thread_execute, conn_ctx);
+        if (0 != rc) {
+            SR_LOG_ERR("Unable to start the dispatcher thread of asynchronous requests: %s.", sr_strerror_safe(rc));
+            pthread_mutex_unlock(&conn_ctx->resp_lock);
+            free(req);
+            return SR_ERR_INTERNAL;
+        }
+        conn_ctx->async_thread_running = true;
+    }
+    conn_ctx->async_req_cnt += 1;
+    pthread_mutex_unlock(&conn_ctx->resp_lock);
 
-    /* validate the response */
-    rc = sr_gpb_msg_validate(*msg_resp, SR__MSG__MSG_TYPE__RESPONSE, expected_response_op);
-    if (SR_ERR_OK != rc) {
-        SR_LOG_ERR("Malformed message with response received (session id=%"PRIu32", operation=%s).",
-                session->id, sr_gpb_operation_name(msg_req->request->operation));
-        return rc;
+    pthread_mutex_lock(&conn_ctx->lock);
+    rc = cl_conn_pending_req_add(conn_ctx, msg_req, req);
+    if (SR_ERR_OK == rc) {
+        rc = cl_message_send(conn_ctx, msg_req);
     }
+    pthread_mutex_unlock(&conn_ctx->lock);
 
-    /* check for errors */
-    if (SR_ERR_OK != (*msg_resp)->response->result) {
-        if (NULL != (*msg_resp)->response->error) {
-            /* set detailed error information into session */
-            rc = cl_session_set_error(session, (*msg_resp)->response->error->message, (*msg_resp)->response->error->xpath);
-        }
-        /* log the error (except expected ones) */
-        if (SR_ERR_NOT_FOUND != (*msg_resp)->response->result &&
-                SR_ERR_VALIDATION_FAILED != (*msg_resp)->response->result &&
-                SR_ERR_UNAUTHORIZED != (*msg_resp)->response->result &&
-                SR_ERR_OPERATION_FAILED != (*msg_resp)->response->result) {
-            SR_LOG_ERR("Error by processing of the %s request (session id=%"PRIu32"): %s.",
-                    sr_gpb_operation_name(msg_req->request->operation), session->id,
-                (NULL != (*msg_resp)->response->error && NULL != (*msg_resp)->response->error->message) ?
-                        (*msg_resp)->response->error->message : sr_strerror((*msg_resp)->response->result));
-        }
-        return (*msg_resp)->response->result;
+    pthread_mutex_lock(&conn_ctx->resp_lock);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_ERR("Unable to send the request (session id=%"PRIu32", operation=%s).",
+                session->id, sr_gpb_operation_name(expected_response_op));
+        cl_conn_pending_req_remove(conn_ctx, req);
+        conn_ctx->async_req_cnt -= 1;
+        free(req);
+    } else {
+        /* wake up the dispatcher thread to start reading */
+        pthread_cond_broadcast(&conn_ctx->resp_cv);
     }
+    pthread_mutex_unlock(&conn_ctx->resp_lock);
 
     return rc;
 }
@@ -23,6 +23,7 @@
 #define CL_COMMON_H_
 
 #include <pthread.h>
+#include <time.h>
 #include "sr_common.h"
 
 /**
@@ -30,6 +31,35 @@
  */
 typedef struct cm_ctx_s cm_ctx_t;
 
+struct sr_session_ctx_s;
+
+/**
+ * @brief Callback called when the response to an asynchronous request is received.
+ *
+ * @param[in] session Session context the request has been sent on.
+ * @param[in] rc Result of the request (including the error code from the response).
+ * @param[in] msg_resp GPB message with the response (NULL if not received), to be freed by the callback.
+ * @param[in] data Data passed to ::cl_request_process_async.
+ */
+typedef void (*cl_resp_cb)(struct sr_session_ctx_s *session, int rc, Sr__Msg *msg_resp, void *data);
+
+/**
+ * @brief Request waiting for its response on a connection.
+ */
+typedef struct cl_pending_req_s {
+    uint64_t request_id;              /**< Identifier of the request assigned by the connection. */
+    bool done;                        /**< TRUE if the response has been received or an error occurred. */
+    int rc;                           /**< Error code of the receive operation. */
+    uint8_t *resp_buf;                /**< Buffer holding the packed response (preamble included). */
+    size_t resp_size;                 /**< Size of the packed response (without the preamble). */
+    struct sr_session_ctx_s *session; /**< Session of an asynchronous request (NULL for synchronous ones). */
+    Sr__Operation operation;          /**< Expected operation of the response to an asynchronous request. */
+    cl_resp_cb callback;              /**< Callback of an asynchronous request. */
+    void *callback_data;              /**< Data passed to the callback of an asynchronous request. */
+    time_t sent_time;                 /**< Time when the request has been sent (used for timeout). */
+    struct cl_pending_req_s *next;    /**< Next request in the linked-list. */
+} cl_pending_req_t;
+
 /**
  * @brief Connection context used to identify a connection to sysrepo datastore.
  */
@@ -38,13 +68,30 @@ typedef struct sr_conn_ctx_s {
     const char *dst_address;                 /**< Destination socket address. */
     uint32_t dst_pid;                        /**< Destination PID (used only to to guarantee that there is
                                                   still the same process at the dst_address). */
-    pthread_mutex_t lock;                    /**< Mutex of the connection to guarantee that requests on the
-                                                  same connection are processed serially (one after another). */
-    uint8_t *msg_buf;                        /**< Buffer used for sending / receiving messages. */
+    pthread_mutex_t lock;                    /**< Mutex of the connection guarding the session list and
+                                                  sending of the messages (one message at a time). */
+    uint8_t *msg_buf;                        /**< Buffer used for sending messages. */
     size_t msg_buf_size;                     /**< Length of the message buffer. */
+    uint64_t last_request_id;                /**< Identifier assigned to the last request sent over the connection. */
+
+    pthread_mutex_t resp_lock;               /**< Mutex guarding the list of pending requests and the reader role. */
+    pthread_cond_t resp_cv;                  /**< Condition signalled when a response has been received or the reader role released. */
+    cl_pending_req_t *pending_reqs;          /**< Linked-list of requests waiting for their responses. */
+    bool reader_active;                      /**< TRUE if one of the waiting threads is reading from the socket. */
+    bool broken;                             /**< TRUE if the stream of messages got out of sync (e.g. a message has been
+                                                  read only partially), the connection can not be used any more. */
+    uint8_t *recv_buf;                       /**< Buffer used for receiving messages (owned by the reader). */
+    size_t recv_buf_size;                    /**< Length of the receive buffer. */
+    size_t async_req_cnt;                    /**< Number of asynchronous requests not completed yet. */
+    bool async_thread_running;               /**< TRUE if the dispatcher thread of asynchronous requests has been started. */
+    bool async_thread_stop;                  /**< Request to stop the dispatcher thread. */
+    pthread_t async_thread;                  /**< Thread receiving the responses to and calling callbacks of asynchronous requests. */
     struct sr_session_list_s *session_list;  /**< Linked-list of associated sessions. */
     bool library_mode;                       /**< Determine if we are connected to sysrepo daemon
                                                   or our own sysrepo engine (library mode). */
+    sr_shm_transport_t *shm;                 /**< Shared-memory transport offered to / accepted by the Engine (NULL if not used). */
+    bool shm_active;                         /**< TRUE if the messages are transferred via the shared-memory transport,
+                                                  the socket then carries only wake-up bytes. */
 } sr_conn_ctx_t;
 
 /**
@@ -60,6 +107,9 @@ typedef struct sr_session_ctx_s {
     size_t error_cnt;             /**< Number of errors that occurred within last API call. */
     bool notif_session;           /**< Distinguishes internal notification session from other ones. */
     uint32_t commit_id;           /**< ID of the commit in case that this is a notification session (0 otherwise). */
+    uint32_t subscription_id;     /**< ID of the subscription whose callbacks use this notification session (0 otherwise). */
+    char *changes_xpath;          /**< XPath of the changes delivered within the notification being processed (NULL if none). */
+    Sr__Msg *changes_msg;         /**< Notification message being processed that carries the changes selected by changes_xpath. */
 } sr_session_ctx_t;
 
 /**
@@ -125,6 +175,10 @@ int cl_version_verify(sr_conn_ctx_t *connection);
 /**
  * @brief Processes (sends) the request over the connection and receive the response.
  *
+ * Multiple requests can be outstanding on the same connection at a time. Each request
+ * is tagged with a unique identifier, one of the waiting threads reads responses from
+ * the socket and hands them over to the matching requests.
+ *
  * @param[in] session Session context acquired by ::cl_session_create call.
  * @param[in] msg_req GPB message with the request to be sent.
  * @param[out] msg_resp GPB message with the response.
@@ -137,6 +191,24 @@ int cl_version_verify(sr_conn_ctx_t *connection);
 int cl_request_process(sr_session_ctx_t *session, Sr__Msg *msg_req, Sr__Msg **msg_resp,
         sr_mem_ctx_t *sr_mem_resp, const Sr__Operation expected_response_op);
 
+/**
+ * @brief Sends the request over the connection without waiting for the response.
+ *
+ * The response is received by the dispatcher thread of the connection (started on
+ * the first asynchronous request), which calls the provided callback. The request
+ * message can be released right after the call.
+ *
+ * @param[in] session Session context acquired by ::cl_session_create call.
+ * @param[in] msg_req GPB message with the request to be sent.
+ * @param[in] expected_response_op Expected message type of the response.
+ * @param[in] callback Callback called when the response is received.
+ * @param[in] data Data passed to the callback.
+ *
+ * @return Error code (SR_ERR_OK on success). The callback is not called if the request has not been sent.
+ */
+int cl_request_process_async(sr_session_ctx_t *session, Sr__Msg *msg_req, const Sr__Operation expected_response_op,
+        cl_resp_cb callback, void *data);
+
 /**
  * @brief Sets detailed error information into session context.
  *
@@ -71,6 +71,8 @@ typedef struct cl_sm_ctx_s {
 
     /** Binary tree of data connections to sysrepo, organized by destination socket address. */
     sr_btree_t *data_connection_btree;
+    /** Lock for the data connections binary tree and the sessions of the data connections. */
+    pthread_mutex_t data_connection_lock;
 
     /** Binary tree used for fast subscription lookup by id. */
     sr_btree_t *subscriptions_btree;
@@ -98,6 +100,25 @@ typedef struct cl_sm_ctx_s {
     ev_async server_ctx_watcher;
     /** Blocking synchronization of processing of all pending events */
     sr_fd_sm_terminated_cb local_watcher_terminate_cb;
+    /** Identifier assigned to the last accepted subscriber connection. */
+    uint32_t last_conn_id;
+
+    /** Worker threads calling the callbacks of change subscriptions (NULL if the callbacks are called from the event loop). */
+    pthread_t *notif_workers;
+    /** Count of started worker threads. */
+    size_t notif_worker_cnt;
+    /** Linked-list of notifications waiting for / being processed by the worker threads, in the order of arrival. */
+    sr_llist_t *notif_jobs;
+    /** Linked-list of processed notifications whose ACKs are to be sent from the event loop. */
+    sr_llist_t *notif_acks;
+    /** Lock for the notification linked-lists and notification counters of the subscriptions. */
+    pthread_mutex_t notif_lock;
+    /** Condition signalled when a notification has been queued or processed, or the worker threads should stop. */
+    pthread_cond_t notif_cv;
+    /** Request to stop the worker threads. */
+    bool notif_workers_stop;
+    /** Watcher for processed notifications whose ACKs are to be sent. */
+    ev_async notif_ack_watcher;
 } cl_sm_ctx_t;
 
 /**
@@ -116,6 +137,7 @@ typedef struct cl_sm_buffer_s {
 typedef struct cl_sm_conn_ctx_s {
     cl_sm_ctx_t *sm_ctx;      /**< Pointer to Subscription Manger context. */
     int fd;                   /**< File descriptor of the connection. */
+    uint32_t id;              /**< Identifier of the connection, unique within the Subscription Manager. */
     cl_sm_buffer_t in_buff;   /**< Input buffer. If not empty, there is some received data to be processed. */
     cl_sm_buffer_t out_buff;  /**< Output buffer. If not empty, there is some data to be sent when receiver is ready. */
     ev_io read_watcher;       /**< Watcher for readable events on connection's socket. */
@@ -123,6 +145,19 @@ typedef struct cl_sm_conn_ctx_s {
     bool close_requested;     /**< TRUE if connection close has been requested. */
 } cl_sm_conn_ctx_t;
 
+/**
+ * @brief Notification to be processed by a worker thread of Subscription Manager.
+ */
+typedef struct cl_sm_notif_job_s {
+    cl_sm_subscription_ctx_t *subscription;  /**< Subscription the notification belongs to. */
+    int conn_fd;                             /**< File descriptor of the connection the notification came from. */
+    uint32_t conn_id;                        /**< Identifier of the connection the notification came from. */
+    Sr__Msg *msg;                            /**< Notification message. */
+    Sr__Msg *ack_msg;                        /**< ACK of the notification to be sent, NULL if none. */
+    bool in_progress;                        /**< TRUE if a worker thread is processing the notification. */
+    pthread_t worker;                        /**< Worker thread processing the notification. */
+} cl_sm_notif_job_t;
+
 /**
  * @brief Adds a new file descriptor into the set of file descriptors whose monitoring state should be changed.
  */
@@ -207,6 +242,11 @@ cl_sm_subscription_cleanup_internal(void *subscription_p)
 
     if (NULL != subscription_p) {
         subscription = (cl_sm_subscription_ctx_t *)subscription_p;
+        if (subscription->notif_cnt > 0) {
+            /* removed from within its own callback, will be released by the worker thread */
+            subscription->release_by_worker = true;
+            return;
+        }
         free((void*)subscription->module_name);
         free((void*)subscription->xpath);
         free(subscription);
@@ -329,6 +369,7 @@ cl_sm_connection_add(cl_sm_ctx_t *sm_ctx, int fd, cl_sm_conn_ctx_t **conn_p)
 
     conn->sm_ctx = sm_ctx;
     conn->fd = fd;
+    conn->id = ++sm_ctx->last_conn_id;
 
     rc = sr_btree_insert(sm_ctx->fd_btree, conn);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Cannot insert new entry into fd binary tree (duplicate fd?).");
@@ -443,6 +484,8 @@ cl_sm_conn_out_buff_flush(cl_sm_ctx_t *sm_ctx, cl_sm_conn_ctx_t *conn)
 
 /**
  * @brief Get (prepare) configuration session that can be used from notification callback.
+ * Each subscription uses its own session for a commit, so that the callbacks of different
+ * subscriptions can run in parallel.
  */
 static int
 cl_sm_get_data_session(cl_sm_ctx_t *sm_ctx, cl_sm_subscription_ctx_t *subscription,
@@ -459,6 +502,8 @@ cl_sm_get_data_session(cl_sm_ctx_t *sm_ctx, cl_sm_subscription_ctx_t *subscripti
 
     CHECK_NULL_ARG4(sm_ctx, subscription, source_address, config_session_p);
 
+    pthread_mutex_lock(&sm_ctx->data_connection_lock);
+
     /* find a connection matching with provided address */
     connection_lookup.dst_address = source_address;
     connection = sr_btree_search(sm_ctx->data_connection_btree, &connection_lookup);
@@ -491,15 +536,16 @@ cl_sm_get_data_session(cl_sm_ctx_t *sm_ctx, cl_sm_subscription_ctx_t *subscripti
         if (SR_ERR_OK != rc) {
             SR_LOG_ERR("Unable to connect to the notification originator at '%s'.", source_address);
             cl_connection_cleanup(connection);
-            return rc;
+            goto unlock;
         }
     }
 
-    /* try to find the session matching with the commit ID in connection */
+    /* try to find the session of the subscription matching with the commit ID in connection */
     if (NULL != connection->session_list) {
         tmp = connection->session_list;
         while (NULL != tmp) {
-            if ((NULL != tmp->session) && (tmp->session->commit_id == commit_id)) {
+            if ((NULL != tmp->session) && (tmp->session->commit_id == commit_id) &&
+                    (tmp->session->subscription_id == subscription->id)) {
                 session = tmp->session;
                 break;
             }
@@ -520,7 +566,7 @@ cl_sm_get_data_session(cl_sm_ctx_t *sm_ctx, cl_sm_subscription_ctx_t *subscripti
         if (SR_ERR_OK != rc) {
             SR_LOG_ERR_MSG("Cannot allocate session_start message.");
             cl_session_cleanup(session);
-            return rc;
+            goto unlock;
         }
         msg_req->request->session_start_req->options = SR__SESSION_FLAGS__SESS_NOTIFICATION;
         if (0 != commit_id) {
@@ -535,12 +581,13 @@ cl_sm_get_data_session(cl_sm_ctx_t *sm_ctx, cl_sm_subscription_ctx_t *subscripti
             SR_LOG_ERR_MSG("Error by processing of session_start request.");
             sr_msg_free(msg_req);
             cl_session_cleanup(session);
-            return rc;
+            goto unlock;
         }
 
         session->id = msg_resp->response->session_start_resp->session_id;
         session->notif_session = true;
         session->commit_id = commit_id;
+        session->subscription_id = subscription->id;
 
         sr_msg_free(msg_req);
         sr_msg_free(msg_resp);
@@ -548,6 +595,9 @@ cl_sm_get_data_session(cl_sm_ctx_t *sm_ctx, cl_sm_subscription_ctx_t *subscripti
 
     subscription->data_session = session;
     *config_session_p = session;
+
+unlock:
+    pthread_mutex_unlock(&sm_ctx->data_connection_lock);
     return rc;
 }
 
@@ -562,30 +612,35 @@ cl_sm_close_data_session(cl_sm_ctx_t *sm_ctx, cl_sm_subscription_ctx_t *subscrip
 
     CHECK_NULL_ARG3(sm_ctx, subscription, source_address);
 
+    pthread_mutex_lock(&sm_ctx->data_connection_lock);
+
     /* find a connection matching with provided address */
     connection_lookup.dst_address = source_address;
     connection = sr_btree_search(sm_ctx->data_connection_btree, &connection_lookup);
 
-    if (NULL == connection || NULL == connection->session_list) {
-        /* no connection / sessions for this source address */
-        return SR_ERR_OK;
-    }
-
-    /* try to find the session matching with the commit ID in connection */
-    tmp = connection->session_list;
-    while (NULL != tmp) {
-        if ((NULL != tmp->session) && (tmp->session->commit_id == commit_id)) {
-            session = tmp->session;
-            break;
+    if (NULL != connection) {
+        /* try to find the session of the subscription matching with the commit ID in connection */
+        tmp = connection->session_list;
+        while (NULL != tmp) {
+            if ((NULL != tmp->session) && (tmp->session->commit_id == commit_id) &&
+                    (tmp->session->subscription_id == subscription->id)) {
+                session = tmp->session;
+                break;
+            }
+            tmp = tmp->next;
         }
-        tmp = tmp->next;
     }
 
     if (NULL != session) {
         /* stop the session including sending of a session-stop request */
+        if (subscription->data_session == session) {
+            subscription->data_session = NULL;
+        }
         sr_session_stop(session);
     }
 
+    pthread_mutex_unlock(&sm_ctx->data_connection_lock);
+
     return SR_ERR_OK;
 }
 
@@ -625,8 +680,8 @@ cl_sm_msg_send_connection(cl_sm_ctx_t *sm_ctx, cl_sm_conn_ctx_t *conn, Sr__Msg *
         /* flush the buffer */
         rc = cl_sm_conn_out_buff_flush(sm_ctx, conn);
         if ((conn->close_requested) || (SR_ERR_OK != rc)) {
-            /* do not close the connection right here - since send is always a consequence of receive,
-             * it will be closed in receive code path */
+            /* do not close the connection right here - it will be closed in the receive code path
+             * or by the caller sending ACKs of notifications processed by the worker threads */
             conn->close_requested = true;
             rc = SR_ERR_DISCONNECT;
         }
@@ -636,42 +691,20 @@ cl_sm_msg_send_connection(cl_sm_ctx_t *sm_ctx, cl_sm_conn_ctx_t *conn, Sr__Msg *
 }
 
 /**
- * @brief Processes an incoming notification message.
+ * @brief Calls the callback of the subscription for an incoming notification message
+ * and prepares the notification ACK, if the notification needs to be acknowledged.
  */
 static int
-cl_sm_notif_process(cl_sm_ctx_t *sm_ctx, cl_sm_conn_ctx_t *conn, Sr__Msg *msg)
+cl_sm_notif_callback_call(cl_sm_ctx_t *sm_ctx, cl_sm_subscription_ctx_t *subscription, Sr__Msg *msg,
+        Sr__Msg **ack_msg_p)
 {
-    cl_sm_subscription_ctx_t *subscription = NULL;
-    cl_sm_subscription_ctx_t subscription_lookup = { 0, };
     sr_session_ctx_t *data_session = NULL;
     Sr__Msg *ack_msg = NULL;
     sr_mem_ctx_t *sr_mem = NULL;
     const char *errmsg = NULL;
     int rc = SR_ERR_OK, rc_tmp = SR_ERR_OK;
 
-    CHECK_NULL_ARG3(sm_ctx, msg, msg->notification);
-
-    SR_LOG_DBG("Received a notification for subscription id=%"PRIu32" (source address='%s').",
-            msg->notification->subscription_id, msg->notification->source_address);
-
-    pthread_mutex_lock(&sm_ctx->subscriptions_lock);
-
-    /* find the subscription according to id */
-    subscription_lookup.id = msg->notification->subscription_id;
-    subscription = sr_btree_search(sm_ctx->subscriptions_btree, &subscription_lookup);
-    if (NULL == subscription) {
-        pthread_mutex_unlock(&sm_ctx->subscriptions_lock);
-        SR_LOG_ERR("No matching subscription for subscription id=%"PRIu32".", msg->notification->subscription_id);
-        return SR_ERR_INVAL_ARG;
-    }
-
-    /* validate the message according to the subscription type */
-    rc = sr_gpb_msg_validate_notif(msg, subscription->type);
-    if (SR_ERR_OK != rc) {
-        pthread_mutex_unlock(&sm_ctx->subscriptions_lock);
-        SR_LOG_ERR("Received notification message is not valid for subscription id=%"PRIu32".", msg->notification->subscription_id);
-        return SR_ERR_INVAL_ARG;
-    }
+    CHECK_NULL_ARG5(sm_ctx, subscription, msg, msg->notification, ack_msg_p);
 
     /* get data session that can be used from notification callback */
     if ((SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS == msg->notification->type) ||
@@ -706,6 +739,16 @@ cl_sm_notif_process(cl_sm_ctx_t *sm_ctx, cl_sm_conn_ctx_t *conn, Sr__Msg *msg)
                     subscription->private_ctx);
             break;
         case SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS:
+            if (msg->notification->module_change_notif->has_changes_inline &&
+                    msg->notification->module_change_notif->changes_inline) {
+                /* the changes of the whole module are selected by "/<module>:*" */
+                rc = sr_asprintf(&data_session->changes_xpath, "/%s:*", msg->notification->module_change_notif->module_name);
+                if (SR_ERR_OK != rc) {
+                    errmsg = "Unable to process the changes delivered within the notification.";
+                    goto ack;
+                }
+                data_session->changes_msg = msg;
+            }
             SR_LOG_DBG("Calling module-change callback for subscription id=%"PRIu32".", subscription->id);
             rc = subscription->callback.module_change_cb(
                     data_session,
@@ -714,6 +757,16 @@ cl_sm_notif_process(cl_sm_ctx_t *sm_ctx, cl_sm_conn_ctx_t *conn, Sr__Msg *msg)
                     subscription->private_ctx);
             break;
         case SR__SUBSCRIPTION_TYPE__SUBTREE_CHANGE_SUBS:
+            if (msg->notification->subtree_change_notif->has_changes_inline &&
+                    msg->notification->subtree_change_notif->changes_inline) {
+                data_session->changes_xpath = strdup(msg->notification->subtree_change_notif->xpath);
+                if (NULL == data_session->changes_xpath) {
+                    rc = SR_ERR_NOMEM;
+                    errmsg = "Unable to process the changes delivered within the notification.";
+                    goto ack;
+                }
+                data_session->changes_msg = msg;
+            }
             SR_LOG_DBG("Calling subtree-change callback for subscription id=%"PRIu32".", subscription->id);
             rc = subscription->callback.subtree_change_cb(
                     data_session,
@@ -738,7 +791,14 @@ cl_sm_notif_process(cl_sm_ctx_t *sm_ctx, cl_sm_conn_ctx_t *conn, Sr__Msg *msg)
     }
 
 ack:
-    /* send notification ACK */
+    /* changes delivered within the notification are not available after the callback returns */
+    if (NULL != data_session) {
+        free(data_session->changes_xpath);
+        data_session->changes_xpath = NULL;
+        data_session->changes_msg = NULL;
+    }
+
+    /* prepare notification ACK */
     if ((SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS == msg->notification->type) ||
             (SR__SUBSCRIPTION_TYPE__SUBTREE_CHANGE_SUBS == msg->notification->type)) {
         rc_tmp = sr_mem_new(0, &sr_mem);
@@ -764,20 +824,325 @@ ack:
                     rc_tmp = SR_ERR_OK;
                 }
             }
-        }
-        if (SR_ERR_OK == rc_tmp) {
-            rc_tmp = cl_sm_msg_send_connection(sm_ctx, conn, ack_msg);
-            ack_msg->notification_ack->notif = NULL;
-            sr_msg_free(ack_msg);
+        } else if (NULL == ack_msg && NULL != sr_mem) {
+            sr_mem_free(sr_mem);
         }
         if (SR_ERR_OK != rc_tmp) {
-            SR_LOG_ERR("Unable to send notification ACK: %s", sr_strerror(rc_tmp));
+            SR_LOG_ERR("Unable to prepare notification ACK: %s", sr_strerror(rc_tmp));
             rc = rc_tmp;
         } else {
             rc = SR_ERR_OK;
         }
     }
 
+    *ack_msg_p = ack_msg;
+    return rc;
+}
+
+/**
+ * @brief Sends notification ACK prepared by ::cl_sm_notif_callback_call and releases it.
+ */
+static int
+cl_sm_notif_ack_send(cl_sm_ctx_t *sm_ctx, cl_sm_conn_ctx_t *conn, Sr__Msg *ack_msg)
+{
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(sm_ctx, conn, ack_msg);
+
+    rc = cl_sm_msg_send_connection(sm_ctx, conn, ack_msg);
+    ack_msg->notification_ack->notif = NULL;
+    sr_msg_free(ack_msg);
+
+    if (SR_ERR_OK != rc) {
+        SR_LOG_ERR("Unable to send notification ACK: %s", sr_strerror(rc));
+    }
+
+    return rc;
+}
+
+/**
+ * @brief Releases a notification processed by worker threads.
+ */
+static void
+cl_sm_notif_job_free(cl_sm_notif_job_t *job)
+{
+    if (NULL != job) {
+        if (NULL != job->ack_msg) {
+            job->ack_msg->notification_ack->notif = NULL;
+            sr_msg_free(job->ack_msg);
+        }
+        sr_msg_free(job->msg);
+        free(job);
+    }
+}
+
+/**
+ * @brief Returns TRUE if the notification of given type is to be processed by the worker threads.
+ * These are the notifications of change subscriptions, which must be processed in order per subscription.
+ */
+static bool
+cl_sm_notif_for_workers(cl_sm_ctx_t *sm_ctx, Sr__SubscriptionType type)
+{
+    return (NULL != sm_ctx->notif_workers) &&
+            ((SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS == type) ||
+             (SR__SUBSCRIPTION_TYPE__SUBTREE_CHANGE_SUBS == type) ||
+             (SR__SUBSCRIPTION_TYPE__COMMIT_END_SUBS == type));
+}
+
+/**
+ * @brief Queues a notification to be processed by the worker threads. Takes over the message.
+ * @note Expects subscriptions lock to be held.
+ */
+static int
+cl_sm_notif_job_add(cl_sm_ctx_t *sm_ctx, cl_sm_subscription_ctx_t *subscription, cl_sm_conn_ctx_t *conn, Sr__Msg *msg)
+{
+    cl_sm_notif_job_t *job = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG4(sm_ctx, subscription, conn, msg);
+
+    job = calloc(1, sizeof(*job));
+    if (NULL == job) {
+        sr_msg_free(msg);
+        return SR_ERR_NOMEM;
+    }
+    job->subscription = subscription;
+    job->conn_fd = conn->fd;
+    job->conn_id = conn->id;
+    job->msg = msg;
+
+    pthread_mutex_lock(&sm_ctx->notif_lock);
+
+    if (subscription->unsubscribed) {
+        SR_LOG_DBG("Subscription id=%"PRIu32" is being removed, dropping the notification.", subscription->id);
+        cl_sm_notif_job_free(job);
+    } else {
+        rc = sr_llist_add_new(sm_ctx->notif_jobs, job);
+        if (SR_ERR_OK == rc) {
+            subscription->notif_cnt += 1;
+            pthread_cond_signal(&sm_ctx->notif_cv);
+        } else {
+            cl_sm_notif_job_free(job);
+        }
+    }
+
+    pthread_mutex_unlock(&sm_ctx->notif_lock);
+
+    return rc;
+}
+
+/**
+ * @brief Finds the next notification that can be processed by a worker thread.
+ *
+ * Notifications of a subscription are processed one by one, in the order of their arrival.
+ * Notifications of different subscriptions are processed in parallel as long as the subscriptions
+ * have the same priority, otherwise all the notifications received sooner have to be processed first,
+ * so that the callbacks are still called in the order of their priorities.
+ *
+ * @note Expects notification lock to be held.
+ */
+static sr_llist_node_t *
+cl_sm_notif_job_next(cl_sm_ctx_t *sm_ctx)
+{
+    sr_llist_node_t *node = NULL, *prev = NULL;
+    cl_sm_notif_job_t *job = NULL, *first = NULL;
+    bool busy = false;
+
+    node = sm_ctx->notif_jobs->first;
+    if (NULL != node) {
+        first = (cl_sm_notif_job_t *) node->data;
+    }
+
+    while (NULL != node) {
+        job = (cl_sm_notif_job_t *) node->data;
+        if (job->subscription->priority != first->subscription->priority) {
+            break;
+        }
+        if (!job->in_progress) {
+            busy = false;
+            for (prev = sm_ctx->notif_jobs->first; prev != node; prev = prev->next) {
+                if (((cl_sm_notif_job_t *) prev->data)->subscription == job->subscription) {
+                    busy = true;
+                    break;
+                }
+            }
+            if (!busy) {
+                return node;
+            }
+        }
+        node = node->next;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Worker thread calling the callbacks of change subscriptions.
+ */
+static void *
+cl_sm_notif_worker(void *sm_ctx_p)
+{
+    cl_sm_ctx_t *sm_ctx = NULL;
+    cl_sm_subscription_ctx_t *subscription = NULL;
+    cl_sm_notif_job_t *job = NULL;
+    sr_llist_node_t *node = NULL;
+    bool ack = false;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG_NORET(rc, sm_ctx_p);
+    if (SR_ERR_OK != rc) {
+        return NULL;
+    }
+    sm_ctx = (cl_sm_ctx_t *) sm_ctx_p;
+
+    pthread_mutex_lock(&sm_ctx->notif_lock);
+
+    while (!sm_ctx->notif_workers_stop) {
+        node = cl_sm_notif_job_next(sm_ctx);
+        if (NULL == node) {
+            pthread_cond_wait(&sm_ctx->notif_cv, &sm_ctx->notif_lock);
+            continue;
+        }
+        job = (cl_sm_notif_job_t *) node->data;
+        job->in_progress = true;
+        job->worker = pthread_self();
+
+        pthread_mutex_unlock(&sm_ctx->notif_lock);
+
+        rc = cl_sm_notif_callback_call(sm_ctx, job->subscription, job->msg, &job->ack_msg);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_ERR("Error by processing of the notification for subscription id=%"PRIu32".", job->subscription->id);
+        }
+
+        pthread_mutex_lock(&sm_ctx->notif_lock);
+
+        sr_llist_rm(sm_ctx->notif_jobs, node);
+        subscription = job->subscription;
+        job->subscription = NULL;
+        subscription->notif_cnt -= 1;
+        if (subscription->release_by_worker && 0 == subscription->notif_cnt) {
+            /* the subscription has been removed from within its callback */
+            cl_sm_subscription_cleanup_internal(subscription);
+        }
+
+        ack = false;
+        if (NULL != job->ack_msg) {
+            /* the ACK is sent from the event loop that owns the connection */
+            rc = sr_llist_add_new(sm_ctx->notif_acks, job);
+            if (SR_ERR_OK == rc) {
+                ack = true;
+            } else {
+                SR_LOG_ERR_MSG("Unable to send notification ACK.");
+                cl_sm_notif_job_free(job);
+            }
+        } else {
+            cl_sm_notif_job_free(job);
+        }
+
+        /* other notifications may be ready for processing now, and unsubscribe may be waiting */
+        pthread_cond_broadcast(&sm_ctx->notif_cv);
+
+        if (ack) {
+            ev_async_send(sm_ctx->event_loop, &sm_ctx->notif_ack_watcher);
+        }
+    }
+
+    pthread_mutex_unlock(&sm_ctx->notif_lock);
+
+    return NULL;
+}
+
+/**
+ * @brief Callback called by the event loop watcher when ACKs of notifications processed
+ * by the worker threads are to be sent.
+ */
+static void
+cl_sm_notif_ack_cb(struct ev_loop *loop, ev_async *w, int revents)
+{
+    cl_sm_ctx_t *sm_ctx = NULL;
+    cl_sm_notif_job_t *job = NULL;
+    cl_sm_conn_ctx_t tmp_conn = { 0, };
+    cl_sm_conn_ctx_t *conn = NULL;
+
+    CHECK_NULL_ARG_VOID3(loop, w, w->data);
+    sm_ctx = (cl_sm_ctx_t*)w->data;
+
+    pthread_mutex_lock(&sm_ctx->notif_lock);
+
+    while (NULL != sm_ctx->notif_acks->first) {
+        job = (cl_sm_notif_job_t *) sm_ctx->notif_acks->first->data;
+        sr_llist_rm(sm_ctx->notif_acks, sm_ctx->notif_acks->first);
+
+        pthread_mutex_unlock(&sm_ctx->notif_lock);
+
+        /* the connection may have been closed in the meantime */
+        tmp_conn.fd = job->conn_fd;
+        conn = sr_btree_search(sm_ctx->fd_btree, &tmp_conn);
+        if (NULL != conn && conn->id == job->conn_id) {
+            cl_sm_notif_ack_send(sm_ctx, conn, job->ack_msg);
+            job->ack_msg = NULL;
+            if (conn->close_requested) {
+                cl_sm_conn_close(sm_ctx, conn);
+            }
+        } else {
+            SR_LOG_WRN("Connection fd=%d has been closed, notification ACK not sent.", job->conn_fd);
+        }
+        cl_sm_notif_job_free(job);
+
+        pthread_mutex_lock(&sm_ctx->notif_lock);
+    }
+
+    pthread_mutex_unlock(&sm_ctx->notif_lock);
+}
+
+/**
+ * @brief Processes an incoming notification message. If the notification is to be processed
+ * by the worker threads, the message is taken over and set to NULL.
+ */
+static int
+cl_sm_notif_process(cl_sm_ctx_t *sm_ctx, cl_sm_conn_ctx_t *conn, Sr__Msg **msg_p)
+{
+    cl_sm_subscription_ctx_t *subscription = NULL;
+    cl_sm_subscription_ctx_t subscription_lookup = { 0, };
+    Sr__Msg *msg = NULL, *ack_msg = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG4(sm_ctx, msg_p, *msg_p, (*msg_p)->notification);
+    msg = *msg_p;
+
+    SR_LOG_DBG("Received a notification for subscription id=%"PRIu32" (source address='%s').",
+            msg->notification->subscription_id, msg->notification->source_address);
+
+    pthread_mutex_lock(&sm_ctx->subscriptions_lock);
+
+    /* find the subscription according to id */
+    subscription_lookup.id = msg->notification->subscription_id;
+    subscription = sr_btree_search(sm_ctx->subscriptions_btree, &subscription_lookup);
+    if (NULL == subscription) {
+        pthread_mutex_unlock(&sm_ctx->subscriptions_lock);
+        SR_LOG_ERR("No matching subscription for subscription id=%"PRIu32".", msg->notification->subscription_id);
+        return SR_ERR_INVAL_ARG;
+    }
+
+    /* validate the message according to the subscription type */
+    rc = sr_gpb_msg_validate_notif(msg, subscription->type);
+    if (SR_ERR_OK != rc) {
+        pthread_mutex_unlock(&sm_ctx->subscriptions_lock);
+        SR_LOG_ERR("Received notification message is not valid for subscription id=%"PRIu32".", msg->notification->subscription_id);
+        return SR_ERR_INVAL_ARG;
+    }
+
+    if (cl_sm_notif_for_workers(sm_ctx, msg->notification->type)) {
+        /* let the worker threads process the notification */
+        *msg_p = NULL;
+        rc = cl_sm_notif_job_add(sm_ctx, subscription, conn, msg);
+    } else {
+        rc = cl_sm_notif_callback_call(sm_ctx, subscription, msg, &ack_msg);
+        if (NULL != ack_msg) {
+            rc = cl_sm_notif_ack_send(sm_ctx, conn, ack_msg);
+        }
+    }
+
     pthread_mutex_unlock(&sm_ctx->subscriptions_lock);
 
     return rc;
@@ -1071,7 +1436,7 @@ cl_sm_conn_msg_process(cl_sm_ctx_t *sm_ctx, cl_sm_conn_ctx_t *conn, uint8_t *msg
     /* check the message */
     if (SR__MSG__MSG_TYPE__NOTIFICATION == msg->type) {
         /* notification */
-        rc = cl_sm_notif_process(sm_ctx, conn, msg);
+        rc = cl_sm_notif_process(sm_ctx, conn, &msg);
     } else if ((SR__MSG__MSG_TYPE__REQUEST == msg->type) && (SR__OPERATION__DATA_PROVIDE == msg->request->operation)) {
         /* data-provide request */
         rc = cl_sm_dp_request_process(sm_ctx, conn, msg);
@@ -1667,6 +2032,62 @@ cl_sm_event_loop_threaded(void *sm_ctx_p)
     return NULL;
 }
 
+/**
+ * @brief Returns the number of worker threads calling the callbacks of change subscriptions:
+ * the value of the SR_SUBSCR_THREADS_ENV environment variable, if set, otherwise SR_SUBSCR_THREAD_COUNT.
+ */
+static size_t
+cl_sm_get_notif_worker_count()
+{
+    const char *env_str = NULL;
+    long count = SR_SUBSCR_THREAD_COUNT;
+
+    env_str = getenv(SR_SUBSCR_THREADS_ENV);
+    if (NULL != env_str) {
+        count = strtol(env_str, NULL, 10);
+    }
+
+    return (count > 0) ? (size_t)count : 0;
+}
+
+/**
+ * @brief Stops the worker threads and drops the notifications that have not been processed.
+ */
+static void
+cl_sm_notif_workers_stop(cl_sm_ctx_t *sm_ctx)
+{
+    cl_sm_notif_job_t *job = NULL;
+
+    if (NULL != sm_ctx->notif_workers) {
+        pthread_mutex_lock(&sm_ctx->notif_lock);
+        sm_ctx->notif_workers_stop = true;
+        pthread_cond_broadcast(&sm_ctx->notif_cv);
+        pthread_mutex_unlock(&sm_ctx->notif_lock);
+
+        for (size_t i = 0; i < sm_ctx->notif_worker_cnt; i++) {
+            pthread_join(sm_ctx->notif_workers[i], NULL);
+        }
+        free(sm_ctx->notif_workers);
+        sm_ctx->notif_workers = NULL;
+        sm_ctx->notif_worker_cnt = 0;
+    }
+
+    if (NULL != sm_ctx->notif_jobs) {
+        while (NULL != sm_ctx->notif_jobs->first) {
+            job = (cl_sm_notif_job_t *) sm_ctx->notif_jobs->first->data;
+            job->subscription->notif_cnt -= 1;
+            cl_sm_notif_job_free(job);
+            sr_llist_rm(sm_ctx->notif_jobs, sm_ctx->notif_jobs->first);
+        }
+    }
+    if (NULL != sm_ctx->notif_acks) {
+        while (NULL != sm_ctx->notif_acks->first) {
+            cl_sm_notif_job_free(sm_ctx->notif_acks->first->data);
+            sr_llist_rm(sm_ctx->notif_acks, sm_ctx->notif_acks->first);
+        }
+    }
+}
+
 int
 cl_sm_init(bool local_fd_watcher, sr_fd_sm_terminated_cb local_sm_terminate_cb, int notify_pipe[2], cl_sm_ctx_t **sm_ctx_p)
 {
@@ -1709,6 +2130,18 @@ cl_sm_init(bool local_fd_watcher, sr_fd_sm_terminated_cb local_sm_terminate_cb,
     CHECK_ZERO_MSG_GOTO(ret, rc, SR_ERR_INIT_FAILED, cleanup, "Cannot initialize subscriptions server contexts mutex.");
     ret = pthread_mutex_init(&ctx->fd_changeset_lock, NULL);
     CHECK_ZERO_MSG_GOTO(ret, rc, SR_ERR_INIT_FAILED, cleanup, "Cannot initialize fd changeset mutex.");
+    ret = pthread_mutex_init(&ctx->data_connection_lock, NULL);
+    CHECK_ZERO_MSG_GOTO(ret, rc, SR_ERR_INIT_FAILED, cleanup, "Cannot initialize data connections mutex.");
+    ret = pthread_mutex_init(&ctx->notif_lock, NULL);
+    CHECK_ZERO_MSG_GOTO(ret, rc, SR_ERR_INIT_FAILED, cleanup, "Cannot initialize notifications mutex.");
+    ret = pthread_cond_init(&ctx->notif_cv, NULL);
+    CHECK_ZERO_MSG_GOTO(ret, rc, SR_ERR_INIT_FAILED, cleanup, "Cannot initialize notifications condition variable.");
+
+    /* initialize linked-lists for notifications processed by the worker threads */
+    rc = sr_llist_init(&ctx->notif_jobs);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Cannot initialize linked-list for notifications.");
+    rc = sr_llist_init(&ctx->notif_acks);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Cannot initialize linked-list for notification ACKs.");
     ret = pthread_mutexattr_init(&mattr);
     CHECK_ZERO_MSG_GOTO(ret, rc, SR_ERR_INIT_FAILED, cleanup, "Cannot initialize mutex attribute.");
     pthread_mutexattr_settype(&mattr, PTHREAD_MUTEX_RECURSIVE);
@@ -1737,6 +2170,24 @@ cl_sm_init(bool local_fd_watcher, sr_fd_sm_terminated_cb local_sm_terminate_cb,
         ctx->server_ctx_watcher.data = (void*)ctx;
         ev_async_start(ctx->event_loop, &ctx->server_ctx_watcher);
 
+        /* initialize event watcher for ACKs of notifications processed by the worker threads */
+        ev_async_init(&ctx->notif_ack_watcher, cl_sm_notif_ack_cb);
+        ctx->notif_ack_watcher.data = (void*)ctx;
+        ev_async_start(ctx->event_loop, &ctx->notif_ack_watcher);
+
+        /* start the worker threads calling the callbacks of change subscriptions */
+        size_t worker_cnt = cl_sm_get_notif_worker_count();
+        if (worker_cnt > 0) {
+            ctx->notif_workers = calloc(worker_cnt, sizeof(*ctx->notif_workers));
+            CHECK_NULL_NOMEM_GOTO(ctx->notif_workers, rc, cleanup);
+            for (size_t i = 0; i < worker_cnt; i++) {
+                ret = pthread_create(&ctx->notif_workers[i], NULL, cl_sm_notif_worker, ctx);
+                CHECK_ZERO_LOG_GOTO(ret, rc, SR_ERR_INIT_FAILED, cleanup, "Error by creating a new thread: %s", sr_strerror_safe(errno));
+                ctx->notif_worker_cnt += 1;
+            }
+            SR_LOG_DBG("%zu worker threads for change notifications started.", worker_cnt);
+        }
+
         /* start the event loop in a new thread */
         ret = pthread_create(&ctx->event_loop_thread, NULL, cl_sm_event_loop_threaded, ctx);
         CHECK_ZERO_LOG_GOTO(ret, rc, SR_ERR_INIT_FAILED, cleanup, "Error by creating a new thread: %s", sr_strerror_safe(errno));
@@ -1768,16 +2219,22 @@ cl_sm_cleanup(cl_sm_ctx_t *sm_ctx, bool join)
                 pthread_join(sm_ctx->event_loop_thread, NULL);
             }
         }
+        cl_sm_notif_workers_stop(sm_ctx);
         cl_sm_servers_cleanup(sm_ctx);
 
         sr_btree_cleanup(sm_ctx->data_connection_btree);
         sr_btree_cleanup(sm_ctx->subscriptions_btree);
         sr_btree_cleanup(sm_ctx->fd_btree);
         sr_llist_cleanup(sm_ctx->server_ctx_list);
+        sr_llist_cleanup(sm_ctx->notif_jobs);
+        sr_llist_cleanup(sm_ctx->notif_acks);
 
         pthread_mutex_destroy(&sm_ctx->server_ctx_lock);
         pthread_mutex_destroy(&sm_ctx->fd_changeset_lock);
         pthread_mutex_destroy(&sm_ctx->subscriptions_lock);
+        pthread_mutex_destroy(&sm_ctx->data_connection_lock);
+        pthread_mutex_destroy(&sm_ctx->notif_lock);
+        pthread_cond_destroy(&sm_ctx->notif_cv);
 
         if (sm_ctx->local_fd_watcher) {
             if (sm_ctx->fd_changeset_cnt > 0) {
@@ -1886,16 +2343,54 @@ void
 cl_sm_subscription_cleanup(cl_sm_subscription_ctx_t *subscription)
 {
     cl_sm_ctx_t *sm_ctx = NULL;
+    sr_llist_node_t *node = NULL, *next = NULL;
+    cl_sm_notif_job_t *job = NULL;
+    bool in_progress = false;
 
     CHECK_NULL_ARG_VOID2(subscription, subscription->sm_ctx);
 
     sm_ctx = subscription->sm_ctx;
 
+    if (NULL != sm_ctx->notif_workers) {
+        /* do not accept new notifications and drop those waiting for processing */
+        pthread_mutex_lock(&sm_ctx->subscriptions_lock);
+        pthread_mutex_lock(&sm_ctx->notif_lock);
+        subscription->unsubscribed = true;
+        node = sm_ctx->notif_jobs->first;
+        while (NULL != node) {
+            next = node->next;
+            job = (cl_sm_notif_job_t *) node->data;
+            if (job->subscription == subscription && !job->in_progress) {
+                subscription->notif_cnt -= 1;
+                cl_sm_notif_job_free(job);
+                sr_llist_rm(sm_ctx->notif_jobs, node);
+            }
+            node = next;
+        }
+        pthread_mutex_unlock(&sm_ctx->subscriptions_lock);
+
+        /* wait for the callback in progress, unless it is the one removing the subscription */
+        do {
+            in_progress = false;
+            for (node = sm_ctx->notif_jobs->first; NULL != node; node = node->next) {
+                job = (cl_sm_notif_job_t *) node->data;
+                if (job->subscription == subscription && job->in_progress && !pthread_equal(job->worker, pthread_self())) {
+                    in_progress = true;
+                    pthread_cond_wait(&sm_ctx->notif_cv, &sm_ctx->notif_lock);
+                    break;
+                }
+            }
+        } while (in_progress);
+        pthread_mutex_unlock(&sm_ctx->notif_lock);
+    }
+
     pthread_mutex_lock(&sm_ctx->subscriptions_lock);
+    pthread_mutex_lock(&sm_ctx->notif_lock);
 
     /* cl_sm_subscription_cleanup_internal will be auto-invoked */
     sr_btree_delete(sm_ctx->subscriptions_btree, subscription);
 
+    pthread_mutex_unlock(&sm_ctx->notif_lock);
     pthread_mutex_unlock(&sm_ctx->subscriptions_lock);
 }
 
@@ -78,6 +78,11 @@ typedef struct cl_sm_subscription_ctx_s {
     void *private_ctx;                           /**< Private context pointer, opaque to sysrepo. */
     int opts;                                    /**< Subscription options. */
     bool replaying;                              /**< TRUE in case of an event notification subscription, which is currently replaying notifications. */
+    uint32_t priority;                           /**< Priority of a change subscription. */
+    size_t notif_cnt;                            /**< Count of notifications of the subscription queued for / being processed by worker threads. */
+    bool unsubscribed;                           /**< TRUE once the subscription is being removed, no more notifications are accepted for it. */
+    bool release_by_worker;                      /**< TRUE if the subscription has been removed from within its own callback,
+                                                      the worker thread calling the callback releases it. */
 } cl_sm_subscription_ctx_t;
 
 /**
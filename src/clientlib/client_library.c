@@ -57,18 +57,6 @@ typedef struct sr_subscription_ctx_s {
     size_t sm_subscription_cnt;                   /**< Count of sm_subscriptions stored within this context. */
 } sr_subscription_ctx_t;
 
-/**
- * @brief Structure holding data for iterative access to items (::sr_get_items_iter).
- */
-typedef struct sr_val_iter_s {
-    char *xpath;                    /**< Xpath of the request. */
-    size_t offset;                  /**< Offset where the next data should be read. */
-    size_t limit;                   /**< How many items should be read. */
-    sr_val_t **buff_values;         /**< Buffered values. */
-    size_t index;                   /**< Index into buff_values pointing to the value to be returned by next call. */
-    size_t count;                   /**< Number of elements currently buffered. */
-} sr_val_iter_t;
-
 /**
  * @brief Structure holding data for iterative access to changes (::sr_get_changes_iter).
  */
@@ -81,8 +69,18 @@ typedef struct sr_change_iter_s {
     sr_val_t **old_values;          /**< Buffered old values. */
     size_t index;                   /**< Index into buff_values pointing to the value to be returned by next call. */
     size_t count;                   /**< Number of elements currently buffered. */
+    bool complete;                  /**< TRUE if all changes are buffered and there is nothing more to fetch. */
 } sr_change_iter_t;
 
+/**
+ * @brief Context of an asynchronous request (::sr_get_items_async, ::sr_set_item_async, ...).
+ */
+typedef struct cl_async_ctx_s {
+    sr_async_cb callback;                /**< Callback of an edit / commit request. */
+    sr_get_items_async_cb get_items_cb;  /**< Callback of a get-items request. */
+    void *private_ctx;                   /**< Private context of the caller. */
+} cl_async_ctx_t;
+
 static int connections_cnt = 0;               /**< Number of active connections to the Sysrepo Engine. */
 static int subscriptions_cnt = 0;             /**< Number of active subscriptions. */
 static cm_ctx_t *local_cm_ctx = NULL;         /**< Local Connection Manager context in case of library mode. */
@@ -114,10 +112,12 @@ cl_engine_init_local(sr_conn_ctx_t *conn_ctx, const char *socket_path, cm_ctx_t
 }
 
 /**
- * @brief Creates get_items request with options and send it
+ * @brief Creates get_items request with options and send it. If the cursor_id is 0, a new
+ * server-side cursor is requested, otherwise the iteration continues in the cursor.
  */
 static int
-cl_send_get_items_iter(sr_session_ctx_t *session, const char *xpath, size_t offset, size_t limit, Sr__Msg **msg_resp)
+cl_send_get_items_iter(sr_session_ctx_t *session, const char *xpath, size_t offset, size_t limit, uint32_t cursor_id,
+        Sr__Msg **msg_resp)
 {
     Sr__Msg *msg_req = NULL;
     sr_mem_ctx_t *sr_mem = NULL;
@@ -140,6 +140,13 @@ cl_send_get_items_iter(sr_session_ctx_t *session, const char *xpath, size_t offs
     msg_req->request->get_items_req->offset = offset;
     msg_req->request->get_items_req->has_limit = true;
     msg_req->request->get_items_req->has_offset = true;
+    if (0 == cursor_id) {
+        msg_req->request->get_items_req->open_cursor = true;
+        msg_req->request->get_items_req->has_open_cursor = true;
+    } else {
+        msg_req->request->get_items_req->cursor_id = cursor_id;
+        msg_req->request->get_items_req->has_cursor_id = true;
+    }
 
     /* send the request and receive the response */
     rc = cl_request_process(session, msg_req, msg_resp, NULL, SR__OPERATION__GET_ITEMS);
@@ -484,6 +491,18 @@ sr_disconnect(sr_conn_ctx_t *conn_ctx)
     }
 }
 
+cm_ctx_t *
+cl_local_cm_ctx_get(void)
+{
+    cm_ctx_t *cm_ctx = NULL;
+
+    pthread_mutex_lock(&global_lock);
+    cm_ctx = local_cm_ctx;
+    pthread_mutex_unlock(&global_lock);
+
+    return cm_ctx;
+}
+
 int
 sr_session_start(sr_conn_ctx_t *conn_ctx, sr_datastore_t datastore,
         const sr_sess_options_t opts, sr_session_ctx_t **session_p)
@@ -1019,7 +1038,7 @@ sr_get_items_iter(sr_session_ctx_t *session, const char *xpath, sr_val_iter_t **
 
     cl_session_clear_errors(session);
 
-    rc = cl_send_get_items_iter(session, xpath, 0, SR_GET_ITEMS_FETCH_LIMIT, &msg_resp);
+    rc = cl_send_get_items_iter(session, xpath, 0, SR_GET_ITEMS_FETCH_LIMIT, 0, &msg_resp);
     if (SR_ERR_NOT_FOUND == rc) {
         SR_LOG_DBG("No items found for xpath '%s'", xpath);
         /* SR_ERR_NOT_FOUND will be returned on get_item_next call */
@@ -1034,6 +1053,10 @@ sr_get_items_iter(sr_session_ctx_t *session, const char *xpath, sr_val_iter_t **
     it->index = 0;
     it->count = msg_resp->response->get_items_resp->n_values;
     it->offset = it->count;
+    if (msg_resp->response->get_items_resp->has_cursor_id) {
+        it->cursor_id = msg_resp->response->get_items_resp->cursor_id;
+        it->finished = (0 == it->cursor_id);
+    }
 
     it->xpath = strdup(xpath);
     CHECK_NULL_NOMEM_GOTO(it->xpath, rc, cleanup);
@@ -1087,10 +1110,14 @@ sr_get_item_next(sr_session_ctx_t *session, sr_val_iter_t *iter, sr_val_t **valu
     } else if (iter->index < iter->count) {
         /* There are buffered data */
         *value = iter->buff_values[iter->index++];
+    } else if (iter->finished) {
+        /* The server has already returned all items */
+        *value = NULL;
+        return SR_ERR_NOT_FOUND;
     } else {
-        /* Fetch more items */
+        /* Fetch more items, the offset is sent also with the cursor in case it has expired */
         rc = cl_send_get_items_iter(session, iter->xpath, iter->offset,
-                SR_GET_ITEMS_FETCH_LIMIT, &msg_resp);
+                SR_GET_ITEMS_FETCH_LIMIT, iter->cursor_id, &msg_resp);
         if (SR_ERR_NOT_FOUND == rc) {
             SR_LOG_DBG("All items has been read for xpath '%s'", iter->xpath);
             goto cleanup;
@@ -1098,6 +1125,11 @@ sr_get_item_next(sr_session_ctx_t *session, sr_val_iter_t *iter, sr_val_t **valu
             CHECK_RC_LOG_GOTO(rc, cleanup, "Fetching more items failed '%s'", iter->xpath);
         }
 
+        if (msg_resp->response->get_items_resp->has_cursor_id) {
+            iter->cursor_id = msg_resp->response->get_items_resp->cursor_id;
+            iter->finished = (0 == iter->cursor_id);
+        }
+
         size_t received_cnt = msg_resp->response->get_items_resp->n_values;
         if (0 == received_cnt) {
             /* There is no more data to be read */
@@ -2000,6 +2032,135 @@ cleanup:
     return cl_session_return(session, rc);
 }
 
+/**
+ * @brief Converts type of an edit operation in a batch to GPB.
+ */
+static Sr__EditBatchReq__EditOperation__EditOperationType
+cl_edit_batch_op_type_sr_to_gpb(sr_edit_batch_op_type_t type)
+{
+    switch (type) {
+        case SR_EDIT_BATCH_SET_STR:
+            return SR__EDIT_BATCH_REQ__EDIT_OPERATION__EDIT_OPERATION_TYPE__SET_STR;
+        case SR_EDIT_BATCH_DELETE:
+            return SR__EDIT_BATCH_REQ__EDIT_OPERATION__EDIT_OPERATION_TYPE__DELETE;
+        case SR_EDIT_BATCH_MOVE:
+            return SR__EDIT_BATCH_REQ__EDIT_OPERATION__EDIT_OPERATION_TYPE__MOVE;
+        case SR_EDIT_BATCH_SET:
+        default:
+            return SR__EDIT_BATCH_REQ__EDIT_OPERATION__EDIT_OPERATION_TYPE__SET;
+    }
+}
+
+int
+sr_edit_batch(sr_session_ctx_t *session, sr_edit_batch_op_t *operations, size_t op_cnt, bool continue_on_error)
+{
+    Sr__Msg *msg_req = NULL, *msg_resp = NULL;
+    Sr__EditBatchReq *batch_req = NULL;
+    Sr__EditBatchResp *batch_resp = NULL;
+    Sr__EditBatchReq__EditOperation *op = NULL;
+    sr_mem_ctx_t *sr_mem = NULL;
+    sr_val_t value = { 0, };
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(session, session->conn_ctx, operations);
+
+    cl_session_clear_errors(session);
+
+    /* prepare edit_batch message */
+    rc = sr_mem_new(0, &sr_mem);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to create a new Sysrepo memory context.");
+    rc = sr_gpb_req_alloc(sr_mem, SR__OPERATION__EDIT_BATCH, session->id, &msg_req);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Cannot allocate GPB message.");
+
+    batch_req = msg_req->request->edit_batch_req;
+    batch_req->continue_on_error = continue_on_error;
+    if (op_cnt > 0) {
+        batch_req->operations = sr_calloc(sr_mem, op_cnt, sizeof(*batch_req->operations));
+        CHECK_NULL_NOMEM_GOTO(batch_req->operations, rc, cleanup);
+    }
+
+    /* fill in the operations */
+    for (size_t i = 0; i < op_cnt; i++) {
+        if (NULL == operations[i].xpath) {
+            SR_LOG_ERR("NULL xpath of the edit operation %zu.", i);
+            rc = SR_ERR_INVAL_ARG;
+            goto cleanup;
+        }
+        operations[i].result = SR_ERR_OPERATION_FAILED;
+
+        op = sr_calloc(sr_mem, 1, sizeof(*op));
+        CHECK_NULL_NOMEM_GOTO(op, rc, cleanup);
+        sr__edit_batch_req__edit_operation__init(op);
+        batch_req->operations[batch_req->n_operations++] = op;
+
+        op->type = cl_edit_batch_op_type_sr_to_gpb(operations[i].type);
+        sr_mem_edit_string(sr_mem, &op->xpath, operations[i].xpath);
+        CHECK_NULL_NOMEM_GOTO(op->xpath, rc, cleanup);
+
+        switch (operations[i].type) {
+            case SR_EDIT_BATCH_SET:
+                if (NULL != operations[i].value) {
+                    /* the message is sent before returning, the value data can be referenced */
+                    value = *operations[i].value;
+                    value._sr_mem = sr_mem;
+                    rc = sr_dup_val_t_to_gpb(&value, &op->value);
+                    CHECK_RC_MSG_GOTO(rc, cleanup, "value duplication failed.");
+                }
+                op->has_options = true;
+                op->options = operations[i].opts;
+                break;
+            case SR_EDIT_BATCH_SET_STR:
+                if (NULL != operations[i].str_value) {
+                    sr_mem_edit_string(sr_mem, &op->str_value, operations[i].str_value);
+                    CHECK_NULL_NOMEM_GOTO(op->str_value, rc, cleanup);
+                }
+                op->has_options = true;
+                op->options = operations[i].opts;
+                break;
+            case SR_EDIT_BATCH_DELETE:
+                op->has_options = true;
+                op->options = operations[i].opts;
+                break;
+            case SR_EDIT_BATCH_MOVE:
+                op->has_position = true;
+                op->position = sr_move_position_sr_to_gpb(operations[i].position);
+                if (NULL != operations[i].relative_item) {
+                    sr_mem_edit_string(sr_mem, &op->relative_item, operations[i].relative_item);
+                    CHECK_NULL_NOMEM_GOTO(op->relative_item, rc, cleanup);
+                }
+                break;
+        }
+    }
+
+    /* send the request and receive the response */
+    rc = cl_request_process(session, msg_req, &msg_resp, NULL, SR__OPERATION__EDIT_BATCH);
+    if (NULL == msg_resp || NULL == msg_resp->response || NULL == msg_resp->response->edit_batch_resp) {
+        SR_LOG_ERR_MSG("Error by processing of the request.");
+        goto cleanup;
+    }
+
+    /* set results of the operations and store the errors within the session */
+    batch_resp = msg_resp->response->edit_batch_resp;
+    for (size_t i = 0; i < batch_resp->n_results && i < op_cnt; i++) {
+        operations[i].result = batch_resp->results[i];
+    }
+    if (batch_resp->n_errors > 0) {
+        SR_LOG_ERR("Edit batch failed with %zu error(s).", batch_resp->n_errors);
+        cl_session_set_errors(session, batch_resp->errors, batch_resp->n_errors);
+    }
+
+cleanup:
+    if (NULL != msg_req) {
+        sr_msg_free(msg_req);
+    } else {
+        sr_mem_free(sr_mem);
+    }
+    if (NULL != msg_resp) {
+        sr_msg_free(msg_resp);
+    }
+    return cl_session_return(session, rc);
+}
+
 int
 sr_validate(sr_session_ctx_t *session)
 {
@@ -2189,6 +2350,291 @@ cleanup:
     return cl_session_return(session, rc);
 }
 
+/**
+ * @brief Collects the error information of a failed asynchronous request. The returned
+ * array points into the response message, which must outlive it.
+ */
+static void
+cl_async_errors_get(int rc, Sr__Msg *msg_resp, sr_error_info_t **errors_p, size_t *error_cnt_p)
+{
+    Sr__Error **gpb_errors = NULL;
+    size_t gpb_error_cnt = 0;
+    sr_error_info_t *errors = NULL;
+
+    *errors_p = NULL;
+    *error_cnt_p = 0;
+
+    if (SR_ERR_OK == rc || NULL == msg_resp || NULL == msg_resp->response) {
+        return;
+    }
+    if (NULL != msg_resp->response->commit_resp && msg_resp->response->commit_resp->n_errors > 0) {
+        gpb_errors = msg_resp->response->commit_resp->errors;
+        gpb_error_cnt = msg_resp->response->commit_resp->n_errors;
+    } else if (NULL != msg_resp->response->error) {
+        gpb_errors = &msg_resp->response->error;
+        gpb_error_cnt = 1;
+    } else {
+        return;
+    }
+
+    errors = calloc(gpb_error_cnt, sizeof(*errors));
+    if (NULL == errors) {
+        SR_LOG_WRN_MSG("Unable to allocate error information, it will not be passed to the callback.");
+        return;
+    }
+    for (size_t i = 0; i < gpb_error_cnt; i++) {
+        errors[i].message = gpb_errors[i]->message;
+        errors[i].xpath = gpb_errors[i]->xpath;
+    }
+    *errors_p = errors;
+    *error_cnt_p = gpb_error_cnt;
+}
+
+/**
+ * @brief Completes an asynchronous edit or commit request.
+ *
+ * The error information is passed only to the callback, the last errors of the session
+ * belong to synchronous calls that may run on the session at the same time.
+ */
+static void
+cl_async_edit_resp_cb(sr_session_ctx_t *session, int rc, Sr__Msg *msg_resp, void *data)
+{
+    cl_async_ctx_t *async_ctx = (cl_async_ctx_t*)data;
+    sr_error_info_t *errors = NULL;
+    size_t error_cnt = 0;
+
+    if (NULL != async_ctx->callback) {
+        cl_async_errors_get(rc, msg_resp, &errors, &error_cnt);
+        async_ctx->callback(session, rc, errors, error_cnt, async_ctx->private_ctx);
+    }
+    free(errors);
+    sr_msg_free(msg_resp);
+    free(async_ctx);
+}
+
+/**
+ * @brief Completes an asynchronous get-items request.
+ */
+static void
+cl_async_get_items_resp_cb(sr_session_ctx_t *session, int rc, Sr__Msg *msg_resp, void *data)
+{
+    cl_async_ctx_t *async_ctx = (cl_async_ctx_t*)data;
+    sr_val_t *values = NULL;
+    size_t value_cnt = 0;
+    sr_error_info_t *errors = NULL;
+    size_t error_cnt = 0;
+
+    if (SR_ERR_OK == rc) {
+        /* copy the content of gpb values to sr_val_t */
+        rc = sr_values_gpb_to_sr((sr_mem_ctx_t *)msg_resp->_sysrepo_mem_ctx, msg_resp->response->get_items_resp->values,
+                msg_resp->response->get_items_resp->n_values, &values, &value_cnt);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_ERR_MSG("Error by copying the values from GPB.");
+        }
+    } else {
+        cl_async_errors_get(rc, msg_resp, &errors, &error_cnt);
+    }
+
+    async_ctx->get_items_cb(session, rc, values, value_cnt, errors, error_cnt, async_ctx->private_ctx);
+    free(errors);
+    sr_msg_free(msg_resp);
+    free(async_ctx);
+}
+
+int
+sr_get_items_async(sr_session_ctx_t *session, const char *xpath, sr_get_items_async_cb callback,
+        void *private_ctx)
+{
+    Sr__Msg *msg_req = NULL;
+    sr_mem_ctx_t *sr_mem = NULL;
+    cl_async_ctx_t *async_ctx = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG4(session, session->conn_ctx, xpath, callback);
+
+    cl_session_clear_errors(session);
+
+    async_ctx = calloc(1, sizeof(*async_ctx));
+    CHECK_NULL_NOMEM_GOTO(async_ctx, rc, cleanup);
+    async_ctx->get_items_cb = callback;
+    async_ctx->private_ctx = private_ctx;
+
+    /* prepare get_items message */
+    rc = sr_mem_new(0, &sr_mem);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to create a new Sysrepo memory context.");
+    rc = sr_gpb_req_alloc(sr_mem, SR__OPERATION__GET_ITEMS, session->id, &msg_req);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Cannot allocate GPB message.");
+
+    /* fill in the path */
+    sr_mem_edit_string(sr_mem, &msg_req->request->get_items_req->xpath, xpath);
+    CHECK_NULL_NOMEM_GOTO(msg_req->request->get_items_req->xpath, rc, cleanup);
+
+    /* send the request, the response will be processed in the callback */
+    rc = cl_request_process_async(session, msg_req, SR__OPERATION__GET_ITEMS, cl_async_get_items_resp_cb, async_ctx);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Error by sending of the request.");
+    async_ctx = NULL;
+
+cleanup:
+    free(async_ctx);
+    if (NULL != msg_req) {
+        sr_msg_free(msg_req);
+    } else {
+        sr_mem_free(sr_mem);
+    }
+    return cl_session_return(session, rc);
+}
+
+int
+sr_set_item_async(sr_session_ctx_t *session, const char *xpath, const sr_val_t *value,
+        const sr_edit_options_t opts, sr_async_cb callback, void *private_ctx)
+{
+    Sr__Msg *msg_req = NULL;
+    sr_mem_ctx_t *sr_mem = NULL;
+    sr_mem_snapshot_t snapshot = { 0, };
+    cl_async_ctx_t *async_ctx = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(session, session->conn_ctx, xpath);
+
+    cl_session_clear_errors(session);
+
+    async_ctx = calloc(1, sizeof(*async_ctx));
+    CHECK_NULL_NOMEM_RETURN(async_ctx);
+    async_ctx->callback = callback;
+    async_ctx->private_ctx = private_ctx;
+
+    /* prepare set_item message */
+    if (NULL != value) {
+        sr_mem = value->_sr_mem;
+        sr_mem_snapshot(sr_mem, &snapshot);
+    } else {
+        rc = sr_mem_new(0, &sr_mem);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to create a new Sysrepo memory context.");
+    }
+    rc = sr_gpb_req_alloc(sr_mem, SR__OPERATION__SET_ITEM, session->id, &msg_req);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Cannot allocate GPB message.");
+
+    /* fill in the path and options */
+    sr_mem_edit_string(sr_mem, &msg_req->request->set_item_req->xpath, xpath);
+    CHECK_NULL_NOMEM_GOTO(msg_req->request->set_item_req->xpath, rc, cleanup);
+
+    msg_req->request->set_item_req->options = opts;
+
+    /* duplicate the content of sr_val_t to gpb */
+    if (NULL != value) {
+        rc = sr_dup_val_t_to_gpb(value, &msg_req->request->set_item_req->value);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "value duplication failed.");
+    }
+
+    /* send the request, the response will be processed in the callback */
+    rc = cl_request_process_async(session, msg_req, SR__OPERATION__SET_ITEM, cl_async_edit_resp_cb, async_ctx);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Error by sending of the request.");
+
+    sr_msg_free(msg_req);
+
+    return cl_session_return(session, SR_ERR_OK);
+
+cleanup:
+    free(async_ctx);
+    if (NULL != sr_mem) {
+        if (NULL != value) {
+            sr_mem_restore(&snapshot);
+        } else {
+            if (NULL != msg_req) {
+                sr_msg_free(msg_req);
+            } else {
+                sr_mem_free(sr_mem);
+            }
+        }
+    } else {
+        sr_msg_free(msg_req);
+    }
+    return cl_session_return(session, rc);
+}
+
+int
+sr_delete_item_async(sr_session_ctx_t *session, const char *xpath, const sr_edit_options_t opts,
+        sr_async_cb callback, void *private_ctx)
+{
+    Sr__Msg *msg_req = NULL;
+    sr_mem_ctx_t *sr_mem = NULL;
+    cl_async_ctx_t *async_ctx = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(session, session->conn_ctx, xpath);
+
+    cl_session_clear_errors(session);
+
+    async_ctx = calloc(1, sizeof(*async_ctx));
+    CHECK_NULL_NOMEM_GOTO(async_ctx, rc, cleanup);
+    async_ctx->callback = callback;
+    async_ctx->private_ctx = private_ctx;
+
+    /* prepare delete_item message */
+    rc = sr_mem_new(0, &sr_mem);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to create a new Sysrepo memory context.");
+    rc = sr_gpb_req_alloc(sr_mem, SR__OPERATION__DELETE_ITEM, session->id, &msg_req);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Cannot allocate GPB message.");
+
+    /* fill in the path and options */
+    sr_mem_edit_string(sr_mem, &msg_req->request->delete_item_req->xpath, xpath);
+    CHECK_NULL_NOMEM_GOTO(msg_req->request->delete_item_req->xpath, rc, cleanup);
+
+    msg_req->request->delete_item_req->options = opts;
+
+    /* send the request, the response will be processed in the callback */
+    rc = cl_request_process_async(session, msg_req, SR__OPERATION__DELETE_ITEM, cl_async_edit_resp_cb, async_ctx);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Error by sending of the request.");
+    async_ctx = NULL;
+
+cleanup:
+    free(async_ctx);
+    if (NULL != msg_req) {
+        sr_msg_free(msg_req);
+    } else {
+        sr_mem_free(sr_mem);
+    }
+    return cl_session_return(session, rc);
+}
+
+int
+sr_commit_async(sr_session_ctx_t *session, sr_async_cb callback, void *private_ctx)
+{
+    Sr__Msg *msg_req = NULL;
+    sr_mem_ctx_t *sr_mem = NULL;
+    cl_async_ctx_t *async_ctx = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG2(session, session->conn_ctx);
+
+    cl_session_clear_errors(session);
+
+    async_ctx = calloc(1, sizeof(*async_ctx));
+    CHECK_NULL_NOMEM_GOTO(async_ctx, rc, cleanup);
+    async_ctx->callback = callback;
+    async_ctx->private_ctx = private_ctx;
+
+    /* prepare commit message */
+    rc = sr_mem_new(0, &sr_mem);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to create a new Sysrepo memory context.");
+    rc = sr_gpb_req_alloc(sr_mem, SR__OPERATION__COMMIT, session->id, &msg_req);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Cannot allocate GPB message.");
+
+    /* send the request, the response will be processed in the callback */
+    rc = cl_request_process_async(session, msg_req, SR__OPERATION__COMMIT, cl_async_edit_resp_cb, async_ctx);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Error by sending of the request.");
+    async_ctx = NULL;
+
+cleanup:
+    free(async_ctx);
+    if (NULL != msg_req) {
+        sr_msg_free(msg_req);
+    } else {
+        sr_mem_free(sr_mem);
+    }
+    return cl_session_return(session, rc);
+}
+
 int
 sr_lock_datastore(sr_session_ctx_t *session)
 {
@@ -2518,6 +2964,7 @@ sr_module_change_subscribe(sr_session_ctx_t *session, const char *module_name, s
     CHECK_RC_MSG_GOTO(rc, cleanup, "Error by initialization of the subscription in the client library.");
 
     sm_subscription->callback.module_change_cb = callback;
+    sm_subscription->priority = priority;
 
     /* fill-in subscription details */
     sr_mem = (sr_mem_ctx_t *)msg_req->_sysrepo_mem_ctx;
@@ -2534,6 +2981,8 @@ sr_module_change_subscribe(sr_session_ctx_t *session, const char *module_name, s
     msg_req->request->subscribe_req->enable_running = !(opts & SR_SUBSCR_PASSIVE);
     msg_req->request->subscribe_req->has_enable_event = true;
     msg_req->request->subscribe_req->enable_event = (opts & SR_SUBSCR_EV_ENABLED);
+    msg_req->request->subscribe_req->has_changes_inline = true;
+    msg_req->request->subscribe_req->changes_inline = (opts & SR_SUBSCR_CHANGES_INLINE);
 
     /* send the request and receive the response */
     rc = cl_request_process(session, msg_req, &msg_resp, NULL, SR__OPERATION__SUBSCRIBE);
@@ -2589,6 +3038,7 @@ sr_subtree_change_subscribe(sr_session_ctx_t *session, const char *xpath, sr_sub
     CHECK_RC_MSG_GOTO(rc, cleanup, "Error by initialization of the subscription in the client library.");
 
     sm_subscription->callback.subtree_change_cb = callback;
+    sm_subscription->priority = priority;
 
     /* fill-in subscription details */
     sr_mem = (sr_mem_ctx_t *)msg_req->_sysrepo_mem_ctx;
@@ -2607,6 +3057,8 @@ sr_subtree_change_subscribe(sr_session_ctx_t *session, const char *xpath, sr_sub
     msg_req->request->subscribe_req->enable_running = !(opts & SR_SUBSCR_PASSIVE);
     msg_req->request->subscribe_req->has_enable_event = true;
     msg_req->request->subscribe_req->enable_event = (opts & SR_SUBSCR_EV_ENABLED);
+    msg_req->request->subscribe_req->has_changes_inline = true;
+    msg_req->request->subscribe_req->changes_inline = (opts & SR_SUBSCR_CHANGES_INLINE);
 
     /* send the request and receive the response */
     rc = cl_request_process(session, msg_req, &msg_resp, NULL, SR__OPERATION__SUBSCRIBE);
@@ -2635,60 +3087,100 @@ cleanup:
     return cl_session_return(session, rc);
 }
 
-int
-sr_get_changes_iter(sr_session_ctx_t *session, const char *xpath, sr_change_iter_t **iter)
+/**
+ * @brief Creates a change iterator buffering provided GPB changes.
+ */
+static int
+cl_change_iter_create(const char *xpath, sr_mem_ctx_t *sr_mem, Sr__Change **changes, size_t changes_cnt,
+        sr_change_iter_t **iter)
 {
-    Sr__Msg *msg_resp = NULL;
     sr_change_iter_t *it = NULL;
     int rc = SR_ERR_OK;
 
-    CHECK_NULL_ARG4(session, session->conn_ctx, xpath, iter);
-
-    cl_session_clear_errors(session);
-
-    rc = cl_send_get_changes(session, xpath, 0, SR_GET_ITEMS_FETCH_LIMIT, &msg_resp);
-    if (SR_ERR_NOT_FOUND == rc) {
-        SR_LOG_DBG("No items found for xpath '%s'", xpath);
-        /* SR_ERR_NOT_FOUND will be returned on get_change_next call */
-        rc = SR_ERR_OK;
-    } else {
-        CHECK_RC_LOG_GOTO(rc, cleanup, "Sending get_changes request failed '%s'", xpath);
-    }
-
     it = calloc(1, sizeof(*it));
     CHECK_NULL_NOMEM_GOTO(it, rc, cleanup);
 
     it->index = 0;
-    it->count = msg_resp->response->get_changes_resp->n_changes;
-    it->offset = it->count;
+    it->offset = changes_cnt;
 
     it->xpath = strdup(xpath);
     CHECK_NULL_NOMEM_GOTO(it->xpath, rc, cleanup);
 
-    it->operations = calloc(it->count, sizeof(*it->operations));
+    it->operations = calloc(changes_cnt, sizeof(*it->operations));
     CHECK_NULL_NOMEM_GOTO(it->operations, rc, cleanup);
 
-    it->old_values = calloc(it->count, sizeof(*it->old_values));
+    it->old_values = calloc(changes_cnt, sizeof(*it->old_values));
     CHECK_NULL_NOMEM_GOTO(it->old_values, rc, cleanup);
 
-    it->new_values = calloc(it->count, sizeof(*it->new_values));
+    it->new_values = calloc(changes_cnt, sizeof(*it->new_values));
     CHECK_NULL_NOMEM_GOTO(it->new_values, rc, cleanup);
 
+    it->count = changes_cnt;
+
     /* copy the content of gpb to sr_val_t */
     for (size_t i = 0; i < it->count; i++) {
-        if (NULL != msg_resp->response->get_changes_resp->changes[i]->new_value) {
-            rc = sr_dup_gpb_to_val_t((sr_mem_ctx_t *)msg_resp->_sysrepo_mem_ctx,
-                                     msg_resp->response->get_changes_resp->changes[i]->new_value, &it->new_values[i]);
+        if (NULL != changes[i]->new_value) {
+            rc = sr_dup_gpb_to_val_t(sr_mem, changes[i]->new_value, &it->new_values[i]);
             CHECK_RC_MSG_GOTO(rc, cleanup, "Copying from gpb to sr_val_t failed");
         }
-        if (NULL != msg_resp->response->get_changes_resp->changes[i]->old_value) {
-            rc = sr_dup_gpb_to_val_t((sr_mem_ctx_t *)msg_resp->_sysrepo_mem_ctx,
-                                     msg_resp->response->get_changes_resp->changes[i]->old_value, &it->old_values[i]);
+        if (NULL != changes[i]->old_value) {
+            rc = sr_dup_gpb_to_val_t(sr_mem, changes[i]->old_value, &it->old_values[i]);
             CHECK_RC_MSG_GOTO(rc, cleanup, "Copying from gpb to sr_val_t failed");
         }
-        it->operations[i] = sr_change_op_gpb_to_sr(msg_resp->response->get_changes_resp->changes[i]->changeoperation);
+        it->operations[i] = sr_change_op_gpb_to_sr(changes[i]->changeoperation);
     }
 
+    *iter = it;
+    return SR_ERR_OK;
+
+cleanup:
+    sr_free_change_iter(it);
+    return rc;
+}
+
+int
+sr_get_changes_iter(sr_session_ctx_t *session, const char *xpath, sr_change_iter_t **iter)
+{
+    Sr__Msg *msg_resp = NULL;
+    Sr__Msg *notif = NULL;
+    sr_change_iter_t *it = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG4(session, session->conn_ctx, xpath, iter);
+
+    cl_session_clear_errors(session);
+
+    if (NULL != session->changes_xpath && NULL != session->changes_msg && 0 == strcmp(xpath, session->changes_xpath)) {
+        /* the changes were delivered within the notification */
+        notif = session->changes_msg;
+        if (NULL != notif->notification->module_change_notif) {
+            rc = cl_change_iter_create(xpath, (sr_mem_ctx_t *)notif->_sysrepo_mem_ctx,
+                    notif->notification->module_change_notif->changes,
+                    notif->notification->module_change_notif->n_changes, &it);
+        } else {
+            rc = cl_change_iter_create(xpath, (sr_mem_ctx_t *)notif->_sysrepo_mem_ctx,
+                    notif->notification->subtree_change_notif->changes,
+                    notif->notification->subtree_change_notif->n_changes, &it);
+        }
+        CHECK_RC_LOG_GOTO(rc, cleanup, "Creating change iterator failed '%s'", xpath);
+        it->complete = true;
+        *iter = it;
+        return cl_session_return(session, SR_ERR_OK);
+    }
+
+    rc = cl_send_get_changes(session, xpath, 0, SR_GET_ITEMS_FETCH_LIMIT, &msg_resp);
+    if (SR_ERR_NOT_FOUND == rc) {
+        SR_LOG_DBG("No items found for xpath '%s'", xpath);
+        /* SR_ERR_NOT_FOUND will be returned on get_change_next call */
+        rc = SR_ERR_OK;
+    } else {
+        CHECK_RC_LOG_GOTO(rc, cleanup, "Sending get_changes request failed '%s'", xpath);
+    }
+
+    rc = cl_change_iter_create(xpath, (sr_mem_ctx_t *)msg_resp->_sysrepo_mem_ctx,
+            msg_resp->response->get_changes_resp->changes, msg_resp->response->get_changes_resp->n_changes, &it);
+    CHECK_RC_LOG_GOTO(rc, cleanup, "Creating change iterator failed '%s'", xpath);
+
     *iter = it;
 
     sr_msg_free(msg_resp);
@@ -2699,9 +3191,6 @@ cleanup:
     if (NULL != msg_resp) {
         sr_msg_free(msg_resp);
     }
-    if (NULL != it){
-        sr_free_change_iter(it);
-    }
     return cl_session_return(session, rc);
 }
 
@@ -2716,7 +3205,7 @@ sr_get_change_next(sr_session_ctx_t *session, sr_change_iter_t *iter, sr_change_
 
     cl_session_clear_errors(session);
 
-    if (0 == iter->count) {
+    if (0 == iter->count || (iter->complete && iter->index >= iter->count)) {
         /* No more data to be read */
         *new_value = NULL;
         *old_value = NULL;
@@ -3391,6 +3880,13 @@ sr_action_send_tree(sr_session_ctx_t *session, const char *xpath,
 int
 sr_dp_get_items_subscribe(sr_session_ctx_t *session, const char *xpath, sr_dp_get_items_cb callback, void *private_ctx,
         sr_subscr_options_t opts, sr_subscription_ctx_t **subscription_p)
+{
+    return sr_dp_get_items_subscribe_cached(session, xpath, callback, private_ctx, 0, opts, subscription_p);
+}
+
+int
+sr_dp_get_items_subscribe_cached(sr_session_ctx_t *session, const char *xpath, sr_dp_get_items_cb callback,
+        void *private_ctx, uint32_t cache_ttl, sr_subscr_options_t opts, sr_subscription_ctx_t **subscription_p)
 {
     Sr__Msg *msg_req = NULL, *msg_resp = NULL;
     sr_subscription_ctx_t *sr_subscription = NULL;
@@ -3427,6 +3923,12 @@ sr_dp_get_items_subscribe(sr_session_ctx_t *session, const char *xpath, sr_dp_ge
 
     msg_req->request->subscribe_req->has_enable_running = true;
     msg_req->request->subscribe_req->enable_running = !(opts & SR_SUBSCR_PASSIVE);
+    if (cache_ttl > 0) {
+        msg_req->request->subscribe_req->has_cache_ttl = true;
+        msg_req->request->subscribe_req->cache_ttl = cache_ttl;
+    }
+    msg_req->request->subscribe_req->has_dp_bulk = true;
+    msg_req->request->subscribe_req->dp_bulk = (opts & SR_SUBSCR_DP_BULK);
 
     /* send the request and receive the response */
     rc = cl_request_process(session, msg_req, &msg_resp, NULL, SR__OPERATION__SUBSCRIBE);
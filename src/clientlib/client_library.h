@@ -23,6 +23,20 @@
 #ifndef CLIENT_LIBRARY_H_
 #define CLIENT_LIBRARY_H_
 
+/**
+ * @brief Structure holding data for iterative access to items (::sr_get_items_iter).
+ */
+typedef struct sr_val_iter_s {
+    char *xpath;                    /**< Xpath of the request. */
+    size_t offset;                  /**< Offset where the next data should be read. */
+    size_t limit;                   /**< How many items should be read. */
+    sr_val_t **buff_values;         /**< Buffered values. */
+    size_t index;                   /**< Index into buff_values pointing to the value to be returned by next call. */
+    size_t count;                   /**< Number of elements currently buffered. */
+    uint32_t cursor_id;             /**< Handle of the server-side cursor of the iteration (0 if not opened yet). */
+    bool finished;                  /**< The server has returned all items, no more data to be fetched. */
+} sr_val_iter_t;
+
 /**
  * @brief Notify sysrepo engine about the installation/removal of an YANG module
  * in the repository directory and instruct it to start/stop using it.
@@ -100,4 +114,12 @@ int sr_get_subtrees_first_chunks(sr_session_ctx_t *session, const char *xpath,
  */
 int sr_get_subtree_next_chunk(sr_session_ctx_t *session, sr_node_t *parent);
 
+/**
+ * @brief Returns the context of the Connection Manager the library has started locally
+ * in library mode.
+ *
+ * @return Connection Manager context, NULL if the library is connected to the sysrepo daemon.
+ */
+struct cm_ctx_s *cl_local_cm_ctx_get(void);
+
 #endif /* CLIENT_LIBRARY_H_ */
@@ -34,6 +34,7 @@
 #endif
 
 #define SR_LIST_INIT_SIZE 4  /**< Initial size of the sysrepo list (in number of elements). */
+#define SR_CACHE_LINE_SIZE 64  /**< Size of a CPU cache line, used to separate data accessed by different threads. */
 
 int
 sr_llist_init(sr_llist_t **llist_p)
@@ -544,6 +545,211 @@ sr_cbuff_items_in_queue(sr_cbuff_t *buffer)
     }
 }
 
+/**
+ * @brief Bounded lock-free MPMC FIFO queue (array-based, each cell carries a sequence
+ * number that tells producers and consumers whether the cell is free or filled).
+ * Elements that do not fit into the ring go to a mutex-protected overflow buffer.
+ */
+typedef struct sr_mpmc_queue_s {
+    size_t mask;                  /**< Capacity of the ring - 1 (capacity is a power of two). */
+    size_t elem_size;             /**< Size of one element in the queue. */
+    size_t *sequence;             /**< Sequence numbers of the cells of the ring. */
+    uint8_t *data;                /**< Data of the cells of the ring. */
+    char pad1[SR_CACHE_LINE_SIZE];
+    size_t enqueue_pos;           /**< Position of the next enqueue (accessed atomically). */
+    char pad2[SR_CACHE_LINE_SIZE];
+    size_t dequeue_pos;           /**< Position of the next dequeue (accessed atomically). */
+    char pad3[SR_CACHE_LINE_SIZE];
+    size_t overflow_count;        /**< Number of elements in the overflow buffer (accessed atomically). */
+    pthread_mutex_t overflow_lock;/**< Mutex guarding the overflow buffer. */
+    sr_cbuff_t *overflow;         /**< Overflow buffer used when the ring is full. */
+} sr_mpmc_queue_t;
+
+int
+sr_mpmc_queue_init(const size_t capacity, const size_t elem_size, sr_mpmc_queue_t **queue_p)
+{
+    sr_mpmc_queue_t *queue = NULL;
+    size_t size = 2;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG(queue_p);
+
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    SR_LOG_DBG("Initiating MPMC queue for %zu elements.", size);
+
+    queue = calloc(1, sizeof(*queue));
+    CHECK_NULL_NOMEM_RETURN(queue);
+
+    queue->sequence = calloc(size, sizeof(*queue->sequence));
+    CHECK_NULL_NOMEM_GOTO(queue->sequence, rc, cleanup);
+    queue->data = calloc(size, elem_size);
+    CHECK_NULL_NOMEM_GOTO(queue->data, rc, cleanup);
+
+    rc = sr_cbuff_init(size, elem_size, &queue->overflow);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to initialize the overflow buffer.");
+
+    for (size_t i = 0; i < size; ++i) {
+        queue->sequence[i] = i;
+    }
+    queue->mask = size - 1;
+    queue->elem_size = elem_size;
+    pthread_mutex_init(&queue->overflow_lock, NULL);
+
+    *queue_p = queue;
+    return SR_ERR_OK;
+
+cleanup:
+    sr_mpmc_queue_cleanup(queue);
+    return rc;
+}
+
+void
+sr_mpmc_queue_cleanup(sr_mpmc_queue_t *queue)
+{
+    if (NULL != queue) {
+        if (NULL != queue->overflow) {
+            pthread_mutex_destroy(&queue->overflow_lock);
+        }
+        sr_cbuff_cleanup(queue->overflow);
+        free(queue->sequence);
+        free(queue->data);
+        free(queue);
+    }
+}
+
+/**
+ * @brief Tries to enqueue an element into the lock-free ring, returns false if the ring is full.
+ */
+static bool
+sr_mpmc_queue_ring_push(sr_mpmc_queue_t *queue, void *item)
+{
+    size_t pos = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_RELAXED);
+    size_t seq = 0;
+    intptr_t diff = 0;
+
+    for (;;) {
+        seq = __atomic_load_n(&queue->sequence[pos & queue->mask], __ATOMIC_ACQUIRE);
+        diff = (intptr_t)seq - (intptr_t)pos;
+        if (0 == diff) {
+            /* the cell is free, try to claim it */
+            if (__atomic_compare_exchange_n(&queue->enqueue_pos, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* the cell still holds an element from the previous round - the ring is full */
+            return false;
+        } else {
+            /* another producer claimed the cell */
+            pos = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    memcpy(queue->data + ((pos & queue->mask) * queue->elem_size), item, queue->elem_size);
+    __atomic_store_n(&queue->sequence[pos & queue->mask], pos + 1, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+/**
+ * @brief Tries to dequeue an element from the lock-free ring, returns false if the ring is empty.
+ */
+static bool
+sr_mpmc_queue_ring_pop(sr_mpmc_queue_t *queue, void *item)
+{
+    size_t pos = __atomic_load_n(&queue->dequeue_pos, __ATOMIC_RELAXED);
+    size_t seq = 0;
+    intptr_t diff = 0;
+
+    for (;;) {
+        seq = __atomic_load_n(&queue->sequence[pos & queue->mask], __ATOMIC_ACQUIRE);
+        diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (0 == diff) {
+            /* the cell is filled, try to claim it */
+            if (__atomic_compare_exchange_n(&queue->dequeue_pos, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* the cell has not been filled yet - the ring is empty */
+            return false;
+        } else {
+            /* another consumer claimed the cell */
+            pos = __atomic_load_n(&queue->dequeue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    memcpy(item, queue->data + ((pos & queue->mask) * queue->elem_size), queue->elem_size);
+    __atomic_store_n(&queue->sequence[pos & queue->mask], pos + queue->mask + 1, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+int
+sr_mpmc_queue_enqueue(sr_mpmc_queue_t *queue, void *item)
+{
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG2(queue, item);
+
+    /* once the overflow buffer is in use, new elements must follow the ones already in there */
+    if (0 == __atomic_load_n(&queue->overflow_count, __ATOMIC_ACQUIRE) && sr_mpmc_queue_ring_push(queue, item)) {
+        return SR_ERR_OK;
+    }
+
+    pthread_mutex_lock(&queue->overflow_lock);
+    rc = sr_cbuff_enqueue(queue->overflow, item);
+    if (SR_ERR_OK == rc) {
+        __atomic_add_fetch(&queue->overflow_count, 1, __ATOMIC_SEQ_CST);
+    }
+    pthread_mutex_unlock(&queue->overflow_lock);
+
+    return rc;
+}
+
+bool
+sr_mpmc_queue_dequeue(sr_mpmc_queue_t *queue, void *item)
+{
+    bool dequeued = false;
+
+    if (NULL == queue || NULL == item) {
+        return false;
+    }
+
+    if (sr_mpmc_queue_ring_pop(queue, item)) {
+        return true;
+    }
+
+    /* the ring is empty, continue with the elements that did not fit into it */
+    if (0 != __atomic_load_n(&queue->overflow_count, __ATOMIC_ACQUIRE)) {
+        pthread_mutex_lock(&queue->overflow_lock);
+        dequeued = sr_cbuff_dequeue(queue->overflow, item);
+        if (dequeued) {
+            __atomic_sub_fetch(&queue->overflow_count, 1, __ATOMIC_SEQ_CST);
+        }
+        pthread_mutex_unlock(&queue->overflow_lock);
+    }
+
+    return dequeued;
+}
+
+size_t
+sr_mpmc_queue_items_in_queue(sr_mpmc_queue_t *queue)
+{
+    size_t enqueue_pos = 0, dequeue_pos = 0;
+
+    if (NULL == queue) {
+        return 0;
+    }
+
+    dequeue_pos = __atomic_load_n(&queue->dequeue_pos, __ATOMIC_SEQ_CST);
+    enqueue_pos = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_SEQ_CST);
+
+    return ((enqueue_pos > dequeue_pos) ? (enqueue_pos - dequeue_pos) : 0) +
+            __atomic_load_n(&queue->overflow_count, __ATOMIC_SEQ_CST);
+}
+
 /**
  * @brief Holds binary tree with filename -> fd maping. This structure
  * is used to check file locks inside of the process and to avoid
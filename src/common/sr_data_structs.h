@@ -27,7 +27,8 @@
  * @ingroup common
  * @{
  *
- * @brief Data structures used in sysrepo (list, linked-list, self-balanced binary tree, circular buffer).
+ * @brief Data structures used in sysrepo (list, linked-list, self-balanced binary tree, circular buffer,
+ * lock-free MPMC queue).
  */
 
 #include <stdint.h>
@@ -325,6 +326,73 @@ bool sr_cbuff_dequeue(sr_cbuff_t *buffer, void *item);
  */
 size_t sr_cbuff_items_in_queue(sr_cbuff_t *buffer);
 
+/**
+ * @brief Bounded lock-free multi-producer multi-consumer FIFO queue context.
+ */
+typedef struct sr_mpmc_queue_s sr_mpmc_queue_t;
+
+/**
+ * @brief Initializes lock-free MPMC FIFO queue of elements with given size.
+ *
+ * Elements are stored in a ring of fixed capacity (rounded up to a power of two)
+ * that is accessed without locking. If the ring is full, elements are enqueued
+ * into a mutex-protected circular buffer, which is drained once the ring is empty,
+ * so that enqueue never fails because of lack of space and FIFO order is kept.
+ *
+ * @param[in] capacity Capacity of the lock-free ring in number of elements.
+ * @param[in] elem_size Size of one element (in bytes).
+ * @param[out] queue MPMC queue context.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int sr_mpmc_queue_init(const size_t capacity, const size_t elem_size, sr_mpmc_queue_t **queue);
+
+/**
+ * @brief Cleans up MPMC queue.
+ *
+ * All memory allocated within provided queue context will be freed.
+ *
+ * @param[in] queue MPMC queue context.
+ */
+void sr_mpmc_queue_cleanup(sr_mpmc_queue_t *queue);
+
+/**
+ * @brief Enqueues an element into MPMC queue. Can be called from multiple threads concurrently.
+ *
+ * @note O(1).
+ *
+ * @param[in] queue MPMC queue context.
+ * @param[in] item The element to be enqueued (pointer to memory from where
+ * the data will be copied to the queue).
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int sr_mpmc_queue_enqueue(sr_mpmc_queue_t *queue, void *item);
+
+/**
+ * @brief Dequeues an element from MPMC queue. Can be called from multiple threads concurrently.
+ *
+ * @note O(1).
+ *
+ * @param[in] queue MPMC queue context.
+ * @param[out] item Pointer to memory where dequeued data will be copied.
+ *
+ * @return TRUE if an element was dequeued, FALSE if the queue is empty.
+ */
+bool sr_mpmc_queue_dequeue(sr_mpmc_queue_t *queue, void *item);
+
+/**
+ * @brief Return number of elements currently stored in the queue. The value is only
+ * approximate if the queue is being accessed concurrently.
+ *
+ * @note O(1).
+ *
+ * @param[in] queue MPMC queue context.
+ *
+ * @return Number of elements currently stored in the queue.
+ */
+size_t sr_mpmc_queue_items_in_queue(sr_mpmc_queue_t *queue);
+
 /**
  * @brief Locking set context.
  */
@@ -63,6 +63,8 @@ sr_gpb_operation_name(Sr__Operation operation)
         return "set-item";
     case SR__OPERATION__SET_ITEM_STR:
         return "set-item-str";
+    case SR__OPERATION__EDIT_BATCH:
+        return "edit-batch";
     case SR__OPERATION__DELETE_ITEM:
         return "delete-item";
     case SR__OPERATION__MOVE_ITEM:
@@ -113,6 +115,10 @@ sr_gpb_operation_name(Sr__Operation operation)
         return "delayed-msg";
     case SR__OPERATION__NACM_RELOAD:
         return "nacm-reload";
+    case SR__OPERATION__EVENT_NOTIF_REPLAY_CONTINUE:
+        return "event-notif-replay-continue";
+    case SR__OPERATION__GET_ITEMS_CURSOR_TIMEOUT:
+        return "get-items-cursor-timeout";
     case _SR__OPERATION_IS_INT_SIZE:
         return "unknown";
     }
@@ -258,6 +264,12 @@ sr_gpb_req_alloc(sr_mem_ctx_t *sr_mem, const Sr__Operation operation, const uint
             sr__set_item_str_req__init((Sr__SetItemStrReq*)sub_msg);
             req->set_item_str_req = (Sr__SetItemStrReq*)sub_msg;
             break;
+        case SR__OPERATION__EDIT_BATCH:
+            sub_msg = sr_calloc(sr_mem, 1, sizeof(Sr__EditBatchReq));
+            CHECK_NULL_NOMEM_GOTO(sub_msg, rc, error);
+            sr__edit_batch_req__init((Sr__EditBatchReq*)sub_msg);
+            req->edit_batch_req = (Sr__EditBatchReq*)sub_msg;
+            break;
         case SR__OPERATION__DELETE_ITEM:
             sub_msg = sr_calloc(sr_mem, 1, sizeof(Sr__DeleteItemReq));
             CHECK_NULL_NOMEM_GOTO(sub_msg, rc, error);
@@ -526,6 +538,12 @@ sr_gpb_resp_alloc(sr_mem_ctx_t *sr_mem, const Sr__Operation operation, const uin
             sr__set_item_str_resp__init((Sr__SetItemStrResp*)sub_msg);
             resp->set_item_str_resp = (Sr__SetItemStrResp*)sub_msg;
             break;
+        case SR__OPERATION__EDIT_BATCH:
+            sub_msg = sr_calloc(sr_mem, 1, sizeof(Sr__EditBatchResp));
+            CHECK_NULL_NOMEM_GOTO(sub_msg, rc, error);
+            sr__edit_batch_resp__init((Sr__EditBatchResp*)sub_msg);
+            resp->edit_batch_resp = (Sr__EditBatchResp*)sub_msg;
+            break;
         case SR__OPERATION__DELETE_ITEM:
             sub_msg = sr_calloc(sr_mem, 1, sizeof(Sr__DeleteItemResp));
             CHECK_NULL_NOMEM_GOTO(sub_msg, rc, error);
@@ -866,6 +884,18 @@ sr_gpb_internal_req_alloc(sr_mem_ctx_t *sr_mem, const Sr__Operation operation, S
             sr__nacm_reload_req__init((Sr__NacmReloadReq*)sub_msg);
             req->nacm_reload_req = (Sr__NacmReloadReq*)sub_msg;
             break;
+        case SR__OPERATION__EVENT_NOTIF_REPLAY_CONTINUE:
+            sub_msg = sr_calloc(sr_mem, 1, sizeof(Sr__EventNotifReplayContinueReq));
+            CHECK_NULL_NOMEM_GOTO(sub_msg, rc, error);
+            sr__event_notif_replay_continue_req__init((Sr__EventNotifReplayContinueReq*)sub_msg);
+            req->event_notif_replay_continue_req = (Sr__EventNotifReplayContinueReq*)sub_msg;
+            break;
+        case SR__OPERATION__GET_ITEMS_CURSOR_TIMEOUT:
+            sub_msg = sr_calloc(sr_mem, 1, sizeof(Sr__GetItemsCursorTimeoutReq));
+            CHECK_NULL_NOMEM_GOTO(sub_msg, rc, error);
+            sr__get_items_cursor_timeout_req__init((Sr__GetItemsCursorTimeoutReq*)sub_msg);
+            req->get_items_cursor_timeout_req = (Sr__GetItemsCursorTimeoutReq*)sub_msg;
+            break;
 
         default:
             break;
@@ -957,6 +987,9 @@ sr_gpb_msg_validate(const Sr__Msg *msg, const Sr__Msg__MsgType type, const Sr__O
             case SR__OPERATION__SET_ITEM_STR:
                 CHECK_NULL_RETURN(msg->request->set_item_str_req, SR_ERR_MALFORMED_MSG);
                 break;
+            case SR__OPERATION__EDIT_BATCH:
+                CHECK_NULL_RETURN(msg->request->edit_batch_req, SR_ERR_MALFORMED_MSG);
+                break;
             case SR__OPERATION__DELETE_ITEM:
                 CHECK_NULL_RETURN(msg->request->delete_item_req, SR_ERR_MALFORMED_MSG);
                 break;
@@ -1073,6 +1106,9 @@ sr_gpb_msg_validate(const Sr__Msg *msg, const Sr__Msg__MsgType type, const Sr__O
             case SR__OPERATION__SET_ITEM_STR:
                 CHECK_NULL_RETURN(msg->response->set_item_str_resp, SR_ERR_MALFORMED_MSG);
                 break;
+            case SR__OPERATION__EDIT_BATCH:
+                CHECK_NULL_RETURN(msg->response->edit_batch_resp, SR_ERR_MALFORMED_MSG);
+                break;
             case SR__OPERATION__DELETE_ITEM:
                 CHECK_NULL_RETURN(msg->response->delete_item_resp, SR_ERR_MALFORMED_MSG);
                 break;
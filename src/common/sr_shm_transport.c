@@ -0,0 +1,385 @@
+/**
+ * @file sr_shm_transport.c
+ * @author Rastislav Szabo <raszabo@cisco.com>, Lukas Macko <lmacko@cisco.com>
+ * @brief Shared-memory transport of messages between Sysrepo Engine and local clients.
+ *
+ * @copyright
+ * Copyright 2016 Cisco Systems, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! @cond doxygen_suppress
+#define _GNU_SOURCE
+//! @endcond
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#include "sr_common.h"
+#include "sr_shm_transport.h"
+
+#ifdef ENABLE_SHM_TRANSPORT
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+#define SR_SHM_MAGIC          0x53524d31  /**< Magic number identifying the shared memory segment ("SRM1"). */
+#define SR_SHM_RING_MIN_SIZE  4096        /**< Minimal size of a ring. */
+#define SR_SHM_RING_MAX_SIZE  (1 << 30)   /**< Maximal size of a ring. */
+#define SR_SHM_ALIGN          64          /**< Alignment of the shared variables (cache line size). */
+
+/**
+ * @brief Shared header of a ring. The positions are free-running counters,
+ * the producer owns the head, the consumer owns the tail.
+ */
+typedef struct sr_shm_ring_hdr_s {
+    uint32_t head __attribute__((aligned(SR_SHM_ALIGN)));  /**< Number of bytes ever written. */
+    uint32_t tail __attribute__((aligned(SR_SHM_ALIGN)));  /**< Number of bytes ever read. */
+    uint32_t producer_waiting;                             /**< Set by the producer waiting for space. */
+    uint32_t wake_seq;                                     /**< Futex word of the waiting producer. */
+    uint32_t closed;                                       /**< Set once either side closes the transport. */
+} sr_shm_ring_hdr_t;
+
+/**
+ * @brief Header of the shared memory segment, followed by the data of the client-to-Engine
+ * and the Engine-to-client rings.
+ */
+typedef struct sr_shm_segment_hdr_s {
+    uint32_t magic;                /**< ::SR_SHM_MAGIC */
+    uint32_t ring_size;            /**< Size of the data of each ring. */
+    sr_shm_ring_hdr_t rings[2];    /**< Headers of the client-to-Engine and the Engine-to-client ring. */
+} __attribute__((aligned(SR_SHM_ALIGN))) sr_shm_segment_hdr_t;
+
+/**
+ * @brief Sets up the rings of the transport within the mapped segment.
+ */
+static void
+sr_shm_transport_rings_setup(sr_shm_transport_t *transport, uint32_t ring_size, bool client)
+{
+    sr_shm_segment_hdr_t *seg = transport->mem;
+    uint8_t *data = (uint8_t *)transport->mem + sizeof(*seg);
+    sr_shm_ring_t *c2e = client ? &transport->tx : &transport->rx;
+    sr_shm_ring_t *e2c = client ? &transport->rx : &transport->tx;
+
+    /* the size is stored locally, the value in the segment can be modified by the peer */
+    c2e->hdr = &seg->rings[0];
+    c2e->data = data;
+    c2e->size = ring_size;
+    e2c->hdr = &seg->rings[1];
+    e2c->data = data + ring_size;
+    e2c->size = ring_size;
+}
+
+bool
+sr_shm_transport_enabled()
+{
+#ifdef ENABLE_SHM_TRANSPORT
+    const char *env_str = getenv(SR_SHM_TRANSPORT_ENV);
+
+    return (NULL == env_str || 0 != strcmp(env_str, "0"));
+#else
+    return false;
+#endif
+}
+
+int
+sr_shm_transport_create(size_t ring_size, sr_shm_transport_t **transport_p)
+{
+#ifdef ENABLE_SHM_TRANSPORT
+    sr_shm_transport_t *transport = NULL;
+    sr_shm_segment_hdr_t *seg = NULL;
+    void *mem = NULL;
+    size_t size = SR_SHM_RING_MIN_SIZE;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG(transport_p);
+
+    while (size < ring_size && size < SR_SHM_RING_MAX_SIZE) {
+        size <<= 1;
+    }
+
+    transport = calloc(1, sizeof(*transport));
+    CHECK_NULL_NOMEM_RETURN(transport);
+    transport->mem_size = sizeof(*seg) + 2 * size;
+
+    transport->fd = memfd_create("sysrepo-connection", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (-1 == transport->fd) {
+        SR_LOG_ERR("Unable to create shared memory segment: %s", sr_strerror_safe(errno));
+        rc = SR_ERR_INTERNAL;
+        goto cleanup;
+    }
+    if (-1 == ftruncate(transport->fd, transport->mem_size)) {
+        SR_LOG_ERR("Unable to resize shared memory segment: %s", sr_strerror_safe(errno));
+        rc = SR_ERR_INTERNAL;
+        goto cleanup;
+    }
+    /* the size of the segment must not change while it is mapped by the Engine */
+    if (-1 == fcntl(transport->fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL)) {
+        SR_LOG_ERR("Unable to seal shared memory segment: %s", sr_strerror_safe(errno));
+        rc = SR_ERR_INTERNAL;
+        goto cleanup;
+    }
+
+    mem = mmap(NULL, transport->mem_size, PROT_READ | PROT_WRITE, MAP_SHARED, transport->fd, 0);
+    if (MAP_FAILED == mem) {
+        SR_LOG_ERR("Unable to map shared memory segment: %s", sr_strerror_safe(errno));
+        rc = SR_ERR_INTERNAL;
+        goto cleanup;
+    }
+    transport->mem = mem;
+
+    seg = transport->mem;
+    seg->magic = SR_SHM_MAGIC;
+    seg->ring_size = size;
+    sr_shm_transport_rings_setup(transport, size, true);
+
+    *transport_p = transport;
+    return SR_ERR_OK;
+
+cleanup:
+    sr_shm_transport_cleanup(transport);
+    return rc;
+#else
+    (void)ring_size;
+    (void)transport_p;
+    return SR_ERR_UNSUPPORTED;
+#endif
+}
+
+int
+sr_shm_transport_attach(int fd, sr_shm_transport_t **transport_p)
+{
+#ifdef ENABLE_SHM_TRANSPORT
+    sr_shm_transport_t *transport = NULL;
+    sr_shm_segment_hdr_t *seg = NULL;
+    struct stat st = { 0, };
+    void *mem = NULL;
+    uint32_t size = 0;
+    int seals = 0, rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG_NORET(rc, transport_p);
+    if (SR_ERR_OK != rc) {
+        close(fd);
+        return rc;
+    }
+
+    transport = calloc(1, sizeof(*transport));
+    if (NULL == transport) {
+        SR_LOG_ERR_MSG("Unable to allocate memory for the shared-memory transport.");
+        close(fd);
+        return SR_ERR_NOMEM;
+    }
+    transport->fd = fd;
+
+    seals = fcntl(fd, F_GET_SEALS);
+    if (-1 == seals || !(seals & F_SEAL_SHRINK) || !(seals & F_SEAL_SEAL)) {
+        SR_LOG_ERR_MSG("Shared memory segment offered by the client is not sealed.");
+        rc = SR_ERR_INVAL_ARG;
+        goto cleanup;
+    }
+    if (-1 == fstat(fd, &st) || st.st_size < sizeof(*seg)) {
+        SR_LOG_ERR_MSG("Invalid size of the shared memory segment offered by the client.");
+        rc = SR_ERR_INVAL_ARG;
+        goto cleanup;
+    }
+    transport->mem_size = st.st_size;
+
+    mem = mmap(NULL, transport->mem_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == mem) {
+        SR_LOG_ERR("Unable to map shared memory segment: %s", sr_strerror_safe(errno));
+        rc = SR_ERR_INTERNAL;
+        goto cleanup;
+    }
+    transport->mem = mem;
+
+    seg = transport->mem;
+    size = seg->ring_size;
+    if (SR_SHM_MAGIC != seg->magic || size < SR_SHM_RING_MIN_SIZE || size > SR_SHM_RING_MAX_SIZE
+            || 0 != (size & (size - 1)) || sizeof(*seg) + 2 * (size_t)size != transport->mem_size) {
+        SR_LOG_ERR_MSG("Invalid header of the shared memory segment offered by the client.");
+        rc = SR_ERR_INVAL_ARG;
+        goto cleanup;
+    }
+    sr_shm_transport_rings_setup(transport, size, false);
+
+    /* the mapping stays valid after the descriptor is closed */
+    close(transport->fd);
+    transport->fd = -1;
+
+    *transport_p = transport;
+    return SR_ERR_OK;
+
+cleanup:
+    sr_shm_transport_cleanup(transport);
+    return rc;
+#else
+    (void)transport_p;
+    close(fd);
+    return SR_ERR_UNSUPPORTED;
+#endif
+}
+
+void
+sr_shm_transport_cleanup(sr_shm_transport_t *transport)
+{
+    if (NULL == transport) {
+        return;
+    }
+    if (NULL != transport->mem) {
+        if (NULL != transport->tx.hdr) {
+            __atomic_store_n(&transport->tx.hdr->closed, 1, __ATOMIC_SEQ_CST);
+            sr_shm_ring_wake_producer(&transport->tx);
+            __atomic_store_n(&transport->rx.hdr->closed, 1, __ATOMIC_SEQ_CST);
+            sr_shm_ring_wake_producer(&transport->rx);
+        }
+        munmap(transport->mem, transport->mem_size);
+    }
+    if (-1 != transport->fd) {
+        close(transport->fd);
+    }
+    free(transport);
+}
+
+size_t
+sr_shm_ring_write(sr_shm_ring_t *ring, const uint8_t *data, size_t len, bool *wakeup)
+{
+    uint32_t head = 0, tail = 0, used = 0, pos = 0, chunk = 0;
+    size_t cnt = 0;
+
+    *wakeup = false;
+
+    head = __atomic_load_n(&ring->hdr->head, __ATOMIC_RELAXED);
+    tail = __atomic_load_n(&ring->hdr->tail, __ATOMIC_ACQUIRE);
+    used = head - tail;
+    if (used >= ring->size) {
+        /* full (or corrupted by the peer, which only blocks its own connection) */
+        return 0;
+    }
+    cnt = MIN(len, ring->size - used);
+    if (0 == cnt) {
+        return 0;
+    }
+
+    pos = head & (ring->size - 1);
+    chunk = MIN(cnt, ring->size - pos);
+    memcpy(ring->data + pos, data, chunk);
+    memcpy(ring->data, data + chunk, cnt - chunk);
+
+    __atomic_store_n(&ring->hdr->head, head + (uint32_t)cnt, __ATOMIC_SEQ_CST);
+    /* the consumer may have seen the ring empty and gone idle */
+    *wakeup = (__atomic_load_n(&ring->hdr->tail, __ATOMIC_SEQ_CST) == head);
+
+    return cnt;
+}
+
+int
+sr_shm_ring_read(sr_shm_ring_t *ring, uint8_t *data, size_t len, size_t *read_len, bool *wakeup)
+{
+    uint32_t head = 0, tail = 0, avail = 0, pos = 0, chunk = 0;
+    size_t cnt = 0;
+
+    *read_len = 0;
+    *wakeup = false;
+
+    tail = __atomic_load_n(&ring->hdr->tail, __ATOMIC_RELAXED);
+    head = __atomic_load_n(&ring->hdr->head, __ATOMIC_ACQUIRE);
+    avail = head - tail;
+    if (avail > ring->size) {
+        SR_LOG_ERR_MSG("Inconsistent positions in the shared memory ring.");
+        return SR_ERR_MALFORMED_MSG;
+    }
+    cnt = MIN(len, avail);
+    if (0 == cnt) {
+        return SR_ERR_OK;
+    }
+
+    pos = tail & (ring->size - 1);
+    chunk = MIN(cnt, ring->size - pos);
+    memcpy(data, ring->data + pos, chunk);
+    memcpy(data + chunk, ring->data, cnt - chunk);
+
+    __atomic_store_n(&ring->hdr->tail, tail + (uint32_t)cnt, __ATOMIC_SEQ_CST);
+    /* pairs with the store of the flag and the load of the tail in sr_shm_ring_wait_announce */
+    *wakeup = (0 != __atomic_exchange_n(&ring->hdr->producer_waiting, 0, __ATOMIC_SEQ_CST));
+    *read_len = cnt;
+
+    return SR_ERR_OK;
+}
+
+size_t
+sr_shm_ring_readable(const sr_shm_ring_t *ring)
+{
+    uint32_t avail = __atomic_load_n(&ring->hdr->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&ring->hdr->tail, __ATOMIC_RELAXED);
+
+    return MIN(avail, ring->size);
+}
+
+bool
+sr_shm_ring_wait_announce(sr_shm_ring_t *ring)
+{
+    uint32_t head = 0, tail = 0;
+
+    __atomic_store_n(&ring->hdr->producer_waiting, 1, __ATOMIC_SEQ_CST);
+    tail = __atomic_load_n(&ring->hdr->tail, __ATOMIC_SEQ_CST);
+    head = __atomic_load_n(&ring->hdr->head, __ATOMIC_RELAXED);
+
+    return (head - tail < ring->size);
+}
+
+int
+sr_shm_ring_wait_space(sr_shm_ring_t *ring, uint32_t timeout)
+{
+#ifdef ENABLE_SHM_TRANSPORT
+    struct timespec ts = { timeout, 0 };
+    uint32_t seq = 0;
+
+    while (true) {
+        /* any wake-up after this load changes the futex word, so it cannot be missed */
+        seq = __atomic_load_n(&ring->hdr->wake_seq, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&ring->hdr->closed, __ATOMIC_SEQ_CST)) {
+            return SR_ERR_DISCONNECT;
+        }
+        if (sr_shm_ring_wait_announce(ring)) {
+            return SR_ERR_OK;
+        }
+        if (-1 == syscall(SYS_futex, &ring->hdr->wake_seq, FUTEX_WAIT, seq, (timeout > 0 ? &ts : NULL), NULL, 0)
+                && ETIMEDOUT == errno) {
+            SR_LOG_ERR_MSG("Timeout expired while waiting for space in the shared memory ring.");
+            return SR_ERR_TIME_OUT;
+        }
+        /* woken up, interrupted or the word changed meanwhile - check again */
+    }
+#else
+    (void)ring;
+    (void)timeout;
+    return SR_ERR_UNSUPPORTED;
+#endif
+}
+
+void
+sr_shm_ring_wake_producer(sr_shm_ring_t *ring)
+{
+#ifdef ENABLE_SHM_TRANSPORT
+    __atomic_add_fetch(&ring->hdr->wake_seq, 1, __ATOMIC_SEQ_CST);
+    syscall(SYS_futex, &ring->hdr->wake_seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#else
+    (void)ring;
+#endif
+}
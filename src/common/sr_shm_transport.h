@@ -0,0 +1,169 @@
+/**
+ * @file sr_shm_transport.h
+ * @author Rastislav Szabo <raszabo@cisco.com>, Lukas Macko <lmacko@cisco.com>
+ * @brief Shared-memory transport of messages between Sysrepo Engine and local clients.
+ *
+ * @copyright
+ * Copyright 2016 Cisco Systems, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SR_SHM_TRANSPORT_H_
+#define SR_SHM_TRANSPORT_H_
+
+/**
+ * @defgroup shm_transport Shared-memory Transport
+ * @ingroup common
+ * @{
+ *
+ * @brief A pair of single-producer single-consumer byte rings in a shared memory segment
+ * mapped by both the client and Sysrepo Engine, used instead of the unix-domain socket to
+ * transfer the (preamble-framed) messages of a connection.
+ *
+ * The segment is created by the client as a sealed memory file (its size cannot be changed
+ * while mapped by the Engine) and its file descriptor is passed to the Engine along with
+ * the version verification request. The socket stays open, it detects disconnection and carries
+ * one-byte wake-ups, which are sent only when the consumer may be idle (the ring was empty
+ * before the write) or the producer waits for space, so no system calls are needed
+ * while both sides keep up. A client producer waiting for space sleeps on a futex.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @brief One direction of the shared-memory transport (single producer, single consumer).
+ */
+typedef struct sr_shm_ring_s {
+    struct sr_shm_ring_hdr_s *hdr;  /**< Shared header of the ring (positions and flags). */
+    uint8_t *data;                  /**< Shared data of the ring. */
+    uint32_t size;                  /**< Size of the data of the ring (power of two). */
+} sr_shm_ring_t;
+
+/**
+ * @brief Shared-memory transport context of a connection.
+ */
+typedef struct sr_shm_transport_s {
+    int fd;              /**< File descriptor of the shared memory segment (-1 if already closed). */
+    void *mem;           /**< Mapped shared memory segment. */
+    size_t mem_size;     /**< Size of the mapped segment. */
+    sr_shm_ring_t tx;    /**< Ring where the messages are sent. */
+    sr_shm_ring_t rx;    /**< Ring where the messages are received. */
+} sr_shm_transport_t;
+
+/**
+ * @brief Returns TRUE if the shared-memory transport is available and not disabled
+ * by the SR_SHM_TRANSPORT_ENV environment variable.
+ *
+ * @return TRUE if the transport can be used.
+ */
+bool sr_shm_transport_enabled();
+
+/**
+ * @brief Creates a new shared memory segment with a ring in each direction and maps it (client side).
+ * The file descriptor of the segment (sr_shm_transport_t::fd) can be passed to the Engine.
+ *
+ * @param[in] ring_size Size of each ring in bytes (rounded up to a power of two).
+ * @param[out] transport Allocated transport context.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int sr_shm_transport_create(size_t ring_size, sr_shm_transport_t **transport);
+
+/**
+ * @brief Maps the shared memory segment created by a client (Engine side). The segment
+ * must be sealed against shrinking, so that the client cannot invalidate the mapping.
+ *
+ * @param[in] fd File descriptor of the segment received from the client (closed by the function).
+ * @param[out] transport Allocated transport context.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int sr_shm_transport_attach(int fd, sr_shm_transport_t **transport);
+
+/**
+ * @brief Marks the transport as closed (waking up the peer waiting for space),
+ * unmaps the segment, closes its file descriptor and releases the context.
+ *
+ * @param[in] transport Transport context.
+ */
+void sr_shm_transport_cleanup(sr_shm_transport_t *transport);
+
+/**
+ * @brief Writes as much of the data into the ring as fits.
+ *
+ * @param[in] ring Ring to write into.
+ * @param[in] data Data to be written.
+ * @param[in] len Length of the data.
+ * @param[out] wakeup TRUE if the consumer may be idle and needs to be woken up.
+ *
+ * @return Number of bytes written.
+ */
+size_t sr_shm_ring_write(sr_shm_ring_t *ring, const uint8_t *data, size_t len, bool *wakeup);
+
+/**
+ * @brief Reads up to the requested amount of data from the ring.
+ *
+ * @param[in] ring Ring to read from.
+ * @param[out] data Buffer for the data.
+ * @param[in] len Size of the buffer.
+ * @param[out] read_len Number of bytes read.
+ * @param[out] wakeup TRUE if the producer waits for space and needs to be woken up.
+ *
+ * @return Error code (SR_ERR_OK on success, SR_ERR_MALFORMED_MSG if the positions in
+ * the ring are inconsistent).
+ */
+int sr_shm_ring_read(sr_shm_ring_t *ring, uint8_t *data, size_t len, size_t *read_len, bool *wakeup);
+
+/**
+ * @brief Returns the number of bytes that can be read from the ring.
+ *
+ * @param[in] ring Ring context.
+ *
+ * @return Number of bytes available.
+ */
+size_t sr_shm_ring_readable(const sr_shm_ring_t *ring);
+
+/**
+ * @brief Announces that the producer waits for space in the ring. The consumer will request
+ * the wake-up by the next read that frees some space.
+ *
+ * @param[in] ring Ring context.
+ *
+ * @return TRUE if some space has been freed meanwhile, and the producer can continue immediately.
+ */
+bool sr_shm_ring_wait_announce(sr_shm_ring_t *ring);
+
+/**
+ * @brief Blocks the producer until some space is freed in the ring, the ring is closed
+ * or the timeout expires.
+ *
+ * @param[in] ring Ring context.
+ * @param[in] timeout Timeout in seconds (0 for no timeout).
+ *
+ * @return Error code (SR_ERR_OK on success, SR_ERR_TIME_OUT, SR_ERR_DISCONNECT if the ring has been closed).
+ */
+int sr_shm_ring_wait_space(sr_shm_ring_t *ring, uint32_t timeout);
+
+/**
+ * @brief Wakes up the producer sleeping in ::sr_shm_ring_wait_space.
+ *
+ * @param[in] ring Ring context.
+ */
+void sr_shm_ring_wake_producer(sr_shm_ring_t *ring);
+
+/**@} shm_transport */
+
+#endif /* SR_SHM_TRANSPORT_H_ */
@@ -562,6 +562,33 @@ cleanup:
     return rc;
 }
 
+LYD_FORMAT
+sr_data_file_format(int fd)
+{
+    char buf[64] = { 0, };
+    ssize_t len = 0, i = 0;
+
+    len = pread(fd, buf, sizeof buf, 0);
+    if (len <= 0) {
+        return SR_FILE_FORMAT_LY;
+    }
+
+#ifdef HAVE_LYD_LYB
+    /* LYB data always start with the magic number */
+    if (len >= 3 && 0 == memcmp(buf, "lyb", 3)) {
+        return LYD_LYB;
+    }
+#endif
+
+    while (i < len && isspace((unsigned char)buf[i])) {
+        ++i;
+    }
+    if (i == len) {
+        return SR_FILE_FORMAT_LY;
+    }
+    return ('{' == buf[i]) ? LYD_JSON : LYD_XML;
+}
+
 int
 sr_ly_set_contains(const struct ly_set *set, void *node, bool sorted)
 {
@@ -1512,7 +1539,7 @@ sr_copy_node_to_tree_internal(const struct lyd_node *top_parent, const struct ly
     struct lyd_node_anydata *sch_any = NULL;
     const struct lyd_node *child = NULL;
     size_t idx = 0;
-    bool prune = false;
+    bool prune = false, keep = false;
     sr_node_t *sr_subtree = NULL;
 
     CHECK_NULL_ARG2(node, sr_tree);
@@ -1568,9 +1595,9 @@ sr_copy_node_to_tree_internal(const struct lyd_node *top_parent, const struct ly
                 (0 < depth || slice_width > idx - slice_offset) /* slice width */ &&
                 (0 == depth || child_limit > idx) /* child_limit */ &&
                 (depth_limit > depth + 1) /* depth limit */) {
-                prune = false;
+                prune = keep = false;
                 if (NULL != pruning_cb) {
-                    rc = pruning_cb(pruning_ctx, child, &prune);
+                    rc = pruning_cb(pruning_ctx, child, &prune, &keep);
                     CHECK_RC_MSG_GOTO(rc, cleanup, "Tree pruning has failed.");
                 }
                 if (true == prune) {
@@ -1582,7 +1609,7 @@ sr_copy_node_to_tree_internal(const struct lyd_node *top_parent, const struct ly
                     goto cleanup;
                 }
                 rc = sr_copy_node_to_tree_internal(top_parent ? top_parent : node, child, depth + 1, slice_offset, slice_width,
-                        child_limit, depth_limit, pruning_cb, pruning_ctx, sr_subtree);
+                        child_limit, depth_limit, keep ? NULL : pruning_cb, pruning_ctx, sr_subtree);
                 if (SR_ERR_OK != rc) {
                     goto cleanup;
                 }
@@ -1630,8 +1657,8 @@ sr_nodes_to_tree_chunks(struct ly_set *nodes, size_t slice_offset, size_t slice_
     sr_node_t *trees = NULL;
     size_t tree_cnt = 0;
     sr_mem_snapshot_t snapshot = { 0, };
-    sr_bitset_t *pruned = NULL;
-    bool prune = false;
+    sr_bitset_t *pruned = NULL, *kept = NULL;
+    bool prune = false, keep = false;
     size_t i = 0, j = 0;
     char **chunk_ids = NULL;
     char *chunk_id = NULL;
@@ -1652,11 +1679,16 @@ sr_nodes_to_tree_chunks(struct ly_set *nodes, size_t slice_offset, size_t slice_
     if (NULL != pruning_cb) {
         rc = sr_bitset_init(nodes->number, &pruned);
         CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to initialize bitset.");
+        rc = sr_bitset_init(nodes->number, &kept);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to initialize bitset.");
         for (i = 0; i < nodes->number; ++i) {
-            rc = pruning_cb(pruning_ctx, nodes->set.d[i], &prune);
+            prune = keep = false;
+            rc = pruning_cb(pruning_ctx, nodes->set.d[i], &prune, &keep);
             CHECK_RC_MSG_GOTO(rc, cleanup, "Tree pruning has failed.");
             rc = sr_bitset_set(pruned, i, prune);
             CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to enable bit in a bitset.");
+            rc = sr_bitset_set(kept, i, keep);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to enable bit in a bitset.");
             tree_cnt += !prune;
         }
     } else {
@@ -1711,14 +1743,20 @@ sr_nodes_to_tree_chunks(struct ly_set *nodes, size_t slice_offset, size_t slice_
         if (prune) {
             continue;
         }
+        keep = false;
+        if (NULL != kept) {
+            rc = sr_bitset_get(kept, i, &keep);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to get value of a bit in a bitset.");
+        }
         trees[j]._sr_mem = sr_mem;
         rc = sr_copy_node_to_tree_internal(NULL, nodes->set.d[i], 0, slice_offset, slice_width, child_limit,
-                depth_limit, pruning_cb, pruning_ctx, trees + j);
+                depth_limit, keep ? NULL : pruning_cb, pruning_ctx, trees + j);
         ++j;
     }
 
 cleanup:
     sr_bitset_cleanup(pruned);
+    sr_bitset_cleanup(kept);
     if (SR_ERR_OK == rc) {
         *sr_trees = trees;
         *count = tree_cnt;
@@ -90,9 +90,10 @@ typedef struct sr_print_ctx_s {
 } sr_print_ctx_t;
 
 /**
- * Callback used to ask if a given subtree should be pruned away.
+ * Callback used to ask if a given subtree should be pruned away. If the callback sets *keep_subtree* to true,
+ * nothing will be pruned away from the subtree and the callback is not called for any of its descendants.
  */
-typedef int (*sr_tree_pruning_cb)(void *pruning_ctx, const struct lyd_node *subtree, bool *prune);
+typedef int (*sr_tree_pruning_cb)(void *pruning_ctx, const struct lyd_node *subtree, bool *prune, bool *keep_subtree);
 
 /**
  * @defgroup utils Utility Functions
@@ -343,6 +344,18 @@ int sr_get_peer_eid(int fd, uid_t *uid, gid_t *gid);
  */
 int sr_save_data_tree_file(const char *file_name, const struct lyd_node *data_tree, LYD_FORMAT format);
 
+/**
+ * @brief Detects the format of a data file from its first bytes, so that data files
+ * in different formats can coexist in one repository (e.g. during a migration to
+ * another ::SR_FILE_FORMAT_LY). The file offset is not changed.
+ *
+ * @param [in] fd Descriptor of the data file.
+ *
+ * @return Detected libyang data format, ::SR_FILE_FORMAT_LY if the file is empty
+ * or its content cannot be read.
+ */
+LYD_FORMAT sr_data_file_format(int fd);
+
 /**
  * @brief Check if the set contains the specified object.
  * @param[in] set Set to explore.
@@ -42,11 +42,58 @@
 #define CM_IN_BUFF_MIN_SPACE 512  /**< Minimal empty space in the input buffer. */
 #define CM_BUFF_ALLOC_CHUNK 1024  /**< Chunk size for buffer expansions. */
 
+#define CM_OUT_BUFF_HIGH_WATERMARK (256 * 1024)  /**< Amount of unsent data in the output buffer above which bulk senders are paused. */
+#define CM_OUT_BUFF_LOW_WATERMARK (64 * 1024)    /**< Amount of unsent data in the output buffer below which paused bulk senders are resumed. */
+
 #define CM_INIT_MSG_QUEUE_SIZE 10      /**< Initial size of the message queue. */
 #define CM_INIT_SESS_REQ_QUEUE_SIZE 2  /**< Initial size of the request queue buffer. */
+#define CM_INIT_CONN_QUEUE_SIZE 4      /**< Initial size of the queue of connections handed over to a reactor. */
 
 #define CM_MAX_SIGNAL_WATCHERS 2  /**< Maximum number of signals that Connection Manager can watch for. */
 
+#define CM_SHM_WAKEUP_BUFF_SIZE 64  /**< Maximum number of wake-up bytes consumed at once (shared-memory transport). */
+
+struct cm_delayed_request_ctx_s;
+
+/**
+ * @brief Reactor of Connection Manager - an event loop running in its own thread, serving the connections
+ * that it owns. Reactor 0 runs in the thread calling ::cm_start and also accepts new connections.
+ */
+typedef struct cm_reactor_s {
+    /** Connection Manager context this reactor belongs to. */
+    struct cm_ctx_s *cm_ctx;
+
+    /** Thread where the event loop of the reactor is running (not used for reactor 0). */
+    pthread_t thread;
+    /** Event loop context. */
+    struct ev_loop *event_loop;
+    /** Watcher for stop request events. */
+    ev_async stop_watcher;
+    /** Watcher for message enqueue events. */
+    ev_async msg_queue_watcher;
+
+    /** Queue of messages to be sent to their recipients. */
+    sr_cbuff_t *msg_queue;
+    /** Queue of accepted connections handed over to this reactor. */
+    sr_cbuff_t *conn_queue;
+    /** Mutex guarding the message and connection queues. */
+    pthread_mutex_t msg_queue_mutex;
+
+    /** Linked-list of all delayed requests (to be sent to the Request Processor after some timeout). */
+    struct cm_delayed_request_ctx_s *delayed_requests;
+
+    /** Number of connections owned by the reactor (guarded by cm_ctx_t::sm_lock). */
+    size_t conn_cnt;
+} cm_reactor_t;
+
+/**
+ * @brief Maps a session to the reactor owning its connection, used to route the messages from Request Processor.
+ */
+typedef struct cm_session_route_s {
+    uint32_t session_id;    /**< Session ID. */
+    cm_reactor_t *reactor;  /**< Reactor owning the connection of the session. */
+} cm_session_route_t;
+
 /**
  * @brief Connection Manager context.
  */
@@ -58,37 +105,39 @@ typedef struct cm_ctx_s {
     sm_ctx_t *sm_ctx;
     /** Request Processor context. */
     rp_ctx_t *rp_ctx;
+    /** Lock guarding Session Manager and CM session & connection data, which are shared by all reactors. */
+    pthread_mutex_t sm_lock;
 
     /** Path where unix-domain server is binded to. */
     const char *server_socket_path;
     /** Socket descriptor used to listen & accept new unix-domain connections. */
     int listen_socket_fd;
 
-    /** Queue of messages to be sent to their recipients. */
-    sr_cbuff_t *msg_queue;
-    /** Message queue mutex. */
-    pthread_mutex_t msg_queue_mutex;
-
-    /** Queue of requests to be sent to the Request Processor after some timeout. */
-    sr_cbuff_t *delayed_requests_queue;
-    /** Linked-list of all delayed requests (to be sent to the Request Processor after some timeout). */
-    struct cm_delayed_request_ctx_s *delayed_requests;
-
-    /** Thread where event loop will be running in case of library mode. */
+    /** Reactors serving the connections. */
+    cm_reactor_t *reactors;
+    /** Number of reactors. */
+    size_t reactor_count;
+    /** Index of the reactor where the next accepted connection is considered first. */
+    size_t next_reactor;
+    /** Routes of the sessions to reactors (used only with multiple reactors). */
+    sr_btree_t *session_routes;
+    /** Read-write lock guarding the session routes. */
+    pthread_rwlock_t session_routes_lock;
+
+    /** Thread where event loop of reactor 0 will be running in case of library mode. */
     pthread_t event_loop_thread;
+    /** TRUE if the threads of additional reactors are running. */
+    bool reactors_running;
 
-    /** Event loop context. */
-    struct ev_loop *event_loop;
     /** Watcher for events on server unix-domain socket. */
     ev_io server_watcher;
-    /** Watcher for stop request events. */
-    ev_async stop_watcher;
-    /** Watcher for message enqueue events. */
-    ev_async msg_queue_watcher;
     /** Watcher for signals. */
     ev_signal signal_watchers[CM_MAX_SIGNAL_WATCHERS];
     /** Callbacks called by individual signal watchers. */
     cm_signal_cb signal_callbacks[CM_MAX_SIGNAL_WATCHERS];
+
+    /** Number of times a notification replay has been paused until an output buffer drains (accessed atomically). */
+    size_t replay_pause_cnt;
 } cm_ctx_t;
 
 /**
@@ -106,11 +155,13 @@ typedef struct cm_buffer_s {
  */
 typedef struct cm_session_ctx_s {
     uint32_t rp_req_cnt;           /**< Number of session-related outstanding requests in Request Processor. */
+    uint64_t rp_req_id;            /**< Client-assigned identifier of the request outstanding in Request Processor (0 if none). */
     sr_cbuff_t *rp_request_queue;  /**< Queue of requests waiting for forwarding to Request Processor. */
     uint32_t rp_resp_expected;     /**< Number of expected session-related responses to be forwarded to Request Processor. */
     rp_session_t *rp_session;      /**< Request Processor's session context. */
     bool stop_requested;           /**< Session-stop requested, but there are still some outstanding requests in RP.
                                         Session will be freed as soon as the response comes from RP. */
+    cm_reactor_t *reactor;         /**< Reactor owning the connection of the session. */
 } cm_session_ctx_t;
 
 /**
@@ -118,10 +169,16 @@ typedef struct cm_session_ctx_s {
  */
 typedef struct cm_connection_ctx_s {
     cm_ctx_t *cm_ctx;      /**< Connection Manager context related to this connection. */
+    cm_reactor_t *reactor; /**< Reactor owning the connection. */
     cm_buffer_t in_buff;   /**< Input buffer. If not empty, there is some received data to be processed. */
     cm_buffer_t out_buff;  /**< Output buffer. If not empty, there is some data to be sent when receiver is ready. */
     ev_io read_watcher;    /**< Watcher for readable events on connection's socket. */
     ev_io write_watcher;   /**< Watcher for writable events on connection's socket. */
+    sr_list_t *drain_waiters;  /**< Internal requests to be forwarded to Request Processor once the output buffer drains. */
+    int shm_fd;                /**< Shared memory segment received from the client before version verification (-1 if none). */
+    sr_shm_transport_t *shm;   /**< Shared-memory transport of the connection (NULL if the socket is used). */
+    bool shm_tx;               /**< TRUE once the output is sent via the shared-memory transport
+                                    (after the version verification response has been flushed to the socket). */
 } cm_connection_ctx_t;
 
 /**
@@ -129,6 +186,7 @@ typedef struct cm_connection_ctx_s {
  */
 typedef struct cm_delayed_request_ctx_s {
     cm_ctx_t *cm_ctx;                       /**< Connection Manager context related to this request. */
+    cm_reactor_t *reactor;                  /**< Reactor where the request has been scheduled. */
     cm_session_ctx_t *session;              /**< Session context related to this request. */
     Sr__Msg *msg;                           /**< Message with the request. */
     ev_timer timer;                         /**< Timer used to determine when to send the request. */
@@ -222,6 +280,76 @@ cm_server_cleanup(cm_ctx_t *cm_ctx)
     }
 }
 
+/**
+ * @brief Compares two session routes by session ID.
+ */
+static int
+cm_session_route_cmp(const void *a, const void *b)
+{
+    const cm_session_route_t *route_a = (const cm_session_route_t*)a;
+    const cm_session_route_t *route_b = (const cm_session_route_t*)b;
+
+    if (route_a->session_id == route_b->session_id) {
+        return 0;
+    }
+    return (route_a->session_id < route_b->session_id) ? -1 : 1;
+}
+
+/**
+ * @brief Records that the messages of the session are to be processed by the given reactor.
+ */
+static int
+cm_session_route_add(cm_ctx_t *cm_ctx, uint32_t session_id, cm_reactor_t *reactor)
+{
+    cm_session_route_t *route = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG2(cm_ctx, reactor);
+
+    if (NULL == cm_ctx->session_routes) {
+        /* single reactor, nothing to route */
+        return SR_ERR_OK;
+    }
+
+    route = calloc(1, sizeof(*route));
+    CHECK_NULL_NOMEM_RETURN(route);
+    route->session_id = session_id;
+    route->reactor = reactor;
+
+    pthread_rwlock_wrlock(&cm_ctx->session_routes_lock);
+    rc = sr_btree_insert(cm_ctx->session_routes, route);
+    pthread_rwlock_unlock(&cm_ctx->session_routes_lock);
+
+    if (SR_ERR_OK != rc) {
+        SR_LOG_ERR("Unable to record the route of session id=%"PRIu32".", session_id);
+        free(route);
+    }
+
+    return rc;
+}
+
+/**
+ * @brief Removes the route of the session.
+ */
+static void
+cm_session_route_remove(cm_ctx_t *cm_ctx, uint32_t session_id)
+{
+    cm_session_route_t lookup = { 0, }, *route = NULL;
+
+    if (NULL == cm_ctx || NULL == cm_ctx->session_routes) {
+        return;
+    }
+
+    lookup.session_id = session_id;
+
+    pthread_rwlock_wrlock(&cm_ctx->session_routes_lock);
+    route = sr_btree_search(cm_ctx->session_routes, &lookup);
+    if (NULL != route) {
+        sr_btree_delete(cm_ctx->session_routes, route);
+    }
+    pthread_rwlock_unlock(&cm_ctx->session_routes_lock);
+}
+
 /**
  * @brief Cleans up Connection Manager-related session data. Automatically called from Session Manager.
  */
@@ -231,6 +359,9 @@ cm_session_data_cleanup(void *session)
     Sr__Msg *msg = NULL;
     sm_session_t *sm_session = (sm_session_t*)session;
     if ((NULL != sm_session) && (NULL != sm_session->cm_data)) {
+        if (NULL != sm_session->cm_data->reactor) {
+            cm_session_route_remove(sm_session->cm_data->reactor->cm_ctx, sm_session->id);
+        }
         while (sr_cbuff_dequeue(sm_session->cm_data->rp_request_queue, &msg)) {
             sr_msg_free(msg);
         }
@@ -250,6 +381,16 @@ cm_connection_data_cleanup(void *connection)
     if ((NULL != sm_connection) && (NULL != sm_connection->cm_data)) {
         free(sm_connection->cm_data->in_buff.data);
         free(sm_connection->cm_data->out_buff.data);
+        if (NULL != sm_connection->cm_data->drain_waiters) {
+            for (size_t i = 0; i < sm_connection->cm_data->drain_waiters->count; i++) {
+                sr_msg_free(sm_connection->cm_data->drain_waiters->data[i]);
+            }
+            sr_list_cleanup(sm_connection->cm_data->drain_waiters);
+        }
+        sr_shm_transport_cleanup(sm_connection->cm_data->shm);
+        if (-1 != sm_connection->cm_data->shm_fd) {
+            close(sm_connection->cm_data->shm_fd);
+        }
         free(sm_connection->cm_data);
         sm_connection->cm_data = NULL;
     }
@@ -269,7 +410,9 @@ cm_delayed_request_cb(struct ev_loop *loop, ev_timer *w, int revents)
     CHECK_NULL_ARG_VOID2(w, w->data);
     req = (cm_delayed_request_ctx_t*)w->data;
 
-    CHECK_NULL_ARG_VOID3(req, req->cm_ctx, req->msg);
+    CHECK_NULL_ARG_VOID4(req, req->cm_ctx, req->reactor, req->msg);
+
+    pthread_mutex_lock(&req->cm_ctx->sm_lock);
 
     if (NULL != req->session) {
         /* check if the session is still active */
@@ -291,11 +434,13 @@ cm_delayed_request_cb(struct ev_loop *loop, ev_timer *w, int revents)
         }
     }
 
+    pthread_mutex_unlock(&req->cm_ctx->sm_lock);
+
     /* remove the request from linked list */
-    if (req == req->cm_ctx->delayed_requests) {
-        req->cm_ctx->delayed_requests = req->next;
+    if (req == req->reactor->delayed_requests) {
+        req->reactor->delayed_requests = req->next;
     } else {
-        prev = req->cm_ctx->delayed_requests;
+        prev = req->reactor->delayed_requests;
         while ((NULL != prev) && (req != prev->next)) {
             prev = prev->next;
         }
@@ -311,14 +456,15 @@ cm_delayed_request_cb(struct ev_loop *loop, ev_timer *w, int revents)
 }
 
 /**
- * @brief Sends a message to the Request Processor after specified timeout.
+ * @brief Sends a message to the Request Processor after specified timeout. The timer runs in the event loop
+ * of the provided reactor.
  */
 static int
-cm_delayed_msg_process(cm_ctx_t *cm_ctx, cm_session_ctx_t *session, Sr__Msg *msg, double timeout)
+cm_delayed_msg_process(cm_ctx_t *cm_ctx, cm_reactor_t *reactor, cm_session_ctx_t *session, Sr__Msg *msg, double timeout)
 {
     cm_delayed_request_ctx_t *req = NULL, *prev = NULL;
 
-    CHECK_NULL_ARG2(cm_ctx, msg);
+    CHECK_NULL_ARG3(cm_ctx, reactor, msg);
 
     SR_LOG_DBG("Scheduling a delayed request for %f seconds.", timeout);
 
@@ -327,14 +473,15 @@ cm_delayed_msg_process(cm_ctx_t *cm_ctx, cm_session_ctx_t *session, Sr__Msg *msg
     CHECK_NULL_NOMEM_RETURN(req);
 
     req->cm_ctx = cm_ctx;
+    req->reactor = reactor;
     req->session = session;
     req->msg = msg;
 
-    /* put the context at the end of the linked-list in CM context */
-    if (NULL == cm_ctx->delayed_requests) {
-        cm_ctx->delayed_requests = req;
+    /* put the context at the end of the linked-list in the reactor */
+    if (NULL == reactor->delayed_requests) {
+        reactor->delayed_requests = req;
     } else {
-        prev = cm_ctx->delayed_requests;
+        prev = reactor->delayed_requests;
         while (NULL != prev->next) {
             prev = prev->next;
         }
@@ -344,16 +491,17 @@ cm_delayed_msg_process(cm_ctx_t *cm_ctx, cm_session_ctx_t *session, Sr__Msg *msg
     /* schedule the timer */
     ev_timer_init(&req->timer, cm_delayed_request_cb, timeout, 0.);
     req->timer.data = req;
-    ev_timer_start(cm_ctx->event_loop, &req->timer);
+    ev_timer_start(reactor->event_loop, &req->timer);
 
     return SR_ERR_OK;
 }
 
 /**
- * @brief Request removal of subscriptions with the specified destination address.
+ * @brief Request removal of subscriptions with the specified destination address. Delayed removal is scheduled
+ * in the provided reactor.
  */
 static int
-cm_subscr_unsubscribe_destination(cm_ctx_t *cm_ctx, const char *destination_address, double delay)
+cm_subscr_unsubscribe_destination(cm_ctx_t *cm_ctx, cm_reactor_t *reactor, const char *destination_address, double delay)
 {
     Sr__Msg *msg_req = NULL;
     sr_mem_ctx_t *sr_mem = NULL;
@@ -374,7 +522,7 @@ cm_subscr_unsubscribe_destination(cm_ctx_t *cm_ctx, const char *destination_addr
 
     if (delay > 0) {
         /* unsubscribe after timeout to prevent configuration flaps in running ds */
-        rc = cm_delayed_msg_process(cm_ctx, NULL, msg_req, delay);
+        rc = cm_delayed_msg_process(cm_ctx, reactor, NULL, msg_req, delay);
     } else {
         /* unsubscribe immediately */
         rc = rp_msg_process(cm_ctx->rp_ctx, NULL, msg_req);
@@ -394,13 +542,53 @@ cleanup:
     return rc;
 }
 
+/**
+ * @brief Forwards the internal requests waiting for the output buffer of the connection to drain
+ * to Request Processor.
+ */
+static void
+cm_conn_drain_waiters_release(cm_ctx_t *cm_ctx, sm_connection_t *conn)
+{
+    sr_list_t *waiters = NULL;
+    sm_session_t *session = NULL;
+    Sr__Msg *msg = NULL;
+    int rc = SR_ERR_OK;
+
+    if (NULL == conn->cm_data || NULL == conn->cm_data->drain_waiters) {
+        return;
+    }
+
+    waiters = conn->cm_data->drain_waiters;
+    conn->cm_data->drain_waiters = NULL;
+
+    for (size_t i = 0; i < waiters->count; i++) {
+        msg = waiters->data[i];
+        /* check if the session is still active */
+        rc = sm_session_find_id(cm_ctx->sm_ctx, msg->session_id, &session);
+        if (SR_ERR_OK != rc || NULL == session->cm_data) {
+            SR_LOG_DBG("Unable to find session context for the request waiting for fd=%d to drain "
+                    "(session id=%"PRIu32"), ignoring the request.", conn->fd, msg->session_id);
+            sr_msg_free(msg);
+            continue;
+        }
+        rc = rp_msg_process(cm_ctx->rp_ctx, session->cm_data->rp_session, msg);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_WRN_MSG("Unable to send internal request to the Request Processor.");
+        }
+    }
+
+    sr_list_cleanup(waiters);
+}
+
 /**
  * @brief Close the connection inside of Connection Manager and Request Processor.
+ * Must be called from the reactor owning the connection, with sm_lock held.
  */
 static int
 cm_conn_close(cm_ctx_t *cm_ctx, sm_connection_t *conn)
 {
     sm_session_list_t *sess = NULL;
+    cm_reactor_t *reactor = NULL;
     bool drop_session = false;
 
     CHECK_NULL_ARG2(cm_ctx, conn);
@@ -408,8 +596,12 @@ cm_conn_close(cm_ctx_t *cm_ctx, sm_connection_t *conn)
     SR_LOG_INF("Closing the connection %p.", (void*)conn);
 
     if (NULL != conn->cm_data) {
-        ev_io_stop(cm_ctx->event_loop, &conn->cm_data->read_watcher);
-        ev_io_stop(cm_ctx->event_loop, &conn->cm_data->write_watcher);
+        reactor = conn->cm_data->reactor;
+        ev_io_stop(reactor->event_loop, &conn->cm_data->read_watcher);
+        ev_io_stop(reactor->event_loop, &conn->cm_data->write_watcher);
+        reactor->conn_cnt -= 1;
+        /* nothing more will be sent over the connection, let the waiting senders continue (and fail) */
+        cm_conn_drain_waiters_release(cm_ctx, conn);
     }
     close(conn->fd);
 
@@ -445,7 +637,7 @@ cm_conn_close(cm_ctx_t *cm_ctx, sm_connection_t *conn)
         SR_LOG_DBG("Subscription server at '%s' has disconnected.", conn->dst_address);
         /* we must unsubscribe immediately because otherwise this connection may be
          * found again before it is removed and by removing it twice we get a segfault */
-        cm_subscr_unsubscribe_destination(cm_ctx, conn->dst_address, 0);
+        cm_subscr_unsubscribe_destination(cm_ctx, reactor, conn->dst_address, 0);
     }
 
     /* cleanup connection, pointers to the connection from outstanding sessions will be set to NULL */
@@ -484,6 +676,44 @@ cm_conn_buffer_expand(const sm_connection_t *conn, cm_buffer_t *buff, size_t req
     return SR_ERR_OK;
 }
 
+/**
+ * @brief Flush contents of the output buffer of the given connection into its shared-memory ring.
+ */
+static int
+cm_conn_shm_flush(sm_connection_t *connection)
+{
+    cm_buffer_t *buff = &connection->cm_data->out_buff;
+    sr_shm_ring_t *ring = &connection->cm_data->shm->tx;
+    uint8_t wakeup_byte = 0;
+    bool wakeup = false;
+
+    SR_LOG_DBG("Writing %zu bytes of data into shared memory of fd %d.", (buff->pos - buff->start), connection->fd);
+
+    while (buff->start < buff->pos) {
+        buff->start += sr_shm_ring_write(ring, (buff->data + buff->start), (buff->pos - buff->start), &wakeup);
+        if (wakeup && -1 == send(connection->fd, &wakeup_byte, sizeof(wakeup_byte), 0)
+                && EWOULDBLOCK != errno && EAGAIN != errno) {
+            /* a full socket means that the client has not consumed previous wake-ups yet */
+            SR_LOG_ERR("Error by writing data to fd %d: %s.", connection->fd, sr_strerror_safe(errno));
+            connection->close_requested = true;
+            return SR_ERR_OK;
+        }
+        if (buff->start < buff->pos && !sr_shm_ring_wait_announce(ring)) {
+            /* the ring is full, continue once the client sends a wake-up */
+            SR_LOG_DBG("Shared memory ring of fd %d is full.", connection->fd);
+            break;
+        }
+    }
+
+    if (buff->start == buff->pos) {
+        /* no more data left in the buffer */
+        buff->pos = 0;
+        buff->start = 0;
+    }
+
+    return SR_ERR_OK;
+}
+
 /**
  * @brief Flush contents of the output buffer of the given connection.
  */
@@ -505,6 +735,10 @@ cm_conn_out_buff_flush(cm_ctx_t *cm_ctx, sm_connection_t *connection)
         return rc;
     }
 
+    if (connection->cm_data->shm_tx) {
+        return cm_conn_shm_flush(connection);
+    }
+
     SR_LOG_DBG("Sending %zu bytes of data.", (buff_size - buff_pos));
 
     do {
@@ -520,7 +754,7 @@ cm_conn_out_buff_flush(cm_ctx_t *cm_ctx, sm_connection_t *connection)
                 /* mark the position where the unsent data start */
                 connection->cm_data->out_buff.start = buff_pos;
                 /* monitor fd for writable event */
-                ev_io_start(cm_ctx->event_loop, &connection->cm_data->write_watcher);
+                ev_io_start(connection->cm_data->reactor->event_loop, &connection->cm_data->write_watcher);
                 break;
             } else {
                 /* error by writing - close the connection due to an error */
@@ -535,22 +769,38 @@ cm_conn_out_buff_flush(cm_ctx_t *cm_ctx, sm_connection_t *connection)
         /* no more data left in the buffer */
         buff->pos = 0;
         connection->cm_data->out_buff.start = 0;
+        if (NULL != connection->cm_data->shm) {
+            /* the version verification response is out, switch to the shared memory */
+            connection->cm_data->shm_tx = true;
+        }
     }
 
     return rc;
 }
 
 /**
- * @brief Sends a message to the recipient identified by session context.
+ * @brief Copies client-assigned request identifier from the request into the response (if present).
+ */
+static void
+cm_msg_set_request_id(Sr__Msg *msg_resp, uint64_t request_id)
+{
+    if (0 != request_id) {
+        msg_resp->has_request_id = true;
+        msg_resp->request_id = request_id;
+    }
+}
+
+/**
+ * @brief Packs a message into the output buffer of the connection.
  */
 static int
-cm_msg_send_connection(cm_ctx_t *cm_ctx, sm_connection_t *connection, Sr__Msg *msg)
+cm_conn_msg_pack(sm_connection_t *connection, Sr__Msg *msg)
 {
     cm_buffer_t *buff = NULL;
     size_t msg_size = 0;
     int rc = SR_ERR_OK;
 
-    CHECK_NULL_ARG4(cm_ctx, connection, connection->cm_data, msg);
+    CHECK_NULL_ARG3(connection, connection->cm_data, msg);
 
     buff = &connection->cm_data->out_buff;
 
@@ -572,7 +822,24 @@ cm_msg_send_connection(cm_ctx_t *cm_ctx, sm_connection_t *connection, Sr__Msg *m
         /* write the message */
         sr__msg__pack(msg, (buff->data + buff->pos));
         buff->pos += msg_size;
+    }
+
+    return rc;
+}
+
+/**
+ * @brief Sends a message to the recipient identified by session context.
+ */
+static int
+cm_msg_send_connection(cm_ctx_t *cm_ctx, sm_connection_t *connection, Sr__Msg *msg)
+{
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG4(cm_ctx, connection, connection->cm_data, msg);
 
+    rc = cm_conn_msg_pack(connection, msg);
+
+    if (SR_ERR_OK == rc) {
         /* flush the buffer */
         rc = cm_conn_out_buff_flush(cm_ctx, connection);
         if ((connection->close_requested) || (SR_ERR_OK != rc)) {
@@ -593,7 +860,7 @@ cm_session_start_internal(cm_ctx_t *cm_ctx, sm_connection_t *conn, const char *e
     sm_session_t *session = NULL;
     int rc = SR_ERR_OK;
 
-    CHECK_NULL_ARG3(cm_ctx, conn, session_p);
+    CHECK_NULL_ARG4(cm_ctx, conn, conn->cm_data, session_p);
 
     SR_LOG_DBG("Starting a new session, options=%"PRIu32".", session_options);
 
@@ -620,6 +887,14 @@ cm_session_start_internal(cm_ctx_t *cm_ctx, sm_connection_t *conn, const char *e
         }
     }
 
+    /* messages of the session will be processed by the reactor owning the connection */
+    if (SR_ERR_OK == rc) {
+        rc = cm_session_route_add(cm_ctx, session->id, conn->cm_data->reactor);
+        if (SR_ERR_OK == rc) {
+            session->cm_data->reactor = conn->cm_data->reactor;
+        }
+    }
+
     /* start session in Request Processor */
     if (SR_ERR_OK == rc) {
         rc = rp_session_start(cm_ctx->rp_ctx,  session->id, &session->credentials,  datastore,
@@ -677,6 +952,7 @@ cm_session_start_req_process(cm_ctx_t *cm_ctx, sm_connection_t *conn, Sr__Msg *m
         /* set the error code to response */
         msg->response->result = rc;
     }
+    cm_msg_set_request_id(msg, msg_in->request_id);
 
     /* send the response */
     rc = cm_msg_send_connection(cm_ctx, conn, msg);
@@ -747,6 +1023,7 @@ cm_session_stop_req_process(cm_ctx_t *cm_ctx, sm_session_t *session, Sr__Msg *ms
         msg_out->response->result = rc;
         drop_session = false;
     }
+    cm_msg_set_request_id(msg_out, msg_in->request_id);
 
     /* send the response */
     rc = cm_msg_send_connection(cm_ctx, session->connection, msg_out);
@@ -792,6 +1069,7 @@ cm_session_check_req_process(cm_ctx_t *cm_ctx, sm_session_t *session, Sr__Msg *m
     }
 
     msg->session_id = session->id;
+    cm_msg_set_request_id(msg, msg_in->request_id);
 
     /* send the response */
     rc = cm_msg_send_connection(cm_ctx, session->connection, msg);
@@ -840,8 +1118,28 @@ cm_verify_version_req_process(cm_ctx_t *cm_ctx, sm_connection_t *conn, Sr__Msg *
         msg->response->result = rc;
         sr_mem_edit_string(sr_mem, &msg->response->version_verify_resp->soname, SR_COMPAT_VERSION);
         CHECK_NULL_NOMEM_GOTO(msg->response->version_verify_resp->soname, rc, cleanup);
+    } else if (msg_in->request->version_verify_req->shm_offered && -1 != conn->cm_data->shm_fd) {
+        if (CM_MODE_DAEMON == cm_ctx->mode && sr_shm_transport_enabled()) {
+            /* accept the shared-memory transport, the response itself still goes through the socket */
+            r = sr_shm_transport_attach(conn->cm_data->shm_fd, &conn->cm_data->shm);
+            conn->cm_data->shm_fd = -1;
+            if (SR_ERR_OK == r) {
+                SR_LOG_DBG("Connection fd=%d switched to the shared-memory transport.", conn->fd);
+                msg->response->version_verify_resp->has_shm_accepted = true;
+                msg->response->version_verify_resp->shm_accepted = true;
+            } else {
+                SR_LOG_WRN("Shared-memory transport offered on fd=%d declined.", conn->fd);
+            }
+        } else {
+            /* disabled in the environment of the Engine, the connection keeps using the socket */
+            SR_LOG_DBG("Shared-memory transport offered on fd=%d declined.", conn->fd);
+            close(conn->cm_data->shm_fd);
+            conn->cm_data->shm_fd = -1;
+        }
     }
 
+    cm_msg_set_request_id(msg, msg_in->request_id);
+
     /* send the response */
     r = cm_msg_send_connection(cm_ctx, conn, msg);
     if (SR_ERR_OK != r) {
@@ -911,6 +1209,7 @@ cm_req_process(cm_ctx_t *cm_ctx, sm_connection_t *conn, sm_session_t *session, S
             } else {
                 /* no outstanding requests in RP, we can forward the message to request Processor */
                 session->cm_data->rp_req_cnt += 1;
+                session->cm_data->rp_req_id = msg->request_id;
                 rc = rp_msg_process(cm_ctx->rp_ctx, session->cm_data->rp_session, msg);
                 if (SR_ERR_OK != rc) {
                     session->cm_data->rp_req_cnt -= 1;
@@ -996,35 +1295,14 @@ cleanup:
 }
 
 /**
- * @brief Processes a message received on connection.
+ * @brief Dispatches an unpacked message received on connection. Called with sm_lock held.
  */
 static int
-cm_conn_msg_process(cm_ctx_t *cm_ctx, sm_connection_t *conn, uint8_t *msg_data, size_t msg_size)
+cm_conn_msg_dispatch(cm_ctx_t *cm_ctx, sm_connection_t *conn, Sr__Msg *msg)
 {
-    Sr__Msg *msg = NULL;
     sm_session_t *session = NULL;
-    sr_mem_ctx_t *sr_mem = NULL;
     int rc = SR_ERR_OK;
 
-    CHECK_NULL_ARG3(cm_ctx, conn, msg_data);
-
-    /* unpack the message */
-    rc = sr_mem_new(msg_size, &sr_mem);
-    CHECK_RC_MSG_RETURN(rc, "Failed to instantiate a Sysrepo memory context.");
-    ProtobufCAllocator allocator = sr_get_protobuf_allocator(sr_mem);
-    msg = sr__msg__unpack(&allocator, msg_size, msg_data);
-    if (NULL == msg) {
-        SR_LOG_ERR("Unable to unpack the message (conn=%p).", (void*)conn);
-        rc = SR_ERR_INTERNAL;
-        goto cleanup;
-    }
-    if (NULL != sr_mem) {
-        msg->_sysrepo_mem_ctx = (uint64_t)sr_mem;
-        ++sr_mem->obj_count;
-    } else {
-        msg->_sysrepo_mem_ctx = (uint64_t) NULL;
-    }
-
     /* NULL check according to message type */
     if (((SR__MSG__MSG_TYPE__REQUEST == msg->type) && (NULL == msg->request)) ||
             ((SR__MSG__MSG_TYPE__RESPONSE == msg->type) && (NULL == msg->response))) {
@@ -1092,11 +1370,44 @@ cm_conn_msg_process(cm_ctx_t *cm_ctx, sm_connection_t *conn, uint8_t *msg_data,
     return rc;
 
 cleanup:
-    if (msg) {
-        sr_msg_free(msg);
-    } else {
+    sr_msg_free(msg);
+    return rc;
+}
+
+/**
+ * @brief Processes a message received on connection.
+ */
+static int
+cm_conn_msg_process(cm_ctx_t *cm_ctx, sm_connection_t *conn, uint8_t *msg_data, size_t msg_size)
+{
+    Sr__Msg *msg = NULL;
+    sr_mem_ctx_t *sr_mem = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(cm_ctx, conn, msg_data);
+
+    /* unpack the message */
+    rc = sr_mem_new(msg_size, &sr_mem);
+    CHECK_RC_MSG_RETURN(rc, "Failed to instantiate a Sysrepo memory context.");
+    ProtobufCAllocator allocator = sr_get_protobuf_allocator(sr_mem);
+    msg = sr__msg__unpack(&allocator, msg_size, msg_data);
+    if (NULL == msg) {
+        SR_LOG_ERR("Unable to unpack the message (conn=%p).", (void*)conn);
         sr_mem_free(sr_mem);
+        return SR_ERR_INTERNAL;
+    }
+    if (NULL != sr_mem) {
+        msg->_sysrepo_mem_ctx = (uint64_t)sr_mem;
+        ++sr_mem->obj_count;
+    } else {
+        msg->_sysrepo_mem_ctx = (uint64_t) NULL;
     }
+
+    /* unpacking is done without the lock, sessions are shared with other reactors */
+    pthread_mutex_lock(&cm_ctx->sm_lock);
+    rc = cm_conn_msg_dispatch(cm_ctx, conn, msg);
+    pthread_mutex_unlock(&cm_ctx->sm_lock);
+
     return rc;
 }
 
@@ -1157,26 +1468,62 @@ cm_conn_in_buff_process(cm_ctx_t *cm_ctx, sm_connection_t *conn)
 }
 
 /**
- * @brief Callback called by the event loop watcher when the file descriptor of
- * a connection is readable (some data has arrived).
+ * @brief Receives data from the socket of a connection. Before the version verification,
+ * keeps the shared memory segment that the client may attach to the request.
  */
-static void
-cm_conn_read_cb(struct ev_loop *loop, ev_io *w, int revents)
+static ssize_t
+cm_conn_socket_recv(sm_connection_t *conn, uint8_t *data, size_t len)
 {
-    sm_connection_t *conn = NULL;
-    cm_ctx_t *cm_ctx = NULL;
-    cm_buffer_t *buff = NULL;
-    int bytes = 0;
-    int rc = SR_ERR_OK;
+    struct msghdr msgh = { 0, };
+    struct iovec iov = { 0, };
+    struct cmsghdr *cmsg = NULL;
+    union {
+        struct cmsghdr align;
+        char buf[CMSG_SPACE(sizeof(int))];
+    } ctrl;
+    ssize_t bytes = 0;
+    int fd = -1;
 
-    CHECK_NULL_ARG_VOID2(w, w->data);
-    conn = (sm_connection_t*)w->data;
+    if (conn->established) {
+        return recv(conn->fd, data, len, 0);
+    }
 
-    CHECK_NULL_ARG_VOID3(conn, conn->cm_data, conn->cm_data->cm_ctx);
-    cm_ctx = conn->cm_data->cm_ctx;
-    buff = &conn->cm_data->in_buff;
+    iov.iov_base = data;
+    iov.iov_len = len;
+    msgh.msg_iov = &iov;
+    msgh.msg_iovlen = 1;
+    msgh.msg_control = ctrl.buf;
+    msgh.msg_controllen = sizeof(ctrl.buf);
 
-    SR_LOG_DBG("fd %d readable (revents %d)", conn->fd, revents);
+    bytes = recvmsg(conn->fd, &msgh, MSG_CMSG_CLOEXEC);
+    if (bytes > 0) {
+        for (cmsg = CMSG_FIRSTHDR(&msgh); NULL != cmsg; cmsg = CMSG_NXTHDR(&msgh, cmsg)) {
+            if (SOL_SOCKET != cmsg->cmsg_level || SCM_RIGHTS != cmsg->cmsg_type) {
+                continue;
+            }
+            for (size_t i = 0; i < (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int); i++) {
+                memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+                if (-1 == conn->cm_data->shm_fd) {
+                    conn->cm_data->shm_fd = fd;
+                } else {
+                    close(fd);
+                }
+            }
+        }
+    }
+
+    return bytes;
+}
+
+/**
+ * @brief Receives all available data from the socket of a connection into its input buffer.
+ */
+static int
+cm_conn_recv(sm_connection_t *conn)
+{
+    cm_buffer_t *buff = &conn->cm_data->in_buff;
+    ssize_t bytes = 0;
+    int rc = SR_ERR_OK;
 
     do {
         /* expand input buffer if needed */
@@ -1186,10 +1533,10 @@ cm_conn_read_cb(struct ev_loop *loop, ev_io *w, int revents)
             break;
         }
         /* receive data */
-        bytes = recv(conn->fd, (buff->data + buff->pos), (buff->size - buff->pos), 0);
+        bytes = cm_conn_socket_recv(conn, (buff->data + buff->pos), (buff->size - buff->pos));
         if (bytes > 0) {
             /* Received "bytes" bytes of data */
-            SR_LOG_DBG("%d bytes of data received on fd %d", bytes, conn->fd);
+            SR_LOG_DBG("%zd bytes of data received on fd %d", bytes, conn->fd);
             buff->pos += bytes;
         } else if (0 == bytes) {
             /* connection closed by the other side */
@@ -1210,19 +1557,112 @@ cm_conn_read_cb(struct ev_loop *loop, ev_io *w, int revents)
         }
     } while (bytes > 0); /* recv returns -1 when there is no more data to be read */
 
-    /* process the content of input buffer */
-    if (SR_ERR_OK == rc) {
-        rc = cm_conn_in_buff_process(cm_ctx, conn);
-        if (SR_ERR_OK != rc) {
-            SR_LOG_WRN("Error by processing of the input buffer of fd=%d, closing the connection.", conn->fd);
-            conn->close_requested = true;
-            rc = SR_ERR_OK; /* connection will be closed, we can continue */
-        }
+    return rc;
+}
+
+/**
+ * @brief Consumes the wake-ups from the socket of a connection using the shared-memory transport
+ * and moves all available data from its ring into the input buffer.
+ */
+static int
+cm_conn_shm_recv(sm_connection_t *conn)
+{
+    cm_buffer_t *buff = &conn->cm_data->in_buff;
+    sr_shm_ring_t *ring = &conn->cm_data->shm->rx;
+    uint8_t wakeups[CM_SHM_WAKEUP_BUFF_SIZE];
+    ssize_t bytes = 0;
+    size_t len = 0;
+    bool wakeup = false;
+    int rc = SR_ERR_OK;
+
+    /* the socket carries only the wake-ups (and detects disconnection) */
+    do {
+        bytes = recv(conn->fd, wakeups, sizeof(wakeups), 0);
+    } while (bytes > 0);
+    if (0 == bytes) {
+        SR_LOG_DBG("Peer on fd %d disconnected.", conn->fd);
+        conn->close_requested = true;
+        return SR_ERR_OK;
+    }
+    if ((EWOULDBLOCK != errno) && (EAGAIN != errno)) {
+        SR_LOG_ERR("Error by reading data on fd %d: %s.", conn->fd, sr_strerror_safe(errno));
+        conn->close_requested = true;
+        return SR_ERR_OK;
+    }
+
+    /* read until the ring is seen empty, the client sends a wake-up for anything written later */
+    do {
+        rc = cm_conn_buffer_expand(conn, buff, MAX(CM_IN_BUFF_MIN_SPACE, sr_shm_ring_readable(ring)));
+        if (SR_ERR_OK == rc) {
+            rc = sr_shm_ring_read(ring, (buff->data + buff->pos), (buff->size - buff->pos), &len, &wakeup);
+        }
+        if (SR_ERR_OK != rc) {
+            conn->close_requested = true;
+            return rc;
+        }
+        if (wakeup) {
+            /* the client waits for space in the ring */
+            sr_shm_ring_wake_producer(ring);
+        }
+        buff->pos += len;
+    } while (len > 0);
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Callback called by the event loop watcher when the file descriptor of
+ * a connection is readable (some data has arrived).
+ */
+static void
+cm_conn_read_cb(struct ev_loop *loop, ev_io *w, int revents)
+{
+    sm_connection_t *conn = NULL;
+    cm_ctx_t *cm_ctx = NULL;
+    cm_buffer_t *out_buff = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG_VOID2(w, w->data);
+    conn = (sm_connection_t*)w->data;
+
+    CHECK_NULL_ARG_VOID3(conn, conn->cm_data, conn->cm_data->cm_ctx);
+    cm_ctx = conn->cm_data->cm_ctx;
+    out_buff = &conn->cm_data->out_buff;
+
+    SR_LOG_DBG("fd %d readable (revents %d)", conn->fd, revents);
+
+    if (NULL != conn->cm_data->shm) {
+        rc = cm_conn_shm_recv(conn);
+        if (SR_ERR_OK == rc && !conn->close_requested && conn->cm_data->shm_tx && out_buff->pos > out_buff->start) {
+            /* the wake-up may also mean that the client has freed some space in its ring */
+            rc = cm_conn_out_buff_flush(cm_ctx, conn);
+            if (SR_ERR_OK == rc && !conn->close_requested && NULL != conn->cm_data->drain_waiters &&
+                    (out_buff->pos - out_buff->start) <= CM_OUT_BUFF_LOW_WATERMARK) {
+                /* resume the senders paused until the output buffer drains */
+                pthread_mutex_lock(&cm_ctx->sm_lock);
+                cm_conn_drain_waiters_release(cm_ctx, conn);
+                pthread_mutex_unlock(&cm_ctx->sm_lock);
+            }
+        }
+    } else {
+        rc = cm_conn_recv(conn);
+    }
+
+    /* process the content of input buffer */
+    if (SR_ERR_OK == rc) {
+        rc = cm_conn_in_buff_process(cm_ctx, conn);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_WRN("Error by processing of the input buffer of fd=%d, closing the connection.", conn->fd);
+            conn->close_requested = true;
+            rc = SR_ERR_OK; /* connection will be closed, we can continue */
+        }
     }
 
     /* close the connection if requested */
     if ((conn->close_requested) || (SR_ERR_OK != rc)) {
+        pthread_mutex_lock(&cm_ctx->sm_lock);
         cm_conn_close(cm_ctx, conn);
+        pthread_mutex_unlock(&cm_ctx->sm_lock);
     }
 }
 
@@ -1245,24 +1685,38 @@ cm_conn_write_cb(struct ev_loop *loop, ev_io *w, int revents)
 
     SR_LOG_DBG("fd %d writeable (revents %d)", conn->fd, revents);
 
-    ev_io_stop(cm_ctx->event_loop, &conn->cm_data->write_watcher);
+    ev_io_stop(loop, &conn->cm_data->write_watcher);
 
     /* flush the output buffer */
     rc = cm_conn_out_buff_flush(cm_ctx, conn);
 
-    /* close the connection if requested */
-    if ((conn->close_requested) || (SR_ERR_OK != rc)) {
-        cm_conn_close(cm_ctx, conn);
+    if ((SR_ERR_OK == rc && !conn->close_requested && NULL != conn->cm_data->drain_waiters) ||
+            (conn->close_requested) || (SR_ERR_OK != rc)) {
+        pthread_mutex_lock(&cm_ctx->sm_lock);
+
+        /* resume the senders paused until the output buffer drains */
+        if (SR_ERR_OK == rc && !conn->close_requested &&
+                (conn->cm_data->out_buff.pos - conn->cm_data->out_buff.start) <= CM_OUT_BUFF_LOW_WATERMARK) {
+            cm_conn_drain_waiters_release(cm_ctx, conn);
+        }
+
+        /* close the connection if requested */
+        if ((conn->close_requested) || (SR_ERR_OK != rc)) {
+            cm_conn_close(cm_ctx, conn);
+        }
+
+        pthread_mutex_unlock(&cm_ctx->sm_lock);
     }
 }
 
 /**
- * @brief Initializes read and write watchers for the file descriptor of provided connection.
+ * @brief Initializes read and write watchers for the file descriptor of provided connection and assigns
+ * the connection to the reactor. The read watcher needs to be started in the event loop of the reactor.
  */
 static int
-cm_conn_watcher_init(cm_ctx_t *cm_ctx, sm_connection_t *conn)
+cm_conn_watcher_init(cm_ctx_t *cm_ctx, cm_reactor_t *reactor, sm_connection_t *conn)
 {
-    CHECK_NULL_ARG2(cm_ctx, conn);
+    CHECK_NULL_ARG3(cm_ctx, reactor, conn);
 
     conn->cm_data = calloc(1, sizeof(*(conn->cm_data)));
     if (NULL == conn->cm_data) {
@@ -1271,10 +1725,12 @@ cm_conn_watcher_init(cm_ctx_t *cm_ctx, sm_connection_t *conn)
     }
 
     conn->cm_data->cm_ctx = cm_ctx;
+    conn->cm_data->reactor = reactor;
+    conn->cm_data->shm_fd = -1;
+    reactor->conn_cnt += 1;
 
     ev_io_init(&conn->cm_data->read_watcher, cm_conn_read_cb, conn->fd, EV_READ);
     conn->cm_data->read_watcher.data = (void*)conn;
-    ev_io_start(cm_ctx->event_loop, &conn->cm_data->read_watcher);
 
     ev_io_init(&conn->cm_data->write_watcher, cm_conn_write_cb, conn->fd, EV_WRITE);
     conn->cm_data->write_watcher.data = (void*)conn;
@@ -1283,6 +1739,57 @@ cm_conn_watcher_init(cm_ctx_t *cm_ctx, sm_connection_t *conn)
     return SR_ERR_OK;
 }
 
+/**
+ * @brief Selects the reactor for a newly accepted connection - the one owning the fewest connections,
+ * round-robin among equally loaded ones. Called with sm_lock held.
+ */
+static cm_reactor_t *
+cm_reactor_select(cm_ctx_t *cm_ctx)
+{
+    cm_reactor_t *reactor = NULL, *candidate = NULL;
+
+    for (size_t i = 0; i < cm_ctx->reactor_count; i++) {
+        candidate = &cm_ctx->reactors[(cm_ctx->next_reactor + i) % cm_ctx->reactor_count];
+        if (NULL == reactor || candidate->conn_cnt < reactor->conn_cnt) {
+            reactor = candidate;
+        }
+    }
+    cm_ctx->next_reactor = (cm_ctx->next_reactor + 1) % cm_ctx->reactor_count;
+
+    return reactor;
+}
+
+/**
+ * @brief Hands over an accepted connection to its reactor, which starts watching its file descriptor.
+ * Called from reactor 0 with sm_lock held.
+ */
+static int
+cm_conn_handover(cm_ctx_t *cm_ctx, sm_connection_t *conn)
+{
+    cm_reactor_t *reactor = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(cm_ctx, conn, conn->cm_data);
+
+    reactor = conn->cm_data->reactor;
+
+    if (reactor == &cm_ctx->reactors[0]) {
+        /* owned by the accepting reactor, start watching immediately */
+        ev_io_start(reactor->event_loop, &conn->cm_data->read_watcher);
+        return SR_ERR_OK;
+    }
+
+    pthread_mutex_lock(&reactor->msg_queue_mutex);
+    rc = sr_cbuff_enqueue(reactor->conn_queue, &conn);
+    pthread_mutex_unlock(&reactor->msg_queue_mutex);
+
+    if (SR_ERR_OK == rc) {
+        ev_async_send(reactor->event_loop, &reactor->msg_queue_watcher);
+    }
+
+    return rc;
+}
+
 /**
  * @brief Callback called by the event loop watcher when a new connection is detected
  * on the server socket. Accepts new connections to the server and starts
@@ -1311,9 +1818,11 @@ cm_server_watcher_cb(struct ev_loop *loop, ev_io *w, int revents)
                 close(clnt_fd);
                 continue;
             }
+            pthread_mutex_lock(&cm_ctx->sm_lock);
             /* start connection in session manager */
             rc = sm_connection_start(cm_ctx->sm_ctx, CM_AF_UNIX_CLIENT, clnt_fd, &connection);
             if (SR_ERR_OK != rc) {
+                pthread_mutex_unlock(&cm_ctx->sm_lock);
                 SR_LOG_ERR("Cannot start connection in Session manager (fd=%d).", clnt_fd);
                 close(clnt_fd);
                 continue;
@@ -1324,17 +1833,27 @@ cm_server_watcher_cb(struct ev_loop *loop, ev_io *w, int revents)
                     SR_LOG_ERR("Peer's uid=%d does not match with local uid=%d "
                             "(required by local mode).", connection->uid, geteuid());
                     sm_connection_stop(cm_ctx->sm_ctx, connection);
+                    pthread_mutex_unlock(&cm_ctx->sm_lock);
                     close(clnt_fd);
                     continue;
                 }
             }
-            /* start watching this fd */
-            rc = cm_conn_watcher_init(cm_ctx, connection);
+            /* assign the connection to a reactor and start watching this fd */
+            rc = cm_conn_watcher_init(cm_ctx, cm_reactor_select(cm_ctx), connection);
+            if (SR_ERR_OK == rc) {
+                rc = cm_conn_handover(cm_ctx, connection);
+            }
             if (SR_ERR_OK != rc) {
                 SR_LOG_ERR("Cannot initialize watcher for fd=%d.", clnt_fd);
+                if (NULL != connection->cm_data) {
+                    connection->cm_data->reactor->conn_cnt -= 1;
+                }
+                sm_connection_stop(cm_ctx->sm_ctx, connection);
+                pthread_mutex_unlock(&cm_ctx->sm_lock);
                 close(clnt_fd);
                 continue;
             }
+            pthread_mutex_unlock(&cm_ctx->sm_lock);
         } else {
             if ((EWOULDBLOCK == errno) || (EAGAIN == errno)) {
                 /* no more connections to accept */
@@ -1348,10 +1867,10 @@ cm_server_watcher_cb(struct ev_loop *loop, ev_io *w, int revents)
 }
 
 /**
- * @brief Creates a new connection to the subscriber destination address.
+ * @brief Creates a new connection to the subscriber destination address, owned by the provided reactor.
  */
 static int
-cm_subscr_conn_create(cm_ctx_t *cm_ctx, const char *socket_path, sm_connection_t **connection_p)
+cm_subscr_conn_create(cm_ctx_t *cm_ctx, cm_reactor_t *reactor, const char *socket_path, sm_connection_t **connection_p)
 {
     int fd = -1;
     struct sockaddr_un addr = { 0, };
@@ -1390,12 +1909,13 @@ cm_subscr_conn_create(cm_ctx_t *cm_ctx, const char *socket_path, sm_connection_t
     }
 
     /* initialize connection watchers */
-    rc = cm_conn_watcher_init(cm_ctx, connection);
+    rc = cm_conn_watcher_init(cm_ctx, reactor, connection);
     if (SR_ERR_OK != rc) {
         SR_LOG_ERR("Cannot initialize watcher for fd=%d.", fd);
         rc = SR_ERR_INTERNAL;
         goto cleanup;
     }
+    ev_io_start(reactor->event_loop, &connection->cm_data->read_watcher);
 
     /* connect to server */
     addr.sun_family = AF_UNIX;
@@ -1439,7 +1959,7 @@ cleanup:
  * @brief Processes an outgoing notification (notification to be sent to the client library).
  */
 static int
-cm_out_notif_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
+cm_out_notif_process(cm_ctx_t *cm_ctx, cm_reactor_t *reactor, Sr__Msg *msg)
 {
     sm_connection_t *connection = NULL;
     int rc = SR_ERR_OK;
@@ -1462,7 +1982,7 @@ cm_out_notif_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
     } else {
         /* connection to that destination does not exist - connect */
         SR_LOG_DBG("Creating a new connection for the notification destination '%s'", msg->notification->destination_address);
-        rc = cm_subscr_conn_create(cm_ctx, msg->notification->destination_address, &connection);
+        rc = cm_subscr_conn_create(cm_ctx, reactor, msg->notification->destination_address, &connection);
     }
 
     /* send the message */
@@ -1472,7 +1992,7 @@ cm_out_notif_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
 
     if (SR_ERR_OK != rc && SR_ERR_DISCONNECT != rc) {
         /* by error, remove subscriptions on this destination */
-        cm_subscr_unsubscribe_destination(cm_ctx, msg->notification->destination_address, 0);
+        cm_subscr_unsubscribe_destination(cm_ctx, reactor, msg->notification->destination_address, 0);
     }
 
     sr_msg_free(msg);
@@ -1484,7 +2004,7 @@ cm_out_notif_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
  * @brief Processes an outgoing data-provide request (to be sent to the client library).
  */
 static int
-cm_out_dp_request_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
+cm_out_dp_request_process(cm_ctx_t *cm_ctx, cm_reactor_t *reactor, Sr__Msg *msg)
 {
     sm_session_t *session = NULL;
     sm_connection_t *connection = NULL;
@@ -1522,7 +2042,7 @@ cm_out_dp_request_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
     } else {
         /* connection to that destination does not exist - connect */
         SR_LOG_DBG("Creating a new connection for the data-provide request destination '%s'", destination_address);
-        rc = cm_subscr_conn_create(cm_ctx, destination_address, &connection);
+        rc = cm_subscr_conn_create(cm_ctx, reactor, destination_address, &connection);
     }
 
     /* send the message */
@@ -1532,7 +2052,7 @@ cm_out_dp_request_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
 
     if (SR_ERR_OK != rc && SR_ERR_DISCONNECT != rc) {
         /* by error, remove subscriptions on this destination */
-        cm_subscr_unsubscribe_destination(cm_ctx, msg->request->data_provide_req->subscriber_address, 0);
+        cm_subscr_unsubscribe_destination(cm_ctx, reactor, msg->request->data_provide_req->subscriber_address, 0);
     }
 
     sr_msg_free(msg);
@@ -1544,7 +2064,7 @@ cm_out_dp_request_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
  * @brief Processes an outgoing RPC/Action (RPC/Action to be sent to the client library).
  */
 static int
-cm_out_rpc_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
+cm_out_rpc_process(cm_ctx_t *cm_ctx, cm_reactor_t *reactor, Sr__Msg *msg)
 {
     sm_session_t *session = NULL;
     sm_connection_t *connection = NULL;
@@ -1584,7 +2104,7 @@ cm_out_rpc_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
     } else {
         /* connection to that destination does not exist - connect */
         SR_LOG_DBG("Creating a new connection for the %s destination '%s'", op_name, destination_address);
-        rc = cm_subscr_conn_create(cm_ctx, destination_address, &connection);
+        rc = cm_subscr_conn_create(cm_ctx, reactor, destination_address, &connection);
     }
 
     /* send the message */
@@ -1594,7 +2114,7 @@ cm_out_rpc_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
 
     if (SR_ERR_OK != rc && SR_ERR_DISCONNECT != rc) {
         /* by error, remove subscriptions on this destination */
-        cm_subscr_unsubscribe_destination(cm_ctx, destination_address, 0);
+        cm_subscr_unsubscribe_destination(cm_ctx, reactor, destination_address, 0);
     }
 
     sr_msg_free(msg);
@@ -1606,7 +2126,7 @@ cm_out_rpc_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
  * @brief Processes an outgoing event notification (notification to be sent to the client library).
  */
 static int
-cm_out_event_notif_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
+cm_out_event_notif_process(cm_ctx_t *cm_ctx, cm_reactor_t *reactor, Sr__Msg *msg)
 {
     sm_session_t *session = NULL;
     sm_connection_t *connection = NULL;
@@ -1646,7 +2166,7 @@ cm_out_event_notif_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
     } else {
         /* connection to that destination does not exist - connect */
         SR_LOG_DBG("Creating a new connection for the event notification destination '%s'", destination_address);
-        rc = cm_subscr_conn_create(cm_ctx, destination_address, &connection);
+        rc = cm_subscr_conn_create(cm_ctx, reactor, destination_address, &connection);
     }
 
     /* send the message */
@@ -1656,7 +2176,7 @@ cm_out_event_notif_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
 
     if (SR_ERR_OK != rc && SR_ERR_DISCONNECT != rc) {
         /* by error, remove subscriptions on this destination */
-        cm_subscr_unsubscribe_destination(cm_ctx, destination_address, 0);
+        cm_subscr_unsubscribe_destination(cm_ctx, reactor, destination_address, 0);
     }
 
     sr_msg_free(msg);
@@ -1664,18 +2184,67 @@ cm_out_event_notif_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
     return rc;
 }
 
+/**
+ * @brief Processes a request to continue with replay of event notifications. If the output buffer of the
+ * subscriber connection is filled over the high watermark, the request is held back until it drains.
+ */
+static int
+cm_event_notif_replay_continue_process(cm_ctx_t *cm_ctx, sm_session_t *session, Sr__Msg *msg)
+{
+    sm_connection_t *connection = NULL;
+    cm_buffer_t *buff = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG_NORET4(rc, cm_ctx, session, session->cm_data, msg->internal_request->event_notif_replay_continue_req);
+    if (SR_ERR_OK != rc) {
+        sr_msg_free(msg);
+        return rc;
+    }
+
+    rc = sm_connection_find_dst(cm_ctx->sm_ctx, msg->internal_request->event_notif_replay_continue_req->subscriber_address,
+            &connection);
+    if (SR_ERR_OK == rc && NULL != connection->cm_data) {
+        buff = &connection->cm_data->out_buff;
+        if ((buff->pos - buff->start) > CM_OUT_BUFF_HIGH_WATERMARK) {
+            SR_LOG_DBG("Output buffer for fd=%d holds %zu bytes, pausing notification replay until it drains.",
+                    connection->fd, (buff->pos - buff->start));
+            if (NULL == connection->cm_data->drain_waiters) {
+                rc = sr_list_init(&connection->cm_data->drain_waiters);
+            }
+            if (SR_ERR_OK == rc) {
+                rc = sr_list_add(connection->cm_data->drain_waiters, msg);
+            }
+            if (SR_ERR_OK == rc) {
+                __atomic_add_fetch(&cm_ctx->replay_pause_cnt, 1, __ATOMIC_RELAXED);
+                return SR_ERR_OK;
+            }
+            SR_LOG_WRN_MSG("Unable to pause notification replay, continuing immediately.");
+        }
+    }
+
+    /* continue immediately */
+    rc = rp_msg_process(cm_ctx->rp_ctx, session->cm_data->rp_session, msg);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_WRN_MSG("Unable to send internal request to the Request Processor.");
+    }
+
+    return rc;
+}
+
 /**
  * @brief Processes an internal request received from Request Processor.
  */
 static int
-cm_internal_msg_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
+cm_internal_msg_process(cm_ctx_t *cm_ctx, cm_reactor_t *reactor, Sr__Msg *msg)
 {
     sm_session_t *session = NULL;
     int rc = SR_ERR_OK;
 
     CHECK_NULL_ARG3(cm_ctx, msg, msg->internal_request);
 
-    if (SR__OPERATION__OPER_DATA_TIMEOUT == msg->internal_request->operation) {
+    if (SR__OPERATION__OPER_DATA_TIMEOUT == msg->internal_request->operation ||
+            SR__OPERATION__GET_ITEMS_CURSOR_TIMEOUT == msg->internal_request->operation ||
+            SR__OPERATION__EVENT_NOTIF_REPLAY_CONTINUE == msg->internal_request->operation) {
         /* find the session */
         rc = sm_session_find_id(cm_ctx->sm_ctx, msg->session_id, &session);
         if (SR_ERR_OK != rc) {
@@ -1686,9 +2255,12 @@ cm_internal_msg_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
         }
     }
 
-    if (msg->internal_request->has_postpone_timeout) {
+    if (SR__OPERATION__EVENT_NOTIF_REPLAY_CONTINUE == msg->internal_request->operation) {
+        /* continue with the replay once the subscriber is ready to receive more notifications */
+        rc = cm_event_notif_replay_continue_process(cm_ctx, session, msg);
+    } else if (msg->internal_request->has_postpone_timeout) {
         /* schedule delivery of message with postpone timeout */
-        rc = cm_delayed_msg_process(cm_ctx, (NULL != session ? session->cm_data : NULL),
+        rc = cm_delayed_msg_process(cm_ctx, reactor, (NULL != session ? session->cm_data : NULL),
                 msg, msg->internal_request->postpone_timeout);
     } else {
         /* deliver the message immediately */
@@ -1705,18 +2277,21 @@ cm_internal_msg_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
 
 /**
  * @brief Processes an outgoing message (message to be sent to the client library).
+ * Called with sm_lock held, the lock is released while the message is being sent.
  */
 static int
-cm_out_msg_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
+cm_out_msg_process(cm_ctx_t *cm_ctx, cm_reactor_t *reactor, Sr__Msg *msg)
 {
     sm_session_t *session = NULL;
+    sm_connection_t *connection = NULL;
+    bool close_conn = false;
     int rc = SR_ERR_OK;
 
     CHECK_NULL_ARG2(cm_ctx, msg);
 
     if (SR__MSG__MSG_TYPE__INTERNAL_REQUEST == msg->type) {
         /* handle as an internal request from RP */
-        return cm_internal_msg_process(cm_ctx, msg);
+        return cm_internal_msg_process(cm_ctx, reactor, msg);
     }
 
     /* find the session */
@@ -1738,6 +2313,9 @@ cm_out_msg_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
     if (SR__MSG__MSG_TYPE__RESPONSE == msg->type) {
         if (session->cm_data->rp_req_cnt > 0) {
             session->cm_data->rp_req_cnt -= 1;
+            /* requests of a session are processed in RP one by one - the response belongs to the outstanding one */
+            cm_msg_set_request_id(msg, session->cm_data->rp_req_id);
+            session->cm_data->rp_req_id = 0;
         }
     } else if (SR__MSG__MSG_TYPE__REQUEST == msg->type) {
         session->cm_data->rp_resp_expected += 1;
@@ -1746,7 +2324,23 @@ cm_out_msg_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
     /* send the message */
     if (!session->cm_data->stop_requested) {
         /* only if session_stop has not been requested */
-        rc = cm_msg_send_connection(cm_ctx, session->connection, msg);
+        connection = session->connection;
+        if (NULL != connection && NULL != connection->cm_data && reactor == connection->cm_data->reactor) {
+            /* the connection and its sessions are closed only by the owning reactor (this one),
+             * other reactors can continue while the message is being packed and sent */
+            pthread_mutex_unlock(&cm_ctx->sm_lock);
+            rc = cm_conn_msg_pack(connection, msg);
+            if (SR_ERR_OK == rc) {
+                rc = cm_conn_out_buff_flush(cm_ctx, connection);
+                close_conn = (connection->close_requested || SR_ERR_OK != rc);
+            }
+            pthread_mutex_lock(&cm_ctx->sm_lock);
+            if (close_conn) {
+                cm_conn_close(cm_ctx, connection);
+            }
+        } else {
+            rc = cm_msg_send_connection(cm_ctx, connection, msg);
+        }
         if (SR_ERR_OK != rc) {
             SR_LOG_ERR("Unable to send the message over session (id=%"PRIu32").", msg->session_id);
         }
@@ -1765,6 +2359,7 @@ cm_out_msg_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
             /* if there are some requests waiting for to be processed, process next one */
             if (sr_cbuff_dequeue(session->cm_data->rp_request_queue, &msg)) {
                 session->cm_data->rp_req_cnt += 1;
+                session->cm_data->rp_req_id = msg->request_id;
                 rc = rp_msg_process(cm_ctx->rp_ctx, session->cm_data->rp_session, msg);
                 if (SR_ERR_OK != rc) {
                     session->cm_data->rp_req_cnt -= 1;
@@ -1777,47 +2372,65 @@ cm_out_msg_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
 }
 
 /**
- * @brief Callback called by the event loop watcher when a message is enqueued into message queue.
+ * @brief Callback called by the event loop watcher when a message is enqueued into message queue
+ * of the reactor (or a connection is handed over to it).
  */
 static void
 cm_msg_enqueue_cb(struct ev_loop *loop, ev_async *w, int revents)
 {
+    cm_reactor_t *reactor = NULL;
     cm_ctx_t *cm_ctx = NULL;
+    sm_connection_t *conn = NULL;
     bool dequeued = false;
 
     CHECK_NULL_ARG_VOID2(w, w->data);
-    cm_ctx = (cm_ctx_t*)w->data;
+    reactor = (cm_reactor_t*)w->data;
+    cm_ctx = reactor->cm_ctx;
 
     SR_LOG_DBG_MSG("New message enqueued into CM message queue.");
 
+    /* start watching the connections handed over by the accepting reactor */
+    do {
+        pthread_mutex_lock(&reactor->msg_queue_mutex);
+        dequeued = sr_cbuff_dequeue(reactor->conn_queue, &conn);
+        pthread_mutex_unlock(&reactor->msg_queue_mutex);
+
+        if (dequeued) {
+            SR_LOG_DBG("Watching fd %d handed over to the reactor.", conn->fd);
+            ev_io_start(loop, &conn->cm_data->read_watcher);
+        }
+    } while (dequeued);
+
     do {
         Sr__Msg *msg = NULL;
 
-        pthread_mutex_lock(&cm_ctx->msg_queue_mutex);
-        dequeued = sr_cbuff_dequeue(cm_ctx->msg_queue, &msg);
-        pthread_mutex_unlock(&cm_ctx->msg_queue_mutex);
+        pthread_mutex_lock(&reactor->msg_queue_mutex);
+        dequeued = sr_cbuff_dequeue(reactor->msg_queue, &msg);
+        pthread_mutex_unlock(&reactor->msg_queue_mutex);
 
         if (dequeued) {
+            pthread_mutex_lock(&cm_ctx->sm_lock);
             if (SR__MSG__MSG_TYPE__NOTIFICATION == msg->type) {
                 /* send the notification via subscriber connection */
-                cm_out_notif_process(cm_ctx, msg);
+                cm_out_notif_process(cm_ctx, reactor, msg);
             } else if ((SR__MSG__MSG_TYPE__REQUEST == msg->type) &&
                     (SR__OPERATION__DATA_PROVIDE == msg->request->operation)) {
                 /* send the data-provide request via subscriber connection */
-                cm_out_dp_request_process(cm_ctx, msg);
+                cm_out_dp_request_process(cm_ctx, reactor, msg);
             } else if ((SR__MSG__MSG_TYPE__REQUEST == msg->type) &&
                             (SR__OPERATION__RPC == msg->request->operation ||
                              SR__OPERATION__ACTION == msg->request->operation)) {
                /* send the RPC request via subscriber connection */
-               cm_out_rpc_process(cm_ctx, msg);
+               cm_out_rpc_process(cm_ctx, reactor, msg);
             } else if ((SR__MSG__MSG_TYPE__REQUEST == msg->type) &&
                    (SR__OPERATION__EVENT_NOTIF == msg->request->operation)) {
                /* send the event notification via subscriber connection */
-               cm_out_event_notif_process(cm_ctx, msg);
+               cm_out_event_notif_process(cm_ctx, reactor, msg);
            } else {
                 /* process as a normal message */
-                cm_out_msg_process(cm_ctx, msg);
+                cm_out_msg_process(cm_ctx, reactor, msg);
             }
+            pthread_mutex_unlock(&cm_ctx->sm_lock);
         }
     } while (dequeued);
 }
@@ -1828,14 +2441,11 @@ cm_msg_enqueue_cb(struct ev_loop *loop, ev_async *w, int revents)
 static void
 cm_stop_cb(struct ev_loop *loop, ev_async *w, int revents)
 {
-    cm_ctx_t *cm_ctx = NULL;
-
     CHECK_NULL_ARG_VOID3(loop, w, w->data);
-    cm_ctx = (cm_ctx_t*)w->data;
 
     SR_LOG_DBG_MSG("Event loop stop requested.");
 
-    ev_break(cm_ctx->event_loop, EVBREAK_ALL);
+    ev_break(loop, EVBREAK_ALL);
 }
 
 /**
@@ -1860,43 +2470,199 @@ cm_signal_cb_internal(struct ev_loop *loop, struct ev_signal *w, int revents)
 }
 
 /**
- * @brief Event loop of Connection Manager. Monitors all connections for events
+ * @brief Event loop of a Connection Manager reactor. Monitors all connections of the reactor for events
  * and calls proper callback handlers for each event. This function call blocks
  * until stop is requested via async stop request.
  */
 static void
-cm_event_loop(cm_ctx_t *cm_ctx)
+cm_event_loop(cm_reactor_t *reactor)
 {
-    CHECK_NULL_ARG_VOID(cm_ctx);
+    CHECK_NULL_ARG_VOID(reactor);
 
-    SR_LOG_DBG_MSG("Starting CM event loop.");
+    SR_LOG_DBG("Starting CM event loop of reactor %zu.", (size_t)(reactor - reactor->cm_ctx->reactors));
 
-    ev_run(cm_ctx->event_loop, 0);
+    ev_run(reactor->event_loop, 0);
 
-    SR_LOG_DBG_MSG("CM event loop finished.");
+    SR_LOG_DBG("CM event loop of reactor %zu finished.", (size_t)(reactor - reactor->cm_ctx->reactors));
 }
 
 /**
- * @brief Starts the event loop in a new thread (applicable only for library mode).
+ * @brief Starts the event loop of a reactor in a new thread (applicable for library mode
+ * and for additional reactors).
  */
 static void *
-cm_event_loop_threaded(void *cm_ctx_p)
+cm_event_loop_threaded(void *reactor_p)
 {
-    if (NULL == cm_ctx_p) {
+    if (NULL == reactor_p) {
         return NULL;
     }
 
-    cm_ctx_t *cm_ctx = (cm_ctx_t*)cm_ctx_p;
+    cm_reactor_t *reactor = (cm_reactor_t*)reactor_p;
 
-    cm_event_loop(cm_ctx);
+    cm_event_loop(reactor);
 
     return NULL;
 }
 
+/**
+ * @brief Returns the number of reactors to be started: 1 in local mode, otherwise the value of the
+ * SR_CM_REACTORS_ENV environment variable, if set, otherwise SR_CM_REACTOR_COUNT,
+ * the number of online CPUs if that is 0.
+ */
+static size_t
+cm_get_reactor_count(cm_connection_mode_t mode)
+{
+    const char *env_str = NULL;
+    long count = SR_CM_REACTOR_COUNT;
+
+    if (CM_MODE_LOCAL == mode) {
+        /* local mode serves the connections of one process only */
+        return 1;
+    }
+
+    env_str = getenv(SR_CM_REACTORS_ENV);
+    if (NULL != env_str) {
+        count = strtol(env_str, NULL, 10);
+    }
+    if (count <= 0) {
+        count = sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (count <= 0) {
+        count = 1;
+    }
+
+    return (size_t)count;
+}
+
+/**
+ * @brief Initializes a reactor - its event loop, queues and watchers.
+ */
+static int
+cm_reactor_init(cm_ctx_t *cm_ctx, cm_reactor_t *reactor)
+{
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG2(cm_ctx, reactor);
+
+    reactor->cm_ctx = cm_ctx;
+
+    /* initialize message and connection queues */
+    pthread_mutex_init(&reactor->msg_queue_mutex, NULL);
+    rc = sr_cbuff_init(CM_INIT_MSG_QUEUE_SIZE, sizeof(Sr__Msg*), &reactor->msg_queue);
+    CHECK_RC_MSG_RETURN(rc, "CM message queue initialization failed.");
+    rc = sr_cbuff_init(CM_INIT_CONN_QUEUE_SIZE, sizeof(sm_connection_t*), &reactor->conn_queue);
+    CHECK_RC_MSG_RETURN(rc, "CM connection queue initialization failed.");
+
+    /* initialize event loop */
+    /* According to our measurements, EPOLL backend is significantly slower for
+     * fewer file descriptors, so we are disabling it for now. */
+    reactor->event_loop = ev_loop_new((EVBACKEND_ALL ^ EVBACKEND_EPOLL) | EVFLAG_NOENV);
+    if (NULL == reactor->event_loop) {
+        SR_LOG_ERR_MSG("Cannot create CM event loop.");
+        return SR_ERR_INIT_FAILED;
+    }
+
+    /* initialize event watcher for async stop requests */
+    ev_async_init(&reactor->stop_watcher, cm_stop_cb);
+    reactor->stop_watcher.data = (void*)reactor;
+    ev_async_start(reactor->event_loop, &reactor->stop_watcher);
+
+    /* initialize event watcher for message enqueue events */
+    ev_async_init(&reactor->msg_queue_watcher, cm_msg_enqueue_cb);
+    reactor->msg_queue_watcher.data = (void*)reactor;
+    ev_async_start(reactor->event_loop, &reactor->msg_queue_watcher);
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Cleans up a reactor, the messages and delayed requests that have not been processed are released.
+ */
+static void
+cm_reactor_cleanup(cm_reactor_t *reactor)
+{
+    Sr__Msg *msg = NULL;
+    cm_delayed_request_ctx_t *req = NULL, *tmp = NULL;
+
+    if (NULL == reactor || NULL == reactor->cm_ctx) {
+        return;
+    }
+
+    if (NULL != reactor->event_loop) {
+        ev_loop_destroy(reactor->event_loop);
+    }
+
+    while (sr_cbuff_dequeue(reactor->msg_queue, &msg)) {
+        sr_msg_free(msg);
+    }
+    sr_cbuff_cleanup(reactor->msg_queue);
+    /* the connections are released by Session Manager */
+    sr_cbuff_cleanup(reactor->conn_queue);
+    pthread_mutex_destroy(&reactor->msg_queue_mutex);
+
+    tmp = reactor->delayed_requests;
+    while (NULL != tmp) {
+        req = tmp;
+        tmp = tmp->next;
+        sr_msg_free(req->msg);
+        free(req);
+    }
+}
+
+/**
+ * @brief Returns the reactor that should process the message from Request Processor. Messages for subscribers
+ * are processed by the reactor owning the connections to their destination (which is chosen by the destination
+ * address), other messages by the reactor owning the connection of their session.
+ */
+static cm_reactor_t *
+cm_msg_reactor_get(cm_ctx_t *cm_ctx, Sr__Msg *msg)
+{
+    cm_session_route_t lookup = { 0, }, *route = NULL;
+    cm_reactor_t *reactor = &cm_ctx->reactors[0];
+    const char *destination_address = NULL;
+
+    if (1 == cm_ctx->reactor_count) {
+        return reactor;
+    }
+
+    if (SR__MSG__MSG_TYPE__NOTIFICATION == msg->type && NULL != msg->notification) {
+        destination_address = msg->notification->destination_address;
+    } else if (SR__MSG__MSG_TYPE__REQUEST == msg->type && NULL != msg->request) {
+        if (SR__OPERATION__DATA_PROVIDE == msg->request->operation && NULL != msg->request->data_provide_req) {
+            destination_address = msg->request->data_provide_req->subscriber_address;
+        } else if ((SR__OPERATION__RPC == msg->request->operation || SR__OPERATION__ACTION == msg->request->operation)
+                && NULL != msg->request->rpc_req) {
+            destination_address = msg->request->rpc_req->subscriber_address;
+        } else if (SR__OPERATION__EVENT_NOTIF == msg->request->operation && NULL != msg->request->event_notif_req) {
+            destination_address = msg->request->event_notif_req->subscriber_address;
+        }
+    } else if (SR__MSG__MSG_TYPE__INTERNAL_REQUEST == msg->type && NULL != msg->internal_request &&
+            SR__OPERATION__EVENT_NOTIF_REPLAY_CONTINUE == msg->internal_request->operation &&
+            NULL != msg->internal_request->event_notif_replay_continue_req) {
+        /* needs to inspect the output buffer of the subscriber connection */
+        destination_address = msg->internal_request->event_notif_replay_continue_req->subscriber_address;
+    }
+
+    if (NULL != destination_address) {
+        return &cm_ctx->reactors[sr_str_hash(destination_address) % cm_ctx->reactor_count];
+    }
+
+    lookup.session_id = msg->session_id;
+    pthread_rwlock_rdlock(&cm_ctx->session_routes_lock);
+    route = sr_btree_search(cm_ctx->session_routes, &lookup);
+    if (NULL != route) {
+        reactor = route->reactor;
+    }
+    pthread_rwlock_unlock(&cm_ctx->session_routes_lock);
+
+    return reactor;
+}
+
 int
 cm_init(const cm_connection_mode_t mode, const char *socket_path, cm_ctx_t **cm_ctx_p)
 {
     cm_ctx_t *ctx = NULL;
+    size_t reactor_count = 0;
     int rc = SR_ERR_OK;
 
     CHECK_NULL_ARG2(socket_path, cm_ctx_p);
@@ -1910,14 +2676,34 @@ cm_init(const cm_connection_mode_t mode, const char *socket_path, cm_ctx_t **cm_
         goto cleanup;
     }
     ctx->mode = mode;
-
-    /* initialize message queue */
-    pthread_mutex_init(&ctx->msg_queue_mutex, NULL);
-    rc = sr_cbuff_init(CM_INIT_MSG_QUEUE_SIZE, sizeof(Sr__Msg*), &ctx->msg_queue);
-    if (SR_ERR_OK != rc){
-        SR_LOG_ERR_MSG("CM message queue initialization failed.");
+    ctx->listen_socket_fd = -1;
+    pthread_mutex_init(&ctx->sm_lock, NULL);
+    pthread_rwlock_init(&ctx->session_routes_lock, NULL);
+
+    /* initialize reactors */
+    reactor_count = cm_get_reactor_count(mode);
+    ctx->reactors = calloc(reactor_count, sizeof(*ctx->reactors));
+    if (NULL == ctx->reactors) {
+        SR_LOG_ERR_MSG("Cannot allocate memory for Connection Manager reactors.");
+        rc = SR_ERR_NOMEM;
         goto cleanup;
     }
+    ctx->reactor_count = reactor_count;
+    for (size_t i = 0; i < ctx->reactor_count; i++) {
+        rc = cm_reactor_init(ctx, &ctx->reactors[i]);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_ERR("Cannot initialize Connection Manager reactor %zu.", i);
+            goto cleanup;
+        }
+    }
+    if (ctx->reactor_count > 1) {
+        rc = sr_btree_init(cm_session_route_cmp, free, &ctx->session_routes);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_ERR_MSG("Cannot initialize session routes.");
+            goto cleanup;
+        }
+    }
+    SR_LOG_DBG("Connection Manager will use %zu reactor(s).", ctx->reactor_count);
 
     /* initialize Session Manager */
     rc = sm_init(cm_session_data_cleanup, cm_connection_data_cleanup, &ctx->sm_ctx);
@@ -1933,25 +2719,10 @@ cm_init(const cm_connection_mode_t mode, const char *socket_path, cm_ctx_t **cm_
         goto cleanup;
     }
 
-    /* initialize event loop */
-    /* According to our measurements, EPOLL backend is significantly slower for
-     * fewer file descriptors, so we are disabling it for now. */
-    ctx->event_loop = ev_loop_new((EVBACKEND_ALL ^ EVBACKEND_EPOLL) | EVFLAG_NOENV);
-
-    /* initialize event watcher for unix-domain server socket */
+    /* initialize event watcher for unix-domain server socket, new connections are accepted by reactor 0 */
     ev_io_init(&ctx->server_watcher, cm_server_watcher_cb, ctx->listen_socket_fd, EV_READ);
     ctx->server_watcher.data = (void*)ctx;
-    ev_io_start(ctx->event_loop, &ctx->server_watcher);
-
-    /* initialize event watcher for async stop requests */
-    ev_async_init(&ctx->stop_watcher, cm_stop_cb);
-    ctx->stop_watcher.data = (void*)ctx;
-    ev_async_start(ctx->event_loop, &ctx->stop_watcher);
-
-    /* initialize event watcher for message enqueue events */
-    ev_async_init(&ctx->msg_queue_watcher, cm_msg_enqueue_cb);
-    ctx->msg_queue_watcher.data = (void*)ctx;
-    ev_async_start(ctx->event_loop, &ctx->msg_queue_watcher);
+    ev_io_start(ctx->reactors[0].event_loop, &ctx->server_watcher);
 
     /* initialize Request Processor */
     rc = rp_init(ctx, &ctx->rp_ctx);
@@ -1975,8 +2746,6 @@ cm_cleanup(cm_ctx_t *cm_ctx)
 {
     size_t i = 0;
     sm_session_t *session = NULL;
-    Sr__Msg *msg = NULL;
-    cm_delayed_request_ctx_t *req = NULL, *tmp = NULL;
     int rc = SR_ERR_OK;
 
     if (NULL != cm_ctx) {
@@ -1991,42 +2760,61 @@ cm_cleanup(cm_ctx_t *cm_ctx)
         rp_cleanup(cm_ctx->rp_ctx);
         sm_cleanup(cm_ctx->sm_ctx);
 
-        ev_loop_destroy(cm_ctx->event_loop);
-        cm_server_cleanup(cm_ctx);
-
-        while (sr_cbuff_dequeue(cm_ctx->msg_queue, &msg)) {
-            sr_msg_free(msg);
+        for (i = 0; i < cm_ctx->reactor_count; i++) {
+            cm_reactor_cleanup(&cm_ctx->reactors[i]);
         }
-        sr_cbuff_cleanup(cm_ctx->msg_queue);
-        pthread_mutex_destroy(&cm_ctx->msg_queue_mutex);
+        free(cm_ctx->reactors);
+        cm_server_cleanup(cm_ctx);
 
-        tmp = cm_ctx->delayed_requests;
-        while (NULL != tmp) {
-            req = tmp;
-            tmp = tmp->next;
-            sr_msg_free(req->msg);
-            free(req);
-        }
+        sr_btree_cleanup(cm_ctx->session_routes);
+        pthread_rwlock_destroy(&cm_ctx->session_routes_lock);
+        pthread_mutex_destroy(&cm_ctx->sm_lock);
 
         free(cm_ctx);
     }
     SR_LOG_INF_MSG("Connection Manager successfully destroyed.");
 }
 
+/**
+ * @brief Requests the reactors starting from the given index to stop and waits for their threads to finish.
+ */
+static void
+cm_reactors_stop(cm_ctx_t *cm_ctx, size_t first, size_t last)
+{
+    for (size_t i = first; i < last; i++) {
+        ev_async_send(cm_ctx->reactors[i].event_loop, &cm_ctx->reactors[i].stop_watcher);
+    }
+    for (size_t i = first; i < last; i++) {
+        pthread_join(cm_ctx->reactors[i].thread, NULL);
+    }
+}
+
 int
 cm_start(cm_ctx_t *cm_ctx)
 {
+    size_t i = 0;
     int rc = SR_ERR_OK;
 
     CHECK_NULL_ARG(cm_ctx);
 
+    /* run the additional reactors in their own threads */
+    for (i = 1; i < cm_ctx->reactor_count; i++) {
+        rc = pthread_create(&cm_ctx->reactors[i].thread, NULL, cm_event_loop_threaded, &cm_ctx->reactors[i]);
+        if (0 != rc) {
+            SR_LOG_ERR("Error by creating a new thread: %s", sr_strerror_safe(errno));
+            cm_reactors_stop(cm_ctx, 1, i);
+            return SR_ERR_INTERNAL;
+        }
+    }
+    cm_ctx->reactors_running = true;
+
     if (CM_MODE_DAEMON == cm_ctx->mode) {
-        /* run the event loop in this thread */
-        cm_event_loop(cm_ctx);
+        /* run the event loop of reactor 0 in this thread */
+        cm_event_loop(&cm_ctx->reactors[0]);
     } else {
-        /* run the event loop in a new thread */
+        /* run the event loop of reactor 0 in a new thread */
         rc = pthread_create(&cm_ctx->event_loop_thread, NULL,
-                cm_event_loop_threaded, cm_ctx);
+                cm_event_loop_threaded, &cm_ctx->reactors[0]);
         if (0 != rc) {
             SR_LOG_ERR("Error by creating a new thread: %s", sr_strerror_safe(errno));
             rc = SR_ERR_INTERNAL;
@@ -2044,7 +2832,13 @@ cm_stop(cm_ctx_t *cm_ctx)
     SR_LOG_INF_MSG("Connection Manager stop requested.");
 
     /* send async event to the event loop */
-    ev_async_send(cm_ctx->event_loop, &cm_ctx->stop_watcher);
+    ev_async_send(cm_ctx->reactors[0].event_loop, &cm_ctx->reactors[0].stop_watcher);
+
+    if (cm_ctx->reactors_running) {
+        /* stop the additional reactors and wait for their threads to exit */
+        cm_reactors_stop(cm_ctx, 1, cm_ctx->reactor_count);
+        cm_ctx->reactors_running = false;
+    }
 
     if (CM_MODE_LOCAL == cm_ctx->mode) {
         /* block until cleanup is finished and the thread with event loop exits */
@@ -2057,6 +2851,7 @@ cm_stop(cm_ctx_t *cm_ctx)
 int
 cm_msg_send(cm_ctx_t *cm_ctx, Sr__Msg *msg)
 {
+    cm_reactor_t *reactor = NULL;
     int rc = SR_ERR_OK;
 
     CHECK_NULL_ARG_NORET2(rc, cm_ctx, msg);
@@ -2068,13 +2863,15 @@ cm_msg_send(cm_ctx_t *cm_ctx, Sr__Msg *msg)
         return rc;
     }
 
-    pthread_mutex_lock(&cm_ctx->msg_queue_mutex);
-    rc = sr_cbuff_enqueue(cm_ctx->msg_queue, &msg);
-    pthread_mutex_unlock(&cm_ctx->msg_queue_mutex);
+    reactor = cm_msg_reactor_get(cm_ctx, msg);
+
+    pthread_mutex_lock(&reactor->msg_queue_mutex);
+    rc = sr_cbuff_enqueue(reactor->msg_queue, &msg);
+    pthread_mutex_unlock(&reactor->msg_queue_mutex);
 
     if (SR_ERR_OK == rc) {
         /* send async event to the event loop */
-        ev_async_send(cm_ctx->event_loop, &cm_ctx->msg_queue_watcher);
+        ev_async_send(reactor->event_loop, &reactor->msg_queue_watcher);
     } else {
         /* release the message by error */
         SR_LOG_ERR_MSG("Unable to send the message, skipping.");
@@ -2084,6 +2881,57 @@ cm_msg_send(cm_ctx_t *cm_ctx, Sr__Msg *msg)
     return rc;
 }
 
+int
+cm_msg_send_batch(cm_ctx_t *cm_ctx, Sr__Msg **msgs, size_t msg_cnt, size_t *sent_cnt)
+{
+    cm_reactor_t *reactor = NULL, *locked = NULL;
+    size_t i = 0;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG_NORET3(rc, cm_ctx, msgs, sent_cnt);
+
+    if (SR_ERR_OK != rc) {
+        for (i = 0; NULL != msgs && i < msg_cnt; i++) {
+            sr_msg_free(msgs[i]);
+        }
+        return rc;
+    }
+
+    /* enqueue the messages, consecutive messages for the same reactor under one lock */
+    for (i = 0; i < msg_cnt; i++) {
+        reactor = cm_msg_reactor_get(cm_ctx, msgs[i]);
+        if (reactor != locked) {
+            if (NULL != locked) {
+                pthread_mutex_unlock(&locked->msg_queue_mutex);
+                /* send one async event to the event loop for the whole run */
+                ev_async_send(locked->event_loop, &locked->msg_queue_watcher);
+            }
+            locked = reactor;
+            pthread_mutex_lock(&locked->msg_queue_mutex);
+        }
+        rc = sr_cbuff_enqueue(locked->msg_queue, &msgs[i]);
+        if (SR_ERR_OK != rc) {
+            break;
+        }
+    }
+    if (NULL != locked) {
+        pthread_mutex_unlock(&locked->msg_queue_mutex);
+        ev_async_send(locked->event_loop, &locked->msg_queue_watcher);
+    }
+
+    *sent_cnt = i;
+
+    if (i < msg_cnt) {
+        /* release the messages that have not been enqueued */
+        SR_LOG_ERR("Unable to send %zu of %zu messages, skipping.", msg_cnt - i, msg_cnt);
+        for (; i < msg_cnt; i++) {
+            sr_msg_free(msgs[i]);
+        }
+    }
+
+    return rc;
+}
+
 int
 cm_watch_signal(cm_ctx_t *cm_ctx, int signum, cm_signal_cb callback)
 {
@@ -2095,7 +2943,7 @@ cm_watch_signal(cm_ctx_t *cm_ctx, int signum, cm_signal_cb callback)
             cm_ctx->signal_callbacks[i] = callback;
             ev_signal_init(&cm_ctx->signal_watchers[i], cm_signal_cb_internal, signum);
             cm_ctx->signal_watchers[i].data = (void*)cm_ctx;
-            ev_signal_start(cm_ctx->event_loop, &cm_ctx->signal_watchers[i]);
+            ev_signal_start(cm_ctx->reactors[0].event_loop, &cm_ctx->signal_watchers[i]);
             return SR_ERR_OK;
         }
     }
@@ -2112,6 +2960,16 @@ cm_get_connection_mode(cm_ctx_t *cm_ctx)
     }
 }
 
+size_t
+cm_get_replay_pause_count(cm_ctx_t *cm_ctx)
+{
+    if (NULL != cm_ctx) {
+        return __atomic_load_n(&cm_ctx->replay_pause_cnt, __ATOMIC_RELAXED);
+    } else {
+        return 0;
+    }
+}
+
 int
 cm_before_cleanup(cm_ctx_t *cm_ctx)
 {
@@ -40,6 +40,17 @@
  * the main thread in daemon mode (making the main thread blocked until stop
  * is requested by ::cm_stop), whereas in local (library( mode the event loop
  * runs in a new dedicated thread (to not block caller thread).
+ *
+ * In daemon mode, the connections can be served by multiple event loops
+ * (reactors), each running in its own thread (see SR_CM_REACTOR_COUNT).
+ * The main event loop accepts new connections and distributes them among
+ * the reactors, messages from @ref rp are routed to the reactor owning the
+ * connection of their session (or the connection to their destination).
+ *
+ * Also in daemon mode, a client may offer a shared memory segment along with
+ * the version verification request (see @ref shm_transport). Once accepted,
+ * the messages of the connection (still preamble-framed) are passed through
+ * the rings in the segment and the socket carries only wake-ups.
  */
 
 #include "sysrepo.pb-c.h"
@@ -138,6 +149,24 @@ int cm_stop(cm_ctx_t *cm_ctx);
  */
 int cm_msg_send(cm_ctx_t *cm_ctx, Sr__Msg *msg);
 
+/**
+ * @brief Sends a batch of messages to their recipients according to the session
+ * ids / destination addresses filled in in the messages. The messages are handed over
+ * to the event loop at once.
+ *
+ * @note This function is thread safe, can be called from any thread.
+ *
+ * @param[in] cm_ctx Connection Manager context.
+ * @param[in] msgs Array of messages to be sent. @note Messages will be freed automatically
+ * after sending, also in case of error.
+ * @param[in] msg_cnt Count of messages in the array.
+ * @param[out] sent_cnt Count of messages (from the beginning of the array) that have been
+ * handed over to the event loop.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int cm_msg_send_batch(cm_ctx_t *cm_ctx, Sr__Msg **msgs, size_t msg_cnt, size_t *sent_cnt);
+
 /**
  * @brief Callback to be called when a watched signal (registered with
  * ::cm_watch_signal) has been caught.
@@ -167,6 +196,16 @@ int cm_watch_signal(cm_ctx_t *cm_ctx, int signum, cm_signal_cb callback);
  */
 cm_connection_mode_t cm_get_connection_mode(cm_ctx_t *cm_ctx);
 
+/**
+ * @brief Returns how many times Connection Manager has paused a replay of event notifications
+ * because the output buffer of the subscriber was filled over the high watermark.
+ *
+ * @param[in] cm_ctx Connection Manager context.
+ *
+ * @return Number of paused replays.
+ */
+size_t cm_get_replay_pause_count(cm_ctx_t *cm_ctx);
+
 /**
  * @brief Function blocks further commit request and wait for ongoing commits to finish.
  * @param [in] cm_ctx
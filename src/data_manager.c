@@ -54,6 +54,20 @@ typedef struct dm_tmp_ly_ctx_s {
     sr_list_t *loaded_modules;
 } dm_tmp_ly_ctx_t;
 
+/**
+ * @brief Background warm-up of the schema infos: the modules from the list are loaded
+ * by a pool of threads in parallel right after the Data Manager starts.
+ */
+typedef struct dm_warmup_s {
+    char *list_filepath;          /**< file recording the modules loaded when the engine was stopped the last time */
+    sr_list_t *modules;           /**< names of the modules to be loaded (char *) */
+    size_t next;                  /**< index of the next module to be loaded, guarded by mutex */
+    bool stop_requested;          /**< set when the Data Manager is being cleaned up, guarded by mutex */
+    pthread_mutex_t mutex;        /**< guards next and stop_requested */
+    pthread_t *threads;           /**< warm-up threads */
+    size_t thread_count;          /**< number of running warm-up threads */
+} dm_warmup_t;
+
 /**
  * @brief Structure that holds Data Manager's per-session context.
  */
@@ -113,7 +127,7 @@ typedef enum dm_procedure_e {
  */
 #define DM_COMMIT_MAX_WAIT_TIME 30
 
-static int dm_get_data_info_internal(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx, const char *module_name, bool skip_validation, bool *should_be_freed, dm_data_info_t **info);
+static int dm_get_data_info_internal(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx, const char *module_name, bool skip_validation, bool rdonly, bool *should_be_freed, dm_data_info_t **info);
 
 /**
  * @brief Compares two data trees by module name
@@ -270,11 +284,287 @@ dm_free_lys_private_data(const struct lys_node *node, void *private)
     }
 }
 
+/**
+ * @brief Drops a reference to the data snapshot, the snapshot is freed once it is not referenced anymore.
+ */
+static void
+dm_data_snapshot_release(dm_schema_info_t *schema_info, dm_data_snapshot_t *snapshot)
+{
+    bool free_snapshot = false;
+
+    if (NULL == snapshot) {
+        return;
+    }
+
+    pthread_mutex_lock(&schema_info->data_cache_mutex);
+    snapshot->ref_count--;
+    free_snapshot = (0 == snapshot->ref_count);
+    pthread_mutex_unlock(&schema_info->data_cache_mutex);
+
+    if (free_snapshot) {
+        lyd_free_withsiblings(snapshot->node);
+        free(snapshot);
+    }
+}
+
+/**
+ * @brief Bumps the generation of the data file of the module in the given datastore
+ * and drops the cached snapshot. Has to be called whenever the data file is rewritten.
+ */
+static void
+dm_data_cache_invalidate(dm_schema_info_t *schema_info, sr_datastore_t ds)
+{
+    dm_data_snapshot_t *snapshot = NULL;
+
+    pthread_mutex_lock(&schema_info->data_cache_mutex);
+    schema_info->generation[ds]++;
+    snapshot = schema_info->data_cache[ds];
+    schema_info->data_cache[ds] = NULL;
+    pthread_mutex_unlock(&schema_info->data_cache_mutex);
+
+    dm_data_snapshot_release(schema_info, snapshot);
+}
+
+/**
+ * @brief Drops cached snapshots of all datastores, must be called before the libyang context
+ * of the schema info is modified or destroyed.
+ */
+static void
+dm_data_cache_clear(dm_schema_info_t *schema_info)
+{
+    for (size_t i = 0; i < DM_DATASTORE_COUNT; i++) {
+        dm_data_cache_invalidate(schema_info, i);
+    }
+}
+
+void
+dm_xpath_entry_free(dm_xpath_entry_t *entry)
+{
+    if (NULL == entry) {
+        return;
+    }
+    for (size_t i = 0; NULL != entry->steps && i < entry->step_cnt; i++) {
+        for (size_t k = 0; NULL != entry->steps[i].keys && k < entry->steps[i].key_cnt; k++) {
+            free(entry->steps[i].keys[k]);
+        }
+        free(entry->steps[i].keys);
+        free(entry->steps[i].predicates);
+    }
+    free(entry->steps);
+    free(entry->xpath);
+    free(entry);
+}
+
+/**
+ * @brief Number of buckets of the xpath cache hash table (power of two).
+ */
+static size_t
+dm_xpath_cache_bucket_cnt()
+{
+    size_t cnt = 16;
+    while (cnt < SR_XPATH_CACHE_SIZE) {
+        cnt <<= 1;
+    }
+    return cnt;
+}
+
+/**
+ * @brief Unlinks the entry from the xpath cache. The entry is freed unless it is still referenced.
+ * Xpath cache mutex must be held by the caller.
+ */
+static void
+dm_xpath_cache_remove(dm_schema_info_t *schema_info, dm_xpath_entry_t *entry)
+{
+    dm_xpath_entry_t **bucket = &schema_info->xpath_cache[entry->hash & (dm_xpath_cache_bucket_cnt() - 1)];
+
+    while (*bucket != entry) {
+        bucket = &(*bucket)->hash_next;
+    }
+    *bucket = entry->hash_next;
+
+    if (NULL != entry->lru_prev) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    } else {
+        schema_info->xpath_cache_mru = entry->lru_next;
+    }
+    if (NULL != entry->lru_next) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    } else {
+        schema_info->xpath_cache_lru = entry->lru_prev;
+    }
+    schema_info->xpath_cache_cnt--;
+
+    entry->cached = false;
+    if (0 == entry->ref_cnt) {
+        dm_xpath_entry_free(entry);
+    }
+}
+
+/**
+ * @brief Drops all resolved xpaths of the schema info, must be called whenever
+ * the libyang context of the schema info is modified or destroyed.
+ */
+static void
+dm_xpath_cache_clear(dm_schema_info_t *schema_info)
+{
+    pthread_mutex_lock(&schema_info->xpath_cache_mutex);
+    while (NULL != schema_info->xpath_cache_mru) {
+        dm_xpath_cache_remove(schema_info, schema_info->xpath_cache_mru);
+    }
+    pthread_mutex_unlock(&schema_info->xpath_cache_mutex);
+}
+
+/**
+ * @brief Looks up the xpath in the hash table and marks it as the most recently used.
+ * Xpath cache mutex must be held by the caller.
+ */
+static dm_xpath_entry_t *
+dm_xpath_cache_lookup(dm_schema_info_t *schema_info, const char *xpath, uint32_t hash)
+{
+    dm_xpath_entry_t *entry = NULL;
+
+    if (NULL == schema_info->xpath_cache) {
+        return NULL;
+    }
+
+    entry = schema_info->xpath_cache[hash & (dm_xpath_cache_bucket_cnt() - 1)];
+    while (NULL != entry && (entry->hash != hash || 0 != strcmp(entry->xpath, xpath))) {
+        entry = entry->hash_next;
+    }
+
+    if (NULL != entry && NULL != entry->lru_prev) {
+        /* move to the front of the LRU list */
+        entry->lru_prev->lru_next = entry->lru_next;
+        if (NULL != entry->lru_next) {
+            entry->lru_next->lru_prev = entry->lru_prev;
+        } else {
+            schema_info->xpath_cache_lru = entry->lru_prev;
+        }
+        entry->lru_prev = NULL;
+        entry->lru_next = schema_info->xpath_cache_mru;
+        schema_info->xpath_cache_mru->lru_prev = entry;
+        schema_info->xpath_cache_mru = entry;
+    }
+    return entry;
+}
+
+int
+dm_xpath_cache_get(dm_schema_info_t *schema_info, const char *xpath, dm_xpath_entry_t **entry)
+{
+    CHECK_NULL_ARG3(schema_info, xpath, entry);
+    dm_xpath_entry_t *e = NULL;
+    uint32_t hash = 0;
+
+    if (0 == SR_XPATH_CACHE_SIZE) {
+        return SR_ERR_NOT_FOUND;
+    }
+
+    hash = sr_str_hash(xpath);
+    pthread_mutex_lock(&schema_info->xpath_cache_mutex);
+    e = dm_xpath_cache_lookup(schema_info, xpath, hash);
+    if (NULL != e) {
+        e->ref_cnt++;
+    }
+    pthread_mutex_unlock(&schema_info->xpath_cache_mutex);
+
+    *entry = e;
+    return NULL != e ? SR_ERR_OK : SR_ERR_NOT_FOUND;
+}
+
+int
+dm_xpath_cache_add(dm_schema_info_t *schema_info, dm_xpath_entry_t *new_entry, dm_xpath_entry_t **entry)
+{
+    CHECK_NULL_ARG4(schema_info, new_entry, new_entry->xpath, entry);
+    dm_xpath_entry_t *e = NULL;
+    dm_xpath_entry_t **bucket = NULL;
+    int rc = SR_ERR_OK;
+
+    new_entry->hash = sr_str_hash(new_entry->xpath);
+    new_entry->ref_cnt = 1;
+    new_entry->cached = false;
+    new_entry->hash_next = new_entry->lru_prev = new_entry->lru_next = NULL;
+
+    if (0 == SR_XPATH_CACHE_SIZE) {
+        /* entry is freed once released */
+        *entry = new_entry;
+        return SR_ERR_OK;
+    }
+
+    pthread_mutex_lock(&schema_info->xpath_cache_mutex);
+
+    if (NULL == schema_info->xpath_cache) {
+        schema_info->xpath_cache = calloc(dm_xpath_cache_bucket_cnt(), sizeof *schema_info->xpath_cache);
+        if (NULL == schema_info->xpath_cache) {
+            SR_LOG_ERR_MSG("Unable to allocate the xpath cache.");
+            dm_xpath_entry_free(new_entry);
+            rc = SR_ERR_NOMEM;
+            goto cleanup;
+        }
+    }
+
+    e = dm_xpath_cache_lookup(schema_info, new_entry->xpath, new_entry->hash);
+    if (NULL != e) {
+        /* resolved by another thread meanwhile */
+        e->ref_cnt++;
+        dm_xpath_entry_free(new_entry);
+        new_entry = e;
+        goto cleanup;
+    }
+
+    if (schema_info->xpath_cache_cnt >= SR_XPATH_CACHE_SIZE) {
+        dm_xpath_cache_remove(schema_info, schema_info->xpath_cache_lru);
+    }
+
+    bucket = &schema_info->xpath_cache[new_entry->hash & (dm_xpath_cache_bucket_cnt() - 1)];
+    new_entry->hash_next = *bucket;
+    *bucket = new_entry;
+    new_entry->lru_next = schema_info->xpath_cache_mru;
+    if (NULL != schema_info->xpath_cache_mru) {
+        schema_info->xpath_cache_mru->lru_prev = new_entry;
+    } else {
+        schema_info->xpath_cache_lru = new_entry;
+    }
+    schema_info->xpath_cache_mru = new_entry;
+    schema_info->xpath_cache_cnt++;
+    new_entry->cached = true;
+
+cleanup:
+    pthread_mutex_unlock(&schema_info->xpath_cache_mutex);
+    if (SR_ERR_OK == rc) {
+        *entry = new_entry;
+    }
+    return rc;
+}
+
+void
+dm_xpath_cache_release(dm_schema_info_t *schema_info, dm_xpath_entry_t *entry)
+{
+    bool free_entry = false;
+
+    if (NULL == schema_info || NULL == entry) {
+        return;
+    }
+
+    pthread_mutex_lock(&schema_info->xpath_cache_mutex);
+    entry->ref_cnt--;
+    free_entry = (0 == entry->ref_cnt && !entry->cached);
+    pthread_mutex_unlock(&schema_info->xpath_cache_mutex);
+
+    if (free_entry) {
+        dm_xpath_entry_free(entry);
+    }
+}
+
 static void
 dm_free_schema_info(void *schema_info)
 {
     CHECK_NULL_ARG_VOID(schema_info);
     dm_schema_info_t *si = (dm_schema_info_t *) schema_info;
+    dm_data_cache_clear(si);
+    pthread_mutex_destroy(&si->data_cache_mutex);
+    dm_xpath_cache_clear(si);
+    free(si->xpath_cache);
+    pthread_mutex_destroy(&si->xpath_cache_mutex);
     free(si->module_name);
     pthread_rwlock_destroy(&si->model_lock);
     pthread_mutex_destroy(&si->usage_count_mutex);
@@ -291,8 +581,12 @@ static void
 dm_data_info_free(void *item)
 {
     dm_data_info_t *info = (dm_data_info_t *) item;
-    if (NULL != info && !info->rdonly_copy) {
-        lyd_free_withsiblings(info->node);
+    if (NULL != info && (!info->rdonly_copy || NULL != info->snapshot)) {
+        if (NULL != info->snapshot) {
+            dm_data_snapshot_release(info->schema, info->snapshot);
+        } else {
+            lyd_free_withsiblings(info->node);
+        }
         sr_free_list_of_strings(info->required_modules);
         /* decrement the number of usage of the module */
         pthread_mutex_lock(&info->schema->usage_count_mutex);
@@ -303,6 +597,51 @@ dm_data_info_free(void *item)
     free(info);
 }
 
+/**
+ * @brief Frees the data tree of the data info. If the data info references a shared snapshot
+ * only the reference is dropped.
+ */
+static void
+dm_data_info_free_node(dm_data_info_t *info)
+{
+    if (NULL != info->snapshot) {
+        dm_data_snapshot_release(info->schema, info->snapshot);
+        info->snapshot = NULL;
+        info->rdonly_copy = false;
+    } else {
+        lyd_free_withsiblings(info->node);
+    }
+    info->node = NULL;
+}
+
+/**
+ * @brief Turns the data info referencing a shared snapshot into a private copy that can be modified.
+ * Does nothing if the data info already holds a private copy.
+ */
+static int
+dm_data_info_make_writable(dm_data_info_t *info)
+{
+    CHECK_NULL_ARG(info);
+    struct lyd_node *dup = NULL;
+
+    if (NULL == info->snapshot) {
+        return SR_ERR_OK;
+    }
+
+    if (NULL != info->node) {
+        dup = sr_dup_datatree(info->node);
+        CHECK_NULL_NOMEM_RETURN(dup);
+    }
+
+    dm_data_snapshot_release(info->schema, info->snapshot);
+    info->snapshot = NULL;
+    info->rdonly_copy = false;
+    info->node = dup;
+    SR_LOG_DBG("Module %s: shared data tree duplicated before modification", info->schema->module_name);
+
+    return SR_ERR_OK;
+}
+
 static void
 dm_model_subscription_free(void *sub)
 {
@@ -664,6 +1003,13 @@ dm_schema_info_init(const char *schema_search_dir, dm_schema_info_t **schema_inf
 
     pthread_rwlock_init(&si->model_lock, NULL);
     pthread_mutex_init(&si->usage_count_mutex, NULL);
+    pthread_mutex_init(&si->data_cache_mutex, NULL);
+    pthread_mutex_init(&si->xpath_cache_mutex, NULL);
+
+    /* generation 0 is reserved for data copies of unknown origin */
+    for (size_t i = 0; i < DM_DATASTORE_COUNT; i++) {
+        si->generation[i] = 1;
+    }
 
 cleanup:
     if (SR_ERR_OK != rc) {
@@ -700,6 +1046,7 @@ dm_insert_data_info_copy(sr_btree_t *tree, const dm_data_info_t *di)
     pthread_mutex_unlock(&di->schema->usage_count_mutex);
     copy->schema = di->schema;
     copy->timestamp = di->timestamp;
+    copy->generation = di->generation;
 
     rc = sr_btree_insert(tree, (void *) copy);
 cleanup:
@@ -735,6 +1082,10 @@ dm_feature_enable_internal(dm_ctx_t *dm_ctx, dm_schema_info_t *schema_info, cons
         return SR_ERR_OPERATION_FAILED;
     }
 
+    /* cached data trees and resolved xpaths may not be valid with the modified set of features */
+    dm_data_cache_clear(schema_info);
+    dm_xpath_cache_clear(schema_info);
+
     const struct lys_module *module = ly_ctx_get_module(schema_info->ly_ctx, module_name, NULL, 0);
     if (NULL != module) {
         rc = enable ? lys_features_enable(module, feature_name) : lys_features_disable(module, feature_name);
@@ -1176,84 +1527,829 @@ dm_remove_added_data_trees_by_module_name(const char *module_name, struct lyd_no
 }
 
 /**
- * @brief Tries to load data tree from provided opened file.
- * @param [in] dm_ctx
- * @param [in] fd to be read from, function does not close it
- * If NULL passed data info with empty data will be created
- * @param [in] schema_info
- * @param [in] data_info
- * @return Error code (SR_ERR_OK on success)
+ * @brief Operations recorded in the journal of changes of a running data file.
+ */
+#define DM_JOURNAL_OP_SET 'S'       /**< create the node or update its value: xpath [value] */
+#define DM_JOURNAL_OP_DELETE 'D'    /**< delete the node: xpath */
+#define DM_JOURNAL_OP_MOVE 'M'      /**< move the user-ordered node after the sibling: xpath [sibling xpath] */
+#define DM_JOURNAL_OP_COMMIT 'C'    /**< end of the record written by one commit */
+
+/** Header of the journal, identifies the content of the data file the journal applies to by the inode,
+ * the size and the hash of the data file when the journal was started. Appends to the journal do not change
+ * the data file, so any rewrite of the data file in the meantime is detected. */
+#define DM_JOURNAL_HEADER "SRJ %llu %llu %llx\n"
+
+/** Maximum length of the journal header. */
+#define DM_JOURNAL_HEADER_MAX_LEN 80
+
+/**
+ * @brief Buffer holding a record of the journal before it is appended to the file.
+ */
+typedef struct dm_journal_buf_s {
+    char *data;     /**< record content */
+    size_t len;     /**< length of the record */
+    size_t size;    /**< allocated size of data */
+} dm_journal_buf_t;
+
+/**
+ * @brief Returns the name of the journal file belonging to the data file.
  */
 static int
-dm_load_data_tree_file(dm_ctx_t *dm_ctx, int fd, const char *data_filename, dm_schema_info_t *schema_info, dm_data_info_t **data_info)
+dm_journal_file_name(const char *data_filename, char **journal_filename)
 {
-    CHECK_NULL_ARG4(dm_ctx, schema_info, data_filename, data_info);
-    int rc = SR_ERR_OK;
-    struct lyd_node *data_tree = NULL, *elem = NULL, *iter = NULL;
-    *data_info = NULL;
-
-    dm_data_info_t *data = NULL;
-    data = calloc(1, sizeof(*data));
-    CHECK_NULL_NOMEM_RETURN(data);
+    return sr_str_join(data_filename, SR_JOURNAL_FILE_EXT, journal_filename);
+}
 
-    if (-1 != fd) {
-#ifdef HAVE_STAT_ST_MTIM
-        struct stat st = {0};
-        rc = stat(data_filename, &st);
-        if (-1 == rc) {
-            SR_LOG_ERR_MSG("Stat failed");
-            free(data);
-            return SR_ERR_INTERNAL;
-        }
-        data->timestamp = st.st_mtim;
-        SR_LOG_DBG("Loaded module %s: mtime sec=%lld nsec=%lld", schema_info->module->name,
-                (long long) st.st_mtim.tv_sec,
-                (long long) st.st_mtim.tv_nsec);
-#endif
-        if (schema_info->has_instance_id) {
-            struct lyd_node *tmp_node = NULL;
-            dm_tmp_ly_ctx_t *tmp_ctx = NULL;
+/**
+ * @brief Calculates the hash of the content of the data file (64-bit FNV-1a).
+ *
+ * @param [in] fd opened data file
+ * @param [out] hash
+ * @return Error code (SR_ERR_OK on success)
+ */
+static int
+dm_data_file_hash(int fd, unsigned long long *hash)
+{
+    unsigned char buff[4096];
+    unsigned long long h = 14695981039346656037ULL;
+    off_t offset = 0;
+    ssize_t ret = 0;
 
-            rc = dm_get_tmp_ly_ctx(dm_ctx, NULL, &tmp_ctx);
-            if (rc != SR_ERR_OK) {
-                SR_LOG_ERR_MSG("Failed to create temporary context.");
-                free(data);
-                return rc;
+    while (0 != (ret = pread(fd, buff, sizeof buff, offset))) {
+        if (-1 == ret) {
+            if (EINTR == errno) {
+                continue;
             }
-            md_ctx_lock(dm_ctx->md_ctx, false);
-            ly_ctx_set_module_data_clb(tmp_ctx->ctx, dm_module_clb, dm_ctx);
+            SR_LOG_ERR("Failed to read the data file: %s", sr_strerror_safe(errno));
+            return SR_ERR_IO;
+        }
+        for (ssize_t i = 0; i < ret; ++i) {
+            h = (h ^ buff[i]) * 1099511628211ULL;
+        }
+        offset += ret;
+    }
 
-            ly_errno = LY_SUCCESS;
-            tmp_node = lyd_parse_fd(tmp_ctx->ctx, fd, SR_FILE_FORMAT_LY, LYD_OPT_TRUSTED | LYD_OPT_CONFIG);
-            md_ctx_unlock(dm_ctx->md_ctx);
+    *hash = h;
+    return SR_ERR_OK;
+}
 
-            if (NULL == tmp_node && LY_SUCCESS != ly_errno) {
-                SR_LOG_ERR("Parsing data tree from file %s failed: %s", data_filename, ly_errmsg(tmp_ctx->ctx));
-                free(data);
-                return SR_ERR_INTERNAL;
-            }
+/**
+ * @brief Checks whether the journal header matches the current content of the data file.
+ *
+ * @param [in] content beginning of the journal (NULL-terminated)
+ * @param [in] fd opened data file
+ * @param [in] st status of the data file
+ * @param [out] header_len length of the header
+ * @return True if the journal applies to the data file
+ */
+static bool
+dm_journal_header_matches(const char *content, int fd, const struct stat *st, size_t *header_len)
+{
+    unsigned long long ino = 0, size = 0, hash = 0, file_hash = 0;
+    const char *eol = NULL;
 
-            dm_remove_added_data_trees_by_module_name(schema_info->module_name, &tmp_node);
+    eol = strchr(content, '\n');
+    if (NULL == eol || 3 != sscanf(content, DM_JOURNAL_HEADER, &ino, &size, &hash)) {
+        return false;
+    }
+    *header_len = eol - content + 1;
 
-            if (NULL != tmp_node) {
-                data_tree = sr_dup_datatree_to_ctx(tmp_node, schema_info->ly_ctx);
-            }
-            lyd_free_withsiblings(tmp_node);
-            dm_release_tmp_ly_ctx(dm_ctx, tmp_ctx);
-        } else {
-            ly_errno = LY_SUCCESS;
-            /* use LYD_OPT_TRUSTED, validation will be done later */
-            data_tree = lyd_parse_fd(schema_info->ly_ctx, fd, SR_FILE_FORMAT_LY, LYD_OPT_TRUSTED | LYD_OPT_CONFIG);
-            if (NULL == data_tree && LY_SUCCESS != ly_errno) {
-                SR_LOG_ERR("Parsing data tree from file %s failed: %s", data_filename, ly_errmsg(schema_info->ly_ctx));
-                free(data);
-                return SR_ERR_INTERNAL;
-            }
-        }
+    if ((unsigned long long)st->st_ino != ino || (unsigned long long)st->st_size != size) {
+        return false;
     }
+    /* the same size does not mean the same content */
+    return SR_ERR_OK == dm_data_file_hash(fd, &file_hash) && file_hash == hash;
+}
 
-    /* if there is no data dependency validate it with of LYD_OPT_STRICT, validate it (only non-empty data trees are validated)*/
-    if (!schema_info->cross_module_data_dependency && !schema_info->has_instance_id) {
+/**
+ * @brief Removes the journal of the running data file of the module. Called whenever
+ * the whole data file is rewritten, the content of the journal is contained in it.
+ */
+static void
+dm_journal_remove(dm_ctx_t *dm_ctx, const char *module_name)
+{
+    char *file_name = NULL, *journal_name = NULL;
+
+    if (SR_ERR_OK != sr_get_data_file_name(dm_ctx->data_search_dir, module_name, SR_DS_RUNNING, &file_name) ||
+            SR_ERR_OK != dm_journal_file_name(file_name, &journal_name)) {
+        SR_LOG_WRN("Failed to get journal file name of module %s", module_name);
+    } else if (-1 == unlink(journal_name) && ENOENT != errno) {
+        SR_LOG_WRN("Failed to remove journal %s: %s", journal_name, sr_strerror_safe(errno));
+    }
+    free(journal_name);
+    free(file_name);
+}
+
+/**
+ * @brief Appends a string prefixed with its length to the journal record.
+ */
+static int
+dm_journal_buf_add_str(dm_journal_buf_t *buf, const char *str)
+{
+    size_t len = strlen(str);
+    size_t required = buf->len + len + 24;
+    char *tmp = NULL;
+
+    if (required > buf->size) {
+        tmp = realloc(buf->data, 2 * required);
+        CHECK_NULL_NOMEM_RETURN(tmp);
+        buf->data = tmp;
+        buf->size = 2 * required;
+    }
+    buf->len += snprintf(buf->data + buf->len, buf->size - buf->len, " %zu:", len);
+    memcpy(buf->data + buf->len, str, len);
+    buf->len += len;
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Appends an operation to the journal record.
+ *
+ * @param [in] buf journal record
+ * @param [in] op operation
+ * @param [in] xpath of the node the operation applies to
+ * @param [in] arg value or sibling xpath, NULL if the operation has no argument
+ */
+static int
+dm_journal_buf_add_op(dm_journal_buf_t *buf, char op, const char *xpath, const char *arg)
+{
+    int rc = SR_ERR_OK;
+    char *tmp = NULL;
+
+    if (buf->len + 2 > buf->size) {
+        tmp = realloc(buf->data, buf->size + 256);
+        CHECK_NULL_NOMEM_RETURN(tmp);
+        buf->data = tmp;
+        buf->size += 256;
+    }
+    buf->data[buf->len++] = op;
+
+    if (NULL != xpath) {
+        rc = dm_journal_buf_add_str(buf, xpath);
+    }
+    if (SR_ERR_OK == rc && NULL != arg) {
+        rc = dm_journal_buf_add_str(buf, arg);
+    }
+    CHECK_RC_MSG_RETURN(rc, "Failed to append operation to the journal record");
+
+    /* add_str always leaves room for the newline */
+    buf->data[buf->len++] = '\n';
+    return rc;
+}
+
+/**
+ * @brief Returns the xpath identifying the node for the journal. Leaf-list instances
+ * are addressed without the value predicate when they are created.
+ */
+static char *
+dm_journal_node_path(const struct lyd_node *node, bool create)
+{
+    char *parent_path = NULL, *path = NULL;
+    const struct lys_module *module = lyd_node_module(node);
+    int rc = SR_ERR_OK;
+
+    if (!create || LYS_LEAFLIST != node->schema->nodetype) {
+        return lyd_path((struct lyd_node *)node);
+    }
+
+    if (NULL != node->parent) {
+        parent_path = lyd_path(node->parent);
+        if (NULL == parent_path) {
+            return NULL;
+        }
+    }
+    if (NULL == node->parent || module != lyd_node_module(node->parent)) {
+        rc = sr_asprintf(&path, "%s/%s:%s", NULL != parent_path ? parent_path : "", module->name, node->schema->name);
+    } else {
+        rc = sr_asprintf(&path, "%s/%s", parent_path, node->schema->name);
+    }
+    free(parent_path);
+
+    return SR_ERR_OK == rc ? path : NULL;
+}
+
+/**
+ * @brief Appends an operation with the node (and the sibling) identified by their xpaths to the journal record.
+ */
+static int
+dm_journal_buf_add_node_op(dm_journal_buf_t *buf, char op, const struct lyd_node *node, const struct lyd_node *sibling)
+{
+    int rc = SR_ERR_OK;
+    char *xpath = NULL, *sibling_xpath = NULL;
+    const char *arg = NULL;
+
+    xpath = dm_journal_node_path(node, DM_JOURNAL_OP_SET == op);
+    CHECK_NULL_NOMEM_RETURN(xpath);
+
+    if (DM_JOURNAL_OP_SET == op && (LYS_LEAF | LYS_LEAFLIST) & node->schema->nodetype) {
+        arg = ((struct lyd_node_leaf_list *)node)->value_str;
+    } else if (DM_JOURNAL_OP_MOVE == op && NULL != sibling) {
+        sibling_xpath = lyd_path((struct lyd_node *)sibling);
+        CHECK_NULL_NOMEM_GOTO(sibling_xpath, rc, cleanup);
+        arg = sibling_xpath;
+    }
+
+    rc = dm_journal_buf_add_op(buf, op, xpath, arg);
+
+cleanup:
+    free(xpath);
+    free(sibling_xpath);
+    return rc;
+}
+
+/**
+ * @brief Records creation of the subtree. Every explicit leaf, leaf-list, list instance and presence
+ * container is recorded as a separate set operation, default nodes are created by validation.
+ *
+ * @return Error code (SR_ERR_OK on success), SR_ERR_UNSUPPORTED if the subtree contains anydata
+ */
+static int
+dm_journal_buf_add_subtree(dm_journal_buf_t *buf, struct lyd_node *root)
+{
+    int rc = SR_ERR_OK;
+    struct lyd_node *next = NULL, *node = NULL;
+    bool set = false;
+
+    LY_TREE_DFS_BEGIN(root, next, node) {
+        set = false;
+        switch (node->schema->nodetype) {
+        case LYS_LEAF:
+            /* keys are created together with the list instance */
+            set = !node->dflt && NULL == lys_is_key((struct lys_node_leaf *)node->schema, NULL);
+            break;
+        case LYS_LEAFLIST:
+            set = !node->dflt;
+            break;
+        case LYS_LIST:
+            set = true;
+            break;
+        case LYS_CONTAINER:
+            set = NULL != ((struct lys_node_container *)node->schema)->presence;
+            break;
+        default:
+            SR_LOG_DBG("Node %s can not be recorded in the journal", node->schema->name);
+            return SR_ERR_UNSUPPORTED;
+        }
+        if (set) {
+            rc = dm_journal_buf_add_node_op(buf, DM_JOURNAL_OP_SET, node, NULL);
+            CHECK_RC_MSG_RETURN(rc, "Failed to record created node");
+        }
+        LYD_TREE_DFS_END(root, next, node);
+    }
+
+    return rc;
+}
+
+/**
+ * @brief Converts the list of differences between the data tree before and after the commit
+ * into a journal record.
+ *
+ * @param [in] diff
+ * @param [in] buf journal record, empty if there are no changes
+ * @return Error code (SR_ERR_OK on success), SR_ERR_UNSUPPORTED if the changes can not be journaled
+ */
+static int
+dm_journal_record_from_diff(struct lyd_difflist *diff, dm_journal_buf_t *buf)
+{
+    int rc = SR_ERR_OK;
+
+    for (size_t i = 0; SR_ERR_OK == rc && LYD_DIFF_END != diff->type[i]; ++i) {
+        switch (diff->type[i]) {
+        case LYD_DIFF_DELETED:
+            rc = dm_journal_buf_add_node_op(buf, DM_JOURNAL_OP_DELETE, diff->first[i], NULL);
+            break;
+        case LYD_DIFF_CHANGED:
+            if (!((LYS_LEAF | LYS_LEAFLIST) & diff->second[i]->schema->nodetype)) {
+                rc = SR_ERR_UNSUPPORTED;
+            } else if (diff->second[i]->dflt) {
+                /* the default value is restored by validation */
+                rc = dm_journal_buf_add_node_op(buf, DM_JOURNAL_OP_DELETE, diff->first[i], NULL);
+            } else {
+                rc = dm_journal_buf_add_node_op(buf, DM_JOURNAL_OP_SET, diff->second[i], NULL);
+            }
+            break;
+        case LYD_DIFF_CREATED:
+            rc = dm_journal_buf_add_subtree(buf, diff->second[i]);
+            break;
+        case LYD_DIFF_MOVEDAFTER1:
+            rc = dm_journal_buf_add_node_op(buf, DM_JOURNAL_OP_MOVE, diff->first[i], diff->second[i]);
+            break;
+        case LYD_DIFF_MOVEDAFTER2:
+            rc = dm_journal_buf_add_node_op(buf, DM_JOURNAL_OP_MOVE, diff->second[i], diff->first[i]);
+            break;
+        default:
+            rc = SR_ERR_UNSUPPORTED;
+        }
+    }
+
+    if (SR_ERR_OK == rc && buf->len > 0) {
+        rc = dm_journal_buf_add_op(buf, DM_JOURNAL_OP_COMMIT, NULL, NULL);
+    }
+    return rc;
+}
+
+/**
+ * @brief Reads a length-prefixed string of the journal record.
+ */
+static int
+dm_journal_read_str(const char **pos, const char *end, char **str)
+{
+    char *num_end = NULL;
+    unsigned long long len = 0;
+
+    if (*pos >= end || ' ' != **pos) {
+        return SR_ERR_MALFORMED_MSG;
+    }
+    errno = 0;
+    len = strtoull(*pos + 1, &num_end, 10);
+    if (0 != errno || num_end >= end || ':' != *num_end || len > (unsigned long long)(end - num_end - 1)) {
+        return SR_ERR_MALFORMED_MSG;
+    }
+    *str = strndup(num_end + 1, len);
+    CHECK_NULL_NOMEM_RETURN(*str);
+    *pos = num_end + 1 + len;
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Parses one operation of the journal record.
+ *
+ * @param [in,out] pos position in the journal, moved behind the operation
+ * @param [in] end end of the journal content
+ * @param [out] op operation
+ * @param [out] xpath allocated xpath, NULL for the commit mark
+ * @param [out] arg allocated argument, NULL if the operation has none
+ * @return Error code (SR_ERR_OK on success), SR_ERR_MALFORMED_MSG if the operation is incomplete
+ */
+static int
+dm_journal_parse_op(const char **pos, const char *end, char *op, char **xpath, char **arg)
+{
+    int rc = SR_ERR_OK;
+
+    *xpath = *arg = NULL;
+    if (*pos >= end) {
+        return SR_ERR_MALFORMED_MSG;
+    }
+    *op = *(*pos)++;
+
+    switch (*op) {
+    case DM_JOURNAL_OP_COMMIT:
+        break;
+    case DM_JOURNAL_OP_SET:
+    case DM_JOURNAL_OP_MOVE:
+        rc = dm_journal_read_str(pos, end, xpath);
+        if (SR_ERR_OK == rc && *pos < end && ' ' == **pos) {
+            rc = dm_journal_read_str(pos, end, arg);
+        }
+        break;
+    case DM_JOURNAL_OP_DELETE:
+        rc = dm_journal_read_str(pos, end, xpath);
+        break;
+    default:
+        rc = SR_ERR_MALFORMED_MSG;
+    }
+
+    if (SR_ERR_OK == rc && (*pos >= end || '\n' != **pos)) {
+        rc = SR_ERR_MALFORMED_MSG;
+    }
+    if (SR_ERR_OK != rc) {
+        free(*xpath);
+        free(*arg);
+        *xpath = *arg = NULL;
+        return rc;
+    }
+    (*pos)++;
+
+    return rc;
+}
+
+/**
+ * @brief Moves the pointer to the first top-level sibling of the data tree.
+ */
+static void
+dm_journal_tree_rewind(struct lyd_node **data_tree)
+{
+    while (NULL != *data_tree && NULL != (*data_tree)->prev->next) {
+        *data_tree = (*data_tree)->prev;
+    }
+}
+
+/**
+ * @brief Applies one operation of the journal onto the data tree. Operations whose target
+ * does not exist are skipped.
+ */
+static int
+dm_journal_apply_op(struct ly_ctx *ly_ctx, struct lyd_node **data_tree, char op, const char *xpath, const char *arg)
+{
+    int rc = SR_ERR_OK;
+    struct ly_set *set = NULL, *sibling_set = NULL;
+    struct lyd_node *node = NULL, *first = NULL;
+
+    if (DM_JOURNAL_OP_SET == op) {
+        ly_errno = LY_SUCCESS;
+        node = lyd_new_path(*data_tree, ly_ctx, xpath, (void *)arg, 0, LYD_PATH_OPT_UPDATE);
+        if (NULL == node && LY_SUCCESS != ly_errno) {
+            SR_LOG_ERR("Failed to replay creation of %s: %s", xpath, ly_errmsg(ly_ctx));
+            return SR_ERR_INTERNAL;
+        }
+        if (NULL == *data_tree) {
+            *data_tree = node;
+        }
+        return rc;
+    }
+
+    if (NULL == *data_tree || NULL == (set = lyd_find_path(*data_tree, xpath)) || 0 == set->number) {
+        SR_LOG_DBG("Node %s of journal operation not found", xpath);
+        goto cleanup;
+    }
+    node = set->set.d[0];
+
+    if (DM_JOURNAL_OP_DELETE == op) {
+        if (*data_tree == node) {
+            *data_tree = node->next;
+        }
+        lyd_free(node);
+    } else if (NULL != arg) {
+        sibling_set = lyd_find_path(*data_tree, arg);
+        if (NULL != sibling_set && 1 == sibling_set->number && node != sibling_set->set.d[0]) {
+            if (0 != lyd_insert_after(sibling_set->set.d[0], node)) {
+                SR_LOG_ERR("Failed to replay move of %s: %s", xpath, ly_errmsg(ly_ctx));
+                rc = SR_ERR_INTERNAL;
+            }
+        }
+    } else {
+        /* move to the first position among the instances of the node */
+        first = NULL != node->parent ? node->parent->child : *data_tree;
+        while (NULL != first && first->schema != node->schema) {
+            first = first->next;
+        }
+        if (NULL != first && first != node && 0 != lyd_insert_before(first, node)) {
+            SR_LOG_ERR("Failed to replay move of %s: %s", xpath, ly_errmsg(ly_ctx));
+            rc = SR_ERR_INTERNAL;
+        }
+    }
+    dm_journal_tree_rewind(data_tree);
+
+cleanup:
+    ly_set_free(set);
+    ly_set_free(sibling_set);
+    return rc;
+}
+
+/**
+ * @brief Replays the journal of changes of the data file onto the data tree parsed from it.
+ * Only the records completely written by a commit are applied. A journal that was written for another
+ * instance of the data file (the file has been replaced or rewritten since) is ignored.
+ *
+ * @param [in] fd opened data file
+ * @param [in] data_filename
+ * @param [in] ly_ctx context of the data tree
+ * @param [in,out] data_tree
+ * @return Error code (SR_ERR_OK on success)
+ */
+static int
+dm_journal_replay(int fd, const char *data_filename, struct ly_ctx *ly_ctx, struct lyd_node **data_tree)
+{
+    int rc = SR_ERR_OK;
+    int journal_fd = -1;
+    char *journal_filename = NULL, *content = NULL;
+    char *xpath = NULL, *arg = NULL;
+    const char *pos = NULL, *record = NULL, *end = NULL;
+    char op = 0;
+    struct stat st = {0}, journal_st = {0};
+    size_t len = 0, record_cnt = 0, header_len = 0;
+    ssize_t ret = 0;
+
+    rc = dm_journal_file_name(data_filename, &journal_filename);
+    CHECK_RC_MSG_RETURN(rc, "Failed to get journal file name");
+
+    journal_fd = open(journal_filename, O_RDONLY);
+    if (-1 == journal_fd) {
+        if (ENOENT != errno) {
+            SR_LOG_ERR("Failed to open journal %s: %s", journal_filename, sr_strerror_safe(errno));
+            rc = SR_ERR_IO;
+        }
+        goto cleanup;
+    }
+
+    if (-1 == fstat(fd, &st) || -1 == fstat(journal_fd, &journal_st)) {
+        SR_LOG_ERR("Failed to stat journal %s: %s", journal_filename, sr_strerror_safe(errno));
+        rc = SR_ERR_IO;
+        goto cleanup;
+    }
+
+    if (0 == journal_st.st_size) {
+        /* empty journal, there are no changes to be applied */
+        goto cleanup;
+    }
+
+    content = malloc(journal_st.st_size + 1);
+    CHECK_NULL_NOMEM_GOTO(content, rc, cleanup);
+    while (len < (size_t)journal_st.st_size) {
+        ret = read(journal_fd, content + len, journal_st.st_size - len);
+        if (-1 == ret && EINTR == errno) {
+            continue;
+        }
+        if (ret <= 0) {
+            break;
+        }
+        len += ret;
+    }
+    content[len] = '\0';
+    end = content + len;
+
+    if (!dm_journal_header_matches(content, fd, &st, &header_len)) {
+        SR_LOG_DBG("Journal %s does not belong to the current data file, ignoring it", journal_filename);
+        goto cleanup;
+    }
+    pos = content + header_len;
+
+    while (pos < end) {
+        /* check that the record is complete */
+        record = pos;
+        do {
+            rc = dm_journal_parse_op(&pos, end, &op, &xpath, &arg);
+            free(xpath);
+            free(arg);
+        } while (SR_ERR_OK == rc && DM_JOURNAL_OP_COMMIT != op);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_WRN("Incomplete record at the end of journal %s is ignored", journal_filename);
+            rc = SR_ERR_OK;
+            break;
+        }
+
+        /* apply it */
+        pos = record;
+        do {
+            rc = dm_journal_parse_op(&pos, end, &op, &xpath, &arg);
+            if (SR_ERR_OK == rc && DM_JOURNAL_OP_COMMIT != op) {
+                rc = dm_journal_apply_op(ly_ctx, data_tree, op, xpath, arg);
+            }
+            free(xpath);
+            free(arg);
+        } while (SR_ERR_OK == rc && DM_JOURNAL_OP_COMMIT != op);
+        CHECK_RC_LOG_GOTO(rc, cleanup, "Replay of journal %s failed", journal_filename);
+        ++record_cnt;
+    }
+    SR_LOG_DBG("%zu records of journal %s replayed", record_cnt, journal_filename);
+
+cleanup:
+    if (-1 != journal_fd) {
+        close(journal_fd);
+    }
+    free(content);
+    free(journal_filename);
+    return rc;
+}
+
+/**
+ * @brief Appends the changes made by the commit to the journal of the running data file of the module
+ * instead of rewriting the whole file. The modification time of the data file is updated so that
+ * the other processes notice the change. A journal left behind for another instance of the data file
+ * (e.g. by a crash right after the data file was rewritten) is restarted.
+ *
+ * @param [in] c_ctx commit context
+ * @param [in] merged_info data tree to be written
+ * @param [in] fd opened (and write-locked) data file
+ * @param [in] file_name path of the data file
+ * @param [out] created set to true if the journal file was created
+ * @return Error code (SR_ERR_OK if the changes were journaled), the whole data file has
+ * to be written otherwise
+ */
+static int
+dm_journal_commit_write(dm_commit_context_t *c_ctx, dm_data_info_t *merged_info, int fd, const char *file_name,
+        bool *created)
+{
+    int rc = SR_ERR_OK;
+    int journal_fd = -1;
+    char *journal_filename = NULL;
+    char header[DM_JOURNAL_HEADER_MAX_LEN + 1] = {0};
+    dm_journal_buf_t buf = {0};
+    dm_data_info_t lookup_info = {0}, *prev_info = NULL;
+    dm_model_subscription_t lookup_subscription = {0}, *ms = NULL;
+    struct lyd_difflist *diff = NULL, *own_diff = NULL;
+    struct stat st = {0}, journal_st = {0};
+    size_t written = 0, header_len = 0, len = 0;
+    unsigned long long hash = 0;
+    ssize_t ret = 0;
+
+    if (0 == SR_RUNNING_JOURNAL_SIZE || SR_DS_RUNNING != c_ctx->session->datastore ||
+            NULL != merged_info->required_modules || merged_info->schema->has_instance_id) {
+        return SR_ERR_UNSUPPORTED;
+    }
+    if (0 == strcmp("ietf-netconf-acm", merged_info->schema->module_name)) {
+        /* NACM configuration is reloaded directly from the data file */
+        return SR_ERR_UNSUPPORTED;
+    }
+
+    /* reuse the differences computed for the subscribers */
+    lookup_info.schema = merged_info->schema;
+    prev_info = sr_btree_search(c_ctx->prev_data_trees, &lookup_info);
+    if (NULL == prev_info) {
+        return SR_ERR_UNSUPPORTED;
+    }
+    lookup_subscription.schema_info = merged_info->schema;
+    if (NULL != c_ctx->subscriptions) {
+        ms = sr_btree_search(c_ctx->subscriptions, &lookup_subscription);
+    }
+    if (NULL != ms && NULL != ms->difflist) {
+        diff = ms->difflist;
+    } else {
+        diff = own_diff = lyd_diff(prev_info->node, merged_info->node, LYD_DIFFOPT_WITHDEFAULTS);
+        if (NULL == diff) {
+            return SR_ERR_UNSUPPORTED;
+        }
+    }
+
+    rc = dm_journal_record_from_diff(diff, &buf);
+    if (SR_ERR_OK != rc || 0 == buf.len) {
+        goto cleanup;
+    }
+
+    rc = dm_journal_file_name(file_name, &journal_filename);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to get journal file name");
+
+    journal_fd = open(journal_filename, O_RDWR | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR);
+    if (-1 == journal_fd || -1 == fstat(journal_fd, &journal_st) || -1 == fstat(fd, &st)) {
+        SR_LOG_WRN("Failed to open journal %s: %s", journal_filename, sr_strerror_safe(errno));
+        rc = SR_ERR_IO;
+        goto cleanup;
+    }
+
+    if (0 != journal_st.st_size) {
+        /* the records can be appended only if the journal belongs to the current content of the data file */
+        do {
+            ret = pread(journal_fd, header + len, DM_JOURNAL_HEADER_MAX_LEN - len, len);
+            len += (ret > 0 ? ret : 0);
+        } while ((ret > 0 || (-1 == ret && EINTR == errno)) && len < DM_JOURNAL_HEADER_MAX_LEN);
+        header[len] = '\0';
+        if (!dm_journal_header_matches(header, fd, &st, &header_len)) {
+            SR_LOG_DBG("Journal %s does not belong to the current data file, restarting it", journal_filename);
+            if (-1 == ftruncate(journal_fd, 0)) {
+                SR_LOG_WRN("Failed to truncate journal %s: %s", journal_filename, sr_strerror_safe(errno));
+                rc = SR_ERR_IO;
+                goto cleanup;
+            }
+            journal_st.st_size = 0;
+        }
+        header_len = 0;
+    }
+
+    if (0 == journal_st.st_size) {
+        /* new journal, it has the same owner and access rights as the data file */
+        if (-1 == fchown(journal_fd, st.st_uid, st.st_gid) || -1 == fchmod(journal_fd, st.st_mode & 07777)) {
+            SR_LOG_DBG("Ownership of journal %s can not be set: %s", journal_filename, sr_strerror_safe(errno));
+            rc = SR_ERR_IO;
+            goto cleanup;
+        }
+        rc = dm_data_file_hash(fd, &hash);
+        if (SR_ERR_OK != rc) {
+            goto cleanup;
+        }
+        header_len = snprintf(header, sizeof header, DM_JOURNAL_HEADER, (unsigned long long)st.st_ino,
+                (unsigned long long)st.st_size, hash);
+        *created = true;
+    }
+
+    if ((size_t)journal_st.st_size + header_len + buf.len > SR_RUNNING_JOURNAL_SIZE * 1024) {
+        SR_LOG_DBG("Journal %s exceeded its size limit, it is folded into the data file", journal_filename);
+        rc = SR_ERR_UNSUPPORTED;
+        goto cleanup;
+    }
+
+    while (written < header_len + buf.len) {
+        if (written < header_len) {
+            ret = write(journal_fd, header + written, header_len - written);
+        } else {
+            ret = write(journal_fd, buf.data + written - header_len, buf.len - written + header_len);
+        }
+        if (-1 == ret && EINTR == errno) {
+            continue;
+        }
+        if (ret <= 0) {
+            break;
+        }
+        written += ret;
+    }
+    if (written != header_len + buf.len || -1 == fsync(journal_fd)) {
+        SR_LOG_ERR("Failed to append to journal %s: %s", journal_filename, sr_strerror_safe(errno));
+        /* drop the incomplete record */
+        if (-1 == ftruncate(journal_fd, journal_st.st_size)) {
+            SR_LOG_WRN("Failed to truncate journal %s", journal_filename);
+        }
+        rc = SR_ERR_IO;
+        goto cleanup;
+    }
+
+    /* data file readers check its modification time */
+    if (-1 == futimens(fd, NULL)) {
+        SR_LOG_WRN("Failed to update modification time of %s: %s", file_name, sr_strerror_safe(errno));
+    }
+    SR_LOG_DBG("Changes of module '%s' appended to the journal", merged_info->schema->module_name);
+
+cleanup:
+    if (-1 != journal_fd) {
+        close(journal_fd);
+    }
+    if (SR_ERR_OK != rc && *created) {
+        unlink(journal_filename);
+        *created = false;
+    }
+    lyd_free_diff(own_diff);
+    free(buf.data);
+    free(journal_filename);
+    return rc;
+}
+
+/**
+ * @brief Tries to load data tree from provided opened file.
+ * @param [in] dm_ctx
+ * @param [in] fd to be read from, function does not close it
+ * If NULL passed data info with empty data will be created
+ * @param [in] schema_info
+ * @param [in] data_info
+ * @return Error code (SR_ERR_OK on success)
+ */
+static int
+dm_load_data_tree_file(dm_ctx_t *dm_ctx, int fd, const char *data_filename, dm_schema_info_t *schema_info, dm_data_info_t **data_info)
+{
+    CHECK_NULL_ARG4(dm_ctx, schema_info, data_filename, data_info);
+    int rc = SR_ERR_OK;
+    struct lyd_node *data_tree = NULL, *elem = NULL, *iter = NULL;
+    *data_info = NULL;
+
+    dm_data_info_t *data = NULL;
+    data = calloc(1, sizeof(*data));
+    CHECK_NULL_NOMEM_RETURN(data);
+
+    if (-1 != fd) {
+#ifdef HAVE_STAT_ST_MTIM
+        struct stat st = {0};
+        rc = stat(data_filename, &st);
+        if (-1 == rc) {
+            SR_LOG_ERR_MSG("Stat failed");
+            free(data);
+            return SR_ERR_INTERNAL;
+        }
+        data->timestamp = st.st_mtim;
+        SR_LOG_DBG("Loaded module %s: mtime sec=%lld nsec=%lld", schema_info->module->name,
+                (long long) st.st_mtim.tv_sec,
+                (long long) st.st_mtim.tv_nsec);
+#endif
+        if (schema_info->has_instance_id) {
+            struct lyd_node *tmp_node = NULL;
+            dm_tmp_ly_ctx_t *tmp_ctx = NULL;
+
+            rc = dm_get_tmp_ly_ctx(dm_ctx, NULL, &tmp_ctx);
+            if (rc != SR_ERR_OK) {
+                SR_LOG_ERR_MSG("Failed to create temporary context.");
+                free(data);
+                return rc;
+            }
+            md_ctx_lock(dm_ctx->md_ctx, false);
+            ly_ctx_set_module_data_clb(tmp_ctx->ctx, dm_module_clb, dm_ctx);
+
+            ly_errno = LY_SUCCESS;
+            tmp_node = lyd_parse_fd(tmp_ctx->ctx, fd, sr_data_file_format(fd), LYD_OPT_TRUSTED | LYD_OPT_CONFIG);
+            md_ctx_unlock(dm_ctx->md_ctx);
+
+            if (NULL == tmp_node && LY_SUCCESS != ly_errno) {
+                SR_LOG_ERR("Parsing data tree from file %s failed: %s", data_filename, ly_errmsg(tmp_ctx->ctx));
+                free(data);
+                return SR_ERR_INTERNAL;
+            }
+
+            dm_remove_added_data_trees_by_module_name(schema_info->module_name, &tmp_node);
+
+            if (NULL != tmp_node) {
+                data_tree = sr_dup_datatree_to_ctx(tmp_node, schema_info->ly_ctx);
+            }
+            lyd_free_withsiblings(tmp_node);
+            dm_release_tmp_ly_ctx(dm_ctx, tmp_ctx);
+        } else {
+            ly_errno = LY_SUCCESS;
+            /* use LYD_OPT_TRUSTED, validation will be done later */
+            data_tree = lyd_parse_fd(schema_info->ly_ctx, fd, sr_data_file_format(fd), LYD_OPT_TRUSTED | LYD_OPT_CONFIG);
+            if (NULL == data_tree && LY_SUCCESS != ly_errno) {
+                SR_LOG_ERR("Parsing data tree from file %s failed: %s", data_filename, ly_errmsg(schema_info->ly_ctx));
+                free(data);
+                return SR_ERR_INTERNAL;
+            }
+        }
+
+        /* apply the changes committed since the data file was written */
+        rc = dm_journal_replay(fd, data_filename, schema_info->ly_ctx, &data_tree);
+        if (SR_ERR_OK != rc) {
+            lyd_free_withsiblings(data_tree);
+            free(data);
+            return rc;
+        }
+    }
+
+    /* if there is no data dependency validate it with of LYD_OPT_STRICT, validate it (only non-empty data trees are validated)*/
+    if (!schema_info->cross_module_data_dependency && !schema_info->has_instance_id) {
         if (NULL != data_tree) {
             rc = lyd_validate(&data_tree, LYD_OPT_STRICT | LYD_OPT_CONFIG, schema_info->ly_ctx);
             if (rc) {
@@ -1306,9 +2402,157 @@ dm_load_data_tree_file(dm_ctx_t *dm_ctx, int fd, const char *data_filename, dm_s
     return rc;
 }
 
+/**
+ * @brief Decides whether the data trees of the module can be served from the shared data cache.
+ * The cache is used only in daemon mode where all the writes of data files go through this process,
+ * so the generation numbers are authoritative. Modules whose data depend on other modules are
+ * validated in the context of each session and they are not cached.
+ */
+static bool
+dm_data_cache_enabled(dm_ctx_t *dm_ctx, dm_schema_info_t *schema_info)
+{
+    return CM_MODE_DAEMON == dm_ctx->conn_mode && !schema_info->cross_module_data_dependency && !schema_info->has_instance_id;
+}
+
+/**
+ * @brief Returns the data info referencing the cached snapshot of the data file. If there is no
+ * snapshot for the current generation of the file, the file is parsed and the result is offered to the cache.
+ *
+ * @note Function expects that a schema info is locked for reading.
+ *
+ * @param [in] dm_ctx
+ * @param [in] fd to be read from in case of cache miss, function does not close it
+ * @param [in] data_filename
+ * @param [in] schema_info
+ * @param [in] ds
+ * @param [out] data_info read-only data info, use ::dm_data_info_make_writable before modification
+ * @return Error code (SR_ERR_OK on success)
+ */
+static int
+dm_load_data_tree_cached(dm_ctx_t *dm_ctx, int fd, const char *data_filename, dm_schema_info_t *schema_info,
+        sr_datastore_t ds, dm_data_info_t **data_info)
+{
+    CHECK_NULL_ARG4(dm_ctx, data_filename, schema_info, data_info);
+    int rc = SR_ERR_OK;
+    dm_data_snapshot_t *snapshot = NULL;
+    dm_data_info_t *di = NULL;
+    uint32_t generation = 0;
+
+    pthread_mutex_lock(&schema_info->data_cache_mutex);
+    generation = schema_info->generation[ds];
+    snapshot = schema_info->data_cache[ds];
+    if (NULL != snapshot) {
+        snapshot->ref_count++;
+    }
+    pthread_mutex_unlock(&schema_info->data_cache_mutex);
+
+    if (NULL != snapshot) {
+        di = calloc(1, sizeof(*di));
+        if (NULL == di) {
+            dm_data_snapshot_release(schema_info, snapshot);
+            CHECK_NULL_NOMEM_RETURN(di);
+        }
+        di->rdonly_copy = true;
+        di->snapshot = snapshot;
+        di->schema = schema_info;
+        di->node = snapshot->node;
+        di->timestamp = snapshot->timestamp;
+        di->generation = snapshot->generation;
+
+        pthread_mutex_lock(&schema_info->usage_count_mutex);
+        schema_info->usage_count++;
+        SR_LOG_DBG("Usage count %s incremented (value=%zu)", schema_info->module_name, schema_info->usage_count);
+        pthread_mutex_unlock(&schema_info->usage_count_mutex);
+
+        SR_LOG_DBG("Data file %s served from the data cache (generation %"PRIu32")", data_filename, generation);
+        *data_info = di;
+        return rc;
+    }
+
+    /* cache miss, parse the file */
+    rc = dm_load_data_tree_file(dm_ctx, fd, data_filename, schema_info, &di);
+    CHECK_RC_LOG_RETURN(rc, "Loading of data file %s failed", data_filename);
+    di->generation = generation;
+
+    snapshot = calloc(1, sizeof(*snapshot));
+    if (NULL == snapshot) {
+        /* not fatal, the session keeps a private copy */
+        SR_LOG_WRN("Unable to cache data file %s", data_filename);
+        *data_info = di;
+        return rc;
+    }
+    snapshot->node = di->node;
+    snapshot->generation = generation;
+    snapshot->timestamp = di->timestamp;
+    snapshot->ref_count = 1;
+    di->snapshot = snapshot;
+    di->rdonly_copy = true;
+
+    pthread_mutex_lock(&schema_info->data_cache_mutex);
+    /* the file might have been rewritten while it was parsed */
+    if (generation == schema_info->generation[ds] && NULL == schema_info->data_cache[ds]) {
+        schema_info->data_cache[ds] = snapshot;
+        snapshot->ref_count++;
+    }
+    pthread_mutex_unlock(&schema_info->data_cache_mutex);
+
+    *data_info = di;
+    return rc;
+}
+
+/**
+ * @brief Loads a private copy of the data tree from the provided opened file. If the data cache is enabled
+ * for the module, the copy is duplicated from the cached snapshot instead of parsing the file.
+ *
+ * @note Function expects that a schema info is locked for reading.
+ */
+static int
+dm_load_data_tree_writable(dm_ctx_t *dm_ctx, int fd, const char *data_filename, dm_schema_info_t *schema_info,
+        sr_datastore_t ds, dm_data_info_t **data_info)
+{
+    CHECK_NULL_ARG2(schema_info, data_info);
+    int rc = SR_ERR_OK;
+
+    if (!dm_data_cache_enabled(dm_ctx, schema_info)) {
+        return dm_load_data_tree_file(dm_ctx, fd, data_filename, schema_info, data_info);
+    }
+
+    rc = dm_load_data_tree_cached(dm_ctx, fd, data_filename, schema_info, ds, data_info);
+    CHECK_RC_LOG_RETURN(rc, "Loading of data file %s failed", data_filename);
+
+    rc = dm_data_info_make_writable(*data_info);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_ERR("Duplication of the shared data tree %s failed", schema_info->module_name);
+        dm_data_info_free(*data_info);
+        *data_info = NULL;
+    }
+    return rc;
+}
+
+/**
+ * @brief Checks whether the data file opened as \p fd has been replaced in the meantime.
+ * Commit writes the new content into a temporary file that is renamed over the original one,
+ * a reader that opened the file before the rename would read the outdated content.
+ *
+ * @param [in] fd opened data file
+ * @param [in] file_name path of the data file
+ * @return True if \p file_name refers to a different file than \p fd
+ */
+static bool
+dm_data_file_replaced(int fd, const char *file_name)
+{
+    struct stat fd_st = {0}, file_st = {0};
+
+    if (-1 == fstat(fd, &fd_st) || -1 == stat(file_name, &file_st)) {
+        return false;
+    }
+    return fd_st.st_ino != file_st.st_ino || fd_st.st_dev != file_st.st_dev;
+}
+
 /**
  * @brief Loads data tree from file. Module and datastore argument are used to
- * determine the file name.
+ * determine the file name. If the data cache is enabled for the module, returned data info
+ * may reference a shared snapshot, use ::dm_data_info_make_writable before modification.
  *
  * @note Function expects that a schema info is locked for reading.
  *
@@ -1325,29 +2569,53 @@ dm_load_data_tree(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx, dm_schema_info
     CHECK_NULL_ARG4(dm_ctx, schema_info, schema_info->module, schema_info->module->name);
 
     char *data_filename = NULL;
+    uint32_t generation = 0;
     int rc = 0;
     *data_info = NULL;
     rc = sr_get_data_file_name(dm_ctx->data_search_dir, schema_info->module->name, ds, &data_filename);
     CHECK_RC_LOG_RETURN(rc, "Get data_filename failed for %s", schema_info->module->name);
 
-    ac_set_user_identity(dm_ctx->ac_ctx, dm_session_ctx->user_credentials);
+    int fd = -1;
+    do {
+        if (-1 != fd) {
+            /* the file was replaced by a commit while waiting for the lock, open the new one */
+            sr_unlock_fd(fd);
+            close(fd);
+        }
+
+        ac_set_user_identity(dm_ctx->ac_ctx, dm_session_ctx->user_credentials);
 
-    int fd = open(data_filename, O_RDONLY);
+        fd = open(data_filename, O_RDONLY);
 
-    ac_unset_user_identity(dm_ctx->ac_ctx, dm_session_ctx->user_credentials);
+        ac_unset_user_identity(dm_ctx->ac_ctx, dm_session_ctx->user_credentials);
 
-    if (-1 != fd) {
-        /* lock, read-only, blocking */
-        sr_lock_fd(fd, false, true);
-    } else if (ENOENT == errno) {
+        if (-1 != fd) {
+            /* lock, read-only, blocking */
+            sr_lock_fd(fd, false, true);
+        }
+    } while (-1 != fd && dm_data_file_replaced(fd, data_filename));
+
+    if (-1 == fd && ENOENT == errno) {
         SR_LOG_DBG("Data file %s does not exist, creating empty data tree", data_filename);
-    } else if (EACCES == errno) {
+    } else if (-1 == fd && EACCES == errno) {
         SR_LOG_DBG("Data file %s can't be read because of access rights", data_filename);
         free(data_filename);
         return SR_ERR_UNAUTHORIZED;
     }
 
-    rc = dm_load_data_tree_file(dm_ctx, fd, data_filename, schema_info, data_info);
+    /* the file is opened even in case of cache hit to enforce the access rights of the user */
+    if (dm_data_cache_enabled(dm_ctx, schema_info)) {
+        rc = dm_load_data_tree_cached(dm_ctx, fd, data_filename, schema_info, ds, data_info);
+    } else {
+        pthread_mutex_lock(&schema_info->data_cache_mutex);
+        generation = schema_info->generation[ds];
+        pthread_mutex_unlock(&schema_info->data_cache_mutex);
+
+        rc = dm_load_data_tree_file(dm_ctx, fd, data_filename, schema_info, data_info);
+        if (SR_ERR_OK == rc) {
+            (*data_info)->generation = generation;
+        }
+    }
 
     if (-1 != fd) {
         sr_unlock_fd(fd);
@@ -1963,7 +3231,7 @@ dm_append_data_tree(dm_ctx_t *dm_ctx, dm_session_t *session, dm_data_info_t *dat
     dm_data_info_t *di = NULL;
     bool must_be_freed = false;
 
-    rc = dm_get_data_info_internal(dm_ctx, session, module_name, true, &must_be_freed, &di);
+    rc = dm_get_data_info_internal(dm_ctx, session, module_name, true, true, &must_be_freed, &di);
     CHECK_RC_LOG_RETURN(rc, "Get data info failed for module %s", module_name);
 
     /* transform data from one ctx to another */
@@ -2061,12 +3329,324 @@ dm_load_dependant_data(dm_ctx_t *dm_ctx, dm_session_t *session, dm_data_info_t *
                 CHECK_RC_LOG_GOTO(rc, unlock, "Failed to append data tree %s", dependant_module);
                 SR_LOG_DBG("Data tree %s appended because of validation", dependant_module);
             }
-            ll_node = ll_node->next;
+            ll_node = ll_node->next;
+        }
+unlock:
+        md_ctx_unlock(dm_ctx->md_ctx);
+    }
+    return rc;
+}
+
+/**
+ * @brief Adds the module into the warm-up list if it is an installed and implemented
+ * module (not a submodule) which is not in the list yet.
+ */
+static int
+dm_warmup_add_module(dm_ctx_t *dm_ctx, dm_warmup_t *warmup, const char *module_name)
+{
+    md_module_t *module = NULL;
+    char *name = NULL;
+    int rc = SR_ERR_OK;
+
+    if ('\0' == module_name[0]) {
+        return SR_ERR_OK;
+    }
+    for (size_t i = 0; i < warmup->modules->count; ++i) {
+        if (0 == strcmp(warmup->modules->data[i], module_name)) {
+            return SR_ERR_OK;
+        }
+    }
+
+    md_ctx_lock(dm_ctx->md_ctx, false);
+    rc = md_get_module_info(dm_ctx->md_ctx, module_name, NULL, NULL, &module);
+    md_ctx_unlock(dm_ctx->md_ctx);
+    if (SR_ERR_OK != rc || module->submodule || !module->implemented) {
+        SR_LOG_DBG("Module '%s' skipped by the warm-up, it is not installed.", module_name);
+        return SR_ERR_OK;
+    }
+
+    name = strdup(module_name);
+    CHECK_NULL_NOMEM_RETURN(name);
+    rc = sr_list_add(warmup->modules, name);
+    if (SR_ERR_OK != rc) {
+        free(name);
+    }
+    return rc;
+}
+
+/**
+ * @brief Fills the list of modules to be warmed-up: from the SR_WARMUP_MODULES_ENV environment
+ * variable if set, otherwise from the modules that were loaded during the last run of the engine.
+ */
+static int
+dm_warmup_load_list(dm_ctx_t *dm_ctx, dm_warmup_t *warmup)
+{
+    const char *env_str = NULL;
+    char *list = NULL, *module_name = NULL, *saveptr = NULL;
+    char line[PATH_MAX] = { 0, };
+    FILE *fp = NULL;
+    int rc = SR_ERR_OK;
+
+    env_str = getenv(SR_WARMUP_MODULES_ENV);
+    if (NULL != env_str) {
+        list = strdup(env_str);
+        CHECK_NULL_NOMEM_RETURN(list);
+        for (module_name = strtok_r(list, ", ", &saveptr); SR_ERR_OK == rc && NULL != module_name;
+                module_name = strtok_r(NULL, ", ", &saveptr)) {
+            rc = dm_warmup_add_module(dm_ctx, warmup, module_name);
+        }
+        free(list);
+        return rc;
+    }
+
+    fp = fopen(warmup->list_filepath, "r");
+    if (NULL == fp) {
+        SR_LOG_DBG("No modules to warm-up recorded in %s.", warmup->list_filepath);
+        return SR_ERR_OK;
+    }
+    while (SR_ERR_OK == rc && NULL != fgets(line, sizeof line, fp)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        rc = dm_warmup_add_module(dm_ctx, warmup, line);
+    }
+    fclose(fp);
+    return rc;
+}
+
+/**
+ * @brief Records the names of all currently loaded modules, so that they can be warmed-up
+ * when the engine starts next time.
+ */
+static void
+dm_warmup_save_list(dm_ctx_t *dm_ctx, dm_warmup_t *warmup)
+{
+    dm_schema_info_t *si = NULL;
+    char *tmp_filepath = NULL;
+    FILE *fp = NULL;
+    size_t i = 0;
+    bool ok = true;
+
+    if (SR_ERR_OK != sr_str_join(warmup->list_filepath, SR_TMP_FILE_EXT, &tmp_filepath)) {
+        return;
+    }
+    fp = fopen(tmp_filepath, "w");
+    if (NULL == fp) {
+        SR_LOG_WRN("Unable to record the modules to warm-up into %s: %s", tmp_filepath, sr_strerror_safe(errno));
+        free(tmp_filepath);
+        return;
+    }
+
+    pthread_rwlock_rdlock(&dm_ctx->schema_tree_lock);
+    while (ok && NULL != (si = sr_btree_get_at(dm_ctx->schema_info_tree, i++))) {
+        if (NULL != si->ly_ctx) {
+            ok = (0 <= fprintf(fp, "%s\n", si->module_name));
+        }
+    }
+    pthread_rwlock_unlock(&dm_ctx->schema_tree_lock);
+
+    if (0 != fclose(fp)) {
+        ok = false;
+    }
+    if (!ok || -1 == rename(tmp_filepath, warmup->list_filepath)) {
+        SR_LOG_WRN("Unable to record the modules to warm-up into %s.", warmup->list_filepath);
+        unlink(tmp_filepath);
+    }
+    free(tmp_filepath);
+}
+
+/**
+ * @brief Body of a warm-up thread, loads modules from the warm-up list until all of them are loaded
+ * or the Data Manager is being cleaned up.
+ */
+static void *
+dm_warmup_thread_execute(void *dm_ctx_p)
+{
+    dm_ctx_t *dm_ctx = (dm_ctx_t *)dm_ctx_p;
+    dm_warmup_t *warmup = dm_ctx->warmup;
+    dm_schema_info_t *si = NULL;
+    const char *module_name = NULL;
+    int rc = SR_ERR_OK;
+
+    while (true) {
+        pthread_mutex_lock(&warmup->mutex);
+        if (warmup->stop_requested || warmup->next >= warmup->modules->count) {
+            pthread_mutex_unlock(&warmup->mutex);
+            break;
+        }
+        module_name = warmup->modules->data[warmup->next++];
+        pthread_mutex_unlock(&warmup->mutex);
+
+        rc = dm_get_module_without_lock(dm_ctx, module_name, &si);
+        if (SR_ERR_OK == rc) {
+            SR_LOG_DBG("Module '%s' has been warmed-up.", module_name);
+        } else {
+            SR_LOG_WRN("Warm-up of module '%s' failed: %s.", module_name, sr_strerror(rc));
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Starts the background warm-up of the frequently used modules.
+ * Failures are not fatal, the modules will be loaded on the first use instead.
+ */
+static void
+dm_warmup_start(dm_ctx_t *dm_ctx, const char *internal_data_search_dir)
+{
+    dm_warmup_t *warmup = NULL;
+    size_t thread_count = SR_WARMUP_THREAD_COUNT;
+    int rc = SR_ERR_OK;
+
+    if (0 == thread_count) {
+        return;
+    }
+
+    warmup = calloc(1, sizeof *warmup);
+    CHECK_NULL_NOMEM_GOTO(warmup, rc, cleanup);
+    pthread_mutex_init(&warmup->mutex, NULL);
+    rc = sr_list_init(&warmup->modules);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to initialize a list");
+    rc = sr_path_join(internal_data_search_dir, SR_WARMUP_MODULES_FILENAME, &warmup->list_filepath);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to compose the path of the warm-up list");
+
+    rc = dm_warmup_load_list(dm_ctx, warmup);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to load the list of modules to warm-up");
+
+    if (thread_count > warmup->modules->count) {
+        thread_count = warmup->modules->count;
+    }
+    if (thread_count > 0) {
+        warmup->threads = calloc(thread_count, sizeof *warmup->threads);
+        CHECK_NULL_NOMEM_GOTO(warmup->threads, rc, cleanup);
+    }
+
+    /* threads access the warm-up through the context */
+    dm_ctx->warmup = warmup;
+    for (warmup->thread_count = 0; warmup->thread_count < thread_count; ++warmup->thread_count) {
+        if (0 != pthread_create(&warmup->threads[warmup->thread_count], NULL, dm_warmup_thread_execute, dm_ctx)) {
+            SR_LOG_WRN("Unable to create a warm-up thread: %s", sr_strerror_safe(errno));
+            break;
+        }
+    }
+    SR_LOG_INF("Warming-up %zu modules using %zu threads.", warmup->modules->count, warmup->thread_count);
+    return;
+
+cleanup:
+    SR_LOG_WRN_MSG("Warm-up of the modules will not be performed.");
+    if (NULL != warmup) {
+        sr_free_list_of_strings(warmup->modules);
+        free(warmup->list_filepath);
+        pthread_mutex_destroy(&warmup->mutex);
+        free(warmup);
+    }
+}
+
+/**
+ * @brief Stops the warm-up threads, records the currently loaded modules for the next start
+ * and releases the warm-up resources.
+ */
+static void
+dm_warmup_cleanup(dm_ctx_t *dm_ctx)
+{
+    dm_warmup_t *warmup = dm_ctx->warmup;
+
+    if (NULL == warmup) {
+        return;
+    }
+
+    pthread_mutex_lock(&warmup->mutex);
+    warmup->stop_requested = true;
+    pthread_mutex_unlock(&warmup->mutex);
+    for (size_t i = 0; i < warmup->thread_count; ++i) {
+        pthread_join(warmup->threads[i], NULL);
+    }
+
+    if (NULL != dm_ctx->schema_info_tree) {
+        dm_warmup_save_list(dm_ctx, warmup);
+    }
+
+    dm_ctx->warmup = NULL;
+    sr_free_list_of_strings(warmup->modules);
+    free(warmup->list_filepath);
+    free(warmup->threads);
+    pthread_mutex_destroy(&warmup->mutex);
+    free(warmup);
+}
+
+int
+dm_warmup_wait(dm_ctx_t *dm_ctx, const sr_list_t **modules)
+{
+    CHECK_NULL_ARG2(dm_ctx, modules);
+    dm_warmup_t *warmup = dm_ctx->warmup;
+
+    if (NULL == warmup) {
+        return SR_ERR_NOT_FOUND;
+    }
+
+    for (size_t i = 0; i < warmup->thread_count; ++i) {
+        pthread_join(warmup->threads[i], NULL);
+    }
+    warmup->thread_count = 0;
+
+    *modules = warmup->modules;
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Removes temporary files left in the data search directory by commits
+ * interrupted by a crash (see ::dm_commit_tmp_file_create). A temporary file is removed
+ * only if the write lock of its data file can be acquired, i.e. no commit is in progress.
+ */
+static void
+dm_remove_stale_tmp_files(dm_ctx_t *dm_ctx)
+{
+    DIR *dir = NULL;
+    struct dirent entry = { 0, }, *result = NULL;
+    char *tmp_filepath = NULL, *data_filepath = NULL;
+    size_t len = 0, suffix_len = strlen(SR_TMP_FILE_EXT "XXXXXX");
+    int fd = -1;
+
+    dir = opendir(dm_ctx->data_search_dir);
+    if (NULL == dir) {
+        SR_LOG_WRN("Failed to open data directory %s: %s", dm_ctx->data_search_dir, sr_strerror_safe(errno));
+        return;
+    }
+
+    while (0 == readdir_r(dir, &entry, &result) && NULL != result) {
+        len = strlen(entry.d_name);
+        if (len <= suffix_len || 0 != strncmp(entry.d_name + len - suffix_len, SR_TMP_FILE_EXT, strlen(SR_TMP_FILE_EXT))) {
+            continue;
+        }
+        if (SR_ERR_OK != sr_str_join(dm_ctx->data_search_dir, entry.d_name, &tmp_filepath)) {
+            break;
+        }
+        data_filepath = strndup(tmp_filepath, strlen(tmp_filepath) - suffix_len);
+        if (NULL == data_filepath) {
+            free(tmp_filepath);
+            break;
+        }
+
+        fd = open(data_filepath, O_RDWR);
+        if (-1 != fd && SR_ERR_OK == sr_lock_fd(fd, true, false)) {
+            SR_LOG_INF("Removing temporary file %s left by an interrupted commit.", tmp_filepath);
+            if (-1 == unlink(tmp_filepath)) {
+                SR_LOG_WRN("Failed to remove %s: %s", tmp_filepath, sr_strerror_safe(errno));
+            }
+            sr_unlock_fd(fd);
+        } else if (-1 == fd && ENOENT == errno) {
+            /* a commit never runs without the data file */
+            SR_LOG_INF("Removing temporary file %s without a data file.", tmp_filepath);
+            unlink(tmp_filepath);
         }
-unlock:
-        md_ctx_unlock(dm_ctx->md_ctx);
+        if (-1 != fd) {
+            close(fd);
+        }
+        free(data_filepath);
+        free(tmp_filepath);
+        data_filepath = tmp_filepath = NULL;
     }
-    return rc;
+
+    closedir(dir);
 }
 
 int
@@ -2137,6 +3717,9 @@ dm_init(ac_ctx_t *ac_ctx, np_ctx_t *np_ctx, pm_ctx_t *pm_ctx, const cm_connectio
                  internal_data_search_dir, false, &ctx->md_ctx);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to initialize Module Dependencies context.");
 
+    /* the data files themselves are always consistent, only temporary files of interrupted commits may remain */
+    dm_remove_stale_tmp_files(ctx);
+
 #ifdef ENABLE_NACM
     if (CM_MODE_DAEMON == conn_mode) {
         rc = nacm_init(ctx, ctx->data_search_dir, &ctx->nacm_ctx);
@@ -2159,6 +3742,11 @@ dm_init(ac_ctx_t *ac_ctx, np_ctx_t *np_ctx, pm_ctx_t *pm_ctx, const cm_connectio
     ctx->tmp_ly_ctx = t_ctx;
     t_ctx = NULL;
 
+    if (CM_MODE_DAEMON == conn_mode) {
+        /* load frequently used modules in the background */
+        dm_warmup_start(ctx, internal_data_search_dir);
+    }
+
     *dm_ctx = ctx;
 
 cleanup:
@@ -2177,6 +3765,7 @@ void
 dm_cleanup(dm_ctx_t *dm_ctx)
 {
     if (NULL != dm_ctx) {
+        dm_warmup_cleanup(dm_ctx);
         nacm_cleanup(dm_ctx->nacm_ctx);
         sr_btree_cleanup(dm_ctx->commit_ctxs.tree);
         free(dm_ctx->schema_search_dir);
@@ -2470,7 +4059,7 @@ dm_requires_tmp_context(dm_ctx_t *dm_ctx, dm_session_t *session, dm_data_info_t
 
                 /* if dep has instanced id and it was inserted call recursively */
                 if (inserted && NULL != dep->dest->inst_ids->first) {
-                    rc = dm_get_data_info_internal(dm_ctx, session, dep->dest->name, true, &must_be_freed, &recursive_info);
+                    rc = dm_get_data_info_internal(dm_ctx, session, dep->dest->name, true, true, &must_be_freed, &recursive_info);
                     CHECK_RC_LOG_GOTO(rc, cleanup, "Get data info failed for %s", dep->dest->name);
 
                     rc = dm_requires_tmp_context(dm_ctx, session, recursive_info, required_data, required_modules);
@@ -2585,7 +4174,7 @@ dm_requires_tmp_context(dm_ctx_t *dm_ctx, dm_session_t *session, dm_data_info_t
 
                         /* if dep has instanced id and it was inserted call recursively */
                         if (inserted && NULL != dep->dest->inst_ids->first) {
-                            rc = dm_get_data_info_internal(dm_ctx, session, dep->dest->name, true, &must_be_freed, &recursive_info);
+                            rc = dm_get_data_info_internal(dm_ctx, session, dep->dest->name, true, true, &must_be_freed, &recursive_info);
                             CHECK_RC_LOG_GOTO(rc, cleanup, "Get data info failed for %s", dep->dest->name);
 
                             rc = dm_requires_tmp_context(dm_ctx, session, recursive_info, required_data, required_modules);
@@ -2612,7 +4201,7 @@ dm_requires_tmp_context(dm_ctx_t *dm_ctx, dm_session_t *session, dm_data_info_t
                     }
 
                     /* call recursively */
-                    rc = dm_get_data_info_internal(dm_ctx, session, inserted_namespace, true, &must_be_freed, &recursive_info);
+                    rc = dm_get_data_info_internal(dm_ctx, session, inserted_namespace, true, true, &must_be_freed, &recursive_info);
                     CHECK_RC_LOG_GOTO(rc, cleanup, "Get data info failed for %s", inserted_namespace);
 
                     rc = dm_requires_tmp_context(dm_ctx, session, recursive_info, required_data, required_modules);
@@ -2703,7 +4292,7 @@ dm_validate_data_info(dm_ctx_t *dm_ctx, dm_session_t *session, dm_data_info_t *i
             /* retrieve all required data */
             for (size_t i = 0; i < required_data->count; i++) {
                 SR_LOG_DBG("To pass the validation of '%s' data from module %s is needed", info->schema->module_name, (char *) required_data->data[i]);
-                rc = dm_get_data_info_internal(dm_ctx, session, (char *) required_data->data[i], true, &should_be_freed[i], &dep_di);
+                rc = dm_get_data_info_internal(dm_ctx, session, (char *) required_data->data[i], true, true, &should_be_freed[i], &dep_di);
                 CHECK_RC_LOG_GOTO(rc, cleanup, "Failed to get data infor for module %s", (char *) required_data->data[i]);
 
                 rc = sr_list_add(data_for_validation, dep_di);
@@ -2771,9 +4360,11 @@ cleanup:
 
 /**
  * @note if skip_validation is false, must_be_freed will not be set to true
+ * @note if rdonly is true, returned data info may reference a shared snapshot that must not be modified
  */
 static int
-dm_get_data_info_internal(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx, const char *module_name, bool skip_validation, bool *must_be_freed, dm_data_info_t **info)
+dm_get_data_info_internal(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx, const char *module_name, bool skip_validation, bool rdonly,
+        bool *must_be_freed, dm_data_info_t **info)
 {
     int rc = SR_ERR_OK;
     dm_data_info_t *exisiting_data_info = NULL;
@@ -2791,6 +4382,10 @@ dm_get_data_info_internal(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx, const
     }
 
     if (NULL != exisiting_data_info) {
+        if (!rdonly) {
+            rc = dm_data_info_make_writable(exisiting_data_info);
+            CHECK_RC_LOG_GOTO(rc, cleanup, "Duplication of the shared data tree %s failed", module_name);
+        }
         *info = exisiting_data_info;
         SR_LOG_DBG("Module %s already loaded", module_name);
         goto cleanup;
@@ -2801,6 +4396,13 @@ dm_get_data_info_internal(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx, const
     if (SR_DS_CANDIDATE == dm_session_ctx->datastore) {
         rc = dm_load_data_tree(dm_ctx, dm_session_ctx, schema_info, SR_DS_RUNNING, &di);
         CHECK_RC_LOG_GOTO(rc, cleanup, "Getting data tree for %s failed.", module_name);
+        /* candidate can not share the running data tree */
+        rc = dm_data_info_make_writable(di);
+        if (SR_ERR_OK != rc) {
+            dm_data_info_free(di);
+            SR_LOG_ERR("Duplication of the shared data tree %s failed", module_name);
+            goto cleanup;
+        }
         rc = dm_remove_not_enabled_nodes(di);
         if (SR_ERR_OK != rc) {
             dm_data_info_free(di);
@@ -2811,6 +4413,14 @@ dm_get_data_info_internal(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx, const
     else {
         rc = dm_load_data_tree(dm_ctx, dm_session_ctx, schema_info, dm_session_ctx->datastore, &di);
         CHECK_RC_LOG_GOTO(rc, cleanup, "Getting data tree for %s failed.", module_name);
+        if (!rdonly) {
+            rc = dm_data_info_make_writable(di);
+            if (SR_ERR_OK != rc) {
+                dm_data_info_free(di);
+                SR_LOG_ERR("Duplication of the shared data tree %s failed", module_name);
+                goto cleanup;
+            }
+        }
     }
 
     if (!skip_validation) {
@@ -2851,7 +4461,7 @@ int
 dm_get_data_info(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx, const char *module_name, dm_data_info_t **info)
 {
     CHECK_NULL_ARG4(dm_ctx, dm_session_ctx, module_name, info);
-    return dm_get_data_info_internal(dm_ctx, dm_session_ctx, module_name, false, NULL, info);
+    return dm_get_data_info_internal(dm_ctx, dm_session_ctx, module_name, false, false, NULL, info);
 }
 
 int
@@ -2860,7 +4470,7 @@ dm_get_datatree(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx, const char *modu
     CHECK_NULL_ARG4(dm_ctx, dm_session_ctx, module_name, data_tree);
     int rc = SR_ERR_OK;
     dm_data_info_t *info = NULL;
-    rc = dm_get_data_info(dm_ctx, dm_session_ctx, module_name, &info);
+    rc = dm_get_data_info_internal(dm_ctx, dm_session_ctx, module_name, false, true, NULL, &info);
     CHECK_RC_LOG_RETURN(rc, "Get data info failed for module %s", module_name);
     *data_tree = info->node;
     if (NULL == info->node) {
@@ -2869,6 +4479,65 @@ dm_get_datatree(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx, const char *modu
     return rc;
 }
 
+int
+dm_get_datatree_snapshot(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx, const char *module_name,
+        dm_schema_info_t **schema_info, dm_data_snapshot_t **snapshot)
+{
+    CHECK_NULL_ARG5(dm_ctx, dm_session_ctx, module_name, schema_info, snapshot);
+    int rc = SR_ERR_OK;
+    dm_data_info_t *info = NULL;
+    dm_data_snapshot_t *snap = NULL;
+
+    rc = dm_get_data_info_internal(dm_ctx, dm_session_ctx, module_name, false, true, NULL, &info);
+    CHECK_RC_LOG_RETURN(rc, "Get data info failed for module %s", module_name);
+    if (NULL == info->node) {
+        return SR_ERR_NOT_FOUND;
+    }
+
+    if (NULL != info->snapshot) {
+        /* the session still shares the snapshot loaded from the data file */
+        snap = info->snapshot;
+        pthread_mutex_lock(&info->schema->data_cache_mutex);
+        snap->ref_count++;
+        pthread_mutex_unlock(&info->schema->data_cache_mutex);
+    } else {
+        /* private copy of the session can be modified, take a copy of it */
+        snap = calloc(1, sizeof *snap);
+        CHECK_NULL_NOMEM_RETURN(snap);
+        snap->node = sr_dup_datatree(info->node);
+        if (NULL == snap->node) {
+            free(snap);
+            SR_LOG_ERR("Duplication of the data tree %s failed", module_name);
+            return SR_ERR_NOMEM;
+        }
+        snap->ref_count = 1;
+    }
+
+    pthread_mutex_lock(&info->schema->usage_count_mutex);
+    info->schema->usage_count++;
+    SR_LOG_DBG("Usage count %s incremented (value=%zu)", info->schema->module_name, info->schema->usage_count);
+    pthread_mutex_unlock(&info->schema->usage_count_mutex);
+
+    *schema_info = info->schema;
+    *snapshot = snap;
+    return rc;
+}
+
+void
+dm_release_datatree_snapshot(dm_schema_info_t *schema_info, dm_data_snapshot_t *snapshot)
+{
+    if (NULL == schema_info || NULL == snapshot) {
+        return;
+    }
+
+    dm_data_snapshot_release(schema_info, snapshot);
+
+    pthread_mutex_lock(&schema_info->usage_count_mutex);
+    schema_info->usage_count--;
+    SR_LOG_DBG("Usage count %s decremented (value=%zu)", schema_info->module_name, schema_info->usage_count);
+    pthread_mutex_unlock(&schema_info->usage_count_mutex);
+}
+
 static int
 dm_get_module_internal(dm_ctx_t *dm_ctx, const char *module_name, bool lock, bool write, dm_schema_info_t **schema_info)
 {
@@ -2881,35 +4550,36 @@ dm_get_module_internal(dm_ctx_t *dm_ctx, const char *module_name, bool lock, boo
     lookup.module_name = (char *) module_name;
     RWLOCK_RDLOCK_TIMED_CHECK_RETURN(&dm_ctx->schema_tree_lock);
     sch_info = sr_btree_search(dm_ctx->schema_info_tree, &lookup);
+    /* schema infos are never removed from the tree while the Data Manager is running (uninstalled modules
+     * only have their ly_ctx released), so the tree lock need not be held while waiting for the module lock,
+     * which would hold off loading of other modules */
+    pthread_rwlock_unlock(&dm_ctx->schema_tree_lock);
 
     if (NULL != sch_info) {
         /* there is matching item in schema info tree */
         if (lock) {
 
             if (write) {
-                RWLOCK_WRLOCK_TIMED_CHECK_GOTO(&sch_info->model_lock, rc, cleanup);
+                RWLOCK_WRLOCK_TIMED_CHECK_RETURN(&sch_info->model_lock);
             } else {
-                RWLOCK_RDLOCK_TIMED_CHECK_GOTO(&sch_info->model_lock, rc, cleanup);
+                RWLOCK_RDLOCK_TIMED_CHECK_RETURN(&sch_info->model_lock);
             }
 
             if (NULL == sch_info->ly_ctx) {
                 SR_LOG_DBG("Module %s has been uninstalled", sch_info->module_name);
                 pthread_rwlock_unlock(&sch_info->model_lock);
-                rc = SR_ERR_UNKNOWN_MODEL;
-                goto cleanup;
+                return SR_ERR_UNKNOWN_MODEL;
             }
         }
         *schema_info = sch_info;
-        goto cleanup;
     } else {
         /* try to load schema */
-        pthread_rwlock_unlock(&dm_ctx->schema_tree_lock);
         rc = dm_load_module(dm_ctx, module_name, NULL, &sch_info);
         if (SR_ERR_OK == rc && lock) {
             if (write) {
-                RWLOCK_WRLOCK_TIMED_CHECK_GOTO(&sch_info->model_lock, rc, cleanup);
+                RWLOCK_WRLOCK_TIMED_CHECK_RETURN(&sch_info->model_lock);
             } else {
-                RWLOCK_RDLOCK_TIMED_CHECK_GOTO(&sch_info->model_lock, rc, cleanup);
+                RWLOCK_RDLOCK_TIMED_CHECK_RETURN(&sch_info->model_lock);
             }
 
             if (NULL == sch_info->ly_ctx) {
@@ -2924,10 +4594,6 @@ dm_get_module_internal(dm_ctx_t *dm_ctx, const char *module_name, bool lock, boo
     }
 
     return rc;
-
-cleanup:
-    pthread_rwlock_unlock(&dm_ctx->schema_tree_lock);
-    return rc;
 }
 
 int
@@ -2955,6 +4621,25 @@ dm_get_module_without_lock(dm_ctx_t *dm_ctx, const char *module_name, dm_schema_
     return rc;
 }
 
+int
+dm_find_loaded_schema_info(dm_ctx_t *dm_ctx, const char *module_name, dm_schema_info_t **schema_info)
+{
+    CHECK_NULL_ARG3(dm_ctx, module_name, schema_info);
+    dm_schema_info_t lookup = {0};
+    dm_schema_info_t *si = NULL;
+
+    lookup.module_name = (char *) module_name;
+    RWLOCK_RDLOCK_TIMED_CHECK_RETURN(&dm_ctx->schema_tree_lock);
+    si = sr_btree_search(dm_ctx->schema_info_tree, &lookup);
+    pthread_rwlock_unlock(&dm_ctx->schema_tree_lock);
+
+    if (NULL == si) {
+        return SR_ERR_NOT_FOUND;
+    }
+    *schema_info = si;
+    return SR_ERR_OK;
+}
+
 static int
 dm_list_rev_file(dm_ctx_t *dm_ctx, sr_mem_ctx_t *sr_mem, const char *module_name, const char *rev_date, sr_sch_revision_t *rev)
 {
@@ -3355,11 +5040,34 @@ dm_remove_session_operations(dm_session_t *session)
     return SR_ERR_OK;
 }
 
+/**
+ * @brief Checks whether the session copy of the data tree was loaded from the current
+ * content of the data file.
+ *
+ * @param [in] dm_ctx
+ * @param [in] file_name
+ * @param [in] ds datastore the data file belongs to
+ * @param [in] info
+ * @param [out] res
+ * @return Error code (SR_ERR_OK on success)
+ */
 static int
-dm_is_info_copy_uptodate(dm_ctx_t *dm_ctx, const char *file_name, const dm_data_info_t *info, bool *res)
+dm_is_info_copy_uptodate(dm_ctx_t *dm_ctx, const char *file_name, sr_datastore_t ds, const dm_data_info_t *info, bool *res)
 {
     CHECK_NULL_ARG4(dm_ctx, file_name, info, res);
     int rc = SR_ERR_OK;
+
+    if (CM_MODE_DAEMON == dm_ctx->conn_mode) {
+        /* all data files are written by this process, generation number is sufficient */
+        pthread_mutex_lock(&info->schema->data_cache_mutex);
+        *res = (info->generation == info->schema->generation[ds]);
+        pthread_mutex_unlock(&info->schema->data_cache_mutex);
+        if (!*res) {
+            SR_LOG_DBG("Module %s will be refreshed (generation %"PRIu32" is outdated)", info->schema->module_name, info->generation);
+        }
+        return rc;
+    }
+
 #ifdef HAVE_STAT_ST_MTIM
     struct stat st = {0};
     rc = stat(file_name, &st);
@@ -3445,7 +5153,8 @@ dm_update_session_data_trees(dm_ctx_t *dm_ctx, dm_session_t *session, sr_list_t
         rc = sr_lock_fd(fd, false, true);
 
         bool copy_uptodate = false;
-        rc = dm_is_info_copy_uptodate(dm_ctx, file_name, info, &copy_uptodate);
+        rc = dm_is_info_copy_uptodate(dm_ctx, file_name,
+                SR_DS_CANDIDATE == session->datastore ? SR_DS_RUNNING : session->datastore, info, &copy_uptodate);
         if (SR_ERR_OK != rc) {
             SR_LOG_ERR_MSG("File up to date check failed");
             close(fd);
@@ -4062,46 +5771,60 @@ dm_commit_load_modified_models(dm_ctx_t *dm_ctx, const dm_session_t *session, dm
             rc = sr_get_data_file_name(dm_ctx->data_search_dir, info->schema->module->name, c_ctx->session->datastore, &file_name);
             CHECK_RC_MSG_GOTO(rc, cleanup, "Get data file name failed");
 
-            c_ctx->fds[count] = open(file_name, O_RDWR);
-            if (-1 == c_ctx->fds[count]) {
-                SR_LOG_DBG("File %s can not be opened for read write", file_name);
-                if (EACCES == errno) {
+            do {
+                if (c_ctx->modif_count > count) {
+                    /* the file was replaced by another commit before it was locked, open the new one */
+                    SR_LOG_DBG("File %s has been replaced, opening it again", file_name);
+                    sr_unlock_fd(c_ctx->fds[count]);
+                    close(c_ctx->fds[count]);
+                    c_ctx->fds[count] = -1;
+                    c_ctx->existed[count] = false;
+                    c_ctx->modif_count--;
+                }
+
+                c_ctx->fds[count] = open(file_name, O_RDWR);
+                if (-1 == c_ctx->fds[count]) {
+                    SR_LOG_DBG("File %s can not be opened for read write", file_name);
+                    if (EACCES == errno) {
 //! @cond doxygen_suppress
 #define ERR_FMT "File %s can not be opened because of authorization"
 //! @endcond
-                    if (SR_ERR_OK != sr_add_error(errors, err_cnt, NULL, ERR_FMT, file_name)) {
-                        SR_LOG_WRN_MSG("Failed to record commit operation error");
-                    }
-                    SR_LOG_ERR(ERR_FMT, file_name);
-                    rc = SR_ERR_UNAUTHORIZED;
-                    goto cleanup;
+                        if (SR_ERR_OK != sr_add_error(errors, err_cnt, NULL, ERR_FMT, file_name)) {
+                            SR_LOG_WRN_MSG("Failed to record commit operation error");
+                        }
+                        SR_LOG_ERR(ERR_FMT, file_name);
+                        rc = SR_ERR_UNAUTHORIZED;
+                        goto cleanup;
 #undef ERR_FMT
-                }
+                    }
 
-                if (ENOENT == errno) {
-                    SR_LOG_DBG("File %s does not exist, trying to create an empty one", file_name);
-                    c_ctx->fds[count] = open(file_name, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
-                    CHECK_NOT_MINUS1_LOG_GOTO(c_ctx->fds[count], rc, SR_ERR_IO, cleanup, "File %s can not be created", file_name);
+                    if (ENOENT == errno) {
+                        SR_LOG_DBG("File %s does not exist, trying to create an empty one", file_name);
+                        c_ctx->fds[count] = open(file_name, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+                        CHECK_NOT_MINUS1_LOG_GOTO(c_ctx->fds[count], rc, SR_ERR_IO, cleanup, "File %s can not be created", file_name);
+                    }
+                } else {
+                    c_ctx->existed[count] = true;
                 }
-            } else {
-                c_ctx->existed[count] = true;
-            }
-            /* file was opened successfully increment the number of files to be closed */
-            c_ctx->modif_count++;
-            /* try to lock for read, non-blocking */
-            rc = sr_lock_fd(c_ctx->fds[count], false, false);
-            if (SR_ERR_OK != rc) {
+                /* file was opened successfully increment the number of files to be closed */
+                c_ctx->modif_count++;
+                /* try to lock for read, non-blocking */
+                rc = sr_lock_fd(c_ctx->fds[count], false, false);
+                if (SR_ERR_OK != rc) {
 //! @cond doxygen_suppress
 #define ERR_FMT "Locking of file '%s' failed: %s."
 //! @endcond
-                if (SR_ERR_OK != sr_add_error(errors, err_cnt, NULL, ERR_FMT, file_name, sr_strerror(rc))) {
-                    SR_LOG_WRN_MSG("Failed to record commit operation error");
-                }
-                SR_LOG_ERR(ERR_FMT, file_name, sr_strerror(rc));
-                rc = SR_ERR_OPERATION_FAILED;
-                goto cleanup;
+                    if (SR_ERR_OK != sr_add_error(errors, err_cnt, NULL, ERR_FMT, file_name, sr_strerror(rc))) {
+                        SR_LOG_WRN_MSG("Failed to record commit operation error");
+                    }
+                    SR_LOG_ERR(ERR_FMT, file_name, sr_strerror(rc));
+                    rc = SR_ERR_OPERATION_FAILED;
+                    goto cleanup;
 #undef ERR_FMT
-            }
+                }
+                /* the merge has to be done on the current file, another commit might have renamed
+                 * a new one over it between open and lock */
+            } while (dm_data_file_replaced(c_ctx->fds[count], file_name));
         }
 
         bool copy_uptodate;
@@ -4109,7 +5832,7 @@ dm_commit_load_modified_models(dm_ctx_t *dm_ctx, const dm_session_t *session, dm
             /* candidate datatree is always up-to-date, there is only one copy */
             copy_uptodate = true;
         } else {
-            rc = dm_is_info_copy_uptodate(dm_ctx, file_name, info, &copy_uptodate);
+            rc = dm_is_info_copy_uptodate(dm_ctx, file_name, c_ctx->session->datastore, info, &copy_uptodate);
             CHECK_RC_MSG_GOTO(rc, cleanup, "File up to date check failed");
         }
 
@@ -4144,7 +5867,8 @@ dm_commit_load_modified_models(dm_ctx_t *dm_ctx, const dm_session_t *session, dm
 
         } else {
             /* if the file existed pass FILE 'r+', otherwise pass -1 because there is 'w' fd already */
-            rc = dm_load_data_tree_file(dm_ctx, c_ctx->existed[count] ? c_ctx->fds[count] : -1, file_name, info->schema, &di);
+            rc = dm_load_data_tree_writable(dm_ctx, c_ctx->existed[count] ? c_ctx->fds[count] : -1, file_name, info->schema,
+                    c_ctx->session->datastore, &di);
             CHECK_RC_MSG_GOTO(rc, cleanup, "Loading data file failed");
         }
 
@@ -4164,7 +5888,8 @@ dm_commit_load_modified_models(dm_ctx_t *dm_ctx, const dm_session_t *session, dm
              */
             if (session->datastore != SR_DS_CANDIDATE && copy_uptodate) {
                 /* load data tree from file system */
-                rc = dm_load_data_tree_file(dm_ctx, c_ctx->existed[count] ? c_ctx->fds[count] : -1, file_name, info->schema, &di);
+                rc = dm_load_data_tree_writable(dm_ctx, c_ctx->existed[count] ? c_ctx->fds[count] : -1, file_name, info->schema,
+                        c_ctx->session->datastore, &di);
                 CHECK_RC_MSG_GOTO(rc, cleanup, "Loading data file failed");
 
                 rc = sr_btree_insert(c_ctx->prev_data_trees, (void *)di);
@@ -4204,6 +5929,8 @@ dm_commit_writelock_fds(dm_session_t *session, dm_commit_context_t *commit_ctx)
     int cnt = 0;
     size_t i = 0;
     dm_data_info_t *info = NULL;
+    char *file_name = NULL;
+    bool replaced = false;
 
     while (NULL != (info = sr_btree_get_at(session->session_modules[session->datastore], i++))) {
         if (!info->modified) {
@@ -4212,11 +5939,170 @@ dm_commit_writelock_fds(dm_session_t *session, dm_commit_context_t *commit_ctx)
         /* try to lock for write, non-blocking */
         rc = sr_lock_fd(commit_ctx->fds[cnt], true, false);
         CHECK_RC_LOG_RETURN(rc, "Locking of file for module '%s' failed: %s.", info->schema->module_name, sr_strerror(rc));
+        /* the data were merged with the content of this file, it must not have been replaced meanwhile */
+        rc = sr_get_data_file_name(session->dm_ctx->data_search_dir, info->schema->module_name, session->datastore, &file_name);
+        CHECK_RC_MSG_RETURN(rc, "Get data file name failed");
+        replaced = dm_data_file_replaced(commit_ctx->fds[cnt], file_name);
+        free(file_name);
+        file_name = NULL;
+        if (replaced) {
+            SR_LOG_ERR("Data file of module '%s' has been replaced by another commit.", info->schema->module_name);
+            return SR_ERR_OPERATION_FAILED;
+        }
         cnt++;
     }
     return rc;
 }
 
+/**
+ * @brief Creates a temporary file next to the data file \p file_name. The new content of the data file
+ * is written into it and then it is renamed over the original, so that a crash in the middle of writing
+ * never leaves a truncated data file behind. Ownership and access rights of the original file are preserved.
+ *
+ * @param [in] orig_fd opened original data file
+ * @param [in] file_name path of the data file
+ * @param [out] tmp_file_name path of the created temporary file
+ * @return File descriptor of the temporary file, -1 if it can not be used and the data file
+ * has to be rewritten in place.
+ */
+static int
+dm_commit_tmp_file_create(int orig_fd, const char *file_name, char **tmp_file_name)
+{
+    struct stat st = {0};
+    char *tmp_name = NULL;
+    int fd = -1;
+
+    if (-1 == fstat(orig_fd, &st)) {
+        SR_LOG_WRN("Failed to stat data file %s: %s", file_name, sr_strerror_safe(errno));
+        return -1;
+    }
+
+    if (SR_ERR_OK != sr_str_join(file_name, SR_TMP_FILE_EXT "XXXXXX", &tmp_name)) {
+        SR_LOG_WRN_MSG("Failed to allocate temporary file name");
+        return -1;
+    }
+
+    fd = mkstemp(tmp_name);
+    if (-1 == fd) {
+        SR_LOG_DBG("Temporary file for %s can not be created: %s", file_name, sr_strerror_safe(errno));
+        free(tmp_name);
+        return -1;
+    }
+
+    if (-1 == fchown(fd, st.st_uid, st.st_gid) || -1 == fchmod(fd, st.st_mode & 07777)) {
+        SR_LOG_DBG("Ownership of %s can not be preserved: %s", file_name, sr_strerror_safe(errno));
+        close(fd);
+        unlink(tmp_name);
+        free(tmp_name);
+        return -1;
+    }
+
+    *tmp_file_name = tmp_name;
+    return fd;
+}
+
+/**
+ * @brief Flushes the directory entries of the data search directory, makes the renames
+ * of the data files performed by a commit durable.
+ */
+static void
+dm_commit_sync_data_dir(dm_ctx_t *dm_ctx)
+{
+    int fd = open(dm_ctx->data_search_dir, O_RDONLY);
+    if (-1 == fd) {
+        SR_LOG_WRN("Failed to open data directory %s: %s", dm_ctx->data_search_dir, sr_strerror_safe(errno));
+        return;
+    }
+    if (-1 == fsync(fd)) {
+        SR_LOG_WRN("Failed to sync data directory %s: %s", dm_ctx->data_search_dir, sr_strerror_safe(errno));
+    }
+    close(fd);
+}
+
+/**
+ * @brief Writes the whole data tree of the module into its data file.
+ *
+ * @param [in] session to be committed
+ * @param [in] merged_info data tree to be written
+ * @param [in] orig_fd opened (and write-locked) data file
+ * @param [in] file_name path of the data file, NULL if unknown (the file is rewritten in place)
+ * @param [out] renamed set to true if the data file was replaced by a new one
+ * @return 0 on success, -1 on failure
+ */
+static int
+dm_commit_write_file(dm_session_t *session, dm_data_info_t *merged_info, int orig_fd, const char *file_name, bool *renamed)
+{
+    int ret = 0;
+    int fd = orig_fd;
+    char *tmp_file_name = NULL;
+    dm_tmp_ly_ctx_t *tmp_ctx = NULL;
+    struct lyd_node *tmp_data_tree = NULL;
+    struct ly_ctx *ly_ctx = NULL;
+
+    ly_errno = LY_SUCCESS;
+
+    /* print using tmp context if schemas different from installation time deps are needed */
+    if (NULL != merged_info->required_modules) {
+        SR_LOG_DBG("Additional schemas are needed to print data of modules %s", merged_info->schema->module_name);
+        if (SR_ERR_OK != dm_get_tmp_ly_ctx(session->dm_ctx, merged_info->required_modules, &tmp_ctx)) {
+            SR_LOG_ERR_MSG("Failed to acquired tmp ly_ctx");
+            return -1;
+        }
+        tmp_data_tree = sr_dup_datatree_to_ctx(merged_info->node, tmp_ctx->ctx);
+    }
+
+    /* write into a temporary file renamed over the original one, in place if not possible */
+    if (NULL != file_name) {
+        fd = dm_commit_tmp_file_create(orig_fd, file_name, &tmp_file_name);
+        if (-1 == fd) {
+            fd = orig_fd;
+        }
+    }
+
+    if (fd == orig_fd) {
+        if (SR_DS_RUNNING == session->datastore) {
+            /* the inode is kept by the in-place rewrite, the journal must not be replayed onto the new content */
+            dm_journal_remove(session->dm_ctx, merged_info->schema->module_name);
+        }
+        ret = ftruncate(fd, 0);
+    }
+    if (0 == ret) {
+        ly_errno = LY_SUCCESS; /* needed to check if the error was in libyang or not below */
+        ret = lyd_print_fd(fd, NULL == merged_info->required_modules ? merged_info->node : tmp_data_tree,
+                    SR_FILE_FORMAT_LY, LYP_WITHSIBLINGS | LYP_FORMAT);
+    }
+    if (0 != ret && ly_errno) {
+        ly_ctx = (NULL == merged_info->required_modules ? merged_info->node->schema->module->ctx : tmp_ctx->ctx);
+    }
+
+    if (0 == ret) {
+        ret = fsync(fd);
+    }
+    if (0 == ret && NULL != tmp_file_name) {
+        ret = rename(tmp_file_name, file_name);
+        *renamed = *renamed || (0 == ret);
+    }
+    if (0 != ret) {
+        SR_LOG_ERR("Failed to write data of '%s' module: %s", merged_info->schema->module->name,
+                (ly_errno != LY_SUCCESS) ? ly_errmsg(ly_ctx) : sr_strerror_safe(errno));
+        if (NULL != tmp_file_name) {
+            /* the original file stays untouched */
+            unlink(tmp_file_name);
+        }
+    }
+
+    if (NULL != merged_info->required_modules) {
+        lyd_free_withsiblings(tmp_data_tree);
+        dm_release_tmp_ly_ctx(session->dm_ctx, tmp_ctx);
+    }
+    if (fd != orig_fd) {
+        close(fd);
+    }
+    free(tmp_file_name);
+
+    return ret;
+}
+
 int
 dm_commit_write_files(dm_session_t *session, dm_commit_context_t *c_ctx)
 {
@@ -4225,10 +6111,9 @@ dm_commit_write_files(dm_session_t *session, dm_commit_context_t *c_ctx)
     int ret = 0;
     size_t i = 0;
     size_t count = 0;
+    bool dir_sync = false, journaled = false, journal_created = false;
+    char *file_name = NULL;
     dm_data_info_t *info = NULL;
-    dm_tmp_ly_ctx_t *tmp_ctx = NULL;
-    struct lyd_node *tmp_data_tree = NULL;
-    struct ly_ctx *ly_ctx = NULL;
 
     /* write data trees */
     i = 0;
@@ -4245,47 +6130,38 @@ dm_commit_write_files(dm_session_t *session, dm_commit_context_t *c_ctx)
             /* remove attached data trees */
             ret = dm_remove_added_data_trees(session, info);
 
-            /* print using tmp context if schemas different from installation time deps are needed */
-            if (NULL != merged_info->required_modules) {
-                SR_LOG_DBG("Additional schemas are needed to print data of modules %s", merged_info->schema->module_name);
-                rc = dm_get_tmp_ly_ctx(session->dm_ctx, merged_info->required_modules, &tmp_ctx);
-                if (SR_ERR_OK == rc) {
-                    tmp_data_tree = sr_dup_datatree_to_ctx(merged_info->node, tmp_ctx->ctx);
-                } else {
-                    SR_LOG_ERR_MSG("Failed to acquired tmp ly_ctx");
-                    continue;
-                }
+            if (SR_ERR_OK != sr_get_data_file_name(session->dm_ctx->data_search_dir, info->schema->module->name,
+                        c_ctx->session->datastore, &file_name)) {
+                SR_LOG_WRN("Failed to get data file name of module %s", info->schema->module->name);
             }
 
-            if (SR_ERR_OK == ret) {
-                ret = ftruncate(c_ctx->fds[count], 0);
+            journaled = false;
+            if (SR_ERR_OK == ret && NULL != file_name) {
+                /* append only the changes to the journal if possible */
+                journal_created = false;
+                journaled = (SR_ERR_OK == dm_journal_commit_write(c_ctx, merged_info, c_ctx->fds[count], file_name,
+                            &journal_created));
+                dir_sync = dir_sync || journal_created;
             }
-            if (0 == ret) {
-                ly_errno = LY_SUCCESS; /* needed to check if the error was in libyang or not below */
-                ret = lyd_print_fd(c_ctx->fds[count], NULL == merged_info->required_modules ? merged_info->node : tmp_data_tree,
-                            SR_FILE_FORMAT_LY, LYP_WITHSIBLINGS | LYP_FORMAT);
-            }
-
-            if (NULL != merged_info->required_modules) {
-                lyd_free_withsiblings(tmp_data_tree);
-                tmp_data_tree = NULL;
-                dm_release_tmp_ly_ctx(session->dm_ctx, tmp_ctx);
+            if (SR_ERR_OK == ret && !journaled) {
+                ret = dm_commit_write_file(session, merged_info, c_ctx->fds[count], file_name, &dir_sync);
+                if (0 == ret && SR_DS_RUNNING == c_ctx->session->datastore) {
+                    /* the journal has been folded into the data file */
+                    dm_journal_remove(session->dm_ctx, info->schema->module->name);
+                }
             }
+            free(file_name);
+            file_name = NULL;
 
-            if (0 == ret) {
-                ret = fsync(c_ctx->fds[count]);
-            }
             if (0 != ret) {
-                if (ly_errno) {
-                    ly_ctx = (NULL == merged_info->required_modules ? merged_info->node->schema->module->ctx :
-                          tmp_data_tree->schema->module->ctx);
-                }
-                SR_LOG_ERR("Failed to write data of '%s' module: %s", info->schema->module->name,
-                        (ly_errno != LY_SUCCESS) ? ly_errmsg(ly_ctx) : sr_strerror_safe(errno));
                 rc = SR_ERR_INTERNAL;
             } else {
                 SR_LOG_DBG("Data successfully written for module '%s'", info->schema->module->name);
             }
+
+            /* the file has been replaced, rewritten (or truncated in case of failure) */
+            dm_data_cache_invalidate(info->schema, c_ctx->session->datastore);
+
             if (0 == ret && SR_DS_RUNNING == c_ctx->session->datastore) {
                 if (0 == strcmp("ietf-netconf-acm", info->schema->module_name)) {
                     c_ctx->nacm_edited = true;
@@ -4294,6 +6170,12 @@ dm_commit_write_files(dm_session_t *session, dm_commit_context_t *c_ctx)
             count++;
         }
     }
+
+    if (dir_sync) {
+        /* all the renames and created journals of this commit share one directory sync */
+        dm_commit_sync_data_dir(session->dm_ctx);
+    }
+
     /* save time of the last commit */
     sr_clock_get_time(CLOCK_REALTIME, &session->dm_ctx->last_commit_time);
 
@@ -4757,7 +6639,7 @@ dm_commit_notify(dm_ctx_t *dm_ctx, dm_session_t *session, sr_notif_event_t ev, d
     dm_data_info_t *info = NULL, *commit_info = NULL, *prev_info = NULL, lookup_info = {0};
     dm_model_subscription_t *ms = NULL;
     bool match = false;
-    sr_list_t *notified_notif = NULL;
+    sr_list_t *notified_notif = NULL, *notifs = NULL;
     dm_module_difflist_t *module_difflist = NULL, lookup_difflist = {0};
 
     c_ctx->should_be_removed = false;
@@ -4770,6 +6652,12 @@ dm_commit_notify(dm_ctx_t *dm_ctx, dm_session_t *session, sr_notif_event_t ev, d
 
     rc = sr_list_init(&notified_notif);
     CHECK_RC_MSG_RETURN(rc, "List init failed");
+    rc = sr_list_init(&notifs);
+    if (SR_ERR_OK != rc) {
+        sr_list_cleanup(notified_notif);
+        SR_LOG_ERR_MSG("List init failed");
+        return rc;
+    }
 
     SR_LOG_DBG("Sending %s notifications about the changes made in running datastore...", sr_notification_event_sr_to_str(ev));
     while (NULL != (info = sr_btree_get_at(session->session_modules[session->datastore], i++))) {
@@ -4929,22 +6817,57 @@ dm_commit_notify(dm_ctx_t *dm_ctx, dm_session_t *session, sr_notif_event_t ev, d
                 }
 
                 if (match) {
-                    /* something has been changed for this subscription, send notification */
-                    rc = np_subscription_notify(dm_ctx->np_ctx, sub, ev, c_ctx->id);
+                    /* something has been changed for this subscription, prepare notification */
+                    sr_list_t *changes = NULL;
+                    Sr__Msg *notif = NULL;
+                    if (sub->changes_inline) {
+                        rc = rp_dt_get_subscription_changes(ms, ms->nodes[s], &changes);
+                        if (SR_ERR_OK != rc) {
+                            SR_LOG_WRN("Unable to get changes to be sent inline for the subscription in module %s, "
+                                    "the subscriber will need to request them.", sub->module_name);
+                            changes = NULL;
+                        }
+                    }
+                    rc = np_subscription_notif_alloc(dm_ctx->np_ctx, sub, ev, c_ctx->id, changes, &notif);
+                    sr_list_cleanup(changes);
+                    if (SR_ERR_OK == rc) {
+                        rc = sr_list_add(notifs, notif);
+                        if (SR_ERR_OK != rc) {
+                            sr_msg_free(notif);
+                        }
+                    }
+                    if (SR_ERR_OK == rc) {
+                        /* wait only for the subscriptions whose notification has been queued */
+                        rc = sr_list_add(notified_notif, sub);
+                        if (SR_ERR_OK != rc) {
+                            /* the notification would be counted but never waited for */
+                            sr_list_rm_at(notifs, notifs->count - 1);
+                            sr_msg_free(notif);
+                        }
+                    }
                     if (SR_ERR_OK != rc) {
                        SR_LOG_WRN("Unable to send notifications about the changes for the subscription in module %s xpath %s.",
                                sub->module_name,
                                sub->xpath);
-                    }
-                    rc = sr_list_add(notified_notif, sub);
-                    if (SR_ERR_OK != rc) {
-                       SR_LOG_WRN_MSG("List add failed");
+                       rc = SR_ERR_OK;
                     }
                 }
             }
         }
     }
 
+    /* send the notifications to all subscribers at once, they process them in parallel */
+    if (notifs->count > 0) {
+        rc = np_commit_notifications_send(dm_ctx->np_ctx, c_ctx->id, (Sr__Msg **) notifs->data, notifs->count);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_WRN("Unable to send some of the %s notifications of commit id=%"PRIu32".",
+                    sr_notification_event_sr_to_str(ev), c_ctx->id);
+            /* notifications that have not been sent are not waited for */
+            rc = SR_ERR_OK;
+        }
+    }
+    sr_list_cleanup(notifs);
+
     if (SR_EV_VERIFY == ev ){
         if (notified_notif->count > 0) {
             c_ctx->state = DM_COMMIT_WAIT_FOR_NOTIFICATIONS;
@@ -5103,16 +7026,33 @@ unlock:
             lookup.module_name = (char *)dep->dest->name;
             si_ext = sr_btree_search(dm_ctx->schema_info_tree, &lookup);
             if (NULL != si_ext && NULL != si_ext->ly_ctx) {
-                rc = dm_load_schema_file(dm_ctx, module->filepath, true, &si_ext);
-                CHECK_RC_LOG_GOTO(rc, unlock, "Failed to load schema %s", module->filepath);
+                /* the context of the augmented module may be in use by other requests */
+                rc = dm_lock_schema_info_write(si_ext);
+                CHECK_RC_LOG_GOTO(rc, cleanup, "Failed to lock schema info %s", dep->dest->name);
 
-                /* compute xpath hashes for all newly added schema nodes (through augment) */
-                rc = dm_init_missing_node_priv_data(si_ext);
-                CHECK_RC_LOG_GOTO(rc, unlock, "Failed to initialize private data for module %s", dep->dest->name);
+                rc = dm_load_schema_file(dm_ctx, module->filepath, true, &si_ext);
+                if (SR_ERR_OK != rc) {
+                    SR_LOG_ERR("Failed to load schema %s", module->filepath);
+                } else {
+                    /* cached xpaths might have been resolved without the augment */
+                    dm_xpath_cache_clear(si_ext);
 
-                if (dm_module_has_persist(module)) {
+                    /* compute xpath hashes for all newly added schema nodes (through augment) */
+                    rc = dm_init_missing_node_priv_data(si_ext);
+                    if (SR_ERR_OK != rc) {
+                        SR_LOG_ERR("Failed to initialize private data for module %s", dep->dest->name);
+                    }
+                }
+                if (SR_ERR_OK == rc && dm_module_has_persist(module)) {
                     rc = dm_apply_persist_data_for_model(dm_ctx, session, module->name, si_ext, false);
-                    CHECK_RC_LOG_GOTO(rc, unlock, "Failed to apply persist data for %s", module->name);
+                    if (SR_ERR_OK != rc) {
+                        SR_LOG_ERR("Failed to apply persist data for %s", module->name);
+                    }
+                }
+
+                pthread_rwlock_unlock(&si_ext->model_lock);
+                if (SR_ERR_OK != rc) {
+                    goto cleanup;
                 }
             }
         }
@@ -5157,6 +7097,8 @@ dm_uninstall_module_schema(dm_ctx_t *dm_ctx, const char *module_name, const char
                 rc = SR_ERR_OPERATION_FAILED;
                 SR_LOG_ERR("Module %s can not be uninstalled because it is being used. (referenced by %zu)", module_name, schema_info->usage_count);
             } else {
+                dm_data_cache_clear(schema_info);
+                dm_xpath_cache_clear(schema_info);
                 ly_ctx_destroy(schema_info->ly_ctx, dm_free_lys_private_data);
                 schema_info->ly_ctx = NULL;
                 schema_info->module = NULL;
@@ -5378,7 +7320,9 @@ static int
 dm_send_enabled_notification(dm_ctx_t *dm_ctx, dm_commit_context_t *c_ctx, const np_subscription_t *subscription)
 {
     int rc = SR_ERR_OK;
-    sr_list_t *notif_list = NULL;
+    sr_list_t *notif_list = NULL, *changes = NULL;
+    dm_model_subscription_t *ms = NULL;
+    struct lys_node *selection_node = NULL;
 
     CHECK_NULL_ARG_NORET3(rc, dm_ctx, c_ctx, subscription);
     if (SR_ERR_OK != rc) {
@@ -5389,16 +7333,33 @@ dm_send_enabled_notification(dm_ctx_t *dm_ctx, dm_commit_context_t *c_ctx, const
     CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to insert commit context");
 
     uint32_t commit_id = c_ctx->id;
+    /* there is only one model subscription in the context */
+    ms = sr_btree_get_at(c_ctx->subscriptions, 0);
     /* do not free commit context in cleanup */
     c_ctx = NULL;
 
+    if (subscription->changes_inline && NULL != ms) {
+        if (NULL != subscription->xpath) {
+            rc = rp_dt_validate_node_xpath(dm_ctx, NULL, subscription->xpath, NULL, &selection_node);
+        }
+        if (SR_ERR_OK == rc) {
+            rc = rp_dt_get_subscription_changes(ms, selection_node, &changes);
+        }
+        if (SR_ERR_OK != rc) {
+            SR_LOG_WRN("Unable to get changes to be sent inline for the subscription in module %s, "
+                    "the subscriber will need to request them.", subscription->module_name);
+            changes = NULL;
+            rc = SR_ERR_OK;
+        }
+    }
+
     rc = sr_list_init(&notif_list);
     CHECK_RC_MSG_GOTO(rc, cleanup, "List init failed");
 
     rc = sr_list_add(notif_list, (void *) subscription);
     CHECK_RC_MSG_GOTO(rc, cleanup, "List insert failed");
 
-    rc = np_subscription_notify(dm_ctx->np_ctx, (np_subscription_t *) subscription, SR_EV_ENABLED, commit_id);
+    rc = np_subscription_notify(dm_ctx->np_ctx, (np_subscription_t *) subscription, SR_EV_ENABLED, commit_id, changes);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Sending of SR_EV_ENABLED notification failed");
 
     rc = np_commit_notifications_sent(dm_ctx->np_ctx, commit_id, true, notif_list);
@@ -5409,6 +7370,7 @@ cleanup:
         dm_free_commit_context(c_ctx);
     }
     sr_list_cleanup(notif_list);
+    sr_list_cleanup(changes);
     return rc;
 }
 
@@ -5520,6 +7482,10 @@ dm_copy_config(dm_ctx_t *dm_ctx, dm_session_t *session, const sr_list_t *module_
             rc = sr_get_data_file_name(dm_ctx->data_search_dir, module_name, dst_session->datastore, &file_name);
             CHECK_RC_MSG_GOTO(rc, cleanup, "Get data file name failed");
 
+            if (SR_DS_RUNNING == dst) {
+                /* the data file is rewritten in place (the inode is kept), drop the journal before that */
+                dm_journal_remove(dm_ctx, module_name);
+            }
             if (NULL != session) {
                 ac_set_user_identity(dm_ctx->ac_ctx, session->user_credentials);
             }
@@ -5546,6 +7512,7 @@ dm_copy_config(dm_ctx_t *dm_ctx, dm_session_t *session, const sr_list_t *module_
                 SR_LOG_ERR("Copy of module %s failed", module_name);
                 rc = SR_ERR_INTERNAL;
             }
+            dm_data_cache_invalidate(src_infos[i]->schema, dst);
             ret = fsync(fds[i]);
             if (0 != ret) {
                 SR_LOG_ERR("Failed to write data of '%s' module: %s", src_infos[i]->schema->module->name,
@@ -6247,7 +8214,7 @@ dm_validate_procedure_content(rp_ctx_t *rp_ctx, rp_session_t *session, dm_data_i
             /* retrieve all required data */
             for (size_t i = 0; i < required_data->count; i++) {
                 SR_LOG_DBG("To pass the validation of '%s' data from module %s is needed", di->schema->module_name, (char *)required_data->data[i]);
-                rc = dm_get_data_info_internal(rp_ctx->dm_ctx, session->dm_session, (char *)required_data->data[i], true, &should_be_freed[i], &dep_di);
+                rc = dm_get_data_info_internal(rp_ctx->dm_ctx, session->dm_session, (char *)required_data->data[i], true, true, &should_be_freed[i], &dep_di);
                 CHECK_RC_LOG_GOTO(rc, cleanup, "Failed to get data info for module %s", (char *)required_data->data[i]);
 
                 rc = sr_list_add(data_for_validation, dep_di);
@@ -6702,8 +8669,8 @@ dm_copy_modified_session_trees(dm_ctx_t *dm_ctx, dm_session_t *from, dm_session_
         new_info->modified = info->modified;
         new_info->schema = info->schema;
         new_info->timestamp = info->timestamp;
-        lyd_free_withsiblings(new_info->node);
-        new_info->node = NULL;
+        new_info->generation = info->generation;
+        dm_data_info_free_node(new_info);
         if (NULL != info->node) {
             new_info->node = sr_dup_datatree(info->node);
         }
@@ -6759,13 +8726,14 @@ dm_copy_session_tree(dm_ctx_t *dm_ctx, dm_session_t *from, dm_session_t *to, con
     new_info->modified = info->modified;
     new_info->schema = info->schema;
     new_info->timestamp = info->timestamp;
+    new_info->generation = info->generation;
     if (NULL != info->node) {
         tmp_node = sr_dup_datatree(info->node);
         CHECK_NULL_NOMEM_ERROR(tmp_node, rc);
     }
 
     if (SR_ERR_OK == rc) {
-        lyd_free_withsiblings(new_info->node);
+        dm_data_info_free_node(new_info);
         new_info->node = tmp_node;
     }
 
@@ -6791,7 +8759,7 @@ dm_create_rdonly_ptr_data_tree(dm_ctx_t *dm_ctx, dm_session_t *from, dm_session_
     dm_data_info_t *info = NULL;
     dm_data_info_t lookup = {0};
     dm_data_info_t *new_info = NULL;
-    bool existed = true;
+    bool existed = true, counted = false;
 
     lookup.schema = schema_info;
 
@@ -6811,10 +8779,28 @@ dm_create_rdonly_ptr_data_tree(dm_ctx_t *dm_ctx, dm_session_t *from, dm_session_
     new_info->modified = info->modified;
     new_info->schema = info->schema;
     new_info->timestamp = info->timestamp;
+    new_info->generation = info->generation;
+    /* whether the usage of the schema is already accounted for the existing data info */
+    counted = existed && (!new_info->rdonly_copy || NULL != new_info->snapshot);
+    dm_data_info_free_node(new_info);
     new_info->rdonly_copy = true;
-    lyd_free_withsiblings(new_info->node);
     new_info->node = info->node;
 
+    if (NULL != info->snapshot) {
+        /* hold own reference, the source session may duplicate the tree before its first edit */
+        pthread_mutex_lock(&info->schema->data_cache_mutex);
+        info->snapshot->ref_count++;
+        pthread_mutex_unlock(&info->schema->data_cache_mutex);
+        new_info->snapshot = info->snapshot;
+
+        if (!counted) {
+            pthread_mutex_lock(&info->schema->usage_count_mutex);
+            info->schema->usage_count++;
+            SR_LOG_DBG("Usage count %s incremented (value=%zu)", info->schema->module_name, info->schema->usage_count);
+            pthread_mutex_unlock(&info->schema->usage_count_mutex);
+        }
+    }
+
     if (!existed) {
         rc = sr_btree_insert(to->session_modules[to->datastore], new_info);
         if (SR_ERR_OK != rc) {
@@ -7158,7 +9144,7 @@ dm_netconf_config_change_to_string(dm_ctx_t *dm_ctx, struct lyd_node *notif, cha
     ly_ctx_set_module_data_clb(tmp_ctx->ctx, dm_module_clb, dm_ctx);
 
     tmp_notif = sr_dup_datatree_to_ctx(notif, tmp_ctx->ctx);
-    lyd_print_mem(out, tmp_notif, SR_FILE_FORMAT_LY, 0);
+    lyd_print_mem(out, tmp_notif, SR_TEXT_FORMAT_LY, 0);
 
 cleanup:
     free(module_name);
@@ -61,6 +61,9 @@ typedef struct dm_c_ctxs_s {
 /** defined in data_manager.c */
 typedef struct dm_tmp_ly_ctx_s dm_tmp_ly_ctx_t;
 
+/** defined in data_manager.c */
+typedef struct dm_warmup_s dm_warmup_t;
+
 /**
  * @brief Data manager context holding loaded schemas, data trees
  * and corresponding locks
@@ -83,6 +86,7 @@ typedef struct dm_ctx_s {
     struct timespec last_commit_time;  /**< Time of the last commit */
     dm_tmp_ly_ctx_t *tmp_ly_ctx;  /**< Structure wrapping libyang context that is used to validate/print/parse date
                                    * where the set of required yang module can vary */
+    dm_warmup_t *warmup;          /**< Background loading of frequently used modules at startup (daemon mode only) */
 
 } dm_ctx_t;
 
@@ -96,6 +100,49 @@ typedef struct dm_session_s dm_session_t;
  */
 typedef struct rp_session_s rp_session_t;
 
+/**
+ * @brief Read-only snapshot of a data tree as stored in a datastore file. Snapshots are cached
+ * in the schema info and shared by the sessions, a session duplicates the tree only before its first edit.
+ */
+typedef struct dm_data_snapshot_s {
+    struct lyd_node *node;              /**< data tree, must not be modified */
+    uint32_t generation;                /**< generation of the data file the snapshot was loaded from */
+    struct timespec timestamp;          /**< timestamp of the data file the snapshot was loaded from */
+    size_t ref_count;                   /**< number of references (data cache + data infos), guarded by data_cache_mutex */
+} dm_data_snapshot_t;
+
+/**
+ * @brief One step of a simple xpath (absolute path of containers, leaves and fully keyed lists).
+ */
+typedef struct dm_xpath_step_s {
+    const struct lys_node *node;        /**< schema node of the step */
+    char **keys;                        /**< NULL-terminated values of the list keys in the order of the keys in schema,
+                                         *  NULL if the node is not a list; a key missing in the xpath leaves its slot NULL */
+    size_t key_cnt;                     /**< number of slots in keys (number of keys of the list) */
+    char *predicates;                   /**< key predicates of the list ("[key1='value1'][key2='value2']..."), NULL if the node is not a list */
+} dm_xpath_step_t;
+
+/**
+ * @brief Xpath resolved in the context of a schema info, cached in ::dm_schema_info_t.
+ */
+typedef struct dm_xpath_entry_s {
+    char *xpath;                        /**< resolved xpath */
+    const struct lys_module *module;    /**< module of the first node in the xpath */
+    struct lys_node *node;              /**< schema node identified by the xpath */
+    dm_xpath_step_t *steps;             /**< steps of the xpath if it is a simple one (data tree can be walked
+                                         *  without the xpath engine), NULL otherwise */
+    size_t step_cnt;                    /**< number of steps */
+    bool keys_canonical;                /**< flag whether all key values of the steps are compared as strings, so a data
+                                         *  node that does not match the steps does not match the xpath either */
+    /* private members, guarded by xpath_cache_mutex of the schema info */
+    size_t ref_cnt;                     /**< number of references handed out by ::dm_xpath_cache_get and ::dm_xpath_cache_add */
+    bool cached;                        /**< flag whether the entry is still stored in the cache */
+    uint32_t hash;                      /**< hash of the xpath */
+    struct dm_xpath_entry_s *hash_next; /**< next entry in the same hash bucket */
+    struct dm_xpath_entry_s *lru_prev;  /**< more recently used entry */
+    struct dm_xpath_entry_s *lru_next;  /**< less recently used entry */
+} dm_xpath_entry_t;
+
 /**
  * @brief Holds information related to the schema.
  */
@@ -113,6 +160,14 @@ typedef struct dm_schema_info_s {
     bool cross_module_data_dependency;  /**< Flag whether data from different module is needed for validation */
     bool has_instance_id;               /**< Flag whether the module contains a node of type instance identifier */
     bool can_not_be_locked;             /**< If true module contains no data and lock_module for the module is NOP */
+    dm_data_snapshot_t *data_cache[DM_DATASTORE_COUNT]; /**< cached data trees loaded from the data files (per datastore) */
+    uint32_t generation[DM_DATASTORE_COUNT];            /**< incremented each time a data file of the module is rewritten (per datastore) */
+    pthread_mutex_t data_cache_mutex;   /**< mutex guarding data_cache, generation and reference counts of the snapshots */
+    dm_xpath_entry_t **xpath_cache;     /**< hash table of resolved xpaths (allocated on first use), emptied whenever the schema changes */
+    dm_xpath_entry_t *xpath_cache_mru;  /**< most recently used entry of the xpath cache */
+    dm_xpath_entry_t *xpath_cache_lru;  /**< least recently used entry of the xpath cache */
+    size_t xpath_cache_cnt;             /**< number of entries in the xpath cache */
+    pthread_mutex_t xpath_cache_mutex;  /**< mutex guarding the xpath cache */
 }dm_schema_info_t;
 
 /**
@@ -120,9 +175,11 @@ typedef struct dm_schema_info_s {
  */
 typedef struct dm_data_info_s{
     bool rdonly_copy;                   /**< node member is only copy of pointer it must not be freed nor modified */
+    dm_data_snapshot_t *snapshot;       /**< shared snapshot the node belongs to (rdonly_copy is set), NULL for private copies */
     dm_schema_info_t *schema;           /**< pointer to schema info */
     struct lyd_node *node;              /**< data tree */
     struct timespec timestamp;          /**< timestamp of this copy (used only if HAVE_ST_MTIM is defined) */
+    uint32_t generation;                /**< generation of the data file this copy was loaded from */
     bool modified;                      /**< flag denoting whether a change has been made*/
     sr_list_t *required_modules;        /**< schemas that needs to be in context to print data */
 }dm_data_info_t;
@@ -315,7 +372,8 @@ void dm_session_stop(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx);
  * @brief Returns the structure holding data tree, timestamp and modified flag for the specified module.
  * If the module has been already loaded, the session copy is returned. If not
  * the function tries to load it from file system.
- * This structure is needed for edit like calls that can modify the data tree.
+ * This structure is needed for edit like calls that can modify the data tree. If the session
+ * references a shared read-only snapshot of the data tree, the tree is duplicated first.
  *
  * @note Function acquires and releases read lock for the schema info.
  *
@@ -332,11 +390,36 @@ int dm_get_data_info(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx, const char
  * @param [in] dm_ctx
  * @param [in] dm_session_ctx
  * @param [in] module_name
- * @param [out] data_tree - @note returned data tree should not be modified. To get editable data_tree use ::dm_get_data_info
+ * @param [out] data_tree - @note returned data tree should not be modified, it may be shared with other sessions.
+ * To get editable data_tree use ::dm_get_data_info
  * @return Error code (SR_ERR_OK on success), SR_ERR_NOT_FOUND if the requested data tree is empty, SR_ERR_UNKNOWN_MODEL
  */
 int dm_get_datatree(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx, const char *module_name, struct lyd_node **data_tree);
 
+/**
+ * @brief Returns an immutable snapshot of the session copy of the data tree for the specified module,
+ * which can be used across requests (e.g. by iterations). If the session has not modified the data tree,
+ * the shared snapshot is referenced, otherwise the session copy is duplicated. The module can not be
+ * uninstalled nor its features changed while the snapshot is held.
+ *
+ * @param [in] dm_ctx
+ * @param [in] dm_session_ctx
+ * @param [in] module_name
+ * @param [out] schema_info Schema info of the module, needed to release the snapshot.
+ * @param [out] snapshot Snapshot to be released by ::dm_release_datatree_snapshot.
+ * @return Error code (SR_ERR_OK on success), SR_ERR_NOT_FOUND if the data tree is empty, SR_ERR_UNKNOWN_MODEL
+ */
+int dm_get_datatree_snapshot(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx, const char *module_name,
+        dm_schema_info_t **schema_info, dm_data_snapshot_t **snapshot);
+
+/**
+ * @brief Releases the snapshot returned by ::dm_get_datatree_snapshot.
+ *
+ * @param [in] schema_info
+ * @param [in] snapshot
+ */
+void dm_release_datatree_snapshot(dm_schema_info_t *schema_info, dm_data_snapshot_t *snapshot);
+
 /**
  * @brief Tests if the schema exists. If yes returns the module (loads from file system if
  * necessary). Having read lock ensures that model will not be uninstalled from sysrepo.
@@ -380,6 +463,68 @@ int dm_get_module_and_lockw(dm_ctx_t *dm_ctx, const char *module_name, dm_schema
  */
 int dm_get_module_without_lock(dm_ctx_t *dm_ctx, const char *module_name, dm_schema_info_t **schema_info);
 
+/**
+ * @brief Returns schema info of a module that has already been loaded, without locking it.
+ * The caller must make sure that the schema can not change while it is used (e.g. by holding
+ * a data tree of the module).
+ *
+ * @param [in] dm_ctx
+ * @param [in] module_name
+ * @param [out] schema_info
+ * @return Error code (SR_ERR_OK on success), SR_ERR_NOT_FOUND if the module has not been loaded
+ */
+int dm_find_loaded_schema_info(dm_ctx_t *dm_ctx, const char *module_name, dm_schema_info_t **schema_info);
+
+/**
+ * @brief Waits until the background warm-up of the modules started by ::dm_init finishes.
+ * Must not be called concurrently with ::dm_cleanup.
+ *
+ * @param [in] dm_ctx
+ * @param [out] modules names of the modules selected for the warm-up (char *), owned by the Data Manager
+ * @return Error code (SR_ERR_OK on success), SR_ERR_NOT_FOUND if no warm-up has been started
+ */
+int dm_warmup_wait(dm_ctx_t *dm_ctx, const sr_list_t **modules);
+
+/**
+ * @brief Looks up the xpath in the cache of resolved xpaths of the schema info. The returned
+ * entry must be released by ::dm_xpath_cache_release.
+ *
+ * @param [in] schema_info Schema info, the schema must not change while the entry is used.
+ * @param [in] xpath
+ * @param [out] entry
+ * @return Error code (SR_ERR_OK on success), SR_ERR_NOT_FOUND if the xpath is not cached
+ */
+int dm_xpath_cache_get(dm_schema_info_t *schema_info, const char *xpath, dm_xpath_entry_t **entry);
+
+/**
+ * @brief Stores the resolved xpath into the cache of the schema info, evicting the least
+ * recently used entry if the cache is full. The returned entry must be released by ::dm_xpath_cache_release.
+ *
+ * @note Schema info must be locked (at least for reading) by the caller.
+ *
+ * @param [in] schema_info
+ * @param [in] new_entry Entry to be stored (ownership is passed to the function, it is freed on error).
+ * If the xpath has been cached meanwhile, the new entry is freed and the cached one is returned.
+ * @param [out] entry
+ * @return Error code (SR_ERR_OK on success)
+ */
+int dm_xpath_cache_add(dm_schema_info_t *schema_info, dm_xpath_entry_t *new_entry, dm_xpath_entry_t **entry);
+
+/**
+ * @brief Releases the entry returned by ::dm_xpath_cache_get or ::dm_xpath_cache_add.
+ *
+ * @param [in] schema_info
+ * @param [in] entry
+ */
+void dm_xpath_cache_release(dm_schema_info_t *schema_info, dm_xpath_entry_t *entry);
+
+/**
+ * @brief Frees the xpath entry that has not been stored in the cache.
+ *
+ * @param [in] entry
+ */
+void dm_xpath_entry_free(dm_xpath_entry_t *entry);
+
 /**
  * @brief Returns an array that contains information about schemas supported by sysrepo.
  * @param [in] dm_ctx
@@ -503,7 +648,9 @@ int dm_commit_writelock_fds(dm_session_t *session, dm_commit_context_t *commit_c
 
 /**
  * @brief Writes the data trees from commit session stored in commit context into the files.
- * In case of error tries to continue. Does not do a cleanup.
+ * Each data tree is written into a temporary file that atomically replaces the original
+ * data file, the data directory is synced once per commit. If a temporary file can not be used
+ * the data file is rewritten in place. In case of error tries to continue. Does not do a cleanup.
  * @param [in] session to be committed
  * @param [in] c_ctx
  * @return Error code (SR_ERR_OK on success)
@@ -787,6 +787,12 @@ srcfg_import_datastore(struct ly_ctx *ly_ctx, int fd_in, md_module_t *module, sr
                               "Unable to obtain input file info: %s.", sr_strerror_safe(errno));
     ly_errno = LY_SUCCESS;
     if (S_ISREG(info.st_mode)) {
+#ifdef HAVE_LYD_LYB
+        /* binary input is recognized regardless of the requested format, so that it can be converted */
+        if (LYD_LYB == sr_data_file_format(fd_in)) {
+            format = LYD_LYB;
+        }
+#endif
         /* load (using mmap) and parse the input data in one step */
         new_dt = lyd_parse_fd(ly_ctx, fd_in, format, LYD_OPT_TRUSTED | LYD_OPT_CONFIG | (strict ? LYD_OPT_STRICT : 0));
     } else { /* most likely STDIN */
@@ -1640,7 +1646,11 @@ srcfg_print_help()
     printf("  -d, --datastore <datastore>  Datastore to be operated on\n");
     printf("                               (either \"running\" or \"startup\", \"running\" is default).\n");
     printf("  -f, --format <format>        Data format to be used for configuration editing/importing/exporting\n");
-    printf("                               (\"xml\" or \"json\", \"" SR_FILE_FORMAT_EXT "\" is default).\n");
+#ifdef HAVE_LYD_LYB
+    printf("                               (\"xml\", \"json\" or \"lyb\" for importing/exporting, \"" SR_TEXT_FORMAT_EXT "\" is default).\n");
+#else
+    printf("                               (\"xml\" or \"json\", \"" SR_TEXT_FORMAT_EXT "\" is default).\n");
+#endif
     printf("  -e, --editor <editor>        Text editor to be used for editing datastore data\n");
     printf("                               (default editor is defined by $VISUAL or $EDITOR env. variables).\n");
     printf("  -i, --import [<path>]        Read and replace entire configuration from a supplied file\n");
@@ -1688,10 +1698,10 @@ main(int argc, char* argv[])
     int c = 0;
     srcfg_operation_t operation = SRCFG_OP_EDIT;
     char *module_name = NULL, *datastore_name = "running";
-    char *format_name = SR_FILE_FORMAT_EXT, *editor = NULL;
+    char *format_name = SR_TEXT_FORMAT_EXT, *editor = NULL;
     char *filepath = NULL;
     srcfg_datastore_t datastore = SRCFG_STORE_RUNNING;
-    LYD_FORMAT format = SR_FILE_FORMAT_LY;
+    LYD_FORMAT format = SR_TEXT_FORMAT_LY;
     bool enabled = false, keep = false, permanent = false, strict = true;
     int log_level = -1;
     char local_schema_search_dir[PATH_MAX] = { 0, }, local_internal_schema_search_dir[PATH_MAX] = { 0, };
@@ -1892,11 +1902,26 @@ main(int argc, char* argv[])
         format = LYD_XML;
     } else if (strcasecmp("json", format_name) == 0) {
         format = LYD_JSON;
+#ifdef HAVE_LYD_LYB
+    } else if (strcasecmp("lyb", format_name) == 0) {
+        format = LYD_LYB;
+#endif
     } else {
+#ifdef HAVE_LYD_LYB
+        fprintf(stderr, "%s: Unsupported data format (xml, json and lyb are supported).\n", argv[0]);
+#else
         fprintf(stderr, "%s: Unsupported data format (xml and json are supported).\n", argv[0]);
+#endif
+        rc = SR_ERR_INVAL_ARG;
+        goto terminate;
+    }
+#ifdef HAVE_LYD_LYB
+    if (LYD_LYB == format && SRCFG_OP_EDIT == operation) {
+        fprintf(stderr, "%s: Binary data format cannot be edited in a text editor.\n", argv[0]);
         rc = SR_ERR_INVAL_ARG;
         goto terminate;
     }
+#endif
     /*  -> datastore */
     if (strcasecmp("startup", datastore_name) == 0) {
         datastore = SRCFG_STORE_STARTUP;
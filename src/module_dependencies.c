@@ -23,6 +23,7 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <stdarg.h>
@@ -35,6 +36,14 @@
 #define MD_MODULE_NAME      "sysrepo-module-dependencies"
 #define MD_SCHEMA_FILENAME  MD_MODULE_NAME ".yang"
 #define MD_DATA_FILENAME    MD_MODULE_NAME "." SR_FILE_FORMAT_EXT
+#define MD_SNAPSHOT_FILENAME MD_MODULE_NAME ".snapshot"
+//! @endcond
+
+/* Binary snapshot of the transitively-closed dependency graph */
+//! @cond doxygen_suppress
+#define MD_SNAPSHOT_MAGIC    0x53524d44  /* "SRMD" */
+#define MD_SNAPSHOT_VERSION  1
+#define MD_SNAPSHOT_NULL_STR UINT32_MAX
 //! @endcond
 
 /* A list of frequently used xpaths for the internal module with dependency info */
@@ -77,6 +86,22 @@ md_get_data_file_path(const char *internal_data_search_dir, char **file_path)
     return rc;
 }
 
+/**
+ * @brief Return file path of the binary snapshot of the dependency graph.
+ *
+ * @param [in] internal_data_search_dir Path to the directory with internal data files
+ *             (e.g. SR_INTERNAL_DATA_SEARCH_DIR)
+ * @param [out] file_path Allocated file path
+ * @return Error code (SR_ERR_OK on success)
+ */
+static int
+md_get_snapshot_file_path(const char *internal_data_search_dir, char **file_path)
+{
+    CHECK_NULL_ARG2(internal_data_search_dir, file_path);
+    int rc = sr_path_join(internal_data_search_dir, MD_SNAPSHOT_FILENAME, file_path);
+    return rc;
+}
+
 /**
  * @brief Return file path of the internal schema file used to represent module dependencies.
  *
@@ -407,6 +432,14 @@ md_lyd_new_path(md_ctx_t *md_ctx, const char *xpath_format, const char *value, m
     struct lyd_node *node_data = NULL;
     va_list va;
 
+    if (NULL == md_ctx->ly_ctx) {
+        /* graph loaded from the snapshot, data tree is not maintained */
+        if (NULL != node_data_p) {
+            *node_data_p = NULL;
+        }
+        return SR_ERR_OK;
+    }
+
     va_start(va, node_data_p);
     vsnprintf(xpath, PATH_MAX, xpath_format, va);
     va_end(va);
@@ -1004,6 +1037,652 @@ cleanup:
     return rc;
 }
 
+/**
+ * @brief Header of the binary snapshot of the dependency graph.
+ *
+ * The snapshot is valid only for the exact version of the internal data file it was created from,
+ * which is identified by the inode number, size and modification time of the file.
+ */
+typedef struct md_snapshot_hdr_s {
+    uint32_t magic;        /**< MD_SNAPSHOT_MAGIC */
+    uint32_t version;      /**< MD_SNAPSHOT_VERSION */
+    uint64_t data_ino;     /**< Inode number of the internal data file. */
+    uint64_t data_size;    /**< Size of the internal data file. */
+    int64_t data_mtime;    /**< Modification time of the internal data file (seconds). */
+    int64_t data_mtime_ns; /**< Modification time of the internal data file (nanoseconds, if available). */
+    uint32_t module_cnt;   /**< Number of (sub)modules stored in the snapshot. */
+    uint32_t reserved;     /**< Padding, always zero. */
+} md_snapshot_hdr_t;
+
+/**
+ * @brief Growing buffer used to serialize the dependency graph.
+ */
+typedef struct md_snapshot_buf_s {
+    uint8_t *data;         /**< Serialized data. */
+    size_t used;           /**< Number of bytes used. */
+    size_t size;           /**< Number of bytes allocated. */
+} md_snapshot_buf_t;
+
+/**
+ * @brief Read cursor over a mapped snapshot.
+ */
+typedef struct md_snapshot_cur_s {
+    const uint8_t *data;   /**< Mapped snapshot. */
+    size_t size;           /**< Size of the snapshot. */
+    size_t pos;            /**< Current read position. */
+} md_snapshot_cur_t;
+
+/**
+ * @brief Mapping from module pointer to its position in ::md_ctx_t::modules.
+ */
+typedef struct md_snapshot_idx_s {
+    const md_module_t *module;
+    uint32_t idx;
+} md_snapshot_idx_t;
+
+/*
+ * @brief Fill the fingerprint of the internal data file into the snapshot header.
+ */
+static void
+md_snapshot_fill_hdr(const struct stat *data_stat, uint32_t module_cnt, md_snapshot_hdr_t *hdr)
+{
+    memset(hdr, 0, sizeof *hdr);
+    hdr->magic = MD_SNAPSHOT_MAGIC;
+    hdr->version = MD_SNAPSHOT_VERSION;
+    hdr->data_ino = data_stat->st_ino;
+    hdr->data_size = data_stat->st_size;
+#ifdef HAVE_STAT_ST_MTIM
+    hdr->data_mtime = data_stat->st_mtim.tv_sec;
+    hdr->data_mtime_ns = data_stat->st_mtim.tv_nsec;
+#else
+    hdr->data_mtime = data_stat->st_mtime;
+#endif
+    hdr->module_cnt = module_cnt;
+}
+
+/*
+ * @brief Append raw bytes into the snapshot buffer.
+ */
+static int
+md_snapshot_put(md_snapshot_buf_t *buf, const void *src, size_t len)
+{
+    uint8_t *tmp = NULL;
+    size_t new_size = 0;
+
+    if (buf->used + len > buf->size) {
+        new_size = buf->size ? buf->size : 4096;
+        while (buf->used + len > new_size) {
+            new_size *= 2;
+        }
+        tmp = realloc(buf->data, new_size);
+        CHECK_NULL_NOMEM_RETURN(tmp);
+        buf->data = tmp;
+        buf->size = new_size;
+    }
+    memcpy(buf->data + buf->used, src, len);
+    buf->used += len;
+    return SR_ERR_OK;
+}
+
+static int
+md_snapshot_put_u32(md_snapshot_buf_t *buf, uint32_t value)
+{
+    return md_snapshot_put(buf, &value, sizeof value);
+}
+
+static int
+md_snapshot_put_u8(md_snapshot_buf_t *buf, uint8_t value)
+{
+    return md_snapshot_put(buf, &value, sizeof value);
+}
+
+/*
+ * @brief Append a length-prefixed string (or NULL) into the snapshot buffer.
+ */
+static int
+md_snapshot_put_str(md_snapshot_buf_t *buf, const char *str)
+{
+    int rc = SR_ERR_OK;
+    uint32_t len = 0;
+
+    if (NULL == str) {
+        return md_snapshot_put_u32(buf, MD_SNAPSHOT_NULL_STR);
+    }
+    len = strlen(str);
+    rc = md_snapshot_put_u32(buf, len);
+    if (SR_ERR_OK == rc) {
+        rc = md_snapshot_put(buf, str, len);
+    }
+    return rc;
+}
+
+static int
+md_snapshot_compare_idx(const void *a, const void *b)
+{
+    const md_snapshot_idx_t *idx_a = (const md_snapshot_idx_t *)a, *idx_b = (const md_snapshot_idx_t *)b;
+
+    if (idx_a->module == idx_b->module) {
+        return 0;
+    }
+    return (uintptr_t)idx_a->module < (uintptr_t)idx_b->module ? -1 : 1;
+}
+
+/*
+ * @brief Append index of the given module into the snapshot buffer.
+ */
+static int
+md_snapshot_put_module_idx(md_snapshot_buf_t *buf, const md_snapshot_idx_t *index, uint32_t module_cnt,
+        const md_module_t *module)
+{
+    md_snapshot_idx_t key = { module, 0 }, *found = NULL;
+
+    found = bsearch(&key, index, module_cnt, sizeof *index, md_snapshot_compare_idx);
+    if (NULL == found) {
+        SR_LOG_ERR("Module '%s' referenced from the dependency graph is not known.", module->name);
+        return SR_ERR_INTERNAL;
+    }
+    return md_snapshot_put_u32(buf, found->idx);
+}
+
+/*
+ * @brief Serialize a list of dependencies (md_dep_t *).
+ */
+static int
+md_snapshot_put_deps(md_snapshot_buf_t *buf, const md_snapshot_idx_t *index, uint32_t module_cnt, sr_llist_t *deps)
+{
+    int rc = SR_ERR_OK;
+    sr_llist_node_t *node = NULL, *orig_node = NULL;
+    md_dep_t *dep = NULL;
+    uint32_t cnt = 0;
+
+    for (node = deps->first; NULL != node; node = node->next) {
+        ++cnt;
+    }
+    rc = md_snapshot_put_u32(buf, cnt);
+
+    for (node = deps->first; SR_ERR_OK == rc && NULL != node; node = node->next) {
+        dep = (md_dep_t *)node->data;
+        rc = md_snapshot_put_u8(buf, dep->type);
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_put_u8(buf, dep->direct);
+        }
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_put_module_idx(buf, index, module_cnt, dep->dest);
+        }
+        cnt = 0;
+        for (orig_node = dep->orig_modules->first; NULL != orig_node; orig_node = orig_node->next) {
+            ++cnt;
+        }
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_put_u32(buf, cnt);
+        }
+        for (orig_node = dep->orig_modules->first; SR_ERR_OK == rc && NULL != orig_node; orig_node = orig_node->next) {
+            rc = md_snapshot_put_module_idx(buf, index, module_cnt, (md_module_t *)orig_node->data);
+        }
+    }
+    return rc;
+}
+
+/*
+ * @brief Serialize a list of subtree references (md_subtree_ref_t *).
+ */
+static int
+md_snapshot_put_subtree_refs(md_snapshot_buf_t *buf, const md_snapshot_idx_t *index, uint32_t module_cnt,
+        sr_llist_t *subtree_refs)
+{
+    int rc = SR_ERR_OK;
+    sr_llist_node_t *node = NULL;
+    md_subtree_ref_t *subtree_ref = NULL;
+    uint32_t cnt = 0;
+
+    for (node = subtree_refs->first; NULL != node; node = node->next) {
+        ++cnt;
+    }
+    rc = md_snapshot_put_u32(buf, cnt);
+
+    for (node = subtree_refs->first; SR_ERR_OK == rc && NULL != node; node = node->next) {
+        subtree_ref = (md_subtree_ref_t *)node->data;
+        rc = md_snapshot_put_str(buf, subtree_ref->xpath);
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_put_module_idx(buf, index, module_cnt, subtree_ref->orig);
+        }
+    }
+    return rc;
+}
+
+/**
+ * @brief Store the (transitively-closed) dependency graph into a binary snapshot file, so that
+ * subsequent read-only initializations can skip parsing of the internal data file and the closure.
+ * The snapshot is first written into a temporary file which is then atomically renamed.
+ *
+ * @param [in] md_ctx Module Dependencies context
+ * @param [in] data_stat Status of the internal data file the graph was loaded from / flushed into.
+ * @return Error code (SR_ERR_OK on success)
+ */
+static int
+md_snapshot_store(md_ctx_t *md_ctx, const struct stat *data_stat)
+{
+    int rc = SR_ERR_OK;
+    md_snapshot_buf_t buf = { 0, };
+    md_snapshot_hdr_t hdr = { 0, };
+    md_snapshot_idx_t *index = NULL;
+    sr_llist_node_t *node = NULL;
+    md_module_t *module = NULL;
+    uint32_t module_cnt = 0, i = 0;
+    uint8_t flags = 0;
+    char *tmp_filepath = NULL;
+    size_t written = 0;
+    ssize_t ret = 0;
+    int fd = -1;
+
+    CHECK_NULL_ARG3(md_ctx, md_ctx->snapshot_filepath, data_stat);
+
+    for (node = md_ctx->modules->first; NULL != node; node = node->next) {
+        ++module_cnt;
+    }
+
+    /* map module pointers to their positions in the list */
+    if (module_cnt > 0) {
+        index = calloc(module_cnt, sizeof *index);
+        CHECK_NULL_NOMEM_GOTO(index, rc, cleanup);
+        for (node = md_ctx->modules->first, i = 0; NULL != node; node = node->next, ++i) {
+            index[i].module = (md_module_t *)node->data;
+            index[i].idx = i;
+        }
+        qsort(index, module_cnt, sizeof *index, md_snapshot_compare_idx);
+    }
+
+    md_snapshot_fill_hdr(data_stat, module_cnt, &hdr);
+    rc = md_snapshot_put(&buf, &hdr, sizeof hdr);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to serialize dependency graph header.");
+
+    /* module attributes */
+    for (node = md_ctx->modules->first; SR_ERR_OK == rc && NULL != node; node = node->next) {
+        module = (md_module_t *)node->data;
+        rc = md_snapshot_put_str(&buf, module->name);
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_put_str(&buf, module->revision_date);
+        }
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_put_str(&buf, module->prefix);
+        }
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_put_str(&buf, module->ns);
+        }
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_put_str(&buf, module->filepath);
+        }
+        flags = (module->latest_revision ? 0x01 : 0) | (module->submodule ? 0x02 : 0) |
+                (module->installed ? 0x04 : 0) | (module->implemented ? 0x08 : 0) |
+                (module->has_data ? 0x10 : 0) | (module->has_persist ? 0x20 : 0);
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_put_u8(&buf, flags);
+        }
+    }
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to serialize module attributes.");
+
+    /* edges and subtree references */
+    for (node = md_ctx->modules->first; SR_ERR_OK == rc && NULL != node; node = node->next) {
+        module = (md_module_t *)node->data;
+        rc = md_snapshot_put_deps(&buf, index, module_cnt, module->deps);
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_put_deps(&buf, index, module_cnt, module->inv_deps);
+        }
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_put_subtree_refs(&buf, index, module_cnt, module->inst_ids);
+        }
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_put_subtree_refs(&buf, index, module_cnt, module->op_data_subtrees);
+        }
+    }
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to serialize module dependencies.");
+
+    /* write into a temporary file and rename */
+    rc = sr_str_join(md_ctx->snapshot_filepath, SR_TMP_FILE_EXT "XXXXXX", &tmp_filepath);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to allocate temporary file name.");
+
+    fd = mkstemp(tmp_filepath);
+    if (-1 == fd) {
+        SR_LOG_DBG("Unable to create temporary file for " MD_SNAPSHOT_FILENAME ": %s", sr_strerror_safe(errno));
+        rc = SR_ERR_IO;
+        goto cleanup;
+    }
+    fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+
+    while (written < buf.used) {
+        ret = write(fd, buf.data + written, buf.used - written);
+        if (-1 == ret) {
+            if (EINTR == errno) {
+                continue;
+            }
+            SR_LOG_WRN("Unable to write " MD_SNAPSHOT_FILENAME ": %s", sr_strerror_safe(errno));
+            rc = SR_ERR_IO;
+            goto cleanup;
+        }
+        written += ret;
+    }
+
+    close(fd);
+    fd = -1;
+    if (-1 == rename(tmp_filepath, md_ctx->snapshot_filepath)) {
+        SR_LOG_WRN("Unable to rename " MD_SNAPSHOT_FILENAME ": %s", sr_strerror_safe(errno));
+        rc = SR_ERR_IO;
+        goto cleanup;
+    }
+    SR_LOG_DBG("Dependency graph with %"PRIu32" modules stored into " MD_SNAPSHOT_FILENAME ".", module_cnt);
+
+cleanup:
+    if (-1 != fd) {
+        close(fd);
+    }
+    if (SR_ERR_OK != rc && NULL != tmp_filepath) {
+        unlink(tmp_filepath);
+    }
+    free(tmp_filepath);
+    free(index);
+    free(buf.data);
+    return rc;
+}
+
+/*
+ * @brief Read raw bytes from the snapshot, fails if the snapshot is truncated.
+ */
+static int
+md_snapshot_get(md_snapshot_cur_t *cur, void *dst, size_t len)
+{
+    if (len > cur->size - cur->pos) {
+        SR_LOG_WRN_MSG(MD_SNAPSHOT_FILENAME " is truncated.");
+        return SR_ERR_INTERNAL;
+    }
+    memcpy(dst, cur->data + cur->pos, len);
+    cur->pos += len;
+    return SR_ERR_OK;
+}
+
+static int
+md_snapshot_get_u32(md_snapshot_cur_t *cur, uint32_t *value)
+{
+    return md_snapshot_get(cur, value, sizeof *value);
+}
+
+static int
+md_snapshot_get_u8(md_snapshot_cur_t *cur, uint8_t *value)
+{
+    return md_snapshot_get(cur, value, sizeof *value);
+}
+
+/*
+ * @brief Read a length-prefixed string (or NULL) from the snapshot.
+ */
+static int
+md_snapshot_get_str(md_snapshot_cur_t *cur, char **str)
+{
+    int rc = SR_ERR_OK;
+    uint32_t len = 0;
+
+    *str = NULL;
+    rc = md_snapshot_get_u32(cur, &len);
+    if (SR_ERR_OK != rc || MD_SNAPSHOT_NULL_STR == len) {
+        return rc;
+    }
+    if (len > cur->size - cur->pos) {
+        SR_LOG_WRN_MSG(MD_SNAPSHOT_FILENAME " is truncated.");
+        return SR_ERR_INTERNAL;
+    }
+    *str = strndup((const char *)cur->data + cur->pos, len);
+    CHECK_NULL_NOMEM_RETURN(*str);
+    cur->pos += len;
+    return SR_ERR_OK;
+}
+
+/*
+ * @brief Read a module index from the snapshot and translate it to the module.
+ */
+static int
+md_snapshot_get_module(md_snapshot_cur_t *cur, md_module_t **modules, uint32_t module_cnt, md_module_t **module)
+{
+    int rc = SR_ERR_OK;
+    uint32_t idx = 0;
+
+    rc = md_snapshot_get_u32(cur, &idx);
+    if (SR_ERR_OK != rc) {
+        return rc;
+    }
+    if (idx >= module_cnt) {
+        SR_LOG_WRN("Invalid module index %"PRIu32" in " MD_SNAPSHOT_FILENAME ".", idx);
+        return SR_ERR_INTERNAL;
+    }
+    *module = modules[idx];
+    return SR_ERR_OK;
+}
+
+/*
+ * @brief Deserialize a list of dependencies (md_dep_t *).
+ */
+static int
+md_snapshot_get_deps(md_snapshot_cur_t *cur, md_module_t **modules, uint32_t module_cnt, sr_llist_t *deps)
+{
+    int rc = SR_ERR_OK;
+    md_module_t *dest = NULL, *orig = NULL;
+    uint32_t dep_cnt = 0, orig_cnt = 0;
+    uint8_t type = 0, direct = 0;
+
+    rc = md_snapshot_get_u32(cur, &dep_cnt);
+    for (uint32_t i = 0; SR_ERR_OK == rc && i < dep_cnt; ++i) {
+        rc = md_snapshot_get_u8(cur, &type);
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_get_u8(cur, &direct);
+        }
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_get_module(cur, modules, module_cnt, &dest);
+        }
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_get_u32(cur, &orig_cnt);
+        }
+        if (SR_ERR_OK != rc) {
+            break;
+        }
+        if (MD_DEP_NONE == type || MD_DEP_DATA < type) {
+            SR_LOG_WRN("Invalid dependency type %d in " MD_SNAPSHOT_FILENAME ".", (int)type);
+            return SR_ERR_INTERNAL;
+        }
+        if (0 == orig_cnt) {
+            rc = md_add_dependency(deps, type, dest, direct, NULL);
+        }
+        for (uint32_t j = 0; SR_ERR_OK == rc && j < orig_cnt; ++j) {
+            rc = md_snapshot_get_module(cur, modules, module_cnt, &orig);
+            if (SR_ERR_OK == rc) {
+                rc = md_add_dependency(deps, type, dest, direct, orig);
+            }
+        }
+    }
+    return rc;
+}
+
+/*
+ * @brief Deserialize a list of subtree references (md_subtree_ref_t *).
+ */
+static int
+md_snapshot_get_subtree_refs(md_snapshot_cur_t *cur, md_module_t **modules, uint32_t module_cnt,
+        sr_llist_t *subtree_refs)
+{
+    int rc = SR_ERR_OK;
+    md_subtree_ref_t *subtree_ref = NULL;
+    uint32_t cnt = 0;
+
+    rc = md_snapshot_get_u32(cur, &cnt);
+    for (uint32_t i = 0; SR_ERR_OK == rc && i < cnt; ++i) {
+        subtree_ref = calloc(1, sizeof *subtree_ref);
+        CHECK_NULL_NOMEM_RETURN(subtree_ref);
+        rc = md_snapshot_get_str(cur, &subtree_ref->xpath);
+        if (SR_ERR_OK == rc && NULL == subtree_ref->xpath) {
+            rc = SR_ERR_INTERNAL;
+        }
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_get_module(cur, modules, module_cnt, &subtree_ref->orig);
+        }
+        if (SR_ERR_OK == rc) {
+            rc = sr_llist_add_new(subtree_refs, subtree_ref);
+        }
+        if (SR_ERR_OK != rc) {
+            free(subtree_ref->xpath);
+            free(subtree_ref);
+        }
+    }
+    return rc;
+}
+
+/**
+ * @brief Load the dependency graph from the binary snapshot, provided that the snapshot
+ * was created from the current version of the internal data file.
+ *
+ * @param [in] md_ctx Module Dependencies context with empty list and trees of modules.
+ * @param [in] data_fd File descriptor of the (locked) internal data file.
+ * @return SR_ERR_OK if the graph was loaded, SR_ERR_NOT_FOUND if there is no usable (matching and
+ * consistent) snapshot, in which case the context is left untouched, other error code otherwise.
+ */
+static int
+md_snapshot_load(md_ctx_t *md_ctx, int data_fd)
+{
+    int rc = SR_ERR_OK;
+    struct stat data_stat = { 0, }, snapshot_stat = { 0, };
+    md_snapshot_hdr_t expected = { 0, }, hdr = { 0, };
+    md_snapshot_cur_t cur = { 0, };
+    md_module_t **modules = NULL, *module = NULL;
+    void *mapped = MAP_FAILED;
+    uint8_t flags = 0;
+    uint32_t i = 0;
+    bool handed_over = false;
+    int fd = -1;
+
+    CHECK_NULL_ARG2(md_ctx, md_ctx->snapshot_filepath);
+
+    if (-1 == fstat(data_fd, &data_stat)) {
+        SR_LOG_WRN("Unable to stat " MD_DATA_FILENAME ": %s", sr_strerror_safe(errno));
+        return SR_ERR_NOT_FOUND;
+    }
+
+    fd = open(md_ctx->snapshot_filepath, O_RDONLY);
+    if (-1 == fd) {
+        SR_LOG_DBG("Unable to open " MD_SNAPSHOT_FILENAME ": %s", sr_strerror_safe(errno));
+        return SR_ERR_NOT_FOUND;
+    }
+    if (-1 == fstat(fd, &snapshot_stat) || (size_t)snapshot_stat.st_size < sizeof hdr) {
+        close(fd);
+        return SR_ERR_NOT_FOUND;
+    }
+    mapped = mmap(NULL, snapshot_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == mapped) {
+        SR_LOG_WRN("Unable to map " MD_SNAPSHOT_FILENAME ": %s", sr_strerror_safe(errno));
+        return SR_ERR_NOT_FOUND;
+    }
+    cur.data = mapped;
+    cur.size = snapshot_stat.st_size;
+
+    /* the snapshot has to match the current version of the data file */
+    rc = md_snapshot_get(&cur, &hdr, sizeof hdr);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to read " MD_SNAPSHOT_FILENAME " header.");
+    md_snapshot_fill_hdr(&data_stat, hdr.module_cnt, &expected);
+    if (0 != memcmp(&hdr, &expected, sizeof hdr)) {
+        SR_LOG_DBG_MSG(MD_SNAPSHOT_FILENAME " is outdated.");
+        rc = SR_ERR_NOT_FOUND;
+        goto cleanup;
+    }
+    if ((uint64_t)hdr.module_cnt * (5 * sizeof(uint32_t) + 1) > cur.size - cur.pos) {
+        SR_LOG_WRN_MSG(MD_SNAPSHOT_FILENAME " is truncated.");
+        rc = SR_ERR_INTERNAL;
+        goto cleanup;
+    }
+
+    /* module attributes */
+    if (hdr.module_cnt > 0) {
+        modules = calloc(hdr.module_cnt, sizeof *modules);
+        CHECK_NULL_NOMEM_GOTO(modules, rc, cleanup);
+    }
+    for (i = 0; i < hdr.module_cnt; ++i) {
+        rc = md_alloc_module(&modules[i]);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to allocate an instance of md_module_t structure.");
+        module = modules[i];
+        rc = md_snapshot_get_str(&cur, &module->name);
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_get_str(&cur, &module->revision_date);
+        }
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_get_str(&cur, &module->prefix);
+        }
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_get_str(&cur, &module->ns);
+        }
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_get_str(&cur, &module->filepath);
+        }
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_get_u8(&cur, &flags);
+        }
+        if (SR_ERR_OK == rc && (NULL == module->name || NULL == module->revision_date)) {
+            rc = SR_ERR_INTERNAL;
+        }
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to read module attributes from " MD_SNAPSHOT_FILENAME ".");
+        module->latest_revision = (flags & 0x01);
+        module->submodule = (flags & 0x02);
+        module->installed = (flags & 0x04);
+        module->implemented = (flags & 0x08);
+        module->has_data = (flags & 0x10);
+        module->has_persist = (flags & 0x20);
+    }
+
+    /* edges and subtree references */
+    for (i = 0; i < hdr.module_cnt; ++i) {
+        module = modules[i];
+        rc = md_snapshot_get_deps(&cur, modules, hdr.module_cnt, module->deps);
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_get_deps(&cur, modules, hdr.module_cnt, module->inv_deps);
+        }
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_get_subtree_refs(&cur, modules, hdr.module_cnt, module->inst_ids);
+        }
+        if (SR_ERR_OK == rc) {
+            rc = md_snapshot_get_subtree_refs(&cur, modules, hdr.module_cnt, module->op_data_subtrees);
+        }
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to read module dependencies from " MD_SNAPSHOT_FILENAME ".");
+    }
+    if (cur.pos != cur.size) {
+        SR_LOG_WRN_MSG(MD_SNAPSHOT_FILENAME " contains trailing data.");
+        rc = SR_ERR_INTERNAL;
+        goto cleanup;
+    }
+
+    /* hand the modules over to the context */
+    handed_over = true;
+    for (i = 0; i < hdr.module_cnt; ++i) {
+        module = modules[i];
+        rc = sr_llist_add_new(md_ctx->modules, module);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to insert instance of (md_module_t *) into a linked-list.");
+        module->ll_node = md_ctx->modules->last;
+        modules[i] = NULL; /*< owned by the context from now on */
+        rc = sr_btree_insert(md_ctx->modules_btree, module);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to insert instance of (md_module_t *) into a balanced tree.");
+        if (!module->submodule && module->implemented && module->ns) {
+            rc = sr_btree_insert(md_ctx->modules_btree_by_ns, module);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to insert instance of (md_module_t *) into a balanced tree.");
+        }
+    }
+    SR_LOG_DBG("Dependency graph with %"PRIu32" modules loaded from " MD_SNAPSHOT_FILENAME ".", hdr.module_cnt);
+
+cleanup:
+    if (SR_ERR_OK != rc && !handed_over) {
+        /* unusable snapshot, fall back to the data file */
+        rc = SR_ERR_NOT_FOUND;
+    }
+    for (i = 0; NULL != modules && i < hdr.module_cnt; ++i) {
+        md_free_module(modules[i]);
+    }
+    free(modules);
+    munmap(mapped, snapshot_stat.st_size);
+    return rc;
+}
+
 int
 md_init(const char *schema_search_dir,
         const char *internal_schema_search_dir, const char *internal_data_search_dir, bool write_lock,
@@ -1029,10 +1708,6 @@ md_init(const char *schema_search_dir,
     /* Initialize pthread mutex */
     pthread_rwlock_init(&ctx->lock, NULL);
 
-    /* Create libyang context */
-    ctx->ly_ctx = ly_ctx_new(schema_search_dir, 0);
-    CHECK_NULL_NOMEM_GOTO(ctx->ly_ctx, rc, fail);
-
     /* Copy schema search directory */
     ctx->schema_search_dir = strdup(schema_search_dir);
     CHECK_NULL_NOMEM_GOTO(ctx->schema_search_dir, rc, fail);
@@ -1059,13 +1734,8 @@ md_init(const char *schema_search_dir,
     CHECK_RC_MSG_GOTO(rc, fail, "Unable to get the filepath of " MD_SCHEMA_FILENAME " data file.");
     rc = md_get_data_file_path(internal_data_search_dir, &data_filepath);
     CHECK_RC_MSG_GOTO(rc, fail, "Unable to get the filepath of " MD_DATA_FILENAME " schema file.");
-
-    /* load internal schema for model dependencies */
-    module_schema = lys_parse_path(ctx->ly_ctx, schema_filepath, LYS_IN_YANG);
-    if (NULL == module_schema) {
-        SR_LOG_ERR("Unable to parse " MD_SCHEMA_FILENAME " schema file: %s", ly_errmsg(ctx->ly_ctx));
-        goto fail;
-    }
+    rc = md_get_snapshot_file_path(internal_data_search_dir, &ctx->snapshot_filepath);
+    CHECK_RC_MSG_GOTO(rc, fail, "Unable to get the filepath of " MD_SNAPSHOT_FILENAME " file.");
 
     /* create directory for internal data files if it doesn't exist yet */
     if (-1 == stat(internal_data_search_dir, &file_stat)) {
@@ -1091,20 +1761,38 @@ md_init(const char *schema_search_dir,
         goto fail;
     }
 
+    /* read-only access: try to load the graph from the snapshot first */
+    if (!write_lock) {
+        rc = md_snapshot_load(ctx, ctx->fd);
+        if (SR_ERR_OK == rc) {
+            close(ctx->fd);
+            ctx->fd = -1;
+            goto cleanup;
+        } else if (SR_ERR_NOT_FOUND != rc) {
+            goto fail;
+        }
+        rc = SR_ERR_OK;
+    }
+
+    /* Create libyang context */
+    ctx->ly_ctx = ly_ctx_new(schema_search_dir, 0);
+    CHECK_NULL_NOMEM_GOTO(ctx->ly_ctx, rc, fail);
+
+    /* load internal schema for model dependencies */
+    module_schema = lys_parse_path(ctx->ly_ctx, schema_filepath, LYS_IN_YANG);
+    if (NULL == module_schema) {
+        SR_LOG_ERR("Unable to parse " MD_SCHEMA_FILENAME " schema file: %s", ly_errmsg(ctx->ly_ctx));
+        goto fail;
+    }
+
     /* parse the data file */
     ly_errno = LY_SUCCESS;
-    ctx->data_tree = lyd_parse_fd(ctx->ly_ctx, ctx->fd, SR_FILE_FORMAT_LY, LYD_OPT_STRICT | LYD_OPT_CONFIG);
+    ctx->data_tree = lyd_parse_fd(ctx->ly_ctx, ctx->fd, sr_data_file_format(ctx->fd), LYD_OPT_STRICT | LYD_OPT_CONFIG);
     if (NULL == ctx->data_tree && LY_SUCCESS != ly_errno) {
         SR_LOG_ERR("Unable to parse " MD_DATA_FILENAME " data file: %s", ly_errmsg(ctx->ly_ctx));
         goto fail;
     }
 
-    /* close file if it is no longer needed */
-    if (!write_lock) {
-        close(ctx->fd);
-        ctx->fd = -1;
-    }
-
     /* traverse data tree and construct dependency graph in-memory */
     /* first process module attributes skipping nested structures */
     if (ctx->data_tree) {
@@ -1213,6 +1901,17 @@ md_init(const char *schema_search_dir,
         goto fail;
     }
 
+    if (!write_lock) {
+        /* store the snapshot for the next read-only initialization (best-effort, still under the file lock) */
+        if (0 == fstat(ctx->fd, &file_stat)) {
+            md_snapshot_store(ctx, &file_stat);
+        }
+        /* close file if it is no longer needed */
+        close(ctx->fd);
+        ctx->fd = -1;
+    }
+
+cleanup:
     rc = SR_ERR_OK;
     free(schema_filepath);
     free(data_filepath);
@@ -1253,6 +1952,7 @@ md_destroy(md_ctx_t *md_ctx)
         if (md_ctx->schema_search_dir) {
             free(md_ctx->schema_search_dir);
         }
+        free(md_ctx->snapshot_filepath);
         if (md_ctx->data_tree) {
             lyd_free_withsiblings(md_ctx->data_tree);
         }
@@ -2788,10 +3488,12 @@ md_remove_modules_internal(md_ctx_t *md_ctx, const char * const *names, const ch
 
         /* now remove the module entry from the data tree */
         node_data = module->ly_data;
-        if (md_ctx->data_tree == node_data) {
-            md_ctx->data_tree = node_data->next;
+        if (NULL != node_data) {
+            if (md_ctx->data_tree == node_data) {
+                md_ctx->data_tree = node_data->next;
+            }
+            lyd_free(node_data);
         }
-        lyd_free(node_data);
 
         /* finally remove the module itself */
         sr_llist_rm(md_ctx->modules, module->ll_node);
@@ -2834,12 +3536,17 @@ int
 md_flush(md_ctx_t *md_ctx)
 {
     int ret = 0;
+    struct stat data_stat = { 0, };
 
     if (-1 == md_ctx->fd) {
         SR_LOG_ERR_MSG(MD_DATA_FILENAME " is not open with write-access and write-lock.");
         return SR_ERR_INVAL_ARG;
     }
 
+    /* invalidate the snapshot first, the fingerprint of the data file may not change
+     * if it is flushed repeatedly within the resolution of its modification time */
+    unlink(md_ctx->snapshot_filepath);
+
     ret = ftruncate(md_ctx->fd, 0);
     CHECK_ZERO_MSG_RETURN(ret, SR_ERR_INTERNAL, "Failed to truncate the internal data file '" MD_DATA_FILENAME"'.");
 
@@ -2849,5 +3556,10 @@ md_flush(md_ctx_t *md_ctx)
         return SR_ERR_INTERNAL;
     }
 
+    /* refresh the snapshot (best-effort) */
+    if (0 == fstat(md_ctx->fd, &data_stat)) {
+        md_snapshot_store(md_ctx, &data_stat);
+    }
+
     return SR_ERR_OK;
 }
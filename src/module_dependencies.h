@@ -122,7 +122,11 @@ typedef struct md_ctx_s {
     int fd;                          /**< file descriptor associated with sysrepo-module-dependencies.xml,
                                           held only if the file is locked for RW-access, otherwise has value "-1". */
 
-    struct ly_ctx *ly_ctx;           /**< libyang context used for manipulation with the internal data file for dependencies. */
+    char *snapshot_filepath;         /**< Path to the binary snapshot of the transitively-closed dependency graph. */
+
+    struct ly_ctx *ly_ctx;           /**< libyang context used for manipulation with the internal data file for dependencies.
+                                          NULL if the graph was loaded from the snapshot, in which case ::md_ctx_t::data_tree
+                                          is not maintained (the context cannot be flushed anyway). */
 
     struct lyd_node *data_tree;      /**< Graph data as loaded by libyang (not transitively closed).
                                           Also reflects changes made using ::md_insert_module and ::md_remove_modules */
@@ -148,7 +152,9 @@ typedef struct md_ctx_s {
  * @param [in] internal_data_search_dir Path to the directory with internal data files
  *             (e.g. SR_INTERNAL_DATA_SEARCH_DIR)
  * @param [in] write_lock If set to "true" the internal data file will be kept open and locked
- *             for editing until the context is destroyed
+ *             for editing until the context is destroyed.
+ *             If set to "false", the graph is loaded from a binary snapshot if there is one matching
+ *             the current version of the internal data file, otherwise the snapshot is (re)created.
  * @param [out] md_ctx Context reference output location
  */
 int md_init(const char *schema_search_dir,
@@ -406,6 +406,226 @@ nacm_get_data_targets(nacm_data_val_ctx_t *nacm_data_val_ctx, uint16_t rule_id)
     return sr_btree_search(nacm_data_val_ctx->data_targets, &targets_lookup);
 }
 
+/**
+ * @brief Deallocate all memory associated with nacm_rule_set_t (rules themselves are owned by rule-lists).
+ */
+static void
+nacm_free_rule_set(void *rule_set_ptr)
+{
+    if (NULL == rule_set_ptr) {
+        return;
+    }
+
+    nacm_rule_set_t *rule_set = (nacm_rule_set_t *)rule_set_ptr;
+    sr_list_cleanup(rule_set->rules);
+    free(rule_set);
+}
+
+/**
+ * @brief Compare two instances of nacm_rule_set_t structure.
+ */
+static int
+nacm_compare_rule_sets(const void *rule_set1_ptr, const void *rule_set2_ptr)
+{
+    if (NULL == rule_set1_ptr || NULL == rule_set2_ptr) {
+        return 0;
+    }
+
+    nacm_rule_set_t *rule_set1 = (nacm_rule_set_t *)rule_set1_ptr;
+    nacm_rule_set_t *rule_set2 = (nacm_rule_set_t *)rule_set2_ptr;
+    if (rule_set1->data_hash == rule_set2->data_hash) {
+        return 0;
+    }
+    return rule_set1->data_hash < rule_set2->data_hash ? -1 : 1;
+}
+
+/**
+ * @brief Add a data-oriented rule into the index of NACM rules. Rules have to be added in the order of their IDs.
+ */
+static int
+nacm_index_rule(nacm_ctx_t *nacm_ctx, nacm_rule_t *rule)
+{
+    int rc = SR_ERR_OK;
+    nacm_rule_set_t rule_set_lookup = { 0, NULL }, *rule_set = NULL;
+    CHECK_NULL_ARG2(nacm_ctx, rule);
+
+    if (NACM_RULE_DATA != rule->type && NACM_RULE_NOTSET != rule->type) {
+        /* not used for data access validation */
+        return SR_ERR_OK;
+    }
+
+    if (NULL == rule->data.path || 0 == strcmp("/", rule->data.path)) {
+        return sr_list_add(nacm_ctx->module_rules, rule);
+    }
+
+    rule_set_lookup.data_hash = rule->data_hash;
+    rule_set = sr_btree_search(nacm_ctx->data_rules, &rule_set_lookup);
+    if (NULL == rule_set) {
+        rule_set = calloc(1, sizeof *rule_set);
+        CHECK_NULL_NOMEM_RETURN(rule_set);
+        rule_set->data_hash = rule->data_hash;
+        rc = sr_list_init(&rule_set->rules);
+        if (SR_ERR_OK == rc) {
+            rc = sr_btree_insert(nacm_ctx->data_rules, rule_set);
+        }
+        if (SR_ERR_OK != rc) {
+            nacm_free_rule_set(rule_set);
+            SR_LOG_ERR_MSG("Failed to insert a new NACM rule set into the index.");
+            return rc;
+        }
+    }
+
+    return sr_list_add(rule_set->rules, rule);
+}
+
+/**
+ * @brief Deallocate all memory associated with nacm_node_rules_t.
+ */
+static void
+nacm_free_node_rules(void *node_rules_ptr)
+{
+    if (NULL == node_rules_ptr) {
+        return;
+    }
+
+    nacm_node_rules_t *node_rules = (nacm_node_rules_t *)node_rules_ptr;
+    free(node_rules->rules);
+    free(node_rules);
+}
+
+/**
+ * @brief Compare two instances of nacm_node_rules_t structure.
+ */
+static int
+nacm_compare_node_rules(const void *node_rules1_ptr, const void *node_rules2_ptr)
+{
+    if (NULL == node_rules1_ptr || NULL == node_rules2_ptr) {
+        return 0;
+    }
+
+    nacm_node_rules_t *node_rules1 = (nacm_node_rules_t *)node_rules1_ptr;
+    nacm_node_rules_t *node_rules2 = (nacm_node_rules_t *)node_rules2_ptr;
+    if (node_rules1->schema == node_rules2->schema) {
+        return 0;
+    }
+    return node_rules1->schema < node_rules2->schema ? -1 : 1;
+}
+
+/**
+ * @brief Compare two NACM rules by their IDs (for qsort).
+ */
+static int
+nacm_compare_rule_ids(const void *rule1_ptr, const void *rule2_ptr)
+{
+    const nacm_rule_t *rule1 = *(const nacm_rule_t **)rule1_ptr;
+    const nacm_rule_t *rule2 = *(const nacm_rule_t **)rule2_ptr;
+    return (int)rule1->id - (int)rule2->id;
+}
+
+/**
+ * @brief Check if the given indexed rule should be considered for data nodes of the given module
+ * within the data validation request.
+ */
+static bool
+nacm_rule_is_candidate(nacm_data_val_ctx_t *nacm_data_val_ctx, const nacm_rule_t *rule, const char *module_name)
+{
+    bool bit_val = false;
+
+    if (SR_ERR_OK != sr_bitset_get(nacm_data_val_ctx->rule_lists, rule->rule_list_idx, &bit_val) || false == bit_val) {
+        /* rule-list doesn't apply to this request */
+        return false;
+    }
+    if (0 != strcmp("*", rule->module) && 0 != strcmp(module_name, rule->module)) {
+        /* this rule doesn't apply to the module where the node is defined */
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Get the set of rules that may apply to data nodes of the given schema node. The set is compiled
+ * from the index of NACM rules on the first use within the data validation request and then re-used.
+ */
+static int
+nacm_get_node_rules(nacm_data_val_ctx_t *nacm_data_val_ctx, struct lys_node *schema, nacm_node_rules_t **node_rules_p)
+{
+    int rc = SR_ERR_OK;
+    uint16_t depth = 0;
+    nacm_ctx_t *nacm_ctx = NULL;
+    struct lys_node *ancestor = NULL;
+    sr_list_t *candidates = NULL;
+    nacm_rule_t *rule = NULL;
+    nacm_rule_set_t rule_set_lookup = { 0, NULL }, *rule_set = NULL;
+    nacm_node_rules_t node_rules_lookup = { schema, NULL, 0 }, *node_rules = NULL;
+    CHECK_NULL_ARG4(nacm_data_val_ctx, nacm_data_val_ctx->nacm_ctx, schema, node_rules_p);
+
+    node_rules = sr_btree_search(nacm_data_val_ctx->node_rules, &node_rules_lookup);
+    if (NULL != node_rules) {
+        *node_rules_p = node_rules;
+        return SR_ERR_OK;
+    }
+
+    nacm_ctx = nacm_data_val_ctx->nacm_ctx;
+    node_rules = calloc(1, sizeof *node_rules);
+    CHECK_NULL_NOMEM_RETURN(node_rules);
+    node_rules->schema = schema;
+
+    rc = sr_list_init(&candidates);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to initialize list.");
+
+    if (NULL != nacm_data_val_ctx->rule_lists) {
+        /* rules applied to entire modules */
+        for (size_t i = 0; i < nacm_ctx->module_rules->count; ++i) {
+            rule = (nacm_rule_t *)nacm_ctx->module_rules->data[i];
+            if (nacm_rule_is_candidate(nacm_data_val_ctx, rule, schema->module->name)) {
+                rc = sr_list_add(candidates, rule);
+                CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to add item into a list.");
+            }
+        }
+
+        /* rules with a path referencing this schema node or any of its ancestors */
+        ancestor = schema;
+        depth = dm_get_node_data_depth(schema);
+        while (NULL != ancestor) {
+            rule_set_lookup.data_hash = dm_get_node_xpath_hash(ancestor);
+            rule_set = sr_btree_search(nacm_ctx->data_rules, &rule_set_lookup);
+            for (size_t i = 0; NULL != rule_set && i < rule_set->rules->count; ++i) {
+                rule = (nacm_rule_t *)rule_set->rules->data[i];
+                if (depth == rule->data_depth && nacm_rule_is_candidate(nacm_data_val_ctx, rule, schema->module->name)) {
+                    rc = sr_list_add(candidates, rule);
+                    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to add item into a list.");
+                }
+            }
+            if (0 == depth) {
+                break;
+            }
+            ancestor = sr_lys_node_get_data_parent(ancestor, false);
+            --depth;
+        }
+    }
+
+    /* order the candidates by their priority */
+    if (candidates->count > 0) {
+        node_rules->rules = calloc(candidates->count, sizeof *node_rules->rules);
+        CHECK_NULL_NOMEM_GOTO(node_rules->rules, rc, cleanup);
+        memcpy(node_rules->rules, candidates->data, candidates->count * sizeof *node_rules->rules);
+        node_rules->count = candidates->count;
+        qsort(node_rules->rules, node_rules->count, sizeof *node_rules->rules, nacm_compare_rule_ids);
+    }
+
+    rc = sr_btree_insert(nacm_data_val_ctx->node_rules, node_rules);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to insert item into a binary tree.");
+
+cleanup:
+    sr_list_cleanup(candidates);
+    if (SR_ERR_OK != rc) {
+        nacm_free_node_rules(node_rules);
+    } else {
+        *node_rules_p = node_rules;
+    }
+    return rc;
+}
+
 /**
  * @brief Get NACM flag from schema node.
  */
@@ -450,7 +670,8 @@ nacm_load_config(nacm_ctx_t *nacm_ctx, const sr_datastore_t ds)
     struct lyd_node_leaf_list *leaf = NULL;
     CHECK_NULL_ARG(nacm_ctx);
 
-    if (NULL != nacm_ctx->groups || NULL != nacm_ctx->users || NULL != nacm_ctx->rule_lists) {
+    if (NULL != nacm_ctx->groups || NULL != nacm_ctx->users || NULL != nacm_ctx->rule_lists ||
+        NULL != nacm_ctx->data_rules || NULL != nacm_ctx->module_rules) {
         return SR_ERR_INVAL_ARG;
     }
 
@@ -483,6 +704,12 @@ nacm_load_config(nacm_ctx_t *nacm_ctx, const sr_datastore_t ds)
     rc = sr_list_init(&nacm_ctx->rule_lists);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to initialize list with NACM rule-lists.");
 
+    rc = sr_btree_init(nacm_compare_rule_sets, nacm_free_rule_set, &nacm_ctx->data_rules);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to initialize binary tree with NACM rule sets.");
+
+    rc = sr_list_init(&nacm_ctx->module_rules);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to initialize list with module-wide NACM rules.");
+
     rc = sr_get_data_file_name(nacm_ctx->data_search_dir, NACM_MODULE_NAME, ds, &ds_filepath);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to get the file-path of NACM startup datastore.");
     fd = open(ds_filepath, O_RDONLY);
@@ -493,7 +720,7 @@ nacm_load_config(nacm_ctx_t *nacm_ctx, const sr_datastore_t ds)
     ly_ctx_set_module_data_clb(nacm_ctx->schema_info->ly_ctx, dm_module_clb, nacm_ctx->dm_ctx);
 
     ly_errno = 0;
-    data_tree = lyd_parse_fd(nacm_ctx->schema_info->ly_ctx, fd, SR_FILE_FORMAT_LY, LYD_OPT_TRUSTED | LYD_OPT_CONFIG);
+    data_tree = lyd_parse_fd(nacm_ctx->schema_info->ly_ctx, fd, sr_data_file_format(fd), LYD_OPT_TRUSTED | LYD_OPT_CONFIG);
     if (NULL == data_tree && LY_SUCCESS != ly_errno) {
         SR_LOG_ERR("Parsing of data tree from file %s failed: %s", ds_filepath, ly_errmsg(nacm_ctx->schema_info->ly_ctx));
         goto cleanup;
@@ -715,6 +942,7 @@ nacm_load_config(nacm_ctx_t *nacm_ctx, const sr_datastore_t ds)
                     rc = nacm_alloc_rule(rule_id++, rule_name, rule_module, rule_type, rule_data, rule_access,
                                          rule_action, rule_comment, &nacm_rule);
                     CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to allocate NACM rule.");
+                    nacm_rule->rule_list_idx = nacm_ctx->rule_lists->count;
                     rc = sr_list_add(nacm_rule_list->rules, nacm_rule);
                     CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to add item into a list.");
                     nacm_rule = NULL;
@@ -793,6 +1021,23 @@ nacm_load_config(nacm_ctx_t *nacm_ctx, const sr_datastore_t ds)
         }
     }
 
+    /**
+     * Phase IV
+     *
+     * Data-oriented rules are compiled into an index keyed by the hash of the referenced schema node,
+     * so that data validation doesn't have to scan all rules for every data node.
+     */
+    phase = 4;
+
+    for (size_t i = 0; i < nacm_ctx->rule_lists->count; ++i) {
+        nacm_rule_list = (nacm_rule_list_t *)nacm_ctx->rule_lists->data[i];
+        for (size_t j = 0; j < nacm_rule_list->rules->count; ++j) {
+            rc = nacm_index_rule(nacm_ctx, (nacm_rule_t *)nacm_rule_list->rules->data[j]);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to add NACM rule into the index.");
+        }
+    }
+    nacm_rule_list = NULL;
+
 cleanup:
     nacm_free_user(nacm_user);
     if (phase < 3) {
@@ -944,6 +1189,10 @@ nacm_cleanup_internal(nacm_ctx_t *nacm_ctx, bool config_only)
     if (NULL != nacm_ctx->users) {
         sr_btree_cleanup(nacm_ctx->users);
     }
+    if (NULL != nacm_ctx->data_rules) {
+        sr_btree_cleanup(nacm_ctx->data_rules);
+    }
+    sr_list_cleanup(nacm_ctx->module_rules);
     if (NULL != nacm_ctx->rule_lists) {
         for (size_t i = 0; i < nacm_ctx->rule_lists->count; ++i) {
             nacm_free_rule_list((nacm_rule_list_t *)nacm_ctx->rule_lists->data[i]);
@@ -953,6 +1202,8 @@ nacm_cleanup_internal(nacm_ctx_t *nacm_ctx, bool config_only)
     nacm_ctx->groups = NULL;
     nacm_ctx->users = NULL;
     nacm_ctx->rule_lists = NULL;
+    nacm_ctx->data_rules = NULL;
+    nacm_ctx->module_rules = NULL;
 
     if (config_only) {
         return rc;
@@ -1395,6 +1646,7 @@ nacm_free_data_val_ctx(nacm_data_val_ctx_t *nacm_data_val_ctx)
 
     sr_bitset_cleanup(nacm_data_val_ctx->rule_lists);
     sr_btree_cleanup(nacm_data_val_ctx->data_targets);
+    sr_btree_cleanup(nacm_data_val_ctx->node_rules);
     free(nacm_data_val_ctx);
 }
 
@@ -1462,6 +1714,9 @@ nacm_data_validation_start(nacm_ctx_t* nacm_ctx, const ac_ucred_t *user_credenti
     rc = sr_btree_init(nacm_compare_data_targets, nacm_free_data_targets, &nacm_data_val_ctx->data_targets);
     CHECK_RC_MSG_GOTO(rc, unlock_if_fail, "Failed to initialize binary tree with data targets.");
 
+    rc = sr_btree_init(nacm_compare_node_rules, nacm_free_node_rules, &nacm_data_val_ctx->node_rules);
+    CHECK_RC_MSG_GOTO(rc, unlock_if_fail, "Failed to initialize binary tree with compiled NACM rules.");
+
     if (nacm_ctx->rule_lists->count > 0) {
         rc = sr_bitset_init(nacm_ctx->rule_lists->count, &nacm_data_val_ctx->rule_lists);
         CHECK_RC_MSG_GOTO(rc, unlock_if_fail, "Failed to initialize bitset.");
@@ -1602,9 +1857,7 @@ nacm_check_data(nacm_data_val_ctx_t *nacm_data_val_ctx, nacm_access_flag_t acces
 {
     int rc = SR_ERR_OK;
     uid_t uid = 0;
-    bool bit_val = true;
     uint16_t node_data_depth = 0;
-    uint32_t parent_xpath_hash = 0;
     struct ly_set *nodeset = NULL;
     const struct lyd_node *parent = NULL;
     struct ly_set **targets_p;
@@ -1612,7 +1865,7 @@ nacm_check_data(nacm_data_val_ctx_t *nacm_data_val_ctx, nacm_access_flag_t acces
     nacm_action_t action = NACM_ACTION_PERMIT;
     nacm_data_targets_t *nacm_data_targets = NULL;
     nacm_ctx_t *nacm_ctx = NULL;
-    nacm_rule_list_t *nacm_rule_list = NULL;
+    nacm_node_rules_t *node_rules = NULL;
     nacm_rule_t *nacm_rule = NULL;
 
     CHECK_NULL_ARG4(nacm_data_val_ctx, nacm_data_val_ctx->nacm_ctx, node, action_p);
@@ -1640,83 +1893,66 @@ nacm_check_data(nacm_data_val_ctx_t *nacm_data_val_ctx, nacm_access_flag_t acces
     nacm_ctx = nacm_data_val_ctx->nacm_ctx;
     node_data_depth = dm_get_node_data_depth(node->schema);
 
-    /* steps 5,6,7: find matching rule */
-    for (size_t i = 0; i < nacm_ctx->rule_lists->count; ++i) {
-        /* step 5: check if this rule-list matches (already evaluated in ::nacm_data_validation_start) */
-        rc = sr_bitset_get(nacm_data_val_ctx->rule_lists, i, &bit_val);
-        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to get value of a bit in a bitset.");
-        if (true == bit_val) {
-            /* process matching rule-list */
-            nacm_rule_list = (nacm_rule_list_t *)nacm_ctx->rule_lists->data[i];
-            for (size_t j = 0; j < nacm_rule_list->rules->count; ++j) {
-                nacm_rule = (nacm_rule_t *)nacm_rule_list->rules->data[j];
-                /* step 6: process all rules until a match is found */
-                if (false == (access_type & nacm_rule->access)) {
-                    /* this rule is for different access operation */
-                    continue;
-                }
-                if (NACM_RULE_DATA != nacm_rule->type && NACM_RULE_NOTSET != nacm_rule->type) {
-                    /* this rule is not defined for data access validation */
-                    continue;
+    /* step 5: matching rule-lists were already evaluated in ::nacm_data_validation_start and only rules
+     * from those lists that may apply to this schema node are considered */
+    rc = nacm_get_node_rules(nacm_data_val_ctx, node->schema, &node_rules);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to get NACM rules for a schema node.");
+
+    /* steps 6,7: find matching rule */
+    for (size_t i = 0; i < node_rules->count; ++i) {
+        nacm_rule = node_rules->rules[i];
+        /* step 6: process all rules until a match is found */
+        if (false == (access_type & nacm_rule->access)) {
+            /* this rule is for different access operation */
+            continue;
+        }
+        if (NULL != nacm_rule->data.path && 0 != strcmp("/", nacm_rule->data.path)) {
+            /* schema node was matched by depth and hash when the candidate rules were compiled */
+            parent = node;
+            for (uint16_t k = 0; parent && k < node_data_depth - nacm_rule->data_depth; ++k) {
+                parent = parent->parent;
+            }
+            if (NULL == parent) {
+                /* path doesn't reference this data node */
+                continue;
+            }
+            /* check the cache if the instance identifier has been already evaluated for this data tree */
+            nacm_data_targets = nacm_get_data_targets(nacm_data_val_ctx, nacm_rule->id);
+            if (NULL == nacm_data_targets) {
+                /* not in the cache */
+                rc = nacm_alloc_data_targets(nacm_rule->id, NULL, NULL, &nacm_data_targets);
+                CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to allocate NACM data targets.");
+                rc = sr_btree_insert(nacm_data_val_ctx->data_targets, nacm_data_targets);
+                if (SR_ERR_OK != rc) {
+                    free(nacm_data_targets);
+                    SR_LOG_ERR_MSG("Failed to insert item into a binary tree.");
+                    goto cleanup;
                 }
-                if (0 != strcmp("*", nacm_rule->module) &&
-                    0 != strcmp(node->schema->module->name, nacm_rule->module)) {
-                    /* this rule doesn't apply to the module where the node is defined */
+            }
+            targets_p = (NACM_ACCESS_CREATE == access_type ? &nacm_data_targets->new_dt :
+                                                             &nacm_data_targets->orig_dt);
+            if (NULL == *targets_p) {
+                /* resolve path to get the matching data nodes */
+                nodeset = lyd_find_path(node, nacm_rule->data.path);
+                if (NULL == nodeset) {
+                    SR_LOG_WRN("Failed to resolve data node instance identifier for rule '%s'.",
+                               nacm_rule->name);
                     continue;
                 }
-                if (NULL != nacm_rule->data.path && 0 != strcmp("/", nacm_rule->data.path)) {
-                    /* check if the schema node matches - first by depth, then by hash */
-                    if (node_data_depth < nacm_rule->data_depth) {
-                        /* path doesn't apply to this schema node */
-                        continue;
-                    }
-                    parent = node;
-                    for (uint16_t k = 0; parent && k < node_data_depth - nacm_rule->data_depth; ++k) {
-                        parent = parent->parent;
-                    }
-                    if (NULL == parent || (parent_xpath_hash = dm_get_node_xpath_hash(parent->schema)) != nacm_rule->data_hash) {
-                        /* path doesn't reference this schema node */
-                        continue;
-                    }
-                    /* check the cache if the instance identifier has been already evaluated for this data tree */
-                    nacm_data_targets = nacm_get_data_targets(nacm_data_val_ctx, nacm_rule->id);
-                    if (NULL == nacm_data_targets) {
-                        /* not in the cache */
-                        rc = nacm_alloc_data_targets(nacm_rule->id, NULL, NULL, &nacm_data_targets);
-                        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to allocate NACM data targets.");
-                        rc = sr_btree_insert(nacm_data_val_ctx->data_targets, nacm_data_targets);
-                        if (SR_ERR_OK != rc) {
-                            free(nacm_data_targets);
-                            SR_LOG_ERR_MSG("Failed to insert item into a binary tree.");
-                            goto cleanup;
-                        }
-                    }
-                    targets_p = (NACM_ACCESS_CREATE == access_type ? &nacm_data_targets->new_dt :
-                                                                     &nacm_data_targets->orig_dt);
-                    if (NULL == *targets_p) {
-                        /* resolve path to get the matching data nodes */
-                        nodeset = lyd_find_path(node, nacm_rule->data.path);
-                        if (NULL == nodeset) {
-                            SR_LOG_WRN("Failed to resolve data node instance identifier for rule '%s'.",
-                                       nacm_rule->name);
-                            continue;
-                        }
-                        (void)sr_ly_set_sort(nodeset);
-                        *targets_p = nodeset;
-                    }
-                    /* check if the data node matches */
-                    if (sr_ly_set_contains(*targets_p, (void *)parent, true) < 0) {
-                       /* path doesn't apply to this data node */
-                        continue;
-                    }
-                }
-                /* the rule matches! */
-                action = nacm_rule->action;
-                rule_name = nacm_rule->name;
-                rule_info = nacm_rule->comment;
-                goto cleanup;
+                (void)sr_ly_set_sort(nodeset);
+                *targets_p = nodeset;
+            }
+            /* check if the data node matches */
+            if (sr_ly_set_contains(*targets_p, (void *)parent, true) < 0) {
+               /* path doesn't apply to this data node */
+                continue;
             }
         }
+        /* the rule matches! */
+        action = nacm_rule->action;
+        rule_name = nacm_rule->name;
+        rule_info = nacm_rule->comment;
+        goto cleanup;
     }
 
     /* step 8: no matching rule was found */
@@ -1748,6 +1984,104 @@ cleanup:
     return rc;
 }
 
+/**
+ * @brief Check if two sets of candidate rules contain the same rules defined for read access.
+ */
+static bool
+nacm_node_rules_read_equal(const nacm_node_rules_t *node_rules1, const nacm_node_rules_t *node_rules2)
+{
+    size_t i = 0, j = 0;
+
+    while (true) {
+        while (i < node_rules1->count && !(NACM_ACCESS_READ & node_rules1->rules[i]->access)) {
+            ++i;
+        }
+        while (j < node_rules2->count && !(NACM_ACCESS_READ & node_rules2->rules[j]->access)) {
+            ++j;
+        }
+        if (i == node_rules1->count || j == node_rules2->count) {
+            return i == node_rules1->count && j == node_rules2->count;
+        }
+        if (node_rules1->rules[i] != node_rules2->rules[j]) {
+            return false;
+        }
+        ++i;
+        ++j;
+    }
+}
+
+/**
+ * @brief Evaluate if data nodes in the subtree of the given schema node all get the same read access decision.
+ * A subtree is uniform if each descendant is defined in the same module, has no NACM extension and has
+ * the same candidate read rules as its parent. The outcome is remembered in the compiled rules of the schema node.
+ */
+static int
+nacm_eval_subtree_uniform(nacm_data_val_ctx_t *nacm_data_val_ctx, struct lys_node *schema, nacm_node_rules_t *node_rules)
+{
+    int rc = SR_ERR_OK;
+    bool uniform = true;
+    struct lys_node *child = NULL;
+    nacm_node_rules_t *child_rules = NULL;
+
+    if (node_rules->subtree_evaluated) {
+        return rc;
+    }
+
+    while (uniform && NULL != (child = (struct lys_node *)lys_getnext(child, schema, NULL, 0))) {
+        if (child->module != schema->module ||
+            NACM_NOT_DEFINED != nacm_check_extension(nacm_data_val_ctx->nacm_ctx->schema_info->module, child,
+                                                     NACM_DENY_ALL | NACM_DENY_WRITE)) {
+            uniform = false;
+            break;
+        }
+        rc = nacm_get_node_rules(nacm_data_val_ctx, child, &child_rules);
+        CHECK_RC_MSG_RETURN(rc, "Failed to get NACM rules for a schema node.");
+        if (!nacm_node_rules_read_equal(node_rules, child_rules)) {
+            /* there is a more specific rule */
+            uniform = false;
+            break;
+        }
+        rc = nacm_eval_subtree_uniform(nacm_data_val_ctx, child, child_rules);
+        CHECK_RC_MSG_RETURN(rc, "Failed to evaluate NACM rules for a schema subtree.");
+        uniform = child_rules->subtree_uniform;
+    }
+
+    node_rules->subtree_uniform = uniform;
+    node_rules->subtree_evaluated = true;
+    return rc;
+}
+
+int
+nacm_check_data_read_subtree(nacm_data_val_ctx_t *nacm_data_val_ctx, const struct lyd_node *node, bool *uniform)
+{
+    int rc = SR_ERR_OK;
+    uid_t uid = 0;
+    nacm_node_rules_t *node_rules = NULL;
+
+    CHECK_NULL_ARG4(nacm_data_val_ctx, nacm_data_val_ctx->nacm_ctx, node, uniform);
+
+    if (NULL != nacm_data_val_ctx->user_credentials->e_username) {
+        uid = nacm_data_val_ctx->user_credentials->e_uid;
+    } else {
+        uid = nacm_data_val_ctx->user_credentials->r_uid;
+    }
+
+    /* access control not enforced */
+    if (false == nacm_data_val_ctx->nacm_ctx->enabled || SR_NACM_RECOVERY_UID == uid) {
+        *uniform = true;
+        return rc;
+    }
+
+    rc = nacm_get_node_rules(nacm_data_val_ctx, node->schema, &node_rules);
+    CHECK_RC_MSG_RETURN(rc, "Failed to get NACM rules for a schema node.");
+
+    rc = nacm_eval_subtree_uniform(nacm_data_val_ctx, node->schema, node_rules);
+    CHECK_RC_MSG_RETURN(rc, "Failed to evaluate NACM rules for a schema subtree.");
+
+    *uniform = node_rules->subtree_uniform;
+    return rc;
+}
+
 int
 nacm_stats_add_denied_data_write(nacm_ctx_t *nacm_ctx)
 {
@@ -120,8 +120,17 @@ typedef struct nacm_rule_s {
     uint8_t access;              /**< Access operations associated with this rule (combination of ::nacm_access_flag_t). */
     nacm_action_t action;        /**< The access control action associated with the rule. */
     char *comment;               /**< Textual description of the access rule. */
+    uint16_t rule_list_idx;      /**< Index of the rule-list that this rule belongs to. */
 } nacm_rule_t;
 
+/**
+ * @brief Set of data-oriented NACM rules whose paths share the same hash (see nacm_rule_t::data_hash).
+ */
+typedef struct nacm_rule_set_s {
+    uint32_t data_hash;          /**< Hash of the data node instance identifiers of all rules in the set. */
+    sr_list_t *rules;            /**< Rules ordered by their IDs. Items are of type nacm_rule_t. */
+} nacm_rule_set_t;
+
 /**
  * @brief NACM rule-list entry.
  */
@@ -153,6 +162,12 @@ typedef struct nacm_ctx_s {
     sr_btree_t *users;             /**< A set of all users known from the NACM config. Items are of type nacm_user_t. */
     sr_list_t *rule_lists;         /**< List of all NACM rule-lists. Items are of type nacm_rule_list_t. */
 
+    /* Data-oriented rules compiled into an index for a quick lookup */
+    sr_btree_t *data_rules;        /**< Rules with a data node instance identifier, grouped by its hash.
+                                        Items are of type nacm_rule_set_t. */
+    sr_list_t *module_rules;       /**< Rules applied to all data nodes of a module (or of all modules), ordered
+                                        by their IDs. Items are of type nacm_rule_t. */
+
     /* NACM state data */
     struct {
         pthread_rwlock_t lock;       /**< RW-lock used to protect incrementation/reading of the stats.
@@ -175,6 +190,21 @@ typedef struct nacm_data_targets_s {
                                      ordered by their memory locations from the lowest to the highest. */
 } nacm_data_targets_t;
 
+/**
+ * @brief Data-oriented NACM rules that may apply to data nodes of a given schema node, compiled for a single
+ * data validation request.
+ */
+typedef struct nacm_node_rules_s {
+    const struct lys_node *schema;  /**< Schema node. */
+    nacm_rule_t **rules;            /**< Candidate rules ordered by their IDs (i.e. by their priority). Only the access
+                                         operations and instance identifiers of these rules remain to be checked. */
+    size_t count;                   /**< Number of candidate rules. */
+    bool subtree_evaluated;         /**< *true* if ::nacm_node_rules_t::subtree_uniform has been already evaluated. */
+    bool subtree_uniform;           /**< *true* if there is no more specific rule for read access nor NACM extension
+                                         for any descendant of this schema node, i.e. the whole subtree of a data node
+                                         gets the same read access decision as the data node itself. */
+} nacm_node_rules_t;
+
 /**
  * @brief Structure that stores an outcome of a NACM data validation for re-use.
  */
@@ -197,6 +227,8 @@ typedef struct nacm_data_val_ctx_s {
                                              (stored as bitset of their IDs). */
     sr_btree_t *data_targets;           /**< A binary tree of target nodes for data-oriented NACM rules with already evaluated
                                              path. Items are of type nacm_data_targets_t. */
+    sr_btree_t *node_rules;             /**< A binary tree of candidate rules for already visited schema nodes.
+                                             Items are of type nacm_node_rules_t. */
 } nacm_data_val_ctx_t;
 
 /**
@@ -287,6 +319,17 @@ void nacm_data_validation_stop(nacm_data_val_ctx_t *nacm_data_val_ctx);
 int nacm_check_data(nacm_data_val_ctx_t *nacm_data_val_ctx, nacm_access_flag_t access_type, const struct lyd_node *node,
         nacm_action_t *action, const char **rule_name, const char **rule_info);
 
+/**
+ * @brief Check if all descendants of the given data node are guaranteed to get the same read access decision
+ * as the node itself, i.e. if there is no more specific rule nor NACM extension below its schema node
+ * for this data validation request. If so, read access doesn't have to be checked for the descendants.
+ *
+ * @param [in] nacm_data_val_ctx NACM data validation context.
+ * @param [in] node Data node whose subtree is about to be read.
+ * @param [out] uniform *true* if the read access decision for the node applies to its entire subtree.
+ */
+int nacm_check_data_read_subtree(nacm_data_val_ctx_t *nacm_data_val_ctx, const struct lyd_node *node, bool *uniform);
+
 /**
  * @brief Update NACM statistics to include another unauthorized attempt to execute operation with write effect.
  *
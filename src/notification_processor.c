@@ -29,6 +29,8 @@
 #include <dirent.h>
 #include <math.h>
 #include <time.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
 
 #include "sr_common.h"
 #include "rp_internal.h"
@@ -39,7 +41,10 @@
 
 #define NP_NS_SCHEMA_FILE                  "sysrepo-notification-store.yang"  /**< Schema of notification store. */
 #define NP_NS_XPATH_NOTIFICATION           "/sysrepo-notification-store:notifications/notification[xpath='%s'][generated-time='%s'][logged-time='%u']"  /**< XPath of one notification entry */
-#define NP_NS_XPATH_NOTIFICATION_BY_XPATH  "/sysrepo-notification-store:notifications/notification[xpath='%s']" /**< XPath of notification entry identified only by xpath */
+#define NP_NS_SEGMENT_EXT                  ".log"           /**< Extension of notification store segment files. */
+#define NP_NS_INDEX_EXT                    ".idx"           /**< Extension of sparse time index files of the segments. */
+#define NP_NS_RECORD_MAGIC                 0x53524e32       /**< Magic number heading each notification store record ("SRN2"). */
+#define NP_NS_INDEX_BLOCK_SIZE             (64 * 1024)      /**< Minimal size of a block of records described by one index entry. */
 
 /**
  * @brief Information about a notification destination.
@@ -78,9 +83,57 @@ typedef struct np_ctx_s {
     const char *data_search_dir;          /**< Directory containing the data files. */
     const struct lys_module *ns_schema;   /**< Schema tree of the notification store YANG. */
     sr_locking_set_t *lock_ctx;           /**< Context for locking notification store files. */
+    sr_list_t *ns_checked_segments;       /**< Segments whose end has been checked for incomplete records since start. */
+    pthread_mutex_t ns_checked_lock;      /**< Mutex guarding the list of checked segments. */
     bool do_notif_store_cleanup;          /**< TRUE if notification store cleanups should be performed.*/
 } np_ctx_t;
 
+/**
+ * @brief Header of one record of a notification store segment. Each record holds one stored notification
+ * (printed sysrepo-notification-store list entry) and is appended to the segment as a whole.
+ */
+typedef struct np_ns_record_hdr_s {
+    uint32_t magic;                  /**< Magic number identifying start of a record (::NP_NS_RECORD_MAGIC). */
+    uint32_t length;                 /**< Length of the record payload following the header. */
+    int64_t generated_time;          /**< Time when the notification stored in the record has been generated. */
+    uint32_t xpath_hash;             /**< Hash of the xpath of the notification stored in the record (::sr_str_hash). */
+    uint32_t padding;                /**< Unused, keeps the size of the header the same on all architectures. */
+} np_ns_record_hdr_t;
+
+/**
+ * @brief Entry of the sparse time index of a notification store segment, describes one block of records.
+ */
+typedef struct np_ns_index_entry_s {
+    uint64_t start;                  /**< Offset of the first record of the block within the segment. */
+    uint64_t end;                    /**< Offset right behind the last record of the block. */
+    int64_t min_time;                /**< Lowest generation time of a notification within the block. */
+    int64_t max_time;                /**< Highest generation time of a notification within the block. */
+} np_ns_index_entry_t;
+
+/**
+ * @brief Cursor used to read stored notifications sequentially, segment by segment.
+ */
+struct np_ev_notif_reader_s {
+    np_ctx_t *np_ctx;                /**< Notification Processor context. */
+    rp_session_t *rp_session;        /**< Request Processor session the notifications are read for. */
+    const ac_ucred_t *user_cred;     /**< Credentials of the user reading the notifications. */
+    char *xpath;                     /**< XPath of the notifications to be read, NULL for all notifications of the module. */
+    uint32_t xpath_hash;             /**< Hash of the xpath, records with a different hash are skipped without parsing. */
+    sr_api_variant_t api_variant;    /**< API variant (values/trees) of the notification data to be returned. */
+    sr_list_t *segments;             /**< Segment files to be read (in chronological order). */
+    size_t segment_idx;              /**< Index of the segment currently being read. */
+    int fd;                          /**< Locked file descriptor of the current segment, -1 if not opened. */
+    uint64_t offset;                 /**< Offset of the next record to be read within the current segment. */
+    uint64_t end;                    /**< Size of the current segment at the time it has been opened. */
+    np_ns_index_entry_t *index;      /**< Sparse time index of the current segment. */
+    size_t index_cnt;                /**< Number of entries in the index. */
+    size_t index_pos;                /**< Index entry covering the current offset (or following it). */
+    time_t start_time;               /**< Only notifications generated at this time or later are returned. */
+    time_t stop_time;                /**< Only notifications generated at this time or earlier are returned. */
+    char *buff;                      /**< Buffer for record payloads. */
+    size_t buff_size;                /**< Size of the payload buffer. */
+};
+
 /**
  * @brief Compares two notification destination information structures by
  * associated destination addresses (used by lookups in binary tree).
@@ -276,10 +329,11 @@ np_commit_ctx_find(np_ctx_t *np_ctx, uint32_t commit_id, sr_llist_node_t **llist
 }
 
 /**
- * @brief Increments count of notifications sent for the commit specified by commit ID.
+ * @brief Updates count of notifications sent for the commit specified by commit ID.
+ * Creates the commit context if it does not exist yet.
  */
 static int
-np_commit_notif_cnt_increment(np_ctx_t *np_ctx, uint32_t commit_id)
+np_commit_notif_cnt_update(np_ctx_t *np_ctx, uint32_t commit_id, ssize_t diff)
 {
     np_commit_ctx_t *commit = NULL;
     int rc = SR_ERR_OK;
@@ -299,9 +353,13 @@ np_commit_notif_cnt_increment(np_ctx_t *np_ctx, uint32_t commit_id)
 
         commit->commit_id = commit_id;
         rc = sr_llist_add_new(np_ctx->commits, commit);
+        if (SR_ERR_OK != rc) {
+            free(commit);
+            goto unlock;
+        }
     }
 
-    commit->notifications_sent++;
+    commit->notifications_sent += diff;
 
 unlock:
     pthread_rwlock_unlock(&np_ctx->lock);
@@ -347,130 +405,422 @@ np_commit_error_add(np_commit_ctx_t *commit_ctx, const char *err_subs_xpath, boo
 }
 
 /**
- * @brief Loads the data tree from provided file.
+ * @brief Composes the filename of the sparse time index belonging to provided notification store segment.
+ */
+static void
+np_ns_index_filename(const char *segment_filename, char *filename_buff, size_t filename_buff_size)
+{
+    size_t len = strlen(segment_filename);
+
+    if (len >= strlen(NP_NS_SEGMENT_EXT)) {
+        len -= strlen(NP_NS_SEGMENT_EXT);
+    }
+    snprintf(filename_buff, filename_buff_size, "%.*s" NP_NS_INDEX_EXT, (int)len, segment_filename);
+}
+
+/**
+ * @brief Opens and locks a segment of the notification store.
  */
 static int
-np_load_data_tree(np_ctx_t *np_ctx, const ac_ucred_t *user_cred, const char *data_filename,
-        const bool read_only, struct lyd_node **data_tree, int *fd_p)
+np_ns_segment_open(np_ctx_t *np_ctx, const ac_ucred_t *user_cred, const char *segment_filename, const bool write,
+        int *fd_p)
 {
-    int fd = -1;
+    int fd = -1, err = 0;
     int rc = SR_ERR_OK;
 
-    CHECK_NULL_ARG4(np_ctx, np_ctx->rp_ctx, data_filename, data_tree);
+    CHECK_NULL_ARG4(np_ctx, np_ctx->rp_ctx, segment_filename, fd_p);
 
     /* open the file as the proper user */
     if (NULL != user_cred) {
         ac_set_user_identity(np_ctx->rp_ctx->ac_ctx, user_cred);
     }
 
-    fd = open(data_filename, (read_only ? O_RDONLY : O_RDWR));
+    fd = open(segment_filename, (write ? (O_RDWR | O_APPEND) : O_RDONLY));
+    err = errno;
 
     if (NULL != user_cred) {
         ac_unset_user_identity(np_ctx->rp_ctx->ac_ctx, user_cred);
     }
 
     if (-1 == fd) {
-        /* error by open */
-        if (ENOENT == errno) {
-            SR_LOG_DBG("Data file '%s' does not exist.", data_filename);
-            if (read_only) {
-                SR_LOG_DBG("No data for '%s' will be loaded.", data_filename);
-                rc = SR_ERR_DATA_MISSING;
-            } else {
-                /* create new persist file */
-                ac_set_user_identity(np_ctx->rp_ctx->ac_ctx, user_cred);
-                fd = open(data_filename, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
-                ac_unset_user_identity(np_ctx->rp_ctx->ac_ctx, user_cred);
-                if (-1 == fd) {
-                    SR_LOG_ERR("Unable to create a new data file '%s': %s", data_filename, sr_strerror_safe(errno));
-                    rc = SR_ERR_INTERNAL;
-                }
-            }
-        } else if (EACCES == errno) {
-            SR_LOG_ERR("Insufficient permissions to access the data file '%s'.", data_filename);
-            rc = SR_ERR_UNAUTHORIZED;
-        } else {
-            SR_LOG_ERR("Unable to open the data file '%s': %s.", data_filename, sr_strerror_safe(errno));
-            rc = SR_ERR_INTERNAL;
+        if (ENOENT == err) {
+            SR_LOG_DBG("Notification store segment '%s' does not exist.", segment_filename);
+            return SR_ERR_DATA_MISSING;
+        } else if (EACCES == err) {
+            SR_LOG_ERR("Insufficient permissions to access the data file '%s'.", segment_filename);
+            return SR_ERR_UNAUTHORIZED;
         }
-        if (SR_ERR_OK != rc) {
+        SR_LOG_ERR("Unable to open the data file '%s': %s.", segment_filename, sr_strerror_safe(err));
+        return SR_ERR_INTERNAL;
+    }
+
+    rc = sr_locking_set_lock_fd(np_ctx->lock_ctx, fd, segment_filename, write, true);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_ERR("Unable to lock data file '%s'.", segment_filename);
+        close(fd);
+        return rc;
+    }
+
+    *fd_p = fd;
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Loads the sparse time index of a segment. Only blocks lying within the first segment_size bytes
+ * of the segment are returned. Missing index is not an error, the segment is then read sequentially.
+ */
+static int
+np_ns_index_load(const char *segment_filename, uint64_t segment_size, np_ns_index_entry_t **index_p, size_t *index_cnt_p)
+{
+    char index_filename[PATH_MAX] = { 0, };
+    np_ns_index_entry_t *index = NULL;
+    struct stat st = { 0, };
+    ssize_t len = 0;
+    size_t cnt = 0;
+    int fd = -1, ret = 0, rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(segment_filename, index_p, index_cnt_p);
+
+    np_ns_index_filename(segment_filename, index_filename, PATH_MAX);
+
+    fd = open(index_filename, O_RDONLY);
+    if (-1 == fd) {
+        SR_LOG_DBG("No time index for notification store segment '%s'.", segment_filename);
+        goto cleanup;
+    }
+
+    ret = fstat(fd, &st);
+    CHECK_NOT_MINUS1_LOG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup, "Unable to stat file '%s': %s.",
+            index_filename, sr_strerror_safe(errno));
+
+    cnt = st.st_size / sizeof(*index);
+    if (0 == cnt) {
+        goto cleanup;
+    }
+
+    index = calloc(cnt, sizeof(*index));
+    CHECK_NULL_NOMEM_GOTO(index, rc, cleanup);
+
+    len = pread(fd, index, cnt * sizeof(*index), 0);
+    CHECK_NOT_MINUS1_LOG_GOTO(len, rc, SR_ERR_INTERNAL, cleanup, "Unable to read file '%s': %s.",
+            index_filename, sr_strerror_safe(errno));
+    cnt = len / sizeof(*index);
+
+    /* ignore blocks not covered by the opened part of the segment */
+    while (cnt > 0 && index[cnt - 1].end > segment_size) {
+        --cnt;
+    }
+
+cleanup:
+    if (-1 != fd) {
+        close(fd);
+    }
+    if (SR_ERR_OK != rc || 0 == cnt) {
+        free(index);
+        index = NULL;
+        cnt = 0;
+    }
+    *index_p = index;
+    *index_cnt_p = cnt;
+    return rc;
+}
+
+/**
+ * @brief Appends a new entry into the sparse time index of a segment, once the records written behind the last
+ * indexed block exceed ::NP_NS_INDEX_BLOCK_SIZE. Expects the segment to be locked for writing.
+ */
+static int
+np_ns_index_update(const char *segment_filename, int segment_fd, uint64_t segment_size)
+{
+    char index_filename[PATH_MAX] = { 0, };
+    np_ns_index_entry_t entry = { 0, };
+    np_ns_record_hdr_t hdr = { 0, };
+    struct stat st = { 0, };
+    size_t cnt = 0;
+    ssize_t len = 0;
+    uint64_t offset = 0;
+    int fd = -1, ret = 0, rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG(segment_filename);
+
+    np_ns_index_filename(segment_filename, index_filename, PATH_MAX);
+
+    fd = open(index_filename, O_RDWR | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR);
+    CHECK_NOT_MINUS1_LOG_GOTO(fd, rc, SR_ERR_INTERNAL, cleanup, "Unable to open file '%s': %s.",
+            index_filename, sr_strerror_safe(errno));
+
+    ret = fstat(fd, &st);
+    CHECK_NOT_MINUS1_LOG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup, "Unable to stat file '%s': %s.",
+            index_filename, sr_strerror_safe(errno));
+
+    cnt = st.st_size / sizeof(entry);
+    if (0 != st.st_size % sizeof(entry)) {
+        /* drop partially written entry */
+        ret = ftruncate(fd, cnt * sizeof(entry));
+        CHECK_ZERO_LOG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup, "File truncate failed: %s", sr_strerror_safe(errno));
+    }
+    if (cnt > 0) {
+        len = pread(fd, &entry, sizeof(entry), (cnt - 1) * sizeof(entry));
+        if ((ssize_t)sizeof(entry) != len) {
+            SR_LOG_ERR("Unable to read file '%s'.", index_filename);
+            rc = SR_ERR_INTERNAL;
             goto cleanup;
         }
+        entry.start = entry.end;
     }
 
-    /* lock & load the data tree */
-    rc = sr_locking_set_lock_fd(np_ctx->lock_ctx, fd, data_filename, (read_only ? false : true), true);
-    CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to lock data file '%s'.", data_filename);
+    if (segment_size < entry.start + NP_NS_INDEX_BLOCK_SIZE) {
+        /* current block is not big enough to be indexed yet */
+        goto cleanup;
+    }
 
-    ly_errno = LY_SUCCESS;
-    *data_tree = lyd_parse_fd(np_ctx->ly_ctx, fd, SR_FILE_FORMAT_LY, LYD_OPT_STRICT | LYD_OPT_CONFIG | LYD_OPT_NOAUTODEL);
-    if (NULL == *data_tree && LY_SUCCESS != ly_errno) {
-        SR_LOG_ERR("Parsing data from file '%s' failed: %s", data_filename, ly_errmsg(np_ctx->ly_ctx));
+    /* collect time range of the records in the block */
+    entry.min_time = INT64_MAX;
+    entry.max_time = INT64_MIN;
+    for (offset = entry.start; offset < segment_size; offset += sizeof(hdr) + hdr.length) {
+        len = pread(segment_fd, &hdr, sizeof(hdr), offset);
+        if ((ssize_t)sizeof(hdr) != len || NP_NS_RECORD_MAGIC != hdr.magic) {
+            SR_LOG_WRN("Invalid record at offset %" PRIu64 " of notification store segment '%s'.", offset, segment_filename);
+            break;
+        }
+        if (hdr.generated_time < entry.min_time) {
+            entry.min_time = hdr.generated_time;
+        }
+        if (hdr.generated_time > entry.max_time) {
+            entry.max_time = hdr.generated_time;
+        }
+    }
+    entry.end = offset;
+
+    len = write(fd, &entry, sizeof(entry));
+    if ((ssize_t)sizeof(entry) != len) {
+        SR_LOG_ERR("Unable to write into file '%s': %s.", index_filename, sr_strerror_safe(errno));
         rc = SR_ERR_INTERNAL;
-    } else {
-        SR_LOG_DBG("Data successfully loaded from file '%s'.", data_filename);
     }
 
-    if ((SR_ERR_OK != rc) || (true == read_only) || (NULL == fd_p)) {
-        /* unlock and close fd in case of read_only has been requested */
-        sr_locking_set_unlock_close_fd(np_ctx->lock_ctx, fd);
-    } else {
-        /* return open fd to locked file otherwise */
-        *fd_p = fd;
+cleanup:
+    if (-1 != fd) {
+        close(fd);
+    }
+    return rc;
+}
+
+/**
+ * @brief Truncates an incomplete record left at the end of a segment (e.g. by a crash in the middle of an append)
+ * together with the index entries not covered by the segment. Only the records behind the last indexed block are
+ * checked. Expects the segment to be locked for writing.
+ */
+static int
+np_ns_segment_repair(const char *segment_filename, int segment_fd, off_t *segment_size)
+{
+    char index_filename[PATH_MAX] = { 0, };
+    np_ns_index_entry_t entry = { 0, };
+    np_ns_record_hdr_t hdr = { 0, };
+    struct stat st = { 0, };
+    uint64_t offset = 0;
+    size_t cnt = 0;
+    ssize_t len = 0;
+    int fd = -1, ret = 0, rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG2(segment_filename, segment_size);
+
+    np_ns_index_filename(segment_filename, index_filename, PATH_MAX);
+
+    fd = open(index_filename, O_RDWR);
+    if (-1 != fd) {
+        ret = fstat(fd, &st);
+        CHECK_NOT_MINUS1_LOG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup, "Unable to stat file '%s': %s.",
+                index_filename, sr_strerror_safe(errno));
+
+        /* find the last block within the segment, records up to its end are complete */
+        cnt = st.st_size / sizeof(entry);
+        while (cnt > 0) {
+            len = pread(fd, &entry, sizeof(entry), (cnt - 1) * sizeof(entry));
+            if ((ssize_t)sizeof(entry) == len && entry.end <= (uint64_t)*segment_size) {
+                offset = entry.end;
+                break;
+            }
+            --cnt;
+        }
+        if ((off_t)(cnt * sizeof(entry)) != st.st_size) {
+            ret = ftruncate(fd, cnt * sizeof(entry));
+            CHECK_ZERO_LOG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup, "File truncate failed: %s", sr_strerror_safe(errno));
+        }
+    }
+
+    /* walk the records behind the last block */
+    while (offset + sizeof(hdr) <= (uint64_t)*segment_size) {
+        len = pread(segment_fd, &hdr, sizeof(hdr), offset);
+        if ((ssize_t)sizeof(hdr) != len || NP_NS_RECORD_MAGIC != hdr.magic ||
+                offset + sizeof(hdr) + hdr.length > (uint64_t)*segment_size) {
+            break;
+        }
+        offset += sizeof(hdr) + hdr.length;
+    }
+
+    if (offset != (uint64_t)*segment_size) {
+        SR_LOG_WRN("Dropping %" PRIu64 " bytes of an incomplete record at the end of notification store segment '%s'.",
+                (uint64_t)*segment_size - offset, segment_filename);
+        ret = ftruncate(segment_fd, offset);
+        CHECK_ZERO_LOG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup, "File truncate failed: %s", sr_strerror_safe(errno));
+        *segment_size = offset;
     }
 
 cleanup:
+    if (-1 != fd) {
+        close(fd);
+    }
     return rc;
 }
 
 /**
- * @brief Saves the data tree into the file specified by file descriptor.
+ * @brief Repairs the end of a segment before the first record is appended to it by this process, so that
+ * an incomplete record does not make the following ones unreadable. Expects the segment to be locked for writing.
  */
 static int
-np_save_data_tree(struct lyd_node *data_tree, int fd)
+np_ns_segment_check(np_ctx_t *np_ctx, const char *segment_filename, int segment_fd, off_t *segment_size)
 {
-    int ret = 0;
+    char *filename = NULL;
+    bool checked = false;
+    int rc = SR_ERR_OK;
 
-    CHECK_NULL_ARG(data_tree);
+    CHECK_NULL_ARG3(np_ctx, segment_filename, segment_size);
 
-    /* empty file content */
-    ret = ftruncate(fd, 0);
-    CHECK_ZERO_LOG_RETURN(ret, SR_ERR_INTERNAL, "File truncate failed: %s", sr_strerror_safe(errno));
+    pthread_mutex_lock(&np_ctx->ns_checked_lock);
+    for (size_t i = 0; i < np_ctx->ns_checked_segments->count; i++) {
+        if (0 == strcmp(np_ctx->ns_checked_segments->data[i], segment_filename)) {
+            checked = true;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&np_ctx->ns_checked_lock);
 
-    /* print data tree to file */
-    ret = lyd_print_fd(fd, data_tree, SR_FILE_FORMAT_LY, LYP_WITHSIBLINGS | LYP_FORMAT | LYP_WD_EXPLICIT);
-    CHECK_ZERO_LOG_RETURN(ret, SR_ERR_INTERNAL, "Saving notification store data tree failed: %s",
-                          ly_errmsg(data_tree->schema->module->ctx));
+    if (checked) {
+        return SR_ERR_OK;
+    }
 
-    /* flush in-core data to the disc */
-    ret = fsync(fd);
-    CHECK_ZERO_LOG_RETURN(ret, SR_ERR_INTERNAL, "File synchronization failed: %s", sr_strerror_safe(errno));
+    rc = np_ns_segment_repair(segment_filename, segment_fd, segment_size);
+    CHECK_RC_LOG_RETURN(rc, "Unable to repair notification store segment '%s'.", segment_filename);
 
-    SR_LOG_DBG_MSG("Data tree successfully saved.");
+    filename = strdup(segment_filename);
+    CHECK_NULL_NOMEM_RETURN(filename);
 
-    return SR_ERR_OK;
+    pthread_mutex_lock(&np_ctx->ns_checked_lock);
+    rc = sr_list_add(np_ctx->ns_checked_segments, filename);
+    pthread_mutex_unlock(&np_ctx->ns_checked_lock);
+    if (SR_ERR_OK != rc) {
+        /* the segment will be just checked again next time */
+        free(filename);
+        rc = SR_ERR_OK;
+    }
+
+    return rc;
 }
 
 /**
- * @brief Cleans up specified data tree and closes specified file descriptor.
+ * @brief Forgets that the end of a segment has been checked (used when the segment is removed).
  */
 static void
-np_cleanup_data_tree(np_ctx_t *np_ctx, struct lyd_node *data_tree, int fd)
+np_ns_segment_uncheck(np_ctx_t *np_ctx, const char *segment_filename)
+{
+    pthread_mutex_lock(&np_ctx->ns_checked_lock);
+    for (size_t i = 0; i < np_ctx->ns_checked_segments->count; i++) {
+        if (0 == strcmp(np_ctx->ns_checked_segments->data[i], segment_filename)) {
+            free(np_ctx->ns_checked_segments->data[i]);
+            sr_list_rm_at(np_ctx->ns_checked_segments, i);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&np_ctx->ns_checked_lock);
+}
+
+/**
+ * @brief Writes a record with one notification at the end of the file (opened with O_APPEND).
+ */
+static int
+np_ns_record_write(int fd, const time_t generated_time, uint32_t xpath_hash, const char *payload)
 {
-    if (NULL != data_tree) {
-        lyd_free_withsiblings(data_tree);
+    np_ns_record_hdr_t hdr = { 0, };
+    struct iovec iov[2] = { { 0, }, };
+    ssize_t len = 0;
+
+    CHECK_NULL_ARG(payload);
+
+    hdr.magic = NP_NS_RECORD_MAGIC;
+    hdr.length = strlen(payload);
+    hdr.generated_time = generated_time;
+    hdr.xpath_hash = xpath_hash;
+
+    iov[0].iov_base = &hdr;
+    iov[0].iov_len = sizeof(hdr);
+    iov[1].iov_base = (void*)payload;
+    iov[1].iov_len = hdr.length;
+
+    len = writev(fd, iov, 2);
+    if (len != (ssize_t)(sizeof(hdr) + hdr.length)) {
+        SR_LOG_ERR("Unable to write a notification store record: %s.", (-1 == len) ? sr_strerror_safe(errno) : "short write");
+        return SR_ERR_INTERNAL;
+    }
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Appends a record with one notification at the end of a notification store segment.
+ */
+static int
+np_ns_record_append(np_ctx_t *np_ctx, const ac_ucred_t *user_cred, const char *segment_filename,
+        const time_t generated_time, uint32_t xpath_hash, const char *payload)
+{
+    struct stat st = { 0, };
+    int fd = -1, ret = 0, rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(np_ctx, segment_filename, payload);
+
+    rc = np_ns_segment_open(np_ctx, user_cred, segment_filename, true, &fd);
+    CHECK_RC_LOG_RETURN(rc, "Unable to open notification store segment '%s'.", segment_filename);
+
+    /* the segment is locked, its size is the offset of the new record */
+    ret = fstat(fd, &st);
+    CHECK_NOT_MINUS1_LOG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup, "Unable to stat file '%s': %s.",
+            segment_filename, sr_strerror_safe(errno));
+
+    rc = np_ns_segment_check(np_ctx, segment_filename, fd, &st.st_size);
+    CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to check notification store segment '%s'.", segment_filename);
+
+    rc = np_ns_record_write(fd, generated_time, xpath_hash, payload);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_ERR("Unable to append a record to notification store segment '%s'.", segment_filename);
+        /* do not leave a partial record behind */
+        ret = ftruncate(fd, st.st_size);
+        goto cleanup;
     }
-    if (-1 != fd && NULL != np_ctx) {
-        sr_locking_set_unlock_close_fd(np_ctx->lock_ctx, fd);
+
+    /* flush in-core data to the disc */
+    ret = fsync(fd);
+    CHECK_ZERO_LOG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup, "File synchronization failed: %s", sr_strerror_safe(errno));
+
+    rc = np_ns_index_update(segment_filename, fd, st.st_size + sizeof(np_ns_record_hdr_t) + strlen(payload));
+    if (SR_ERR_OK != rc) {
+        /* the record has been stored, the segment will be just read without the index */
+        SR_LOG_WRN("Unable to update time index of notification store segment '%s'.", segment_filename);
+        rc = SR_ERR_OK;
     }
+
+cleanup:
+    sr_locking_set_unlock_close_fd(np_ctx->lock_ctx, fd);
+    return rc;
 }
 
 /**
- * @brief Returns the name of a file that can be used to store a notification received in given time.
+ * @brief Returns the name of the segment that can be used to store a notification received in given time.
+ * Creates the segment together with its time index if it does not exist yet.
  */
 static int
 np_get_notif_store_filename(const char *module_name, time_t received_time, char *filename_buff, size_t filename_buff_size)
 {
+    char index_filename[PATH_MAX] = { 0, };
+    const char *files[2] = { filename_buff, index_filename };
     mode_t old_umask = 0;
     time_t raw_time = 0;
     struct tm *tm_time = { 0, };
@@ -505,21 +855,24 @@ np_get_notif_store_filename(const char *module_name, time_t received_time, char
     /* move raw_time back to the beginning of the current NP_NOTIF_FILE_WINDOW */
     raw_time -= (((tm_time->tm_hour * 60) + tm_time->tm_min) % SR_NOTIF_TIME_WINDOW) * 60;
     strftime(filename_buff + strlen(filename_buff), filename_buff_size - strlen(filename_buff) - 1,
-            "%Y-%m-%d_%H-%M." SR_FILE_FORMAT_EXT, localtime(&raw_time));
-
-    /* create file if not exists & apply access permissions */
-    if (-1 == access(filename_buff, F_OK)) {
-        old_umask = umask(0);
-        fd = open(filename_buff, O_CREAT, S_IRUSR | S_IWUSR);
-        if (-1 == fd) {
-            SR_LOG_WRN("Error by opening file '%s': %s.", filename_buff, sr_strerror_safe(errno));
-        } else {
-            /* close and apply access permissions */
-            close(fd);
+            "%Y-%m-%d_%H-%M" NP_NS_SEGMENT_EXT, localtime(&raw_time));
+    np_ns_index_filename(filename_buff, index_filename, PATH_MAX);
+
+    /* create the segment and its index if not exist & apply access permissions */
+    for (size_t i = 0; i < 2; i++) {
+        if (-1 == access(files[i], F_OK)) {
+            old_umask = umask(0);
+            fd = open(files[i], O_CREAT, S_IRUSR | S_IWUSR);
             umask(old_umask);
-            rc = sr_set_data_file_permissions(filename_buff, false, SR_DATA_SEARCH_DIR, module_name, false);
-            if (SR_ERR_OK != rc) {
-                SR_LOG_WRN("Error by applying correct data file permissions on file '%s'.", filename_buff);
+            if (-1 == fd) {
+                SR_LOG_WRN("Error by opening file '%s': %s.", files[i], sr_strerror_safe(errno));
+            } else {
+                /* close and apply access permissions */
+                close(fd);
+                rc = sr_set_data_file_permissions(files[i], false, SR_DATA_SEARCH_DIR, module_name, false);
+                if (SR_ERR_OK != rc) {
+                    SR_LOG_WRN("Error by applying correct data file permissions on file '%s'.", files[i]);
+                }
             }
         }
     }
@@ -529,10 +882,11 @@ np_get_notif_store_filename(const char *module_name, time_t received_time, char
 
 /**
  * @brief Get notification files of given module with last modification time from provided time interval.
+ * If suffix is provided, only the files with names ending with it are returned.
  */
 static int
 np_get_notification_files(np_ctx_t *np_ctx, const char *module_name, time_t time_from, time_t time_to,
-        sr_list_t *file_list)
+        const char *suffix, sr_list_t *file_list)
 {
     char dirname[PATH_MAX] = { 0, };
     char filename[PATH_MAX] = { 0, };
@@ -560,7 +914,8 @@ np_get_notification_files(np_ctx_t *np_ctx, const char *module_name, time_t time
     } else {
         for (size_t i = 0; i < dir_elem_cnt; i++) {
             if ((DT_DIR != entries[i]->d_type) &&
-                    (0 != strcmp(entries[i]->d_name, ".")) && (0 != strcmp(entries[i]->d_name, ".."))) {
+                    (0 != strcmp(entries[i]->d_name, ".")) && (0 != strcmp(entries[i]->d_name, "..")) &&
+                    (NULL == suffix || sr_str_ends_with(entries[i]->d_name, suffix))) {
                 /* for each file */
                 snprintf(filename, PATH_MAX - 1, "%s/%s", dirname, entries[i]->d_name);
                 ret = stat(filename, &sb);
@@ -615,7 +970,7 @@ np_get_all_notification_files(np_ctx_t *np_ctx, time_t time_from, time_t time_to
         if ((NULL != result) && (0 != strcmp(entry.d_name, ".")) && (0 != strcmp(entry.d_name, ".."))) {
             /* for each directory */
             SR_LOG_DBG("Listing notification directory '%s'.", entry.d_name);
-            rc = np_get_notification_files(np_ctx, entry.d_name, time_from, time_to, file_list);
+            rc = np_get_notification_files(np_ctx, entry.d_name, time_from, time_to, NULL, file_list);
             if (SR_ERR_OK != rc) {
                 SR_LOG_WRN("Error by retrieving notification files from '%s' directory: %s.",
                         entry.d_name, sr_strerror(rc));
@@ -695,6 +1050,406 @@ cleanup:
     return rc;
 }
 
+/**
+ * @brief Releases the segment currently opened by the reader. Reading can be later resumed
+ * from the same position by ::np_ns_reader_record_next.
+ */
+static void
+np_ns_reader_pause(np_ev_notif_reader_t *reader)
+{
+    if (NULL != reader && -1 != reader->fd) {
+        sr_locking_set_unlock_close_fd(reader->np_ctx->lock_ctx, reader->fd);
+        reader->fd = -1;
+        free(reader->index);
+        reader->index = NULL;
+        reader->index_cnt = 0;
+        reader->index_pos = 0;
+    }
+}
+
+/**
+ * @brief Cleans up the notification store reader.
+ */
+static void
+np_ns_reader_cleanup(np_ev_notif_reader_t *reader)
+{
+    if (NULL != reader) {
+        np_ns_reader_pause(reader);
+        sr_free_list_of_strings(reader->segments);
+        free(reader->xpath);
+        free(reader->buff);
+        free(reader);
+    }
+}
+
+/**
+ * @brief Initializes a reader of stored notifications of given module generated within provided time interval.
+ */
+static int
+np_ns_reader_init(np_ctx_t *np_ctx, const ac_ucred_t *user_cred, const char *module_name,
+        const time_t start_time, const time_t stop_time, np_ev_notif_reader_t **reader_p)
+{
+    np_ev_notif_reader_t *reader = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(np_ctx, module_name, reader_p);
+
+    reader = calloc(1, sizeof(*reader));
+    CHECK_NULL_NOMEM_RETURN(reader);
+
+    reader->np_ctx = np_ctx;
+    reader->user_cred = user_cred;
+    reader->fd = -1;
+    reader->start_time = start_time;
+    reader->stop_time = stop_time;
+
+    rc = sr_list_init(&reader->segments);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to initialize file list.");
+
+    /* get all segments of the module matching provided time interval */
+    rc = np_get_notification_files(np_ctx, module_name,
+            (0 == start_time) ? 0 : (start_time - (SR_NOTIF_TIME_WINDOW * 60)),
+            (stop_time + (SR_NOTIF_TIME_WINDOW * 60)),
+            NP_NS_SEGMENT_EXT, reader->segments);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to retrieve notification file list.");
+
+    *reader_p = reader;
+    return SR_ERR_OK;
+
+cleanup:
+    np_ns_reader_cleanup(reader);
+    return rc;
+}
+
+/**
+ * @brief Opens the current segment of the reader and loads its time index.
+ */
+static int
+np_ns_reader_segment_open(np_ev_notif_reader_t *reader)
+{
+    const char *segment_filename = reader->segments->data[reader->segment_idx];
+    struct stat st = { 0, };
+    int ret = 0, rc = SR_ERR_OK;
+
+    rc = np_ns_segment_open(reader->np_ctx, reader->user_cred, segment_filename, false, &reader->fd);
+    if (SR_ERR_OK != rc) {
+        reader->fd = -1;
+        return rc;
+    }
+
+    /* records appended after this point are not visible to the reader until it is resumed */
+    ret = fstat(reader->fd, &st);
+    CHECK_NOT_MINUS1_LOG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup, "Unable to stat file '%s': %s.",
+            segment_filename, sr_strerror_safe(errno));
+    reader->end = st.st_size;
+
+    rc = np_ns_index_load(segment_filename, reader->end, &reader->index, &reader->index_cnt);
+    CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to load time index of notification store segment '%s'.", segment_filename);
+    reader->index_pos = 0;
+
+cleanup:
+    if (SR_ERR_OK != rc) {
+        np_ns_reader_pause(reader);
+    }
+    return rc;
+}
+
+/**
+ * @brief Returns the next stored notification matching the time interval of the reader, as a data tree
+ * of sysrepo-notification-store. Returns SR_ERR_NOT_FOUND once there are no more notifications to be read.
+ */
+static int
+np_ns_reader_record_next(np_ev_notif_reader_t *reader, struct lyd_node **data_tree)
+{
+    const char *segment_filename = NULL;
+    np_ns_record_hdr_t hdr = { 0, };
+    np_ns_index_entry_t *block = NULL;
+    char *tmp = NULL;
+    ssize_t len = 0;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG2(reader, data_tree);
+
+    while (true) {
+        if (-1 == reader->fd) {
+            if (reader->segment_idx >= reader->segments->count) {
+                return SR_ERR_NOT_FOUND;
+            }
+            rc = np_ns_reader_segment_open(reader);
+            if (SR_ERR_DATA_MISSING == rc) {
+                /* segment removed in the meantime */
+                reader->segment_idx++;
+                reader->offset = 0;
+                continue;
+            }
+            CHECK_RC_MSG_RETURN(rc, "Unable to open notification store segment.");
+        }
+        segment_filename = reader->segments->data[reader->segment_idx];
+
+        if (reader->offset >= reader->end) {
+            /* move to the next segment */
+            np_ns_reader_pause(reader);
+            reader->segment_idx++;
+            reader->offset = 0;
+            continue;
+        }
+
+        /* skip whole blocks of records not matching the time interval */
+        while (reader->index_pos < reader->index_cnt && reader->index[reader->index_pos].end <= reader->offset) {
+            reader->index_pos++;
+        }
+        if (reader->index_pos < reader->index_cnt) {
+            block = &reader->index[reader->index_pos];
+            if (block->start <= reader->offset &&
+                    (block->max_time < reader->start_time || block->min_time > reader->stop_time)) {
+                reader->offset = block->end;
+                continue;
+            }
+        }
+
+        /* read the record header */
+        len = pread(reader->fd, &hdr, sizeof(hdr), reader->offset);
+        if ((ssize_t)sizeof(hdr) != len || NP_NS_RECORD_MAGIC != hdr.magic ||
+                reader->offset + sizeof(hdr) + hdr.length > reader->end) {
+            SR_LOG_WRN("Invalid record at offset %" PRIu64 " of notification store segment '%s', skipping the rest of it.",
+                    reader->offset, segment_filename);
+            reader->offset = reader->end;
+            continue;
+        }
+        if (hdr.generated_time < reader->start_time || hdr.generated_time > reader->stop_time ||
+                (NULL != reader->xpath && hdr.xpath_hash != reader->xpath_hash)) {
+            reader->offset += sizeof(hdr) + hdr.length;
+            continue;
+        }
+
+        /* read the record payload */
+        if (reader->buff_size < hdr.length + 1) {
+            tmp = realloc(reader->buff, hdr.length + 1);
+            CHECK_NULL_NOMEM_RETURN(tmp);
+            reader->buff = tmp;
+            reader->buff_size = hdr.length + 1;
+        }
+        len = pread(reader->fd, reader->buff, hdr.length, reader->offset + sizeof(hdr));
+        if (len != (ssize_t)hdr.length) {
+            SR_LOG_WRN("Unable to read record at offset %" PRIu64 " of notification store segment '%s', skipping the rest of it.",
+                    reader->offset, segment_filename);
+            reader->offset = reader->end;
+            continue;
+        }
+        reader->buff[hdr.length] = '\0';
+        reader->offset += sizeof(hdr) + hdr.length;
+
+        ly_errno = LY_SUCCESS;
+        *data_tree = lyd_parse_mem(reader->np_ctx->ly_ctx, reader->buff, SR_TEXT_FORMAT_LY,
+                LYD_OPT_STRICT | LYD_OPT_CONFIG | LYD_OPT_NOAUTODEL);
+        if (NULL == *data_tree) {
+            SR_LOG_WRN("Parsing notification record from '%s' failed: %s", segment_filename,
+                    ly_errmsg(reader->np_ctx->ly_ctx));
+            continue;
+        }
+
+        return SR_ERR_OK;
+    }
+}
+
+/**
+ * @brief Converts one notification store file in the format used before segments (whole sysrepo-notification-store
+ * data tree per time window) into a segment with the same time window. The records converted from the old file are
+ * placed before the records already stored in the segment. The old file is removed once the segment has been replaced.
+ */
+static int
+np_ns_legacy_file_convert(np_ctx_t *np_ctx, const char *legacy_filename)
+{
+    char segment_filename[PATH_MAX] = { 0, };
+    char tmp_filename[PATH_MAX] = { 0, };
+    char index_filename[PATH_MAX] = { 0, };
+    char buff[4096] = { 0, };
+    struct lyd_node *data_tree = NULL, *node = NULL, *record_tree = NULL, *dup = NULL;
+    np_ev_notification_t notification = { 0, };
+    struct stat legacy_st = { 0, }, segment_st = { 0, }, st = { 0, };
+    struct timespec times[2] = { { 0, }, };
+    char *record = NULL;
+    off_t offset = 0;
+    ssize_t len = 0;
+    size_t record_cnt = 0;
+    int legacy_fd = -1, segment_fd = -1, tmp_fd = -1, ret = 0, rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG2(np_ctx, legacy_filename);
+
+    snprintf(segment_filename, PATH_MAX, "%.*s" NP_NS_SEGMENT_EXT,
+            (int)(strlen(legacy_filename) - strlen("." SR_TEXT_FORMAT_EXT)), legacy_filename);
+    snprintf(tmp_filename, PATH_MAX, "%s.tmp", segment_filename);
+    np_ns_index_filename(segment_filename, index_filename, PATH_MAX);
+
+    /* lock & load the old file */
+    legacy_fd = open(legacy_filename, O_RDWR);
+    CHECK_NOT_MINUS1_LOG_GOTO(legacy_fd, rc, SR_ERR_INTERNAL, cleanup, "Unable to open file '%s': %s.",
+            legacy_filename, sr_strerror_safe(errno));
+    rc = sr_locking_set_lock_fd(np_ctx->lock_ctx, legacy_fd, legacy_filename, true, true);
+    CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to lock data file '%s'.", legacy_filename);
+
+    ret = fstat(legacy_fd, &legacy_st);
+    CHECK_NOT_MINUS1_LOG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup, "Unable to stat file '%s': %s.",
+            legacy_filename, sr_strerror_safe(errno));
+    if (-1 == stat(legacy_filename, &st) || st.st_ino != legacy_st.st_ino) {
+        /* converted by another process in the meantime */
+        goto cleanup;
+    }
+
+    ly_errno = LY_SUCCESS;
+    data_tree = lyd_parse_fd(np_ctx->ly_ctx, legacy_fd, sr_data_file_format(legacy_fd),
+            LYD_OPT_STRICT | LYD_OPT_CONFIG | LYD_OPT_NOAUTODEL);
+    if (NULL == data_tree && LY_SUCCESS != ly_errno) {
+        SR_LOG_ERR("Parsing data from file '%s' failed: %s", legacy_filename, ly_errmsg(np_ctx->ly_ctx));
+        rc = SR_ERR_INTERNAL;
+        goto cleanup;
+    }
+
+    /* lock the segment of the same time window, it may already contain some records */
+    segment_fd = open(segment_filename, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+    CHECK_NOT_MINUS1_LOG_GOTO(segment_fd, rc, SR_ERR_INTERNAL, cleanup, "Unable to open file '%s': %s.",
+            segment_filename, sr_strerror_safe(errno));
+    rc = sr_locking_set_lock_fd(np_ctx->lock_ctx, segment_fd, segment_filename, true, true);
+    CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to lock data file '%s'.", segment_filename);
+    ret = fstat(segment_fd, &segment_st);
+    CHECK_NOT_MINUS1_LOG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup, "Unable to stat file '%s': %s.",
+            segment_filename, sr_strerror_safe(errno));
+
+    tmp_fd = open(tmp_filename, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, S_IRUSR | S_IWUSR);
+    CHECK_NOT_MINUS1_LOG_GOTO(tmp_fd, rc, SR_ERR_INTERNAL, cleanup, "Unable to open file '%s': %s.",
+            tmp_filename, sr_strerror_safe(errno));
+
+    /* each notification entry of the old file becomes one record */
+    for (node = (NULL != data_tree) ? data_tree->child : NULL; NULL != node; node = node->next) {
+        rc = np_event_notification_entry_fill(&notification, node->child);
+        if (SR_ERR_OK != rc) {
+            /* the entry has been already cleaned up */
+            memset(&notification, 0, sizeof(notification));
+            SR_LOG_ERR_MSG("Error by filling a notification entry.");
+            goto cleanup;
+        }
+
+        record_tree = lyd_dup(data_tree, 0);
+        dup = lyd_dup(node, 1);
+        if (NULL == record_tree || NULL == dup || 0 != lyd_insert(record_tree, dup)) {
+            SR_LOG_ERR("Unable to copy notification entry from '%s': %s.", legacy_filename, ly_errmsg(np_ctx->ly_ctx));
+            lyd_free_withsiblings(dup);
+            rc = SR_ERR_INTERNAL;
+            goto cleanup;
+        }
+        if (lyd_print_mem(&record, record_tree, SR_TEXT_FORMAT_LY, LYP_WITHSIBLINGS | LYP_WD_EXPLICIT) || NULL == record) {
+            SR_LOG_ERR("Error printing notification store record: %s.", ly_errmsg(np_ctx->ly_ctx));
+            rc = SR_ERR_INTERNAL;
+            goto cleanup;
+        }
+
+        rc = np_ns_record_write(tmp_fd, notification.timestamp,
+                (NULL != notification.xpath) ? sr_str_hash(notification.xpath) : 0, record);
+        CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to write into file '%s'.", tmp_filename);
+        ++record_cnt;
+
+        free(record);
+        record = NULL;
+        lyd_free_withsiblings(record_tree);
+        record_tree = NULL;
+        np_event_notification_content_cleanup(&notification);
+        memset(&notification, 0, sizeof(notification));
+    }
+
+    /* records already stored in the segment follow */
+    for (offset = 0; offset < segment_st.st_size; offset += len) {
+        len = pread(segment_fd, buff, sizeof(buff), offset);
+        CHECK_NOT_MINUS1_LOG_GOTO(len, rc, SR_ERR_INTERNAL, cleanup, "Unable to read file '%s': %s.",
+                segment_filename, sr_strerror_safe(errno));
+        if (0 == len) {
+            break;
+        }
+        if (len != write(tmp_fd, buff, len)) {
+            SR_LOG_ERR("Unable to write into file '%s': %s.", tmp_filename, sr_strerror_safe(errno));
+            rc = SR_ERR_INTERNAL;
+            goto cleanup;
+        }
+    }
+
+    /* keep access rights and modification time (used by the cleanup) of the old file */
+    if (-1 == fchmod(tmp_fd, legacy_st.st_mode & 07777) || -1 == fchown(tmp_fd, legacy_st.st_uid, legacy_st.st_gid)) {
+        SR_LOG_WRN("Unable to apply access permissions on file '%s': %s.", tmp_filename, sr_strerror_safe(errno));
+    }
+    times[0].tv_nsec = UTIME_OMIT;
+    times[1].tv_sec = (segment_st.st_size > 0 && segment_st.st_mtime > legacy_st.st_mtime) ?
+            segment_st.st_mtime : legacy_st.st_mtime;
+    ret = futimens(tmp_fd, times);
+    if (-1 == ret) {
+        SR_LOG_WRN("Unable to set modification time of file '%s': %s.", tmp_filename, sr_strerror_safe(errno));
+    }
+
+    ret = fsync(tmp_fd);
+    CHECK_ZERO_LOG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup, "File synchronization failed: %s", sr_strerror_safe(errno));
+
+    /* replace the segment, offsets of its records have changed so the index is dropped */
+    ret = rename(tmp_filename, segment_filename);
+    CHECK_ZERO_LOG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup, "Unable to rename file '%s': %s.",
+            tmp_filename, sr_strerror_safe(errno));
+    if (-1 == unlink(index_filename) && ENOENT != errno) {
+        SR_LOG_WRN("Unable to delete notification data file '%s': %s.", index_filename, sr_strerror_safe(errno));
+    }
+    ret = unlink(legacy_filename);
+    CHECK_ZERO_LOG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup, "Unable to delete file '%s': %s.",
+            legacy_filename, sr_strerror_safe(errno));
+
+    SR_LOG_INF("Converted %zu notifications from '%s' into notification store segment '%s'.", record_cnt,
+            legacy_filename, segment_filename);
+
+cleanup:
+    if (-1 != tmp_fd) {
+        close(tmp_fd);
+        if (SR_ERR_OK != rc) {
+            unlink(tmp_filename);
+        }
+    }
+    if (-1 != segment_fd) {
+        sr_locking_set_unlock_close_fd(np_ctx->lock_ctx, segment_fd);
+    }
+    if (-1 != legacy_fd) {
+        sr_locking_set_unlock_close_fd(np_ctx->lock_ctx, legacy_fd);
+    }
+    np_event_notification_content_cleanup(&notification);
+    lyd_free_withsiblings(record_tree);
+    lyd_free_withsiblings(data_tree);
+    free(record);
+    return rc;
+}
+
+/**
+ * @brief Converts all notification store files in the format used before segments.
+ * Files that cannot be converted are left in place and expire through the regular cleanup.
+ */
+static void
+np_ns_legacy_convert(np_ctx_t *np_ctx)
+{
+    sr_list_t *file_list = NULL;
+    int rc = SR_ERR_OK;
+
+    rc = sr_list_init(&file_list);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_WRN_MSG("Unable to initialize file list.");
+        return;
+    }
+
+    np_get_all_notification_files(np_ctx, 0, time(NULL) + (SR_NOTIF_TIME_WINDOW * 60), file_list);
+
+    for (size_t i = 0; i < file_list->count; i++) {
+        if (sr_str_ends_with(file_list->data[i], "." SR_TEXT_FORMAT_EXT)) {
+            rc = np_ns_legacy_file_convert(np_ctx, file_list->data[i]);
+            if (SR_ERR_OK != rc) {
+                SR_LOG_WRN("Unable to convert notification data file '%s'.", (char*)file_list->data[i]);
+            }
+        }
+    }
+
+    sr_free_list_of_strings(file_list);
+}
+
 /**
  * @brief Sets up notification store cleanup timer.
  */
@@ -763,6 +1518,11 @@ np_init(rp_ctx_t *rp_ctx, const char *schema_search_dir, const char *data_search
     rc = sr_locking_set_init(&ctx->lock_ctx);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to initialize locking set.");
 
+    /* init list of checked notification store segments */
+    rc = sr_list_init(&ctx->ns_checked_segments);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to initialize list of checked segments.");
+    pthread_mutex_init(&ctx->ns_checked_lock, NULL);
+
     /* save data search directory */
     ctx->data_search_dir = strdup(data_search_dir);
     CHECK_NULL_NOMEM_GOTO(ctx->data_search_dir, rc, cleanup);
@@ -790,6 +1550,9 @@ np_init(rp_ctx_t *rp_ctx, const char *schema_search_dir, const char *data_search
         goto cleanup;
     }
 
+    /* convert notification store files of older sysrepo versions */
+    np_ns_legacy_convert(ctx);
+
     /* if running in daemon mode, setup notif. store cleanup timer */
     if (CM_MODE_DAEMON == cm_get_connection_mode(rp_ctx->cm_ctx)) {
         ctx->do_notif_store_cleanup = true;
@@ -839,6 +1602,10 @@ np_cleanup(np_ctx_t *np_ctx)
         if (np_ctx->do_notif_store_cleanup) {
             np_notification_store_cleanup(np_ctx, false);
         }
+        if (NULL != np_ctx->ns_checked_segments) {
+            sr_free_list_of_strings(np_ctx->ns_checked_segments);
+            pthread_mutex_destroy(&np_ctx->ns_checked_lock);
+        }
 
         free(np_ctx);
     }
@@ -974,7 +1741,8 @@ cleanup:
 int
 np_notification_subscribe(np_ctx_t *np_ctx, const rp_session_t *rp_session, Sr__SubscriptionType type,
         const char *dst_address, uint32_t dst_id, const char *module_name, const char *xpath, const char *username,
-        Sr__NotificationEvent notif_event, uint32_t priority, sr_api_variant_t api_variant, const np_subscr_options_t opts)
+        Sr__NotificationEvent notif_event, uint32_t priority, uint32_t cache_ttl, sr_api_variant_t api_variant,
+        const np_subscr_options_t opts)
 {
     np_subscription_t *subscription = NULL;
     np_subscription_t **subscriptions_tmp = NULL;
@@ -1008,7 +1776,11 @@ np_notification_subscribe(np_ctx_t *np_ctx, const rp_session_t *rp_session, Sr__
 
     subscription->notif_event = notif_event;
     subscription->priority = priority;
+    subscription->cache_ttl = (SR__SUBSCRIPTION_TYPE__DP_GET_ITEMS_SUBS == type) ? cache_ttl : 0;
     subscription->enable_running = (opts & NP_SUBSCR_ENABLE_RUNNING);
+    subscription->dp_bulk = (SR__SUBSCRIPTION_TYPE__DP_GET_ITEMS_SUBS == type) && (opts & NP_SUBSCR_DP_BULK);
+    subscription->changes_inline = (SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS == type ||
+            SR__SUBSCRIPTION_TYPE__SUBTREE_CHANGE_SUBS == type) && (opts & NP_SUBSCR_CHANGES_INLINE);
     subscription->enable_nacm = (rp_session->options & SR_SESS_ENABLE_NACM);
     subscription->api_variant = api_variant;
 
@@ -1374,15 +2146,37 @@ np_get_data_provider_subscriptions(np_ctx_t *np_ctx, const rp_session_t *rp_sess
     return rc;
 }
 
+/**
+ * @brief Attaches the changes to a change notification message. If it fails, the notification is sent without
+ * the changes and the subscriber requests them on its own.
+ */
+static void
+np_notification_attach_changes(sr_list_t *changes, Sr__Change ***gpb_changes, size_t *gpb_count,
+        protobuf_c_boolean *has_changes_inline, protobuf_c_boolean *changes_inline)
+{
+    int rc = SR_ERR_OK;
+
+    rc = sr_changes_sr_to_gpb(changes, NULL, gpb_changes, gpb_count);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_WRN_MSG("Unable to attach the changes to the notification.");
+        *gpb_changes = NULL;
+        *gpb_count = 0;
+        return;
+    }
+    *has_changes_inline = true;
+    *changes_inline = true;
+}
+
 int
-np_subscription_notify(np_ctx_t *np_ctx, np_subscription_t *subscription, sr_notif_event_t event, uint32_t commit_id)
+np_subscription_notif_alloc(np_ctx_t *np_ctx, np_subscription_t *subscription, sr_notif_event_t event, uint32_t commit_id,
+        sr_list_t *changes, Sr__Msg **notif_p)
 {
     Sr__Msg *notif = NULL;
     int rc = SR_ERR_OK;
 
-    CHECK_NULL_ARG4(np_ctx, np_ctx->rp_ctx, subscription, subscription->dst_address);
+    CHECK_NULL_ARG5(np_ctx, np_ctx->rp_ctx, subscription, subscription->dst_address, notif_p);
 
-    SR_LOG_DBG("Sending %s notification to '%s' @ %"PRIu32".", sr_subscription_type_gpb_to_str(subscription->type),
+    SR_LOG_DBG("Preparing %s notification for '%s' @ %"PRIu32".", sr_subscription_type_gpb_to_str(subscription->type),
             subscription->dst_address, subscription->dst_id);
 
     rc = sr_gpb_notif_alloc(NULL, subscription->type, subscription->dst_address, subscription->dst_id, &notif);
@@ -1394,11 +2188,21 @@ np_subscription_notify(np_ctx_t *np_ctx, np_subscription_t *subscription, sr_not
             notif->notification->module_change_notif->event = sr_notification_event_sr_to_gpb(event);
             notif->notification->module_change_notif->module_name = strdup(subscription->module_name);
             CHECK_NULL_NOMEM_ERROR(notif->notification->module_change_notif->module_name, rc);
+            if (SR_ERR_OK == rc && subscription->changes_inline && NULL != changes) {
+                np_notification_attach_changes(changes, &notif->notification->module_change_notif->changes,
+                        &notif->notification->module_change_notif->n_changes, &notif->notification->module_change_notif->has_changes_inline,
+                        &notif->notification->module_change_notif->changes_inline);
+            }
         }
         if (SR__SUBSCRIPTION_TYPE__SUBTREE_CHANGE_SUBS == subscription->type) {
             notif->notification->subtree_change_notif->event = sr_notification_event_sr_to_gpb(event);
             notif->notification->subtree_change_notif->xpath = strdup(subscription->xpath);
             CHECK_NULL_NOMEM_ERROR(notif->notification->subtree_change_notif->xpath, rc);
+            if (SR_ERR_OK == rc && subscription->changes_inline && NULL != changes) {
+                np_notification_attach_changes(changes, &notif->notification->subtree_change_notif->changes,
+                        &notif->notification->subtree_change_notif->n_changes, &notif->notification->subtree_change_notif->has_changes_inline,
+                        &notif->notification->subtree_change_notif->changes_inline);
+            }
         }
     }
 
@@ -1406,14 +2210,71 @@ np_subscription_notify(np_ctx_t *np_ctx, np_subscription_t *subscription, sr_not
         /* save notification destination info */
         rc = np_dst_info_insert(np_ctx, subscription->dst_address, subscription->module_name);
     }
+
+    if (SR_ERR_OK == rc) {
+        *notif_p = notif;
+    } else {
+        sr_msg_free(notif);
+    }
+
+    return rc;
+}
+
+int
+np_commit_notifications_send(np_ctx_t *np_ctx, uint32_t commit_id, Sr__Msg **notifs, size_t notif_cnt)
+{
+    size_t sent_cnt = 0;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(np_ctx, np_ctx->rp_ctx, notifs);
+
+    if (0 == notif_cnt) {
+        return SR_ERR_OK;
+    }
+
+    /* account the whole batch before sending, so that no ACK can arrive before its notification is counted */
+    rc = np_commit_notif_cnt_update(np_ctx, commit_id, notif_cnt);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_ERR("Unable to account notifications of commit id=%"PRIu32".", commit_id);
+        for (size_t i = 0; i < notif_cnt; i++) {
+            sr_msg_free(notifs[i]);
+        }
+        return rc;
+    }
+
+    /* send all the messages at once */
+    SR_LOG_DBG("Sending %zu notifications of commit id=%"PRIu32".", notif_cnt, commit_id);
+    rc = cm_msg_send_batch(np_ctx->rp_ctx->cm_ctx, notifs, notif_cnt, &sent_cnt);
+    if (sent_cnt < notif_cnt) {
+        /* do not wait for ACKs of notifications that have not been sent */
+        np_commit_notif_cnt_update(np_ctx, commit_id, -(ssize_t)(notif_cnt - sent_cnt));
+    }
+
+    return rc;
+}
+
+int
+np_subscription_notify(np_ctx_t *np_ctx, np_subscription_t *subscription, sr_notif_event_t event, uint32_t commit_id,
+        sr_list_t *changes)
+{
+    Sr__Msg *notif = NULL;
+    int rc = SR_ERR_OK;
+
+    rc = np_subscription_notif_alloc(np_ctx, subscription, event, commit_id, changes, &notif);
+
+    if (SR_ERR_OK == rc) {
+        /* account the notification before sending, so that its ACK cannot arrive sooner */
+        rc = np_commit_notif_cnt_update(np_ctx, commit_id, 1);
+        if (SR_ERR_OK != rc) {
+            sr_msg_free(notif);
+        }
+    }
     if (SR_ERR_OK == rc) {
         /* send the message */
         rc = cm_msg_send(np_ctx->rp_ctx->cm_ctx, notif);
-        if (SR_ERR_OK == rc) {
-            rc = np_commit_notif_cnt_increment(np_ctx, commit_id);
+        if (SR_ERR_OK != rc) {
+            np_commit_notif_cnt_update(np_ctx, commit_id, -1);
         }
-    } else {
-        sr_msg_free(notif);
     }
 
     return rc;
@@ -1665,9 +2526,10 @@ np_store_event_notification(np_ctx_t *np_ctx, const ac_ucred_t *user_cred, const
     char data_filename[PATH_MAX] = { 0, };
     char data_xpath[PATH_MAX] = { 0, };
     char generated_time_buf[TIME_BUF_SIZE] = { 0, };
+    char *record = NULL;
+    uint32_t xpath_hash = 0;
     struct timespec logged_time_spec = { 0, };
     struct lyd_node *data_tree = NULL, *new_node = NULL;
-    int fd = -1;
     int rc = SR_ERR_OK;
 
     CHECK_NULL_ARG3(np_ctx, xpath, notif_data_tree);
@@ -1689,14 +2551,10 @@ np_store_event_notification(np_ctx_t *np_ctx, const ac_ucred_t *user_cred, const
     rc = sr_copy_first_ns(xpath, &module_name);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Error by extracting module name from xpath.");
 
-    /* get current notification data filename */
+    /* get current notification store segment */
     rc = np_get_notif_store_filename(module_name, generated_time, data_filename, PATH_MAX);
     CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to compose notification data file name for '%s'.", module_name);
 
-    /* load notif. data */
-    rc = np_load_data_tree(np_ctx, user_cred, data_filename, false, &data_tree, &fd);
-    CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to load notification store data for module '%s'.", module_name);
-
     /* format the time & retrieve current time */
     sr_time_to_str(generated_time, generated_time_buf, TIME_BUF_SIZE);
     sr_clock_get_time(CLOCK_REALTIME, &logged_time_spec);
@@ -1709,28 +2567,26 @@ np_store_event_notification(np_ctx_t *np_ctx, const ac_ucred_t *user_cred, const
         }
     }
 
-    /* create data subtree to be stored in the notif. data file */
+    /* create data subtree to be stored as a new record of the segment */
     snprintf(data_xpath, PATH_MAX - 1, NP_NS_XPATH_NOTIFICATION, tmp_xpath ? tmp_xpath : xpath, generated_time_buf,
             /* logged-time in hundreds of seconds */
             (uint32_t) (((logged_time_spec.tv_sec * 100) + (uint32_t)(logged_time_spec.tv_nsec / 1.0e7)) % UINT32_MAX));
+    xpath_hash = sr_str_hash(tmp_xpath ? tmp_xpath : xpath);
     free(tmp_xpath);
 
-    new_node = lyd_new_path(data_tree, np_ctx->ly_ctx, data_xpath, NULL, 0, 0);
-    if (NULL == new_node) {
-        SR_LOG_WRN("Error by adding new notification entry %s: %s.", data_xpath, ly_errmsg(np_ctx->ly_ctx));
-        goto cleanup; /* do not set error code - it may be just too much notifications within the same hundred of second */
-    }
+    data_tree = lyd_new_path(NULL, np_ctx->ly_ctx, data_xpath, NULL, 0, 0);
     if (NULL == data_tree) {
-        /* if the new data tree has been just created */
-        data_tree = new_node;
-        new_node = new_node->child; /* new_node is 'notifications' container */
+        SR_LOG_ERR("Error by creating new notification entry %s: %s.", data_xpath, ly_errmsg(np_ctx->ly_ctx));
+        rc = SR_ERR_INTERNAL;
+        goto cleanup;
     }
+    new_node = data_tree->child; /* data_tree is 'notifications' container */
 
     if (0 == strcmp("/ietf-netconf-notifications:netconf-config-change", xpath)) {
         char *string_notif = NULL;
         rc = dm_netconf_config_change_to_string(np_ctx->rp_ctx->dm_ctx, notif_data_tree, &string_notif);
         CHECK_RC_MSG_GOTO(rc, cleanup, "Failed print config-change notif to string");
-        switch (SR_FILE_FORMAT_LY) {
+        switch (SR_TEXT_FORMAT_LY) {
         case LYD_JSON:
             new_node = lyd_new_anydata(new_node, NULL, "data", string_notif, LYD_ANYDATA_JSOND);
             break;
@@ -1738,17 +2594,17 @@ np_store_event_notification(np_ctx_t *np_ctx, const ac_ucred_t *user_cred, const
             new_node = lyd_new_anydata(new_node, NULL, "data", string_notif, LYD_ANYDATA_STRING);
             break;
         default:
-            SR_LOG_ERR_MSG("Unknown libyang format '" "SR_FILE_FORMAT_LY" "'.");
+            SR_LOG_ERR_MSG("Unknown libyang format '" "SR_TEXT_FORMAT_LY" "'.");
             rc = SR_ERR_INTERNAL;
             goto cleanup;
         }
     } else {
         /* store notification data as anydata */
-        if (lyd_print_mem(&ptr, notif_data_tree, SR_FILE_FORMAT_LY, LYP_WITHSIBLINGS | LYP_FORMAT)) {
+        if (lyd_print_mem(&ptr, notif_data_tree, SR_TEXT_FORMAT_LY, LYP_WITHSIBLINGS | LYP_FORMAT)) {
             SR_LOG_ERR("Error printing notification data tree: %s.", ly_errmsg(notif_data_tree->schema->module->ctx));
             goto cleanup;
         }
-        switch (SR_FILE_FORMAT_LY) {
+        switch (SR_TEXT_FORMAT_LY) {
         case LYD_JSON:
             new_node = lyd_new_anydata(new_node, NULL, "data", ptr, LYD_ANYDATA_JSOND);
             break;
@@ -1756,7 +2612,7 @@ np_store_event_notification(np_ctx_t *np_ctx, const ac_ucred_t *user_cred, const
             new_node = lyd_new_anydata(new_node, NULL, "data", ptr, LYD_ANYDATA_SXMLD);
             break;
         default:
-            SR_LOG_ERR_MSG("Unknown libyang format '" "SR_FILE_FORMAT_LY" "'.");
+            SR_LOG_ERR_MSG("Unknown libyang format '" "SR_TEXT_FORMAT_LY" "'.");
             rc = SR_ERR_INTERNAL;
             goto cleanup;
         }
@@ -1767,32 +2623,34 @@ np_store_event_notification(np_ctx_t *np_ctx, const ac_ucred_t *user_cred, const
         goto cleanup;
     }
 
-    /* save notif. data */
-    rc = np_save_data_tree(data_tree, fd);
+    /* append the record to the segment */
+    if (lyd_print_mem(&record, data_tree, SR_TEXT_FORMAT_LY, LYP_WITHSIBLINGS | LYP_WD_EXPLICIT) || NULL == record) {
+        SR_LOG_ERR("Error printing notification store record: %s.", ly_errmsg(np_ctx->ly_ctx));
+        rc = SR_ERR_INTERNAL;
+        goto cleanup;
+    }
+    rc = np_ns_record_append(np_ctx, user_cred, data_filename, generated_time, xpath_hash, record);
     if (SR_ERR_OK == rc) {
         SR_LOG_DBG("Notification successfully logged into '%s' notification store.", module_name);
     }
 
 cleanup:
-    np_cleanup_data_tree(np_ctx, data_tree, fd);
+    lyd_free_withsiblings(data_tree);
+    free(record);
     free(module_name);
     return rc;
 }
 
 int
-np_get_event_notifications(np_ctx_t *np_ctx, rp_session_t *rp_session, const char *xpath,
-        const time_t start_time, const time_t stop_time, const sr_api_variant_t api_variant, sr_list_t **notifications)
+np_event_notif_reader_open(np_ctx_t *np_ctx, rp_session_t *rp_session, const char *xpath, const time_t start_time,
+        const time_t stop_time, const sr_api_variant_t api_variant, np_ev_notif_reader_t **reader_p)
 {
-    char *module_name = NULL;
-    char req_xpath[PATH_MAX] = { 0, };
-    sr_list_t *file_list = NULL, *notif_list = NULL;
-    struct lyd_node *data_tree = NULL, *main_tree = NULL;
-    struct ly_set *node_set = NULL;
-    np_ev_notification_t *notification = NULL;
+    char *module_name = NULL, *ptr = NULL;
+    np_ev_notif_reader_t *reader = NULL;
     time_t effective_stop_time = 0;
-    int rc = SR_ERR_OK, ret = 0;
+    int rc = SR_ERR_OK;
 
-    CHECK_NULL_ARG3(np_ctx, xpath, notifications);
+    CHECK_NULL_ARG4(np_ctx, rp_session, xpath, reader_p);
 
     effective_stop_time = (0 == stop_time) ? time(NULL) : stop_time;
 
@@ -1801,76 +2659,131 @@ np_get_event_notifications(np_ctx_t *np_ctx, rp_session_t *rp_session, const cha
     /* extract module name from xpath */
     if (xpath[0] != '/') {
         module_name = strdup(xpath);
-        xpath = NULL;
+        CHECK_NULL_NOMEM_RETURN(module_name);
     } else {
         rc = sr_copy_first_ns(xpath, &module_name);
-        CHECK_RC_MSG_GOTO(rc, cleanup, "Error by extracting module name from xpath.");
+        CHECK_RC_MSG_RETURN(rc, "Error by extracting module name from xpath.");
     }
 
-    /* get all notification files matching module name and time interval */
-    rc = sr_list_init(&file_list);
-    CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to initialize file list.");
+    /* the reader skips the records outside of the time interval */
+    rc = np_ns_reader_init(np_ctx, rp_session->user_credentials, module_name, start_time, effective_stop_time, &reader);
+    CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to open notification store of module '%s'.", module_name);
 
-    /* get all notification files matching module name and provided time interval */
-    rc = np_get_notification_files(np_ctx, module_name,
-            (0 == start_time) ? 0 : (start_time - (SR_NOTIF_TIME_WINDOW * 60)),
-            (effective_stop_time + (SR_NOTIF_TIME_WINDOW * 60)),
-            file_list);
-    CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to retrieve notification file list.");
+    reader->rp_session = rp_session;
+    reader->api_variant = api_variant;
 
-    /* load all notification files */
-    for (size_t i = 0; i < file_list->count; i++) {
-        rc = np_load_data_tree(np_ctx, rp_session->user_credentials, file_list->data[i], true, &data_tree, NULL);
-        CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to load notification store data for module '%s'.", module_name);
-        if (NULL == main_tree) {
-            main_tree = data_tree;
-        } else {
-            ret = lyd_merge(main_tree, data_tree, LYD_OPT_DESTRUCT);
-            CHECK_ZERO_LOG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup,
-                                "Unable to merge notification trees: %s", ly_errmsg(main_tree->schema->module->ctx));
+    if (xpath[0] == '/') {
+        /* quotes in the xpath are replaced in the same way as by storing of the notification */
+        reader->xpath = strdup(xpath);
+        CHECK_NULL_NOMEM_GOTO(reader->xpath, rc, cleanup);
+        for (ptr = strchr(reader->xpath, '\''); ptr; ptr = strchr(ptr + 1, '\'')) {
+            *ptr = '"';
         }
+        reader->xpath_hash = sr_str_hash(reader->xpath);
     }
 
-    /* get all notifications matching the xpath */
-    if (NULL == xpath) {
-        node_set = lyd_find_path(main_tree, "/*/*");
-    } else {
-        snprintf(req_xpath, PATH_MAX, NP_NS_XPATH_NOTIFICATION_BY_XPATH, xpath);
-        node_set = lyd_find_path(main_tree, req_xpath);
-    }
-
-    if (NULL != node_set && node_set->number > 0) {
-        /* init the notification list */
-        rc = sr_list_init(&notif_list);
-        CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to initialize notification list.");
-
-        for (size_t i = 0; i < node_set->number; i++) {
-            /* allocate a new notification entry */
-            notification = calloc(1, sizeof(*notification));
-            CHECK_NULL_NOMEM_GOTO(notification, rc, cleanup);
-            /* fill in the notification details */
-            rc = np_event_notification_entry_fill(notification, node_set->set.d[i]->child);
-            CHECK_RC_MSG_GOTO(rc, cleanup, "Error by filling a notification entry.");
-
-            /* filter out notifications not exactly matching the time interval */
-            if (notification->timestamp < start_time || notification->timestamp > effective_stop_time) {
-                np_event_notification_cleanup(notification);
-                notification = NULL;
-                continue;
-            }
+    *reader_p = reader;
+    reader = NULL;
 
-            /* parse notification data */
-            rc = dm_parse_event_notif(np_ctx->rp_ctx, rp_session, NULL, notification, api_variant);
-            CHECK_RC_LOG_GOTO(rc, cleanup, "Error by parsing notification '%s'.", notification->xpath);
+cleanup:
+    np_ns_reader_cleanup(reader);
+    free(module_name);
+    return rc;
+}
 
-            SR_LOG_DBG("Adding a new notification: '%s' (time=%ld)", notification->xpath, notification->timestamp);
+int
+np_event_notif_reader_next(np_ev_notif_reader_t *reader, np_ev_notification_t **notification_p)
+{
+    struct lyd_node *data_tree = NULL;
+    np_ev_notification_t *notification = NULL;
+    int rc = SR_ERR_OK;
 
-            /* add the notification into notification list */
-            rc = sr_list_add(notif_list, notification);
-            CHECK_RC_MSG_GOTO(rc, cleanup, "Error by adding notification into list.");
+    CHECK_NULL_ARG2(reader, notification_p);
+
+    while (SR_ERR_OK == (rc = np_ns_reader_record_next(reader, &data_tree))) {
+        if (NULL == data_tree->child) {
+            lyd_free_withsiblings(data_tree);
+            data_tree = NULL;
+            continue;
+        }
+
+        /* allocate a new notification entry */
+        notification = calloc(1, sizeof(*notification));
+        CHECK_NULL_NOMEM_GOTO(notification, rc, cleanup);
+        /* fill in the notification details */
+        rc = np_event_notification_entry_fill(notification, data_tree->child->child);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Error by filling a notification entry.");
+
+        /* filter out notifications not matching the xpath or exactly matching the time interval */
+        if ((NULL != reader->xpath && (NULL == notification->xpath || 0 != strcmp(notification->xpath, reader->xpath))) ||
+                notification->timestamp < reader->start_time || notification->timestamp > reader->stop_time) {
+            np_event_notification_cleanup(notification);
             notification = NULL;
+            lyd_free_withsiblings(data_tree);
+            data_tree = NULL;
+            continue;
+        }
+
+        /* parse notification data */
+        rc = dm_parse_event_notif(reader->np_ctx->rp_ctx, reader->rp_session, NULL, notification, reader->api_variant);
+        CHECK_RC_LOG_GOTO(rc, cleanup, "Error by parsing notification '%s'.", notification->xpath);
+
+        SR_LOG_DBG("Read a notification: '%s' (time=%ld)", notification->xpath, notification->timestamp);
+
+        *notification_p = notification;
+        notification = NULL;
+        break;
+    }
+    if (SR_ERR_OK != rc && SR_ERR_NOT_FOUND != rc) {
+        SR_LOG_ERR_MSG("Error by reading the notification store.");
+    }
+
+cleanup:
+    np_event_notification_cleanup(notification);
+    lyd_free_withsiblings(data_tree);
+    return rc;
+}
+
+void
+np_event_notif_reader_pause(np_ev_notif_reader_t *reader)
+{
+    np_ns_reader_pause(reader);
+}
+
+void
+np_event_notif_reader_close(np_ev_notif_reader_t *reader)
+{
+    np_ns_reader_cleanup(reader);
+}
+
+int
+np_get_event_notifications(np_ctx_t *np_ctx, rp_session_t *rp_session, const char *xpath,
+        const time_t start_time, const time_t stop_time, const sr_api_variant_t api_variant, sr_list_t **notifications)
+{
+    sr_list_t *notif_list = NULL;
+    np_ev_notif_reader_t *reader = NULL;
+    np_ev_notification_t *notification = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG4(np_ctx, rp_session, xpath, notifications);
+
+    rc = np_event_notif_reader_open(np_ctx, rp_session, xpath, start_time, stop_time, api_variant, &reader);
+    CHECK_RC_LOG_RETURN(rc, "Unable to read notifications '%s'.", xpath);
+
+    while (SR_ERR_OK == (rc = np_event_notif_reader_next(reader, &notification))) {
+        /* add the notification into notification list */
+        if (NULL == notif_list) {
+            rc = sr_list_init(&notif_list);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to initialize notification list.");
         }
+        rc = sr_list_add(notif_list, notification);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Error by adding notification into list.");
+        notification = NULL;
     }
+    if (SR_ERR_NOT_FOUND != rc) {
+        goto cleanup;
+    }
+    rc = SR_ERR_OK;
 
     *notifications = notif_list;
     notif_list = NULL;
@@ -1884,10 +2797,7 @@ cleanup:
         }
         sr_list_cleanup(notif_list);
     }
-    ly_set_free(node_set);
-    lyd_free_withsiblings(main_tree);
-    sr_free_list_of_strings(file_list);
-    free(module_name);
+    np_event_notif_reader_close(reader);
     return rc;
 }
 
@@ -1903,6 +2813,7 @@ np_event_notification_cleanup(np_ev_notification_t *notification)
 int
 np_notification_store_cleanup(np_ctx_t *np_ctx, bool reschedule)
 {
+    char index_filename[PATH_MAX] = { 0, };
     sr_list_t *file_list = NULL;
     int ret = 0, rc = SR_ERR_OK;
 
@@ -1916,11 +2827,21 @@ np_notification_store_cleanup(np_ctx_t *np_ctx, bool reschedule)
     rc = np_get_all_notification_files(np_ctx, 0, (time(NULL) - (SR_NOTIF_AGE_TIMEOUT * 60)), file_list);
 
     for (size_t i = 0; i < file_list->count; i++) {
+        if (sr_str_ends_with(file_list->data[i], NP_NS_INDEX_EXT)) {
+            /* indices are deleted together with their segments */
+            continue;
+        }
         SR_LOG_DBG("Deleting old notification data file '%s'.", (char*)file_list->data[i]);
         ret = unlink((char*)file_list->data[i]);
         if (-1 == ret) {
             SR_LOG_WRN("Unable to delete notification data file '%s': %s.",
-                    (char*)file_list->data[i], sr_strerror_safe(ret));
+                    (char*)file_list->data[i], sr_strerror_safe(errno));
+        } else if (sr_str_ends_with(file_list->data[i], NP_NS_SEGMENT_EXT)) {
+            np_ns_segment_uncheck(np_ctx, file_list->data[i]);
+            np_ns_index_filename(file_list->data[i], index_filename, PATH_MAX);
+            if (-1 == unlink(index_filename) && ENOENT != errno) {
+                SR_LOG_WRN("Unable to delete notification data file '%s': %s.", index_filename, sr_strerror_safe(errno));
+            }
         }
     }
 
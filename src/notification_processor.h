@@ -53,8 +53,11 @@ typedef struct np_subscription_s {
     const char *xpath;                 /**< XPath to the subtree where the subscription is active (if applicable). */
     const char *username;              /**< Name of the user behind the subscription (for event notifications only). */
     uint32_t priority;                 /**< Priority of the subscription by delivering notifications (0 is the lowest priority). */
+    uint32_t cache_ttl;                /**< For how long (ms) the data provided by the subscriber can be cached, 0 if not at all. */
     bool enable_running;               /**< TRUE if the subscription enables specified subtree in the running datastore. */
     bool enable_nacm;                  /**< TRUE if the NETCONF Access Control is enabled for this subscription. */
+    bool dp_bulk;                      /**< TRUE if the data provider accepts requests for all instances of a parent list at once. */
+    bool changes_inline;               /**< TRUE if the changes should be delivered within the change notifications. */
     sr_api_variant_t api_variant;      /**< API variant -- values vs. trees (relevant for the callback type only). */
     size_t copy_cnt;                   /**< Count of other references to the primary structure. 0 means no other copies exist. */
 } np_subscription_t;
@@ -87,6 +90,11 @@ typedef struct np_ev_notification_s {
     size_t data_cnt;                    /**< Values of the data. */
 } np_ev_notification_t;
 
+/**
+ * @brief Reader of the event notifications stored in the notification datastore (opaque for public API).
+ */
+typedef struct np_ev_notif_reader_s np_ev_notif_reader_t;
+
 /**
  * @brief Initializes a Notification Processor instance.
  *
@@ -114,6 +122,8 @@ typedef enum np_subscr_flag_e {
     NP_SUBSCR_ENABLE_RUNNING = 1,
     NP_SUBSCR_EXCLUSIVE = 2,
     NP_SUBSCR_EV_EVENT = 4,
+    NP_SUBSCR_DP_BULK = 8,
+    NP_SUBSCR_CHANGES_INLINE = 16,
 } np_subscr_flag_t;
 
 /**
@@ -135,6 +145,7 @@ typedef uint32_t np_subscr_options_t;
  * @param[in] username Effective user name used to authorize access to receive (event) notifications.
  * @param[in] notif_event Notification event which the notification subscriber is interested in.
  * @param[in] priority Priority of the subscribtion by delivering notifications (0 is the lowest priority).
+ * @param[in] cache_ttl Operational data cache TTL in milliseconds (data provider subscriptions only, 0 = no caching).
  * @param[in] api_variant Variant of the subscription API which was used to create the subscription.
  * @param[in] opts Options overriding default handling. Bitwise OR-ed value of any ::np_subscr_flag_t flags.
  *
@@ -142,7 +153,8 @@ typedef uint32_t np_subscr_options_t;
  */
 int np_notification_subscribe(np_ctx_t *np_ctx, const rp_session_t *rp_session, Sr__SubscriptionType type,
         const char *dst_address, uint32_t dst_id, const char *module_name, const char *xpath, const char *username,
-        Sr__NotificationEvent notif_event, uint32_t priority, sr_api_variant_t api_variant, const np_subscr_options_t opts);
+        Sr__NotificationEvent notif_event, uint32_t priority, uint32_t cache_ttl, sr_api_variant_t api_variant,
+        const np_subscr_options_t opts);
 
 /**
  * @brief Unsubscribe the client from notifications on specified event.
@@ -237,6 +249,37 @@ int np_get_module_change_subscriptions(np_ctx_t *np_ctx, const ac_ucred_t *user_
 int np_get_data_provider_subscriptions(np_ctx_t *np_ctx, const rp_session_t *rp_session, const char *module_name,
         sr_list_t **subscriptions);
 
+/**
+ * @brief Allocates a notification about the change the subscriber is subscribed to. The notification
+ * is meant to be sent together with other notifications of the commit by ::np_commit_notifications_send.
+ *
+ * @param[in] np_ctx Notification Processor context acquired by ::np_init call.
+ * @param[in] subscription Subscription context acquired by ::np_get_module_change_subscriptions call.
+ * @param[in] event type of event to be sent to subscription
+ * @param[in] commit_id ID of the commit to be used for starting a new notification session from client library.
+ * @param[in] changes List of changes (sr_change_t) matching the subscription, delivered within the notification
+ * if the subscriber asked for it (::NP_SUBSCR_CHANGES_INLINE). Can be NULL.
+ * @param[out] notif Allocated notification message.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int np_subscription_notif_alloc(np_ctx_t *np_ctx, np_subscription_t *subscription, sr_notif_event_t event,
+        uint32_t commit_id, sr_list_t *changes, Sr__Msg **notif);
+
+/**
+ * @brief Sends a batch of notifications of the commit to the subscribers at once. All of them are accounted
+ * in the commit context before any of them is sent, the commit then waits for their acknowledgments.
+ *
+ * @param[in] np_ctx Notification Processor context acquired by ::np_init call.
+ * @param[in] commit_id ID of the commit.
+ * @param[in] notifs Array of notifications allocated by ::np_subscription_notif_alloc. The messages
+ * are freed automatically after sending, also in case of error.
+ * @param[in] notif_cnt Count of notifications in the array.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int np_commit_notifications_send(np_ctx_t *np_ctx, uint32_t commit_id, Sr__Msg **notifs, size_t notif_cnt);
+
 /**
  * @brief Notify the subscriber about the change they are subscribed to.
  *
@@ -244,10 +287,13 @@ int np_get_data_provider_subscriptions(np_ctx_t *np_ctx, const rp_session_t *rp_
  * @param[in] subscription Subscription context acquired by ::np_get_module_change_subscriptions call.
  * @param[in] event type of event to be sent to subscription
  * @param[in] commit_id ID of the commit to be used for starting a new notification session from client library.
+ * @param[in] changes List of changes (sr_change_t) matching the subscription, delivered within the notification
+ * if the subscriber asked for it (::NP_SUBSCR_CHANGES_INLINE). Can be NULL.
  *
  * @return Error code (SR_ERR_OK on success).
  */
-int np_subscription_notify(np_ctx_t *np_ctx, np_subscription_t *subscription, sr_notif_event_t event, uint32_t commit_id);
+int np_subscription_notify(np_ctx_t *np_ctx, np_subscription_t *subscription, sr_notif_event_t event, uint32_t commit_id,
+        sr_list_t *changes);
 
 /**
  * @brief Request operational data from a data provider subscription.
@@ -352,6 +398,49 @@ int np_store_event_notification(np_ctx_t *np_ctx, const ac_ucred_t *user_cred, c
 int np_get_event_notifications(np_ctx_t *np_ctx, rp_session_t *rp_session, const char *xpath,
         const time_t start_time, const time_t stop_time, const sr_api_variant_t api_variant, sr_list_t **notifications);
 
+/**
+ * @brief Opens a reader of the event notifications stored in the notification datastore. In contrast to
+ * ::np_get_event_notifications, the notifications are read from the datastore incrementally, one by one.
+ *
+ * @param[in] np_ctx Notification Processor context acquired by ::np_init call.
+ * @param[in] rp_session Request Processor session context.
+ * @param[in] xpath XPath of the notifications to be read (or module name to read all notifications of the module).
+ * @param[in] start_time Start time of the time window.
+ * @param[in] stop_time Stop time of the time window (0 means the current time).
+ * @param[in] api_variant Requested API variant (values/trees) of the data to be read.
+ * @param[out] reader Allocated reader, to be released by ::np_event_notif_reader_close.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int np_event_notif_reader_open(np_ctx_t *np_ctx, rp_session_t *rp_session, const char *xpath,
+        const time_t start_time, const time_t stop_time, const sr_api_variant_t api_variant, np_ev_notif_reader_t **reader);
+
+/**
+ * @brief Reads the next stored event notification matching the parameters of the reader.
+ *
+ * @param[in] reader Reader opened by ::np_event_notif_reader_open.
+ * @param[out] notification Notification read from the datastore, to be freed by ::np_event_notification_cleanup.
+ *
+ * @return Error code (SR_ERR_OK on success, SR_ERR_NOT_FOUND if there are no more notifications to be read).
+ */
+int np_event_notif_reader_next(np_ev_notif_reader_t *reader, np_ev_notification_t **notification);
+
+/**
+ * @brief Releases the notification datastore file currently opened (and locked) by the reader, so that
+ * storing of new notifications is not blocked while the reading is paused. Reading continues from the same
+ * position by the next ::np_event_notif_reader_next call.
+ *
+ * @param[in] reader Reader opened by ::np_event_notif_reader_open.
+ */
+void np_event_notif_reader_pause(np_ev_notif_reader_t *reader);
+
+/**
+ * @brief Closes the reader of stored event notifications.
+ *
+ * @param[in] reader Reader opened by ::np_event_notif_reader_open.
+ */
+void np_event_notif_reader_close(np_ev_notif_reader_t *reader);
+
 /**
  * @brief Cleans up an event notification structure.
  *
@@ -56,6 +56,9 @@
 #define PM_XPATH_SUBSCRIPTION_ENABLE_RUNNING  PM_XPATH_SUBSCRIPTION      "/enable-running"
 #define PM_XPATH_SUBSCRIPTION_ENABLE_NACM     PM_XPATH_SUBSCRIPTION      "/enable-nacm"
 #define PM_XPATH_SUBSCRIPTION_API_VARIANT     PM_XPATH_SUBSCRIPTION      "/api-variant"
+#define PM_XPATH_SUBSCRIPTION_CACHE_TTL       PM_XPATH_SUBSCRIPTION      "/cache-ttl"
+#define PM_XPATH_SUBSCRIPTION_DP_BULK         PM_XPATH_SUBSCRIPTION      "/dp-bulk"
+#define PM_XPATH_SUBSCRIPTION_CHANGES_INLINE  PM_XPATH_SUBSCRIPTION      "/changes-inline"
 
 #define PM_XPATH_SUBSCRIPTIONS_BY_TYPE        PM_XPATH_SUBSCRIPTION_LIST "[type='" PM_MODULE_NAME ":%s']"
 #define PM_XPATH_SUBSCRIPTIONS_BY_TYPE_XPATH  PM_XPATH_SUBSCRIPTION_LIST "[type='" PM_MODULE_NAME ":%s'][xpath='%s']"
@@ -259,7 +262,7 @@ pm_load_data_tree(pm_ctx_t *pm_ctx, const ac_ucred_t *user_cred, const char *mod
     CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to lock persist data file for '%s'.", module_name);
 
     ly_errno = LY_SUCCESS;
-    *data_tree = lyd_parse_fd(pm_ctx->ly_ctx, fd, SR_FILE_FORMAT_LY, LYD_OPT_STRICT | LYD_OPT_CONFIG | LYD_OPT_NOAUTODEL);
+    *data_tree = lyd_parse_fd(pm_ctx->ly_ctx, fd, sr_data_file_format(fd), LYD_OPT_STRICT | LYD_OPT_CONFIG | LYD_OPT_NOAUTODEL);
     if (NULL == *data_tree && LY_SUCCESS != ly_errno) {
         SR_LOG_ERR("Parsing persist data from file '%s' failed: %s", data_filename, ly_errmsg(pm_ctx->ly_ctx));
         rc = SR_ERR_INTERNAL;
@@ -466,12 +469,21 @@ pm_subscription_entry_fill(const char *module_name, np_subscription_t *subscript
             if (0 == strcmp(node->schema->name, "priority") && NULL != node_ll->value_str) {
                 subscription->priority = atoi(node_ll->value_str);
             }
+            if (0 == strcmp(node->schema->name, "cache-ttl") && NULL != node_ll->value_str) {
+                subscription->cache_ttl = node_ll->value.uint32;
+            }
             if (0 == strcmp(node->schema->name, "enable-running")) {
                 subscription->enable_running = true;
             }
             if (0 == strcmp(node->schema->name, "enable-nacm")) {
                 subscription->enable_nacm = true;
             }
+            if (0 == strcmp(node->schema->name, "dp-bulk")) {
+                subscription->dp_bulk = true;
+            }
+            if (0 == strcmp(node->schema->name, "changes-inline")) {
+                subscription->changes_inline = true;
+            }
             if (0 == strcmp(node->schema->name, "api-variant") && NULL != node_ll->value_str) {
                 subscription->api_variant = sr_api_variant_from_str(node_ll->value_str);
             }
@@ -1183,6 +1195,27 @@ pm_add_subscription(pm_ctx_t *pm_ctx, const ac_ucred_t *user_cred, const char *m
         rc = pm_modify_persist_data_tree(pm_ctx, &data_tree, xpath, value, true, true, NULL);
         CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to add new leaf into the data tree.");
     }
+    if (SR__SUBSCRIPTION_TYPE__DP_GET_ITEMS_SUBS == subscription->type && subscription->cache_ttl > 0) {
+        snprintf(xpath, PATH_MAX, PM_XPATH_SUBSCRIPTION_CACHE_TTL, module_name,
+                sr_subscription_type_gpb_to_str(subscription->type), subscription->dst_address, subscription->dst_id);
+        snprintf(buff, sizeof(buff), "%"PRIu32, subscription->cache_ttl);
+        value = buff;
+        rc = pm_modify_persist_data_tree(pm_ctx, &data_tree, xpath, value, true, true, NULL);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to add new leaf into the data tree.");
+    }
+    if ((SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS == subscription->type ||
+            SR__SUBSCRIPTION_TYPE__SUBTREE_CHANGE_SUBS == subscription->type) && subscription->changes_inline) {
+        snprintf(xpath, PATH_MAX, PM_XPATH_SUBSCRIPTION_CHANGES_INLINE, module_name,
+                sr_subscription_type_gpb_to_str(subscription->type), subscription->dst_address, subscription->dst_id);
+        rc = pm_modify_persist_data_tree(pm_ctx, &data_tree, xpath, NULL, true, true, NULL);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to add new leaf into the data tree.");
+    }
+    if (SR__SUBSCRIPTION_TYPE__DP_GET_ITEMS_SUBS == subscription->type && subscription->dp_bulk) {
+        snprintf(xpath, PATH_MAX, PM_XPATH_SUBSCRIPTION_DP_BULK, module_name,
+                sr_subscription_type_gpb_to_str(subscription->type), subscription->dst_address, subscription->dst_id);
+        rc = pm_modify_persist_data_tree(pm_ctx, &data_tree, xpath, NULL, true, true, NULL);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to add new leaf into the data tree.");
+    }
     if (SR__SUBSCRIPTION_TYPE__RPC_SUBS == subscription->type ||
             SR__SUBSCRIPTION_TYPE__EVENT_NOTIF_SUBS == subscription->type ||
             SR__SUBSCRIPTION_TYPE__ACTION_SUBS == subscription->type) {
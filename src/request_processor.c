@@ -35,7 +35,9 @@
 #include "rp_dt_edit.h"
 #include "rp_dt_xpath.h"
 
-#define RP_INIT_REQ_QUEUE_SIZE   10  /**< Initial size of the request queue. */
+#define RP_REQ_QUEUE_SIZE   1024  /**< Size of the lock-free part of the request queue. */
+#define RP_INIT_SESS_REQ_QUEUE_SIZE 2  /**< Initial size of the run-queue of postponed requests of a session. */
+#define RP_NOTIF_REPLAY_BATCH_SIZE 64  /**< Maximum number of replayed event notifications sent to a subscriber at once. */
 
 /*
  * Attributes that can significantly affect performance of the threadpool.
@@ -52,8 +54,180 @@
 typedef struct rp_request_s {
     rp_session_t *session;  /**< Request Processor's session. */
     Sr__Msg *msg;           /**< Message to be processed. */
+    bool scheduled;         /**< The request already owns its session: it is a resumed paused request
+                                 or the next request taken from the run-queue of the session. */
 } rp_request_t;
 
+/**
+ * @brief Enqueues a request into the request queue and wakes up a worker thread if needed.
+ */
+static int
+rp_request_enqueue(rp_ctx_t *rp_ctx, rp_request_t *req)
+{
+    struct timespec now = { 0 };
+    size_t active_threads = 0, queued = 0;
+    int rc = SR_ERR_OK;
+
+    /* enqueue the request into the queue, no locking needed */
+    rc = sr_mpmc_queue_enqueue(rp_ctx->request_queue, req);
+
+    /* pairs with the decrement of active_threads by a worker going to sleep */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    active_threads = __atomic_load_n(&rp_ctx->active_threads, __ATOMIC_SEQ_CST);
+    queued = sr_mpmc_queue_items_in_queue(rp_ctx->request_queue);
+
+    SR_LOG_DBG("Threads: active=%zu/%zu, %zu requests in queue", active_threads, rp_ctx->thread_count, queued);
+
+    /* send signal if there is no active thread ready to process the request */
+    if (0 == active_threads ||
+            (((queued / active_threads) > RP_REQ_PER_THREADS) && active_threads < rp_ctx->thread_count)) {
+        pthread_mutex_lock(&rp_ctx->request_queue_mutex);
+        if (0 == active_threads) {
+            /* there is no active (non-sleeping) thread - if this is happening too
+             * frequently, instruct the threads to spin before going to sleep */
+            sr_clock_get_time(CLOCK_MONOTONIC, &now);
+            uint64_t diff = (1000000000L * (now.tv_sec - rp_ctx->last_thread_wakeup.tv_sec)) + now.tv_nsec - rp_ctx->last_thread_wakeup.tv_nsec;
+            size_t spin_limit = rp_ctx->thread_spin_limit;
+            if (diff < RP_THREAD_SPIN_TIMEOUT) {
+                /* a thread has been woken up in less than RP_THREAD_SPIN_TIMEOUT, increase the spin */
+                if (0 == spin_limit) {
+                    /* no spin set yet, set to initial value */
+                    spin_limit = RP_THREAD_SPIN_MIN;
+                } else if(spin_limit < RP_THREAD_SPIN_MAX) {
+                    /* double the spin limit */
+                    spin_limit *= 2;
+                }
+            } else {
+                /* reset spin to 0 if wakaups are not too frequent */
+                spin_limit = 0;
+            }
+            __atomic_store_n(&rp_ctx->thread_spin_limit, spin_limit, __ATOMIC_RELAXED);
+            rp_ctx->last_thread_wakeup = now;
+        }
+        pthread_cond_signal(&rp_ctx->request_queue_cv);
+        pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
+    }
+
+    return rc;
+}
+
+/**
+ * @brief Tries to acquire the session for processing of a request. Requests of a session
+ * are processed one by one, in the order in which they were received. If another request
+ * of the session is being processed (or is paused), the request is postponed into
+ * the run-queue of the session.
+ *
+ * @param[in] session Request Processor's session.
+ * @param[in] req Request to be processed.
+ * @param[out] postponed TRUE if the request has been postponed and must not be processed now.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+static int
+rp_session_req_acquire(rp_session_t *session, rp_request_t *req, bool *postponed)
+{
+    int rc = SR_ERR_OK;
+
+    *postponed = false;
+
+    pthread_mutex_lock(&session->msg_count_mutex);
+    if (session->req_in_progress) {
+        rc = sr_cbuff_enqueue(session->req_queue, req);
+        if (SR_ERR_OK == rc) {
+            SR_LOG_DBG("Request of session id=%"PRIu32" postponed, another request of the session is in progress.", session->id);
+            *postponed = true;
+        }
+    } else {
+        session->req_in_progress = true;
+    }
+    pthread_mutex_unlock(&session->msg_count_mutex);
+
+    return rc;
+}
+
+/**
+ * @brief Releases the session after its request in progress has been finished and
+ * schedules the next postponed request of the session, if there is any.
+ */
+static void
+rp_session_req_release(rp_ctx_t *rp_ctx, rp_session_t *session)
+{
+    rp_request_t req = { 0 };
+    bool next = false;
+    int rc = SR_ERR_OK;
+
+    do {
+        pthread_mutex_lock(&session->msg_count_mutex);
+        next = sr_cbuff_dequeue(session->req_queue, &req);
+        session->req_in_progress = next;
+        pthread_mutex_unlock(&session->msg_count_mutex);
+
+        if (next) {
+            /* the next request inherits the session */
+            req.scheduled = true;
+            rc = rp_request_enqueue(rp_ctx, &req);
+            if (SR_ERR_OK != rc) {
+                SR_LOG_ERR("Unable to schedule the next request of session id=%"PRIu32", skipping.", session->id);
+                pthread_mutex_lock(&session->msg_count_mutex);
+                session->msg_count -= 1;
+                pthread_mutex_unlock(&session->msg_count_mutex);
+                sr_msg_free(req.msg);
+            }
+        }
+    } while (next && SR_ERR_OK != rc);
+}
+
+/**
+ * @brief Enqueues a message for processing. The message is released in case of error.
+ *
+ * @param[in] scheduled TRUE if the message is a paused request of the session
+ * being resumed, FALSE for new messages.
+ */
+static int
+rp_msg_enqueue(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, bool scheduled)
+{
+    rp_request_t req = { 0 };
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG_NORET2(rc, rp_ctx, msg);
+
+    if (SR_ERR_OK != rc) {
+        if (NULL != msg) {
+            sr_msg_free(msg);
+        }
+        return rc;
+    }
+
+    if (NULL != session) {
+        pthread_mutex_lock(&session->msg_count_mutex);
+        session->msg_count += 1;
+        pthread_mutex_unlock(&session->msg_count_mutex);
+    }
+
+    req.session = session;
+    req.msg = msg;
+    req.scheduled = scheduled;
+
+    rc = rp_request_enqueue(rp_ctx, &req);
+
+    if (SR_ERR_OK != rc) {
+        /* release the message by error */
+        SR_LOG_ERR_MSG("Unable to process the message, skipping.");
+        if (NULL != session) {
+            if (scheduled) {
+                /* the paused request will not be finished, let other requests of the session run */
+                rp_session_req_release(rp_ctx, session);
+            }
+            pthread_mutex_lock(&session->msg_count_mutex);
+            session->msg_count -= 1;
+            pthread_mutex_unlock(&session->msg_count_mutex);
+        }
+        sr_msg_free(msg);
+    }
+
+    return rc;
+}
+
 /**
  * @brief Capability change type
  */
@@ -190,6 +364,51 @@ rp_set_oper_request_timeout(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *re
     return rc;
 }
 
+/**
+ * @brief Schedules a request closing the get_items_iter cursors of the session that will not have been used
+ * for ::SR_GET_ITEMS_CURSOR_TIMEOUT seconds, unless one is scheduled already. Called with cur_req_mutex held.
+ */
+static int
+rp_set_get_items_cursor_timeout(rp_ctx_t *rp_ctx, rp_session_t *session)
+{
+    Sr__Msg *msg = NULL;
+    rp_dt_get_items_ctx_t *cursor = NULL;
+    struct timespec now = { 0, };
+    long timeout = SR_GET_ITEMS_CURSOR_TIMEOUT;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG2(rp_ctx, session);
+
+    if (session->cursor_timer_pending || NULL == session->get_items_cursors ||
+            0 == session->get_items_cursors->count) {
+        return SR_ERR_OK;
+    }
+
+    /* the least recently used cursor expires first */
+    cursor = session->get_items_cursors->data[0];
+    sr_clock_get_time(CLOCK_MONOTONIC, &now);
+    timeout -= now.tv_sec - cursor->last_used.tv_sec;
+    if (timeout < 1) {
+        timeout = 1;
+    }
+
+    rc = sr_gpb_internal_req_alloc(NULL, SR__OPERATION__GET_ITEMS_CURSOR_TIMEOUT, &msg);
+    if (SR_ERR_OK == rc) {
+        msg->session_id = session->id;
+        msg->internal_request->postpone_timeout = (uint32_t)timeout;
+        msg->internal_request->has_postpone_timeout = true;
+        rc = cm_msg_send(rp_ctx->cm_ctx, msg);
+    }
+
+    if (SR_ERR_OK == rc) {
+        session->cursor_timer_pending = true;
+    } else {
+        SR_LOG_ERR("Unable to setup a timeout for get_items cursors: %s.", sr_strerror(rc));
+    }
+
+    return rc;
+}
+
 static int
 rp_create_capability_change_values(rp_ctx_t *rp_ctx, rp_session_t *session, const char *module_name, rp_capability_change_type_t change_type, sr_val_t **value, size_t *val_cnt)
 {
@@ -782,8 +1001,10 @@ cleanup:
 static int
 rp_get_items_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, bool *skip_msg_cleanup)
 {
-    sr_val_t *values = NULL;
-    size_t count = 0, limit = 0, offset = 0;
+    Sr__GetItemsResp *get_items_resp = NULL;
+    Sr__GetItemsReq *get_items_req = NULL;
+    rp_dt_get_items_ctx_t *cursor = NULL;
+    size_t limit = 0, offset = 0;
     char *xpath = NULL;
     int rc = SR_ERR_OK;
 
@@ -814,15 +1035,44 @@ rp_get_items_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg,
     /* store current request to session */
     session->req = msg;
 
-    xpath = msg->request->get_items_req->xpath;
-    offset = msg->request->get_items_req->offset;
-    limit = msg->request->get_items_req->limit;
+    get_items_req = msg->request->get_items_req;
+    xpath = get_items_req->xpath;
+    offset = get_items_req->offset;
+    limit = get_items_req->limit;
 
-    if (msg->request->get_items_req->has_offset || msg->request->get_items_req->has_limit) {
-        rc = rp_dt_get_values_wrapper_with_opts(rp_ctx, session, &session->get_items_ctx, sr_mem, xpath,
-                offset, limit, &values, &count);
+    /* values are encoded directly into the response, allocated in its memory context */
+    get_items_resp = resp->response->get_items_resp;
+    if (get_items_req->has_offset || get_items_req->has_limit) {
+        rc = rp_dt_get_items_cursor(session, get_items_req->has_cursor_id ? get_items_req->cursor_id : 0,
+                get_items_req->has_open_cursor && get_items_req->open_cursor, limit, &cursor);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_ERR("Failed to get the get_items cursor, session id=%"PRIu32".", session->id);
+            pthread_mutex_unlock(&session->cur_req_mutex);
+            goto cleanup;
+        }
+        if (0 != cursor->id) {
+            /* clients using the handles accept larger pages, the page grows with each request */
+            limit = cursor->page_size > limit ? cursor->page_size : limit;
+            cursor->page_size = 2 * limit < SR_GET_ITEMS_MAX_FETCH_LIMIT ? 2 * limit : SR_GET_ITEMS_MAX_FETCH_LIMIT;
+        }
+        rc = rp_dt_get_gpb_values_wrapper_with_opts(rp_ctx, session, cursor, sr_mem, xpath,
+                offset, limit, &get_items_resp->values, &get_items_resp->n_values);
+        if (RP_REQ_WAITING_FOR_DATA != session->state && 0 != cursor->id) {
+            get_items_resp->has_cursor_id = true;
+            get_items_resp->cursor_id = cursor->id;
+        }
+        if (RP_REQ_WAITING_FOR_DATA == session->state || SR_ERR_OK != rc || NULL == cursor->nodes ||
+                cursor->offset >= cursor->nodes->number) {
+            /* the iteration is finished (or the cursor will be opened again once the data are loaded) */
+            if (get_items_resp->has_cursor_id) {
+                get_items_resp->cursor_id = 0;
+            }
+            rp_dt_close_get_items_cursor(session, cursor);
+        }
+        /* idle cursors are closed even if the session sends no more requests */
+        rp_set_get_items_cursor_timeout(rp_ctx, session);
     } else {
-        rc = rp_dt_get_values_wrapper(rp_ctx, session, sr_mem, xpath, &values, &count);
+        rc = rp_dt_get_gpb_values_wrapper(rp_ctx, session, sr_mem, xpath, &get_items_resp->values, &get_items_resp->n_values);
     }
 
     if (SR_ERR_OK != rc) {
@@ -839,19 +1089,14 @@ rp_get_items_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg,
         *skip_msg_cleanup = true;
         /* setup timeout */
         rc = rp_set_oper_request_timeout(rp_ctx, session, msg, SR_OPER_DATA_PROVIDE_TIMEOUT);
-        sr_free_values(values, count);
         sr_msg_free(resp);
         pthread_mutex_unlock(&session->cur_req_mutex);
         return rc;
     }
 
-    SR_LOG_DBG("%zu items found for '%s', session id=%"PRIu32".", count, xpath, session->id);
+    SR_LOG_DBG("%zu items found for '%s', session id=%"PRIu32".", get_items_resp->n_values, xpath, session->id);
     pthread_mutex_unlock(&session->cur_req_mutex);
 
-    /* copy values to gpb */
-    rc = sr_values_sr_to_gpb(values, count, &resp->response->get_items_resp->values, &resp->response->get_items_resp->n_values);
-    CHECK_RC_MSG_GOTO(rc, cleanup, "Copying values to GPB failed.");
-
 cleanup:
     session->req = NULL;
 
@@ -863,7 +1108,6 @@ cleanup:
         SR_LOG_ERR_MSG("Copying errors to gpb failed");
     }
 
-    sr_free_values(values, count);
     rc = cm_msg_send(rp_ctx->cm_ctx, resp);
 
     return rc;
@@ -1366,6 +1610,126 @@ rp_move_item_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
     return rc;
 }
 
+/**
+ * @brief Processes an edit_batch request.
+ */
+static int
+rp_edit_batch_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
+{
+    Sr__Msg *resp = NULL;
+    sr_mem_ctx_t *sr_mem = NULL;
+    Sr__EditBatchReq *batch_req = NULL;
+    Sr__EditBatchResp *batch_resp = NULL;
+    Sr__EditBatchReq__EditOperation *op = NULL;
+    Sr__Error *error = NULL;
+    sr_val_t *value = NULL;
+    char *str_value = NULL;
+    int rc = SR_ERR_OK, op_rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG5(rp_ctx, session, msg, msg->request, msg->request->edit_batch_req);
+
+    batch_req = msg->request->edit_batch_req;
+
+    SR_LOG_DBG("Processing edit_batch request (%zu operations).", batch_req->n_operations);
+
+    /* allocate the response */
+    rc = sr_mem_new(0, &sr_mem);
+    CHECK_RC_MSG_RETURN(rc, "Failed to create a new Sysrepo memory context.");
+    rc = sr_gpb_resp_alloc(sr_mem, SR__OPERATION__EDIT_BATCH, session->id, &resp);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_ERR_MSG("Allocation of edit_batch response failed.");
+        sr_mem_free(sr_mem);
+        return SR_ERR_NOMEM;
+    }
+    batch_resp = resp->response->edit_batch_resp;
+
+    if (batch_req->n_operations > 0) {
+        batch_resp->results = sr_calloc(sr_mem, batch_req->n_operations, sizeof(*batch_resp->results));
+        CHECK_NULL_NOMEM_GOTO(batch_resp->results, rc, cleanup);
+        batch_resp->errors = sr_calloc(sr_mem, batch_req->n_operations, sizeof(*batch_resp->errors));
+        CHECK_NULL_NOMEM_GOTO(batch_resp->errors, rc, cleanup);
+    }
+
+    /* apply the operations in the order of the request, the same way as the single-edit requests */
+    for (size_t i = 0; i < batch_req->n_operations; i++) {
+        op = batch_req->operations[i];
+        value = NULL;
+        str_value = NULL;
+        op_rc = SR_ERR_OK;
+
+        switch (op->type) {
+            case SR__EDIT_BATCH_REQ__EDIT_OPERATION__EDIT_OPERATION_TYPE__SET:
+                if (NULL != op->value) {
+                    op_rc = sr_dup_gpb_to_val_t((sr_mem_ctx_t *)msg->_sysrepo_mem_ctx, op->value, &value);
+                }
+                if (SR_ERR_OK == op_rc) {
+                    op_rc = rp_dt_set_item_wrapper(rp_ctx, session, op->xpath, value, NULL, op->options);
+                }
+                break;
+            case SR__EDIT_BATCH_REQ__EDIT_OPERATION__EDIT_OPERATION_TYPE__SET_STR:
+                if (NULL != op->str_value) {
+                    str_value = strdup(op->str_value);
+                    if (NULL == str_value) {
+                        op_rc = SR_ERR_NOMEM;
+                    }
+                }
+                if (SR_ERR_OK == op_rc) {
+                    op_rc = rp_dt_set_item_wrapper(rp_ctx, session, op->xpath, NULL, str_value, op->options);
+                }
+                break;
+            case SR__EDIT_BATCH_REQ__EDIT_OPERATION__EDIT_OPERATION_TYPE__DELETE:
+                op_rc = rp_dt_delete_item_wrapper(rp_ctx, session, op->xpath, op->options);
+                break;
+            case SR__EDIT_BATCH_REQ__EDIT_OPERATION__EDIT_OPERATION_TYPE__MOVE:
+                op_rc = rp_dt_move_list_wrapper(rp_ctx, session, op->xpath,
+                        sr_move_direction_gpb_to_sr(op->position), op->relative_item);
+                break;
+            default:
+                op_rc = SR_ERR_INVAL_ARG;
+                break;
+        }
+
+        batch_resp->results[batch_resp->n_results++] = op_rc;
+        if (SR_ERR_OK == op_rc) {
+            continue;
+        }
+
+        SR_LOG_ERR("Operation %zu of edit batch failed for '%s', session id=%"PRIu32".", i, op->xpath, session->id);
+        if (SR_ERR_OK == rc) {
+            rc = op_rc;
+        }
+
+        /* move the error of the operation from the session to the response */
+        error = NULL;
+        if (dm_has_error(session->dm_session)) {
+            error = sr_calloc(sr_mem, 1, sizeof(*error));
+            if (NULL != error) {
+                sr__error__init(error);
+                dm_copy_errors(session->dm_session, sr_mem, &error->message, &error->xpath);
+            }
+            dm_clear_session_errors(session->dm_session);
+        } else {
+            sr_gpb_fill_error(sr_strerror(op_rc), op->xpath, sr_mem, &error);
+        }
+        if (NULL != error) {
+            batch_resp->errors[batch_resp->n_errors++] = error;
+        }
+
+        if (!batch_req->continue_on_error) {
+            break;
+        }
+    }
+
+cleanup:
+    /* set response code */
+    resp->response->result = rc;
+
+    /* send the response */
+    rc = cm_msg_send(rp_ctx->cm_ctx, resp);
+
+    return rc;
+}
+
 /**
  * @brief Processes a validate request.
  */
@@ -1861,6 +2225,12 @@ rp_subscribe_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr
     if (subscribe_req->has_enable_event && subscribe_req->enable_event) {
         options |= NP_SUBSCR_EV_EVENT;
     }
+    if (subscribe_req->has_dp_bulk && subscribe_req->dp_bulk) {
+        options |= NP_SUBSCR_DP_BULK;
+    }
+    if (subscribe_req->has_changes_inline && subscribe_req->changes_inline) {
+        options |= NP_SUBSCR_CHANGES_INLINE;
+    }
 
     /* subscribe to the notification */
     rc = np_notification_subscribe(rp_ctx->np_ctx, session, subscribe_req->type,
@@ -1868,6 +2238,7 @@ rp_subscribe_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr
             subscribe_req->module_name, subscribe_req->xpath, username,
             (subscribe_req->has_notif_event ? subscribe_req->notif_event : SR__NOTIFICATION_EVENT__APPLY_EV),
             (subscribe_req->has_priority ? subscribe_req->priority : 0),
+            (subscribe_req->has_cache_ttl ? subscribe_req->cache_ttl : 0),
             sr_api_variant_gpb_to_sr(subscribe_req->api_variant),
             options);
 
@@ -1895,7 +2266,7 @@ rp_subscribe_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr
  * @brief Processes an unsubscribe request.
  */
 static int
-rp_unsubscribe_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Msg *msg)
+rp_unsubscribe_req_process(rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Msg *msg)
 {
     Sr__Msg *resp = NULL;
     sr_mem_ctx_t *sr_mem = NULL;
@@ -1919,6 +2290,11 @@ rp_unsubscribe_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session,
     rc = np_notification_unsubscribe(rp_ctx->np_ctx, session, msg->request->unsubscribe_req->type,
             msg->request->unsubscribe_req->destination, msg->request->unsubscribe_req->subscription_id,
             msg->request->unsubscribe_req->module_name);
+    if (SR__SUBSCRIPTION_TYPE__DP_GET_ITEMS_SUBS == msg->request->unsubscribe_req->type) {
+        /* the data are not provided by the subscription anymore */
+        rp_dt_dp_cache_remove_subscription(rp_ctx, msg->request->unsubscribe_req->destination, false,
+                msg->request->unsubscribe_req->subscription_id);
+    }
 
     /* set response code */
     resp->response->result = rc;
@@ -2403,9 +2779,10 @@ finalize:
  * @brief Checks if the received xpath was requested and find corresponding schema node
  */
 static int
-rp_data_provide_resp_validate(rp_ctx_t *rp_ctx, rp_session_t *session, const char *xpath, sr_val_t *values, size_t values_cnt, struct lys_node **sch_node)
+rp_data_provide_resp_validate(rp_ctx_t *rp_ctx, rp_session_t *session, const char *xpath, sr_val_t *values, size_t values_cnt,
+        struct lys_node **sch_node, np_subscription_t **subscription)
 {
-    CHECK_NULL_ARG3(rp_ctx, session, sch_node);
+    CHECK_NULL_ARG4(rp_ctx, session, sch_node, subscription);
     if (values_cnt > 0) {
         CHECK_NULL_ARG(values);
     }
@@ -2433,6 +2810,8 @@ rp_data_provide_resp_validate(rp_ctx_t *rp_ctx, rp_session_t *session, const cha
             ly_set_free(set);
             free(xp);
             sr_list_rm_at(session->state_data_ctx.requested_xpaths, i);
+            *subscription = session->state_data_ctx.requested_subscriptions->data[i];
+            sr_list_rm_at(session->state_data_ctx.requested_subscriptions, i);
             break;
         }
     }
@@ -2466,6 +2845,133 @@ unlock:
     return rc;
 }
 
+/**
+ * @brief Returns the xpath of the list instance a value received from a bulk data provider belongs to:
+ * the value xpath cut after the step of the list at the given depth.
+ */
+static int
+rp_data_provide_instance_xpath(const char *xpath, size_t depth, char **instance_xp)
+{
+    const char *p = NULL;
+    char quote = 0;
+    size_t steps = 0, brackets = 0;
+
+    for (p = xpath; '\0' != *p; p++) {
+        if (0 != quote) {
+            if (quote == *p) {
+                quote = 0;
+            }
+        } else if ('\'' == *p || '"' == *p) {
+            quote = *p;
+        } else if ('[' == *p) {
+            brackets++;
+        } else if (']' == *p && brackets > 0) {
+            brackets--;
+        } else if ('/' == *p && 0 == brackets && ++steps > depth) {
+            break;
+        }
+    }
+    if ('\0' == *p) {
+        /* the value is not nested in a list instance */
+        return SR_ERR_INVAL_ARG;
+    }
+
+    *instance_xp = strndup(xpath, p - xpath);
+    CHECK_NULL_NOMEM_RETURN(*instance_xp);
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Merges values received from a data provider into the session data tree. Values received
+ * from a bulk data provider are merged only if the list instance they belong to is present in the data tree,
+ * the provider must not create list instances that have not been configured.
+ */
+static void
+rp_data_provide_values_merge(rp_ctx_t *rp_ctx, rp_session_t *session, const char *xpath, struct lys_node *sch_node,
+        sr_val_t *values, size_t values_cnt)
+{
+    struct lys_node *list = NULL, *n = NULL;
+    struct lyd_node *data_tree = NULL, *instance = NULL;
+    char *instance_xp = NULL, *checked_xp = NULL;
+    bool bulk = false, exists = false;
+    size_t depth = 0;
+    int rc = SR_ERR_OK;
+
+    bulk = rp_dt_is_bulk_dp_xpath(sch_node, xpath);
+    if (bulk) {
+        /* depth of the closest list instance the values are nested in */
+        for (n = sch_node; NULL != n; n = lys_parent(n)) {
+            if (NULL == list && LYS_LIST == n->nodetype && n != sch_node) {
+                list = n;
+            }
+            if (NULL != list && 0 == ((LYS_USES | LYS_CHOICE | LYS_CASE) & n->nodetype)) {
+                depth++;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < values_cnt; i++) {
+        SR_LOG_DBG("Received value from data provider for xpath '%s'.", values[i].xpath);
+        if (bulk) {
+            rc = rp_data_provide_instance_xpath(values[i].xpath, depth, &instance_xp);
+            if (SR_ERR_OK != rc) {
+                SR_LOG_WRN("Value '%s' received from a bulk data provider is not nested in a list instance, ignoring it.",
+                        values[i].xpath);
+                continue;
+            }
+            if (NULL == checked_xp || 0 != strcmp(checked_xp, instance_xp)) {
+                /* values of the same instance are usually sent together, look the instance up only once */
+                instance = NULL;
+                exists = SR_ERR_OK == dm_get_datatree(rp_ctx->dm_ctx, session->dm_session, session->module_name, &data_tree) &&
+                        SR_ERR_OK == rp_dt_find_node(rp_ctx->dm_ctx, data_tree, instance_xp, false, &instance);
+                free(checked_xp);
+                checked_xp = instance_xp;
+            } else {
+                free(instance_xp);
+            }
+            instance_xp = NULL;
+            if (!exists) {
+                SR_LOG_WRN("Value '%s' received from a bulk data provider belongs to list instance '%s' "
+                        "that does not exist, ignoring it.", values[i].xpath, checked_xp);
+                continue;
+            }
+        }
+        rc = rp_dt_set_item(rp_ctx->dm_ctx, session->dm_session, values[i].xpath, SR_EDIT_DEFAULT, &values[i], NULL, true);
+        if (SR_ERR_OK != rc) {
+            //TODO: maybe validate if this path corresponds to the operational data
+            SR_LOG_WRN("Failed to set operational data for xpath '%s'.", values[i].xpath);
+        }
+    }
+
+    free(checked_xp);
+}
+
+/**
+ * @brief Creates the xpath of a child node under the parent xpath.
+ */
+static int
+rp_data_provide_nested_xpath(const char *parent_xp, struct lys_node *sch_node, struct lys_node *child, char **xpath)
+{
+    char *xp = NULL;
+    size_t len = strlen(parent_xp) + strlen(child->name) + 2 /* slash + zero byte */;
+
+    if (lys_node_module(sch_node) != lys_node_module(child)) {
+        len += strlen(lys_node_module(child)->name) + 1;
+    }
+
+    xp = calloc(len, sizeof(*xp));
+    CHECK_NULL_NOMEM_RETURN(xp);
+
+    if (lys_node_module(sch_node) == lys_node_module(child)) {
+        snprintf(xp, len, "%s/%s", parent_xp, child->name);
+    } else {
+        snprintf(xp, len, "%s/%s:%s", parent_xp, lys_node_module(child)->name, child->name);
+    }
+
+    *xpath = xp;
+    return SR_ERR_OK;
+}
+
 /**
  * @brief Generate requests for nested data
  */
@@ -2475,22 +2981,16 @@ rp_data_provide_request_nested(rp_ctx_t *rp_ctx, rp_session_t *session, const ch
     int rc = SR_ERR_OK;
     struct lys_node *iter = NULL;
     size_t subs_index = 0;
+    np_subscription_t *subscription = NULL;
     char **xpaths = NULL;
     size_t xp_count = 0;
     char *request_xp = NULL;
+    bool per_instance = false, bulk_xpath = false, instances_loaded = false;
 
-    /* prepare xpaths where nested data will be requested */
-    if (LYS_LIST == sch_node->nodetype) {
-        rc = rp_dt_create_instance_xps(session, sch_node, &xpaths, &xp_count);
-        CHECK_RC_MSG_RETURN(rc, "Failed to create xpaths for instances of sch node");
-    } else {
-        xpaths = calloc(1, sizeof(*xpaths));
-        CHECK_NULL_NOMEM_GOTO(xpaths, rc, cleanup);
-
-        xpaths[0] = strdup(xpath);
-        CHECK_NULL_NOMEM_GOTO(xpaths[0], rc, cleanup);
-        xp_count = 1;
-    }
+    /* the nested data are requested per instance for lists and for nodes received from a bulk data provider,
+     * unless the nested data provider is able to handle all instances at once as well */
+    bulk_xpath = (NULL == strchr(xpath, '['));
+    per_instance = (LYS_LIST == sch_node->nodetype) || rp_dt_is_bulk_dp_xpath(sch_node, xpath);
 
     /* loop through the node children */
     LY_TREE_FOR(sch_node->child, iter) {
@@ -2512,32 +3012,41 @@ rp_data_provide_request_nested(rp_ctx_t *rp_ctx, rp_session_t *session, const ch
             /* check if we have exact match for leaf or leaf-list node */
             rp_dt_find_exact_match_subscription_for_node(session, iter, &subs_index);
         }
-        if (subs_index < session->state_data_ctx.subscription_nodes->count) {
-            for (size_t i = 0; i < xp_count; i++) {
-                size_t len = strlen(xpaths[i]) + strlen(iter->name) + 2 /* slash + zero byte */;
-
-                if (lys_node_module(sch_node) != lys_node_module(iter)) {
-                    len += strlen(lys_node_module(iter)->name) + 1;
-                }
+        if (subs_index >= session->state_data_ctx.subscription_nodes->count) {
+            continue;
+        }
+        subscription = session->state_data_ctx.subscriptions->data[subs_index];
 
-                request_xp = calloc(len, sizeof(*request_xp));
-                CHECK_NULL_NOMEM_GOTO(request_xp, rc, cleanup);
+        if (!per_instance || (subscription->dp_bulk && bulk_xpath)) {
+            /* single request */
+            rc = rp_data_provide_nested_xpath(xpath, sch_node, iter, &request_xp);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to create xpath for nested request");
 
-                if (lys_node_module(sch_node) == lys_node_module(iter)) {
-                    snprintf(request_xp, len, "%s/%s", xpaths[i], iter->name);
-                } else {
-                    snprintf(request_xp, len, "%s/%s:%s", xpaths[i], lys_node_module(iter)->name, iter->name);
-                }
+            SR_LOG_DBG("Requesting nested state data: %s using subs index %zu", request_xp, subs_index);
+            rc = rp_dt_request_dp_data(rp_ctx, session, subscription, request_xp);
+            request_xp = NULL;
+            if (SR_ERR_OK != rc) {
+                SR_LOG_WRN("Request for nested state data failed using subs index %zu", subs_index);
+            }
+            continue;
+        }
 
-                rc = np_data_provider_request(rp_ctx->np_ctx, session->state_data_ctx.subscriptions->data[subs_index],
-                        session, request_xp);
-                SR_LOG_DBG("Sending request for nested state data: %s using subs index %zu", request_xp, subs_index);
+        /* prepare xpaths of the instances where nested data will be requested */
+        if (!instances_loaded) {
+            rc = rp_dt_create_instance_xps(session, sch_node, &xpaths, &xp_count);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to create xpaths for instances of sch node");
+            instances_loaded = true;
+        }
 
-                session->dp_req_waiting += 1;
+        for (size_t i = 0; i < xp_count; i++) {
+            rc = rp_data_provide_nested_xpath(xpaths[i], sch_node, iter, &request_xp);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to create xpath for nested request");
 
-                rc = sr_list_add(session->state_data_ctx.requested_xpaths, request_xp);
-                CHECK_RC_MSG_GOTO(rc, cleanup, "List add failed");
-                request_xp = NULL;
+            SR_LOG_DBG("Requesting nested state data: %s using subs index %zu", request_xp, subs_index);
+            rc = rp_dt_request_dp_data(rp_ctx, session, subscription, request_xp);
+            request_xp = NULL;
+            if (SR_ERR_OK != rc) {
+                SR_LOG_WRN("Request for nested state data failed using subs index %zu", subs_index);
             }
         }
     }
@@ -2580,22 +3089,22 @@ rp_data_provide_resp_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *m
 
     char *xpath = msg->response->data_provide_resp->xpath;
     struct lys_node *sch_node = NULL;
+    np_subscription_t *subscription = NULL;
 
     session->dp_req_waiting -= 1;
     SR_LOG_DBG("Data provide response received, waiting for %zu more data providers.", session->dp_req_waiting);
 
-    rc = rp_data_provide_resp_validate(rp_ctx, session, xpath, values, values_cnt, &sch_node);
+    rc = rp_data_provide_resp_validate(rp_ctx, session, xpath, values, values_cnt, &sch_node, &subscription);
     CHECK_RC_MSG_GOTO(rc, finish, "Data validation failed.");
 
-    for (size_t i = 0; i < values_cnt; i++) {
-        SR_LOG_DBG("Received value from data provider for xpath '%s'.", values[i].xpath);
-        rc = rp_dt_set_item(rp_ctx->dm_ctx, session->dm_session, values[i].xpath, SR_EDIT_DEFAULT, &values[i], NULL, true);
-        if (SR_ERR_OK != rc) {
-            //TODO: maybe validate if this path corresponds to the operational data
-            SR_LOG_WRN("Failed to set operational data for xpath '%s'.", values[i].xpath);
+    if (subscription->cache_ttl > 0 && !msg->response->data_provide_resp->from_cache) {
+        if (SR_ERR_OK != rp_dt_dp_cache_store(rp_ctx, subscription, xpath, values, values_cnt)) {
+            SR_LOG_WRN("Failed to cache operational data for xpath %s", xpath);
         }
     }
 
+    rp_data_provide_values_merge(rp_ctx, session, xpath, sch_node, values, values_cnt);
+
     /* handle nested data */
     if ((LYS_CONTAINER | LYS_LIST) & sch_node->nodetype) {
         rc = rp_data_provide_request_nested(rp_ctx, session, xpath, sch_node);
@@ -2612,7 +3121,7 @@ finish:
             SR_LOG_DBG("All data from data providers has been received session id = %u, "
                     "re-enqueue the request id = %" PRIu64, session->id, session->req->request->_id);
             session->state = RP_REQ_DATA_LOADED;
-            rp_msg_process(rp_ctx, session, session->req);
+            rp_msg_enqueue(rp_ctx, session, session->req, true);
             session->req = NULL;
         }
     }
@@ -2743,7 +3252,7 @@ rp_rpc_resp_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
  * @brief Processes an unsubscribe-destination internal request.
  */
 static int
-rp_unsubscribe_destination_req_process(const rp_ctx_t *rp_ctx, Sr__Msg *msg)
+rp_unsubscribe_destination_req_process(rp_ctx_t *rp_ctx, Sr__Msg *msg)
 {
     int rc = SR_ERR_OK;
 
@@ -2752,6 +3261,7 @@ rp_unsubscribe_destination_req_process(const rp_ctx_t *rp_ctx, Sr__Msg *msg)
     SR_LOG_DBG_MSG("Processing unsubscribe destination request.");
 
     rc = np_unsubscribe_destination(rp_ctx->np_ctx, msg->internal_request->unsubscribe_dst_req->destination);
+    rp_dt_dp_cache_remove_subscription(rp_ctx, msg->internal_request->unsubscribe_dst_req->destination, true, 0);
 
     return rc;
 }
@@ -2791,7 +3301,7 @@ rp_oper_data_timeout_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Ms
         session->req && session->req->request->_id == msg->internal_request->oper_data_timeout_req->request_id) {
         SR_LOG_DBG("Time out expired for operational data to be loaded. Request (id=%" PRIu64 ") processing continue, "
                 "session id = %u", session->req->request->_id, session->id);
-        rp_msg_process(rp_ctx, session, session->req);
+        rp_msg_enqueue(rp_ctx, session, session->req, true);
         session->state = RP_REQ_TIMED_OUT;
     }
     pthread_mutex_unlock(&session->cur_req_mutex);
@@ -2799,6 +3309,28 @@ rp_oper_data_timeout_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Ms
     return rc;
 }
 
+/**
+ * @brief Processes a request closing the get_items_iter cursors of the session that have not been used
+ * for too long. Reschedules itself while the session has some cursors open.
+ */
+static int
+rp_get_items_cursor_timeout_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
+{
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG4(rp_ctx, msg, msg->internal_request, session);
+
+    SR_LOG_DBG("Processing get-items-cursor-timeout request, session id=%"PRIu32".", session->id);
+
+    MUTEX_LOCK_TIMED_CHECK_RETURN(&session->cur_req_mutex);
+    session->cursor_timer_pending = false;
+    rp_dt_expire_get_items_cursors(session);
+    rc = rp_set_get_items_cursor_timeout(rp_ctx, session);
+    pthread_mutex_unlock(&session->cur_req_mutex);
+
+    return rc;
+}
+
 /**
  * @brief Processes an internal state data request.
  */
@@ -2871,7 +3403,7 @@ cleanup:
                     "re-enqueue the request (id=%" PRIu64 ")", session->id,
                     session->req ? session->req->request->_id : 0);
             session->state = RP_REQ_DATA_LOADED;
-            rp_msg_process(rp_ctx, session, session->req);
+            rp_msg_enqueue(rp_ctx, session, session->req, true);
             session->req = NULL;
         }
     }
@@ -3249,53 +3781,88 @@ finalize:
 }
 
 /**
- * @brief Processes an event notification replay request.
+ * @brief Processes an event notification replay request. Stored notifications are read incrementally
+ * and sent to the subscriber in batches. After each batch the request is paused until the subscriber
+ * receives the notifications already sent to it (see ::rp_event_notif_replay_continue_req_process).
  */
 static int
-rp_event_notif_replay_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
+rp_event_notif_replay_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, bool *skip_msg_cleanup)
 {
     Sr__EventNotifReplayReq *replay_req = NULL;
     Sr__Msg *resp = NULL;
     sr_mem_ctx_t *sr_mem = NULL;
-    int rc = SR_ERR_OK;
+    int result = SR_ERR_OK, rc = SR_ERR_OK;
 
     CHECK_NULL_ARG5(rp_ctx, session, msg, msg->request, msg->request->event_notif_replay_req);
-
-    SR_LOG_DBG_MSG("Processing event notification replay request.");
+    CHECK_NULL_ARG(skip_msg_cleanup);
 
     replay_req = msg->request->event_notif_replay_req;
 
-    /* allocate the response */
-    rc = sr_mem_new(0, &sr_mem);
-    CHECK_RC_MSG_RETURN(rc, "Failed to create a new Sysrepo memory context.");
-    rc = sr_gpb_resp_alloc(sr_mem, SR__OPERATION__EVENT_NOTIF_REPLAY, session->id, &resp);
-    if (SR_ERR_OK != rc) {
-        sr_mem_free(sr_mem);
-        SR_LOG_ERR_MSG("Allocation of the response failed.");
-        return SR_ERR_NOMEM;
-    }
+    MUTEX_LOCK_TIMED_CHECK_RETURN(&session->cur_req_mutex);
 
 #ifdef ENABLE_NOTIF_STORE
-    sr_list_t *notif_list = NULL;
-
-    /* get matching notifications from the notification store */
-    rc = np_get_event_notifications(rp_ctx->np_ctx, session, replay_req->xpath, replay_req->start_time,
-            replay_req->stop_time, sr_api_variant_gpb_to_sr(replay_req->api_variant), &notif_list);
-    CHECK_RC_LOG_GOTO(rc, finalize, "Error by loading event notifications for xpath '%s'.", replay_req->xpath);
-
-    /* send each notification to the subscriber */
-    if (NULL != notif_list) {
-        for (size_t i = 0; i < notif_list->count; i++) {
-            np_ev_notification_t *notification = notif_list->data[i];
-
-            /* send the notification */
-            rc = rp_event_notif_send(rp_ctx, session, SR__EVENT_NOTIF_REQ__NOTIF_TYPE__REPLAY, notification->xpath,
-                    notification->timestamp, sr_api_variant_gpb_to_sr(replay_req->api_variant),
-                    notification->data.values, notification->data_cnt, notification->data.trees, notification->data_cnt,
-                    replay_req->subscriber_address, replay_req->subscription_id, 0);
-            CHECK_RC_LOG_GOTO(rc, finalize, "Error by sending the replay of notification '%s' to the subscriber '%s'.",
-                    notification->xpath, replay_req->subscriber_address);
+    np_ev_notification_t *notification = NULL;
+    Sr__Msg *continue_req = NULL;
+    size_t sent_cnt = 0;
+
+    if (RP_REQ_RESUMED == session->state && NULL != session->replay_reader) {
+        SR_LOG_DBG_MSG("Resuming event notification replay.");
+    } else {
+        SR_LOG_DBG_MSG("Processing event notification replay request.");
+
+        /* open matching notifications in the notification store */
+        rc = np_event_notif_reader_open(rp_ctx->np_ctx, session, replay_req->xpath, replay_req->start_time,
+                replay_req->stop_time, sr_api_variant_gpb_to_sr(replay_req->api_variant), &session->replay_reader);
+        CHECK_RC_LOG_GOTO(rc, finalize, "Error by loading event notifications for xpath '%s'.", replay_req->xpath);
+    }
+
+    /* send next batch of notifications to the subscriber */
+    while (sent_cnt < RP_NOTIF_REPLAY_BATCH_SIZE &&
+            SR_ERR_OK == (rc = np_event_notif_reader_next(session->replay_reader, &notification))) {
+        rc = rp_event_notif_send(rp_ctx, session, SR__EVENT_NOTIF_REQ__NOTIF_TYPE__REPLAY, notification->xpath,
+                notification->timestamp, sr_api_variant_gpb_to_sr(replay_req->api_variant),
+                notification->data.values, notification->data_cnt, notification->data.trees, notification->data_cnt,
+                replay_req->subscriber_address, replay_req->subscription_id, 0);
+        np_event_notification_cleanup(notification);
+        notification = NULL;
+        CHECK_RC_LOG_GOTO(rc, finalize, "Error by sending the replay of notification '%s' to the subscriber '%s'.",
+                replay_req->xpath, replay_req->subscriber_address);
+        sent_cnt++;
+    }
+
+    if (SR_ERR_OK == rc) {
+        /* more notifications may follow - do not block the notification store while the subscriber is busy */
+        np_event_notif_reader_pause(session->replay_reader);
+
+        rc = sr_gpb_internal_req_alloc(NULL, SR__OPERATION__EVENT_NOTIF_REPLAY_CONTINUE, &continue_req);
+        CHECK_RC_MSG_GOTO(rc, finalize, "Unable to allocate event notification replay continue request.");
+        continue_req->session_id = session->id;
+        continue_req->internal_request->event_notif_replay_continue_req->subscriber_address =
+                strdup(replay_req->subscriber_address);
+        if (NULL == continue_req->internal_request->event_notif_replay_continue_req->subscriber_address) {
+            sr_msg_free(continue_req);
+            rc = SR_ERR_NOMEM;
+            goto finalize;
         }
+
+        /* Connection Manager passes the request back once the sent notifications drain from its output buffer */
+        session->state = RP_REQ_WAITING_FOR_SUBSCRIBER;
+        session->req = msg;
+        rc = cm_msg_send(rp_ctx->cm_ctx, continue_req);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_ERR_MSG("Unable to send event notification replay continue request.");
+            session->req = NULL;
+            goto finalize;
+        }
+
+        SR_LOG_DBG("Event notification replay paused after %zu notifications.", sent_cnt);
+        *skip_msg_cleanup = true;
+        pthread_mutex_unlock(&session->cur_req_mutex);
+        return SR_ERR_OK;
+    }
+    if (SR_ERR_NOT_FOUND != rc) {
+        SR_LOG_ERR("Error by reading event notifications for xpath '%s'.", replay_req->xpath);
+        goto finalize;
     }
 
     /* send replay-complete notification */
@@ -3306,14 +3873,13 @@ rp_event_notif_replay_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__M
             replay_req->subscriber_address);
 
 finalize:
-    if (NULL != notif_list) {
-        for (size_t i = 0; i < notif_list->count; i++) {
-            np_event_notification_cleanup(notif_list->data[i]);
-        }
-    }
-    sr_list_cleanup(notif_list);
+    np_event_notif_reader_close(session->replay_reader);
+    session->replay_reader = NULL;
 #endif
 
+    session->state = RP_REQ_FINISHED;
+    pthread_mutex_unlock(&session->cur_req_mutex);
+
     /* schedule replay-stop notification */
     if ((0 != replay_req->stop_time) && (time(NULL) <= replay_req->stop_time)) {
         rc = rp_event_notif_send(rp_ctx, session, SR__EVENT_NOTIF_REQ__NOTIF_TYPE__REPLAY_STOP, replay_req->xpath,
@@ -3325,8 +3891,20 @@ finalize:
         }
     }
 
+    result = rc;
+
+    /* allocate the response */
+    rc = sr_mem_new(0, &sr_mem);
+    CHECK_RC_MSG_RETURN(rc, "Failed to create a new Sysrepo memory context.");
+    rc = sr_gpb_resp_alloc(sr_mem, SR__OPERATION__EVENT_NOTIF_REPLAY, session->id, &resp);
+    if (SR_ERR_OK != rc) {
+        sr_mem_free(sr_mem);
+        SR_LOG_ERR_MSG("Allocation of the response failed.");
+        return SR_ERR_NOMEM;
+    }
+
     /* set response code */
-    resp->response->result = rc;
+    resp->response->result = result;
 
     rc = rp_resp_fill_errors(resp, session->dm_session);
     if (SR_ERR_OK != rc) {
@@ -3339,6 +3917,30 @@ finalize:
     return rc;
 }
 
+/**
+ * @brief Processes a request to continue with a paused event notification replay, sent by Connection Manager
+ * once the subscriber has received the notifications already sent to it.
+ */
+static int
+rp_event_notif_replay_continue_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
+{
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(rp_ctx, session, msg);
+
+    SR_LOG_DBG_MSG("Processing event-notif-replay-continue request.");
+
+    MUTEX_LOCK_TIMED_CHECK_RETURN(&session->cur_req_mutex);
+    if (RP_REQ_WAITING_FOR_SUBSCRIBER == session->state && NULL != session->req) {
+        session->state = RP_REQ_RESUMED;
+        rc = rp_msg_enqueue(rp_ctx, session, session->req, true);
+        session->req = NULL;
+    }
+    pthread_mutex_unlock(&session->cur_req_mutex);
+
+    return rc;
+}
+
 /**
  * @brief Processes an notification acknowledgment.
  */
@@ -3415,6 +4017,7 @@ rp_req_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, bool *ski
         case SR__OPERATION__SET_ITEM_STR:
         case SR__OPERATION__DELETE_ITEM:
         case SR__OPERATION__MOVE_ITEM:
+        case SR__OPERATION__EDIT_BATCH:
         case SR__OPERATION__SESSION_REFRESH:
             pthread_rwlock_rdlock(&rp_ctx->commit_lock);
             locked = true;
@@ -3478,6 +4081,9 @@ rp_req_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, bool *ski
         case SR__OPERATION__MOVE_ITEM:
             rc = rp_move_item_req_process(rp_ctx, session, msg);
             break;
+        case SR__OPERATION__EDIT_BATCH:
+            rc = rp_edit_batch_req_process(rp_ctx, session, msg);
+            break;
         case SR__OPERATION__VALIDATE:
             rc = rp_validate_req_process(rp_ctx, session, msg);
             break;
@@ -3522,7 +4128,7 @@ rp_req_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, bool *ski
             rc = rp_event_notif_req_process(rp_ctx, session, msg, skip_msg_cleanup);
             break;
         case SR__OPERATION__EVENT_NOTIF_REPLAY:
-            rc = rp_event_notif_replay_req_process(rp_ctx, session, msg);
+            rc = rp_event_notif_replay_req_process(rp_ctx, session, msg, skip_msg_cleanup);
             break;
         default:
             SR_LOG_ERR("Unsupported request received (session id=%"PRIu32", operation=%d).",
@@ -3602,6 +4208,12 @@ rp_internal_req_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
         case SR__OPERATION__NACM_RELOAD:
             rc = rp_nacm_reload_req_process(rp_ctx, session, msg);
             break;
+        case SR__OPERATION__EVENT_NOTIF_REPLAY_CONTINUE:
+            rc = rp_event_notif_replay_continue_req_process(rp_ctx, session, msg);
+            break;
+        case SR__OPERATION__GET_ITEMS_CURSOR_TIMEOUT:
+            rc = rp_get_items_cursor_timeout_req_process(rp_ctx, session, msg);
+            break;
         default:
             SR_LOG_ERR("Unsupported internal request received (operation=%d).", msg->internal_request->operation);
             rc = SR_ERR_UNSUPPORTED;
@@ -3631,13 +4243,18 @@ rp_session_can_be_null_for_msg (Sr__Msg *msg) {
 
 /**
  * @brief Dispatches the received message.
+ *
+ * @param[out] paused Set to TRUE if the message is a request whose processing has been paused
+ * (waiting for operational data or verifiers) and will be resumed later.
  */
 static int
-rp_msg_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
+rp_msg_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, bool *paused)
 {
     int rc = SR_ERR_OK;
     bool skip_msg_cleanup = false;
 
+    *paused = false;
+
     CHECK_NULL_ARG2(rp_ctx, msg);
 
     /* NULL session is only allowed for internal messages */
@@ -3667,6 +4284,8 @@ rp_msg_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
     switch (msg->type) {
         case SR__MSG__MSG_TYPE__REQUEST:
             rc = rp_req_dispatch(rp_ctx, session, msg, &skip_msg_cleanup);
+            /* a request is kept only if its processing has been paused */
+            *paused = skip_msg_cleanup;
             break;
         case SR__MSG__MSG_TYPE__RESPONSE:
             rc = rp_resp_dispatch(rp_ctx, session, msg, &skip_msg_cleanup);
@@ -3708,16 +4327,23 @@ rp_session_cleanup(const rp_ctx_t *rp_ctx, rp_session_t *session)
     dm_session_stop(rp_ctx->dm_ctx, session->dm_session);
     ac_session_cleanup(session->ac_session);
 
-    ly_set_free(session->get_items_ctx.nodes);
-    free(session->get_items_ctx.xpath);
+    rp_dt_free_get_items_cursors(session);
     pthread_mutex_destroy(&session->msg_count_mutex);
     pthread_mutex_destroy(&session->total_req_cnt_mutex);
     pthread_mutex_destroy(&session->cur_req_mutex);
     free(session->change_ctx.xpath);
     free(session->module_name);
+    np_event_notif_reader_close(session->replay_reader);
     if (NULL != session->req) {
         sr_msg_free(session->req);
     }
+    if (NULL != session->req_queue) {
+        rp_request_t req = { 0 };
+        while (sr_cbuff_dequeue(session->req_queue, &req)) {
+            sr_msg_free(req.msg);
+        }
+        sr_cbuff_cleanup(session->req_queue);
+    }
     for (size_t i = 0; i < DM_DATASTORE_COUNT; i++) {
         while (session->loaded_state_data[i]->count > 0) {
             char *item = session->loaded_state_data[i]->data[session->loaded_state_data[i]->count-1];
@@ -3745,21 +4371,19 @@ rp_worker_thread_execute(void *rp_ctx_p)
     rp_ctx_t *rp_ctx = (rp_ctx_t*)rp_ctx_p;
     rp_request_t req = { 0 };
     bool dequeued = false, dequeued_prev = false, exit = false;
+    bool ordered = false, postponed = false, paused = false;
+    int rc = SR_ERR_OK;
 
     SR_LOG_DBG("Starting worker thread id=%lu.", (unsigned long)pthread_self());
 
-    pthread_mutex_lock(&rp_ctx->request_queue_mutex);
-    rp_ctx->active_threads++;
-    pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
+    __atomic_add_fetch(&rp_ctx->active_threads, 1, __ATOMIC_SEQ_CST);
 
     do {
         /* process requests while there are some */
         dequeued_prev = false;
         do {
             /* dequeue a request */
-            pthread_mutex_lock(&rp_ctx->request_queue_mutex);
-            dequeued = sr_cbuff_dequeue(rp_ctx->request_queue, &req);
-            pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
+            dequeued = sr_mpmc_queue_dequeue(rp_ctx->request_queue, &req);
 
             if (dequeued) {
                 /* process the request */
@@ -3767,7 +4391,28 @@ rp_worker_thread_execute(void *rp_ctx_p)
                     SR_LOG_DBG("Thread id=%lu received an empty request, exiting.", (unsigned long)pthread_self());
                     exit = true;
                 } else {
-                    rp_msg_dispatch(rp_ctx, req.session, req.msg);
+                    /* requests of a session are processed in order, other messages (responses to the requests
+                     * sent by RP, internal requests) are processed immediately as they may resume a paused request */
+                    ordered = (NULL != req.session && SR__MSG__MSG_TYPE__REQUEST == req.msg->type);
+                    if (ordered && !req.scheduled) {
+                        rc = rp_session_req_acquire(req.session, &req, &postponed);
+                        if (SR_ERR_OK != rc) {
+                            SR_LOG_ERR_MSG("Unable to postpone the request, skipping.");
+                            sr_msg_free(req.msg);
+                            req.msg = NULL;
+                            ordered = false;
+                        } else if (postponed) {
+                            /* will be scheduled once the request in progress is finished */
+                            dequeued_prev = true;
+                            continue;
+                        }
+                    }
+                    if (NULL != req.msg) {
+                        rp_msg_dispatch(rp_ctx, req.session, req.msg, &paused);
+                        if (ordered && !paused) {
+                            rp_session_req_release(rp_ctx, req.session);
+                        }
+                    }
                     if (NULL != req.session) {
                         /* update message count and release session if needed */
                         pthread_mutex_lock(&req.session->msg_count_mutex);
@@ -3785,23 +4430,15 @@ rp_worker_thread_execute(void *rp_ctx_p)
                 /* no items in queue - spin for a while */
                 if (dequeued_prev) {
                     /* only if the thread has actually processed something since the last wakeup */
-                    size_t count = 0;
-                    pthread_mutex_lock(&rp_ctx->request_queue_mutex);
-                    while ((0 == sr_cbuff_items_in_queue(rp_ctx->request_queue)) && (count < rp_ctx->thread_spin_limit)) {
+                    size_t count = 0, spin_limit = __atomic_load_n(&rp_ctx->thread_spin_limit, __ATOMIC_RELAXED);
+                    while ((0 == sr_mpmc_queue_items_in_queue(rp_ctx->request_queue)) && (count < spin_limit)) {
                         count++;
                     }
-                    pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
                 }
-                pthread_mutex_lock(&rp_ctx->request_queue_mutex);
-                if (0 != sr_cbuff_items_in_queue(rp_ctx->request_queue)) {
+                if (0 != sr_mpmc_queue_items_in_queue(rp_ctx->request_queue)) {
                     /* some items are in queue - process them */
-                    pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
                     dequeued = true;
                     continue;
-                } else {
-                    /* no items in queue - go to sleep */
-                    rp_ctx->active_threads--;
-                    pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
                 }
             }
         } while (dequeued && !exit);
@@ -3812,13 +4449,17 @@ rp_worker_thread_execute(void *rp_ctx_p)
 
             /* wait for a signal */
             pthread_mutex_lock(&rp_ctx->request_queue_mutex);
+            __atomic_sub_fetch(&rp_ctx->active_threads, 1, __ATOMIC_SEQ_CST);
             if (rp_ctx->stop_requested) {
                 /* stop has been requested, do not wait anymore */
                 pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
                 break;
             }
-            pthread_cond_wait(&rp_ctx->request_queue_cv, &rp_ctx->request_queue_mutex);
-            rp_ctx->active_threads++;
+            /* a request enqueued before the decrement above has not signaled anyone, do not wait for it */
+            if (0 == sr_mpmc_queue_items_in_queue(rp_ctx->request_queue)) {
+                pthread_cond_wait(&rp_ctx->request_queue_cv, &rp_ctx->request_queue_mutex);
+            }
+            __atomic_add_fetch(&rp_ctx->active_threads, 1, __ATOMIC_SEQ_CST);
 
             SR_LOG_DBG("Thread id=%lu signaled.",  (unsigned long)pthread_self());
             pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
@@ -3928,6 +4569,31 @@ cleanup:
     return rc;
 }
 
+/**
+ * @brief Returns the number of worker threads to be started: the value of the
+ * SR_RP_THREADS_ENV environment variable, if set, otherwise SR_RP_THREAD_COUNT,
+ * the number of online CPUs if that is 0.
+ */
+static size_t
+rp_get_thread_count()
+{
+    const char *env_str = NULL;
+    long count = SR_RP_THREAD_COUNT;
+
+    env_str = getenv(SR_RP_THREADS_ENV);
+    if (NULL != env_str) {
+        count = strtol(env_str, NULL, 10);
+    }
+    if (count <= 0) {
+        count = sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (count <= 0) {
+        count = 1;
+    }
+
+    return (size_t)count;
+}
+
 int
 rp_init(cm_ctx_t *cm_ctx, rp_ctx_t **rp_ctx_p)
 {
@@ -3955,7 +4621,7 @@ rp_init(cm_ctx_t *cm_ctx, rp_ctx_t **rp_ctx_p)
     }
 
     /* initialize request queue */
-    rc = sr_cbuff_init(RP_INIT_REQ_QUEUE_SIZE, sizeof(rp_request_t), &ctx->request_queue);
+    rc = sr_mpmc_queue_init(RP_REQ_QUEUE_SIZE, sizeof(rp_request_t), &ctx->request_queue);
     if (SR_ERR_OK != rc) {
         SR_LOG_ERR_MSG("RP request queue initialization failed.");
         goto cleanup;
@@ -3999,13 +4665,21 @@ rp_init(cm_ctx_t *cm_ctx, rp_ctx_t **rp_ctx_p)
     rc = rp_setup_internal_state_data(ctx);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Set up of internal state data failed");
 
+    rc = rp_dt_dp_cache_init(ctx);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Operational data cache initialization failed");
+
     pthread_mutex_init(&ctx->commit_block_mutex, NULL);
 
     /* run worker threads */
     pthread_mutex_init(&ctx->request_queue_mutex, NULL);
     pthread_cond_init(&ctx->request_queue_cv, NULL);
 
-    for (i = 0; i < RP_THREAD_COUNT; i++) {
+    ctx->thread_count = rp_get_thread_count();
+    ctx->thread_pool = calloc(ctx->thread_count, sizeof(*ctx->thread_pool));
+    CHECK_NULL_NOMEM_GOTO(ctx->thread_pool, rc, cleanup);
+    SR_LOG_DBG("Request Processor will use %zu worker threads.", ctx->thread_count);
+
+    for (i = 0; i < ctx->thread_count; i++) {
         rc = pthread_create(&ctx->thread_pool[i], NULL, rp_worker_thread_execute, ctx);
         if (0 != rc) {
             SR_LOG_ERR("Error by creating a new thread: %s", sr_strerror_safe(errno));
@@ -4025,7 +4699,9 @@ cleanup:
     np_cleanup(ctx->np_ctx);
     pm_cleanup(ctx->pm_ctx);
     ac_cleanup(ctx->ac_ctx);
-    sr_cbuff_cleanup(ctx->request_queue);
+    sr_mpmc_queue_cleanup(ctx->request_queue);
+    rp_dt_dp_cache_cleanup(ctx);
+    free(ctx->thread_pool);
     free(ctx);
     return rc;
 }
@@ -4039,24 +4715,25 @@ rp_cleanup(rp_ctx_t *rp_ctx)
     SR_LOG_DBG_MSG("Request Processor cleanup started, requesting cancel of each worker thread.");
 
     if (NULL != rp_ctx) {
-        /* enqueue RP_THREAD_COUNT "empty" messages and send signal to all threads */
+        /* enqueue thread_count "empty" messages and send signal to all threads */
         pthread_mutex_lock(&rp_ctx->request_queue_mutex);
         rp_ctx->stop_requested = true;
         /* enqueue empty requests to request thread exits */
-        for (i = 0; i < RP_THREAD_COUNT; i++) {
-            sr_cbuff_enqueue(rp_ctx->request_queue, &req);
+        for (i = 0; i < rp_ctx->thread_count; i++) {
+            sr_mpmc_queue_enqueue(rp_ctx->request_queue, &req);
         }
         pthread_cond_broadcast(&rp_ctx->request_queue_cv);
         pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
 
         /* wait for threads to exit */
-        for (i = 0; i < RP_THREAD_COUNT; i++) {
+        for (i = 0; i < rp_ctx->thread_count; i++) {
             pthread_join(rp_ctx->thread_pool[i], NULL);
         }
+        free(rp_ctx->thread_pool);
         pthread_mutex_destroy(&rp_ctx->request_queue_mutex);
         pthread_cond_destroy(&rp_ctx->request_queue_cv);
 
-        while (sr_cbuff_dequeue(rp_ctx->request_queue, &req)) {
+        while (sr_mpmc_queue_dequeue(rp_ctx->request_queue, &req)) {
             if (NULL != req.msg) {
                 sr_msg_free(req.msg);
             }
@@ -4067,8 +4744,9 @@ rp_cleanup(rp_ctx_t *rp_ctx)
         np_cleanup(rp_ctx->np_ctx);
         pm_cleanup(rp_ctx->pm_ctx);
         ac_cleanup(rp_ctx->ac_ctx);
-        sr_cbuff_cleanup(rp_ctx->request_queue);
+        sr_mpmc_queue_cleanup(rp_ctx->request_queue);
         rp_cleanup_internal_state_data_records(rp_ctx);
+        rp_dt_dp_cache_cleanup(rp_ctx);
         free(rp_ctx);
     }
 
@@ -4108,6 +4786,9 @@ rp_session_start(const rp_ctx_t *rp_ctx, const uint32_t session_id, const ac_ucr
         CHECK_RC_LOG_GOTO(rc, cleanup, "List of state xpath initialization failed for session id=%"PRIu32".", session_id);
     }
 
+    rc = sr_cbuff_init(RP_INIT_SESS_REQ_QUEUE_SIZE, sizeof(rp_request_t), &session->req_queue);
+    CHECK_RC_LOG_GOTO(rc, cleanup, "Run-queue initialization failed for session id=%"PRIu32".", session_id);
+
     if (session_id != 0) {
         /* not for internal sessions */
         rc = ac_session_init(rp_ctx->ac_ctx, user_credentials, &session->ac_session);
@@ -4155,78 +4836,7 @@ rp_session_stop(const rp_ctx_t *rp_ctx, rp_session_t *session)
 int
 rp_msg_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
 {
-    rp_request_t req = { 0 };
-    struct timespec now = { 0 };
-    int rc = SR_ERR_OK;
-
-    CHECK_NULL_ARG_NORET2(rc, rp_ctx, msg);
-
-    if (SR_ERR_OK != rc) {
-        if (NULL != msg) {
-            sr_msg_free(msg);
-        }
-        return rc;
-    }
-
-    if (NULL != session) {
-        pthread_mutex_lock(&session->msg_count_mutex);
-        session->msg_count += 1;
-        pthread_mutex_unlock(&session->msg_count_mutex);
-    }
-
-    req.session = session;
-    req.msg = msg;
-
-    pthread_mutex_lock(&rp_ctx->request_queue_mutex);
-
-    /* enqueue the request into buffer */
-    rc = sr_cbuff_enqueue(rp_ctx->request_queue, &req);
-
-    if (0 == rp_ctx->active_threads) {
-        /* there is no active (non-sleeping) thread - if this is happening too
-         * frequently, instruct the threads to spin before going to sleep */
-        sr_clock_get_time(CLOCK_MONOTONIC, &now);
-        uint64_t diff = (1000000000L * (now.tv_sec - rp_ctx->last_thread_wakeup.tv_sec)) + now.tv_nsec - rp_ctx->last_thread_wakeup.tv_nsec;
-        if (diff < RP_THREAD_SPIN_TIMEOUT) {
-            /* a thread has been woken up in less than RP_THREAD_SPIN_TIMEOUT, increase the spin */
-            if (0 == rp_ctx->thread_spin_limit) {
-                /* no spin set yet, set to initial value */
-                rp_ctx->thread_spin_limit = RP_THREAD_SPIN_MIN;
-            } else if(rp_ctx->thread_spin_limit < RP_THREAD_SPIN_MAX) {
-                /* double the spin limit */
-                rp_ctx->thread_spin_limit *= 2;
-            }
-        } else {
-            /* reset spin to 0 if wakaups are not too frequent */
-            rp_ctx->thread_spin_limit = 0;
-        }
-        rp_ctx->last_thread_wakeup = now;
-    }
-
-    SR_LOG_DBG("Threads: active=%zu/%d, %zu requests in queue", rp_ctx->active_threads, RP_THREAD_COUNT,
-            sr_cbuff_items_in_queue(rp_ctx->request_queue));
-
-    /* send signal if there is no active thread ready to process the request */
-    if (0 == rp_ctx->active_threads ||
-            (((sr_cbuff_items_in_queue(rp_ctx->request_queue) / rp_ctx->active_threads) > RP_REQ_PER_THREADS) &&
-             rp_ctx->active_threads < RP_THREAD_COUNT)) {
-        pthread_cond_signal(&rp_ctx->request_queue_cv);
-    }
-
-    pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
-
-    if (SR_ERR_OK != rc) {
-        /* release the message by error */
-        SR_LOG_ERR_MSG("Unable to process the message, skipping.");
-        if (NULL != session) {
-            pthread_mutex_lock(&session->msg_count_mutex);
-            session->msg_count -= 1;
-            pthread_mutex_unlock(&session->msg_count_mutex);
-        }
-        sr_msg_free(msg);
-    }
-
-    return rc;
+    return rp_msg_enqueue(rp_ctx, session, msg, false);
 }
 
 int
@@ -4289,7 +4899,7 @@ rp_all_notifications_received(rp_ctx_t *rp_ctx, uint32_t commit_id, bool finishe
             sr_list_cleanup(errors);
         }
         /* reenqueue the request */
-        rc = rp_msg_process(rp_ctx, c_ctx->init_session, c_ctx->init_session->req);
+        rc = rp_msg_enqueue(rp_ctx, c_ctx->init_session, c_ctx->init_session->req, true);
         c_ctx->init_session->req = NULL;
         pthread_mutex_unlock(&c_ctx->mutex);
         pthread_rwlock_unlock(&dm_ctxs->lock);
@@ -90,13 +90,15 @@ cleanup:
  * @brief Callback to prune away disabled and NACM-read-inaccessible subtrees from a sysrepo tree.
  */
 static int
-rp_dt_tree_pruning(void *pruning_ctx_p, const struct lyd_node *subtree, bool *prune)
+rp_dt_tree_pruning(void *pruning_ctx_p, const struct lyd_node *subtree, bool *prune, bool *keep_subtree)
 {
     int rc = SR_ERR_OK;
     nacm_action_t nacm_action = NACM_ACTION_PERMIT;
     const char *rule_name = NULL, *rule_info = NULL;
     rp_tree_pruning_ctx_t *pruning_ctx = (rp_tree_pruning_ctx_t *)pruning_ctx_p;
-    CHECK_NULL_ARG3(pruning_ctx, subtree, prune);
+    CHECK_NULL_ARG4(pruning_ctx, subtree, prune, keep_subtree);
+
+    *keep_subtree = false;
 
     /* check read access */
     if (NULL != pruning_ctx->nacm_data_val_ctx) {
@@ -117,6 +119,15 @@ rp_dt_tree_pruning(void *pruning_ctx_p, const struct lyd_node *subtree, bool *pr
         return rc;
     }
 
+    /* readable subtree without more specific NACM rules below can be copied without further checks */
+    if (!pruning_ctx->check_enabled) {
+        *keep_subtree = true;
+        if (NULL != pruning_ctx->nacm_data_val_ctx) {
+            rc = nacm_check_data_read_subtree(pruning_ctx->nacm_data_val_ctx, subtree, keep_subtree);
+            CHECK_RC_LOG_RETURN(rc, "NACM subtree evaluation failed for node: %s.", subtree->schema->name);
+        }
+    }
+
     *prune = false;
     return rc;
 }
@@ -137,6 +148,7 @@ rp_dt_init_tree_pruning(dm_ctx_t *dm_ctx, rp_session_t *rp_session, struct lyd_n
         bool check_enabled, sr_tree_pruning_cb *pruning_cb, rp_tree_pruning_ctx_t **pruning_ctx_p)
 {
     int rc = SR_ERR_OK;
+    bool keep_tree = false;
     rp_tree_pruning_ctx_t *pruning_ctx = NULL;
     CHECK_NULL_ARG5(dm_ctx, rp_session, data_tree, pruning_cb, pruning_ctx_p);
 
@@ -167,10 +179,19 @@ rp_dt_init_tree_pruning(dm_ctx_t *dm_ctx, rp_session_t *rp_session, struct lyd_n
         }
     }
 
+    /* check if anything can be pruned away from the tree at all */
+    if (NULL != root && !check_enabled) {
+        keep_tree = true;
+        if (NULL != pruning_ctx->nacm_data_val_ctx) {
+            rc = nacm_check_data_read_subtree(pruning_ctx->nacm_data_val_ctx, root, &keep_tree);
+            CHECK_RC_LOG_GOTO(rc, cleanup, "NACM subtree evaluation failed for node: %s.", root->schema->name);
+        }
+    }
+
 cleanup:
     if (SR_ERR_OK == rc) {
         *pruning_ctx_p = pruning_ctx;
-        *pruning_cb = rp_dt_tree_pruning;
+        *pruning_cb = keep_tree ? NULL : rp_dt_tree_pruning;
     } else {
         rp_dt_cleanup_tree_pruning(pruning_ctx);
     }
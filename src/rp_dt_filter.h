@@ -60,6 +60,7 @@ int rp_dt_nacm_filtering(dm_ctx_t *dm_ctx, rp_session_t *rp_session, struct lyd_
  * @param [in] data_tree Data tree to which the root belongs to.
  * @param [in] check_enabled Prune away subtrees which are not enabled.
  * @param [out] pruning_cb Pruning callback to use for ::sr_copy_node_to_tree and the like.
+ *                         NULL if nothing can be pruned away from the tree of the given root.
  * @param [out] pruning_ctx Pruning context to use with the callback.
  */
 int rp_dt_init_tree_pruning(dm_ctx_t *dm_ctx, rp_session_t *rp_session, struct lyd_node *root, struct lyd_node *data_tree,
@@ -31,6 +31,7 @@
 #include "rp_dt_xpath.h"
 #include "rp_dt_edit.h"
 #include "rp_dt_filter.h"
+#include "values_internal.h"
 
 void
 rp_dt_free_state_data_ctx_content (rp_state_data_ctx_t *state_data)
@@ -61,6 +62,9 @@ rp_dt_free_state_data_ctx_content (rp_state_data_ctx_t *state_data)
             sr_list_cleanup(state_data->requested_xpaths);
             state_data->requested_xpaths = NULL;
         }
+        /* subscriptions are owned by the subscriptions list */
+        sr_list_cleanup(state_data->requested_subscriptions);
+        state_data->requested_subscriptions = NULL;
         state_data->overlapping_leaf_subscription = false;
         state_data->internal_state_data = false;
     }
@@ -177,6 +181,55 @@ rp_dt_get_values_from_nodes(sr_mem_ctx_t *sr_mem, struct ly_set *nodes, sr_val_t
     return rc;
 }
 
+int
+rp_dt_get_gpb_values_from_nodes(sr_mem_ctx_t *sr_mem, struct ly_set *nodes, Sr__Value ***values, size_t *value_cnt)
+{
+    CHECK_NULL_ARG4(sr_mem, nodes, values, value_cnt);
+    int rc = SR_ERR_OK;
+    Sr__Value **gpb_values = NULL;
+    sr_val_t val = { 0, };
+    sr_mem_snapshot_t snapshot = { 0, };
+    size_t cnt = 0;
+    struct lyd_node *node = NULL;
+
+    if (0 == nodes->number) {
+        *values = NULL;
+        *value_cnt = 0;
+        return SR_ERR_OK;
+    }
+
+    sr_mem_snapshot(sr_mem, &snapshot);
+
+    gpb_values = sr_calloc(sr_mem, nodes->number, sizeof(*gpb_values));
+    CHECK_NULL_NOMEM_RETURN(gpb_values);
+
+    for (size_t i = 0; i < nodes->number; i++) {
+        node = nodes->set.d[i];
+        if (NULL == node || NULL == node->schema || LYS_RPC == node->schema->nodetype ||
+            LYS_NOTIF == node->schema->nodetype || LYS_ACTION == node->schema->nodetype) {
+            /* ignore this node */
+            continue;
+        }
+        /* the scratch value only carries pointers into sr_mem, GPB message references them directly */
+        memset(&val, 0, sizeof(val));
+        val._sr_mem = sr_mem;
+        rc = rp_dt_get_value_from_node(node, &val);
+        CHECK_RC_LOG_GOTO(rc, cleanup, "Getting value from node %s failed", node->schema->name);
+
+        rc = sr_dup_val_t_to_gpb(&val, &gpb_values[cnt]);
+        CHECK_RC_LOG_GOTO(rc, cleanup, "Copying value of node %s to GPB failed", node->schema->name);
+        cnt++;
+    }
+
+    *values = gpb_values;
+    *value_cnt = cnt;
+    return SR_ERR_OK;
+
+cleanup:
+    sr_mem_restore(&snapshot);
+    return SR_ERR_INTERNAL;
+}
+
 int
 rp_dt_get_value(dm_ctx_t *dm_ctx, rp_session_t *rp_session, struct lyd_node *data_tree, sr_mem_ctx_t *sr_mem,
         const char *xpath, bool check_enabled, sr_val_t **value)
@@ -220,16 +273,20 @@ rp_dt_get_value(dm_ctx_t *dm_ctx, rp_session_t *rp_session, struct lyd_node *dat
     return rc;
 }
 
-int
-rp_dt_get_values(dm_ctx_t *dm_ctx, rp_session_t *rp_session, struct lyd_node *data_tree, sr_mem_ctx_t *sr_mem,
-        const char *xpath, bool check_enable, sr_val_t **values, size_t *count)
+/**
+ * @brief Finds the nodes matching the xpath and removes those that are not readable
+ * by the session according to NACM.
+ */
+static int
+rp_dt_get_readable_nodes(dm_ctx_t *dm_ctx, rp_session_t *rp_session, struct lyd_node *data_tree,
+        const char *xpath, bool check_enable, struct ly_set **nodes)
 {
-    CHECK_NULL_ARG5(dm_ctx, data_tree, xpath, values, count);
+    CHECK_NULL_ARG4(dm_ctx, data_tree, xpath, nodes);
 
     int rc = SR_ERR_OK;
-    struct ly_set *nodes = NULL;
+    struct ly_set *found = NULL;
 
-    rc = rp_dt_find_nodes(dm_ctx, data_tree, xpath, check_enable, &nodes);
+    rc = rp_dt_find_nodes(dm_ctx, data_tree, xpath, check_enable, &found);
     if (SR_ERR_OK != rc) {
         if (SR_ERR_NOT_FOUND != rc) {
             SR_LOG_ERR("Get nodes for xpath %s failed (%d)", xpath, rc);
@@ -237,22 +294,43 @@ rp_dt_get_values(dm_ctx_t *dm_ctx, rp_session_t *rp_session, struct lyd_node *da
         goto cleanup;
     }
 
-    rc = rp_dt_nacm_filtering(dm_ctx, rp_session, data_tree, nodes->set.d, &nodes->number);
+    rc = rp_dt_nacm_filtering(dm_ctx, rp_session, data_tree, found->set.d, &found->number);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to filter nodes by NACM read access.");
-    if (0 == nodes->number) {
+    if (0 == found->number) {
         rc = SR_ERR_NOT_FOUND;
         goto cleanup;
     }
 
+    *nodes = found;
+    found = NULL;
+
+cleanup:
+    if (NULL != found) {
+        ly_set_free(found);
+    }
+    return rc;
+}
+
+int
+rp_dt_get_values(dm_ctx_t *dm_ctx, rp_session_t *rp_session, struct lyd_node *data_tree, sr_mem_ctx_t *sr_mem,
+        const char *xpath, bool check_enable, sr_val_t **values, size_t *count)
+{
+    CHECK_NULL_ARG5(dm_ctx, data_tree, xpath, values, count);
+
+    int rc = SR_ERR_OK;
+    struct ly_set *nodes = NULL;
+
+    rc = rp_dt_get_readable_nodes(dm_ctx, rp_session, data_tree, xpath, check_enable, &nodes);
+    if (SR_ERR_OK != rc) {
+        return rc;
+    }
+
     rc = rp_dt_get_values_from_nodes(sr_mem, nodes, values, count);
     if (SR_ERR_OK != rc) {
         SR_LOG_ERR("Copying values from nodes failed for xpath '%s'", xpath);
     }
 
-cleanup:
-    if (NULL != nodes) {
-        ly_set_free(nodes);
-    }
+    ly_set_free(nodes);
     return rc;
 }
 
@@ -938,6 +1016,359 @@ cleanup:
     return rc;
 }
 
+bool
+rp_dt_is_bulk_dp_xpath(struct lys_node *sch_node, const char *xpath)
+{
+    if (NULL == sch_node || NULL == xpath) {
+        return false;
+    }
+    /* xpaths sent to bulk data providers are built from schema paths, so they contain no predicates */
+    return NULL == strchr(xpath, '[') && rp_dt_has_parent_list(sch_node, NULL, NULL);
+}
+
+/**
+ * @brief Compares two operational data cache entries by subscription and xpath.
+ */
+static int
+rp_dt_dp_cache_entry_cmp(const void *a, const void *b)
+{
+    const rp_dp_cache_entry_t *entry_a = (const rp_dp_cache_entry_t *) a;
+    const rp_dp_cache_entry_t *entry_b = (const rp_dp_cache_entry_t *) b;
+    int res = 0;
+
+    if (entry_a->dst_id != entry_b->dst_id) {
+        return entry_a->dst_id < entry_b->dst_id ? -1 : 1;
+    }
+    res = strcmp(entry_a->dst_address, entry_b->dst_address);
+    if (0 != res) {
+        return res;
+    }
+    return strcmp(entry_a->xpath, entry_b->xpath);
+}
+
+/**
+ * @brief Frees an operational data cache entry.
+ */
+static void
+rp_dt_dp_cache_entry_free(void *item)
+{
+    rp_dp_cache_entry_t *entry = (rp_dp_cache_entry_t *) item;
+
+    if (NULL != entry) {
+        free(entry->dst_address);
+        free(entry->xpath);
+        sr_free_values(entry->values, entry->values_cnt);
+        free(entry);
+    }
+}
+
+/**
+ * @brief Compares two operational data cache entries by their expiration time.
+ */
+static int
+rp_dt_dp_cache_entry_expiry_cmp(const void *a, const void *b)
+{
+    const rp_dp_cache_entry_t *entry_a = (const rp_dp_cache_entry_t *) a;
+    const rp_dp_cache_entry_t *entry_b = (const rp_dp_cache_entry_t *) b;
+
+    if (entry_a->expires.tv_sec != entry_b->expires.tv_sec) {
+        return entry_a->expires.tv_sec < entry_b->expires.tv_sec ? -1 : 1;
+    }
+    if (entry_a->expires.tv_nsec != entry_b->expires.tv_nsec) {
+        return entry_a->expires.tv_nsec < entry_b->expires.tv_nsec ? -1 : 1;
+    }
+    return rp_dt_dp_cache_entry_cmp(a, b);
+}
+
+/**
+ * @brief Returns true if the cache entry has expired at the time now.
+ */
+static bool
+rp_dt_dp_cache_entry_expired(const rp_dp_cache_entry_t *entry, const struct timespec *now)
+{
+    return (now->tv_sec > entry->expires.tv_sec) ||
+            (now->tv_sec == entry->expires.tv_sec && now->tv_nsec >= entry->expires.tv_nsec);
+}
+
+/**
+ * @brief Removes the entry from the operational data cache and frees it. Called with dp_cache_mutex held.
+ */
+static void
+rp_dt_dp_cache_remove(rp_ctx_t *rp_ctx, rp_dp_cache_entry_t *entry)
+{
+    sr_btree_delete(rp_ctx->dp_cache_expiry, entry);
+    sr_btree_delete(rp_ctx->dp_cache, entry);
+}
+
+/**
+ * @brief Drops the expired entries from the operational data cache, the entries are visited
+ * in the order of their expiration. Called with dp_cache_mutex held.
+ */
+static void
+rp_dt_dp_cache_expire(rp_ctx_t *rp_ctx, const struct timespec *now)
+{
+    rp_dp_cache_entry_t *entry = NULL;
+
+    while (NULL != (entry = sr_btree_get_at(rp_ctx->dp_cache_expiry, 0)) && rp_dt_dp_cache_entry_expired(entry, now)) {
+        rp_dt_dp_cache_remove(rp_ctx, entry);
+    }
+}
+
+int
+rp_dt_dp_cache_init(rp_ctx_t *rp_ctx)
+{
+    CHECK_NULL_ARG(rp_ctx);
+    int rc = SR_ERR_OK;
+
+    rc = sr_btree_init(rp_dt_dp_cache_entry_cmp, rp_dt_dp_cache_entry_free, &rp_ctx->dp_cache);
+    CHECK_RC_MSG_RETURN(rc, "Operational data cache initialization failed.");
+    rc = sr_btree_init(rp_dt_dp_cache_entry_expiry_cmp, NULL, &rp_ctx->dp_cache_expiry);
+    if (SR_ERR_OK != rc) {
+        sr_btree_cleanup(rp_ctx->dp_cache);
+        rp_ctx->dp_cache = NULL;
+        CHECK_RC_MSG_RETURN(rc, "Operational data cache initialization failed.");
+    }
+
+    pthread_mutex_init(&rp_ctx->dp_cache_mutex, NULL);
+    return SR_ERR_OK;
+}
+
+void
+rp_dt_dp_cache_cleanup(rp_ctx_t *rp_ctx)
+{
+    if (NULL != rp_ctx && NULL != rp_ctx->dp_cache) {
+        sr_btree_cleanup(rp_ctx->dp_cache_expiry);
+        rp_ctx->dp_cache_expiry = NULL;
+        sr_btree_cleanup(rp_ctx->dp_cache);
+        rp_ctx->dp_cache = NULL;
+        pthread_mutex_destroy(&rp_ctx->dp_cache_mutex);
+    }
+}
+
+int
+rp_dt_dp_cache_store(rp_ctx_t *rp_ctx, const np_subscription_t *subscription, const char *xpath,
+        const sr_val_t *values, size_t values_cnt)
+{
+    CHECK_NULL_ARG5(rp_ctx, rp_ctx->dp_cache, subscription, subscription->dst_address, xpath);
+    int rc = SR_ERR_OK;
+    rp_dp_cache_entry_t *entry = NULL, *old = NULL;
+    struct timespec now = { 0, };
+
+    if (0 == subscription->cache_ttl) {
+        return SR_ERR_OK;
+    }
+
+    entry = calloc(1, sizeof(*entry));
+    CHECK_NULL_NOMEM_RETURN(entry);
+
+    entry->dst_id = subscription->dst_id;
+    entry->dst_address = strdup(subscription->dst_address);
+    CHECK_NULL_NOMEM_GOTO(entry->dst_address, rc, cleanup);
+    entry->xpath = strdup(xpath);
+    CHECK_NULL_NOMEM_GOTO(entry->xpath, rc, cleanup);
+    if (values_cnt > 0) {
+        rc = sr_dup_values(values, values_cnt, &entry->values);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to duplicate provided values.");
+        entry->values_cnt = values_cnt;
+    }
+
+    sr_clock_get_time(CLOCK_MONOTONIC, &now);
+    entry->expires.tv_sec = now.tv_sec + subscription->cache_ttl / 1000;
+    entry->expires.tv_nsec = now.tv_nsec + (subscription->cache_ttl % 1000) * 1000000L;
+    if (entry->expires.tv_nsec >= 1000000000L) {
+        entry->expires.tv_sec += 1;
+        entry->expires.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&rp_ctx->dp_cache_mutex);
+
+    /* replace the previous data and drop the entries that have expired meanwhile */
+    old = sr_btree_search(rp_ctx->dp_cache, entry);
+    if (NULL != old) {
+        rp_dt_dp_cache_remove(rp_ctx, old);
+    }
+    rp_dt_dp_cache_expire(rp_ctx, &now);
+
+    /* the expiration index does not own the entries */
+    rc = sr_btree_insert(rp_ctx->dp_cache_expiry, entry);
+    if (SR_ERR_OK == rc) {
+        rc = sr_btree_insert(rp_ctx->dp_cache, entry);
+        if (SR_ERR_OK != rc) {
+            sr_btree_delete(rp_ctx->dp_cache_expiry, entry);
+        }
+    }
+
+    pthread_mutex_unlock(&rp_ctx->dp_cache_mutex);
+
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to insert the entry into operational data cache.");
+    SR_LOG_DBG("Operational data for '%s' from '%s' @ %"PRIu32" cached for %"PRIu32" ms.", xpath,
+            subscription->dst_address, subscription->dst_id, subscription->cache_ttl);
+    entry = NULL;
+
+cleanup:
+    rp_dt_dp_cache_entry_free(entry);
+    return rc;
+}
+
+void
+rp_dt_dp_cache_remove_subscription(rp_ctx_t *rp_ctx, const char *dst_address, bool all_subscriptions, uint32_t dst_id)
+{
+    rp_dp_cache_entry_t *entry = NULL;
+    sr_list_t *removed = NULL;
+
+    if (NULL == rp_ctx || NULL == rp_ctx->dp_cache || NULL == dst_address) {
+        return;
+    }
+    if (SR_ERR_OK != sr_list_init(&removed)) {
+        SR_LOG_WRN_MSG("List init failed, cached operational data of the subscription are kept until they expire.");
+        return;
+    }
+
+    pthread_mutex_lock(&rp_ctx->dp_cache_mutex);
+    for (size_t i = 0; NULL != (entry = sr_btree_get_at(rp_ctx->dp_cache, i)); i++) {
+        if ((all_subscriptions || dst_id == entry->dst_id) && 0 == strcmp(dst_address, entry->dst_address)) {
+            sr_list_add(removed, entry);
+        }
+    }
+    for (size_t i = 0; i < removed->count; i++) {
+        rp_dt_dp_cache_remove(rp_ctx, removed->data[i]);
+    }
+    pthread_mutex_unlock(&rp_ctx->dp_cache_mutex);
+
+    if (removed->count > 0) {
+        SR_LOG_DBG("%zu cached operational data entries of '%s' dropped.", removed->count, dst_address);
+    }
+    sr_list_cleanup(removed);
+}
+
+/**
+ * @brief Looks up the operational data cache. In case of a hit the cached values are passed
+ * to the session in a data provide response generated internally, the same way as if the data
+ * provider has answered.
+ * @param [in] rp_ctx
+ * @param [in] rp_session
+ * @param [in] subscription
+ * @param [in] xpath
+ * @param [out] hit set to true if the cached data were used
+ * @return Error code (SR_ERR_OK on success)
+ */
+static int
+rp_dt_dp_cache_provide(rp_ctx_t *rp_ctx, rp_session_t *rp_session, const np_subscription_t *subscription,
+        const char *xpath, bool *hit)
+{
+    CHECK_NULL_ARG5(rp_ctx, rp_session, rp_session->req, subscription, hit);
+    int rc = SR_ERR_OK;
+    rp_dp_cache_entry_t lookup = { 0, }, *entry = NULL;
+    struct timespec now = { 0, };
+    sr_mem_ctx_t *sr_mem = NULL;
+    Sr__Msg *resp = NULL;
+    Sr__DataProvideResp *dp_resp = NULL;
+    sr_val_t *values = NULL;
+
+    *hit = false;
+
+    lookup.dst_address = (char *) subscription->dst_address;
+    lookup.dst_id = subscription->dst_id;
+    lookup.xpath = (char *) xpath;
+
+    sr_clock_get_time(CLOCK_MONOTONIC, &now);
+
+    pthread_mutex_lock(&rp_ctx->dp_cache_mutex);
+
+    entry = sr_btree_search(rp_ctx->dp_cache, &lookup);
+    if (NULL == entry) {
+        goto unlock;
+    }
+    if (rp_dt_dp_cache_entry_expired(entry, &now)) {
+        rp_dt_dp_cache_expire(rp_ctx, &now);
+        goto unlock;
+    }
+
+    rc = sr_mem_new(0, &sr_mem);
+    CHECK_RC_MSG_GOTO(rc, unlock, "Failed to create a new Sysrepo memory context.");
+    rc = sr_gpb_resp_alloc(sr_mem, SR__OPERATION__DATA_PROVIDE, rp_session->id, &resp);
+    if (SR_ERR_OK != rc) {
+        sr_mem_free(sr_mem);
+        SR_LOG_ERR_MSG("Allocation of data provide response failed.");
+        goto unlock;
+    }
+    dp_resp = resp->response->data_provide_resp;
+    dp_resp->request_id = rp_session->req->request->_id;
+    dp_resp->has_from_cache = true;
+    dp_resp->from_cache = true;
+    sr_mem_edit_string(sr_mem, &dp_resp->xpath, xpath);
+    CHECK_NULL_NOMEM_GOTO(dp_resp->xpath, rc, unlock);
+
+    if (entry->values_cnt > 0) {
+        rc = sr_dup_values_ctx(entry->values, entry->values_cnt, sr_mem, &values);
+        CHECK_RC_MSG_GOTO(rc, unlock, "Failed to duplicate cached values.");
+        rc = sr_values_sr_to_gpb(values, entry->values_cnt, &dp_resp->values, &dp_resp->n_values);
+        CHECK_RC_MSG_GOTO(rc, unlock, "Failed to copy cached values to GPB.");
+    }
+
+unlock:
+    pthread_mutex_unlock(&rp_ctx->dp_cache_mutex);
+
+    if (SR_ERR_OK == rc && NULL != resp) {
+        SR_LOG_DBG("Operational data for '%s' from '%s' @ %"PRIu32" served from the cache.", xpath,
+                subscription->dst_address, subscription->dst_id);
+        rc = rp_msg_process(rp_ctx, rp_session, resp);
+        resp = NULL;
+        *hit = (SR_ERR_OK == rc);
+    }
+    if (NULL != resp) {
+        sr_msg_free(resp);
+    }
+
+    return rc;
+}
+
+int
+rp_dt_request_dp_data(rp_ctx_t *rp_ctx, rp_session_t *rp_session, np_subscription_t *subscription, char *xpath)
+{
+    int rc = SR_ERR_OK;
+    bool hit = false;
+
+    CHECK_NULL_ARG_NORET4(rc, rp_ctx, rp_session, subscription, xpath);
+    if (SR_ERR_OK != rc) {
+        free(xpath);
+        return rc;
+    }
+
+    if (subscription->cache_ttl > 0) {
+        rc = rp_dt_dp_cache_provide(rp_ctx, rp_session, subscription, xpath, &hit);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_WRN("Operational data cache lookup failed for xpath %s, asking the data provider.", xpath);
+            rc = SR_ERR_OK;
+        }
+    }
+
+    if (!hit) {
+        SR_LOG_DBG("Sending request for state data: %s", xpath);
+        rc = np_data_provider_request(rp_ctx->np_ctx, subscription, rp_session, xpath);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_WRN("Request for operational data failed with xpath %s on subscription %s", xpath, subscription->xpath);
+            free(xpath);
+            return rc;
+        }
+    }
+
+    rp_session->dp_req_waiting += 1;
+
+    rc = sr_list_add(rp_session->state_data_ctx.requested_subscriptions, subscription);
+    if (SR_ERR_OK != rc) {
+        free(xpath);
+        return rc;
+    }
+    rc = sr_list_add(rp_session->state_data_ctx.requested_xpaths, xpath);
+    if (SR_ERR_OK != rc) {
+        sr_list_rm_at(rp_session->state_data_ctx.requested_subscriptions,
+                rp_session->state_data_ctx.requested_subscriptions->count - 1);
+        free(xpath);
+    }
+    return rc;
+}
+
 /**
  *
  * @param [in] rp_ctx
@@ -957,11 +1388,24 @@ rp_dt_send_request_to_dp_subscription(rp_ctx_t *rp_ctx, rp_session_t *rp_session
     struct lys_node *parent_list = NULL;
     size_t list_depth = 0;
     size_t xp_cnt = 0;
+    struct ly_set *list_instances = NULL;
     np_subscription_t *subscription = NULL;
 
     subscription = rp_session->state_data_ctx.subscriptions->data[subscription_index];
 
-    if (rp_dt_has_parent_list(sch_node, &parent_list, &list_depth)) {
+    if (subscription->dp_bulk && rp_dt_has_parent_list(sch_node, &parent_list, NULL)) {
+        /* the provider returns data for all list instances at once, request them only if there are any */
+        rc = dm_get_nodes_by_schema(rp_session->dm_session, rp_session->module_name, parent_list, &list_instances);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Dm_get_nodes_by_schema failed");
+
+        if (list_instances->number > 0) {
+            SR_LOG_DBG("State data is nested in %u instances of configuration list, will request %s at once",
+                    list_instances->number, xp);
+            rc = rp_dt_request_dp_data(rp_ctx, rp_session, subscription, xp);
+            xp = NULL;
+        }
+
+    } else if (rp_dt_has_parent_list(sch_node, &parent_list, &list_depth)) {
         SR_LOG_DBG("State data is nested in configuration list %s", xp);
 
         rc = rp_dt_create_instance_xps(rp_session, parent_list, &xpaths, &xp_cnt);
@@ -992,40 +1436,26 @@ rp_dt_send_request_to_dp_subscription(rp_ctx_t *rp_ctx, rp_session_t *rp_session
 
             snprintf(request_xp, len, "%s/%s", xpaths[i], ptr);
 
-            rc = np_data_provider_request(rp_ctx->np_ctx, subscription, rp_session, request_xp);
-            SR_LOG_DBG("Sending request for state data: %s", request_xp);
-            if (SR_ERR_OK != rc) {
-                SR_LOG_WRN("Request for operational data failed with xpath %s on subscription %s", request_xp, subscription->xpath);
-                free(request_xp);
-            } else {
-                rp_session->dp_req_waiting += 1;
-                rc = sr_list_add(rp_session->state_data_ctx.requested_xpaths, request_xp);
-            }
+            rc = rp_dt_request_dp_data(rp_ctx, rp_session, subscription, request_xp);
+            request_xp = NULL;
         }
         free(xp);
         xp = NULL;
 
     } else {
-        rc = np_data_provider_request(rp_ctx->np_ctx, subscription, rp_session, xp);
-        SR_LOG_DBG("Sending request for state data: %s", xp);
-        if (SR_ERR_OK != rc) {
-            SR_LOG_WRN("Request for operational data failed with xpath %s on subscription %s", xp, subscription->xpath);
-        } else {
-            rp_session->dp_req_waiting += 1;
-            rc = sr_list_add(rp_session->state_data_ctx.requested_xpaths, xp);
-        }
+        rc = rp_dt_request_dp_data(rp_ctx, rp_session, subscription, xp);
+        xp = NULL;
     }
 
 cleanup:
-    if (SR_ERR_OK != rc) {
-        free(xp);
-    }
+    free(xp);
     if (NULL != xpaths) {
         for (size_t i = 0; i < xp_cnt; i++) {
             free(xpaths[i]);
         }
         free(xpaths);
     }
+    ly_set_free(list_instances);
     return rc;
 }
 
@@ -1180,8 +1610,9 @@ rp_dt_prepare_data(rp_ctx_t *rp_ctx, rp_session_t *rp_session, const char *xpath
 {
     CHECK_NULL_ARG3(rp_ctx, rp_session, xpath);
     int rc = SR_ERR_OK;
-    bool has_state_data = false;
+    bool has_state_data = false, load_state_data = false;
     dm_data_info_t *data_info = NULL;
+    struct lyd_node *tree = NULL;
 
     if (RP_REQ_NEW == rp_session->state) {
 
@@ -1199,20 +1630,31 @@ rp_dt_prepare_data(rp_ctx_t *rp_ctx, rp_session_t *rp_session, const char *xpath
         rc = ac_check_node_permissions(rp_session->ac_session, xpath, AC_OPER_READ);
         CHECK_RC_LOG_GOTO(rc, cleanup, "Access control check failed for xpath '%s'", xpath);
 
-        rc = dm_get_data_info(rp_ctx->dm_ctx, rp_session->dm_session, rp_session->module_name, &data_info);
+        /* operational data are merged into the session copy of the data tree */
+        load_state_data = (SR_DS_RUNNING == rp_session->datastore || SR_DS_CANDIDATE == rp_session->datastore) &&
+            (!(SR_SESS_CONFIG_ONLY & rp_session->options)) &&
+            (!(SR__SESSION_FLAGS__SESS_NOTIFICATION & rp_session->options)) &&
+            (SR_ERR_OK == dm_has_state_data(rp_ctx->dm_ctx, rp_session->module_name, &has_state_data) && has_state_data);
+
+        if (load_state_data) {
+            rc = dm_get_data_info(rp_ctx->dm_ctx, rp_session->dm_session, rp_session->module_name, &data_info);
+            if (SR_ERR_OK == rc) {
+                tree = data_info->node;
+            }
+        } else {
+            /* read-only access, the data tree may be shared with other sessions */
+            rc = dm_get_datatree(rp_ctx->dm_ctx, rp_session->dm_session, rp_session->module_name, &tree);
+        }
 
         /* check of data tree's emptiness is performed outside of this function -> ignore SR_ERR_NOT_FOUND */
         rc = SR_ERR_NOT_FOUND == rc ? SR_ERR_OK : rc;
         CHECK_RC_LOG_GOTO(rc, cleanup, "Getting data tree failed (%d) for xpath '%s'", rc, xpath);
         if (data_tree) {
-            *data_tree = data_info->node;
+            *data_tree = tree;
         }
 
         /* if the request requires operational data pause the processing and wait for data to be provided */
-        if ((SR_DS_RUNNING == rp_session->datastore || SR_DS_CANDIDATE == rp_session->datastore) &&
-            (!(SR_SESS_CONFIG_ONLY & rp_session->options)) &&
-            (!(SR__SESSION_FLAGS__SESS_NOTIFICATION & rp_session->options)) &&
-            (SR_ERR_OK == dm_has_state_data(rp_ctx->dm_ctx, rp_session->module_name, &has_state_data) && has_state_data)) {
+        if (load_state_data) {
 
             rp_dt_free_state_data_ctx_content(&rp_session->state_data_ctx);
             rp_session->dp_req_waiting = 0;
@@ -1220,6 +1662,9 @@ rp_dt_prepare_data(rp_ctx_t *rp_ctx, rp_session_t *rp_session, const char *xpath
             rc = sr_list_init(&rp_session->state_data_ctx.requested_xpaths);
             CHECK_RC_MSG_GOTO(rc, cleanup, "List init failed");
 
+            rc = sr_list_init(&rp_session->state_data_ctx.requested_subscriptions);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "List init failed");
+
             rc = rp_dt_xpath_requests_state_data(rp_ctx, rp_session, data_info->schema, xpath, api_variant,
                     tree_depth_limit, &rp_session->state_data_ctx);
             CHECK_RC_MSG_GOTO(rc, cleanup, "rp_dt_xpath_requests_state_data failed");
@@ -1297,17 +1742,23 @@ cleanup:
     return rc;
 }
 
-int
-rp_dt_get_values_wrapper(rp_ctx_t *rp_ctx, rp_session_t *rp_session, sr_mem_ctx_t *sr_mem, const char *xpath,
-        sr_val_t **values, size_t *count)
+/**
+ * @brief Loads the data needed for get-items request and returns the readable nodes
+ * matching the xpath. If the request has to wait for operational data, SR_ERR_OK
+ * is returned and nodes are left NULL.
+ */
+static int
+rp_dt_get_nodes_wrapper(rp_ctx_t *rp_ctx, rp_session_t *rp_session, const char *xpath, struct ly_set **nodes)
 {
     CHECK_NULL_ARG4(rp_ctx, rp_ctx->dm_ctx, rp_session, rp_session->dm_session);
-    CHECK_NULL_ARG3(xpath, values, count);
+    CHECK_NULL_ARG2(xpath, nodes);
     SR_LOG_INF("Get items request %s datastore, xpath: %s", sr_ds_to_str(rp_session->datastore), xpath);
 
     int rc = SR_ERR_OK;
     struct lyd_node *data_tree = NULL;
 
+    *nodes = NULL;
+
     rc = rp_dt_prepare_data(rp_ctx, rp_session, xpath, SR_API_VALUES, 0, &data_tree);
     CHECK_RC_MSG_GOTO(rc, cleanup, "rp_dt_prepare_data failed");
 
@@ -1321,8 +1772,8 @@ rp_dt_get_values_wrapper(rp_ctx_t *rp_ctx, rp_session_t *rp_session, sr_mem_ctx_
         goto cleanup;
     }
 
-    rc = rp_dt_get_values(rp_ctx->dm_ctx, rp_session, data_tree, sr_mem, xpath,
-            dm_is_running_ds_session(rp_session->dm_session), values, count);
+    rc = rp_dt_get_readable_nodes(rp_ctx->dm_ctx, rp_session, data_tree, xpath,
+            dm_is_running_ds_session(rp_session->dm_session), nodes);
     if (SR_ERR_UNAUTHORIZED == rc) {
         rc = SR_ERR_NOT_FOUND;
     } else if (SR_ERR_OK != rc && SR_ERR_NOT_FOUND != rc) {
@@ -1336,45 +1787,86 @@ cleanup:
     return rc;
 }
 
-int
-rp_dt_get_values_wrapper_with_opts(rp_ctx_t *rp_ctx, rp_session_t *rp_session, rp_dt_get_items_ctx_t *get_items_ctx, sr_mem_ctx_t *sr_mem,
-        const char *xpath, size_t offset, size_t limit, sr_val_t **values, size_t *count)
+/**
+ * @brief Loads the data needed for get-items request with offset and limit and returns
+ * the selected nodes. If the request continues where the previous page of the iteration
+ * stopped, the nodes are selected from the snapshot held by get_items_ctx without loading
+ * the data (or asking data providers) again. Otherwise a snapshot of the loaded data is taken
+ * for the subsequent pages. If the request has to wait for operational data, SR_ERR_OK
+ * is returned and nodes are left NULL.
+ */
+static int
+rp_dt_get_nodes_wrapper_with_opts(rp_ctx_t *rp_ctx, rp_session_t *rp_session, rp_dt_get_items_ctx_t *get_items_ctx,
+        const char *xpath, size_t offset, size_t limit, struct ly_set **nodes)
 {
     CHECK_NULL_ARG5(rp_ctx, rp_ctx->dm_ctx, rp_session, rp_session->dm_session, get_items_ctx);
-    CHECK_NULL_ARG3(xpath, values, count);
+    CHECK_NULL_ARG2(xpath, nodes);
     SR_LOG_INF("Get items request %s datastore, xpath: %s, offset: %zu, limit: %zu", sr_ds_to_str(rp_session->datastore), xpath, offset, limit);
 
     int rc = SR_ERR_OK;
     struct lyd_node *data_tree = NULL;
-    struct ly_set *nodes = NULL;
 
-    if (get_items_ctx->xpath != NULL && 0 == strcmp(xpath, get_items_ctx->xpath) &&
+    *nodes = NULL;
+
+    if (NULL != get_items_ctx->snapshot && NULL != get_items_ctx->xpath && 0 == strcmp(xpath, get_items_ctx->xpath) &&
             offset == get_items_ctx->offset) {
-        /* cache hit do not load data from data providers */
-        rp_session->state = RP_REQ_DATA_LOADED;
-    }
+        /* continue in the snapshot, do not load data nor ask data providers */
+        SR_LOG_DBG("Get items continues in the snapshot, session id = %u", rp_session->id);
+    } else {
+        rc = rp_dt_prepare_data(rp_ctx, rp_session, xpath, SR_API_VALUES, 0, &data_tree);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "rp_dt_prepare_data failed");
 
-    rc = rp_dt_prepare_data(rp_ctx, rp_session, xpath, SR_API_VALUES, 0, &data_tree);
-    CHECK_RC_MSG_GOTO(rc, cleanup, "rp_dt_prepare_data failed");
+        if (RP_REQ_WAITING_FOR_DATA == rp_session->state) {
+            SR_LOG_DBG("Session id = %u is waiting for the data", rp_session->id);
+            return rc;
+        }
 
-    if (RP_REQ_WAITING_FOR_DATA == rp_session->state) {
-        SR_LOG_DBG("Session id = %u is waiting for the data", rp_session->id);
-        return rc;
-    }
+        if (NULL == data_tree) {
+            rc = SR_ERR_NOT_FOUND;
+            goto cleanup;
+        }
 
-    if (NULL == data_tree) {
-        rc = SR_ERR_NOT_FOUND;
-        goto cleanup;
+        /* take an immutable snapshot of the data, the session may modify its copy between the pages */
+        rp_dt_free_get_items_ctx_content(get_items_ctx);
+        rc = dm_get_datatree_snapshot(rp_ctx->dm_ctx, rp_session->dm_session, rp_session->module_name,
+                &get_items_ctx->schema_info, &get_items_ctx->snapshot);
+        if (SR_ERR_OK != rc) {
+            if (SR_ERR_NOT_FOUND != rc) {
+                SR_LOG_ERR("Failed to take a snapshot of the data tree for xpath %s", xpath);
+            }
+            goto cleanup;
+        }
     }
 
-    rc = rp_dt_find_nodes_with_opts(rp_ctx->dm_ctx, rp_session, get_items_ctx, data_tree, xpath, offset, limit, &nodes);
+    rc = rp_dt_find_nodes_with_opts(rp_ctx->dm_ctx, rp_session, get_items_ctx, get_items_ctx->snapshot->node,
+            xpath, offset, limit, nodes);
     if (SR_ERR_OK != rc) {
         if (SR_ERR_UNAUTHORIZED == rc) {
             rc = SR_ERR_NOT_FOUND;
         } else if (SR_ERR_NOT_FOUND != rc) {
             SR_LOG_ERR("Get nodes for xpath %s failed (%d)", xpath, rc);
         }
-        goto cleanup;
+        ly_set_free(*nodes);
+        *nodes = NULL;
+    }
+
+cleanup:
+    rp_session->state = RP_REQ_FINISHED;
+    return rc;
+}
+
+int
+rp_dt_get_values_wrapper(rp_ctx_t *rp_ctx, rp_session_t *rp_session, sr_mem_ctx_t *sr_mem, const char *xpath,
+        sr_val_t **values, size_t *count)
+{
+    CHECK_NULL_ARG3(xpath, values, count);
+
+    int rc = SR_ERR_OK;
+    struct ly_set *nodes = NULL;
+
+    rc = rp_dt_get_nodes_wrapper(rp_ctx, rp_session, xpath, &nodes);
+    if (SR_ERR_OK != rc || NULL == nodes) {
+        return rc;
     }
 
     rc = rp_dt_get_values_from_nodes(sr_mem, nodes, values, count);
@@ -1382,12 +1874,226 @@ rp_dt_get_values_wrapper_with_opts(rp_ctx_t *rp_ctx, rp_session_t *rp_session, r
         SR_LOG_ERR("Copying values from nodes failed for xpath '%s'", xpath);
     }
 
-cleanup:
     ly_set_free(nodes);
-    rp_session->state = RP_REQ_FINISHED;
     return rc;
 }
 
+int
+rp_dt_get_values_wrapper_with_opts(rp_ctx_t *rp_ctx, rp_session_t *rp_session, rp_dt_get_items_ctx_t *get_items_ctx, sr_mem_ctx_t *sr_mem,
+        const char *xpath, size_t offset, size_t limit, sr_val_t **values, size_t *count)
+{
+    CHECK_NULL_ARG3(xpath, values, count);
+
+    int rc = SR_ERR_OK;
+    struct ly_set *nodes = NULL;
+
+    rc = rp_dt_get_nodes_wrapper_with_opts(rp_ctx, rp_session, get_items_ctx, xpath, offset, limit, &nodes);
+    if (SR_ERR_OK != rc || NULL == nodes) {
+        return rc;
+    }
+
+    rc = rp_dt_get_values_from_nodes(sr_mem, nodes, values, count);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_ERR("Copying values from nodes failed for xpath '%s'", xpath);
+    }
+
+    ly_set_free(nodes);
+    return rc;
+}
+
+int
+rp_dt_get_gpb_values_wrapper(rp_ctx_t *rp_ctx, rp_session_t *rp_session, sr_mem_ctx_t *sr_mem, const char *xpath,
+        Sr__Value ***values, size_t *count)
+{
+    CHECK_NULL_ARG4(sr_mem, xpath, values, count);
+
+    int rc = SR_ERR_OK;
+    struct ly_set *nodes = NULL;
+
+    rc = rp_dt_get_nodes_wrapper(rp_ctx, rp_session, xpath, &nodes);
+    if (SR_ERR_OK != rc || NULL == nodes) {
+        return rc;
+    }
+
+    rc = rp_dt_get_gpb_values_from_nodes(sr_mem, nodes, values, count);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_ERR("Encoding values from nodes failed for xpath '%s'", xpath);
+    }
+
+    ly_set_free(nodes);
+    return rc;
+}
+
+int
+rp_dt_get_gpb_values_wrapper_with_opts(rp_ctx_t *rp_ctx, rp_session_t *rp_session, rp_dt_get_items_ctx_t *get_items_ctx, sr_mem_ctx_t *sr_mem,
+        const char *xpath, size_t offset, size_t limit, Sr__Value ***values, size_t *count)
+{
+    CHECK_NULL_ARG4(sr_mem, xpath, values, count);
+
+    int rc = SR_ERR_OK;
+    struct ly_set *nodes = NULL;
+
+    rc = rp_dt_get_nodes_wrapper_with_opts(rp_ctx, rp_session, get_items_ctx, xpath, offset, limit, &nodes);
+    if (SR_ERR_OK != rc || NULL == nodes) {
+        return rc;
+    }
+
+    rc = rp_dt_get_gpb_values_from_nodes(sr_mem, nodes, values, count);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_ERR("Encoding values from nodes failed for xpath '%s'", xpath);
+    }
+
+    ly_set_free(nodes);
+    return rc;
+}
+
+void
+rp_dt_free_get_items_ctx_content(rp_dt_get_items_ctx_t *get_items_ctx)
+{
+    if (NULL == get_items_ctx) {
+        return;
+    }
+    ly_set_free(get_items_ctx->nodes);
+    get_items_ctx->nodes = NULL;
+    free(get_items_ctx->xpath);
+    get_items_ctx->xpath = NULL;
+    get_items_ctx->offset = 0;
+    dm_release_datatree_snapshot(get_items_ctx->schema_info, get_items_ctx->snapshot);
+    get_items_ctx->schema_info = NULL;
+    get_items_ctx->snapshot = NULL;
+}
+
+/**
+ * @brief Removes the cursor from the list of session cursors and frees it.
+ */
+static void
+rp_dt_get_items_cursor_remove_at(rp_session_t *rp_session, size_t index)
+{
+    rp_dt_get_items_ctx_t *cursor = rp_session->get_items_cursors->data[index];
+
+    SR_LOG_DBG("Closing get_items cursor %"PRIu32", session id = %u", cursor->id, rp_session->id);
+    sr_list_rm_at(rp_session->get_items_cursors, index);
+    rp_dt_free_get_items_ctx_content(cursor);
+    free(cursor);
+}
+
+void
+rp_dt_expire_get_items_cursors(rp_session_t *rp_session)
+{
+    rp_dt_get_items_ctx_t *c = NULL;
+    struct timespec now = { 0, };
+
+    if (NULL == rp_session || NULL == rp_session->get_items_cursors) {
+        return;
+    }
+
+    sr_clock_get_time(CLOCK_MONOTONIC, &now);
+    for (size_t i = 0; i < rp_session->get_items_cursors->count; ) {
+        c = rp_session->get_items_cursors->data[i];
+        if (now.tv_sec - c->last_used.tv_sec >= SR_GET_ITEMS_CURSOR_TIMEOUT) {
+            rp_dt_get_items_cursor_remove_at(rp_session, i);
+        } else {
+            i++;
+        }
+    }
+}
+
+int
+rp_dt_get_items_cursor(rp_session_t *rp_session, uint32_t cursor_id, bool open_cursor, size_t limit,
+        rp_dt_get_items_ctx_t **cursor)
+{
+    CHECK_NULL_ARG2(rp_session, cursor);
+
+    int rc = SR_ERR_OK;
+    rp_dt_get_items_ctx_t *c = NULL;
+    struct timespec now = { 0, };
+
+    if (NULL == rp_session->get_items_cursors) {
+        rc = sr_list_init(&rp_session->get_items_cursors);
+        CHECK_RC_MSG_RETURN(rc, "List init failed");
+    }
+
+    /* close the cursors which have not been used for too long */
+    rp_dt_expire_get_items_cursors(rp_session);
+    sr_clock_get_time(CLOCK_MONOTONIC, &now);
+
+    /* look up the cursor, iterations of the clients that do not use the handles have the cursor with id 0 */
+    for (size_t i = 0; i < rp_session->get_items_cursors->count && !(open_cursor && 0 == cursor_id); i++) {
+        c = rp_session->get_items_cursors->data[i];
+        if (cursor_id == c->id) {
+            /* move to the most recently used position */
+            sr_list_rm_at(rp_session->get_items_cursors, i);
+            rc = sr_list_add(rp_session->get_items_cursors, c);
+            if (SR_ERR_OK != rc) {
+                rp_dt_free_get_items_ctx_content(c);
+                free(c);
+                CHECK_RC_MSG_RETURN(rc, "List add failed");
+            }
+            c->last_used = now;
+            *cursor = c;
+            return rc;
+        }
+    }
+
+    if (open_cursor || 0 != cursor_id) {
+        /* a new cursor, or the cursor has expired and the iteration continues in a new one from the requested offset */
+        SR_LOG_DBG("Opening get_items cursor (requested %"PRIu32"), session id = %u", cursor_id, rp_session->id);
+        cursor_id = ++rp_session->last_cursor_id;
+        if (0 == cursor_id) {
+            cursor_id = ++rp_session->last_cursor_id;
+        }
+    }
+
+    /* evict the least recently used cursor if there are too many of them */
+    if (rp_session->get_items_cursors->count >= SR_GET_ITEMS_CURSOR_LIMIT) {
+        rp_dt_get_items_cursor_remove_at(rp_session, 0);
+    }
+
+    c = calloc(1, sizeof *c);
+    CHECK_NULL_NOMEM_RETURN(c);
+    c->id = cursor_id;
+    c->page_size = limit;
+    c->last_used = now;
+
+    rc = sr_list_add(rp_session->get_items_cursors, c);
+    if (SR_ERR_OK != rc) {
+        free(c);
+        CHECK_RC_MSG_RETURN(rc, "List add failed");
+    }
+
+    *cursor = c;
+    return rc;
+}
+
+void
+rp_dt_close_get_items_cursor(rp_session_t *rp_session, rp_dt_get_items_ctx_t *cursor)
+{
+    if (NULL == rp_session || NULL == rp_session->get_items_cursors || NULL == cursor) {
+        return;
+    }
+
+    for (size_t i = 0; i < rp_session->get_items_cursors->count; i++) {
+        if (cursor == rp_session->get_items_cursors->data[i]) {
+            rp_dt_get_items_cursor_remove_at(rp_session, i);
+            return;
+        }
+    }
+}
+
+void
+rp_dt_free_get_items_cursors(rp_session_t *rp_session)
+{
+    if (NULL == rp_session || NULL == rp_session->get_items_cursors) {
+        return;
+    }
+
+    while (rp_session->get_items_cursors->count > 0) {
+        rp_dt_get_items_cursor_remove_at(rp_session, rp_session->get_items_cursors->count - 1);
+    }
+    sr_list_cleanup(rp_session->get_items_cursors);
+    rp_session->get_items_cursors = NULL;
+}
+
 int
 rp_dt_get_subtree_wrapper(rp_ctx_t *rp_ctx, rp_session_t *rp_session, sr_mem_ctx_t *sr_mem, const char *xpath, sr_node_t **subtree)
 {
@@ -1890,6 +2596,37 @@ cleanup:
     return rc;
 }
 
+/**
+ * @brief Acquires the changes lock of the model subscription and generates the changes from the difflist
+ * if it has not been done yet. The lock is held upon successful return.
+ */
+static int
+rp_dt_lock_changes(dm_model_subscription_t *ms)
+{
+    int rc = SR_ERR_OK;
+
+    RWLOCK_RDLOCK_TIMED_CHECK_RETURN(&ms->changes_lock);
+
+    /* generate changes on demand */
+    if (!ms->changes_generated) {
+        pthread_rwlock_unlock(&ms->changes_lock);
+        /* acquire write lock */
+        RWLOCK_WRLOCK_TIMED_CHECK_RETURN(&ms->changes_lock);
+        /* check if some generated the changes meanwhile */
+        if (!ms->changes_generated) {
+            rc = rp_dt_difflist_to_changes(ms->difflist, &ms->changes);
+            if (SR_ERR_OK != rc) {
+                SR_LOG_ERR_MSG("Difflist to changes failed");
+                pthread_rwlock_unlock(&ms->changes_lock);
+                return rc;
+            }
+            ms->changes_generated = true;
+        }
+    }
+
+    return rc;
+}
+
 int
 rp_dt_get_changes(rp_ctx_t *rp_ctx, rp_session_t *rp_session, dm_commit_context_t *c_ctx, const char *xpath,
         size_t offset, size_t limit, sr_list_t **matched_changes)
@@ -1919,25 +2656,8 @@ rp_dt_get_changes(rp_ctx_t *rp_ctx, rp_session_t *rp_session, dm_commit_context_
         goto cleanup;
     }
 
-
-    RWLOCK_RDLOCK_TIMED_CHECK_GOTO(&ms->changes_lock, rc, cleanup);
-
-    /* generate changes on demand */
-    if (!ms->changes_generated) {
-        pthread_rwlock_unlock(&ms->changes_lock);
-        /* acquire write lock */
-        RWLOCK_WRLOCK_TIMED_CHECK_GOTO(&ms->changes_lock, rc, cleanup);
-        /* check if some generated the changes meanwhile */
-        if (!ms->changes_generated) {
-            rc = rp_dt_difflist_to_changes(ms->difflist, &ms->changes);
-            if (SR_ERR_OK != rc) {
-                SR_LOG_ERR_MSG("Difflist to changes failed");
-                pthread_rwlock_unlock(&ms->changes_lock);
-                goto cleanup;
-            }
-            ms->changes_generated = true;
-        }
-    }
+    rc = rp_dt_lock_changes(ms);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to generate changes");
 
     rc = rp_dt_find_changes(rp_ctx->dm_ctx, rp_session->dm_session, ms, &rp_session->change_ctx, xpath, offset, limit, matched_changes);
     pthread_rwlock_unlock(&ms->changes_lock);
@@ -1950,3 +2670,35 @@ cleanup:
     free(module_name);
     return rc;
 }
+
+int
+rp_dt_get_subscription_changes(dm_model_subscription_t *ms, struct lys_node *selection_node, sr_list_t **matched_changes)
+{
+    CHECK_NULL_ARG2(ms, matched_changes);
+    int rc = SR_ERR_OK;
+    sr_list_t *changes = NULL;
+    sr_change_t *change = NULL;
+
+    rc = rp_dt_lock_changes(ms);
+    CHECK_RC_MSG_RETURN(rc, "Failed to generate changes");
+
+    rc = sr_list_init(&changes);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "List init failed");
+
+    for (size_t i = 0; NULL != ms->changes && i < ms->changes->count; i++) {
+        change = (sr_change_t *) ms->changes->data[i];
+        if (NULL == selection_node || (NULL != change->sch_node && rp_dt_depth_under_subtree(selection_node, change->sch_node, NULL))) {
+            rc = sr_list_add(changes, change);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "List add failed");
+        }
+    }
+
+cleanup:
+    pthread_rwlock_unlock(&ms->changes_lock);
+    if (SR_ERR_OK != rc) {
+        sr_list_cleanup(changes);
+    } else {
+        *matched_changes = changes;
+    }
+    return rc;
+}
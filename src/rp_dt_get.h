@@ -85,9 +85,11 @@ int rp_dt_get_values_wrapper(rp_ctx_t *rp_ctx, rp_session_t *rp_session, sr_mem_
 /**
  * @brief Returns the values for the specified xpath. Internally calls ::rp_dt_find_nodes_with_opts
  * to identify the matching nodes. The selection of returned values can be specified by limit and offset.
+ * The nodes are selected from a snapshot of the data held by get_items_ctx, so the subsequent pages
+ * neither load the data nor evaluate the xpath again.
  * @param [in] rp_ctx
  * @param [in] rp_session
- * @param [in] get_items_ctx
+ * @param [in] get_items_ctx - cursor of the iteration, its content is freed by ::rp_dt_free_get_items_ctx_content
  * @param [in] sr_mem
  * @param [in] xpath
  * @param [in] offset - return the values with index and above
@@ -99,6 +101,75 @@ int rp_dt_get_values_wrapper(rp_ctx_t *rp_ctx, rp_session_t *rp_session, sr_mem_
 int rp_dt_get_values_wrapper_with_opts(rp_ctx_t *rp_ctx, rp_session_t *rp_session, rp_dt_get_items_ctx_t *get_items_ctx, sr_mem_ctx_t *sr_mem,
         const char *xpath, size_t offset, size_t limit, sr_val_t **values, size_t *count);
 
+/**
+ * @brief Same as ::rp_dt_get_values_wrapper, but the values are encoded straight
+ * into GPB values allocated in the provided memory context, without the intermediate sr_val_t array.
+ * @param [in] rp_ctx
+ * @param [in] rp_session
+ * @param [in] sr_mem Sysrepo memory context of the response message (can not be NULL).
+ * @param [in] xpath
+ * @param [out] values
+ * @param [out] count
+ * @return Error code (SR_ERR_OK on success), SR_ERR_NOT_FOUND, SR_ERR_UNKNOWN_MODEL, SR_ERR_BAD_ELEMENT
+ */
+int rp_dt_get_gpb_values_wrapper(rp_ctx_t *rp_ctx, rp_session_t *rp_session, sr_mem_ctx_t *sr_mem, const char *xpath,
+        Sr__Value ***values, size_t *count);
+
+/**
+ * @brief Same as ::rp_dt_get_values_wrapper_with_opts, but the values are encoded straight
+ * into GPB values allocated in the provided memory context.
+ * @param [in] rp_ctx
+ * @param [in] rp_session
+ * @param [in] get_items_ctx
+ * @param [in] sr_mem Sysrepo memory context of the response message (can not be NULL).
+ * @param [in] xpath
+ * @param [in] offset - return the values with index and above
+ * @param [in] limit - the maximum count of values that can be returned
+ * @param [out] values
+ * @param [out] count
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dt_get_gpb_values_wrapper_with_opts(rp_ctx_t *rp_ctx, rp_session_t *rp_session, rp_dt_get_items_ctx_t *get_items_ctx, sr_mem_ctx_t *sr_mem,
+        const char *xpath, size_t offset, size_t limit, Sr__Value ***values, size_t *count);
+
+/**
+ * @brief Closes the get_items_iter cursors of the session that have not been used
+ * for SR_GET_ITEMS_CURSOR_TIMEOUT seconds, releasing their data tree snapshots.
+ * Must be called with cur_req_mutex of the session held.
+ * @param [in] rp_session
+ */
+void rp_dt_expire_get_items_cursors(rp_session_t *rp_session);
+
+/**
+ * @brief Returns the get_items_iter cursor of the session. Cursors that have not been used
+ * for SR_GET_ITEMS_CURSOR_TIMEOUT seconds are closed first. If the cursor is not found (or a new one
+ * is requested), a new cursor is added to the session, evicting the least recently used one
+ * if the session already has SR_GET_ITEMS_CURSOR_LIMIT cursors.
+ * @param [in] rp_session
+ * @param [in] cursor_id Handle of the cursor, 0 for clients that do not use the handles.
+ * @param [in] open_cursor Open a new cursor with a new handle.
+ * @param [in] limit Initial page size of a new cursor.
+ * @param [out] cursor
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dt_get_items_cursor(rp_session_t *rp_session, uint32_t cursor_id, bool open_cursor, size_t limit,
+        rp_dt_get_items_ctx_t **cursor);
+
+/**
+ * @brief Closes the cursor returned by ::rp_dt_get_items_cursor.
+ */
+void rp_dt_close_get_items_cursor(rp_session_t *rp_session, rp_dt_get_items_ctx_t *cursor);
+
+/**
+ * @brief Closes all get_items_iter cursors of the session.
+ */
+void rp_dt_free_get_items_cursors(rp_session_t *rp_session);
+
+/**
+ * @brief Frees the content of the get_items context (selected nodes and the snapshot).
+ */
+void rp_dt_free_get_items_ctx_content(rp_dt_get_items_ctx_t *get_items_ctx);
+
 /**
  * @brief Fills the values from the array of nodes. The length of the
  * values array is equal to the count of the nodes in nodes set.
@@ -110,6 +181,18 @@ int rp_dt_get_values_wrapper_with_opts(rp_ctx_t *rp_ctx, rp_session_t *rp_sessio
  */
 int rp_dt_get_values_from_nodes(sr_mem_ctx_t *sr_mem, struct ly_set *nodes, sr_val_t **values, size_t *value_cnt);
 
+/**
+ * @brief Encodes the nodes from the set directly as GPB values. Strings are copied
+ * once into sr_mem and referenced by the GPB values. RPC, action and notification
+ * nodes are skipped, therefore value_cnt can be lower than the count of the nodes.
+ * @param [in] sr_mem Sysrepo memory context to use for memory allocation (can not be NULL).
+ * @param [in] nodes
+ * @param [out] values
+ * @param [out] value_cnt
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dt_get_gpb_values_from_nodes(sr_mem_ctx_t *sr_mem, struct ly_set *nodes, Sr__Value ***values, size_t *value_cnt);
+
 /**
  * @brief Returns subtree with the root node at the specified xpath. If more than one node matching xpath,
  * SR_ERR_INVAL_ARG is returned.
@@ -264,6 +347,17 @@ int rp_dt_difflist_to_changes(struct lyd_difflist *difflist, sr_list_t **changes
 int rp_dt_get_changes(rp_ctx_t *rp_ctx, rp_session_t *session, dm_commit_context_t *c_ctx, const char *xpath,
             size_t offset, size_t limit, sr_list_t **matched_changes);
 
+/**
+ * @brief Returns all changes of the model subscription located under the selection node. Changes
+ * are generated from difflist if it has not been done yet. The returned list does not own the changes,
+ * they are valid as long as the commit context exists.
+ * @param [in] ms
+ * @param [in] selection_node - NULL selects all changes of the module
+ * @param [out] matched_changes
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dt_get_subscription_changes(dm_model_subscription_t *ms, struct lys_node *selection_node, sr_list_t **matched_changes);
+
 /**
  * @brief Removes the state data loaded into a session
  * @param [in] rp_ctx
@@ -272,6 +366,55 @@ int rp_dt_get_changes(rp_ctx_t *rp_ctx, rp_session_t *session, dm_commit_context
  */
 int rp_dt_remove_loaded_state_data(rp_ctx_t *rp_ctx, rp_session_t *rp_session);
 
+/**
+ * @brief Requests the operational data under the xpath from the data provider subscription.
+ * If the subscription allows caching and the data are in the operational data cache, the data provider
+ * is not contacted and the cached data are passed to the session as if the provider has answered.
+ * On success the xpath is added to the list of requested xpaths of the session.
+ * @param [in] rp_ctx
+ * @param [in] rp_session
+ * @param [in] subscription
+ * @param [in] xpath - must be allocated, must not be used after return from the function. It will be freed
+ * even in case of error.
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dt_request_dp_data(rp_ctx_t *rp_ctx, rp_session_t *rp_session, np_subscription_t *subscription, char *xpath);
+
+/**
+ * @brief Initializes the operational data cache of Request Processor.
+ * @param [in] rp_ctx
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dt_dp_cache_init(rp_ctx_t *rp_ctx);
+
+/**
+ * @brief Releases the operational data cache of Request Processor.
+ * @param [in] rp_ctx
+ */
+void rp_dt_dp_cache_cleanup(rp_ctx_t *rp_ctx);
+
+/**
+ * @brief Stores the values provided by the data provider subscription for the xpath into
+ * the operational data cache. Does nothing if the subscription does not allow caching.
+ * @param [in] rp_ctx
+ * @param [in] subscription
+ * @param [in] xpath
+ * @param [in] values
+ * @param [in] values_cnt
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dt_dp_cache_store(rp_ctx_t *rp_ctx, const np_subscription_t *subscription, const char *xpath,
+        const sr_val_t *values, size_t values_cnt);
+
+/**
+ * @brief Drops the operational data cached for the data provider subscription(s) of the destination.
+ * @param [in] rp_ctx
+ * @param [in] dst_address Destination address of the subscription(s).
+ * @param [in] all_subscriptions Drop the data of all subscriptions of the destination.
+ * @param [in] dst_id Destination ID of the subscription (ignored if all_subscriptions is set).
+ */
+void rp_dt_dp_cache_remove_subscription(rp_ctx_t *rp_ctx, const char *dst_address, bool all_subscriptions, uint32_t dst_id);
+
 /**
  * @brief Loads configuration data and asks for state data if needed. Request
  * can enter this function in RP_REQ_NEW state or RP_REQ_FINISHED.
@@ -333,6 +476,15 @@ bool rp_dt_find_exact_match_subscription_for_node(rp_session_t *rp_session, stru
  */
 int rp_dt_create_instance_xps(rp_session_t *session, struct lys_node *sch_node, char ***xps, size_t *xp_count);
 
+/**
+ * @brief Tests whether the xpath of a data provide request selects the node in all instances
+ * of its parent list(s) at once, as it is sent to the data providers subscribed with ::NP_SUBSCR_DP_BULK option.
+ * @param [in] sch_node - schema node corresponding to the xpath
+ * @param [in] xpath
+ * @return result of the test
+ */
+bool rp_dt_is_bulk_dp_xpath(struct lys_node *sch_node, const char *xpath);
+
 #endif /* RP_DT_GET_H */
 
 /**
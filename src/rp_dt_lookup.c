@@ -26,6 +26,139 @@
 #include "rp_dt_xpath.h"
 #include "rp_dt_filter.h"
 
+#ifndef HAVE_LYD_FIND_SIBLING_VAL
+/**
+ * @brief Returns TRUE if the data node is an instance of the schema node of the step (with matching key values).
+ */
+static bool
+rp_dt_node_matches_step(const struct lyd_node *node, const dm_xpath_step_t *step)
+{
+    const struct lys_node_list *list = (const struct lys_node_list *) step->node;
+    const struct lyd_node *key = NULL;
+
+    if (node->schema != step->node) {
+        return false;
+    }
+    if (NULL == step->keys) {
+        return true;
+    }
+    /* keys are the first children of a list instance, in the order of the schema */
+    key = node->child;
+    for (size_t k = 0; k < list->keys_size; k++, key = key->next) {
+        if (NULL == key || key->schema != (struct lys_node *) list->keys[k] ||
+                0 != strcmp(((struct lyd_node_leaf_list *) key)->value_str, step->keys[k])) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+/**
+ * @brief Looks up the data node addressed by the simple xpath by walking the data tree
+ * along the steps of the resolved xpath. If libyang provides the lookup of list instances by keys,
+ * it is used (hashes of the children make it a constant-time operation except for the top-level nodes).
+ *
+ * @return TRUE if the result of the lookup is conclusive (the node is NULL if it does not exist),
+ * FALSE if the xpath engine must be used (key values need to be canonized).
+ */
+static bool
+rp_dt_find_node_by_steps(struct lyd_node *data_tree, const dm_xpath_entry_t *entry, struct lyd_node **found)
+{
+    struct lyd_node *node = data_tree;
+
+    *found = NULL;
+
+    /* absolute xpath, start from the first top-level node */
+    while (NULL != node->parent) {
+        node = node->parent;
+    }
+    while (NULL != node->prev->next) {
+        node = node->prev;
+    }
+
+    for (size_t i = 0; i < entry->step_cnt; i++) {
+        if (0 != i) {
+            node = node->child;
+            if (NULL == node) {
+                return true;
+            }
+        }
+#ifdef HAVE_LYD_FIND_SIBLING_VAL
+        struct lyd_node *match = NULL;
+        if (0 > lyd_find_sibling_val(node, entry->steps[i].node, entry->steps[i].predicates, &match)) {
+            return false;
+        }
+        node = match;
+#else
+        while (NULL != node && !rp_dt_node_matches_step(node, &entry->steps[i])) {
+            node = node->next;
+        }
+        if (NULL == node && !entry->keys_canonical) {
+            return false;
+        }
+#endif
+        if (NULL == node) {
+            return true;
+        }
+    }
+    *found = node;
+    return true;
+}
+
+/**
+ * @brief Tries to look up the nodes using the cached resolution of the xpath. Simple xpaths are looked up
+ * without the xpath engine. The schema info is only locked if it can be done without blocking, since
+ * the caller can hold its write lock (the schema can not change meanwhile as the data tree references it).
+ *
+ * @return SR_ERR_OK if the result is known, SR_ERR_NOT_FOUND if the xpath engine must be used.
+ */
+static int
+rp_dt_find_nodes_cached(const dm_ctx_t *dm_ctx, struct lyd_node *data_tree, const char *module_name, const char *xpath, struct ly_set **res)
+{
+    int rc = SR_ERR_OK;
+    dm_schema_info_t *si = NULL;
+    dm_xpath_entry_t *entry = NULL;
+    struct lyd_node *node = NULL;
+
+    if ('/' != xpath[0] || 0 == SR_XPATH_CACHE_SIZE) {
+        return SR_ERR_NOT_FOUND;
+    }
+
+    rc = dm_find_loaded_schema_info((dm_ctx_t *) dm_ctx, module_name, &si);
+    if (SR_ERR_OK != rc || si->ly_ctx != data_tree->schema->module->ctx) {
+        /* data tree created in a different context */
+        return SR_ERR_NOT_FOUND;
+    }
+
+    rc = dm_xpath_cache_get(si, xpath, &entry);
+    if (SR_ERR_NOT_FOUND == rc && 0 == pthread_rwlock_tryrdlock(&si->model_lock)) {
+        rc = NULL != si->ly_ctx ? rp_dt_resolve_xpath((dm_ctx_t *) dm_ctx, NULL, si, xpath, &entry) : SR_ERR_NOT_FOUND;
+        pthread_rwlock_unlock(&si->model_lock);
+    }
+    if (SR_ERR_OK != rc) {
+        /* not resolved, leave the reporting of errors to the xpath engine */
+        return SR_ERR_NOT_FOUND;
+    }
+
+    rc = SR_ERR_NOT_FOUND;
+    if (NULL != entry->steps && rp_dt_find_node_by_steps(data_tree, entry, &node)) {
+        *res = ly_set_new();
+        if (NULL == *res) {
+            SR_LOG_ERR_MSG("Unable to allocate memory for the set");
+            rc = SR_ERR_NOMEM;
+        } else if (NULL != node && 0 > ly_set_add(*res, node, LY_SET_OPT_USEASLIST)) {
+            ly_set_free(*res);
+            *res = NULL;
+            rc = SR_ERR_INTERNAL;
+        } else {
+            rc = SR_ERR_OK;
+        }
+    }
+    dm_xpath_cache_release(si, entry);
+    return rc;
+}
+
 int
 rp_dt_find_nodes(const dm_ctx_t *dm_ctx, struct lyd_node *data_tree, const char *xpath, bool check_enable, struct ly_set **nodes)
 {
@@ -40,17 +173,23 @@ rp_dt_find_nodes(const dm_ctx_t *dm_ctx, struct lyd_node *data_tree, const char
         sub = (struct lys_submodule *) data_tree->schema->module;
         CHECK_NULL_ARG3(sub, sub->belongsto, sub->belongsto->name);
     }
-    struct ly_set *res = lyd_find_path(data_tree, xpath);
-    if (NULL == res) {
-        SR_LOG_ERR_MSG("Lyd find path failed");
-        return LY_EINVAL == ly_errno || LY_EVALID == ly_errno ? SR_ERR_INVAL_ARG : SR_ERR_INTERNAL;
+    /* for submodule use the main module*/
+    const char *module_name = sub == NULL ? data_tree->schema->module->name : sub->belongsto->name;
+    struct ly_set *res = NULL;
+
+    rc = rp_dt_find_nodes_cached(dm_ctx, data_tree, module_name, xpath, &res);
+    if (SR_ERR_NOT_FOUND == rc) {
+        res = lyd_find_path(data_tree, xpath);
+        if (NULL == res) {
+            SR_LOG_ERR_MSG("Lyd find path failed");
+            return LY_EINVAL == ly_errno || LY_EVALID == ly_errno ? SR_ERR_INVAL_ARG : SR_ERR_INTERNAL;
+        }
+    } else if (SR_ERR_OK != rc) {
+        return rc;
     }
 
     if (check_enable) {
         /* lock ly_ctx_lock to schema_info_tree*/
-        /* for submodule lock the main module*/
-        const char *module_name = sub == NULL ? data_tree->schema->module->name : sub->belongsto->name;
-
         dm_schema_info_t *si = NULL;
         rc = dm_get_module_and_lock((dm_ctx_t *) dm_ctx, module_name, &si);
         if (rc != SR_ERR_OK) {
@@ -20,10 +20,16 @@
  */
 
 #include <pthread.h>
+#include <ctype.h>
 
 #include "rp_dt_xpath.h"
 #include "sr_common.h"
 
+/**
+ * @brief Maximum number of steps of an xpath that can be looked up without the xpath engine.
+ */
+#define RP_DT_SIMPLE_XPATH_MAX_DEPTH 32
+
 /**
  * @brief Creates xpath for the selected node.
  */
@@ -51,36 +57,234 @@ rp_dt_create_xpath_for_node(sr_mem_ctx_t *sr_mem, const struct lyd_node *node, c
 }
 
 /**
+ * @brief Parses an YANG identifier (optionally prefixed) at the current position of the xpath.
  *
- * @brief Function tries to validate the xpath and to find the corresponding
- * node in schema if possible.
- *
- * @note Function expects that a schema info is locked for reading.
- *
- * @param [in] dm_ctx
- * @param [in] session
- * @param [in] schema_info
- * @param [in] xpath
- * @param [out] match
- * @return Error code (SR_ERR_OK on success)
+ * @return FALSE if there is no identifier at the position.
+ */
+static bool
+rp_dt_xpath_parse_name(const char **cur, const char **prefix, size_t *prefix_len, const char **name, size_t *name_len)
+{
+    const char *p = *cur;
+    const char *id = NULL;
+
+    *prefix = NULL;
+    *prefix_len = 0;
+    for (int i = 0; i < 2; i++) {
+        if (!isalpha((unsigned char) *p) && '_' != *p) {
+            return false;
+        }
+        id = p;
+        while (isalnum((unsigned char) *p) || '_' == *p || '-' == *p || '.' == *p) {
+            p++;
+        }
+        if (0 == i && ':' == *p) {
+            *prefix = id;
+            *prefix_len = p - id;
+            p++;
+        } else {
+            break;
+        }
+    }
+    *name = id;
+    *name_len = p - id;
+    *cur = p;
+    return true;
+}
+
+/**
+ * @brief Returns TRUE if the identifier matches the zero-terminated string.
+ */
+static bool
+rp_dt_xpath_name_eq(const char *name, size_t name_len, const char *str)
+{
+    return 0 == strncmp(name, str, name_len) && '\0' == str[name_len];
+}
+
+/**
+ * @brief Parses the key predicates of a list step, all keys must be listed exactly once
+ * (otherwise the step is not simple).
  */
 static int
-rp_dt_validate_node_xpath_internal(dm_ctx_t *dm_ctx, dm_session_t *session, dm_schema_info_t *schema_info, const char *xpath, struct lys_node **match)
+rp_dt_xpath_parse_keys(const char **cur, const struct lys_node_list *list, dm_xpath_step_t *step, bool *simple, bool *canonical)
 {
-    CHECK_NULL_ARG3(dm_ctx, xpath, schema_info); /* match can be NULL */
+    const char *p = *cur;
+    const char *prefix = NULL, *name = NULL, *value = NULL;
+    size_t prefix_len = 0, name_len = 0;
+    char quote = 0;
+    size_t k = 0, len = 0;
+
+    *simple = false;
+    step->keys = calloc(list->keys_size + 1, sizeof *step->keys);
+    CHECK_NULL_NOMEM_RETURN(step->keys);
+    step->key_cnt = list->keys_size;
+
+    for (size_t i = 0; i < list->keys_size; i++) {
+        if ('[' != *p++) {
+            return SR_ERR_OK;
+        }
+        while (isspace((unsigned char) *p)) {
+            p++;
+        }
+        if (!rp_dt_xpath_parse_name(&p, &prefix, &prefix_len, &name, &name_len)) {
+            return SR_ERR_OK;
+        }
+        if (NULL != prefix && !rp_dt_xpath_name_eq(prefix, prefix_len, lys_node_module((struct lys_node *) list)->name)) {
+            return SR_ERR_OK;
+        }
+        k = 0;
+        while (k < list->keys_size && !rp_dt_xpath_name_eq(name, name_len, list->keys[k]->name)) {
+            k++;
+        }
+        if (k == list->keys_size || NULL != step->keys[k]) {
+            return SR_ERR_OK;
+        }
+        while (isspace((unsigned char) *p)) {
+            p++;
+        }
+        if ('=' != *p++) {
+            return SR_ERR_OK;
+        }
+        while (isspace((unsigned char) *p)) {
+            p++;
+        }
+        quote = *p++;
+        if ('\'' != quote && '"' != quote) {
+            return SR_ERR_OK;
+        }
+        value = p;
+        while ('\0' != *p && quote != *p && '\\' != *p) {
+            p++;
+        }
+        if (quote != *p) {
+            return SR_ERR_OK;
+        }
+        step->keys[k] = strndup(value, p - value);
+        CHECK_NULL_NOMEM_RETURN(step->keys[k]);
+        p++;
+        while (isspace((unsigned char) *p)) {
+            p++;
+        }
+        if (']' != *p++) {
+            return SR_ERR_OK;
+        }
+        if (LY_TYPE_STRING != list->keys[k]->type.base) {
+            /* the value in the data tree is canonical, the one in the xpath need not be */
+            *canonical = false;
+        }
+    }
+
+    /* the same predicates with the keys ordered as in schema */
+    for (k = 0; k < list->keys_size; k++) {
+        len += strlen(list->keys[k]->name) + strlen(step->keys[k]) + 5;
+    }
+    step->predicates = malloc(len + 1);
+    CHECK_NULL_NOMEM_RETURN(step->predicates);
+    len = 0;
+    for (k = 0; k < list->keys_size; k++) {
+        quote = NULL != strchr(step->keys[k], '\'') ? '"' : '\'';
+        len += sprintf(step->predicates + len, "[%s=%c%s%c]", list->keys[k]->name, quote, step->keys[k], quote);
+    }
+
+    *cur = p;
+    *simple = true;
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Splits the xpath into steps if it is a simple one - an absolute path of containers,
+ * leaves and lists with values of all their keys. Data nodes addressed by such xpaths
+ * can be looked up by walking the data tree, without evaluating the xpath.
+ */
+static int
+rp_dt_xpath_simple_steps(const char *xpath, dm_xpath_entry_t *entry)
+{
+    const struct lys_node *nodes[RP_DT_SIMPLE_XPATH_MAX_DEPTH];
+    const struct lys_node *n = NULL;
+    const struct lys_module *module = NULL;
+    const char *p = xpath, *prefix = NULL, *name = NULL;
+    size_t prefix_len = 0, name_len = 0;
+    size_t cnt = 0;
+    bool canonical = true, simple = true;
+    int rc = SR_ERR_OK;
+
+    for (n = entry->node; NULL != n && simple; n = lys_parent(n)) {
+        if ((LYS_USES | LYS_CHOICE | LYS_CASE) & n->nodetype) {
+            continue;
+        }
+        if (!((LYS_CONTAINER | LYS_LIST | LYS_LEAF) & n->nodetype) || cnt == RP_DT_SIMPLE_XPATH_MAX_DEPTH ||
+                (LYS_LIST == n->nodetype && 0 == ((struct lys_node_list *) n)->keys_size)) {
+            simple = false;
+        } else {
+            nodes[cnt++] = n;
+        }
+    }
+    if (!simple || 0 == cnt) {
+        return SR_ERR_OK;
+    }
+
+    entry->steps = calloc(cnt, sizeof *entry->steps);
+    CHECK_NULL_NOMEM_RETURN(entry->steps);
+    entry->step_cnt = cnt;
+
+    for (size_t i = 0; i < cnt && simple; i++) {
+        n = nodes[cnt - i - 1];
+        entry->steps[i].node = n;
+        simple = '/' == *p++ && rp_dt_xpath_parse_name(&p, &prefix, &prefix_len, &name, &name_len) &&
+                rp_dt_xpath_name_eq(name, name_len, n->name);
+        if (simple && NULL != prefix) {
+            module = lys_node_module((struct lys_node *) n);
+            simple = rp_dt_xpath_name_eq(prefix, prefix_len, module->name);
+        } else if (simple) {
+            /* unprefixed nodes belong to the module of the previous step */
+            simple = NULL != module && module == lys_node_module((struct lys_node *) n);
+        }
+        if (simple && LYS_LIST == n->nodetype) {
+            rc = rp_dt_xpath_parse_keys(&p, (const struct lys_node_list *) n, &entry->steps[i], &simple, &canonical);
+            if (SR_ERR_OK != rc) {
+                simple = false;
+            }
+        }
+    }
+    if (simple && '\0' != *p) {
+        simple = false;
+    }
+
+    if (simple) {
+        entry->keys_canonical = canonical;
+    } else {
+        for (size_t i = 0; i < cnt; i++) {
+            for (size_t k = 0; NULL != entry->steps[i].keys && k < entry->steps[i].key_cnt; k++) {
+                free(entry->steps[i].keys[k]);
+            }
+            free(entry->steps[i].keys);
+            free(entry->steps[i].predicates);
+        }
+        free(entry->steps);
+        entry->steps = NULL;
+        entry->step_cnt = 0;
+    }
+    return rc;
+}
+
+int
+rp_dt_resolve_xpath(dm_ctx_t *dm_ctx, dm_session_t *session, dm_schema_info_t *schema_info, const char *xpath, dm_xpath_entry_t **entry)
+{
+    CHECK_NULL_ARG4(dm_ctx, xpath, schema_info, entry);
     int rc = SR_ERR_OK;
 
     char *namespace = NULL;
     const struct lys_module *module = NULL;
     struct ly_set *set = NULL;
+    dm_xpath_entry_t *new_entry = NULL;
+
+    rc = dm_xpath_cache_get(schema_info, xpath, entry);
+    if (SR_ERR_OK == rc) {
+        return rc;
+    }
 
     rc = sr_copy_first_ns(xpath, &namespace);
     CHECK_RC_MSG_RETURN(rc, "Namespace copy failed");
 
-    if (NULL != match) {
-        *match = NULL;
-    }
-
     module = ly_ctx_get_module(schema_info->ly_ctx, namespace, NULL, 1);
     if (NULL == module) {
         if (NULL != session) {
@@ -100,10 +304,60 @@ rp_dt_validate_node_xpath_internal(dm_ctx_t *dm_ctx, dm_session_t *session, dm_s
         return rc;
     }
 
-    if (match && set->number == 1) {
-        *match = set->set.s[0];
+    new_entry = calloc(1, sizeof *new_entry);
+    CHECK_NULL_NOMEM_GOTO(new_entry, rc, cleanup);
+    new_entry->xpath = strdup(xpath);
+    CHECK_NULL_NOMEM_GOTO(new_entry->xpath, rc, cleanup);
+    new_entry->module = module;
+    if (1 == set->number) {
+        new_entry->node = set->set.s[0];
+        rc = rp_dt_xpath_simple_steps(xpath, new_entry);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to split xpath into steps");
     }
+
+    rc = dm_xpath_cache_add(schema_info, new_entry, entry);
+    new_entry = NULL;
+
+cleanup:
+    dm_xpath_entry_free(new_entry);
     ly_set_free(set);
+    return rc;
+}
+
+/**
+ *
+ * @brief Function tries to validate the xpath and to find the corresponding
+ * node in schema if possible.
+ *
+ * @note Function expects that a schema info is locked for reading.
+ *
+ * @param [in] dm_ctx
+ * @param [in] session
+ * @param [in] schema_info
+ * @param [in] xpath
+ * @param [out] match
+ * @return Error code (SR_ERR_OK on success)
+ */
+static int
+rp_dt_validate_node_xpath_internal(dm_ctx_t *dm_ctx, dm_session_t *session, dm_schema_info_t *schema_info, const char *xpath, struct lys_node **match)
+{
+    CHECK_NULL_ARG3(dm_ctx, xpath, schema_info); /* match can be NULL */
+    int rc = SR_ERR_OK;
+    dm_xpath_entry_t *entry = NULL;
+
+    if (NULL != match) {
+        *match = NULL;
+    }
+
+    rc = rp_dt_resolve_xpath(dm_ctx, session, schema_info, xpath, &entry);
+    if (SR_ERR_OK != rc) {
+        return rc;
+    }
+
+    if (NULL != match) {
+        *match = entry->node;
+    }
+    dm_xpath_cache_release(schema_info, entry);
 
     return rc;
 }
@@ -56,6 +56,21 @@ int rp_dt_create_xpath_for_node(sr_mem_ctx_t *sr_mem, const struct lyd_node *nod
  */
 int rp_dt_enable_xpath(dm_ctx_t *dm_ctx, dm_session_t *session, dm_schema_info_t *schema_info, const char *xpath);
 
+/**
+ * @brief Resolves the xpath in the context of the schema info. Resolved xpaths are cached
+ * in the schema info, so repeated requests with the same xpath skip the schema lookup.
+ *
+ * @note Function expects that a schema info is locked for reading.
+ *
+ * @param [in] dm_ctx
+ * @param [in] session Session where the errors are reported, can be NULL.
+ * @param [in] schema_info
+ * @param [in] xpath
+ * @param [out] entry Resolved xpath, must be released by ::dm_xpath_cache_release.
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dt_resolve_xpath(dm_ctx_t *dm_ctx, dm_session_t *session, dm_schema_info_t *schema_info, const char *xpath, dm_xpath_entry_t **entry);
+
 /**
  *
  * @brief
@@ -28,8 +28,6 @@
 #include "notification_processor.h"
 #include "persistence_manager.h"
 
-#define RP_THREAD_COUNT 4  /**< Number of threads that RP uses for processing. */
-
 /**
  * @brief Structure that holds the context of an instance of Request Processor.
  */
@@ -40,18 +38,19 @@ typedef struct rp_ctx_s {
     np_ctx_t *np_ctx;                        /**< Notification Processor context. */
     pm_ctx_t *pm_ctx;                        /**< Persistence Manager context. */
 
-    pthread_t thread_pool[RP_THREAD_COUNT];  /**< Thread pool. */
-    size_t active_threads;                   /**< Number of active (non-sleeping) threads. */
+    pthread_t *thread_pool;                  /**< Thread pool. */
+    size_t thread_count;                     /**< Number of threads in the thread pool. */
+    size_t active_threads;                   /**< Number of active (non-sleeping) threads (accessed atomically). */
     struct timespec last_thread_wakeup;      /**< Timestamp of the last thread wake-up event. */
-    size_t thread_spin_limit;                /**< Current limit of thread spinning before going to sleep. */
+    size_t thread_spin_limit;                /**< Current limit of thread spinning before going to sleep (accessed atomically). */
     bool stop_requested;                     /**< Stopping of all threads has been requested. */
 
     bool block_further_commits;              /**< Flag that allows commit to be processed */
     pthread_mutex_t commit_block_mutex;      /**< Mutex guarding block_further_commits flag */
 
-    sr_cbuff_t *request_queue;               /**< Input request queue. */
-    pthread_mutex_t request_queue_mutex;     /**< Request queue mutex. */
-    pthread_cond_t request_queue_cv;         /**< Request queue condition variable. */
+    sr_mpmc_queue_t *request_queue;          /**< Input request queue (lock-free). */
+    pthread_mutex_t request_queue_mutex;     /**< Mutex used for putting worker threads to sleep and waking them up. */
+    pthread_cond_t request_queue_cv;         /**< Condition variable used for putting worker threads to sleep and waking them up. */
 
     sr_list_t *modules_incl_intern_op_data;  /**< List of modules that contains state data that is handled internally in sysrepo
                                               *   and requests are not send to a subscriber */
@@ -59,15 +58,40 @@ typedef struct rp_ctx_s {
 
     pthread_rwlock_t commit_lock;            /**< Lock to synchronize commit in this instance */
     bool do_not_generate_config_change;      /**< Config-change notification will not be generated */
+
+    sr_btree_t *dp_cache;                    /**< Operational data cached for data providers with cache TTL (::rp_dp_cache_entry_t) */
+    sr_btree_t *dp_cache_expiry;             /**< Entries of the operational data cache ordered by their expiration (not owned) */
+    pthread_mutex_t dp_cache_mutex;          /**< Mutex guarding the operational data cache */
 } rp_ctx_t;
 
 /**
- * @brief Cache structure that holds the state of the last get_item_iter call.
+ * @brief Operational data provided by a data provider subscription for a requested xpath,
+ * kept in ::rp_ctx_t::dp_cache until expiration.
+ */
+typedef struct rp_dp_cache_entry_s {
+    char *dst_address;                       /**< Destination address of the data provider subscription. */
+    uint32_t dst_id;                         /**< Destination ID of the data provider subscription. */
+    char *xpath;                             /**< Xpath that has been requested from the data provider. */
+    sr_val_t *values;                        /**< Values returned by the data provider. */
+    size_t values_cnt;                       /**< Number of values. */
+    struct timespec expires;                 /**< Time (CLOCK_MONOTONIC) when the entry expires. */
+} rp_dp_cache_entry_t;
+
+/**
+ * @brief Server-side cursor of a get_items_iter iteration. Holds the nodes matching the xpath
+ * (already filtered by NACM) within an immutable snapshot of the data tree, so that the pages
+ * are returned without evaluating the xpath again.
  */
 typedef struct rp_dt_get_items_ctx {
-    char *xpath;            /**< xpath of the request*/
-    size_t offset;          /**< index of the node to be processed */
-    struct ly_set *nodes;   /**< nodes to be iterated through */
+    uint32_t id;                        /**< handle of the cursor passed to the client, 0 for iterations of clients
+                                             that do not use the handles (continued by xpath and offset) */
+    char *xpath;                        /**< xpath of the request*/
+    size_t offset;                      /**< index of the node to be processed */
+    struct ly_set *nodes;               /**< nodes to be iterated through */
+    size_t page_size;                   /**< number of nodes returned by the next page (grows with each page) */
+    dm_schema_info_t *schema_info;      /**< schema info of the module the snapshot belongs to */
+    dm_data_snapshot_t *snapshot;       /**< snapshot of the data tree holding the nodes */
+    struct timespec last_used;          /**< time (CLOCK_MONOTONIC) of the last request of the cursor */
 } rp_dt_get_items_ctx_t;
 
 /**
@@ -90,6 +114,7 @@ typedef enum rp_request_state_e {
     RP_REQ_DATA_LOADED,                 /**< Respones for all state data request were received */
     RP_REQ_WAITING_FOR_VERIFIERS,       /**< Request is waiting for replies from verifiers */
     RP_REQ_RESUMED,                     /**< Replies from verifiers were received or timeout expired */
+    RP_REQ_WAITING_FOR_SUBSCRIBER,      /**< Request is waiting for the subscriber to receive the data already sent to it */
     RP_REQ_FINISHED                     /**< Request processing finished, request can be freed */
 } rp_request_state_t;
 
@@ -102,6 +127,7 @@ typedef struct rp_state_data_ctx_s {
     sr_list_t *subtree_nodes;          /**< List of schema nodes corresponding to state data subtrees */
     sr_list_t *subscription_nodes;     /**< Schema node corresponding to the subscriptions */
     sr_list_t *requested_xpaths;       /**< List of xpath that has been requested and response has not been processed yet */
+    sr_list_t *requested_subscriptions;/**< Subscriptions the xpaths in requested_xpaths have been requested from (same order) */
     bool overlapping_leaf_subscription;/**< Flags signalizing that ther is a subscription for leaf or leaf-list under a container or a list */
     size_t internal_state_data_index;   /**< Index to the module of internal state data structures in rp_ctx */
     bool internal_state_data;          /**< Request contains internally handled state data */
@@ -117,11 +143,15 @@ typedef struct rp_session_s {
     uint32_t options;                    /**< Session options used to override default session behavior. */
     uint32_t commit_id;                  /**< Commit ID in case that this is a notification session or session is about to resume commit processing. */
     uint32_t msg_count;                  /**< Count of unprocessed messages (including waiting in queue). */
-    pthread_mutex_t msg_count_mutex;     /**< Mutex for msg_count counter. */
+    pthread_mutex_t msg_count_mutex;     /**< Mutex for msg_count counter and the run-queue of the session. */
+    sr_cbuff_t *req_queue;               /**< Run-queue of requests postponed until the request in progress is finished. */
+    bool req_in_progress;                /**< A request of the session is being processed or is paused. */
     bool stop_requested;                 /**< Session stop has been requested. */
     ac_session_t *ac_session;            /**< Access Control module's session context. */
     dm_session_t *dm_session;            /**< Data Manager's session context. */
-    rp_dt_get_items_ctx_t get_items_ctx; /**< Context for get_items_iter calls. */
+    sr_list_t *get_items_cursors;        /**< Cursors of get_items_iter calls (rp_dt_get_items_ctx_t), most recently used last. */
+    uint32_t last_cursor_id;             /**< Handle of the most recently opened cursor. */
+    bool cursor_timer_pending;           /**< A request closing the idle cursors is scheduled (guarded by cur_req_mutex). */
     rp_dt_change_ctx_t change_ctx;       /**< Context for iteration over the changes */
 
     /* request ID generator */
@@ -136,6 +166,7 @@ typedef struct rp_session_s {
     pthread_mutex_t cur_req_mutex;       /**< mutex guarding information about currently processed request */
     sr_list_t **loaded_state_data;       /**< List of xpath for loaded state data in datastore */
     rp_state_data_ctx_t state_data_ctx;  /**< Context used during state data loading */
+    np_ev_notif_reader_t *replay_reader; /**< Reader of stored notifications used by the event notification replay in progress */
 } rp_session_t;
 
 #endif /* RP_INTERNAL_H_ */
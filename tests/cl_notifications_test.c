@@ -27,9 +27,12 @@
 #include <cmocka.h>
 #include <string.h>
 #include <pthread.h>
+#include <errno.h>
+#include <time.h>
 
 #include "sysrepo.h"
 #include "client_library.h"
+#include "connection_manager.h"
 
 #include "sr_common.h"
 #include "test_module_helper.h"
@@ -1093,6 +1096,71 @@ cl_notif_priority_test(void **state)
     sr_session_stop(session);
 }
 
+typedef struct parallel_s {
+    int running;
+    int max_running;
+    int v_count;
+}parallel_t;
+
+static int
+parallel_verify_cb(sr_session_ctx_t *session, const char *module_name, sr_notif_event_t ev, void *private_ctx)
+{
+    parallel_t *par = (parallel_t *) private_ctx;
+    int running = 0, max = 0;
+
+    if (SR_EV_VERIFY == ev) {
+        running = __atomic_add_fetch(&par->running, 1, __ATOMIC_SEQ_CST);
+        max = __atomic_load_n(&par->max_running, __ATOMIC_SEQ_CST);
+        while (running > max && !__atomic_compare_exchange_n(&par->max_running, &max, running, false,
+                __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST));
+        usleep(500000); /* 500 ms */
+        __atomic_sub_fetch(&par->running, 1, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&par->v_count, 1, __ATOMIC_SEQ_CST);
+    }
+    return SR_ERR_OK;
+}
+
+static void
+cl_notif_parallel_verifiers_test(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL;
+    sr_subscription_ctx_t *subscription = NULL;
+    parallel_t parallel = {0};
+    int rc = SR_ERR_OK;
+
+    /* callbacks are called from worker threads only if requested, the pool is created with the first subscription */
+    setenv("SR_SUBSCR_THREADS", "4", 1);
+
+    /* start session */
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* verifiers with the same priority */
+    rc = sr_module_change_subscribe(session, "test-module", parallel_verify_cb, &parallel,
+            0, SR_SUBSCR_DEFAULT, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_subtree_change_subscribe(session, "/test-module:user", parallel_verify_cb, &parallel,
+            0, SR_SUBSCR_DEFAULT | SR_SUBSCR_CTX_REUSE, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_set_item(session, "/test-module:user[name='userA']", NULL, SR_EDIT_DEFAULT);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_commit(session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* both verifiers have been called at the same time */
+    assert_int_equal(parallel.v_count, 2);
+    assert_int_equal(parallel.max_running, 2);
+
+    sr_unsubscribe(session, subscription);
+    sr_session_stop(session);
+    unsetenv("SR_SUBSCR_THREADS");
+}
+
 int
 cl_whole_module_cb(sr_session_ctx_t *session, const char *module_name, sr_notif_event_t ev, void *private_ctx)
 {
@@ -1217,6 +1285,80 @@ cl_whole_module_changes(void **state)
     sr_session_stop(session);
 }
 
+static void
+cl_whole_module_changes_inline(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL;
+    sr_subscription_ctx_t *subscription = NULL;
+    changes_t changes = {.mutex = PTHREAD_MUTEX_INITIALIZER, .cv = PTHREAD_COND_INITIALIZER, 0};
+    struct timespec ts;
+    int rc = SR_ERR_OK;
+
+    /* start session */
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_module_change_subscribe(session, "test-module", cl_whole_module_cb, &changes,
+            0, SR_SUBSCR_CHANGES_INLINE, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+
+    sr_val_t v = {0};
+    v.type = SR_UINT8_T;
+    v.data.uint8_val = 19;
+
+    rc = sr_set_item(session, "/test-module:main/ui8", &v, SR_EDIT_DEFAULT);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_set_item(session, "/test-module:user[name='userA']", NULL, SR_EDIT_DEFAULT);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    pthread_mutex_lock(&changes.mutex);
+    rc = sr_commit(session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    sr_clock_get_time(CLOCK_REALTIME, &ts);
+    ts.tv_sec += COND_WAIT_SEC;
+    pthread_cond_timedwait(&changes.cv, &changes.mutex, &ts);
+
+    /* changes delivered within the notification are the same as those requested from sysrepo */
+    assert_int_equal(changes.cnt, 4);
+
+    assert_int_equal(changes.oper[0], SR_OP_MODIFIED);
+    assert_non_null(changes.new_values[0]);
+    assert_non_null(changes.old_values[0]);
+    assert_string_equal("/test-module:main/ui8", changes.new_values[0]->xpath);
+
+    assert_int_equal(changes.oper[1], SR_OP_CREATED);
+    assert_non_null(changes.new_values[1]);
+    assert_null(changes.old_values[1]);
+    assert_string_equal("/test-module:user[name='userA']", changes.new_values[1]->xpath);
+
+    assert_int_equal(changes.oper[2], SR_OP_CREATED);
+    assert_non_null(changes.new_values[2]);
+    assert_null(changes.old_values[2]);
+    assert_string_equal("/test-module:user[name='userA']/name", changes.new_values[2]->xpath);
+
+    assert_int_equal(changes.oper[3], SR_OP_MOVED);
+    assert_non_null(changes.new_values[3]);
+    assert_null(changes.old_values[3]);
+    assert_string_equal("/test-module:user[name='userA']", changes.new_values[3]->xpath);
+
+    for (size_t i = 0; i < changes.cnt; i++) {
+        sr_free_val(changes.new_values[i]);
+        sr_free_val(changes.old_values[i]);
+    }
+    pthread_mutex_unlock(&changes.mutex);
+
+    pthread_mutex_destroy(&changes.mutex);
+    pthread_cond_destroy(&changes.cv);
+
+    sr_unsubscribe(session, subscription);
+    sr_session_stop(session);
+}
+
 int
 cl_invalid_change_xpath_cb(sr_session_ctx_t *session, const char *module_name, sr_notif_event_t ev, void *private_ctx)
 {
@@ -2875,6 +3017,135 @@ cl_config_change_replay_test(void **state)
     assert_int_equal(rc, SR_ERR_OK);
 }
 
+#define REPLAY_NOTIF_COUNT 1000       /**< Number of stored notifications, several times the output buffer high watermark. */
+#define REPLAY_INTERFACE_LEN 1000     /**< Length of the interface names making the notifications large. */
+
+/**
+ * @brief State of the slow subscriber of the replay backpressure test.
+ */
+typedef struct replay_backpressure_s {
+    pthread_mutex_t mutex;
+    pthread_cond_t cv;
+    cm_ctx_t *cm_ctx;          /**< Local Connection Manager context. */
+    size_t pause_base;         /**< Number of replay pauses counted before the test. */
+    size_t received_cnt;       /**< Number of replayed notifications received in order. */
+    bool complete;             /**< Replay-complete has been received. */
+    bool out_of_order;         /**< A notification has been lost, duplicated or reordered. */
+} replay_backpressure_t;
+
+static void
+replay_backpressure_cb(const sr_ev_notif_type_t notif_type, const char *xpath, const sr_val_t *values,
+        const size_t values_cnt, time_t timestamp, void *private_ctx)
+{
+    replay_backpressure_t *rb = (replay_backpressure_t *) private_ctx;
+    unsigned int hi = 0, lo = 0;
+
+    pthread_mutex_lock(&rb->mutex);
+    if (SR_EV_NOTIF_T_REPLAY == notif_type) {
+        if (0 == rb->received_cnt) {
+            /* do not read anything more until the replay is paused */
+            for (size_t i = 0; i < 100 * COND_WAIT_SEC && rb->pause_base == cm_get_replay_pause_count(rb->cm_ctx); i++) {
+                usleep(10000);
+            }
+        }
+        for (size_t i = 0; i < values_cnt; i++) {
+            if (0 == strcmp("/test-module:link-removed/destination/address", values[i].xpath) &&
+                    0 != strcmp("10.255.0.16", values[i].data.string_val)) {
+                /* stored by another test */
+                pthread_mutex_unlock(&rb->mutex);
+                return;
+            }
+        }
+        for (size_t i = 0; i < values_cnt; i++) {
+            if (0 == strcmp("/test-module:link-removed/source/address", values[i].xpath)) {
+                if (2 != sscanf(values[i].data.string_val, "10.0.%u.%u", &hi, &lo) ||
+                        rb->received_cnt != hi * 256 + lo) {
+                    rb->out_of_order = true;
+                }
+            }
+        }
+        rb->received_cnt++;
+    } else if (SR_EV_NOTIF_T_REPLAY_COMPLETE == notif_type) {
+        rb->complete = true;
+        pthread_cond_broadcast(&rb->cv);
+    }
+    pthread_mutex_unlock(&rb->mutex);
+}
+
+static void
+cl_event_notif_replay_backpressure_test(void **state)
+{
+#ifndef ENABLE_NOTIF_STORE
+    skip();
+#else
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL;
+    sr_subscription_ctx_t *subscription = NULL;
+    replay_backpressure_t rb = {.mutex = PTHREAD_MUTEX_INITIALIZER, .cv = PTHREAD_COND_INITIALIZER, 0};
+    char interface[REPLAY_INTERFACE_LEN + 1] = { 0, }, address[20] = { 0, };
+    sr_val_t values[4];
+    struct timespec ts;
+    time_t start_time = time(NULL);
+    int rc = SR_ERR_OK;
+
+    skip_if_daemon_running(); /* replay pauses are counted by the local Connection Manager */
+
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* store the notifications */
+    memset(interface, 'e', REPLAY_INTERFACE_LEN);
+    memset(&values, 0, sizeof(values));
+    values[0].xpath = "/test-module:link-removed/source/address";
+    values[0].type = SR_STRING_T;
+    values[0].data.string_val = address;
+    values[1].xpath = "/test-module:link-removed/source/interface";
+    values[1].type = SR_STRING_T;
+    values[1].data.string_val = interface;
+    values[2].xpath = "/test-module:link-removed/destination/address";
+    values[2].type = SR_STRING_T;
+    values[2].data.string_val = "10.255.0.16";
+    values[3].xpath = "/test-module:link-removed/destination/interface";
+    values[3].type = SR_STRING_T;
+    values[3].data.string_val = interface;
+    for (size_t i = 0; i < REPLAY_NOTIF_COUNT; i++) {
+        snprintf(address, sizeof(address), "10.0.%zu.%zu", i / 256, i % 256);
+        rc = sr_event_notif_send(session, "/test-module:link-removed", values, 4, SR_EV_NOTIF_DEFAULT);
+        assert_int_equal(rc, SR_ERR_OK);
+    }
+
+    /* the subscriber does not read until the replay is paused */
+    rb.cm_ctx = cl_local_cm_ctx_get();
+    rb.pause_base = cm_get_replay_pause_count(rb.cm_ctx);
+
+    rc = sr_event_notif_subscribe(session, "/test-module:link-removed", replay_backpressure_cb,
+            &rb, SR_SUBSCR_NOTIF_REPLAY_FIRST, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = sr_event_notif_replay(session, subscription, start_time, 0);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* the replay is resumed once the subscriber drains the output buffer */
+    pthread_mutex_lock(&rb.mutex);
+    sr_clock_get_time(CLOCK_REALTIME, &ts);
+    ts.tv_sec += 6 * COND_WAIT_SEC;
+    while (!rb.complete && ETIMEDOUT != pthread_cond_timedwait(&rb.cv, &rb.mutex, &ts));
+    assert_true(cm_get_replay_pause_count(rb.cm_ctx) > rb.pause_base);
+    assert_true(rb.complete);
+    assert_false(rb.out_of_order);
+    assert_int_equal(REPLAY_NOTIF_COUNT, rb.received_cnt);
+    pthread_mutex_unlock(&rb.mutex);
+
+    rc = sr_unsubscribe(session, subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = sr_session_stop(session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    pthread_mutex_destroy(&rb.mutex);
+    pthread_cond_destroy(&rb.cv);
+#endif
+}
+
 int
 main()
 {
@@ -2887,7 +3158,9 @@ main()
         cmocka_unit_test_setup_teardown(cl_get_changes_create_default_test, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_get_changes_parents_test, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_notif_priority_test, sysrepo_setup, sysrepo_teardown),
+        cmocka_unit_test_setup_teardown(cl_notif_parallel_verifiers_test, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_whole_module_changes, sysrepo_setup, sysrepo_teardown),
+        cmocka_unit_test_setup_teardown(cl_whole_module_changes_inline, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_invalid_xpath_test, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_children_subscription_test, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_subscribe_top_level_mandatory, sysrepo_setup, sysrepo_teardown),
@@ -2909,6 +3182,7 @@ main()
         cmocka_unit_test_setup_teardown(cl_config_change_notif_test, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_read_old_config_in_verify_test, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_config_change_replay_test, sysrepo_setup, sysrepo_teardown),
+        cmocka_unit_test_setup_teardown(cl_event_notif_replay_backpressure_test, sysrepo_setup, sysrepo_teardown),
     };
 
     watchdog_start(300);
@@ -740,6 +740,36 @@ cl_dp_card_state(const char *xpath, sr_val_t **values, size_t *values_cnt, void
     return SR_ERR_OK;
 }
 
+static int
+cl_dp_card_state_bulk(const char *xpath, sr_val_t **values, size_t *values_cnt, void *private_ctx)
+{
+    /* card ghi is not configured, its state must not create it */
+    const char *cards[] = {"abc", "def", "ghi"};
+    sr_val_t *v = NULL;
+    int rc = SR_ERR_OK;
+
+    sr_list_t *l = (sr_list_t *) private_ctx;
+    if (0 != sr_list_add(l, strdup(xpath))) {
+        SR_LOG_ERR_MSG("Error while adding into list");
+    }
+
+    /* state of all cards is provided at once */
+    rc = sr_new_values(3, &v);
+    if (SR_ERR_OK != rc) {
+        return rc;
+    }
+
+    for (size_t i = 0; i < 3; i++) {
+        sr_val_build_xpath(&v[i], "/state-module:cards/card[dn='%s']/state/c_state", cards[i]);
+        sr_val_set_str_data(&v[i], SR_STRING_T, "OK");
+    }
+
+    *values = v;
+    *values_cnt = 3;
+
+    return SR_ERR_OK;
+}
+
 
 static void
 cl_parent_subscription(void **state)
@@ -996,6 +1026,65 @@ cl_parent_subscription_tree(void **state)
     sr_session_stop(session);
 }
 
+static void
+cl_dp_cache_subscription(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL, *session2 = NULL;
+    sr_subscription_ctx_t *subscription = NULL;
+    sr_list_t *xpath_retrieved = NULL;
+    sr_val_t *value = NULL;
+    int rc = SR_ERR_OK;
+
+    rc = sr_list_init(&xpath_retrieved);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* start sessions */
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &session2);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_module_change_subscribe(session, "state-module", cl_whole_module_cb, NULL,
+            0, SR_SUBSCR_DEFAULT, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* subscribe data provider allowing to cache the data for 1 second */
+    rc = sr_dp_get_items_subscribe_cached(session, "/state-module:cpu_load", cl_dp_cpu_load, xpath_retrieved,
+            1000, SR_SUBSCR_CTX_REUSE, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* repeated requests from both sessions are served by a single call of the provider */
+    for (size_t i = 0; i < 4; i++) {
+        rc = sr_get_item((i % 2) ? session2 : session, "/state-module:cpu_load", &value);
+        assert_int_equal(rc, SR_ERR_OK);
+        assert_non_null(value);
+        assert_int_equal(SR_DECIMAL64_T, value->type);
+        assert_true(75.25 == value->data.decimal64_val);
+        sr_free_val(value);
+    }
+    assert_int_equal(1, xpath_retrieved->count);
+
+    /* the provider is asked again once the cached data expire */
+    sleep(2);
+    rc = sr_get_item(session2, "/state-module:cpu_load", &value);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_non_null(value);
+    sr_free_val(value);
+    assert_int_equal(2, xpath_retrieved->count);
+
+    /* cleanup */
+    sr_unsubscribe(session, subscription);
+    sr_session_stop(session2);
+    sr_session_stop(session);
+
+    for (size_t i = 0; i < xpath_retrieved->count; i++) {
+        free(xpath_retrieved->data[i]);
+    }
+    sr_list_cleanup(xpath_retrieved);
+}
+
 static void
 cl_exact_match_subscription(void **state)
 {
@@ -3052,6 +3141,87 @@ cl_state_data_in_grouping(void **state)
 
 }
 
+static void
+cl_dp_bulk_subscription(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL;
+    sr_subscription_ctx_t *subscription = NULL;
+    sr_list_t *xpath_retrieved = NULL;
+    sr_val_t *values = NULL, *value = NULL;
+    size_t cnt = 0;
+    int rc = SR_ERR_OK;
+
+    rc = sr_list_init(&xpath_retrieved);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* start session */
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_module_change_subscribe(session, "state-module", cl_whole_module_cb, NULL,
+            0, SR_SUBSCR_DEFAULT, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* subscribe data provider able to provide state of all cards at once */
+    rc = sr_dp_get_items_subscribe(session, "/state-module:cards/card/state", cl_dp_card_state_bulk, xpath_retrieved,
+            SR_SUBSCR_CTX_REUSE | SR_SUBSCR_DP_BULK, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_set_item(session, "/state-module:cards/card[dn='abc']", NULL, SR_EDIT_DEFAULT);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_set_item(session, "/state-module:cards/card[dn='def']", NULL, SR_EDIT_DEFAULT);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* retrieve data */
+    rc = sr_get_items(session, "/state-module:cards//*", &values, &cnt);
+    assert_int_equal(rc, SR_ERR_OK);
+    sr_free_values(values, cnt);
+
+    /* single request for all instances of the list */
+    const char *xpath_expected_to_be_loaded [] = {
+        "/state-module:cards/card/state",
+    };
+    CHECK_LIST_OF_STRINGS(xpath_retrieved, xpath_expected_to_be_loaded);
+
+    for (size_t i = 0; i < xpath_retrieved->count; i++) {
+        free(xpath_retrieved->data[i]);
+    }
+    xpath_retrieved->count = 0;
+
+    /* data of all instances are available */
+    rc = sr_get_item(session, "/state-module:cards/card[dn='def']/state/c_state", &value);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(SR_STRING_T, value->type);
+    assert_string_equal("OK", value->data.string_val);
+    sr_free_val(value);
+
+    rc = sr_get_item(session, "/state-module:cards/card[dn='abc']/state/c_state", &value);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_string_equal("OK", value->data.string_val);
+    sr_free_val(value);
+
+    /* the instance returned by the provider in addition to the configured ones is ignored */
+    rc = sr_get_item(session, "/state-module:cards/card[dn='ghi']", &value);
+    assert_int_equal(rc, SR_ERR_NOT_FOUND);
+
+    rc = sr_get_items(session, "/state-module:cards/card", &values, &cnt);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(2, cnt);
+    sr_free_values(values, cnt);
+
+    for (size_t i = 0; i < xpath_retrieved->count; i++) {
+        free(xpath_retrieved->data[i]);
+    }
+    sr_list_cleanup(xpath_retrieved);
+
+    /* cleanup */
+    sr_unsubscribe(session, subscription);
+    sr_session_stop(session);
+}
+
 int
 main()
 {
@@ -3082,6 +3252,8 @@ main()
         cmocka_unit_test_setup_teardown(cl_no_dp_subscription, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_type_not_filled_by_dp, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_state_data_in_grouping, sysrepo_setup, sysrepo_teardown),
+        cmocka_unit_test_setup_teardown(cl_dp_cache_subscription, sysrepo_setup, sysrepo_teardown),
+        cmocka_unit_test_setup_teardown(cl_dp_bulk_subscription, sysrepo_setup, sysrepo_teardown),
     };
 
     watchdog_start(300);
@@ -944,6 +944,115 @@ cl_get_items_iter_test(void **state)
     assert_int_equal(rc, SR_ERR_OK);
 }
 
+/**
+ * @brief Checks one item returned by an iterator over the large example-module list.
+ */
+static void
+cl_get_items_iter_check_item(sr_val_t *value, size_t index, size_t list_count)
+{
+    char xpath[100] = { 0, };
+
+    assert_non_null(value);
+    if (index < list_count) {
+        snprintf(xpath, sizeof(xpath), "/example-module:container/list[key1='k1%zu'][key2='k2%zu']/leaf", index, index);
+    } else {
+        snprintf(xpath, sizeof(xpath), "/example-module:container/list[key1='key1'][key2='key2']/leaf");
+    }
+    assert_string_equal(xpath, value->xpath);
+}
+
+static void
+cl_get_items_iter_interleaved_test(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+
+    sr_session_ctx_t *session = NULL;
+    sr_val_iter_t *it_a = NULL, *it_b = NULL;
+    sr_val_t *value = NULL;
+    size_t list_count = 1000, total = list_count + 1;
+    size_t cnt_a = 0, cnt_b = 0, page_a = 0, page_b = 0, pages_a = 0;
+    int rc = SR_ERR_OK;
+
+    createDataTreeLargeExampleModule(list_count);
+
+    /* start a session */
+    rc = sr_session_start(conn, SR_DS_STARTUP, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* two iterations of the same session, each has its own cursor */
+    rc = sr_get_items_iter(session, "/example-module:container/list/leaf", &it_a);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = sr_get_items_iter(session, "/example-module:container/list/leaf", &it_b);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    assert_int_equal(SR_GET_ITEMS_FETCH_LIMIT, it_a->count);
+    assert_int_equal(SR_GET_ITEMS_FETCH_LIMIT, it_b->count);
+    assert_int_not_equal(0, it_a->cursor_id);
+    assert_int_not_equal(0, it_b->cursor_id);
+    assert_int_not_equal(it_a->cursor_id, it_b->cursor_id);
+    page_a = it_a->count;
+    page_b = it_b->count;
+    pages_a = 1;
+
+    /* iterator A reads two items for each item of iterator B */
+    while (cnt_a < total || cnt_b < total) {
+        for (int i = 0; i < 2 && cnt_a < total; i++) {
+            rc = sr_get_item_next(session, it_a, &value);
+            assert_int_equal(rc, SR_ERR_OK);
+            cl_get_items_iter_check_item(value, cnt_a++, list_count);
+            sr_free_val(value);
+            if (1 == it_a->index && 1 < cnt_a) {
+                /* a new page has been fetched, it is larger than the previous one unless it is the last one */
+                if (it_a->finished) {
+                    assert_int_equal(total - (cnt_a - 1), it_a->count);
+                } else {
+                    assert_true(it_a->count > page_a);
+                    assert_true(it_a->count <= SR_GET_ITEMS_MAX_FETCH_LIMIT);
+                }
+                page_a = it_a->count;
+                pages_a++;
+            }
+        }
+        if (cnt_b < total) {
+            rc = sr_get_item_next(session, it_b, &value);
+            assert_int_equal(rc, SR_ERR_OK);
+            cl_get_items_iter_check_item(value, cnt_b++, list_count);
+            sr_free_val(value);
+            if (1 == it_b->index && 1 < cnt_b) {
+                if (!it_b->finished) {
+                    assert_true(it_b->count > page_b);
+                }
+                page_b = it_b->count;
+            }
+        }
+    }
+    /* growing pages need fewer round trips than fixed ones */
+    assert_true(pages_a < (total + SR_GET_ITEMS_FETCH_LIMIT - 1) / SR_GET_ITEMS_FETCH_LIMIT);
+
+    /* the server closed both cursors with the last page */
+    assert_int_equal(0, it_a->cursor_id);
+    assert_true(it_a->finished);
+    assert_int_equal(0, it_b->cursor_id);
+    assert_true(it_b->finished);
+
+    rc = sr_get_item_next(session, it_a, &value);
+    assert_int_equal(rc, SR_ERR_NOT_FOUND);
+    assert_null(value);
+    rc = sr_get_item_next(session, it_b, &value);
+    assert_int_equal(rc, SR_ERR_NOT_FOUND);
+    assert_null(value);
+
+    sr_free_val_iter(it_a);
+    sr_free_val_iter(it_b);
+
+    /* stop the session */
+    rc = sr_session_stop(session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    createDataTreeExampleModule();
+}
+
 /**
  * @brief Traverses through at most visited_limit nodes of a given tree and counts visited iterators.
  */
@@ -5518,6 +5627,250 @@ cl_session_get_id_test (void **state)
     sr_session_stop(session);
 }
 
+typedef struct cl_async_test_ctx_s {
+    pthread_mutex_t mutex;
+    pthread_cond_t cv;
+    size_t completed;
+    int results[4];
+    size_t error_cnts[4];
+    bool error_xpath_match;
+    size_t value_cnt;
+} cl_async_test_ctx_t;
+
+static void
+cl_async_test_cb(sr_session_ctx_t *session, int result, const sr_error_info_t *errors, size_t error_cnt,
+        void *private_ctx)
+{
+    cl_async_test_ctx_t *ctx = private_ctx;
+
+    pthread_mutex_lock(&ctx->mutex);
+    if (error_cnt > 0 && NULL != errors[0].xpath &&
+            0 == strcmp("/example-module:container/list[key1='no'][key2='such']", errors[0].xpath)) {
+        ctx->error_xpath_match = true;
+    }
+    ctx->error_cnts[ctx->completed] = error_cnt;
+    ctx->results[ctx->completed++] = result;
+    pthread_cond_signal(&ctx->cv);
+    pthread_mutex_unlock(&ctx->mutex);
+}
+
+static void
+cl_async_test_get_items_cb(sr_session_ctx_t *session, int result, sr_val_t *values, size_t value_cnt,
+        const sr_error_info_t *errors, size_t error_cnt, void *private_ctx)
+{
+    cl_async_test_ctx_t *ctx = private_ctx;
+
+    sr_free_values(values, value_cnt);
+
+    pthread_mutex_lock(&ctx->mutex);
+    ctx->value_cnt = value_cnt;
+    ctx->error_cnts[ctx->completed] = error_cnt;
+    ctx->results[ctx->completed++] = result;
+    pthread_cond_signal(&ctx->cv);
+    pthread_mutex_unlock(&ctx->mutex);
+}
+
+static void
+cl_async_api_test(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL;
+    cl_async_test_ctx_t ctx = { .mutex = PTHREAD_MUTEX_INITIALIZER, .cv = PTHREAD_COND_INITIALIZER, };
+    struct timespec ts = { 0, };
+    sr_val_t *values = NULL;
+    size_t value_cnt = 0;
+    const sr_error_info_t *error_info = NULL;
+    int rc = SR_ERR_OK;
+
+    rc = sr_session_start(conn, SR_DS_STARTUP, SR_SESS_DEFAULT, &session);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    /* issue several requests without waiting for the responses */
+    pthread_mutex_lock(&ctx.mutex);
+    rc = sr_set_item_async(session, "/example-module:container/list[key1='async1'][key2='async2']", NULL,
+            SR_EDIT_DEFAULT, cl_async_test_cb, &ctx);
+    assert_int_equal(SR_ERR_OK, rc);
+    rc = sr_delete_item_async(session, "/example-module:container/list[key1='no'][key2='such']",
+            SR_EDIT_STRICT, cl_async_test_cb, &ctx);
+    assert_int_equal(SR_ERR_OK, rc);
+    rc = sr_get_items_async(session, "/example-module:container/list[key1='async1'][key2='async2']/*",
+            cl_async_test_get_items_cb, &ctx);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    /* a synchronous request can be processed meanwhile */
+    rc = sr_get_items(session, "/example-module:container/list[key1='async1'][key2='async2']/*", &values, &value_cnt);
+    assert_int_equal(SR_ERR_OK, rc);
+    sr_free_values(values, value_cnt);
+
+    rc = sr_commit_async(session, cl_async_test_cb, &ctx);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    sr_clock_get_time(CLOCK_REALTIME, &ts);
+    ts.tv_sec += COND_WAIT_SEC;
+    while (ctx.completed < 4 && 0 == rc) {
+        rc = pthread_cond_timedwait(&ctx.cv, &ctx.mutex, &ts);
+    }
+    assert_int_equal(4, ctx.completed);
+    pthread_mutex_unlock(&ctx.mutex);
+
+    /* callbacks are called in the order of the requests */
+    assert_int_equal(SR_ERR_OK, ctx.results[0]);
+    assert_int_equal(SR_ERR_DATA_MISSING, ctx.results[1]);
+    assert_int_equal(SR_ERR_OK, ctx.results[2]);
+    assert_int_equal(2, ctx.value_cnt);
+    assert_int_equal(SR_ERR_OK, ctx.results[3]);
+
+    /* the error is delivered to the callback, the session keeps the result of the last synchronous call */
+    assert_int_equal(0, ctx.error_cnts[0]);
+    assert_int_equal(1, ctx.error_cnts[1]);
+    assert_true(ctx.error_xpath_match);
+    assert_int_equal(0, ctx.error_cnts[2]);
+    assert_int_equal(0, ctx.error_cnts[3]);
+    assert_int_equal(SR_ERR_OK, sr_get_last_error(session, &error_info));
+
+    /* cleanup */
+    rc = sr_delete_item(session, "/example-module:container/list[key1='async1'][key2='async2']", SR_EDIT_DEFAULT);
+    assert_int_equal(SR_ERR_OK, rc);
+    rc = sr_commit(session);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    sr_session_stop(session);
+}
+
+#define CL_CONCURRENT_THREADS 8        /**< Number of threads sharing one connection in the concurrent requests test. */
+#define CL_CONCURRENT_ITERATIONS 100   /**< Number of set & get request pairs issued by each thread. */
+
+/**
+ * @brief Context of a thread of the concurrent requests test.
+ */
+typedef struct cl_concurrent_req_ctx_s {
+    sr_conn_ctx_t *conn;    /**< Connection shared by all threads. */
+    int id;                 /**< Identifier of the thread. */
+    int rc;                 /**< First error returned by an API call. */
+    size_t mismatch_cnt;    /**< Number of responses that belonged to another request. */
+} cl_concurrent_req_ctx_t;
+
+static void *
+cl_concurrent_req_thread(void *arg)
+{
+    cl_concurrent_req_ctx_t *ctx = arg;
+    sr_session_ctx_t *session = NULL;
+    sr_val_t value = { 0, }, *result = NULL;
+    char str[32] = { 0, };
+    int rc = SR_ERR_OK;
+
+    rc = sr_session_start(ctx->conn, SR_DS_STARTUP, SR_SESS_DEFAULT, &session);
+    for (size_t i = 0; SR_ERR_OK == rc && i < CL_CONCURRENT_ITERATIONS; i++) {
+        /* the value is visible only in the session of this thread */
+        snprintf(str, sizeof(str), "thread-%d-%zu", ctx->id, i);
+        value.type = SR_STRING_T;
+        value.data.string_val = str;
+        rc = sr_set_item(session, XP_TEST_MODULE_STRING, &value, SR_EDIT_DEFAULT);
+        if (SR_ERR_OK == rc) {
+            rc = sr_get_item(session, XP_TEST_MODULE_STRING, &result);
+        }
+        if (SR_ERR_OK == rc) {
+            if (SR_STRING_T != result->type || 0 != strcmp(str, result->data.string_val)) {
+                ctx->mismatch_cnt++;
+            }
+            sr_free_val(result);
+            result = NULL;
+        }
+    }
+    ctx->rc = rc;
+
+    if (NULL != session) {
+        sr_session_stop(session);
+    }
+    return NULL;
+}
+
+static void
+cl_concurrent_requests_test(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    pthread_t threads[CL_CONCURRENT_THREADS];
+    cl_concurrent_req_ctx_t ctx[CL_CONCURRENT_THREADS];
+    int rc = 0;
+
+    /* all threads share the connection, their requests are outstanding at the same time */
+    for (int i = 0; i < CL_CONCURRENT_THREADS; i++) {
+        ctx[i].conn = conn;
+        ctx[i].id = i;
+        ctx[i].rc = SR_ERR_OK;
+        ctx[i].mismatch_cnt = 0;
+        rc = pthread_create(&threads[i], NULL, cl_concurrent_req_thread, &ctx[i]);
+        assert_int_equal(0, rc);
+    }
+    for (int i = 0; i < CL_CONCURRENT_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    /* each thread has received the responses to its own requests */
+    for (int i = 0; i < CL_CONCURRENT_THREADS; i++) {
+        assert_int_equal(SR_ERR_OK, ctx[i].rc);
+        assert_int_equal(0, ctx[i].mismatch_cnt);
+    }
+}
+
+static void
+cl_edit_batch_test(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL;
+    sr_val_t value = { 0, }, *v = NULL;
+    int rc = SR_ERR_OK;
+
+    rc = sr_session_start(conn, SR_DS_STARTUP, SR_SESS_DEFAULT, &session);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    value.type = SR_UINT8_T;
+    value.data.uint8_val = 42;
+
+    sr_edit_batch_op_t ops[] = {
+        { .type = SR_EDIT_BATCH_SET, .xpath = "/test-module:main/ui8", .value = &value },
+        { .type = SR_EDIT_BATCH_SET_STR, .xpath = "/test-module:main/string", .str_value = "batch" },
+        { .type = SR_EDIT_BATCH_DELETE, .xpath = "/test-module:main/nonexisting", .opts = SR_EDIT_STRICT },
+        { .type = SR_EDIT_BATCH_SET_STR, .xpath = "/example-module:container/list[key1='b1'][key2='b2']/leaf", .str_value = "abc" },
+    };
+
+    /* stop on the first error */
+    rc = sr_edit_batch(session, ops, sizeof(ops) / sizeof(ops[0]), false);
+    assert_int_not_equal(SR_ERR_OK, rc);
+    assert_int_equal(SR_ERR_OK, ops[0].result);
+    assert_int_equal(SR_ERR_OK, ops[1].result);
+    assert_int_equal(rc, ops[2].result);
+    assert_int_equal(SR_ERR_OPERATION_FAILED, ops[3].result);
+
+    rc = sr_get_item(session, "/test-module:main/ui8", &v);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(42, v->data.uint8_val);
+    sr_free_val(v);
+
+    rc = sr_get_item(session, "/example-module:container/list[key1='b1'][key2='b2']/leaf", &v);
+    assert_int_equal(SR_ERR_NOT_FOUND, rc);
+
+    /* continue on error */
+    rc = sr_edit_batch(session, ops, sizeof(ops) / sizeof(ops[0]), true);
+    assert_int_not_equal(SR_ERR_OK, rc);
+    assert_int_equal(SR_ERR_OK, ops[0].result);
+    assert_int_not_equal(SR_ERR_OK, ops[2].result);
+    assert_int_equal(SR_ERR_OK, ops[3].result);
+
+    rc = sr_get_item(session, "/example-module:container/list[key1='b1'][key2='b2']/leaf", &v);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_string_equal("abc", v->data.string_val);
+    sr_free_val(v);
+
+    rc = sr_discard_changes(session);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    sr_session_stop(session);
+}
+
 static void
 cl_apos_xpath_test (void **state)
 {
@@ -6315,6 +6668,7 @@ main()
             cmocka_unit_test_setup_teardown(cl_get_item_test, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_get_items_test, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_get_items_iter_test, sysrepo_setup, sysrepo_teardown),
+            cmocka_unit_test_setup_teardown(cl_get_items_iter_interleaved_test, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_get_subtree_test, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_get_subtrees_test, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_iterative_tree_traversal, sysrepo_setup, sysrepo_teardown),
@@ -6358,6 +6712,9 @@ main()
             cmocka_unit_test_setup_teardown(cl_get_schema_with_subscription, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_set_item_str_test, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_session_get_id_test, sysrepo_setup, sysrepo_teardown),
+            cmocka_unit_test_setup_teardown(cl_async_api_test, sysrepo_setup, sysrepo_teardown),
+            cmocka_unit_test_setup_teardown(cl_concurrent_requests_test, sysrepo_setup, sysrepo_teardown),
+            cmocka_unit_test_setup_teardown(cl_edit_batch_test, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_apos_xpath_test, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_no_inst_id_test, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_inst_id_to_known_deps_test, sysrepo_setup, sysrepo_teardown),
@@ -450,6 +450,105 @@ circular_buffer_test3(void **state)
     sr_cbuff_cleanup(buffer);
 }
 
+/*
+ * Tests lock-free MPMC queue - FIFO order, including elements that do not fit into the ring.
+ */
+static void
+mpmc_queue_test1(void **state)
+{
+    sr_mpmc_queue_t *queue = NULL;
+    int rc = 0, i = 0;
+    int tmp = 0;
+
+    rc = sr_mpmc_queue_init(4, sizeof(int), &queue);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    for (i = 1; i <= 50; i++) {
+        rc = sr_mpmc_queue_enqueue(queue, &i);
+        assert_int_equal(rc, SR_ERR_OK);
+
+        if (10 == i) {
+            assert_int_equal(10, sr_mpmc_queue_items_in_queue(queue));
+            for (int j = 1; j <= 6; j++) {
+                assert_true(sr_mpmc_queue_dequeue(queue, &tmp));
+                assert_int_equal(tmp, j);
+            }
+        }
+    }
+
+    assert_int_equal(44, sr_mpmc_queue_items_in_queue(queue));
+    for (i = 7; i <= 50; i++) {
+        assert_true(sr_mpmc_queue_dequeue(queue, &tmp));
+        assert_int_equal(tmp, i);
+    }
+
+    /* queue should be empty now */
+    assert_false(sr_mpmc_queue_dequeue(queue, &tmp));
+    assert_int_equal(0, sr_mpmc_queue_items_in_queue(queue));
+
+    sr_mpmc_queue_cleanup(queue);
+}
+
+#define MPMC_TEST_THREADS 4
+#define MPMC_TEST_ITEMS 10000
+
+static void *
+mpmc_queue_producer(void *queue)
+{
+    for (size_t i = 1; i <= MPMC_TEST_ITEMS; i++) {
+        assert_int_equal(SR_ERR_OK, sr_mpmc_queue_enqueue(queue, &i));
+    }
+    return NULL;
+}
+
+static void *
+mpmc_queue_consumer(void *queue)
+{
+    size_t item = 0, sum = 0, count = 0;
+
+    while (count < MPMC_TEST_ITEMS) {
+        if (sr_mpmc_queue_dequeue(queue, &item)) {
+            sum += item;
+            count++;
+        }
+    }
+    return (void *)sum;
+}
+
+/*
+ * Tests lock-free MPMC queue - concurrent producers and consumers.
+ */
+static void
+mpmc_queue_test2(void **state)
+{
+    sr_mpmc_queue_t *queue = NULL;
+    pthread_t producers[MPMC_TEST_THREADS], consumers[MPMC_TEST_THREADS];
+    void *sum = NULL;
+    size_t total = 0;
+    int rc = 0;
+
+    rc = sr_mpmc_queue_init(16, sizeof(size_t), &queue);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    for (size_t i = 0; i < MPMC_TEST_THREADS; i++) {
+        pthread_create(&consumers[i], NULL, mpmc_queue_consumer, queue);
+        pthread_create(&producers[i], NULL, mpmc_queue_producer, queue);
+    }
+    for (size_t i = 0; i < MPMC_TEST_THREADS; i++) {
+        pthread_join(producers[i], NULL);
+    }
+    for (size_t i = 0; i < MPMC_TEST_THREADS; i++) {
+        pthread_join(consumers[i], &sum);
+        total += (size_t)sum;
+    }
+
+    /* each item has been dequeued exactly once */
+    assert_int_equal(total, (size_t)MPMC_TEST_THREADS * MPMC_TEST_ITEMS * (MPMC_TEST_ITEMS + 1) / 2);
+    assert_false(sr_mpmc_queue_dequeue(queue, &total));
+
+    sr_mpmc_queue_cleanup(queue);
+}
+
 /*
  * Tests sysrepo bitset DS.
  */
@@ -1427,6 +1526,112 @@ sr_dup_data_tree_to_ctx_test(void **state)
     ly_ctx_destroy(ctx_B, NULL);
 }
 
+static void
+sr_data_file_format_test(void **state)
+{
+    struct ly_ctx *ctx = ly_ctx_new(TEST_SCHEMA_SEARCH_DIR, 0);
+    struct lyd_node *data_tree = NULL, *parsed = NULL;
+    LYD_FORMAT formats[] = { LYD_XML, LYD_JSON,
+#ifdef HAVE_LYD_LYB
+            LYD_LYB,
+#endif
+    };
+    char file_name[] = "/tmp/sr_data_file_format_test.XXXXXX";
+    int fd = -1;
+
+    ly_ctx_load_module(ctx, "test-module", NULL);
+    data_tree = lyd_new_path(NULL, ctx, "/test-module:list[key='a']", NULL, 0, 0);
+    assert_non_null(data_tree);
+
+    fd = mkstemp(file_name);
+    assert_int_not_equal(-1, fd);
+
+    /* empty file */
+    assert_int_equal(SR_FILE_FORMAT_LY, sr_data_file_format(fd));
+
+    for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); ++i) {
+        assert_int_equal(0, ftruncate(fd, 0));
+        assert_int_equal(0, lseek(fd, 0, SEEK_SET));
+        assert_int_equal(0, lyd_print_fd(fd, data_tree, formats[i], LYP_WITHSIBLINGS | LYP_FORMAT));
+        assert_int_equal(formats[i], sr_data_file_format(fd));
+
+        /* the detected format can be used to parse the file */
+        parsed = lyd_parse_fd(ctx, fd, sr_data_file_format(fd), LYD_OPT_CONFIG);
+        assert_non_null(parsed);
+        assert_string_equal("list", parsed->schema->name);
+        lyd_free_withsiblings(parsed);
+    }
+
+    close(fd);
+    unlink(file_name);
+    lyd_free_withsiblings(data_tree);
+    ly_ctx_destroy(ctx, NULL);
+}
+
+#ifdef ENABLE_SHM_TRANSPORT
+static void
+sr_shm_transport_test(void **state)
+{
+    sr_shm_transport_t *client = NULL, *engine = NULL;
+    uint8_t data[6000] = { 0, }, recv_data[6000] = { 0, };
+    size_t len = 0;
+    bool wakeup = false;
+    int rc = SR_ERR_OK;
+
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = i % 251;
+    }
+
+    /* ring size is rounded up to a power of two */
+    rc = sr_shm_transport_create(1000, &client);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(4096, client->tx.size);
+    rc = sr_shm_transport_attach(dup(client->fd), &engine);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(4096, engine->rx.size);
+
+    /* the first write into an empty ring wakes up the consumer */
+    assert_int_equal(3000, sr_shm_ring_write(&client->tx, data, 3000, &wakeup));
+    assert_true(wakeup);
+    assert_int_equal(1096, sr_shm_ring_write(&client->tx, data + 3000, 3000, &wakeup));
+    assert_false(wakeup);
+    assert_false(sr_shm_ring_wait_announce(&client->tx));
+    assert_int_equal(4096, sr_shm_ring_readable(&engine->rx));
+
+    /* reading from the full ring wakes up the waiting producer */
+    rc = sr_shm_ring_read(&engine->rx, recv_data, 2000, &len, &wakeup);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(2000, len);
+    assert_true(wakeup);
+
+    /* the rest wraps around the end of the ring */
+    assert_int_equal(1904, sr_shm_ring_write(&client->tx, data + 4096, 1904, &wakeup));
+    assert_false(wakeup);
+    rc = sr_shm_ring_read(&engine->rx, recv_data + 2000, 6000, &len, &wakeup);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(4000, len);
+    assert_false(wakeup);
+    assert_memory_equal(data, recv_data, sizeof(data));
+
+    rc = sr_shm_ring_read(&engine->rx, recv_data, sizeof(recv_data), &len, &wakeup);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(0, len);
+    assert_int_equal(0, sr_shm_ring_readable(&engine->rx));
+
+    /* the other direction */
+    assert_int_equal(10, sr_shm_ring_write(&engine->tx, data, 10, &wakeup));
+    assert_true(wakeup);
+    rc = sr_shm_ring_read(&client->rx, recv_data, sizeof(recv_data), &len, &wakeup);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(10, len);
+
+    /* the peer waiting for space is notified about closing */
+    sr_shm_transport_cleanup(engine);
+    assert_int_equal(SR_ERR_DISCONNECT, sr_shm_ring_wait_space(&client->tx, 1));
+    sr_shm_transport_cleanup(client);
+}
+#endif
+
 int
 main() {
     const struct CMUnitTest tests[] = {
@@ -1436,6 +1641,8 @@ main() {
             cmocka_unit_test_setup_teardown(circular_buffer_test1, logging_setup, logging_cleanup),
             cmocka_unit_test_setup_teardown(circular_buffer_test2, logging_setup, logging_cleanup),
             cmocka_unit_test_setup_teardown(circular_buffer_test3, logging_setup, logging_cleanup),
+            cmocka_unit_test_setup_teardown(mpmc_queue_test1, logging_setup, logging_cleanup),
+            cmocka_unit_test_setup_teardown(mpmc_queue_test2, logging_setup, logging_cleanup),
             cmocka_unit_test_setup_teardown(sr_bitset_test, logging_setup, logging_cleanup),
             cmocka_unit_test_setup_teardown(logger_callback_test, logging_setup, logging_cleanup),
             cmocka_unit_test_setup_teardown(sr_locking_set_test, logging_setup, logging_cleanup),
@@ -1449,6 +1656,10 @@ main() {
             cmocka_unit_test_setup_teardown(sr_get_system_groups_test, logging_setup, logging_cleanup),
             cmocka_unit_test_setup_teardown(sr_free_list_of_strings_test, logging_setup, logging_cleanup),
             cmocka_unit_test_setup_teardown(sr_dup_data_tree_to_ctx_test, logging_setup, logging_cleanup),
+            cmocka_unit_test_setup_teardown(sr_data_file_format_test, logging_setup, logging_cleanup),
+#ifdef ENABLE_SHM_TRANSPORT
+            cmocka_unit_test_setup_teardown(sr_shm_transport_test, logging_setup, logging_cleanup),
+#endif
     };
 
     watchdog_start(300);
@@ -27,9 +27,14 @@
 #include <stdbool.h>
 #include <signal.h>
 #include <time.h>
+#include <pthread.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
 
 #include "sysrepo.h"
 #include "sr_common.h"
+#include "cl_common.h"
 #include "system_helper.h"
 
 bool daemon_run_before_test = false; /**< Indices if the daemon was running before executing the test. */
@@ -124,10 +129,304 @@ sysrepo_daemon_test(void **state)
     assert_int_not_equal(ret, 0);
 }
 
+#ifdef ENABLE_SHM_TRANSPORT
+/**
+ * @brief Connects to the daemon, checks which transport is used and sends some traffic through it.
+ */
+static void
+daemon_shm_connection_check(bool shm_expected)
+{
+    sr_conn_ctx_t *conn = NULL;
+    sr_session_ctx_t *session = NULL;
+    sr_schema_t *schemas = NULL;
+    size_t schema_cnt = 0;
+    int rc = SR_ERR_OK;
+
+    rc = sr_connect("daemon_test", SR_CONN_DAEMON_REQUIRED, &conn);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_false(conn->library_mode);
+    assert_true(shm_expected == conn->shm_active);
+    if (shm_expected) {
+        assert_non_null(conn->shm);
+        /* the descriptor of the segment has been passed to the daemon */
+        assert_int_equal(conn->shm->fd, -1);
+    } else {
+        assert_null(conn->shm);
+    }
+
+    rc = sr_session_start(conn, SR_DS_STARTUP, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* enough messages to wrap around the rings several times */
+    for (size_t i = 0; i < 200; i++) {
+        rc = sr_list_schemas(session, &schemas, &schema_cnt);
+        assert_int_equal(rc, SR_ERR_OK);
+        assert_true(schema_cnt > 0);
+        sr_free_schemas(schemas, schema_cnt);
+    }
+
+    sr_session_stop(session);
+    sr_disconnect(conn);
+}
+#endif
+
+static void
+sysrepo_daemon_shm_transport_test(void **state)
+{
+#ifndef ENABLE_SHM_TRANSPORT
+    skip();
+#else
+    int ret = 0;
+
+    /* the daemon accepts the shared memory segment passed with the version verification (SCM_RIGHTS) */
+    ret = system("../src/sysrepod");
+    assert_int_equal(ret, 0);
+    daemon_shm_connection_check(true);
+
+    /* the client does not offer the segment if the transport is disabled in its environment */
+    setenv(SR_SHM_TRANSPORT_ENV, "0", 1);
+    daemon_shm_connection_check(false);
+    unsetenv(SR_SHM_TRANSPORT_ENV);
+
+    /* the daemon declines the offer if the transport is disabled in its environment */
+    daemon_kill();
+    ret = system(SR_SHM_TRANSPORT_ENV "=0 ../src/sysrepod");
+    assert_int_equal(ret, 0);
+    daemon_shm_connection_check(false);
+
+    /* leave the daemon running with the default configuration */
+    daemon_kill();
+    ret = system("../src/sysrepod");
+    assert_int_equal(ret, 0);
+#endif
+}
+
+#define DAEMON_REACTOR_COUNT 4     /**< Number of reactors of the daemon started by the multi-reactor test. */
+#define DAEMON_CONN_COUNT 4        /**< Number of publisher / subscriber connections of the multi-reactor test. */
+#define DAEMON_NOTIF_COUNT 20      /**< Number of notifications sent by each publisher. */
+#define DAEMON_COND_WAIT_SEC 10
+
+/**
+ * @brief State of a subscriber of the multi-reactor test.
+ */
+typedef struct daemon_subscriber_s {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    size_t realtime_cnt;                   /**< Received real-time notifications. */
+    size_t replay_cnt;                     /**< Received replayed notifications. */
+    size_t replay_stop_cnt;                /**< Received replay stop signals. */
+    int last_seq[DAEMON_CONN_COUNT];       /**< Sequence number of the last notification of each publisher. */
+    size_t apply_cnt;                      /**< Received SR_EV_APPLY module change events. */
+} daemon_subscriber_t;
+
+static void
+daemon_subscriber_init(daemon_subscriber_t *subscriber)
+{
+    memset(subscriber, 0, sizeof(*subscriber));
+    assert_int_equal(0, pthread_mutex_init(&subscriber->mutex, NULL));
+    assert_int_equal(0, pthread_cond_init(&subscriber->cond, NULL));
+    for (size_t i = 0; i < DAEMON_CONN_COUNT; i++) {
+        subscriber->last_seq[i] = -1;
+    }
+}
+
+static void
+daemon_subscriber_cleanup(daemon_subscriber_t *subscriber)
+{
+    assert_int_equal(0, pthread_mutex_destroy(&subscriber->mutex));
+    assert_int_equal(0, pthread_cond_destroy(&subscriber->cond));
+}
+
+static void
+daemon_notif_cb(const sr_ev_notif_type_t notif_type, const char *xpath, const sr_val_t *values,
+        const size_t values_cnt, time_t timestamp, void *private_ctx)
+{
+    daemon_subscriber_t *subscriber = private_ctx;
+    int publisher = -1, seq = -1;
+
+    assert_int_equal(0, pthread_mutex_lock(&subscriber->mutex));
+    if (SR_EV_NOTIF_T_REPLAY_STOP == notif_type) {
+        subscriber->replay_stop_cnt++;
+    } else if (SR_EV_NOTIF_T_REALTIME == notif_type || SR_EV_NOTIF_T_REPLAY == notif_type) {
+        assert_string_equal("/test-module:link-removed", xpath);
+        for (size_t i = 0; i < values_cnt; i++) {
+            if (0 == strcmp("/test-module:link-removed/source/address", values[i].xpath)) {
+                if (2 != sscanf(values[i].data.string_val, "10.42.%d.%d", &publisher, &seq)) {
+                    publisher = -1;
+                }
+            }
+        }
+        /* notifications of other tests may be stored in the same second */
+        if (publisher >= 0 && publisher < DAEMON_CONN_COUNT) {
+            /* the notifications of one publisher are delivered in order */
+            assert_int_equal(subscriber->last_seq[publisher] + 1, seq);
+            subscriber->last_seq[publisher] = seq;
+            if (SR_EV_NOTIF_T_REALTIME == notif_type) {
+                subscriber->realtime_cnt++;
+            } else {
+                subscriber->replay_cnt++;
+            }
+        }
+    }
+    assert_int_equal(0, pthread_cond_signal(&subscriber->cond));
+    assert_int_equal(0, pthread_mutex_unlock(&subscriber->mutex));
+}
+
+static int
+daemon_module_change_cb(sr_session_ctx_t *session, const char *module_name, sr_notif_event_t event, void *private_ctx)
+{
+    daemon_subscriber_t *subscriber = private_ctx;
+
+    assert_int_equal(0, pthread_mutex_lock(&subscriber->mutex));
+    if (SR_EV_APPLY == event) {
+        subscriber->apply_cnt++;
+    }
+    assert_int_equal(0, pthread_cond_signal(&subscriber->cond));
+    assert_int_equal(0, pthread_mutex_unlock(&subscriber->mutex));
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Waits until the counter of the subscriber reaches the expected value.
+ * The mutex of the subscriber must be locked.
+ */
+static void
+daemon_subscriber_wait(daemon_subscriber_t *subscriber, size_t *counter, size_t expected)
+{
+    struct timespec ts = { 0 };
+
+    sr_clock_get_time(CLOCK_REALTIME, &ts);
+    ts.tv_sec += DAEMON_COND_WAIT_SEC;
+    while (*counter < expected && ETIMEDOUT != pthread_cond_timedwait(&subscriber->cond, &subscriber->mutex, &ts));
+    assert_int_equal(expected, *counter);
+}
+
+static void
+sysrepo_daemon_multi_reactor_test(void **state)
+{
+    sr_conn_ctx_t *pub_conn[DAEMON_CONN_COUNT] = { 0 }, *sub_conn[DAEMON_CONN_COUNT] = { 0 };
+    sr_session_ctx_t *pub_sess[DAEMON_CONN_COUNT] = { 0 }, *sub_sess[DAEMON_CONN_COUNT] = { 0 };
+    sr_subscription_ctx_t *subscription[DAEMON_CONN_COUNT] = { 0 };
+    daemon_subscriber_t subscriber[DAEMON_CONN_COUNT];
+    char address[20] = { 0 }, leaf_value[20] = { 0 }, cmd[PATH_MAX] = { 0 };
+    sr_val_t values[4];
+    time_t start_time = time(NULL);
+    int rc = SR_ERR_OK, ret = 0;
+
+    /* connections are distributed among the reactors of the daemon, the connections to the subscribers
+     * are served by the reactors selected by their addresses */
+    snprintf(cmd, sizeof(cmd), SR_CM_REACTORS_ENV "=%d ../src/sysrepod", DAEMON_REACTOR_COUNT);
+    ret = system(cmd);
+    assert_int_equal(ret, 0);
+
+    for (size_t i = 0; i < DAEMON_CONN_COUNT; i++) {
+        daemon_subscriber_init(&subscriber[i]);
+        rc = sr_connect("daemon_test", SR_CONN_DAEMON_REQUIRED, &sub_conn[i]);
+        assert_int_equal(rc, SR_ERR_OK);
+        rc = sr_session_start(sub_conn[i], SR_DS_RUNNING, SR_SESS_DEFAULT, &sub_sess[i]);
+        assert_int_equal(rc, SR_ERR_OK);
+        rc = sr_event_notif_subscribe(sub_sess[i], "/test-module:link-removed", daemon_notif_cb,
+                &subscriber[i], SR_SUBSCR_DEFAULT, &subscription[i]);
+        assert_int_equal(rc, SR_ERR_OK);
+        rc = sr_module_change_subscribe(sub_sess[i], "example-module", daemon_module_change_cb,
+                &subscriber[i], 0, SR_SUBSCR_CTX_REUSE, &subscription[i]);
+        assert_int_equal(rc, SR_ERR_OK);
+
+        rc = sr_connect("daemon_test", SR_CONN_DAEMON_REQUIRED, &pub_conn[i]);
+        assert_int_equal(rc, SR_ERR_OK);
+        rc = sr_session_start(pub_conn[i], SR_DS_RUNNING, SR_SESS_DEFAULT, &pub_sess[i]);
+        assert_int_equal(rc, SR_ERR_OK);
+    }
+
+    /* the publishers take turns so that the reactors deliver concurrently */
+    memset(&values, 0, sizeof(values));
+    values[0].xpath = "/test-module:link-removed/source/address";
+    values[0].type = SR_STRING_T;
+    values[0].data.string_val = address;
+    values[1].xpath = "/test-module:link-removed/source/interface";
+    values[1].type = SR_STRING_T;
+    values[1].data.string_val = "eth0";
+    values[2].xpath = "/test-module:link-removed/destination/address";
+    values[2].type = SR_STRING_T;
+    values[2].data.string_val = "10.42.255.1";
+    values[3].xpath = "/test-module:link-removed/destination/interface";
+    values[3].type = SR_STRING_T;
+    values[3].data.string_val = "eth1";
+    for (size_t seq = 0; seq < DAEMON_NOTIF_COUNT; seq++) {
+        for (size_t i = 0; i < DAEMON_CONN_COUNT; i++) {
+            snprintf(address, sizeof(address), "10.42.%zu.%zu", i, seq);
+            rc = sr_event_notif_send(pub_sess[i], "/test-module:link-removed", values, 4, SR_EV_NOTIF_DEFAULT);
+            assert_int_equal(rc, SR_ERR_OK);
+        }
+    }
+
+    /* each publisher commits a change verified by all subscribers */
+    for (size_t i = 0; i < DAEMON_CONN_COUNT; i++) {
+        snprintf(leaf_value, sizeof(leaf_value), "reactor-%zu", i);
+        rc = sr_set_item_str(pub_sess[i], "/example-module:container/list[key1='key1'][key2='key2']/leaf",
+                leaf_value, SR_EDIT_DEFAULT);
+        assert_int_equal(rc, SR_ERR_OK);
+        rc = sr_commit(pub_sess[i]);
+        assert_int_equal(rc, SR_ERR_OK);
+    }
+
+    for (size_t i = 0; i < DAEMON_CONN_COUNT; i++) {
+        assert_int_equal(0, pthread_mutex_lock(&subscriber[i].mutex));
+        daemon_subscriber_wait(&subscriber[i], &subscriber[i].realtime_cnt, DAEMON_CONN_COUNT * DAEMON_NOTIF_COUNT);
+        daemon_subscriber_wait(&subscriber[i], &subscriber[i].apply_cnt, DAEMON_CONN_COUNT);
+        assert_int_equal(0, pthread_mutex_unlock(&subscriber[i].mutex));
+
+        rc = sr_unsubscribe(sub_sess[i], subscription[i]);
+        assert_int_equal(rc, SR_ERR_OK);
+        subscription[i] = NULL;
+        daemon_subscriber_cleanup(&subscriber[i]);
+    }
+
+#ifdef ENABLE_NOTIF_STORE
+    /* replay the stored notifications to all subscribers at once */
+    for (size_t i = 0; i < DAEMON_CONN_COUNT; i++) {
+        daemon_subscriber_init(&subscriber[i]);
+        rc = sr_event_notif_subscribe(sub_sess[i], "/test-module:link-removed", daemon_notif_cb,
+                &subscriber[i], SR_SUBSCR_NOTIF_REPLAY_FIRST, &subscription[i]);
+        assert_int_equal(rc, SR_ERR_OK);
+    }
+    for (size_t i = 0; i < DAEMON_CONN_COUNT; i++) {
+        rc = sr_event_notif_replay(sub_sess[i], subscription[i], start_time, time(NULL) + 1);
+        assert_int_equal(rc, SR_ERR_OK);
+    }
+    for (size_t i = 0; i < DAEMON_CONN_COUNT; i++) {
+        assert_int_equal(0, pthread_mutex_lock(&subscriber[i].mutex));
+        daemon_subscriber_wait(&subscriber[i], &subscriber[i].replay_cnt, DAEMON_CONN_COUNT * DAEMON_NOTIF_COUNT);
+        daemon_subscriber_wait(&subscriber[i], &subscriber[i].replay_stop_cnt, 1);
+        assert_int_equal(0, subscriber[i].realtime_cnt);
+        assert_int_equal(0, pthread_mutex_unlock(&subscriber[i].mutex));
+
+        rc = sr_unsubscribe(sub_sess[i], subscription[i]);
+        assert_int_equal(rc, SR_ERR_OK);
+        daemon_subscriber_cleanup(&subscriber[i]);
+    }
+#endif
+
+    for (size_t i = 0; i < DAEMON_CONN_COUNT; i++) {
+        sr_session_stop(pub_sess[i]);
+        sr_disconnect(pub_conn[i]);
+        sr_session_stop(sub_sess[i]);
+        sr_disconnect(sub_conn[i]);
+    }
+
+    /* leave the daemon running with the default configuration */
+    daemon_kill();
+    ret = system("../src/sysrepod");
+    assert_int_equal(ret, 0);
+}
+
 int
 main() {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test_setup_teardown(sysrepo_daemon_test, test_setup, test_teardown),
+            cmocka_unit_test_setup_teardown(sysrepo_daemon_shm_transport_test, test_setup, test_teardown),
+            cmocka_unit_test_setup_teardown(sysrepo_daemon_multi_reactor_test, test_setup, test_teardown),
     };
 
     watchdog_start(300);
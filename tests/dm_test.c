@@ -25,6 +25,10 @@
 #include <cmocka.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
 #include "data_manager.h"
 #include "test_data.h"
 #include "sr_common.h"
@@ -1099,6 +1103,233 @@ dm_schema_node_xpath_hash(void **state)
     dm_cleanup(ctx);
 }
 
+void
+dm_shared_data_cache_test(void **state)
+{
+    int rc;
+    dm_ctx_t *ctx = NULL;
+    dm_session_t *ses_a = NULL, *ses_b = NULL;
+    dm_data_info_t *info = NULL;
+    struct lyd_node *tree_a = NULL, *tree_b = NULL;
+
+    /* data cache is used only in the daemon mode */
+    rc = dm_init(NULL, NULL, NULL, CM_MODE_DAEMON, TEST_SCHEMA_SEARCH_DIR, TEST_DATA_SEARCH_DIR, &ctx);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    dm_session_start(ctx, NULL, SR_DS_STARTUP, &ses_a);
+    dm_session_start(ctx, NULL, SR_DS_STARTUP, &ses_b);
+
+    /* both sessions share the same read-only data tree */
+    assert_int_equal(SR_ERR_OK, dm_get_datatree(ctx, ses_a, "example-module", &tree_a));
+    assert_int_equal(SR_ERR_OK, dm_get_datatree(ctx, ses_b, "example-module", &tree_b));
+    assert_ptr_equal(tree_a, tree_b);
+
+    /* the tree is duplicated before the first edit */
+    assert_int_equal(SR_ERR_OK, dm_get_data_info(ctx, ses_b, "example-module", &info));
+    assert_false(info->rdonly_copy);
+    assert_null(info->snapshot);
+    assert_ptr_not_equal(tree_a, info->node);
+
+    /* the other session still uses the shared tree */
+    assert_int_equal(SR_ERR_OK, dm_get_datatree(ctx, ses_a, "example-module", &tree_b));
+    assert_ptr_equal(tree_a, tree_b);
+
+    dm_session_stop(ctx, ses_a);
+    dm_session_stop(ctx, ses_b);
+    dm_cleanup(ctx);
+}
+
+#define DM_TEST_WARMUP_FILE TEST_DATA_SEARCH_DIR "internal/" SR_WARMUP_MODULES_FILENAME
+
+void
+dm_warmup_env_test(void **state)
+{
+    int rc;
+    dm_ctx_t *ctx = NULL;
+    dm_schema_info_t *si = NULL;
+    const sr_list_t *modules = NULL;
+
+    if (0 == SR_WARMUP_THREAD_COUNT) {
+        skip();
+    }
+    unlink(DM_TEST_WARMUP_FILE);
+
+    /* modules listed in the environment variable are warmed-up, the one not installed is skipped */
+    setenv(SR_WARMUP_MODULES_ENV, "example-module, no-such-module,test-module", 1);
+    rc = dm_init(NULL, NULL, NULL, CM_MODE_DAEMON, TEST_SCHEMA_SEARCH_DIR, TEST_DATA_SEARCH_DIR, &ctx);
+    unsetenv(SR_WARMUP_MODULES_ENV);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    rc = dm_warmup_wait(ctx, &modules);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(2, modules->count);
+    assert_string_equal("example-module", (char *) modules->data[0]);
+    assert_string_equal("test-module", (char *) modules->data[1]);
+
+    assert_int_equal(SR_ERR_OK, dm_find_loaded_schema_info(ctx, "example-module", &si));
+    assert_int_equal(SR_ERR_OK, dm_find_loaded_schema_info(ctx, "test-module", &si));
+
+    dm_cleanup(ctx);
+    unlink(DM_TEST_WARMUP_FILE);
+}
+
+void
+dm_warmup_saved_list_test(void **state)
+{
+    int rc;
+    dm_ctx_t *ctx = NULL;
+    dm_schema_info_t *si = NULL;
+    const sr_list_t *modules = NULL;
+    FILE *fp = NULL;
+    char line[PATH_MAX] = { 0, };
+    bool interfaces = false, test_module = false, example_module = false, unknown = false;
+
+    if (0 == SR_WARMUP_THREAD_COUNT) {
+        skip();
+    }
+    unsetenv(SR_WARMUP_MODULES_ENV);
+
+    /* modules loaded during the last run, one of them has been uninstalled since */
+    fp = fopen(DM_TEST_WARMUP_FILE, "w");
+    assert_non_null(fp);
+    fprintf(fp, "test-module\nno-such-module\nexample-module\n");
+    fclose(fp);
+
+    rc = dm_init(NULL, NULL, NULL, CM_MODE_DAEMON, TEST_SCHEMA_SEARCH_DIR, TEST_DATA_SEARCH_DIR, &ctx);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    rc = dm_warmup_wait(ctx, &modules);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(2, modules->count);
+    assert_string_equal("test-module", (char *) modules->data[0]);
+    assert_string_equal("example-module", (char *) modules->data[1]);
+
+    assert_int_equal(SR_ERR_OK, dm_find_loaded_schema_info(ctx, "test-module", &si));
+    assert_int_equal(SR_ERR_OK, dm_find_loaded_schema_info(ctx, "example-module", &si));
+
+    /* the modules loaded during this run are recorded for the next one */
+    rc = dm_get_module_without_lock(ctx, "ietf-interfaces", &si);
+    assert_int_equal(SR_ERR_OK, rc);
+    dm_cleanup(ctx);
+
+    fp = fopen(DM_TEST_WARMUP_FILE, "r");
+    assert_non_null(fp);
+    while (NULL != fgets(line, sizeof line, fp)) {
+        line[strcspn(line, "\n")] = '\0';
+        interfaces |= (0 == strcmp("ietf-interfaces", line));
+        test_module |= (0 == strcmp("test-module", line));
+        example_module |= (0 == strcmp("example-module", line));
+        unknown |= (0 == strcmp("no-such-module", line));
+    }
+    fclose(fp);
+    assert_true(interfaces);
+    assert_true(test_module);
+    assert_true(example_module);
+    assert_false(unknown);
+
+    unlink(DM_TEST_WARMUP_FILE);
+}
+
+/**
+ * @brief Request for a module waiting until the module lock is released.
+ */
+typedef struct dm_test_module_req_s {
+    dm_ctx_t *ctx;
+    pthread_mutex_t mutex;
+    bool done;
+    int rc;
+} dm_test_module_req_t;
+
+static void *
+dm_test_module_req_execute(void *arg)
+{
+    dm_test_module_req_t *req = arg;
+    dm_schema_info_t *si = NULL;
+    int rc = SR_ERR_OK;
+
+    rc = dm_get_module_and_lock(req->ctx, "example-module", &si);
+    if (SR_ERR_OK == rc) {
+        pthread_rwlock_unlock(&si->model_lock);
+    }
+
+    pthread_mutex_lock(&req->mutex);
+    req->rc = rc;
+    req->done = true;
+    pthread_mutex_unlock(&req->mutex);
+    return NULL;
+}
+
+void
+dm_get_module_while_loading_test(void **state)
+{
+    int rc;
+    dm_ctx_t *ctx = NULL;
+    dm_schema_info_t *si = NULL, *other_si = NULL;
+    dm_test_module_req_t req = { .mutex = PTHREAD_MUTEX_INITIALIZER, .done = false, .rc = SR_ERR_OK };
+    pthread_t thread;
+
+    rc = dm_init(NULL, NULL, NULL, CM_MODE_LOCAL, TEST_SCHEMA_SEARCH_DIR, TEST_DATA_SEARCH_DIR, &ctx);
+    assert_int_equal(SR_ERR_OK, rc);
+    req.ctx = ctx;
+
+    /* the loaded module is locked by a long-lasting operation, another request for it waits */
+    rc = dm_get_module_and_lockw(ctx, "example-module", &si);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(0, pthread_create(&thread, NULL, dm_test_module_req_execute, &req));
+    usleep(100000);
+
+    /* inserting another module into the schema tree is not held off by the waiting request */
+    rc = dm_get_module_without_lock(ctx, "test-module", &other_si);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(SR_ERR_OK, dm_find_loaded_schema_info(ctx, "test-module", &other_si));
+
+    pthread_mutex_lock(&req.mutex);
+    assert_false(req.done);
+    pthread_mutex_unlock(&req.mutex);
+
+    /* the waiting request proceeds once the module is unlocked */
+    pthread_rwlock_unlock(&si->model_lock);
+    pthread_join(thread, NULL);
+    assert_true(req.done);
+    assert_int_equal(SR_ERR_OK, req.rc);
+
+    pthread_mutex_destroy(&req.mutex);
+    dm_cleanup(ctx);
+}
+
+#define DM_TEST_STALE_TMP_FILE TEST_DATA_SEARCH_DIR "example-module" SR_STARTUP_FILE_EXT SR_TMP_FILE_EXT "a1B2c3"
+#define DM_TEST_ORPHAN_TMP_FILE TEST_DATA_SEARCH_DIR "no-such-module" SR_RUNNING_FILE_EXT SR_TMP_FILE_EXT "d4E5f6"
+#define DM_TEST_OTHER_TMP_FILE TEST_DATA_SEARCH_DIR "example-module" SR_STARTUP_FILE_EXT SR_TMP_FILE_EXT
+
+void
+dm_stale_tmp_files_test(void **state)
+{
+    int rc;
+    dm_ctx_t *ctx = NULL;
+    FILE *fp = NULL;
+    const char *files[] = { DM_TEST_STALE_TMP_FILE, DM_TEST_ORPHAN_TMP_FILE, DM_TEST_OTHER_TMP_FILE };
+
+    /* temporary files left behind by commits interrupted by a crash */
+    for (size_t i = 0; i < sizeof files / sizeof *files; ++i) {
+        fp = fopen(files[i], "w");
+        assert_non_null(fp);
+        fputs("<partial", fp);
+        fclose(fp);
+    }
+
+    rc = dm_init(NULL, NULL, NULL, CM_MODE_LOCAL, TEST_SCHEMA_SEARCH_DIR, TEST_DATA_SEARCH_DIR, &ctx);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    /* only the files created by a commit are removed */
+    test_file_exists(DM_TEST_STALE_TMP_FILE, false);
+    test_file_exists(DM_TEST_ORPHAN_TMP_FILE, false);
+    test_file_exists(DM_TEST_OTHER_TMP_FILE, true);
+    test_file_exists(TEST_DATA_SEARCH_DIR "example-module" SR_STARTUP_FILE_EXT, true);
+
+    dm_cleanup(ctx);
+    unlink(DM_TEST_OTHER_TMP_FILE);
+}
+
 int
 main()
 {
@@ -1121,6 +1352,11 @@ main()
             cmocka_unit_test(dm_event_notif_parse_test),
             cmocka_unit_test(dm_action_test),
             cmocka_unit_test(dm_schema_node_xpath_hash),
+            cmocka_unit_test(dm_shared_data_cache_test),
+            cmocka_unit_test(dm_warmup_env_test),
+            cmocka_unit_test(dm_warmup_saved_list_test),
+            cmocka_unit_test(dm_get_module_while_loading_test),
+            cmocka_unit_test(dm_stale_tmp_files_test),
     };
 
     watchdog_start(300);
@@ -26,6 +26,7 @@
 #include <cmocka.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <unistd.h>
 #include "module_dependencies.h"
 #include "sr_common.h"
 #include "test_data.h"
@@ -651,30 +652,6 @@ md_tests_teardown(void **state)
     return 0;
 }
 
-/**
- * @brief Test initialization and destruction of the Module Dependencies context.
- */
-static void
-md_test_init_and_destroy(void **state)
-{
-    int rc;
-    md_ctx_t *md_ctx = NULL;
-
-    /* initialize context */
-    rc = md_init(TEST_SCHEMA_SEARCH_DIR, TEST_SCHEMA_SEARCH_DIR "internal",
-                 TEST_DATA_SEARCH_DIR "internal", false, &md_ctx);
-    assert_int_equal(0, rc);
-    assert_non_null(md_ctx->schema_search_dir);
-    assert_int_equal(md_ctx->fd, -1);
-    assert_non_null(md_ctx->ly_ctx);
-    assert_non_null(md_ctx->data_tree);
-    assert_non_null(md_ctx->modules);
-    assert_non_null(md_ctx->modules_btree);
-
-    /* destroy context */
-    md_destroy(md_ctx);
-}
-
 /*
  * presence_type flag: 0 - inserted modules, 1 - implemented modules
  */
@@ -891,6 +868,118 @@ validate_subtree_ref(md_ctx_t *md_ctx, sr_llist_t *list, const char *xpath,
     free(orig_name_cpy);
 }
 
+/**
+ * @brief Compare two lists of modules, each from a different Module Dependencies context.
+ */
+static void
+compare_module_lists(sr_llist_t *modules, sr_llist_t *expected)
+{
+    sr_llist_node_t *node = NULL, *expected_node = NULL;
+    bool found = false;
+    size_t expected_cnt = 0;
+
+    if (NULL == expected) {
+        assert_true_bt(NULL == modules || NULL == modules->first);
+        return;
+    }
+    assert_non_null_bt(modules);
+
+    for (expected_node = expected->first; NULL != expected_node; expected_node = expected_node->next) {
+        ++expected_cnt;
+        found = false;
+        for (node = modules->first; NULL != node && !found; node = node->next) {
+            found = (0 == strcmp(md_get_module_fullname((md_module_t *)node->data),
+                                 md_get_module_fullname((md_module_t *)expected_node->data)));
+        }
+        assert_true_bt(found);
+    }
+    check_list_size(modules, expected_cnt);
+}
+
+/**
+ * @brief Compare two lists of dependencies, each from a different Module Dependencies context.
+ */
+static void
+compare_dependencies(sr_llist_t *deps, sr_llist_t *expected_deps)
+{
+    sr_llist_node_t *node = NULL, *expected_node = NULL;
+    md_dep_t *dep = NULL, *expected_dep = NULL;
+    bool found = false;
+    size_t expected_cnt = 0;
+
+    for (expected_node = expected_deps->first; NULL != expected_node; expected_node = expected_node->next) {
+        expected_dep = (md_dep_t *)expected_node->data;
+        ++expected_cnt;
+        found = false;
+        for (node = deps->first; NULL != node && !found; node = node->next) {
+            dep = (md_dep_t *)node->data;
+            found = (dep->type == expected_dep->type &&
+                     0 == strcmp(md_get_module_fullname(dep->dest), md_get_module_fullname(expected_dep->dest)));
+        }
+        assert_true_bt(found);
+        assert_int_equal_bt(expected_dep->direct, dep->direct);
+        compare_module_lists(dep->orig_modules, expected_dep->orig_modules);
+    }
+    check_list_size(deps, expected_cnt);
+}
+
+/**
+ * @brief Compare two lists of subtree references, each from a different Module Dependencies context.
+ */
+static void
+compare_subtree_refs(sr_llist_t *list, sr_llist_t *expected)
+{
+    sr_llist_node_t *node = NULL, *expected_node = NULL;
+    md_subtree_ref_t *subtree_ref = NULL, *expected_ref = NULL;
+    bool found = false;
+    size_t expected_cnt = 0;
+
+    for (expected_node = expected->first; NULL != expected_node; expected_node = expected_node->next) {
+        expected_ref = (md_subtree_ref_t *)expected_node->data;
+        ++expected_cnt;
+        found = false;
+        for (node = list->first; NULL != node && !found; node = node->next) {
+            subtree_ref = (md_subtree_ref_t *)node->data;
+            found = (0 == strcmp(subtree_ref->xpath, expected_ref->xpath) &&
+                     0 == strcmp(md_get_module_fullname(subtree_ref->orig), md_get_module_fullname(expected_ref->orig)));
+        }
+        assert_true_bt(found);
+    }
+    check_list_size(list, expected_cnt);
+}
+
+/**
+ * @brief Compare the dependency graph of a context loaded from the snapshot
+ * with the graph of a context parsed from the data file.
+ */
+static void
+compare_contexts(md_ctx_t *md_ctx, md_ctx_t *parsed_ctx)
+{
+    int rc = 0;
+    sr_llist_node_t *node = NULL;
+    md_module_t *module = NULL, *expected = NULL;
+    size_t module_cnt = 0;
+
+    for (node = parsed_ctx->modules->first; NULL != node; node = node->next) {
+        expected = (md_module_t *)node->data;
+        ++module_cnt;
+        rc = md_get_module_info(md_ctx, expected->name, expected->revision_date, NULL, &module);
+        assert_int_equal_bt(SR_ERR_OK, rc);
+        assert_string_equal_bt(md_get_module_fullname(expected), md_get_module_fullname(module));
+        assert_int_equal_bt(expected->latest_revision, module->latest_revision);
+        assert_int_equal_bt(expected->submodule, module->submodule);
+        assert_int_equal_bt(expected->installed, module->installed);
+        assert_int_equal_bt(expected->implemented, module->implemented);
+        assert_int_equal_bt(expected->has_data, module->has_data);
+        assert_int_equal_bt(expected->has_persist, module->has_persist);
+        compare_subtree_refs(module->inst_ids, expected->inst_ids);
+        compare_subtree_refs(module->op_data_subtrees, expected->op_data_subtrees);
+        compare_dependencies(module->deps, expected->deps);
+        compare_dependencies(module->inv_deps, expected->inv_deps);
+    }
+    check_list_size(md_ctx->modules, module_cnt);
+}
+
 /**
  * @brief Validate Module Dependencies context.
  */
@@ -899,6 +988,20 @@ validate_context(md_ctx_t *md_ctx)
 {
     int rc = 0;
     md_module_t *module = NULL;
+    md_ctx_t *parsed_ctx = NULL;
+
+    if (NULL == md_ctx->ly_ctx) {
+        /* loaded from the snapshot, which keeps neither the schemas nor the data tree:
+         * validate the context parsed from the data file and compare the graphs */
+        rc = md_init(TEST_SCHEMA_SEARCH_DIR, TEST_SCHEMA_SEARCH_DIR "internal",
+                     TEST_DATA_SEARCH_DIR "internal", true, &parsed_ctx);
+        assert_int_equal_bt(SR_ERR_OK, rc);
+        assert_non_null_bt(parsed_ctx->ly_ctx);
+        validate_context(parsed_ctx);
+        compare_contexts(md_ctx, parsed_ctx);
+        md_destroy(parsed_ctx);
+        return;
+    }
 
     /* validate module A */
     rc = md_get_module_info(md_ctx, TEST_MODULE_PREFIX "A", NULL, NULL, &module);
@@ -1527,6 +1630,45 @@ validate_context(md_ctx_t *md_ctx)
     }
 }
 
+/**
+ * @brief Test initialization and destruction of the Module Dependencies context.
+ */
+static void
+md_test_init_and_destroy(void **state)
+{
+    int rc;
+    md_ctx_t *md_ctx = NULL, *snapshot_ctx = NULL;
+
+    /* make sure the data file gets parsed */
+    unlink(TEST_DATA_SEARCH_DIR "internal/sysrepo-module-dependencies.snapshot");
+
+    /* initialize context */
+    rc = md_init(TEST_SCHEMA_SEARCH_DIR, TEST_SCHEMA_SEARCH_DIR "internal",
+                 TEST_DATA_SEARCH_DIR "internal", false, &md_ctx);
+    assert_int_equal(0, rc);
+    assert_non_null(md_ctx->schema_search_dir);
+    assert_int_equal(md_ctx->fd, -1);
+    assert_non_null(md_ctx->ly_ctx);
+    assert_non_null(md_ctx->data_tree);
+    assert_non_null(md_ctx->modules);
+    assert_non_null(md_ctx->modules_btree);
+
+    /* the snapshot stored by the first initialization is used now */
+    rc = md_init(TEST_SCHEMA_SEARCH_DIR, TEST_SCHEMA_SEARCH_DIR "internal",
+                 TEST_DATA_SEARCH_DIR "internal", false, &snapshot_ctx);
+    assert_int_equal(0, rc);
+    assert_int_equal(snapshot_ctx->fd, -1);
+    assert_null(snapshot_ctx->ly_ctx);
+    assert_null(snapshot_ctx->data_tree);
+
+    /* the graph loaded from the snapshot matches the graph parsed from the data file */
+    compare_contexts(snapshot_ctx, md_ctx);
+
+    /* destroy contexts */
+    md_destroy(snapshot_ctx);
+    md_destroy(md_ctx);
+}
+
 /*
  * @brief Test md_insert_module().
  */
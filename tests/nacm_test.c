@@ -36,6 +36,7 @@
 #include "test_data.h"
 #include "rp_internal.h"
 #include "rp_dt_get.h"
+#include "rp_dt_filter.h"
 #include "rp_dt_context_helper.h"
 #include "test_module_helper.h"
 #include "nacm_module_helper.h"
@@ -129,15 +130,15 @@ node_get_child(sr_node_t *parent, const char *child_name)
     return NULL;
 }
 
-static void
-verify_tree_size(sr_node_t *root, size_t expected)
+static size_t
+get_tree_size(sr_node_t *root)
 {
     sr_node_t *node = NULL, *child = NULL, *next = NULL;
     size_t node_cnt = 0;
     bool backtrack = false;
 
     if (NULL == root) {
-        assert_int_equal_bt(0, expected);
+        return 0;
     }
 
     node = root;
@@ -162,7 +163,13 @@ verify_tree_size(sr_node_t *root, size_t expected)
         }
     } while (node != root);
 
-    assert_int_equal_bt(expected, node_cnt);
+    return node_cnt;
+}
+
+static void
+verify_tree_size(sr_node_t *root, size_t expected)
+{
+    assert_int_equal_bt(expected, get_tree_size(root));
 }
 
 void
@@ -990,6 +997,13 @@ nacm_test_rules(void **state)
     assert_int_equal(NACM_ACCESS_READ, rule->access);
     assert_int_equal(NACM_ACTION_PERMIT, rule->action);
     assert_string_equal("This is rule5.", rule->comment);
+    /*  -> index of data-oriented rules */
+    verify_sr_list_size(nacm_ctx->module_rules, 3);
+    assert_string_equal("deny-ncm", ((nacm_rule_t *)nacm_ctx->module_rules->data[0])->name);
+    assert_string_equal("default-rule", ((nacm_rule_t *)nacm_ctx->module_rules->data[1])->name);
+    assert_string_equal("rule4", ((nacm_rule_t *)nacm_ctx->module_rules->data[2])->name);
+    assert_int_equal(1, ((nacm_rule_t *)nacm_ctx->module_rules->data[2])->rule_list_idx);
+    verify_sr_btree_size(nacm_ctx->data_rules, 2);
 
     /* deallocate NACM config */
     delete_nacm_config(nacm_config);
@@ -3368,6 +3382,163 @@ nacm_test_read_access_with_empty_config(void **state)
     }
 }
 
+/**
+ * @brief Context of a tree pruning callback counting the calls of the pruning callback of Request Processor.
+ */
+typedef struct counting_pruning_ctx_s {
+    sr_tree_pruning_cb pruning_cb;
+    void *pruning_ctx;
+    size_t call_cnt;
+} counting_pruning_ctx_t;
+
+static int
+counting_tree_pruning(void *pruning_ctx_p, const struct lyd_node *subtree, bool *prune, bool *keep_subtree)
+{
+    counting_pruning_ctx_t *pruning_ctx = (counting_pruning_ctx_t *)pruning_ctx_p;
+
+    ++pruning_ctx->call_cnt;
+    return pruning_ctx->pruning_cb(pruning_ctx->pruning_ctx, subtree, prune, keep_subtree);
+}
+
+static void
+nacm_test_read_access_uniform_subtrees(void **state)
+{
+    int rc = 0;
+    dm_ctx_t *dm_ctx = rp_ctx->dm_ctx;
+    rp_session_t *rp_session[2] = {NULL,};
+    struct lyd_node *data_tree[2] = {NULL,};
+    test_nacm_cfg_t *nacm_config = NULL;
+    nacm_ctx_t *nacm_ctx = get_nacm_ctx();
+    sr_tree_pruning_cb pruning_cb = NULL;
+    rp_tree_pruning_ctx_t *pruning_ctx = NULL;
+    counting_pruning_ctx_t counting_ctx = {NULL,};
+    struct ly_set *nodes = NULL;
+    sr_node_t *subtree = NULL, *subtrees = NULL;
+    sr_val_t *value = NULL;
+    size_t count = 0, full_size = 0;
+    bool uniform = false;
+
+    /* datastore content */
+    createDataTreeTestModule();
+
+    /* NACM config: a rule denying read access to a leaf below a permitted list,
+     * no more specific rule below the permitted main container */
+    new_nacm_config(&nacm_config);
+    set_nacm_read_dflt(nacm_config, "deny");
+    add_nacm_user(nacm_config, "user1", "group1");
+    add_nacm_rule_list(nacm_config, "acl1", "group1", NULL);
+    assert_non_null(ly_ctx_load_module(nacm_config->ly_ctx, "test-module", NULL));
+    add_nacm_rule(nacm_config, "acl1", "deny-list-union", "test-module", NACM_RULE_DATA,
+            "/test-module:list/union", "read", "deny", NULL);
+    add_nacm_rule(nacm_config, "acl1", "permit-list", "test-module", NACM_RULE_DATA,
+            "/test-module:list", "read", "permit", NULL);
+    add_nacm_rule(nacm_config, "acl1", "permit-main", "test-module", NACM_RULE_DATA,
+            "/test-module:main", "read", "permit", NULL);
+    save_nacm_config(nacm_config);
+    nacm_reload(nacm_ctx, SR_DS_STARTUP);
+    delete_nacm_config(nacm_config);
+
+    /* session 0 with NACM enabled, session 1 without */
+    for (int i = 0; i < 2; ++i) {
+        test_rp_session_create_user(rp_ctx, SR_DS_STARTUP, user_credentials[0],
+                0 == i ? SR_SESS_ENABLE_NACM : SR_SESS_DEFAULT, &rp_session[i]);
+        rc = dm_get_datatree(dm_ctx, rp_session[i]->dm_session, "test-module", &data_tree[i]);
+        assert_int_equal(SR_ERR_OK, rc);
+        assert_non_null(data_tree[i]);
+    }
+
+    /* -> /test-module:main is uniformly permitted, it is copied without the pruning callback */
+#define TEST_MODULE_MAIN "/test-module:main"
+    nodes = lyd_find_path(data_tree[0], TEST_MODULE_MAIN);
+    assert_non_null(nodes);
+    assert_int_equal(1, nodes->number);
+    rc = rp_dt_init_tree_pruning(dm_ctx, rp_session[0], nodes->set.d[0], data_tree[0], false, &pruning_cb, &pruning_ctx);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_null(pruning_cb);
+    assert_non_null(pruning_ctx->nacm_data_val_ctx);
+    rc = nacm_check_data_read_subtree(pruning_ctx->nacm_data_val_ctx, nodes->set.d[0], &uniform);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_true(uniform);
+    rp_dt_cleanup_tree_pruning(pruning_ctx);
+    pruning_ctx = NULL;
+
+    rc = rp_dt_get_subtree(dm_ctx, rp_session[1], data_tree[1], NULL, TEST_MODULE_MAIN, false, &subtree);
+    assert_int_equal(SR_ERR_OK, rc);
+    full_size = get_tree_size(subtree);
+    sr_free_tree(subtree);
+    rc = rp_dt_get_subtree(dm_ctx, rp_session[0], data_tree[0], NULL, TEST_MODULE_MAIN, false, &subtree);
+    assert_int_equal(SR_ERR_OK, rc);
+    verify_tree_size(subtree, full_size);   /* the whole subtree */
+    sr_free_tree(subtree);
+
+    /*    -> the callback is called only for the root of the subtree, not for its descendants */
+    rc = rp_dt_init_tree_pruning(dm_ctx, rp_session[0], NULL, data_tree[0], false, &pruning_cb, &pruning_ctx);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_non_null(pruning_cb);
+    counting_ctx.pruning_cb = pruning_cb;
+    counting_ctx.pruning_ctx = pruning_ctx;
+    counting_ctx.call_cnt = 0;
+    rc = sr_nodes_to_trees(nodes, NULL, counting_tree_pruning, &counting_ctx, &subtrees, &count);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(1, count);
+    assert_int_equal(1, counting_ctx.call_cnt);
+    verify_tree_size(subtrees, full_size);
+    sr_free_trees(subtrees, count);
+    rp_dt_cleanup_tree_pruning(pruning_ctx);
+    pruning_ctx = NULL;
+    ly_set_free(nodes);
+
+    /* -> /test-module:list[key='k1'] is permitted, but the deny rule below it is still enforced */
+    nodes = lyd_find_path(data_tree[0], "/test-module:list[key='k1']");
+    assert_non_null(nodes);
+    assert_int_equal(1, nodes->number);
+    rc = rp_dt_init_tree_pruning(dm_ctx, rp_session[0], nodes->set.d[0], data_tree[0], false, &pruning_cb, &pruning_ctx);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_non_null(pruning_cb);
+    rc = nacm_check_data_read_subtree(pruning_ctx->nacm_data_val_ctx, nodes->set.d[0], &uniform);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_false(uniform);
+    rp_dt_cleanup_tree_pruning(pruning_ctx);
+    pruning_ctx = NULL;
+    ly_set_free(nodes);
+
+    rc = rp_dt_get_value(dm_ctx, rp_session[0], data_tree[0], NULL, "/test-module:list[key='k1']/union", false, &value);
+    assert_int_equal(SR_ERR_NOT_FOUND, rc); /* access denied */
+    rc = rp_dt_get_value(dm_ctx, rp_session[0], data_tree[0], NULL, "/test-module:list[key='k1']/key", false, &value);
+    assert_int_equal(SR_ERR_OK, rc);        /* access allowed */
+    sr_free_val(value);
+    rc = rp_dt_get_subtree(dm_ctx, rp_session[0], data_tree[0], NULL, "/test-module:list[key='k1']", false, &subtree);
+    assert_int_equal(SR_ERR_OK, rc);
+    verify_tree_size(subtree, 4);           /* all but union */
+    assert_null(node_get_child(subtree, "union"));
+    sr_free_tree(subtree);
+
+    /*    -> the callback is called for the descendants of the list entries as well */
+    nodes = lyd_find_path(data_tree[0], "/test-module:list");
+    assert_non_null(nodes);
+    assert_int_equal(2, nodes->number);
+    rc = rp_dt_init_tree_pruning(dm_ctx, rp_session[0], NULL, data_tree[0], false, &pruning_cb, &pruning_ctx);
+    assert_int_equal(SR_ERR_OK, rc);
+    counting_ctx.pruning_cb = pruning_cb;
+    counting_ctx.pruning_ctx = pruning_ctx;
+    counting_ctx.call_cnt = 0;
+    rc = sr_nodes_to_trees(nodes, NULL, counting_tree_pruning, &counting_ctx, &subtrees, &count);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(2, count);
+    assert_true(counting_ctx.call_cnt > count);
+    for (size_t i = 0; i < count; ++i) {
+        assert_null(node_get_child(subtrees+i, "union"));
+    }
+    sr_free_trees(subtrees, count);
+    rp_dt_cleanup_tree_pruning(pruning_ctx);
+    ly_set_free(nodes);
+
+    /* cleanup */
+    for (int i = 0; i < 2; ++i) {
+        test_rp_session_cleanup(rp_ctx, rp_session[i]);
+    }
+}
+
 int main() {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(nacm_test_empty_config),
@@ -3383,6 +3554,7 @@ int main() {
             cmocka_unit_test(nacm_test_read_access_with_disabled_nacm),
             cmocka_unit_test(nacm_test_read_access_denied_by_default),
             cmocka_unit_test(nacm_test_read_access_with_empty_config),
+            cmocka_unit_test(nacm_test_read_access_uniform_subtrees),
     };
 
     sr_log_stderr(SR_LL_DBG);
@@ -22,6 +22,8 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
 #include <setjmp.h>
 #include <cmocka.h>
 
@@ -99,17 +101,17 @@ np_tmp_subscription_test(void **state)
 
     /* create subscription 1 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_INSTALL_SUBS,
-            "addr1", 123, NULL, NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
+            "addr1", 123, NULL, NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* create subscription 2 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_INSTALL_SUBS,
-            "addr2", 123, NULL, NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
+            "addr2", 123, NULL, NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* create subscription 3 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__FEATURE_ENABLE_SUBS,
-            "addr1", 456, NULL, NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
+            "addr1", 456, NULL, NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* module install notify */
@@ -146,38 +148,38 @@ np_persistent_subscription_test(void **state)
 
     /* create subscription to example-module @ addr1 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS,
-            "addr1", 123, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
+            "addr1", 123, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* create subscription to test-module @ addr1 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS,
-            "addr1", 456, "test-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
+            "addr1", 456, "test-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* create subscription to small-module @ addr1 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS,
-            "addr1", 789, "small-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
+            "addr1", 789, "small-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* create subscription to test-module @ addr1 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__EVENT_NOTIF_SUBS,
-            "addr1", 999, "test-module", "/test-module:link-removed", "user2", SR__NOTIFICATION_EVENT__APPLY_EV, 0,
+            "addr1", 999, "test-module", "/test-module:link-removed", "user2", SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0,
             SR_API_VALUES, NP_SUBSCR_DEFAULT);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* create subscription to example-module @ addr2 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS,
-            "addr2", 123, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
+            "addr2", 123, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* create subscription to test-module @ addr2 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS,
-            "addr2", 456, "test-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
+            "addr2", 456, "test-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* create subscription to test-module @ addr2 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__EVENT_NOTIF_SUBS,
-            "addr2", 789, "test-module", "/test-module:link-discovered", "user1", SR__NOTIFICATION_EVENT__APPLY_EV, 0,
+            "addr2", 789, "test-module", "/test-module:link-discovered", "user1", SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0,
             SR_API_VALUES, NP_SUBSCR_DEFAULT);
     assert_int_equal(rc, SR_ERR_OK);
 
@@ -220,12 +222,12 @@ np_negative_subscription_test(void **state)
 
     /* subscribe */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS,
-            "addr2", 456, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
+            "addr2", 456, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* try to subscribe again for the same */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS,
-            "addr2", 456, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
+            "addr2", 456, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_DATA_EXISTS);
 
     /* try to unsubscribe from module-change subscription without specifying module name */
@@ -291,16 +293,16 @@ np_module_subscriptions_test(void **state)
 
     /* subscribe */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS,
-            "addr3", 123, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__VERIFY_EV, 10, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
+            "addr3", 123, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__VERIFY_EV, 10, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__SUBTREE_CHANGE_SUBS,
-            "addr3", 456, "example-module", "/example-module:container", NULL, SR__NOTIFICATION_EVENT__VERIFY_EV, 20,
+            "addr3", 456, "example-module", "/example-module:container", NULL, SR__NOTIFICATION_EVENT__VERIFY_EV, 20, 0,
             SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__SUBTREE_CHANGE_SUBS,
-            "addr3", 789, "example-module", "/example-module:container", NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 20,
+            "addr3", 789, "example-module", "/example-module:container", NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 20, 0,
             SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
@@ -321,7 +323,7 @@ np_module_subscriptions_test(void **state)
                 (SR__NOTIFICATION_EVENT__APPLY_EV == subscription->notif_event));
 
         /* notify */
-        rc = np_subscription_notify(np_ctx, subscription, SR_EV_APPLY, 0);
+        rc = np_subscription_notify(np_ctx, subscription, SR_EV_APPLY, 0, NULL);
         assert_int_equal(rc, SR_ERR_OK);
     }
 
@@ -362,12 +364,12 @@ np_dp_subscriptions_test(void **state)
     /* subscribe */
 
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__DP_GET_ITEMS_SUBS,
-            "addr4", 789, "example-module", "/example-module:container", NULL, SR__NOTIFICATION_EVENT__VERIFY_EV, 20,
+            "addr4", 789, "example-module", "/example-module:container", NULL, SR__NOTIFICATION_EVENT__VERIFY_EV, 20, 0,
             SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__DP_GET_ITEMS_SUBS,
-            "addr5", 1011, "example-module", "/example-module:container", NULL, SR__NOTIFICATION_EVENT__VERIFY_EV, 20,
+            "addr5", 1011, "example-module", "/example-module:container", NULL, SR__NOTIFICATION_EVENT__VERIFY_EV, 20, 0,
             SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
@@ -453,6 +455,240 @@ np_notif_store_test(void **state)
 #endif
 }
 
+static size_t
+np_notif_store_count(test_ctx_t *test_ctx, const char *xpath, time_t start_time, time_t stop_time)
+{
+    sr_list_t *notif_list = NULL;
+    size_t count = 0;
+    int rc = SR_ERR_OK;
+
+    rc = np_get_event_notifications(test_ctx->rp_ctx->np_ctx, test_ctx->rp_session_ctx, xpath, start_time, stop_time,
+            SR_API_VALUES, &notif_list);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    if (NULL != notif_list) {
+        count = notif_list->count;
+        for (size_t i = 0; i < notif_list->count; i++) {
+            np_ev_notification_t *notification = notif_list->data[i];
+            assert_true(notification->timestamp >= start_time && notification->timestamp <= stop_time);
+            np_event_notification_cleanup(notification);
+        }
+        sr_list_cleanup(notif_list);
+    }
+
+    return count;
+}
+
+static void
+np_notif_store_time_range_test(void **state)
+{
+#ifndef ENABLE_NOTIF_STORE
+    skip();
+#else
+    int rc = SR_ERR_OK;
+    test_ctx_t *test_ctx = *state;
+    assert_non_null(test_ctx);
+    np_ctx_t *np_ctx = test_ctx->rp_ctx->np_ctx;
+
+    struct ly_ctx *ctx = NULL;
+    struct lyd_node *discovered = NULL, *removed = NULL;
+    time_t now = time(NULL);
+    size_t discovered_cnt = 0, removed_cnt = 0, module_cnt = 0, older_cnt = 0;
+
+    ctx = ly_ctx_new(TEST_SCHEMA_SEARCH_DIR, 0);
+    assert_non_null(ctx);
+    assert_non_null(ly_ctx_load_module(ctx, "test-module", NULL));
+    discovered = lyd_new_path(NULL, ctx, "/test-module:link-discovered/source/interface", "eth1", 0, 0);
+    assert_non_null(discovered);
+    removed = lyd_new_path(NULL, ctx, "/test-module:link-removed/source/interface", "eth1", 0, 0);
+    assert_non_null(removed);
+
+    /* notifications possibly stored before */
+    discovered_cnt = np_notif_store_count(test_ctx, "/test-module:link-discovered", now, now);
+    removed_cnt = np_notif_store_count(test_ctx, "/test-module:link-removed", now, now);
+    module_cnt = np_notif_store_count(test_ctx, "test-module", now, now);
+    older_cnt = np_notif_store_count(test_ctx, "/test-module:link-discovered", now - 10, now - 10);
+
+    /* store a bunch of notifications, enough to get the segment indexed */
+    for (size_t i = 0; i < 500; i++) {
+        rc = np_store_event_notification(np_ctx, test_ctx->rp_session_ctx->user_credentials,
+                "/test-module:link-discovered", now, discovered);
+        assert_int_equal(rc, SR_ERR_OK);
+    }
+    rc = np_store_event_notification(np_ctx, test_ctx->rp_session_ctx->user_credentials,
+            "/test-module:link-removed", now, removed);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = np_store_event_notification(np_ctx, test_ctx->rp_session_ctx->user_credentials,
+            "/test-module:link-discovered", now - 10, discovered);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* retrieve them by xpath, module and time interval */
+    assert_int_equal(np_notif_store_count(test_ctx, "/test-module:link-discovered", now, now), discovered_cnt + 500);
+    assert_int_equal(np_notif_store_count(test_ctx, "/test-module:link-removed", now, now), removed_cnt + 1);
+    assert_int_equal(np_notif_store_count(test_ctx, "test-module", now, now), module_cnt + 501);
+    assert_int_equal(np_notif_store_count(test_ctx, "/test-module:link-discovered", now - 10, now - 10), older_cnt + 1);
+
+    lyd_free_withsiblings(discovered);
+    lyd_free_withsiblings(removed);
+    ly_ctx_destroy(ctx, NULL);
+#endif
+}
+
+/**
+ * @brief Composes the name of the notification store segment holding notifications of the module
+ * generated at given time.
+ */
+static void
+np_notif_store_segment_name(const char *module_name, time_t generated_time, char *filename, size_t filename_size)
+{
+    struct tm *tm_time = localtime(&generated_time);
+
+    generated_time -= (((tm_time->tm_hour * 60) + tm_time->tm_min) % SR_NOTIF_TIME_WINDOW) * 60;
+    snprintf(filename, filename_size, "%s/%s/", SR_NOTIF_DATA_SEARCH_DIR, module_name);
+    strftime(filename + strlen(filename), filename_size - strlen(filename), "%Y-%m-%d_%H-%M.log",
+            localtime(&generated_time));
+}
+
+static void
+np_notif_store_torn_record_test(void **state)
+{
+#ifndef ENABLE_NOTIF_STORE
+    skip();
+#else
+    int rc = SR_ERR_OK;
+    test_ctx_t *test_ctx = *state;
+    assert_non_null(test_ctx);
+
+    struct ly_ctx *ctx = NULL;
+    struct lyd_node *removed = NULL;
+    char segment_filename[PATH_MAX] = { 0, };
+    char buff[32] = { 0, };
+    time_t now = time(NULL);
+    size_t removed_cnt = 0;
+    int fd = -1;
+
+    ctx = ly_ctx_new(TEST_SCHEMA_SEARCH_DIR, 0);
+    assert_non_null(ctx);
+    assert_non_null(ly_ctx_load_module(ctx, "test-module", NULL));
+    removed = lyd_new_path(NULL, ctx, "/test-module:link-removed/source/interface", "eth3", 0, 0);
+    assert_non_null(removed);
+
+    rc = np_store_event_notification(test_ctx->rp_ctx->np_ctx, test_ctx->rp_session_ctx->user_credentials,
+            "/test-module:link-removed", now, removed);
+    assert_int_equal(rc, SR_ERR_OK);
+    removed_cnt = np_notif_store_count(test_ctx, "/test-module:link-removed", now, now);
+
+    /* simulate a crash in the middle of an append: the copy of the first record header
+     * followed by just a part of its payload */
+    np_notif_store_segment_name("test-module", now, segment_filename, PATH_MAX);
+    fd = open(segment_filename, O_RDWR | O_APPEND);
+    assert_int_not_equal(fd, -1);
+    assert_int_equal(pread(fd, buff, sizeof(buff), 0), sizeof(buff));
+    assert_int_equal(write(fd, buff, sizeof(buff)), sizeof(buff));
+    close(fd);
+
+    /* restart the engine, as after the crash */
+    test_rp_session_cleanup(test_ctx->rp_ctx, test_ctx->rp_session_ctx);
+    test_rp_ctx_cleanup(test_ctx->rp_ctx);
+    test_rp_ctx_create(CM_MODE_LOCAL, &test_ctx->rp_ctx);
+    test_rp_session_create(test_ctx->rp_ctx, SR_DS_RUNNING, &test_ctx->rp_session_ctx);
+
+    /* the incomplete record is dropped and the records appended after it are readable */
+    rc = np_store_event_notification(test_ctx->rp_ctx->np_ctx, test_ctx->rp_session_ctx->user_credentials,
+            "/test-module:link-removed", now, removed);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(np_notif_store_count(test_ctx, "/test-module:link-removed", now, now), removed_cnt + 1);
+
+    lyd_free_withsiblings(removed);
+    ly_ctx_destroy(ctx, NULL);
+#endif
+}
+
+static void
+np_notif_store_legacy_test(void **state)
+{
+#ifndef ENABLE_NOTIF_STORE
+    skip();
+#else
+    int rc = SR_ERR_OK;
+    test_ctx_t *test_ctx = *state;
+    assert_non_null(test_ctx);
+
+    struct ly_ctx *ctx = NULL, *ns_ctx = NULL;
+    struct lyd_node *removed = NULL, *legacy_tree = NULL;
+    struct ly_set *entries = NULL;
+    char legacy_filename[PATH_MAX] = { 0, };
+    char segment_filename[PATH_MAX] = { 0, };
+    char entry_xpath[PATH_MAX] = { 0, };
+    char time_buf[64] = { 0, };
+    char *data = NULL;
+    time_t generated_time = time(NULL) - 20;
+    size_t removed_cnt = 0;
+    int fd = -1;
+
+    ctx = ly_ctx_new(TEST_SCHEMA_SEARCH_DIR, 0);
+    assert_non_null(ctx);
+    assert_non_null(ly_ctx_load_module(ctx, "test-module", NULL));
+    removed = lyd_new_path(NULL, ctx, "/test-module:link-removed/source/interface", "eth4", 0, 0);
+    assert_non_null(removed);
+
+    /* makes sure the directory of the module exists */
+    rc = np_store_event_notification(test_ctx->rp_ctx->np_ctx, test_ctx->rp_session_ctx->user_credentials,
+            "/test-module:link-removed", generated_time, removed);
+    assert_int_equal(rc, SR_ERR_OK);
+    removed_cnt = np_notif_store_count(test_ctx, "/test-module:link-removed", generated_time, generated_time);
+
+    /* store two notifications in the format of older sysrepo versions: one data tree per time window */
+    ns_ctx = ly_ctx_new(TEST_INTERNAL_SCHEMA_SEARCH_DIR, 0);
+    assert_non_null(ns_ctx);
+    assert_non_null(lys_parse_path(ns_ctx, TEST_INTERNAL_SCHEMA_SEARCH_DIR "sysrepo-notification-store.yang", LYS_IN_YANG));
+    sr_time_to_str(generated_time, time_buf, sizeof(time_buf));
+    for (size_t i = 0; i < 2; i++) {
+        snprintf(entry_xpath, PATH_MAX, "/sysrepo-notification-store:notifications/notification"
+                "[xpath='/test-module:link-removed'][generated-time='%s'][logged-time='%zu']", time_buf, i + 1);
+        if (NULL == legacy_tree) {
+            legacy_tree = lyd_new_path(NULL, ns_ctx, entry_xpath, NULL, 0, 0);
+            assert_non_null(legacy_tree);
+        } else {
+            assert_non_null(lyd_new_path(legacy_tree, ns_ctx, entry_xpath, NULL, 0, 0));
+        }
+    }
+    entries = lyd_find_path(legacy_tree, "/sysrepo-notification-store:notifications/notification");
+    assert_non_null(entries);
+    assert_int_equal(entries->number, 2);
+    for (size_t i = 0; i < entries->number; i++) {
+        assert_int_equal(lyd_print_mem(&data, removed, SR_TEXT_FORMAT_LY, LYP_WITHSIBLINGS), 0);
+        assert_non_null(lyd_new_anydata(entries->set.d[i], NULL, "data", data,
+                (LYD_JSON == SR_TEXT_FORMAT_LY) ? LYD_ANYDATA_JSOND : LYD_ANYDATA_SXMLD));
+    }
+    ly_set_free(entries);
+
+    snprintf(legacy_filename, PATH_MAX, "%s/test-module/2000-01-01_00-00." SR_TEXT_FORMAT_EXT, SR_NOTIF_DATA_SEARCH_DIR);
+    snprintf(segment_filename, PATH_MAX, "%s/test-module/2000-01-01_00-00.log", SR_NOTIF_DATA_SEARCH_DIR);
+    fd = open(legacy_filename, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    assert_int_not_equal(fd, -1);
+    assert_int_equal(lyd_print_fd(fd, legacy_tree, SR_TEXT_FORMAT_LY, LYP_WITHSIBLINGS | LYP_FORMAT | LYP_WD_EXPLICIT), 0);
+    close(fd);
+
+    /* the file is converted into a segment when the engine starts */
+    test_rp_session_cleanup(test_ctx->rp_ctx, test_ctx->rp_session_ctx);
+    test_rp_ctx_cleanup(test_ctx->rp_ctx);
+    test_rp_ctx_create(CM_MODE_LOCAL, &test_ctx->rp_ctx);
+    test_rp_session_create(test_ctx->rp_ctx, SR_DS_RUNNING, &test_ctx->rp_session_ctx);
+
+    assert_int_equal(access(legacy_filename, F_OK), -1);
+    assert_int_equal(access(segment_filename, F_OK), 0);
+    assert_int_equal(np_notif_store_count(test_ctx, "/test-module:link-removed", generated_time, generated_time),
+            removed_cnt + 2);
+
+    unlink(segment_filename);
+    lyd_free_withsiblings(legacy_tree);
+    lyd_free_withsiblings(removed);
+    ly_ctx_destroy(ns_ctx, NULL);
+    ly_ctx_destroy(ctx, NULL);
+#endif
+}
+
 int
 main() {
     const struct CMUnitTest tests[] = {
@@ -463,6 +699,9 @@ main() {
             cmocka_unit_test_setup_teardown(np_module_subscriptions_test, test_setup, test_teardown),
             cmocka_unit_test_setup_teardown(np_dp_subscriptions_test, test_setup, test_teardown),
             cmocka_unit_test_setup_teardown(np_notif_store_test, test_setup, test_teardown),
+            cmocka_unit_test_setup_teardown(np_notif_store_time_range_test, test_setup, test_teardown),
+            cmocka_unit_test_setup_teardown(np_notif_store_torn_record_test, test_setup, test_teardown),
+            cmocka_unit_test_setup_teardown(np_notif_store_legacy_test, test_setup, test_teardown),
     };
 
     watchdog_start(300);
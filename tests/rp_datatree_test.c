@@ -26,6 +26,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <unistd.h>
 #include "data_manager.h"
 #include "test_data.h"
 #include "sr_common.h"
@@ -1083,10 +1084,7 @@ void get_values_opts_test(void **state) {
 
     sr_val_t *values = NULL;
     size_t count = 0;
-    rp_dt_get_items_ctx_t get_items_ctx;
-    get_items_ctx.nodes = NULL;
-    get_items_ctx.xpath = NULL;
-    get_items_ctx.offset = 0;
+    rp_dt_get_items_ctx_t get_items_ctx = { 0, };
 
 #define EX_CONT "/example-module:container//*"
     struct ly_set *nodes = NULL;
@@ -1117,8 +1115,7 @@ void get_values_opts_test(void **state) {
     }
     sr_free_values(values, count);
 
-    free(get_items_ctx.xpath);
-    ly_set_free(get_items_ctx.nodes);
+    rp_dt_free_get_items_ctx_content(&get_items_ctx);
     lyd_free_withsiblings(root);
 
     test_rp_session_cleanup(ctx, ses_ctx);
@@ -1376,6 +1373,61 @@ void get_nodes_test(void **state){
 
 }
 
+void get_node_in_large_list_test(void **state)
+{
+    int rc = 0;
+    rp_ctx_t *rp_ctx = *state;
+    dm_ctx_t *ctx = rp_ctx->dm_ctx;
+    dm_session_t *ses_ctx = NULL;
+    struct lyd_node *data_tree = NULL, *root = NULL, *node = NULL;
+    struct ly_ctx *ly_ctx = NULL;
+    char xpath[256] = { 0, }, key[16] = { 0, };
+    dm_session_start(ctx, NULL, SR_DS_STARTUP, &ses_ctx);
+
+    rc = dm_get_datatree(ctx, ses_ctx, "example-module", &data_tree);
+    assert_int_equal(SR_ERR_OK, rc);
+    ly_ctx = data_tree->schema->module->ctx;
+
+    for (int i = 0; i < 1000; i++) {
+        snprintf(xpath, sizeof xpath, "/example-module:container/list[key1='k%d'][key2='k%d']/leaf", i, i % 7);
+        node = lyd_new_path(root, ly_ctx, xpath, "value", 0, 0);
+        assert_non_null(node);
+        if (NULL == root) {
+            root = node;
+        }
+    }
+
+    /* fully keyed xpaths are looked up without the xpath engine */
+    for (int i = 0; i < 1000; i += 99) {
+        snprintf(xpath, sizeof xpath, "/example-module:container/list[key2='k%d'][key1='k%d']/leaf", i % 7, i);
+        rc = rp_dt_find_node(ctx, root, xpath, false, &node);
+        assert_int_equal(SR_ERR_OK, rc);
+        assert_string_equal("leaf", node->schema->name);
+        /* key1 is the first child of the list instance */
+        snprintf(key, sizeof key, "k%d", i);
+        assert_string_equal(key, ((struct lyd_node_leaf_list *) node->parent->child)->value_str);
+    }
+
+    rc = rp_dt_find_node(ctx, root, "/example-module:container/list[key1='k1'][key2='k2']", false, &node);
+    assert_int_equal(SR_ERR_NOT_FOUND, rc);
+
+    /* removed instance is not found anymore, the added one is */
+    rc = rp_dt_find_node(ctx, root, "/example-module:container/list[key1='k500'][key2='k3']", false, &node);
+    assert_int_equal(SR_ERR_OK, rc);
+    lyd_free(node);
+    rc = rp_dt_find_node(ctx, root, "/example-module:container/list[key1='k500'][key2='k3']", false, &node);
+    assert_int_equal(SR_ERR_NOT_FOUND, rc);
+
+    node = lyd_new_path(root, ly_ctx, "/example-module:container/list[key1='new'][key2='k\"1']/leaf", "value", 0, 0);
+    assert_non_null(node);
+    rc = rp_dt_find_node(ctx, root, "/example-module:container/list[key1='new'][key2='k\"1']/leaf", false, &node);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_string_equal("value", ((struct lyd_node_leaf_list *) node)->value_str);
+
+    lyd_free_withsiblings(root);
+    dm_session_stop(ctx, ses_ctx);
+}
+
 void get_node_test_not_found(void **state)
 {
     int rc = 0;
@@ -1491,10 +1543,7 @@ get_nodes_with_opts_cache_missed_test(void **state)
     test_rp_session_create(ctx, SR_DS_STARTUP, &ses_ctx);
     sr_val_t *values = NULL;
     size_t count = 0;
-    rp_dt_get_items_ctx_t get_items_ctx;
-    get_items_ctx.nodes = NULL;
-    get_items_ctx.xpath = NULL;
-    get_items_ctx.offset = 0;
+    rp_dt_get_items_ctx_t get_items_ctx = { 0, };
 
     rc = rp_dt_get_values_wrapper_with_opts(ctx, ses_ctx, &get_items_ctx, NULL, "/test-module:list[key='k1']/*", 0, 2, &values, &count);
     assert_int_equal(rc, SR_ERR_OK);
@@ -1513,8 +1562,7 @@ get_nodes_with_opts_cache_missed_test(void **state)
     rc = rp_dt_get_values_wrapper_with_opts(ctx, ses_ctx, &get_items_ctx, NULL, "/test-module:list[key='k1']/*", 4, 2, &values, &count);
     assert_int_equal(rc, SR_ERR_NOT_FOUND);
 
-    free(get_items_ctx.xpath);
-    ly_set_free(get_items_ctx.nodes);
+    rp_dt_free_get_items_ctx_content(&get_items_ctx);
 
     test_rp_session_cleanup(ctx, ses_ctx);
 }
@@ -1898,11 +1946,210 @@ union_test(void **state)
     test_rp_session_cleanup(ctx, ses_ctx);
 }
 
+void
+get_gpb_values_wrapper_test(void **state)
+{
+    int rc = 0;
+    rp_ctx_t *ctx = *state;
+    rp_session_t *ses_ctx = NULL;
+    sr_mem_ctx_t *sr_mem = NULL;
+    sr_val_t *values = NULL, *gpb_val = NULL;
+    Sr__Value **gpb_values = NULL;
+    size_t count = 0, gpb_count = 0;
+    char *str = NULL, *gpb_str = NULL;
+    rp_dt_get_items_ctx_t get_items_ctx = { 0, };
+
+#define TM_MAIN_ALL "/test-module:main/*"
+    test_rp_session_create(ctx, SR_DS_STARTUP, &ses_ctx);
+
+    rc = rp_dt_get_values_wrapper(ctx, ses_ctx, NULL, TM_MAIN_ALL, &values, &count);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    rc = sr_mem_new(0, &sr_mem);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    ses_ctx->state = RP_REQ_NEW;
+    rc = rp_dt_get_gpb_values_wrapper(ctx, ses_ctx, sr_mem, TM_MAIN_ALL, &gpb_values, &gpb_count);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(count, gpb_count);
+
+    /* the values encoded directly from nodes must match the sr_val_t path */
+    for (size_t i = 0; i < count; i++) {
+        rc = sr_dup_gpb_to_val_t(NULL, gpb_values[i], &gpb_val);
+        assert_int_equal(SR_ERR_OK, rc);
+        assert_string_equal(values[i].xpath, gpb_val->xpath);
+        assert_int_equal(values[i].type, gpb_val->type);
+        assert_int_equal(values[i].dflt, gpb_val->dflt);
+        str = sr_val_to_str(&values[i]);
+        gpb_str = sr_val_to_str(gpb_val);
+        if (NULL == str) {
+            assert_null(gpb_str);
+        } else {
+            assert_string_equal(str, gpb_str);
+        }
+        free(str);
+        free(gpb_str);
+        sr_free_val(gpb_val);
+    }
+    sr_free_values(values, count);
+
+    /* offset and limit */
+    ses_ctx->state = RP_REQ_NEW;
+    rc = rp_dt_get_gpb_values_wrapper_with_opts(ctx, ses_ctx, &get_items_ctx, sr_mem, TM_MAIN_ALL, 1, 2, &gpb_values, &gpb_count);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(2, gpb_count);
+    assert_true(count > 2);
+
+    ses_ctx->state = RP_REQ_NEW;
+    rc = rp_dt_get_gpb_values_wrapper(ctx, ses_ctx, sr_mem, "/test-module:main/non-existing", &gpb_values, &gpb_count);
+    assert_int_not_equal(SR_ERR_OK, rc);
+
+    sr_mem_free(sr_mem);
+    rp_dt_free_get_items_ctx_content(&get_items_ctx);
+    test_rp_session_cleanup(ctx, ses_ctx);
+}
+
+void
+get_items_cursors_test(void **state)
+{
+    int rc = 0;
+    rp_ctx_t *ctx = *state;
+    rp_session_t *ses_ctx = NULL;
+    rp_dt_get_items_ctx_t *cursor_a = NULL, *cursor_b = NULL, *cursor = NULL;
+    sr_val_t *values = NULL, *all_values = NULL;
+    size_t count = 0, all_count = 0;
+    uint32_t cursor_id = 0;
+
+#define TM_LIST_ALL "/test-module:list/*"
+    test_rp_session_create(ctx, SR_DS_STARTUP, &ses_ctx);
+
+    rc = rp_dt_get_values_wrapper(ctx, ses_ctx, NULL, TM_LIST_ALL, &all_values, &all_count);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_true(all_count > 3);
+
+    /* two cursors of the same session are interleaved */
+    rc = rp_dt_get_items_cursor(ses_ctx, 0, true, 1, &cursor_a);
+    assert_int_equal(SR_ERR_OK, rc);
+    rc = rp_dt_get_items_cursor(ses_ctx, 0, true, 1, &cursor_b);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_not_equal(0, cursor_a->id);
+    assert_int_not_equal(cursor_a->id, cursor_b->id);
+
+    ses_ctx->state = RP_REQ_NEW;
+    rc = rp_dt_get_values_wrapper_with_opts(ctx, ses_ctx, cursor_a, NULL, TM_LIST_ALL, 0, 1, &values, &count);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(1, count);
+    assert_string_equal(all_values[0].xpath, values[0].xpath);
+    sr_free_values(values, count);
+
+    ses_ctx->state = RP_REQ_NEW;
+    rc = rp_dt_get_values_wrapper_with_opts(ctx, ses_ctx, cursor_b, NULL, TM_LIST_ALL, 0, 2, &values, &count);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(2, count);
+    sr_free_values(values, count);
+
+    /* the cursors continue in the snapshot taken by the first page */
+    rc = rp_dt_delete_item_wrapper(ctx, ses_ctx, "/test-module:list", SR_EDIT_DEFAULT);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    rc = rp_dt_get_items_cursor(ses_ctx, cursor_a->id, false, 1, &cursor);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_ptr_equal(cursor_a, cursor);
+    ses_ctx->state = RP_REQ_NEW;
+    rc = rp_dt_get_values_wrapper_with_opts(ctx, ses_ctx, cursor, NULL, TM_LIST_ALL, 1, 2, &values, &count);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(2, count);
+    assert_string_equal(all_values[1].xpath, values[0].xpath);
+    assert_string_equal(all_values[2].xpath, values[1].xpath);
+    sr_free_values(values, count);
+
+    rc = rp_dt_get_items_cursor(ses_ctx, cursor_b->id, false, 1, &cursor);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_ptr_equal(cursor_b, cursor);
+    ses_ctx->state = RP_REQ_NEW;
+    rc = rp_dt_get_values_wrapper_with_opts(ctx, ses_ctx, cursor, NULL, TM_LIST_ALL, 2, 1, &values, &count);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(1, count);
+    assert_string_equal(all_values[2].xpath, values[0].xpath);
+    sr_free_values(values, count);
+
+    /* a closed cursor is replaced by a new one, which sees the current data */
+    cursor_id = cursor_b->id;
+    rp_dt_close_get_items_cursor(ses_ctx, cursor_b);
+    rc = rp_dt_get_items_cursor(ses_ctx, cursor_id, false, 1, &cursor);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_not_equal(cursor_id, cursor->id);
+    assert_null(cursor->snapshot);
+    ses_ctx->state = RP_REQ_NEW;
+    rc = rp_dt_get_values_wrapper_with_opts(ctx, ses_ctx, cursor, NULL, TM_LIST_ALL, 3, 1, &values, &count);
+    assert_int_equal(SR_ERR_NOT_FOUND, rc);
+
+    /* the number of cursors of a session is limited */
+    for (size_t i = 0; i < SR_GET_ITEMS_CURSOR_LIMIT; i++) {
+        rc = rp_dt_get_items_cursor(ses_ctx, 0, true, 1, &cursor);
+        assert_int_equal(SR_ERR_OK, rc);
+    }
+    assert_int_equal(SR_GET_ITEMS_CURSOR_LIMIT, ses_ctx->get_items_cursors->count);
+
+    sr_free_values(all_values, all_count);
+    test_rp_session_cleanup(ctx, ses_ctx);
+}
+
+static size_t
+dp_cache_entry_count(sr_btree_t *tree)
+{
+    size_t count = 0;
+
+    while (NULL != sr_btree_get_at(tree, count)) {
+        count++;
+    }
+    return count;
+}
+
+void
+dp_cache_expiry_test(void **state)
+{
+    int rc = 0;
+    rp_ctx_t *ctx = *state;
+    np_subscription_t subscription_a = { 0, }, subscription_b = { 0, };
+
+    rc = rp_dt_dp_cache_init(ctx);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    subscription_a.dst_address = "/tmp/dp-a.sock";
+    subscription_a.dst_id = 1;
+    subscription_a.cache_ttl = 1;
+    subscription_b.dst_address = "/tmp/dp-b.sock";
+    subscription_b.dst_id = 2;
+    subscription_b.cache_ttl = 60000;
+
+    rc = rp_dt_dp_cache_store(ctx, &subscription_a, "/test-module:main", NULL, 0);
+    assert_int_equal(SR_ERR_OK, rc);
+    rc = rp_dt_dp_cache_store(ctx, &subscription_b, "/test-module:main", NULL, 0);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(2, dp_cache_entry_count(ctx->dp_cache));
+
+    /* the expired entry is dropped by the next store */
+    usleep(10000);
+    rc = rp_dt_dp_cache_store(ctx, &subscription_b, "/test-module:list", NULL, 0);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(2, dp_cache_entry_count(ctx->dp_cache));
+    assert_int_equal(2, dp_cache_entry_count(ctx->dp_cache_expiry));
+
+    /* entries of an unsubscribed data provider are dropped */
+    rp_dt_dp_cache_remove_subscription(ctx, subscription_b.dst_address, false, subscription_b.dst_id);
+    assert_int_equal(0, dp_cache_entry_count(ctx->dp_cache));
+    assert_int_equal(0, dp_cache_entry_count(ctx->dp_cache_expiry));
+
+    rp_dt_dp_cache_cleanup(ctx);
+}
+
 int main(){
 
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(get_node_test_found),
             cmocka_unit_test(get_node_test_not_found),
+            cmocka_unit_test(get_node_in_large_list_test),
             cmocka_unit_test(get_value_test),
             cmocka_unit_test(get_tree_test),
             cmocka_unit_test(get_values_test),
@@ -1922,6 +2169,9 @@ int main(){
             cmocka_unit_test(default_nodes_test),
             cmocka_unit_test(default_nodes_toplevel_test),
             cmocka_unit_test_setup(union_test, createData),
+            cmocka_unit_test_setup(get_gpb_values_wrapper_test, createData),
+            cmocka_unit_test_setup(get_items_cursors_test, createData),
+            cmocka_unit_test(dp_cache_expiry_test),
     };
 
     watchdog_start(300);
@@ -26,6 +26,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <unistd.h>
+#include <sys/stat.h>
 #include "data_manager.h"
 #include "test_data.h"
 #include "sr_common.h"
@@ -1879,6 +1880,54 @@ edit_commit4_test(void **state)
     createDataTreeTestModule();
 }
 
+void
+edit_commit_replace_file_test(void **state)
+{
+    int rc = 0;
+    rp_ctx_t *ctx = *state;
+    rp_session_t *session = NULL;
+    dm_commit_context_t *c_ctx = NULL;
+    sr_error_info_t *errors = NULL;
+    size_t e_cnt = 0;
+    sr_val_t *v = NULL;
+    struct stat st_before = {0}, st_after = {0};
+
+    assert_int_equal(0, stat(TEST_MODULE_DATA_FILE_NAME, &st_before));
+
+    test_rp_session_create(ctx, SR_DS_STARTUP, &session);
+
+    v = calloc(1, sizeof(*v));
+    assert_non_null(v);
+    v->type = SR_ENUM_T;
+    v->data.enum_val = strdup("no");
+    assert_non_null(v->data.enum_val);
+
+    rc = rp_dt_set_item_wrapper(ctx, session, "/test-module:main/enum", v, NULL, SR_EDIT_DEFAULT);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    rc = rp_dt_commit(ctx, session, &c_ctx, false, &errors, &e_cnt);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    /* data file has been replaced by a new one with the same access rights */
+    assert_int_equal(0, stat(TEST_MODULE_DATA_FILE_NAME, &st_after));
+    assert_true(st_before.st_ino != st_after.st_ino);
+    assert_int_equal(st_before.st_mode, st_after.st_mode);
+    assert_int_equal(st_before.st_uid, st_after.st_uid);
+
+    rc = rp_dt_refresh_session(ctx, session, &errors, &e_cnt);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    session->state = RP_REQ_NEW;
+    rc = rp_dt_get_value_wrapper(ctx, session, NULL, "/test-module:main/enum", &v);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_string_equal("no", v->data.enum_val);
+    sr_free_val(v);
+
+    test_rp_session_cleanup(ctx, session);
+
+    createDataTreeTestModule();
+}
+
 void
 edit_move_test(void **state)
 {
@@ -2796,6 +2845,7 @@ int main(){
             cmocka_unit_test(edit_commit2_test),
             cmocka_unit_test(edit_commit3_test),
             cmocka_unit_test(edit_commit4_test),
+            cmocka_unit_test(edit_commit_replace_file_test),
             cmocka_unit_test(operation_logging_test),
             cmocka_unit_test(lock_commit_test),
             cmocka_unit_test(empty_string_leaf_test),
@@ -23,6 +23,7 @@
 #include <stdio.h>
 #include <unistd.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <setjmp.h>
 #include <cmocka.h>
 
@@ -250,6 +251,133 @@ enable_running_for_submodule(void **state)
    test_rp_session_cleanup(ctx, session);
 }
 
+void
+running_journal_test(void **state)
+{
+   int rc = 0;
+   rp_ctx_t *ctx = *state;
+   rp_session_t *session = NULL;
+   dm_commit_context_t *c_ctx = NULL;
+   sr_error_info_t *errors = NULL;
+   size_t e_cnt = 0;
+   sr_val_t *value = NULL;
+   struct stat st_before = {0}, st_after = {0}, st_journal = {0};
+   const char *data_file = TEST_DATA_SEARCH_DIR "test-module" SR_RUNNING_FILE_EXT;
+   const char *journal_file = TEST_DATA_SEARCH_DIR "test-module" SR_RUNNING_FILE_EXT SR_JOURNAL_FILE_EXT;
+
+   if (0 == SR_RUNNING_JOURNAL_SIZE) {
+       skip();
+   }
+
+   test_rp_session_create(ctx, SR_DS_RUNNING, &session);
+
+   /* copies startup into running, the whole data file is written */
+   rc = dm_enable_module_running(ctx->dm_ctx, session->dm_session, "test-module", NULL);
+   assert_int_equal(SR_ERR_OK, rc);
+   assert_int_equal(0, stat(data_file, &st_before));
+
+   value = calloc(1, sizeof(*value));
+   assert_non_null(value);
+   value->type = SR_INT8_T;
+   value->data.int8_val = 42;
+   rc = rp_dt_set_item_wrapper(ctx, session, XP_TEST_MODULE_INT8, value, NULL, SR_EDIT_DEFAULT);
+   assert_int_equal(SR_ERR_OK, rc);
+
+   rc = rp_dt_delete_item_wrapper(ctx, session, "/test-module:main/string", SR_EDIT_DEFAULT);
+   assert_int_equal(SR_ERR_OK, rc);
+
+   rc = rp_dt_commit(ctx, session, &c_ctx, false, &errors, &e_cnt);
+   assert_int_equal(SR_ERR_OK, rc);
+   test_rp_session_cleanup(ctx, session);
+
+   /* only the changes were appended to the journal */
+   assert_int_equal(0, stat(data_file, &st_after));
+   assert_int_equal(st_before.st_ino, st_after.st_ino);
+   assert_int_equal(st_before.st_size, st_after.st_size);
+   assert_int_equal(0, stat(journal_file, &st_journal));
+   assert_true(st_journal.st_size > 0);
+
+   /* the journal is replayed when the data file is loaded */
+   test_rp_session_create(ctx, SR_DS_RUNNING, &session);
+   rc = rp_dt_get_value_wrapper(ctx, session, NULL, XP_TEST_MODULE_INT8, &value);
+   assert_int_equal(SR_ERR_OK, rc);
+   assert_int_equal(42, value->data.int8_val);
+   sr_free_val(value);
+
+   session->state = RP_REQ_NEW;
+   rc = rp_dt_get_value_wrapper(ctx, session, NULL, "/test-module:main/string", &value);
+   assert_int_equal(SR_ERR_NOT_FOUND, rc);
+
+   /* rewrite of the whole data file removes the journal */
+   rc = rp_dt_copy_config(ctx, session, "test-module", SR_DS_STARTUP, SR_DS_RUNNING, &errors, &e_cnt);
+   assert_int_equal(SR_ERR_OK, rc);
+   assert_int_equal(-1, stat(journal_file, &st_journal));
+
+   test_rp_session_cleanup(ctx, session);
+}
+
+void
+running_stale_journal_test(void **state)
+{
+   int rc = 0;
+   rp_ctx_t *ctx = *state;
+   rp_session_t *session = NULL;
+   dm_commit_context_t *c_ctx = NULL;
+   sr_error_info_t *errors = NULL;
+   size_t e_cnt = 0;
+   sr_val_t *value = NULL;
+   struct stat st = {0};
+   unsigned long long ino = 0, size = 0, hash = 0;
+   FILE *journal = NULL;
+   const char *data_file = TEST_DATA_SEARCH_DIR "test-module" SR_RUNNING_FILE_EXT;
+   const char *journal_file = TEST_DATA_SEARCH_DIR "test-module" SR_RUNNING_FILE_EXT SR_JOURNAL_FILE_EXT;
+
+   if (0 == SR_RUNNING_JOURNAL_SIZE) {
+       skip();
+   }
+
+   test_rp_session_create(ctx, SR_DS_RUNNING, &session);
+   rc = dm_enable_module_running(ctx->dm_ctx, session->dm_session, "test-module", NULL);
+   assert_int_equal(SR_ERR_OK, rc);
+   assert_int_equal(0, stat(data_file, &st));
+
+   /* journal left behind by a crash, written for other content of the data file with the same inode and size */
+   journal = fopen(journal_file, "w");
+   assert_non_null(journal);
+   fprintf(journal, "SRJ %llu %llu 0\nstale", (unsigned long long)st.st_ino, (unsigned long long)st.st_size);
+   fclose(journal);
+
+   value = calloc(1, sizeof(*value));
+   assert_non_null(value);
+   value->type = SR_INT8_T;
+   value->data.int8_val = 43;
+   rc = rp_dt_set_item_wrapper(ctx, session, XP_TEST_MODULE_INT8, value, NULL, SR_EDIT_DEFAULT);
+   assert_int_equal(SR_ERR_OK, rc);
+
+   rc = rp_dt_commit(ctx, session, &c_ctx, false, &errors, &e_cnt);
+   assert_int_equal(SR_ERR_OK, rc);
+   test_rp_session_cleanup(ctx, session);
+
+   /* the journal has been restarted for the current data file */
+   journal = fopen(journal_file, "r");
+   assert_non_null(journal);
+   assert_int_equal(3, fscanf(journal, "SRJ %llu %llu %llx", &ino, &size, &hash));
+   fclose(journal);
+   assert_int_equal(0, stat(data_file, &st));
+   assert_true((unsigned long long)st.st_ino == ino);
+   assert_true((unsigned long long)st.st_size == size);
+   assert_true(0 != hash);
+
+   /* the committed change is replayed */
+   test_rp_session_create(ctx, SR_DS_RUNNING, &session);
+   rc = rp_dt_get_value_wrapper(ctx, session, NULL, XP_TEST_MODULE_INT8, &value);
+   assert_int_equal(SR_ERR_OK, rc);
+   assert_int_equal(43, value->data.int8_val);
+   sr_free_val(value);
+
+   test_rp_session_cleanup(ctx, session);
+}
+
 int
 main() {
     sr_log_stderr(SR_LL_ERR);
@@ -259,6 +387,8 @@ main() {
             cmocka_unit_test_setup_teardown(enable_subtree_test, setup, teardown),
             cmocka_unit_test_setup_teardown(edit_enabled, setup, teardown),
             cmocka_unit_test_setup_teardown(enable_running_for_submodule, setup, teardown),
+            cmocka_unit_test_setup_teardown(running_journal_test, setup, teardown),
+            cmocka_unit_test_setup_teardown(running_stale_journal_test, setup, teardown),
     };
 
     watchdog_start(300);
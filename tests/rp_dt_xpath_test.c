@@ -25,6 +25,7 @@
 #include <cmocka.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <pthread.h>
 #include "rp_dt_xpath.h"
 #include "sr_common.h"
 #include "data_manager.h"
@@ -212,6 +213,67 @@ check_error_reporting(void **state)
     dm_session_stop(ctx, session);
 }
 
+void
+rp_dt_resolve_cached(void **state)
+{
+    int rc = 0;
+    dm_ctx_t *ctx = *state;
+    dm_session_t *session = NULL;
+    dm_schema_info_t *si = NULL;
+    dm_xpath_entry_t *entry = NULL, *entry2 = NULL;
+    dm_session_start(ctx, NULL, SR_DS_STARTUP, &session);
+
+    rc = dm_get_module_and_lock(ctx, "example-module", &si);
+    assert_int_equal(SR_ERR_OK, rc);
+
+    /* simple xpath is split into steps */
+    rc = rp_dt_resolve_xpath(ctx, session, si, "/example-module:container/list[key2='b'][key1='a']/leaf", &entry);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_non_null(entry->node);
+    assert_string_equal("leaf", entry->node->name);
+    assert_non_null(entry->steps);
+    assert_int_equal(3, entry->step_cnt);
+    assert_null(entry->steps[0].keys);
+    assert_string_equal("list", entry->steps[1].node->name);
+    assert_string_equal("a", entry->steps[1].keys[0]);
+    assert_string_equal("b", entry->steps[1].keys[1]);
+    assert_null(entry->steps[1].keys[2]);
+    assert_int_equal(2, entry->steps[1].key_cnt);
+
+    /* second resolution is served from the cache */
+    rc = rp_dt_resolve_xpath(ctx, session, si, "/example-module:container/list[key2='b'][key1='a']/leaf", &entry2);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_ptr_equal(entry, entry2);
+    dm_xpath_cache_release(si, entry2);
+    dm_xpath_cache_release(si, entry);
+
+    /* list without all keys is resolved, but can not be looked up by steps */
+    rc = rp_dt_resolve_xpath(ctx, session, si, "/example-module:container/list[key1='a']", &entry);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_non_null(entry->node);
+    assert_null(entry->steps);
+    dm_xpath_cache_release(si, entry);
+
+    /* the same with only the second key, the parsed key value is not leaked */
+    rc = rp_dt_resolve_xpath(ctx, session, si, "/example-module:container/list[key2='b']/leaf", &entry);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_non_null(entry->node);
+    assert_string_equal("leaf", entry->node->name);
+    assert_null(entry->steps);
+    dm_xpath_cache_release(si, entry);
+
+    /* failures are not cached */
+    for (int i = 0; i < 2; i++) {
+        rc = rp_dt_resolve_xpath(ctx, session, si, "/example-module:container/unknown", &entry);
+        assert_int_equal(SR_ERR_BAD_ELEMENT, rc);
+        assert_true(dm_has_error(session));
+        dm_clear_session_errors(session);
+    }
+
+    pthread_rwlock_unlock(&si->model_lock);
+    dm_session_stop(ctx, session);
+}
+
 int main(){
     sr_log_stderr(SR_LL_ERR);
 
@@ -219,6 +281,7 @@ int main(){
             cmocka_unit_test_setup_teardown(rp_dt_validate_ok, setup, teardown),
             cmocka_unit_test_setup_teardown(rp_dt_validate_fail, setup, teardown),
             cmocka_unit_test_setup_teardown(check_error_reporting, setup, teardown),
+            cmocka_unit_test_setup_teardown(rp_dt_resolve_cached, setup, teardown),
     };
 
     watchdog_start(300);
@@ -29,6 +29,8 @@
 #include "sr_common.h"
 #include "access_control.h"
 #include "request_processor.h"
+#include "rp_internal.h"
+#include "rp_dt_get.h"
 #include "system_helper.h"
 
 static int
@@ -142,11 +144,68 @@ rp_msg_neg_test(void **state)
     assert_int_equal(rc, SR_ERR_OK);
 }
 
+/**
+ * Test that requests of one session are executed in the order in which they were received.
+ */
+static void
+rp_session_order_test(void **state)
+{
+    int rc = 0;
+    rp_session_t *session = NULL;
+    Sr__Msg *msg = NULL;
+    sr_val_t value = { 0 }, *result = NULL;
+    uint32_t msg_count = 0;
+
+    rp_ctx_t *rp_ctx = *state;
+    assert_non_null(rp_ctx);
+
+    ac_ucred_t credentials = { 0 };
+    credentials.e_uid = getuid();
+    credentials.e_gid = getgid();
+
+    rc = rp_session_start(rp_ctx, 123456, &credentials, SR_DS_STARTUP, SR_SESS_DEFAULT, 0, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_non_null(session);
+
+    /* enqueue a burst of requests setting the same leaf, worker threads pick them up concurrently */
+    value.type = SR_INT32_T;
+    for (int32_t i = 1; i <= 100; i++) {
+        rc = sr_gpb_req_alloc(NULL, SR__OPERATION__SET_ITEM, session->id, &msg);
+        assert_int_equal(rc, SR_ERR_OK);
+        msg->request->set_item_req->xpath = strdup("/test-module:main/i32");
+        msg->request->set_item_req->options = SR_EDIT_DEFAULT;
+        value.data.int32_val = i;
+        rc = sr_dup_val_t_to_gpb(&value, &msg->request->set_item_req->value);
+        assert_int_equal(rc, SR_ERR_OK);
+
+        rc = rp_msg_process(rp_ctx, session, msg);
+        assert_int_equal(rc, SR_ERR_OK);
+    }
+
+    /* wait until all requests are processed */
+    do {
+        usleep(1000);
+        pthread_mutex_lock(&session->msg_count_mutex);
+        msg_count = session->msg_count;
+        pthread_mutex_unlock(&session->msg_count_mutex);
+    } while (msg_count > 0);
+
+    /* the last request has been executed last */
+    rc = rp_dt_get_value_wrapper(rp_ctx, session, NULL, "/test-module:main/i32", &result);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(100, result->data.int32_val);
+    sr_free_val(result);
+
+    rc = rp_session_stop(rp_ctx, session);
+    assert_int_equal(rc, SR_ERR_OK);
+}
+
 int
 main() {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test_setup_teardown(rp_session_test, rp_setup, rp_teardown),
             cmocka_unit_test_setup_teardown(rp_msg_neg_test, rp_setup, rp_teardown),
+            cmocka_unit_test_setup_teardown(rp_session_order_test, rp_setup, rp_teardown),
     };
 
     watchdog_start(300);